@@ -8,6 +8,7 @@
 #define SQLITE_ENABLE_NORMALIZE 1
 #include <BeSQLite/ChangeSet.h>
 #include <BeSQLite/BeLzma.h>
+#include <BeSQLite/BeZstd.h>
 #include "SQLite/sqlite3.h"
 #include <Bentley/BeFileName.h>
 #include <Bentley/BeAssert.h>
@@ -217,15 +218,15 @@ struct CachedPropertyKey
 struct CachedPropertyValue
     {
     bool          m_dirty;
-    bool          m_compressed;
+    PropertySpec::Compress m_compress;
     Utf8String    m_strVal;
     bvector<Byte> m_value;
 
-    CachedPropertyValue() {m_dirty=m_compressed=false;}
-    void ChangeValue(Utf8CP strVal, uint32_t valSize, Byte const* value, bool dirty, bool compressed)
+    CachedPropertyValue() {m_dirty=false; m_compress=PropertySpec::Compress::No;}
+    void ChangeValue(Utf8CP strVal, uint32_t valSize, Byte const* value, bool dirty, PropertySpec::Compress compress)
         {
         m_dirty = dirty;
-        m_compressed = compressed;
+        m_compress = compress;
         if (strVal)
             m_strVal.assign(strVal);
         if (value)
@@ -1358,7 +1359,7 @@ void DbFile::SaveCachedProperties(bool isCommit)
         CachedPropertyValue& val = it->second;
         if (val.m_dirty)
             {
-            PropertySpec spec(key.m_name.c_str(), key.m_namespace.c_str(), PropertySpec::Mode::Normal, val.m_compressed ? PropertySpec::Compress::Yes : PropertySpec::Compress::No);
+            PropertySpec spec(key.m_name.c_str(), key.m_namespace.c_str(), PropertySpec::Mode::Normal, val.m_compress);
             SaveProperty(spec, val.m_strVal.length()>0 ? val.m_strVal.c_str() : nullptr, val.m_value.size()>0 ? val.m_value.data() : nullptr, (uint32_t) val.m_value.size(),
                           key.m_id, key.m_subId);
             val.m_dirty=false;
@@ -1416,7 +1417,7 @@ DbResult DbFile::SaveProperty(PropertySpecCR spec, Utf8CP stringData, void const
 
     if (spec.IsCached())
         {
-        GetCachedProperty(spec, id, subId).ChangeValue(stringData, size, const_cast<Byte*>((Byte const*)value), true, spec.IsCompress());
+        GetCachedProperty(spec, id, subId).ChangeValue(stringData, size, const_cast<Byte*>((Byte const*)value), true, spec.GetCompress());
         return  BE_SQLITE_OK;
         }
 
@@ -1440,7 +1441,18 @@ DbResult DbFile::SaveProperty(PropertySpecCR spec, Utf8CP stringData, void const
         if (size <= 100) // too small to be worth trying
             doCompress = false;
 
-        if (doCompress)
+        if (doCompress && spec.IsZstd())
+            {
+            ZstdEncoder encoder(DefaultCompressionLevel);
+            if (ZIP_SUCCESS != encoder.CompressBuffer(compressed, value, size) || (compressed.size() >= size))
+                doCompress = false;
+            else
+                {
+                stmt->BindInt(6, size);     // this is the uncompressed size, when compressed
+                stmt->BindBlob(7, compressed.data(), (int) compressed.size(), Statement::MakeCopy::No);
+                }
+            }
+        else if (doCompress)
             {
             unsigned long compressedSize= (uint32_t) (size*1.01) + 12;
             compressed.resize(compressedSize);
@@ -1503,6 +1515,30 @@ DbResult DbFile::QueryPropertySize(uint32_t& size, PropertySpecCR spec, uint64_t
     }
 
 #define FROM_PROPERTY_TABLE_SQL " FROM " BEDB_TABLE_Property " WHERE Namespace=? AND Name=? AND Id=? AND SubId=?"
+
+/*---------------------------------------------------------------------------------**//**
+* Uncompress the first size bytes of a compressed property value. Values are compressed with either zlib or, for
+* PropertySpec::Compress::Zstd, Zstandard. The two are told apart by the zstd frame magic number, which is never a valid zlib header.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static DbResult uncompressProperty(void* value, uint32_t size, void const* blobdata, uint32_t blobsize)
+    {
+    if (ZstdDecoder::IsZstdFrame(blobdata, blobsize))
+        {
+        bvector<Byte> uncompressed;
+        ZstdDecoder decoder;
+        if (ZIP_SUCCESS != decoder.DecompressBuffer(uncompressed, blobdata, blobsize) || uncompressed.size() < size)
+            return BE_SQLITE_MISMATCH;
+
+        memcpy(value, uncompressed.data(), size);
+        return BE_SQLITE_OK;
+        }
+
+    unsigned long actuallyRead = size;
+    uncompress((Byte*)value, &actuallyRead, (Byte const*) blobdata, blobsize);
+    return (actuallyRead != size) ? BE_SQLITE_MISMATCH : BE_SQLITE_OK;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -1543,10 +1579,9 @@ DbResult DbFile::QueryCachedProperty(Utf8String* strval, void** value, uint32_t
 
         if (compressedBytes > 0)
             {
-            unsigned long actuallyRead = size;
-            uncompress((Byte*)cachedProp->m_value.data(), &actuallyRead, (Byte const*) blobdata, blobsize);
-            if (actuallyRead != size)
-                return BE_SQLITE_MISMATCH;
+            DbResult rc = uncompressProperty(cachedProp->m_value.data(), compressedBytes, blobdata, blobsize);
+            if (BE_SQLITE_OK != rc)
+                return rc;
             }
         else
             {
@@ -1606,10 +1641,9 @@ DbResult DbFile::QueryProperty(void* value, uint32_t size, PropertySpecCR spec,
 
     if (compressedBytes > 0)
         {
-        unsigned long actuallyRead = size;
-        uncompress((Byte*)value, &actuallyRead, (Byte const*) blobdata, blobsize);
-        if (actuallyRead != size)
-            return BE_SQLITE_MISMATCH;
+        DbResult rc = uncompressProperty(value, size, blobdata, blobsize);
+        if (BE_SQLITE_OK != rc)
+            return rc;
         }
     else
         {
@@ -2985,6 +3019,7 @@ DbResult Db::OpenSecondaryConnection(Db& newConnection, OpenParams params) const
 
 /** Perform a checkpoint operation if this database is in WAL mode. */
 DbResult Db::PerformCheckpoint(WalCheckpointMode mode, int* pnLog, int* pnCkpt) {
+    _OnBeforeCheckpoint();
     SuspendDefaultTxn noDefaultTxn(*this); // no transactions may be active to perform a checkpoint
     return (DbResult) sqlite3_wal_checkpoint_v2(GetSqlDb(), "main", (int)mode, pnLog, pnCkpt);
 }
@@ -4297,6 +4332,7 @@ public:
 
 
 #define EMBEDDED_LZMA_MARKER   "EmLzma"
+#define EMBEDDED_ZSTD_LEVEL    9
 //=======================================================================================
 // The first EmbeddedFileBlob for an embedded file starts with this structure.  If
 // m_compressionType is NO_COMPRESSION then the image is not compressed.
@@ -4315,7 +4351,8 @@ public:
     enum CompressionType : uint16_t
         {
         NO_COMPRESSION = 0,
-        LZMA2 = 2
+        LZMA2 = 2,
+        ZSTD = 3
         };
 
     //---------------------------------------------------------------------------------------
@@ -4334,7 +4371,9 @@ public:
 
     int GetVersion() { return m_formatVersionNumber; }
     bool IsLzma2() { return LZMA2 == m_compressionType; }
+    bool IsZstd() { return ZSTD == m_compressionType; }
     bool IsUncompressed() { return NO_COMPRESSION == m_compressionType; }
+    DbEmbeddedFileTable::Compression GetCompression() { return (DbEmbeddedFileTable::Compression) m_compressionType; }
 
     //---------------------------------------------------------------------------------------
     // @bsimethod
@@ -4350,7 +4389,7 @@ public:
         if (formatVersionNumber != m_formatVersionNumber)
             return false;
 
-        return m_compressionType == LZMA2 || m_compressionType == NO_COMPRESSION;
+        return m_compressionType == LZMA2 || m_compressionType == ZSTD || m_compressionType == NO_COMPRESSION;
         }
 };
 
@@ -4390,15 +4429,44 @@ static uint32_t getDictionarySize(uint32_t dictionarySize)
     return dictionarySize;
     }
 
+//---------------------------------------------------------------------------------------
+// Zstandard has no equivalent of LZMA's random access blocks; the output is simply split into chunkSize blobs.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static DbResult zstdCompressAndEmbed(PropertyBlobOutStream& outStream, ILzmaInputStream& inStream)
+    {
+    EmbeddedLzmaHeader  header(EmbeddedLzmaHeader::ZSTD);
+    uint32_t bytesWritten;
+    outStream._Write(&header, sizeof (header), bytesWritten);
+    if (bytesWritten != sizeof (header))
+        return BE_SQLITE_IOERR;
+
+    ZstdEncoder encoder(EMBEDDED_ZSTD_LEVEL);
+    ZipErrors compressResult = encoder.CompressStream(outStream, inStream);
+    if (compressResult != ZIP_SUCCESS)
+        {
+        LOG.errorv("ZstdEncoder::CompressStream returned %d", compressResult);
+        return BE_SQLITE_IOERR;
+        }
+
+    return outStream.Flush();
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-static DbResult compressAndEmbedFileImage(Db& db, uint32_t& chunkSize, BeBriefcaseBasedId id, void const* data, uint32_t const size, bool supportRandomAccess)
+static DbResult compressAndEmbedFileImage(Db& db, uint32_t& chunkSize, BeBriefcaseBasedId id, void const* data, uint32_t const size, bool supportRandomAccess, DbEmbeddedFileTable::Compression compression)
     {
+    MemoryLzmaInStream inStream(data, size);
+    if (DbEmbeddedFileTable::Compression::Zstd == compression)
+        {
+        PropertyBlobOutStream outStream(db, id, chunkSize);
+        return zstdCompressAndEmbed(outStream, inStream);
+        }
+
     if (supportRandomAccess)
         chunkSize = getDictionarySize(chunkSize);
 
-    MemoryLzmaInStream inStream(data, size);
     PropertyBlobOutStream outStream(db, id, chunkSize);
 
     uint32_t dictionarySize = std::min(size, chunkSize);
@@ -4474,9 +4542,10 @@ static bool isFileLockedBySQLite(BeFile& testfile)
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-static DbResult compressAndEmbedFile(Db& db, uint64_t& filesize, uint32_t& chunkSize, BeBriefcaseBasedId id, Utf8CP filespec, bool supportRandomAccess)
+static DbResult compressAndEmbedFile(Db& db, uint64_t& filesize, uint32_t& chunkSize, BeBriefcaseBasedId id, Utf8CP filespec, bool supportRandomAccess, DbEmbeddedFileTable::Compression compression)
     {
-    if (supportRandomAccess)
+    bool useZstd = DbEmbeddedFileTable::Compression::Zstd == compression;
+    if (supportRandomAccess && !useZstd)
         chunkSize = getDictionarySize(chunkSize);
 
     BeFileLzmaInStream inStream;
@@ -4493,6 +4562,18 @@ static DbResult compressAndEmbedFile(Db& db, uint64_t& filesize, uint32_t& chunk
     if (isFileLockedBySQLite(inStream.GetBeFile()))
         return BE_SQLITE_BUSY;
 
+    if (useZstd)
+        {
+        DbResult rc = zstdCompressAndEmbed(outStream, inStream);
+        if (BE_SQLITE_OK == rc && inStream.GetBytesRead() != filesize)
+            {
+            LOG.errorv("ZstdEncoder::CompressStream succeeded but read the wrong number of bytes: expected %lld, actual %lld", filesize, inStream.GetBytesRead());
+            return BE_SQLITE_IOERR;
+            }
+
+        return rc;
+        }
+
     uint32_t dictionarySize = static_cast <uint32_t> (std::min(filesize, (uint64_t) chunkSize));
 
     LzmaEncoder encoder(LzmaEncoder::LzmaParams(dictionarySize, supportRandomAccess));
@@ -4648,6 +4729,15 @@ BeBriefcaseBasedId DbEmbeddedFileTable::ImportDbFile(DbResult& stat, Utf8CP name
 BeBriefcaseBasedId DbEmbeddedFileTable::Import(DbResult* stat, bool compress, Utf8CP name, Utf8CP localFileName, DateTime const* lastModified,
         Utf8CP typeStr, Utf8CP description, uint32_t chunkSize, bool supportRandomAccess)
     {
+    return Import(stat, compress ? Compression::Lzma : Compression::None, name, localFileName, lastModified, typeStr, description, chunkSize, supportRandomAccess);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+ @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BeBriefcaseBasedId DbEmbeddedFileTable::Import(DbResult* stat, Compression compression, Utf8CP name, Utf8CP localFileName, DateTime const* lastModified,
+        Utf8CP typeStr, Utf8CP description, uint32_t chunkSize, bool supportRandomAccess)
+    {
     BeAssert(m_db.IsTransactionActive());
 
     // make sure name is unique before continuing
@@ -4663,8 +4753,8 @@ BeBriefcaseBasedId DbEmbeddedFileTable::Import(DbResult* stat, bool compress, Ut
     BeBriefcaseBasedId newId = GetNextEmbedFileId();
 
     uint64_t fileSize;
-    DbResult rc = compress ? compressAndEmbedFile(m_db, fileSize, chunkSize, newId, localFileName, supportRandomAccess) :
-                             embedFileWithoutCompressing(m_db, fileSize, chunkSize, newId, localFileName);
+    DbResult rc = (Compression::None != compression) ? compressAndEmbedFile(m_db, fileSize, chunkSize, newId, localFileName, supportRandomAccess, compression) :
+                                                       embedFileWithoutCompressing(m_db, fileSize, chunkSize, newId, localFileName);
     if (BE_SQLITE_OK == rc)
         rc = addEmbedFile(m_db, name, typeStr, description, newId, fileSize, lastModified, chunkSize);
 
@@ -4724,7 +4814,7 @@ DbResult DbEmbeddedFileTable::Replace(Utf8CP name, Utf8CP filespec, DateTime con
     if (!id.IsValid())
         return  BE_SQLITE_ERROR;
 
-    bool isLzma2 = true;
+    Compression compression = Compression::Lzma;
     {
     PropertyBlobInStream    inStream(m_db, id);
     EmbeddedLzmaHeader  header(EmbeddedLzmaHeader::LZMA2);
@@ -4732,15 +4822,15 @@ DbResult DbEmbeddedFileTable::Replace(Utf8CP name, Utf8CP filespec, DateTime con
     inStream._Read(&header, sizeof(header), actuallyRead);
     if (actuallyRead != sizeof(header) || !header.IsValid())
         return BE_SQLITE_MISMATCH;
-    isLzma2 = header.IsLzma2();
+    compression = header.GetCompression();
     }
 
     removeFileBlobs(m_db, id);
 
-    if (isLzma2)
+    if (Compression::None != compression)
         {
         uint64_t fileSize;
-        DbResult rc = compressAndEmbedFile(m_db, fileSize, chunkSize, id, filespec, false);
+        DbResult rc = compressAndEmbedFile(m_db, fileSize, chunkSize, id, filespec, false, compression);
         return (BE_SQLITE_OK != rc) ? rc : updateEmbedFile(m_db, id, fileSize, lastModified, chunkSize);
         }
 
@@ -4753,6 +4843,14 @@ DbResult DbEmbeddedFileTable::Replace(Utf8CP name, Utf8CP filespec, DateTime con
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 DbResult DbEmbeddedFileTable::Save(void const* data, uint64_t size, Utf8CP name, DateTime const* lastModified, bool compress, uint32_t chunkSize)
+    {
+    return Save(data, size, name, compress ? Compression::Lzma : Compression::None, lastModified, chunkSize);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+DbResult DbEmbeddedFileTable::Save(void const* data, uint64_t size, Utf8CP name, Compression compression, DateTime const* lastModified, uint32_t chunkSize)
     {
     BeAssert(m_db.IsTransactionActive());
     BeBriefcaseBasedId id = QueryFile(name);
@@ -4778,9 +4876,9 @@ DbResult DbEmbeddedFileTable::Save(void const* data, uint64_t size, Utf8CP name,
             return rc;
         }
 
-    if (compress)
+    if (Compression::None != compression)
         {
-        compressAndEmbedFileImage(m_db, chunkSize, id, data, (uint32_t)size, true);
+        compressAndEmbedFileImage(m_db, chunkSize, id, data, (uint32_t)size, true, compression);
         return updateEmbedFile(m_db, id, size, nullptr, chunkSize);
         }
 
@@ -4816,12 +4914,21 @@ DbResult DbEmbeddedFileTable::Export(Utf8CP filespec, Utf8CP name, ICompressProg
     if (outStream.CreateOutputFile(outName, false) != BeFileStatus::Success)
         return  BE_SQLITE_ERROR_FileExists;
 
-    if (header.IsLzma2())
+    if (header.IsLzma2() || header.IsZstd())
         {
-        LzmaDecoder decoder;
-        decoder.SetProgressTracker(progress);
+        ZipErrors result;
+        if (header.IsZstd())
+            {
+            ZstdDecoder decoder;
+            result = decoder.DecompressStream(outStream, inStream);
+            }
+        else
+            {
+            LzmaDecoder decoder;
+            decoder.SetProgressTracker(progress);
+            result = decoder.DecompressStream(outStream, inStream);
+            }
 
-        ZipErrors result = decoder.DecompressStream(outStream, inStream);
         if (ZIP_SUCCESS != result)
             {
             outName.BeDeleteFile();
@@ -4918,9 +5025,15 @@ DbResult DbEmbeddedFileTable::Read(ChunkedArray& callerBuffer, Utf8CP name) {
     if (actuallyRead != sizeof(header) || !header.IsValid())
         return BE_SQLITE_MISMATCH;
 
-    if (header.IsLzma2()) {
-        LzmaDecoder decoder;
-        ZipErrors result = decoder.DecompressStream(outStream, inStream);
+    if (header.IsLzma2() || header.IsZstd()) {
+        ZipErrors result;
+        if (header.IsZstd()) {
+            ZstdDecoder decoder;
+            result = decoder.DecompressStream(outStream, inStream);
+        } else {
+            LzmaDecoder decoder;
+            result = decoder.DecompressStream(outStream, inStream);
+        }
         BeAssert(callerBuffer.m_size == actualSize);
         return ZIP_SUCCESS == result ? BE_SQLITE_OK : BE_SQLITE_IOERR_READ;
     }
@@ -0,0 +1,437 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#include "zstd/zstd.h"
+#include "zstd/zdict.h"
+
+#include <BeSQLite/BeZstd.h>
+#include <Bentley/Logging.h>
+
+#define LOG (NativeLogging::CategoryLogger("BeSQLite"))
+
+BEGIN_BENTLEY_SQLITE_NAMESPACE
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdDictionary::Train(bvector<bvector<Byte>> const& samples, uint32_t maxSize)
+    {
+    bvector<Byte> sampleData;
+    bvector<size_t> sampleSizes;
+    for (auto const& sample : samples)
+        {
+        sampleData.insert(sampleData.end(), sample.begin(), sample.end());
+        sampleSizes.push_back(sample.size());
+        }
+
+    bvector<Byte> data(maxSize);
+    size_t size = ZDICT_trainFromBuffer(data.data(), data.size(), sampleData.data(), sampleSizes.data(), (unsigned)sampleSizes.size());
+    if (ZDICT_isError(size))
+        {
+        LOG.errorv("Unable to train a zstd dictionary from %d samples: %s", (int)samples.size(), ZDICT_getErrorName(size));
+        return ZIP_ERROR_COMPRESSION_ERROR;
+        }
+
+    data.resize(size);
+    m_data.swap(data);
+    return ZIP_SUCCESS;
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+uint32_t ZstdDictionary::GetId() const
+    {
+    return m_data.empty() ? 0 : ZDICT_getDictID(m_data.data(), m_data.size());
+    }
+
+//=======================================================================================
+// @bsiclass
+//=======================================================================================
+struct ZstdEncoder::Impl
+{
+private:
+    ZSTD_CCtx* m_cctx;
+    ILzmaOutputStream* m_outStream = nullptr;
+    bvector<Byte> m_outBuf;
+
+    ZipErrors Compress(void const* data, size_t size, ZSTD_EndDirective mode)
+        {
+        if (nullptr == m_outStream)
+            {
+            BeAssert(false && "Call StartCompress first");
+            return ZIP_ERROR_WRITE_ERROR;
+            }
+
+        ZSTD_inBuffer in = {data, size, 0};
+        bool finished = false;
+        while (!finished)
+            {
+            ZSTD_outBuffer out = {m_outBuf.data(), m_outBuf.size(), 0};
+            size_t remaining = ZSTD_compressStream2(m_cctx, &out, &in, mode);
+            if (ZSTD_isError(remaining))
+                {
+                LOG.errorv("zstd compression failed: %s", ZSTD_getErrorName(remaining));
+                return ZIP_ERROR_COMPRESSION_ERROR;
+                }
+
+            if (out.pos > 0)
+                {
+                uint32_t bytesWritten;
+                ZipErrors status = m_outStream->_Write(m_outBuf.data(), (uint32_t)out.pos, bytesWritten);
+                if (ZIP_SUCCESS != status)
+                    return status;
+
+                if (bytesWritten != out.pos)
+                    return ZIP_ERROR_WRITE_ERROR;
+                }
+
+            // Ending the frame has to flush everything; otherwise it is enough that all of the input was consumed.
+            finished = (ZSTD_e_end == mode) ? (0 == remaining) : (in.pos == in.size);
+            }
+
+        return ZIP_SUCCESS;
+        }
+
+public:
+    Impl(int level, ZstdDictionary const* dictionary) : m_outBuf(ZSTD_CStreamOutSize())
+        {
+        m_cctx = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, level);
+        ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_checksumFlag, 1);
+        if (nullptr != dictionary && !dictionary->IsEmpty())
+            ZSTD_CCtx_loadDictionary(m_cctx, dictionary->GetData().data(), dictionary->GetData().size());
+        }
+
+    ~Impl() { ZSTD_freeCCtx(m_cctx); }
+
+    ZipErrors StartCompress(ILzmaOutputStream& outStream, uint64_t pledgedSize = ZSTD_CONTENTSIZE_UNKNOWN)
+        {
+        if (nullptr != m_outStream)
+            {
+            BeAssert(false && "In the middle of another streaming operation. Finish that first!!");
+            return ZIP_ERROR_WRITE_ERROR;
+            }
+
+        // Resetting the session keeps the level and dictionary.
+        ZSTD_CCtx_reset(m_cctx, ZSTD_reset_session_only);
+        if (ZSTD_CONTENTSIZE_UNKNOWN != pledgedSize)
+            ZSTD_CCtx_setPledgedSrcSize(m_cctx, pledgedSize);
+
+        m_outStream = &outStream;
+        return ZIP_SUCCESS;
+        }
+
+    ZipErrors CompressNextPage(void const* pData, int nData) { return Compress(pData, (size_t)nData, ZSTD_e_continue); }
+
+    ZipErrors FinishCompress()
+        {
+        if (nullptr == m_outStream)
+            return ZIP_SUCCESS;
+
+        ZipErrors status = Compress(nullptr, 0, ZSTD_e_end);
+        m_outStream = nullptr;
+        return status;
+        }
+
+    ZipErrors CompressStream(ILzmaOutputStream& outStream, ILzmaInputStream& inStream)
+        {
+        ZipErrors status = StartCompress(outStream);
+        if (ZIP_SUCCESS != status)
+            return status;
+
+        bvector<Byte> inBuf(ZSTD_CStreamInSize());
+        while (true)
+            {
+            uint32_t bytesRead = 0;
+            if (ZIP_SUCCESS != (status = inStream._Read(inBuf.data(), (uint32_t)inBuf.size(), bytesRead)))
+                break;
+
+            if (0 == bytesRead)
+                break;
+
+            if (ZIP_SUCCESS != (status = CompressNextPage(inBuf.data(), (int)bytesRead)))
+                break;
+            }
+
+        ZipErrors finishStatus = FinishCompress();
+        return ZIP_SUCCESS != status ? status : finishStatus;
+        }
+
+    ZipErrors CompressBuffer(bvector<Byte>& out, void const* input, uint32_t sizeInput)
+        {
+        MemoryLzmaOutStream outStream(out);
+        ZipErrors status = StartCompress(outStream, sizeInput);
+        if (ZIP_SUCCESS != status)
+            return status;
+
+        status = Compress(input, sizeInput, ZSTD_e_end);
+        m_outStream = nullptr;
+        return status;
+        }
+};
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZstdEncoder::ZstdEncoder(int level, ZstdDictionary const* dictionary)
+    {
+    m_impl = new ZstdEncoder::Impl(level, dictionary);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZstdEncoder::~ZstdEncoder()
+    {
+    delete m_impl;
+    m_impl = nullptr;
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdEncoder::StartCompress(ILzmaOutputStream& outStream)
+    {
+    return m_impl->StartCompress(outStream);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdEncoder::CompressNextPage(void const* pData, int nData)
+    {
+    return m_impl->CompressNextPage(pData, nData);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdEncoder::FinishCompress()
+    {
+    return m_impl->FinishCompress();
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdEncoder::CompressStream(ILzmaOutputStream& outStream, ILzmaInputStream& inStream)
+    {
+    return m_impl->CompressStream(outStream, inStream);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdEncoder::CompressBuffer(bvector<Byte>& out, void const* input, uint32_t sizeInput)
+    {
+    return m_impl->CompressBuffer(out, input, sizeInput);
+    }
+
+//=======================================================================================
+// @bsiclass
+//=======================================================================================
+struct ZstdDecoder::Impl
+{
+private:
+    ZSTD_DCtx* m_dctx;
+    ILzmaInputStream* m_inStream = nullptr;
+    bvector<Byte> m_inBuf;
+    size_t m_inSize = 0;
+    size_t m_inPos = 0;
+    bool m_endOfInput = false;
+    size_t m_lastResult = 0; // 0 when the last frame has been fully decoded and flushed
+
+public:
+    Impl(ZstdDictionary const* dictionary) : m_inBuf(ZSTD_DStreamInSize())
+        {
+        m_dctx = ZSTD_createDCtx();
+        if (nullptr != dictionary && !dictionary->IsEmpty())
+            ZSTD_DCtx_loadDictionary(m_dctx, dictionary->GetData().data(), dictionary->GetData().size());
+        }
+
+    ~Impl() { ZSTD_freeDCtx(m_dctx); }
+
+    ZipErrors StartDecompress(ILzmaInputStream& inStream)
+        {
+        if (nullptr != m_inStream)
+            {
+            BeAssert(false && "In the middle of another streaming operation. Finish that first!!");
+            return ZIP_ERROR_READ_ERROR;
+            }
+
+        ZSTD_DCtx_reset(m_dctx, ZSTD_reset_session_only);
+        m_inStream = &inStream;
+        m_inSize = m_inPos = 0;
+        m_endOfInput = false;
+        m_lastResult = 0;
+        return ZIP_SUCCESS;
+        }
+
+    ZipErrors DecompressNextPage(void* pData, int* pnData)
+        {
+        if (nullptr == m_inStream)
+            {
+            BeAssert(false && "Call StartDecompress first");
+            return ZIP_ERROR_READ_ERROR;
+            }
+
+        ZSTD_outBuffer out = {pData, (size_t)*pnData, 0};
+        *pnData = 0;
+        while (true)
+            {
+            if (m_inPos == m_inSize && !m_endOfInput)
+                {
+                uint32_t bytesRead = 0;
+                ZipErrors status = m_inStream->_Read(m_inBuf.data(), (uint32_t)m_inBuf.size(), bytesRead);
+                if (ZIP_SUCCESS != status)
+                    return status;
+
+                m_inSize = bytesRead;
+                m_inPos = 0;
+                m_endOfInput = (0 == bytesRead);
+                }
+
+            // Nothing more to come once the input is exhausted and the last frame has been flushed. Until then the decoder
+            // is called even without new input, since it may still hold output that did not fit last time.
+            if (m_endOfInput && 0 == m_lastResult)
+                break;
+
+            ZSTD_inBuffer in = {m_inBuf.data(), m_inSize, m_inPos};
+            size_t result = ZSTD_decompressStream(m_dctx, &out, &in);
+            m_inPos = in.pos;
+            if (ZSTD_isError(result))
+                {
+                LOG.errorv("zstd decompression failed: %s", ZSTD_getErrorName(result));
+                return ZIP_ERROR_BAD_DATA;
+                }
+
+            m_lastResult = result;
+            if (out.pos > 0)
+                break;
+
+            if (m_endOfInput)
+                {
+                BeAssert(false && "zstd stream is truncated");
+                return ZIP_ERROR_END_OF_DATA;
+                }
+            }
+
+        *pnData = (int)out.pos;
+        return ZIP_SUCCESS;
+        }
+
+    void FinishDecompress() { m_inStream = nullptr; }
+
+    ZipErrors DecompressStream(ILzmaOutputStream& outStream, ILzmaInputStream& inStream)
+        {
+        ZipErrors status = StartDecompress(inStream);
+        if (ZIP_SUCCESS != status)
+            return status;
+
+        bvector<Byte> outBuf(ZSTD_DStreamOutSize());
+        while (true)
+            {
+            int size = (int)outBuf.size();
+            if (ZIP_SUCCESS != (status = DecompressNextPage(outBuf.data(), &size)) || 0 == size)
+                break;
+
+            uint32_t bytesWritten;
+            if (ZIP_SUCCESS != (status = outStream._Write(outBuf.data(), (uint32_t)size, bytesWritten)))
+                break;
+
+            if (bytesWritten != (uint32_t)size)
+                {
+                status = ZIP_ERROR_WRITE_ERROR;
+                break;
+                }
+            }
+
+        FinishDecompress();
+        return status;
+        }
+
+    ZipErrors DecompressBuffer(bvector<Byte>& out, void const* inputBuffer, uint32_t inputSize)
+        {
+        unsigned long long contentSize = ZSTD_getFrameContentSize(inputBuffer, inputSize);
+        if (ZSTD_CONTENTSIZE_ERROR != contentSize && ZSTD_CONTENTSIZE_UNKNOWN != contentSize)
+            out.reserve(out.size() + (size_t)contentSize);
+
+        MemoryLzmaInStream inStream(inputBuffer, inputSize);
+        MemoryLzmaOutStream outStream(out);
+        return DecompressStream(outStream, inStream);
+        }
+};
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZstdDecoder::ZstdDecoder(ZstdDictionary const* dictionary)
+    {
+    m_impl = new ZstdDecoder::Impl(dictionary);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZstdDecoder::~ZstdDecoder()
+    {
+    delete m_impl;
+    m_impl = nullptr;
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdDecoder::StartDecompress(ILzmaInputStream& inStream)
+    {
+    return m_impl->StartDecompress(inStream);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdDecoder::DecompressNextPage(void* pData, int* pnData)
+    {
+    return m_impl->DecompressNextPage(pData, pnData);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ZstdDecoder::FinishDecompress()
+    {
+    m_impl->FinishDecompress();
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdDecoder::DecompressStream(ILzmaOutputStream& outStream, ILzmaInputStream& inStream)
+    {
+    return m_impl->DecompressStream(outStream, inStream);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ZstdDecoder::DecompressBuffer(bvector<Byte>& out, void const* inputBuffer, uint32_t inputSize)
+    {
+    return m_impl->DecompressBuffer(out, inputBuffer, inputSize);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool ZstdDecoder::IsZstdFrame(void const* data, uint32_t size)
+    {
+    if (size < 4)
+        return false;
+
+    Byte const* bytes = (Byte const*)data;
+    uint32_t magic = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    return ZSTD_MAGICNUMBER == magic;
+    }
+
+END_BENTLEY_SQLITE_NAMESPACE
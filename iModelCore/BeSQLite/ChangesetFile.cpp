@@ -3,13 +3,21 @@
 * See LICENSE.md in the repository root for full copyright notice.
 *--------------------------------------------------------------------------------------------*/
 #include <BeSQLite/ChangesetFile.h>
+#include <BeSQLite/BeZstd.h>
 #include <Bentley/Logging.h>
 #include <Bentley/ScopedArray.h>
+#include <deque>
+#include <future>
 #include <map>
+#include <thread>
 
 USING_NAMESPACE_BENTLEY_SQLITE
 
 #define CHANGESET_FORMAT_VERSION  0x10
+#define CHANGESET_BLOCKS_FORMAT_VERSION  0x11
+#define CHANGESET_BLOCK_SIZE    (4 * 1024 * 1024)
+#define CHANGESET_MAX_BLOCKS_IN_FLIGHT  8
+#define CHANGESET_ZSTD_LEVEL    9
 #define CHANGESET_LZMA_MARKER   "ChangeSetLzma"
 #define JSON_PROP_DDL                   "DDL"
 #define JSON_PROP_ContainsSchemaChanges "ContainsSchemaChanges"
@@ -47,21 +55,28 @@ private:
 
 public:
     static const int formatVersionNumber = CHANGESET_FORMAT_VERSION;
+    static const int blocksFormatVersionNumber = CHANGESET_BLOCKS_FORMAT_VERSION;
     enum CompressionType {
-        LZMA2 = 2
+        LZMA2 = 2,
+        ZSTD = 3, // Only valid in the blocks format
     };
 
-    ChangesetLzmaHeader() {
+    explicit ChangesetLzmaHeader(int version = formatVersionNumber, CompressionType compressionType = LZMA2) {
         CharCP idString = CHANGESET_LZMA_MARKER;
         BeAssert((strlen(idString) + 1) <= sizeof(m_idString));
         memset(this, 0, sizeof(*this));
         m_sizeOfHeader = (uint16_t)sizeof(ChangesetLzmaHeader);
         strcpy(m_idString, idString);
-        m_compressionType = CompressionType::LZMA2;
-        m_formatVersionNumber = formatVersionNumber;
+        m_compressionType = (uint16_t)compressionType;
+        m_formatVersionNumber = (uint16_t)version;
     }
 
+    explicit ChangesetLzmaHeader(ChangesetFileFormat format)
+        : ChangesetLzmaHeader(ChangesetFileFormat::SingleStream == format ? formatVersionNumber : blocksFormatVersionNumber, ChangesetFileFormat::ZstdBlocks == format ? ZSTD : LZMA2) {}
+
     int GetVersion() { return m_formatVersionNumber; }
+    CompressionType GetCompressionType() { return (CompressionType)m_compressionType; }
+    bool IsBlockFormat() { return blocksFormatVersionNumber == m_formatVersionNumber; }
 
     bool IsValid() {
         if (m_sizeOfHeader != sizeof(ChangesetLzmaHeader))
@@ -70,13 +85,293 @@ public:
         if (strcmp(m_idString, CHANGESET_LZMA_MARKER))
             return false;
 
-        if (formatVersionNumber != m_formatVersionNumber)
-            return false;
+        if (formatVersionNumber == m_formatVersionNumber)
+            return m_compressionType == LZMA2;
+
+        if (blocksFormatVersionNumber == m_formatVersionNumber)
+            return m_compressionType == LZMA2 || m_compressionType == ZSTD;
+
+        return false;
+    }
+};
+
+//---------------------------------------------------------------------------------------
+// Maximum number of blocks being compressed or decompressed at the same time.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static size_t getMaxBlocksInFlight() {
+    size_t nThreads = std::thread::hardware_concurrency();
+    return std::min(std::max(nThreads, (size_t)2), (size_t)CHANGESET_MAX_BLOCKS_IN_FLIGHT);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static ZipErrors readFully(ILzmaInputStream& in, void* data, uint32_t size, uint32_t& actuallyRead) {
+    actuallyRead = 0;
+    while (actuallyRead < size) {
+        uint32_t bytesRead = 0;
+        ZipErrors status = in._Read((Byte*)data + actuallyRead, size - actuallyRead, bytesRead);
+        if (ZIP_SUCCESS != status)
+            return status;
+
+        if (0 == bytesRead)
+            break;
+
+        actuallyRead += bytesRead;
+    }
+
+    return ZIP_SUCCESS;
+}
+
+BEGIN_BENTLEY_SQLITE_NAMESPACE
+
+//=======================================================================================
+// Splits the changeset stream into blocks of CHANGESET_BLOCK_SIZE bytes and compresses
+// each into its own LZMA2 (or zstd) stream. Both encoders are used single threaded, so a bounded
+// number of blocks are compressed concurrently and written out in order as they complete.
+// Each block is written as [uncompressed size][compressed size][compressed stream], and an
+// empty block terminates the file.
+// @bsiclass
+//=======================================================================================
+struct ChangesetBlockEncoder {
+private:
+    struct CompressedBlock {
+        ZipErrors m_status = ZIP_SUCCESS;
+        uint32_t m_uncompressedSize = 0;
+        bvector<Byte> m_data;
+    };
+
+    ILzmaOutputStream& m_out;
+    LzmaEncoder::LzmaParams m_params;
+    bool m_useZstd;
+    bvector<Byte> m_pending;
+    std::deque<std::future<CompressedBlock>> m_inFlight;
+    size_t m_maxInFlight;
+    ZipErrors m_status = ZIP_SUCCESS;
+
+    ZipErrors WriteBlockHeader(uint32_t uncompressedSize, uint32_t compressedSize) {
+        Byte sizeBytes[8];
+        UIntToByteArray(sizeBytes, uncompressedSize);
+        UIntToByteArray(sizeBytes + 4, compressedSize);
+        uint32_t bytesWritten;
+        ZipErrors status = m_out._Write(sizeBytes, sizeof(sizeBytes), bytesWritten);
+        return (ZIP_SUCCESS == status && sizeof(sizeBytes) != bytesWritten) ? ZIP_ERROR_WRITE_ERROR : status;
+    }
+
+    ZipErrors WriteNextBlock() {
+        CompressedBlock block = m_inFlight.front().get();
+        m_inFlight.pop_front();
+        if (ZIP_SUCCESS != block.m_status)
+            return block.m_status;
+
+        ZipErrors status = WriteBlockHeader(block.m_uncompressedSize, (uint32_t)block.m_data.size());
+        if (ZIP_SUCCESS != status)
+            return status;
+
+        uint32_t bytesWritten;
+        status = m_out._Write(block.m_data.data(), (uint32_t)block.m_data.size(), bytesWritten);
+        return (ZIP_SUCCESS == status && block.m_data.size() != bytesWritten) ? ZIP_ERROR_WRITE_ERROR : status;
+    }
+
+    ZipErrors SubmitPending() {
+        while (m_inFlight.size() >= m_maxInFlight) {
+            ZipErrors status = WriteNextBlock();
+            if (ZIP_SUCCESS != status)
+                return status;
+        }
+
+        bvector<Byte> input;
+        input.swap(m_pending);
+        LzmaEncoder::LzmaParams params = m_params;
+        bool useZstd = m_useZstd;
+        m_inFlight.push_back(std::async(std::launch::async, [params, useZstd, input = std::move(input)]() {
+            CompressedBlock block;
+            block.m_uncompressedSize = (uint32_t)input.size();
+            if (useZstd) {
+                ZstdEncoder encoder(CHANGESET_ZSTD_LEVEL);
+                block.m_status = encoder.CompressBuffer(block.m_data, input.data(), (uint32_t)input.size());
+                return block;
+            }
+
+            LzmaEncoder encoder(params);
+            block.m_status = encoder.CompressBuffer(block.m_data, input.data(), (uint32_t)input.size());
+            return block;
+        }));
+
+        m_pending.reserve(CHANGESET_BLOCK_SIZE);
+        return ZIP_SUCCESS;
+    }
+
+public:
+    ChangesetBlockEncoder(ILzmaOutputStream& out, LzmaEncoder::LzmaParams const& params, bool useZstd) : m_out(out), m_params(params), m_useZstd(useZstd), m_maxInFlight(getMaxBlocksInFlight()) {
+        // A dictionary larger than a block only costs memory, and every block in flight holds its own.
+        if (m_params.GetDictSize() > CHANGESET_BLOCK_SIZE)
+            m_params.SetDictSize(CHANGESET_BLOCK_SIZE);
+
+        m_pending.reserve(CHANGESET_BLOCK_SIZE);
+    }
+
+    ZipErrors Append(void const* data, uint32_t size) {
+        if (ZIP_SUCCESS != m_status)
+            return m_status;
+
+        Byte const* bytes = (Byte const*)data;
+        while (size > 0) {
+            uint32_t toCopy = std::min(size, (uint32_t)(CHANGESET_BLOCK_SIZE - m_pending.size()));
+            m_pending.insert(m_pending.end(), bytes, bytes + toCopy);
+            bytes += toCopy;
+            size -= toCopy;
+
+            if (m_pending.size() == CHANGESET_BLOCK_SIZE && ZIP_SUCCESS != (m_status = SubmitPending()))
+                return m_status;
+        }
+
+        return ZIP_SUCCESS;
+    }
+
+    ZipErrors Finish() {
+        if (ZIP_SUCCESS == m_status && !m_pending.empty())
+            m_status = SubmitPending();
+
+        while (!m_inFlight.empty()) {
+            ZipErrors status = WriteNextBlock();
+            if (ZIP_SUCCESS == m_status)
+                m_status = status;
+        }
+
+        if (ZIP_SUCCESS == m_status)
+            m_status = WriteBlockHeader(0, 0);
+
+        return m_status;
+    }
+};
+
+//=======================================================================================
+// Reads the blocks written by ChangesetBlockEncoder. The compressed blocks are read on
+// the calling thread, and the blocks that follow the one being consumed are decompressed
+// ahead on other threads.
+// @bsiclass
+//=======================================================================================
+struct ChangesetBlockDecoder {
+private:
+    struct DecompressedBlock {
+        ZipErrors m_status = ZIP_SUCCESS;
+        bvector<Byte> m_data;
+    };
+
+    ILzmaInputStream& m_in;
+    bool m_useZstd;
+    std::deque<std::future<DecompressedBlock>> m_readAhead;
+    size_t m_maxInFlight;
+    bool m_endOfInput = false;
+    ZipErrors m_status = ZIP_SUCCESS;
+    bvector<Byte> m_current;
+    size_t m_currentPos = 0;
+
+    ZipErrors ReadNextBlock() {
+        Byte sizeBytes[8];
+        uint32_t actuallyRead;
+        ZipErrors status = readFully(m_in, sizeBytes, sizeof(sizeBytes), actuallyRead);
+        if (ZIP_SUCCESS != status)
+            return status;
+
+        if (sizeof(sizeBytes) != actuallyRead) {
+            BeAssert(false && "Changeset block stream is truncated");
+            return ZIP_ERROR_END_OF_DATA;
+        }
+
+        uint32_t uncompressedSize = ByteArrayToUInt(sizeBytes);
+        uint32_t compressedSize = ByteArrayToUInt(sizeBytes + 4);
+        if (0 == uncompressedSize && 0 == compressedSize) {
+            m_endOfInput = true;
+            return ZIP_SUCCESS;
+        }
+
+        if (0 == uncompressedSize || uncompressedSize > CHANGESET_BLOCK_SIZE || 0 == compressedSize || compressedSize > 2 * CHANGESET_BLOCK_SIZE) {
+            BeAssert(false && "Invalid changeset block");
+            return ZIP_ERROR_BAD_DATA;
+        }
+
+        bvector<Byte> compressed(compressedSize);
+        status = readFully(m_in, compressed.data(), compressedSize, actuallyRead);
+        if (ZIP_SUCCESS != status)
+            return status;
+
+        if (compressedSize != actuallyRead) {
+            BeAssert(false && "Changeset block stream is truncated");
+            return ZIP_ERROR_END_OF_DATA;
+        }
 
-        return m_compressionType == LZMA2;
+        bool useZstd = m_useZstd;
+        m_readAhead.push_back(std::async(std::launch::async, [uncompressedSize, useZstd, compressed = std::move(compressed)]() {
+            DecompressedBlock block;
+            block.m_data.reserve(uncompressedSize);
+            if (useZstd) {
+                ZstdDecoder decoder;
+                block.m_status = decoder.DecompressBuffer(block.m_data, compressed.data(), (uint32_t)compressed.size());
+            } else {
+                LzmaDecoder decoder;
+                block.m_status = decoder.DecompressBuffer(block.m_data, compressed.data(), (uint32_t)compressed.size());
+            }
+
+            if (ZIP_SUCCESS == block.m_status && uncompressedSize != block.m_data.size())
+                block.m_status = ZIP_ERROR_BAD_DATA;
+            return block;
+        }));
+
+        return ZIP_SUCCESS;
+    }
+
+    ZipErrors FillReadAhead() {
+        while (!m_endOfInput && m_readAhead.size() < m_maxInFlight) {
+            ZipErrors status = ReadNextBlock();
+            if (ZIP_SUCCESS != status)
+                return status;
+        }
+
+        return ZIP_SUCCESS;
+    }
+
+public:
+    ChangesetBlockDecoder(ILzmaInputStream& in, bool useZstd) : m_in(in), m_useZstd(useZstd), m_maxInFlight(getMaxBlocksInFlight()) {}
+
+    //! Same contract as LzmaDecoder::DecompressNextPage: *pSize is set to the number of bytes copied, which is 0 at the end of the stream.
+    ZipErrors Read(Byte* data, int* pSize) {
+        int wanted = *pSize;
+        *pSize = 0;
+        while (ZIP_SUCCESS == m_status && *pSize < wanted) {
+            if (m_currentPos == m_current.size()) {
+                if (ZIP_SUCCESS != (m_status = FillReadAhead()))
+                    break;
+
+                if (m_readAhead.empty())
+                    break;
+
+                DecompressedBlock block = m_readAhead.front().get();
+                m_readAhead.pop_front();
+                if (ZIP_SUCCESS != (m_status = block.m_status))
+                    break;
+
+                m_current.swap(block.m_data);
+                m_currentPos = 0;
+
+                // Start on the next block while the caller consumes this one.
+                m_status = FillReadAhead();
+            }
+
+            size_t toCopy = std::min((size_t)(wanted - *pSize), m_current.size() - m_currentPos);
+            memcpy(data + *pSize, m_current.data() + m_currentPos, toCopy);
+            m_currentPos += toCopy;
+            *pSize += (int)toCopy;
+        }
+
+        return m_status;
     }
 };
 
+END_BENTLEY_SQLITE_NAMESPACE
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -92,7 +387,7 @@ DbResult ChangesetFileWriter::StartOutput() {
         return BE_SQLITE_ERROR;
     }
 
-    ChangesetLzmaHeader header;
+    ChangesetLzmaHeader header(m_format);
     uint32_t bytesWritten;
     ZipErrors zipStatus = m_outLzmaFileStream->_Write(&header, sizeof(header), bytesWritten);
     if (zipStatus != ZIP_SUCCESS) {
@@ -100,7 +395,11 @@ DbResult ChangesetFileWriter::StartOutput() {
         return BE_SQLITE_ERROR;
     }
 
-    zipStatus = m_lzmaEncoder.StartCompress(*m_outLzmaFileStream);
+    if (header.IsBlockFormat())
+        m_blockEncoder = new ChangesetBlockEncoder(*m_outLzmaFileStream, m_lzmaParams, ChangesetLzmaHeader::ZSTD == header.GetCompressionType());
+    else
+        zipStatus = m_lzmaEncoder.StartCompress(*m_outLzmaFileStream);
+
     if (zipStatus != ZIP_SUCCESS) {
         BeAssert(false);
         return BE_SQLITE_ERROR;
@@ -112,14 +411,32 @@ DbResult ChangesetFileWriter::StartOutput() {
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-void ChangesetFileWriter::FinishOutput() {
+DbResult ChangesetFileWriter::FinishOutput() {
     if (m_outLzmaFileStream == nullptr)
-        return;
+        return BE_SQLITE_OK;
 
-    m_lzmaEncoder.FinishCompress();
+    ZipErrors zipStatus;
+    if (nullptr != m_blockEncoder) {
+        zipStatus = m_blockEncoder->Finish();
+        delete m_blockEncoder;
+        m_blockEncoder = nullptr;
+    } else {
+        zipStatus = m_lzmaEncoder.FinishCompress();
+    }
 
     delete m_outLzmaFileStream;
     m_outLzmaFileStream = nullptr;
+    return (zipStatus == ZIP_SUCCESS) ? BE_SQLITE_OK : BE_SQLITE_ERROR;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ChangesetFileWriter::Compress(void const* data, int size) {
+    if (nullptr != m_blockEncoder)
+        return m_blockEncoder->Append(data, (uint32_t)size);
+
+    return m_lzmaEncoder.CompressNextPage(data, size);
 }
 
 //---------------------------------------------------------------------------------------
@@ -131,7 +448,7 @@ DbResult ChangesetFileWriter::_Append(Byte const* pData, int nData) {
         return BE_SQLITE_ERROR;
     }
 
-    ZipErrors zipErrors = m_lzmaEncoder.CompressNextPage(pData, nData);
+    ZipErrors zipErrors = Compress(pData, nData);
     return (zipErrors == ZIP_SUCCESS) ? BE_SQLITE_OK : BE_SQLITE_ERROR;
 }
 
@@ -152,21 +469,21 @@ DbResult ChangesetFileWriter::WritePrefix() {
     Byte sizeBytes[4];
     UIntToByteArray(sizeBytes, size);
 
-    ZipErrors zipErrors = m_lzmaEncoder.CompressNextPage(sizeBytes, 4);
+    ZipErrors zipErrors = Compress(sizeBytes, 4);
     if (zipErrors != ZIP_SUCCESS)
         return BE_SQLITE_ERROR;
 
     if (size == 0)
         return BE_SQLITE_OK;
 
-    zipErrors = m_lzmaEncoder.CompressNextPage(m_prefix.c_str(), size);
+    zipErrors = Compress(m_prefix.c_str(), size);
     return (zipErrors == ZIP_SUCCESS) ? BE_SQLITE_OK : BE_SQLITE_ERROR;
 }
 
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-ChangesetFileWriter::ChangesetFileWriter(BeFileNameCR pathname, bool containsEcSchemaChanges, DdlChangesCR ddlChanges, Db const &dgnDb, BeSQLite::LzmaEncoder::LzmaParams const &lzmaParams) : m_pathname(pathname), m_prefix(""), m_db(dgnDb), m_outLzmaFileStream(nullptr), m_lzmaEncoder(lzmaParams) {
+ChangesetFileWriter::ChangesetFileWriter(BeFileNameCR pathname, bool containsEcSchemaChanges, DdlChangesCR ddlChanges, Db const &dgnDb, BeSQLite::LzmaEncoder::LzmaParams const &lzmaParams, ChangesetFileFormat format) : m_pathname(pathname), m_prefix(""), m_db(dgnDb), m_outLzmaFileStream(nullptr), m_lzmaEncoder(lzmaParams), m_lzmaParams(lzmaParams), m_format(format) {
     m_prefix = "";
     if (!containsEcSchemaChanges && ddlChanges._IsEmpty())
         return;
@@ -179,6 +496,13 @@ ChangesetFileWriter::ChangesetFileWriter(BeFileNameCR pathname, bool containsEcS
     m_prefix = jsonPrefix.Stringify();
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ChangesetFileWriter::ChangesetFileWriter(BeFileNameCR pathname, Utf8StringCR prefix, Db const& db, BeSQLite::LzmaEncoder::LzmaParams const& lzmaParams, ChangesetFileFormat format)
+    : m_pathname(pathname), m_prefix(prefix), m_db(db), m_outLzmaFileStream(nullptr), m_lzmaEncoder(lzmaParams), m_lzmaParams(lzmaParams), m_format(format) {
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -212,6 +536,11 @@ DbResult ChangesetFileReaderBase::Reader::StartInput() {
         return BE_SQLITE_ERROR_InvalidChangeSetVersion;
     }
 
+    if (header.IsBlockFormat()) {
+        m_blockDecoder = new ChangesetBlockDecoder(*m_inLzmaFileStream, ChangesetLzmaHeader::ZSTD == header.GetCompressionType());
+        return ReadPrefix();
+    }
+
     ZipErrors zipStatus = m_lzmaDecoder.StartDecompress(*m_inLzmaFileStream);
     if (zipStatus != ZIP_SUCCESS) {
         BeAssert(false);
@@ -228,11 +557,27 @@ void ChangesetFileReaderBase::Reader::FinishInput() {
     if (m_inLzmaFileStream == nullptr)
         return;
 
-    m_lzmaDecoder.FinishDecompress();
+    if (nullptr != m_blockDecoder) {
+        delete m_blockDecoder;
+        m_blockDecoder = nullptr;
+    } else {
+        m_lzmaDecoder.FinishDecompress();
+    }
+
     delete m_inLzmaFileStream;
     m_inLzmaFileStream = nullptr;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ZipErrors ChangesetFileReaderBase::Reader::Decompress(Byte* pData, int* pnData) {
+    if (nullptr != m_blockDecoder)
+        return m_blockDecoder->Read(pData, pnData);
+
+    return m_lzmaDecoder.DecompressNextPage(pData, pnData);
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -243,7 +588,7 @@ DbResult ChangesetFileReaderBase::Reader::_Read(Byte* pData, int* pnData) {
             return result;
     }
 
-    ZipErrors zipErrors = m_lzmaDecoder.DecompressNextPage(pData, pnData);
+    ZipErrors zipErrors = Decompress(pData, pnData);
     return (zipErrors == ZIP_SUCCESS) ? BE_SQLITE_OK : BE_SQLITE_ERROR;
 }
 
@@ -289,7 +634,7 @@ DbResult ChangesetFileReaderBase::Reader::GetSchemaChanges(bool& containsSchemaC
 BeSQLite::DbResult ChangesetFileReaderBase::Reader::ReadPrefix() {
     Byte sizeBytes[4];
     int readSizeBytes = 4;
-    ZipErrors zipErrors = m_lzmaDecoder.DecompressNextPage((Byte*)sizeBytes, &readSizeBytes);
+    ZipErrors zipErrors = Decompress(sizeBytes, &readSizeBytes);
     if (zipErrors != ZIP_SUCCESS || readSizeBytes != 4) {
         BeAssert(false && "Couldn't read size of the schema changes");
         return BE_SQLITE_ERROR;
@@ -303,7 +648,7 @@ BeSQLite::DbResult ChangesetFileReaderBase::Reader::ReadPrefix() {
     int bytesRead = 0;
     while (bytesRead < size) {
         int readSize = size - bytesRead;
-        zipErrors = m_lzmaDecoder.DecompressNextPage((Byte*)prefixBytes.GetData() + bytesRead, &readSize);
+        zipErrors = Decompress((Byte*)prefixBytes.GetData() + bytesRead, &readSize);
         if (zipErrors != ZIP_SUCCESS) {
             BeAssert(false && "Error reading revision prefix stream");
             return BE_SQLITE_ERROR;
@@ -351,62 +696,6 @@ Utf8String RevisionUtility::GetChangesetId(BeFileName changesetFile) {
     return Utf8String(fileName);
 }
 
-BentleyStatus RevisionUtility::ReadChangesetPrefix(BeSQLite::LzmaDecoder& lzmaDecoder, Utf8StringR prefix) {
-    Byte sizeBytes[4];
-    int readSizeBytes = 4;
-    ZipErrors zipStatus = lzmaDecoder.DecompressNextPage((Byte*)sizeBytes, &readSizeBytes);
-    if (zipStatus != ZIP_SUCCESS || readSizeBytes != 4) {
-        BeAssert(false && "Couldn't read size of the schema changes");
-        return ERROR;
-    }
-
-    const int size = (int)ByteArrayToUInt(sizeBytes);
-    if (size > 0) {
-        ScopedArray<Byte> prefixBytes(size);
-        int bytesRead = 0;
-        while (bytesRead < size) {
-            int readSize = size - bytesRead;
-            zipStatus = lzmaDecoder.DecompressNextPage((Byte*)prefixBytes.GetData() + bytesRead, &readSize);
-            if (zipStatus != ZIP_SUCCESS) {
-                BeAssert(false && "Error reading revision prefix stream");
-                return ERROR;
-            }
-
-            bytesRead += readSize;
-        }
-        BeAssert(bytesRead == size);
-        prefix = (Utf8CP)prefixBytes.GetData();
-    }
-
-    return SUCCESS;
-}
-
-BentleyStatus RevisionUtility::OpenChangesetForReading(BeSQLite::LzmaDecoder& lzmaDecoder, BlockFilesLzmaInStream& inLzmaFileStream)
-    {
-    if (!inLzmaFileStream.IsReady())
-        {
-        BeAssert(false);
-        return ERROR;
-        }
-
-    ChangesetLzmaHeader  header;
-    uint32_t actuallyRead;
-    inLzmaFileStream._Read(&header, sizeof(header), actuallyRead);
-    if (actuallyRead != sizeof(header) || !header.IsValid())
-        {
-        BeAssert(false && "Attempt to read an invalid revision version");
-        return ERROR;
-        }
-
-    ZipErrors zipStatus = lzmaDecoder.StartDecompress(inLzmaFileStream);
-    if (zipStatus != ZIP_SUCCESS)
-        {
-        BeAssert(false);
-        return ERROR;
-        }
-
-    return SUCCESS;
-    }
 BentleyStatus RevisionUtility::ExportPrefixFile(BeFileName targetDir, Utf8StringCR changesetId, Utf8StringCR prefix)
     {
     WString changesetIdW(changesetId.c_str(), true);
@@ -421,27 +710,25 @@ BentleyStatus RevisionUtility::ExportPrefixFile(BeFileName targetDir, Utf8String
     prefixFile.Close();
     return status;
     }
-BentleyStatus RevisionUtility::GetUncompressSize(BeSQLite::LzmaDecoder& lzmaDecoder, uint32_t& uncompressSize)
+BentleyStatus RevisionUtility::GetUncompressSize(Changes::Reader& reader, uint32_t& uncompressSize)
     {
     const int kMaxDecompressBytes = 1024 * 64;
     int decompressBytesRead;
     uncompressSize = 0;
     Byte buffer[kMaxDecompressBytes];
-    ZipErrors zipStatus;
     do
         {
         decompressBytesRead = kMaxDecompressBytes;
-        zipStatus = lzmaDecoder.DecompressNextPage(buffer, &decompressBytesRead);
-        if (zipStatus != ZIP_SUCCESS)
+        if (reader._Read(buffer, &decompressBytesRead) != BE_SQLITE_OK)
             return ERROR;
         uncompressSize += decompressBytesRead;
 
-        } while (zipStatus == ZIP_SUCCESS && decompressBytesRead > 0);
+        } while (decompressBytesRead > 0);
 
     return SUCCESS;
     }
 
-BentleyStatus RevisionUtility::ExportChangesetFile(BeFileName targetDir, Utf8StringCR changesetId, BeSQLite::LzmaDecoder& lzmaDecoder)
+BentleyStatus RevisionUtility::ExportChangesetFile(BeFileName targetDir, Utf8StringCR changesetId, Changes::Reader& reader)
     {
     WString changesetIdW(changesetId.c_str(), true);
     if (!BeFileName::DoesPathExist(targetDir.GetName()))
@@ -454,18 +741,16 @@ BentleyStatus RevisionUtility::ExportChangesetFile(BeFileName targetDir, Utf8Str
     const int kMaxDecompressBytes = 1024 * 64;
     int decompressBytesRead;
     Byte buffer[kMaxDecompressBytes];
-    ZipErrors zipStatus;
     do
         {
         decompressBytesRead = kMaxDecompressBytes;
-        zipStatus = lzmaDecoder.DecompressNextPage(buffer, &decompressBytesRead);
-        if (zipStatus != ZIP_SUCCESS)
+        if (reader._Read(buffer, &decompressBytesRead) != BE_SQLITE_OK)
             return ERROR;
 
         if (decompressBytesRead > 0 && rawChangesetFile.Write(nullptr, buffer, decompressBytesRead) != BeFileStatus::Success)
             return ERROR;
 
-        } while (zipStatus == ZIP_SUCCESS && decompressBytesRead > 0);
+        } while (decompressBytesRead > 0);
     rawChangesetFile.Close();
     return SUCCESS;
     }
@@ -474,49 +759,39 @@ BentleyStatus RevisionUtility::DisassembleRevision(Utf8CP sourceFile, Utf8CP tar
     BeFileName source, target;
     source.SetNameUtf8(sourceFile);
     target.SetNameUtf8(targetDir);
-    BeSQLite::LzmaDecoder lzmaDecoder;
-    BlockFilesLzmaInStream inLzmaFileStream({ source });
     Utf8String changesetId = RevisionUtility::GetChangesetId(source);
+    Db unused;
+    ChangesetFileReaderBase changesetFile({ source }, unused);
+    auto reader = changesetFile.MakeReader();
 
-    if (RevisionUtility::OpenChangesetForReading(lzmaDecoder, inLzmaFileStream) != SUCCESS)
-        return ERROR;
-
-    Utf8String prefix;
-    if (RevisionUtility::ReadChangesetPrefix(lzmaDecoder, prefix) != SUCCESS)
+    DbResult result;
+    Utf8String prefix = reader->GetPrefix(result);
+    if (result != BE_SQLITE_OK)
         return ERROR;
 
     if (!prefix.empty() && RevisionUtility::ExportPrefixFile(target, changesetId, prefix) != SUCCESS)
         return ERROR;
 
-    if (RevisionUtility::ExportChangesetFile(target, changesetId, lzmaDecoder) != SUCCESS)
-        return ERROR;
-
-    lzmaDecoder.FinishDecompress();
-    return SUCCESS;
+    return RevisionUtility::ExportChangesetFile(target, changesetId, *reader);
     }
 
 BentleyStatus RevisionUtility::GetUncompressSize(Utf8CP sourceFile, uint32_t& compressSize, uint32_t &uncompressSize, uint32_t &prefixSize)
     {
     BeFileName source;
     source.SetNameUtf8(sourceFile);
-    BeSQLite::LzmaDecoder lzmaDecoder;
-    BlockFilesLzmaInStream inLzmaFileStream({ source });
     uint64_t diskSize;
     source.GetFileSize(diskSize);
     compressSize = static_cast<uint32_t>(diskSize);
-    if (RevisionUtility::OpenChangesetForReading(lzmaDecoder, inLzmaFileStream) != SUCCESS)
-        return ERROR;
-
-    Utf8String prefix;
-    if (RevisionUtility::ReadChangesetPrefix(lzmaDecoder, prefix) != SUCCESS)
-        return ERROR;
+    Db unused;
+    ChangesetFileReaderBase changesetFile({ source }, unused);
+    auto reader = changesetFile.MakeReader();
 
-    prefixSize = static_cast<uint32_t>(prefix.size());
-    if (RevisionUtility::GetUncompressSize(lzmaDecoder, uncompressSize) != SUCCESS)
+    DbResult result;
+    prefixSize = static_cast<uint32_t>(reader->GetPrefix(result).size());
+    if (result != BE_SQLITE_OK)
         return ERROR;
 
-    lzmaDecoder.FinishDecompress();
-    return SUCCESS;
+    return RevisionUtility::GetUncompressSize(*reader, uncompressSize);
     }
 BentleyStatus RevisionUtility::AssembleRevision(Utf8CP inPrefixFile, Utf8CP inChangesetFile, Utf8CP outputFile, LzmaEncoder::LzmaParams params)
     {
@@ -628,122 +903,28 @@ BentleyStatus RevisionUtility::WritePrefix(BeSQLite::LzmaEncoder& lzmaEncoder, U
 // --------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-BentleyStatus RevisionUtility::RecompressRevision(Utf8CP sourceFile, Utf8CP targetFile, LzmaEncoder::LzmaParams params)
+BentleyStatus RevisionUtility::RecompressRevision(Utf8CP sourceFile, Utf8CP targetFile, LzmaEncoder::LzmaParams params, ChangesetFileFormat format)
     {
     BeFileName source, target;
     source.SetNameUtf8(sourceFile);
     target.SetNameUtf8(targetFile);
-    ZipErrors zipStatus;
-    BeSQLite::LzmaDecoder lzmaDecoder;
-    BlockFilesLzmaInStream inLzmaFileStream({source});
-    if (!inLzmaFileStream.IsReady())
-        {
-        BeAssert(false);
-        return ERROR;
-        }
-
-    ChangesetLzmaHeader  header;
-    uint32_t actuallyRead;
-    inLzmaFileStream._Read(&header, sizeof(header), actuallyRead);
-    if (actuallyRead != sizeof(header) || !header.IsValid())
-        {
-        BeAssert(false && "Attempt to read an invalid revision version");
-        return ERROR;
-        }
-
-    zipStatus = lzmaDecoder.StartDecompress(inLzmaFileStream);
-    if (zipStatus != ZIP_SUCCESS)
-        {
-        BeAssert(false);
-        return ERROR;
-        }
-
-    Byte sizeBytes[4];
-    int readSizeBytes = 4;
-    zipStatus = lzmaDecoder.DecompressNextPage((Byte*)sizeBytes, &readSizeBytes);
-    if (zipStatus != ZIP_SUCCESS || readSizeBytes != 4)
-        {
-        BeAssert(false && "Couldn't read size of the schema changes");
-        return ERROR;
-        }
-    Utf8String prefix;
-    const int prefixSizeRead = (int)ByteArrayToUInt(sizeBytes);
-    if (prefixSizeRead > 0)
-        {
-        ScopedArray<Byte> prefixBytes(prefixSizeRead);
-        int bytesRead = 0;
-        while (bytesRead < prefixSizeRead)
-            {
-            int readSize = prefixSizeRead - bytesRead;
-            zipStatus = lzmaDecoder.DecompressNextPage((Byte*)prefixBytes.GetData() + bytesRead, &readSize);
-            if (zipStatus != ZIP_SUCCESS)
-                {
-                BeAssert(false && "Error reading revision prefix stream");
-                return ERROR;
-                }
-
-            bytesRead += readSize;
-            }
-        BeAssert(bytesRead == prefixSizeRead);
-        prefix = (Utf8CP)prefixBytes.GetData();
-        }
-    // write ========================================================================
-    BeSQLite::LzmaEncoder lzmaEncoder(params);
-    BeFileLzmaOutStream outLzmaFileStream;
-    BeFileName::CreateNewDirectory(target.GetDirectoryName());
-    BeFileStatus fileStatus = outLzmaFileStream.CreateOutputFile(target, true /* createAlways */);
-    if (fileStatus != BeFileStatus::Success)
-        {
-        BeAssert(false);
-        return ERROR;
-        }
+    Db unused;
+    ChangesetFileReaderBase changesetFile({source}, unused);
+    auto reader = changesetFile.MakeReader();
 
-    uint32_t bytesWritten;
-    zipStatus = outLzmaFileStream._Write(&header, sizeof(header), bytesWritten);
-    if (zipStatus != ZIP_SUCCESS)
-        {
-        BeAssert(false);
+    DbResult result;
+    Utf8String prefix = reader->GetPrefix(result);
+    if (result != BE_SQLITE_OK)
         return ERROR;
-        }
 
-    zipStatus = lzmaEncoder.StartCompress(outLzmaFileStream);
-    if (zipStatus != ZIP_SUCCESS)
-        {
-        BeAssert(false);
+    ChangesetFileWriter writer(target, prefix, unused, params, format);
+    if (writer.Initialize() != BE_SQLITE_OK)
         return ERROR;
-        }
 
-    uint32_t prefixSizeWrite = prefix.empty() ? 0 : (uint32_t)prefix.SizeInBytes();
-    UIntToByteArray(sizeBytes, prefixSizeWrite);
-
-    zipStatus = lzmaEncoder.CompressNextPage(sizeBytes, 4);
-    if (zipStatus != ZIP_SUCCESS)
+    if (writer.ReadFrom(*reader) != BE_SQLITE_OK)
         return ERROR;
 
-    if (prefixSizeWrite > 0)
-        {
-        zipStatus = lzmaEncoder.CompressNextPage(prefix.c_str(), prefixSizeWrite);
-        if (zipStatus != ZIP_SUCCESS)
-            return ERROR;
-        }
-    const int kMaxDecompressBytes = 1024 * 64;
-    int decompressBytesRead;
-    Byte buffer[kMaxDecompressBytes];
-    do
-        {
-        decompressBytesRead = kMaxDecompressBytes;
-        zipStatus = lzmaDecoder.DecompressNextPage(buffer, &decompressBytesRead);
-        if (zipStatus != ZIP_SUCCESS)
-            return ERROR;
-
-        if (decompressBytesRead > 0 && lzmaEncoder.CompressNextPage(buffer, decompressBytesRead) != ZIP_SUCCESS )
-            return ERROR;
-
-        } while (zipStatus == ZIP_SUCCESS && decompressBytesRead > 0);
-
-    lzmaDecoder.FinishDecompress();
-    lzmaEncoder.FinishCompress();
-    return SUCCESS;
+    return writer.Finish() == BE_SQLITE_OK ? SUCCESS : ERROR;
     }
 struct OperationStatistics final : NonCopyableClass
     {
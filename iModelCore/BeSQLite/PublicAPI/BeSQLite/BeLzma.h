@@ -209,6 +209,7 @@ struct LzmaEncoder
             LzmaParams& SetNumBlockThreads(int threads) {m_numBlockThreads = threads; return *this;}
             LzmaParams& SetNumTotalThreads(int threads) {m_numTotalThreads = threads; return *this;}
             bool GetSupportRandomAccess() const { return m_supportRandomAccess; }
+            uint32_t GetDictSize() const { return m_dictSize; }
             BE_SQLITE_EXPORT void ToJson(BeJsValue) const;
             BE_SQLITE_EXPORT BentleyStatus FromJson(BeJsConst);
             BE_SQLITE_EXPORT void Normalize();
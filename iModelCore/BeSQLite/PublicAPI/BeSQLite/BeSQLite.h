@@ -1853,6 +1853,14 @@ private:
     BeBriefcaseBasedId GetNextEmbedFileId() const; //!< @private
 
 public:
+    //! The codec used to compress the content of an embedded file.
+    enum class Compression
+    {
+        None = 0,   //!< stored as is
+        Lzma = 2,   //!< LZMA2. Readable by all versions.
+        Zstd = 3,   //!< Zstandard. Larger than LZMA2, but several times faster to extract. Can't be read by versions that predate Zstandard support.
+    };
+
     //=======================================================================================
     //! An Iterator over the entries of a DbEmbeddedFileTable.
     // @bsiclass
@@ -1919,6 +1927,11 @@ public:
     //! @return Id of the embedded file
     BE_SQLITE_EXPORT BeBriefcaseBasedId Import(DbResult* stat, bool compress, Utf8CP name, Utf8CP localFileName, DateTime const* lastModified = nullptr,
         Utf8CP typeStr = nullptr, Utf8CP description = nullptr, uint32_t chunkSize = 500 * 1024, bool supportRandomAccess = true);
+
+    //! Import a copy of an existing file from the local filesystem into this BeSQLite::Db, compressing it with the specified codec.
+    //! @see Import above for the other parameters. supportRandomAccess applies only to Compression::Lzma.
+    BE_SQLITE_EXPORT BeBriefcaseBasedId Import(DbResult* stat, Compression compression, Utf8CP name, Utf8CP localFileName, DateTime const* lastModified = nullptr,
+        Utf8CP typeStr = nullptr, Utf8CP description = nullptr, uint32_t chunkSize = 500 * 1024, bool supportRandomAccess = true);
     BE_SQLITE_EXPORT DbResult ExportDbFile(Utf8CP localFileName, Utf8CP name, ICompressProgressTracker* progress=nullptr);
 
     //! Create a new file on the local file system with a copy of the content of an embedded file, by name.
@@ -1934,7 +1947,7 @@ public:
     //! @return BE_SQLITE_OK if the data was successfully extracted, and error status otherwise.
     BE_SQLITE_EXPORT DbResult Read(ChunkedArray& buffer, Utf8CP name);
 
-    //! Replace the content of a previously embedded file with the content of a different file on the local file system.
+    //! Replace the content of a previously embedded file with the content of a different file on the local file system. The new content is compressed with the same codec as the old.
     //! @param[in] name the name by which the file was embedded.
     //! @param[in] localFileName the name of the new file to be embedded. This method will fail if the file does not exist or cannot be read.
     //! @param[in] chunkSize the maximum number of bytes that are saved in a single blob to hold this file. There are many tradeoffs involved in
@@ -1965,6 +1978,10 @@ public:
     //! @return BE_SQLITE_OK if the entry was successfully saved, and error status otherwise.
     BE_SQLITE_EXPORT DbResult Save(void const* data, uint64_t size, Utf8CP name, DateTime const* lastModified = nullptr, bool compress=true, uint32_t chunkSize=500*1024);
 
+    //! Save an in-memory buffer as the data for an entry in this embedded file table, compressing it with the specified codec.
+    //! @see Save above for the other parameters.
+    BE_SQLITE_EXPORT DbResult Save(void const* data, uint64_t size, Utf8CP name, Compression compression, DateTime const* lastModified = nullptr, uint32_t chunkSize=500*1024);
+
 
     //! Remove an entry from this embedded file table, by name. All of its data will be deleted from the Db.
     //! @param[in] name the name by which the file was embedded.
@@ -2182,7 +2199,10 @@ public:
 
         //! the property value may be compressed before it is saved. The property won't necessarily be compressed unless its size is large enough
         //! (usually 100 bytes) and the actual compression results in a net savings.
-        Yes=1
+        Yes=1,
+
+        //! as Yes, but compressed with Zstandard rather than zlib. Faster to read, but the value can't be read by versions that predate Zstandard support.
+        Zstd=2
     };
 
     enum class Mode {Normal=0, Cached=2,};
@@ -2199,7 +2219,7 @@ public:
     //! @param[in] name The Name part of this Property specification
     //! @param[in] nameSpace The Namespace part of this Property specification.
     //! @param[in] mode the transaction mode for this property.
-    //! @param[in] compress If Compress::Yes, the property value may be compressed before it is saved. The property won't necessarily be compressed unless
+    //! @param[in] compress If Compress::Yes or Compress::Zstd, the property value may be compressed before it is saved. The property won't necessarily be compressed unless
     //!            its size is large enough (usually 100 bytes) and the actual compression results in a net savings.
     //! @param[in] saveIfNull If true, this property will be saved even if its value is nullptr. Otherwise it is deleted if its value is Null.
     //! @note name and namespace should always point to static strings.
@@ -2213,7 +2233,9 @@ public:
 
     bool IsCached()  const {return Mode::Cached == m_mode;}     //!< Determine whether this PropertySpec is cached or not.
     bool SaveIfNull() const {return m_saveIfNull;}              //!< Determine whether this PropertySpec saves NULL values or not.
-    bool IsCompress() const {return Compress::Yes==m_compress;} //!< Determine whether this PropertySpec requests to compress or not.
+    bool IsCompress() const {return Compress::No!=m_compress;}  //!< Determine whether this PropertySpec requests to compress or not.
+    bool IsZstd() const {return Compress::Zstd==m_compress;}    //!< Determine whether this PropertySpec requests to compress with Zstandard.
+    Compress GetCompress() const {return m_compress;}
 };
 
 typedef PropertySpec const& PropertySpecCR;
@@ -2706,6 +2728,9 @@ protected:
     //! @note implementers should always forward this call to their superclass.
     virtual void _OnDbClose() {}
 
+    //! override to write out state that should be on disk along with the database before PerformCheckpoint checkpoints it
+    virtual void _OnBeforeCheckpoint() {}
+
     //! Called when a new transaction is started on a connection, and a different connection (either in the same process or from another process)
     //! has changed the database since the last transaction from this connection was committed. This gives subclasses an opportunity to clear internal
     //! caches or user interface that may now be invalid.
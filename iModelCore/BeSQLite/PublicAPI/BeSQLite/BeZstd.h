@@ -0,0 +1,124 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#pragma once
+#include "BeLzma.h"
+
+BEGIN_BENTLEY_SQLITE_NAMESPACE
+
+//=======================================================================================
+//! A Zstandard dictionary. Small blobs have too little content of their own to compress well;
+//! a dictionary trained on representative samples supplies the shared content up front.
+//! The same dictionary must be supplied to decompress data that was compressed with it.
+// @bsiclass
+//=======================================================================================
+struct ZstdDictionary
+{
+private:
+    bvector<Byte> m_data;
+
+public:
+    ZstdDictionary() {}
+    //! Construct from the bytes of a dictionary previously obtained from GetData
+    ZstdDictionary(void const* data, size_t size) : m_data((Byte const*)data, (Byte const*)data + size) {}
+
+    //! Train a dictionary from a set of sample blobs.
+    //! @param[in] samples The sample blobs. Zstandard needs at least several dozen samples, and ideally about a hundred times as much sample data as maxSize.
+    //! @param[in] maxSize The maximum size of the dictionary in bytes.
+    //! @return ZIP_SUCCESS, or ZIP_ERROR_COMPRESSION_ERROR if the samples are insufficient to train a dictionary.
+    BE_SQLITE_EXPORT ZipErrors Train(bvector<bvector<Byte>> const& samples, uint32_t maxSize = 16 * 1024);
+
+    //! Get the identifier recorded in data compressed with this dictionary, or 0 if this is not a valid dictionary.
+    BE_SQLITE_EXPORT uint32_t GetId() const;
+
+    bool IsEmpty() const { return m_data.empty(); }
+    bvector<Byte> const& GetData() const { return m_data; }
+};
+
+//=======================================================================================
+//! Utility to compress and write streams in the Zstandard format. Zstandard decompresses several times faster
+//! than LZMA at comparable ratios.
+// @bsiclass
+//=======================================================================================
+struct ZstdEncoder
+{
+public:
+    struct Impl;
+
+private:
+    Impl* m_impl;
+
+public:
+    //! Constructor
+    //! @param[in] level Compression level, from 1 (fastest) to 22 (smallest).
+    //! @param[in] dictionary Optional dictionary to compress with. The encoder keeps its own copy.
+    BE_SQLITE_EXPORT explicit ZstdEncoder(int level = 9, ZstdDictionary const* dictionary = nullptr);
+
+    //! Destructor
+    BE_SQLITE_EXPORT ~ZstdEncoder();
+
+    //! Start incremental compression to the supplied output stream
+    //! @param[in] outStream Output stream to write to
+    BE_SQLITE_EXPORT ZipErrors StartCompress(ILzmaOutputStream& outStream);
+
+    //! Write the next page of data after compression
+    //! @param[in] pData Uncompressed buffer of data to be written after compression
+    //! @param[in] nData Size of buffer
+    BE_SQLITE_EXPORT ZipErrors CompressNextPage(void const* pData, int nData);
+
+    //! Finish incremental compression.
+    BE_SQLITE_EXPORT ZipErrors FinishCompress();
+
+    //! Compress the entire contents of supplied input stream to the supplied output stream
+    BE_SQLITE_EXPORT ZipErrors CompressStream(ILzmaOutputStream& out, ILzmaInputStream& in);
+
+    //! Compress a buffer of bytes. The uncompressed size is recorded in the output.
+    BE_SQLITE_EXPORT ZipErrors CompressBuffer(bvector<Byte>& out, void const* input, uint32_t sizeInput);
+};
+
+//=======================================================================================
+//! Utility to read and decompress streams in the Zstandard format
+// @bsiclass
+//=======================================================================================
+struct ZstdDecoder
+{
+public:
+    struct Impl;
+
+private:
+    Impl* m_impl;
+
+public:
+    //! Constructor
+    //! @param[in] dictionary The dictionary the data was compressed with, if any. The decoder keeps its own copy.
+    BE_SQLITE_EXPORT explicit ZstdDecoder(ZstdDictionary const* dictionary = nullptr);
+
+    //! Destructor
+    BE_SQLITE_EXPORT ~ZstdDecoder();
+
+    //! Start incremental decompression from the supplied input stream
+    //! @param[in] inStream Input stream to read from
+    BE_SQLITE_EXPORT ZipErrors StartDecompress(ILzmaInputStream& inStream);
+
+    //! Read and decompress the next page
+    //! @param[out] pData Buffer to copy the data to (allocated by the client)
+    //! @param[in,out] pnData Caller sets this to the size of the buffer. The method then sets it to the actual
+    //! number of bytes copied. If the input is exhausted, the value is set to 0.
+    //! @return ZIP_SUCCESS if successfully extracted data. Returns appropriate error otherwise.
+    BE_SQLITE_EXPORT ZipErrors DecompressNextPage(void* pData, int* pnData);
+
+    //! Finish incremental decompression
+    BE_SQLITE_EXPORT void FinishDecompress();
+
+    //! Decompress the entire contents of the supplied input stream to the supplied output stream
+    BE_SQLITE_EXPORT ZipErrors DecompressStream(ILzmaOutputStream& outStream, ILzmaInputStream& inStream);
+
+    //! Decompress a buffer of bytes
+    BE_SQLITE_EXPORT ZipErrors DecompressBuffer(bvector<Byte>& out, void const* inputBuffer, uint32_t inputSize);
+
+    //! Determine whether a buffer starts with a Zstandard frame
+    BE_SQLITE_EXPORT static bool IsZstdFrame(void const* data, uint32_t size);
+};
+
+END_BENTLEY_SQLITE_NAMESPACE
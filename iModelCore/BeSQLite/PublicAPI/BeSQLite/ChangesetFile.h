@@ -10,6 +10,19 @@
 
 BEGIN_BENTLEY_SQLITE_NAMESPACE
 
+struct ChangesetBlockEncoder;
+struct ChangesetBlockDecoder;
+
+//=======================================================================================
+//! The container formats of changeset files
+// @bsiclass
+//=======================================================================================
+enum class ChangesetFileFormat {
+    SingleStream, //!< The changeset is compressed as a single LZMA2 stream. Readable by all versions.
+    Blocks,       //!< The changeset is split into independently compressed LZMA2 blocks, which are compressed and decompressed on multiple threads.
+    ZstdBlocks,   //!< As Blocks, but compressed with Zstandard. Files are slightly larger, but several times faster to read.
+};
+
 //=======================================================================================
 //! Streams the contents of a file containing serialized change streams
 // @bsiclass
@@ -23,9 +36,11 @@ private:
         ChangesetFileReaderBase const& m_base;
         Utf8String m_prefix = "";
         LzmaDecoder m_lzmaDecoder;
+        ChangesetBlockDecoder* m_blockDecoder = nullptr;
         BlockFilesLzmaInStream* m_inLzmaFileStream = nullptr;
         DbResult StartInput();
         DbResult ReadPrefix();
+        ZipErrors Decompress(Byte* data, int* pSize);
         BE_SQLITE_EXPORT void FinishInput();
         BE_SQLITE_EXPORT Utf8StringCR GetPrefix(DbResult& result);
         BE_SQLITE_EXPORT Reader(ChangesetFileReaderBase const& base) : m_base(base) {}
@@ -54,14 +69,18 @@ public:
 struct EXPORT_VTABLE_ATTRIBUTE ChangesetFileWriter : ChangeStream {
 private:
     BeSQLite::LzmaEncoder m_lzmaEncoder;
+    LzmaEncoder::LzmaParams m_lzmaParams;
+    ChangesetFileFormat m_format;
+    ChangesetBlockEncoder* m_blockEncoder = nullptr;
     BeFileName m_pathname;
     BeFileLzmaOutStream* m_outLzmaFileStream;
     Utf8String m_prefix;
     Db const& m_db; // Only for debugging
 
     DbResult StartOutput();
-    BE_SQLITE_EXPORT void FinishOutput();
+    BE_SQLITE_EXPORT DbResult FinishOutput();
     DbResult WritePrefix();
+    ZipErrors Compress(void const* data, int size);
 
     RefCountedPtr<Changes::Reader> _GetReader() const override { return nullptr; }
     BE_SQLITE_EXPORT DbResult _Append(Byte const* pData, int nData) override;
@@ -70,8 +89,12 @@ private:
 
 public:
     BE_SQLITE_EXPORT ChangesetFileWriter(BeFileNameCR pathname, bool containsEcSchemaChanges, DdlChangesCR ddlChanges, Db const&,
-                                         BeSQLite::LzmaEncoder::LzmaParams const& lzmaParams = BeSQLite::LzmaEncoder::LzmaParams());
+                                         BeSQLite::LzmaEncoder::LzmaParams const& lzmaParams = BeSQLite::LzmaEncoder::LzmaParams(), ChangesetFileFormat format = ChangesetFileFormat::SingleStream);
+    //! Write a changeset whose prefix has already been serialized, e.g. when recompressing an existing changeset file.
+    BE_SQLITE_EXPORT ChangesetFileWriter(BeFileNameCR pathname, Utf8StringCR prefix, Db const&, BeSQLite::LzmaEncoder::LzmaParams const& lzmaParams, ChangesetFileFormat format);
     BE_SQLITE_EXPORT DbResult Initialize();
+    //! Write any buffered data and close the file. Called by the destructor, but only this reports errors.
+    DbResult Finish() { return FinishOutput(); }
     ~ChangesetFileWriter() { FinishOutput(); }
 };
 
@@ -81,17 +104,16 @@ public:
 struct RevisionUtility final {
 private:
     static Utf8String GetChangesetId(BeFileName changesetFile);
-    static BentleyStatus ReadChangesetPrefix(BeSQLite::LzmaDecoder& lzmaDecoder, Utf8StringR prefix);
-    static BentleyStatus OpenChangesetForReading(BeSQLite::LzmaDecoder& lzmaDecoder, BlockFilesLzmaInStream& inLzmaFileStream);
     static BentleyStatus ExportPrefixFile(BeFileName targetDir, Utf8StringCR changesetId, Utf8StringCR prefix);
-    static BentleyStatus ExportChangesetFile(BeFileName targetDir, Utf8StringCR changesetId, BeSQLite::LzmaDecoder& lzmaDecoder);
+    static BentleyStatus ExportChangesetFile(BeFileName targetDir, Utf8StringCR changesetId, Changes::Reader& reader);
     static BentleyStatus WritePrefix(BeSQLite::LzmaEncoder& lzmaEncoder, Utf8StringCR prefix);
     static BentleyStatus WriteChangeset(BeSQLite::LzmaEncoder& lzmaEncoder, BeFileName inChangesetFileName);
-    static BentleyStatus GetUncompressSize(BeSQLite::LzmaDecoder& lzmaDecoder, uint32_t& uncompressSize);
+    static BentleyStatus GetUncompressSize(Changes::Reader& reader, uint32_t& uncompressSize);
 
 public:
     RevisionUtility() = delete;
-    BE_SQLITE_EXPORT static BentleyStatus RecompressRevision(Utf8CP sourceFile, Utf8CP targetFile, LzmaEncoder::LzmaParams param);
+    //! Rewrite a changeset file of either format with the supplied compression parameters in the supplied format.
+    BE_SQLITE_EXPORT static BentleyStatus RecompressRevision(Utf8CP sourceFile, Utf8CP targetFile, LzmaEncoder::LzmaParams param, ChangesetFileFormat format = ChangesetFileFormat::SingleStream);
     BE_SQLITE_EXPORT static BentleyStatus DisassembleRevision(Utf8CP sourceFile, Utf8CP targetDir);
     BE_SQLITE_EXPORT static BentleyStatus AssembleRevision(Utf8CP inPrefixFile, Utf8CP inChangesetFile, Utf8CP outputFile, LzmaEncoder::LzmaParams params = LzmaEncoder::LzmaParams());
     BE_SQLITE_EXPORT static BentleyStatus ComputeStatistics(Utf8CP changesetFile, bool addPrefix, BeJsValue stats);
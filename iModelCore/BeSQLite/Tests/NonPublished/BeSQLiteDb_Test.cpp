@@ -4,6 +4,8 @@
 *--------------------------------------------------------------------------------------------*/
 #include "BeSQLiteNonPublishedTests.h"
 #include "BeSQLite/ChangeSet.h"
+#include "BeSQLite/ChangesetFile.h"
+#include "BeSQLite/BeZstd.h"
 #include <map>
 #include <vector>
 
@@ -845,6 +847,56 @@ TEST_F(BeSQLiteDbTests, Property)
     m_db.SaveChanges();
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Properties compressed with Zstandard, both normal and cached.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(BeSQLiteDbTests, ZstdProperty)
+    {
+    SetupDb(L"Props4.db");
+
+    bvector<Byte> value;
+    for (int i = 0; i < 20000; ++i)
+        value.push_back((Byte) (i % 97));
+
+    PropertySpec normalSpec("ZstdSpec", "TestApplication", PropertySpec::Mode::Normal, PropertySpec::Compress::Zstd);
+    PropertySpec cachedSpec("ZstdCachedSpec", "TestApplication", PropertySpec::Mode::Cached, PropertySpec::Compress::Zstd);
+    ASSERT_EQ(BE_SQLITE_OK, m_db.SaveProperty(normalSpec, value.data(), (uint32_t) value.size()));
+    ASSERT_EQ(BE_SQLITE_OK, m_db.SaveProperty(cachedSpec, value.data(), (uint32_t) value.size()));
+    m_db.SaveChanges();
+
+    // Both are stored compressed, as zstd frames.
+    for (Utf8CP name : {"ZstdSpec", "ZstdCachedSpec"})
+        {
+        Statement stmt;
+        ASSERT_EQ(BE_SQLITE_OK, stmt.Prepare(m_db, "SELECT RawSize,Data FROM " BEDB_TABLE_Property " WHERE Namespace='TestApplication' AND Name=?"));
+        stmt.BindText(1, name, Statement::MakeCopy::No);
+        ASSERT_EQ(BE_SQLITE_ROW, stmt.Step());
+        EXPECT_EQ((int) value.size(), stmt.GetValueInt(0));
+        EXPECT_LT(stmt.GetColumnBytes(1), (int) value.size());
+        EXPECT_TRUE(ZstdDecoder::IsZstdFrame(stmt.GetValueBlob(1), stmt.GetColumnBytes(1)));
+        }
+
+    m_db.CloseDb();
+    ASSERT_EQ(BE_SQLITE_OK, m_db.OpenBeSQLiteDb(getDbFilePath(L"Props4.db"), Db::OpenParams(Db::OpenMode::Readonly)));
+
+    for (PropertySpec const* spec : {&normalSpec, &cachedSpec})
+        {
+        uint32_t size = 0;
+        ASSERT_EQ(BE_SQLITE_ROW, m_db.QueryPropertySize(size, *spec));
+        ASSERT_EQ(value.size(), size);
+
+        bvector<Byte> buffer(size);
+        ASSERT_EQ(BE_SQLITE_ROW, m_db.QueryProperty(buffer.data(), size, *spec));
+        EXPECT_TRUE(value == buffer);
+
+        // A partial read returns the start of the value.
+        Byte start[10];
+        ASSERT_EQ(BE_SQLITE_ROW, m_db.QueryProperty(start, sizeof(start), *spec));
+        EXPECT_EQ(0, memcmp(value.data(), start, sizeof(start)));
+        }
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -1170,6 +1222,75 @@ TEST_F(BeSQLiteEmbeddedFileTests, ReadAddNewEntrySaveEmbeddedFile)
     m_db.SaveChanges();
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(BeSQLiteEmbeddedFileTests, ZstdEmbeddedFile)
+    {
+    SetupDb(L"embeddedfiles.db");
+
+    Utf8CP testFileName = "Bentley_Standard_CustomAttributes.01.13.ecschema.xml";
+    WString testFileNameW(testFileName, BentleyCharEncoding::Utf8);
+
+    BeFileName testFilePath;
+    BeTest::GetHost().GetDgnPlatformAssetsDirectory(testFilePath);
+    testFilePath.AppendToPath(L"ECSchemas");
+    testFilePath.AppendToPath(L"Standard");
+    testFilePath.AppendToPath(testFileNameW.c_str());
+
+    bvector<Byte> expected;
+        {
+        BeFile file;
+        ASSERT_EQ(BeFileStatus::Success, file.Open(testFilePath, BeFileAccess::Read));
+        ASSERT_EQ(BeFileStatus::Success, file.ReadEntireFile(expected));
+        }
+
+    auto readAll = [&](Utf8CP name)
+        {
+        ChunkedArray buffer;
+        EXPECT_EQ(BE_SQLITE_OK, m_db.EmbeddedFiles().Read(buffer, name));
+        bvector<Byte> data;
+        for (auto const& chunk : buffer.m_chunks)
+            data.insert(data.end(), chunk.begin(), chunk.end());
+        return data;
+        };
+
+    DbEmbeddedFileTable& embeddedFileTable = m_db.EmbeddedFiles();
+    DbResult stat = BE_SQLITE_OK;
+    // A small chunk size, so the compressed file spans more than one blob.
+    BeBriefcaseBasedId embeddedFileId = embeddedFileTable.Import(&stat, DbEmbeddedFileTable::Compression::Zstd, testFileName, testFilePath.GetNameUtf8().c_str(), nullptr, "xml", nullptr, 4 * 1024);
+    ASSERT_EQ(BE_SQLITE_OK, stat);
+    ASSERT_TRUE(embeddedFileId.IsValid());
+    EXPECT_TRUE(expected == readAll(testFileName));
+
+    // Replace keeps the codec the file was embedded with.
+    ASSERT_EQ(BE_SQLITE_OK, embeddedFileTable.Replace(testFileName, testFilePath.GetNameUtf8().c_str()));
+    EXPECT_TRUE(expected == readAll(testFileName));
+
+    BeFileName exportFilePath;
+    BeTest::GetHost().GetOutputRoot(exportFilePath);
+    exportFilePath.AppendToPath(L"zstd_");
+    exportFilePath.AppendString(testFileNameW.c_str());
+    deleteExistingFile(exportFilePath);
+    ASSERT_EQ(BE_SQLITE_OK, embeddedFileTable.Export(exportFilePath.GetNameUtf8().c_str(), testFileName));
+    bvector<Byte> exported;
+        {
+        BeFile file;
+        ASSERT_EQ(BeFileStatus::Success, file.Open(exportFilePath, BeFileAccess::Read));
+        ASSERT_EQ(BeFileStatus::Success, file.ReadEntireFile(exported));
+        }
+    EXPECT_TRUE(expected == exported);
+
+    Utf8CP savedName = "saved.xml";
+    ASSERT_EQ(BE_SQLITE_OK, embeddedFileTable.AddEntry(savedName, "xml"));
+    ASSERT_EQ(BE_SQLITE_OK, embeddedFileTable.Save(expected.data(), expected.size(), savedName, DbEmbeddedFileTable::Compression::Zstd));
+    uint64_t size = 0;
+    ASSERT_TRUE(embeddedFileTable.QueryFile(savedName, &size).IsValid());
+    EXPECT_EQ(expected.size(), size);
+    EXPECT_TRUE(expected == readAll(savedName));
+    m_db.SaveChanges();
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //+---------------+---------------+---------------+---------------+---------------+------
@@ -1656,4 +1777,80 @@ TEST_F (BeSQLiteDbTests, Limits)
     ASSERT_EQ(250000000, m_db.GetLimit(DbLimits::VdbeOp));
     ASSERT_EQ(0, m_db.GetLimit(DbLimits::WorkerThreads));
     m_db.AbandonChanges();
-}
\ No newline at end of file
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static bvector<Byte> readAllChanges(ChangeStream const& stream)
+    {
+    bvector<Byte> data;
+    auto reader = stream._GetReader();
+    Byte buffer[64 * 1024];
+    int nRead;
+    do
+        {
+        nRead = (int) sizeof(buffer);
+        EXPECT_EQ(BE_SQLITE_OK, reader->_Read(buffer, &nRead));
+        data.insert(data.end(), buffer, buffer + nRead);
+        } while (nRead > 0);
+
+    return data;
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(BeSQLiteDbTests, ChangesetFileBlockFormat)
+    {
+    SetupDb(L"ChangesetBlocks.db");
+    ASSERT_EQ(BE_SQLITE_OK, m_db.ExecuteSql("CREATE TABLE TestTable ([Id] INTEGER PRIMARY KEY, [Data] TEXT)"));
+
+    MyChangeTracker changeTracker(m_db);
+    changeTracker.EnableTracking(true);
+
+    // Enough data to span more than one compressed block
+    ASSERT_EQ(BE_SQLITE_OK, m_db.ExecuteSql("WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n+1 FROM seq WHERE n < 3000) INSERT INTO TestTable (Data) SELECT hex(randomblob(1024)) FROM seq"));
+
+    MyChangeSet changeSet;
+    ASSERT_EQ(BE_SQLITE_OK, changeSet.FromChangeTrack(changeTracker));
+    changeTracker.EndTracking();
+    bvector<Byte> expected = readAllChanges(changeSet);
+    ASSERT_GT(expected.size(), (size_t) (4 * 1024 * 1024));
+
+    BeFileName outputDir;
+    BeTest::GetHost().GetOutputRoot(outputDir);
+    outputDir.AppendToPath(L"ChangesetBlocks");
+    BeFileName blocksFile = outputDir, singleStreamFile = outputDir, blocksAgainFile = outputDir, zstdFile = outputDir;
+    blocksFile.AppendToPath(L"blocks.changeset");
+    singleStreamFile.AppendToPath(L"singleStream.changeset");
+    blocksAgainFile.AppendToPath(L"blocksAgain.changeset");
+    zstdFile.AppendToPath(L"zstd.changeset");
+
+    DdlChanges ddlChanges;
+    ddlChanges.AddDDL("CREATE TABLE TestTable ([Id] INTEGER PRIMARY KEY, [Data] TEXT)");
+        {
+        ChangesetFileWriter writer(blocksFile, false, ddlChanges, m_db, LzmaEncoder::LzmaParams(), ChangesetFileFormat::Blocks);
+        ASSERT_EQ(BE_SQLITE_OK, writer.Initialize());
+        auto reader = changeSet._GetReader();
+        ASSERT_EQ(BE_SQLITE_OK, writer.ReadFrom(*reader));
+        ASSERT_EQ(BE_SQLITE_OK, writer.Finish());
+        }
+
+    ASSERT_EQ(SUCCESS, RevisionUtility::RecompressRevision(blocksFile.GetNameUtf8().c_str(), singleStreamFile.GetNameUtf8().c_str(), LzmaEncoder::LzmaParams(), ChangesetFileFormat::SingleStream));
+    ASSERT_EQ(SUCCESS, RevisionUtility::RecompressRevision(singleStreamFile.GetNameUtf8().c_str(), blocksAgainFile.GetNameUtf8().c_str(), LzmaEncoder::LzmaParams(), ChangesetFileFormat::Blocks));
+    ASSERT_EQ(SUCCESS, RevisionUtility::RecompressRevision(blocksAgainFile.GetNameUtf8().c_str(), zstdFile.GetNameUtf8().c_str(), LzmaEncoder::LzmaParams(), ChangesetFileFormat::ZstdBlocks));
+
+    for (BeFileNameCR file : {blocksFile, singleStreamFile, blocksAgainFile, zstdFile})
+        {
+        ChangesetFileReaderBase changesetFile({file}, m_db);
+        bool containsSchemaChanges;
+        DdlChanges readDdlChanges;
+        ASSERT_EQ(BE_SQLITE_OK, changesetFile.MakeReader()->GetSchemaChanges(containsSchemaChanges, readDdlChanges));
+        EXPECT_TRUE(containsSchemaChanges);
+        EXPECT_STREQ(ddlChanges.ToString().c_str(), readDdlChanges.ToString().c_str());
+        EXPECT_TRUE(expected == readAllChanges(changesetFile)) << file.GetNameUtf8().c_str();
+        }
+
+    m_db.AbandonChanges();
+    }
@@ -7,6 +7,7 @@
 #include <Bentley/BeTimeUtilities.h>
 #include <BeSQLite/BeSQLite.h>
 #include <BeSQLite/BeLzma.h>
+#include <BeSQLite/BeZstd.h>
 
 #include <zlib/zlib.h>
 #include <zlib/zip/zip.h>
@@ -300,6 +301,68 @@ TEST(CompressionTests, ZipBuffer)
         }
      }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST(CompressionTests, ZstdBuffer)
+    {
+    bvector<Byte> input;
+    for (int i = 0; i < 100000; ++i)
+        input.push_back((Byte) ((i * 7) % 251));
+
+    BeSQLite::ZstdEncoder encoder;
+    bvector<Byte> compressed;
+    ASSERT_EQ(BeSQLite::ZIP_SUCCESS, encoder.CompressBuffer(compressed, input.data(), (uint32_t) input.size()));
+    EXPECT_LT(compressed.size(), input.size());
+    EXPECT_TRUE(BeSQLite::ZstdDecoder::IsZstdFrame(compressed.data(), (uint32_t) compressed.size()));
+
+    BeSQLite::ZstdDecoder decoder;
+    bvector<Byte> uncompressed;
+    ASSERT_EQ(BeSQLite::ZIP_SUCCESS, decoder.DecompressBuffer(uncompressed, compressed.data(), (uint32_t) compressed.size()));
+    EXPECT_TRUE(input == uncompressed);
+
+    // A truncated frame is an error rather than a short result.
+    bvector<Byte> truncated;
+    EXPECT_NE(BeSQLite::ZIP_SUCCESS, decoder.DecompressBuffer(truncated, compressed.data(), (uint32_t) compressed.size() / 2));
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST(CompressionTests, ZstdDictionary)
+    {
+    // Many small, similar blobs: too small to compress well on their own.
+    bvector<bvector<Byte>> samples;
+    for (int i = 0; i < 500; ++i)
+        {
+        Utf8PrintfString json("{\"className\":\"BisCore:PhysicalElement\",\"id\":\"0x%x\",\"model\":\"0x%x\",\"userLabel\":\"Element %d\",\"placement\":{\"origin\":[%d,%d,0]}}", i, i % 7, i, i * 3, i * 5);
+        samples.push_back(bvector<Byte>(json.begin(), json.end()));
+        }
+
+    BeSQLite::ZstdDictionary dictionary;
+    ASSERT_EQ(BeSQLite::ZIP_SUCCESS, dictionary.Train(samples, 4 * 1024));
+    ASSERT_FALSE(dictionary.IsEmpty());
+    EXPECT_NE(0u, dictionary.GetId());
+
+    bvector<Byte> const& blob = samples[42];
+    bvector<Byte> plain, withDictionary;
+    ASSERT_EQ(BeSQLite::ZIP_SUCCESS, BeSQLite::ZstdEncoder().CompressBuffer(plain, blob.data(), (uint32_t) blob.size()));
+    ASSERT_EQ(BeSQLite::ZIP_SUCCESS, BeSQLite::ZstdEncoder(9, &dictionary).CompressBuffer(withDictionary, blob.data(), (uint32_t) blob.size()));
+    EXPECT_LT(withDictionary.size(), plain.size());
+
+    // A dictionary round-trips through its bytes.
+    BeSQLite::ZstdDictionary reloaded(dictionary.GetData().data(), dictionary.GetData().size());
+    EXPECT_EQ(dictionary.GetId(), reloaded.GetId());
+
+    bvector<Byte> uncompressed;
+    ASSERT_EQ(BeSQLite::ZIP_SUCCESS, BeSQLite::ZstdDecoder(&reloaded).DecompressBuffer(uncompressed, withDictionary.data(), (uint32_t) withDictionary.size()));
+    EXPECT_TRUE(blob == uncompressed);
+
+    // Data compressed with a dictionary cannot be decoded without it.
+    bvector<Byte> noDictionary;
+    EXPECT_NE(BeSQLite::ZIP_SUCCESS, BeSQLite::ZstdDecoder().DecompressBuffer(noDictionary, withDictionary.data(), (uint32_t) withDictionary.size()));
+    }
+
 #if defined (RUN_LZMA_ZIP_COMPARISONS)
 struct CompressTestResults
     {
@@ -5,6 +5,7 @@
 #include "ECDbPch.h"
 #include <regex>
 #include <string>
+#include <cmath>
 #include <ECObjects/ECJsonUtilities.h>
 #include <Bentley/Logging.h>
 #include <GeomSerialization/GeomSerializationApi.h>
@@ -15,6 +16,7 @@ using namespace std::chrono_literals;
 using namespace std::chrono;
 #define LIMIT_VAR_COUNT "sys_ecdb_count"
 #define LIMIT_VAR_OFFSET "sys_ecdb_offset"
+#define CURSOR_VAR_KEY "sys_ecdb_cursor_key"
 
 static NativeLogging::CategoryLogger s_logger("ECDb.ConcurrentQuery");
 
@@ -94,6 +96,101 @@ std::shared_ptr<CachedQueryAdaptor> QueryAdaptorCache::TryGet(Utf8CP ecsql, bool
     return newCachedAdaptor;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryAdaptorCache::OpenCursor(std::shared_ptr<CachedQueryAdaptor> adaptor, std::string const& query, std::chrono::seconds idleTimeout) {
+    recursive_guard_t lock(m_mutex);
+    EvictIdleCursors();
+    // a cursor owns its statement, it must not be reset by the next request using the same ecsql.
+    auto iter = std::find(m_cache.begin(), m_cache.end(), adaptor);
+    if (iter != m_cache.end())
+        m_cache.erase(iter);
+
+    if (m_cursors.size() >= kMaxCursors) {
+        auto lru = std::min_element(m_cursors.begin(), m_cursors.end(), [](std::shared_ptr<CachedQueryAdaptor>& lhs, std::shared_ptr<CachedQueryAdaptor>& rhs) {
+            return lhs->GetCursorLastUsed() < rhs->GetCursorLastUsed();
+        });
+        log_trace("%s closing cursor '%s' as connection [id=%" PRIu16 "] has too many open cursors.", GetTimestamp().c_str(), (*lru)->GetCursorToken().c_str(), m_conn.Id());
+        m_cursors.erase(lru);
+    }
+    adaptor->SetCursorToken(Utf8PrintfString("%" PRIu16 ":%" PRIu64, m_conn.Id(), ++m_nextCursorId).c_str());
+    adaptor->SetCursorQuery(query);
+    adaptor->SetCursorIdleTimeout(idleTimeout);
+    adaptor->SetCursorHasMore(false);
+    adaptor->SetCursorNeedsRestart(false);
+    adaptor->ClearCursorRowCount();
+    adaptor->ClearCursorKey();
+    adaptor->TouchCursor();
+    m_cursors.push_back(adaptor);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::shared_ptr<CachedQueryAdaptor> QueryAdaptorCache::TryGetCursor(std::string const& token, std::string const& query) {
+    recursive_guard_t lock(m_mutex);
+    EvictIdleCursors();
+    auto iter = std::find_if(m_cursors.begin(), m_cursors.end(), [&token](std::shared_ptr<CachedQueryAdaptor>& entry) {
+        return entry->GetCursorToken() == token;
+    });
+    if (iter == m_cursors.end())
+        return nullptr;
+
+    if ((*iter)->GetCursorQuery() != query)
+        return nullptr;
+
+    (*iter)->SetCursorHasMore(false);
+    (*iter)->TouchCursor();
+    return *iter;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryAdaptorCache::ReleaseCursor(CachedQueryAdaptor& adaptor) {
+    recursive_guard_t lock(m_mutex);
+    if (adaptor.GetCursorHasMore()) {
+        adaptor.TouchCursor();
+        return;
+    }
+    auto iter = std::find_if(m_cursors.begin(), m_cursors.end(), [&adaptor](std::shared_ptr<CachedQueryAdaptor>& entry) {
+        return entry.get() == &adaptor;
+    });
+    if (iter != m_cursors.end()) {
+        log_trace("%s cursor '%s' closed.", GetTimestamp().c_str(), adaptor.GetCursorToken().c_str());
+        m_cursors.erase(iter);
+    }
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryAdaptorCache::EvictIdleCursors() {
+    recursive_guard_t lock(m_mutex);
+    const auto now = std::chrono::steady_clock::now();
+    auto iter = std::remove_if(m_cursors.begin(), m_cursors.end(), [&now](std::shared_ptr<CachedQueryAdaptor>& entry) {
+        if (now - entry->GetCursorLastUsed() < entry->GetCursorIdleTimeout())
+            return false;
+
+        log_trace("%s cursor '%s' closed after being idle.", GetTimestamp().c_str(), entry->GetCursorToken().c_str());
+        return true;
+    });
+    m_cursors.erase(iter, m_cursors.end());
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool QueryAdaptorCache::TryParseCursorToken(std::string const& token, uint16_t& connId, uint64_t& cursorId) {
+    unsigned int id = 0;
+    if (sscanf(token.c_str(), "%u:%" SCNu64, &id, &cursorId) != 2 || id > std::numeric_limits<uint16_t>::max())
+        return false;
+
+    connId = (uint16_t)id;
+    return true;
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -107,7 +204,17 @@ QueryJsonAdaptor& CachedQueryAdaptor::GetJsonAdaptor() {
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-void CachedConnection::Execute(std::function<void(QueryAdaptorCache&,RunnableRequestBase&)> cb, std::unique_ptr<RunnableRequestBase> request) {
+QueryColumnarAdaptor& CachedQueryAdaptor::GetColumnarAdaptor() {
+    if (!m_columnarAdaptor) {
+         m_columnarAdaptor = std::unique_ptr<QueryColumnarAdaptor>(new QueryColumnarAdaptor(GetJsonAdaptor()));
+    }
+    return *m_columnarAdaptor.get();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void CachedConnection::AttachChangeSummaryCache() {
     recursive_guard_t lock(m_mutexReq);
     if (!m_isChangeSummaryCacheAttached) {
         BeFileName primaryChangeCacheFile;
@@ -119,7 +226,13 @@ void CachedConnection::Execute(std::function<void(QueryAdaptorCache&,RunnableReq
             }
         }
     }
-
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void CachedConnection::Execute(std::function<void(QueryAdaptorCache&,RunnableRequestBase&)> cb, std::unique_ptr<RunnableRequestBase> request) {
+    recursive_guard_t lock(m_mutexReq);
+    AttachChangeSummaryCache();
     SetRequest(std::move(request));
     cb(m_adaptorCache, *m_request);
     ClearRequest();
@@ -127,6 +240,14 @@ void CachedConnection::Execute(std::function<void(QueryAdaptorCache&,RunnableReq
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
+void CachedConnection::Execute(std::function<void(QueryAdaptorCache&)> cb) {
+    recursive_guard_t lock(m_mutexReq);
+    AttachChangeSummaryCache();
+    cb(m_adaptorCache);
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
 void CachedConnection::ClearRequest() {
     recursive_guard_t lock(m_mutexReq);
     m_request = nullptr;
@@ -171,6 +292,13 @@ void CachedConnection::SetAdaptorCacheSize(uint32_t newSize) {
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
+void CachedConnection::EvictIdleCursors() {
+    recursive_guard_t lock(m_mutexReq);
+    m_adaptorCache.EvictIdleCursors();
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
 void CachedConnection::Reset(bool detachDbs) {
     recursive_guard_t lock(m_mutexReq);
     m_adaptorCache.Reset();
@@ -288,6 +416,83 @@ std::shared_ptr<CachedConnection> ConnectionCache::GetConnection() {
     return nullptr;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::shared_ptr<CachedConnection> ConnectionCache::TryGetConnection() {
+    // Interrupt() holds the lock until every connection is released, so a caller holding one must not wait for it.
+    std::unique_lock<recursive_mutex_t> lock(m_mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+        return nullptr;
+
+    return GetConnection();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::shared_ptr<CachedConnection> ConnectionCache::GetConnection(RunnableRequestBase const& request) {
+    if (request.GetRequest().GetKind() == QueryRequest::Kind::ECSql) {
+        auto& token = request.GetRequest().GetAsConst<ECSqlRequest>().GetContinuationToken();
+        uint16_t connId;
+        uint64_t cursorId;
+        if (!token.empty() && QueryAdaptorCache::TryParseCursorToken(token, connId, cursorId)) {
+            recursive_guard_t lock(m_mutex);
+            for (auto& it : m_conns) {
+                // a cursor can only be resumed on the connection that owns its statement.
+                if (it != nullptr && it->Id() == connId)
+                    return it.use_count() == 1 ? it : nullptr;
+            }
+        }
+    }
+    return GetConnection();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::shared_ptr<CachedConnection> ConnectionCache::WaitForConnection(RunnableRequestBase const& request) {
+    std::shared_ptr<CachedConnection> conn;
+    std::unique_lock<std::mutex> lock(m_releasedMutex);
+    m_released.wait(lock, [&]() {
+        conn = GetConnection(request);
+        return conn != nullptr;
+    });
+    return conn;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ConnectionCache::ReleaseConnection(std::shared_ptr<CachedConnection>& conn) {
+    // the reference is dropped first, Interrupt() may hold m_mutex while it waits for it.
+    conn = nullptr;
+    std::lock_guard<std::mutex> lock(m_releasedMutex);
+    m_released.notify_all();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ConnectionCache::SetMaxPoolSize(uint32_t newSize) {
+    m_poolSize = newSize;
+    // a larger pool may have room for the requests waiting for a connection.
+    std::lock_guard<std::mutex> lock(m_releasedMutex);
+    m_released.notify_all();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ConnectionCache::EvictIdleCursors() {
+    recursive_guard_t lock(m_mutex);
+    for (auto& it : m_conns) {
+        // connections in use are skipped, cursors are only closed by the thread that owns the connection.
+        if (it != nullptr && it.use_count() == 1)
+            it->EvictIdleCursors();
+    }
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -457,23 +662,56 @@ QueryResponse::Ptr RunnableRequestBase::CreateBlobIOResponse(std::vector<uint8_t
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-QueryResponse::Ptr RunnableRequestBase::CreateECSqlResponse(std::string& resultJson, QueryProperty::List& meta, uint32_t rowCount, bool done) const {
+QueryResponse::Ptr RunnableRequestBase::CreateECSqlResponse(std::string& resultJson, QueryProperty::List& meta, uint32_t rowCount, bool done, std::string const& continuationToken) const {
     const auto memUsed = (uint32_t)(resultJson.size());
-    return std::make_shared<ECSqlResponse>(
+    auto response = std::make_shared<ECSqlResponse>(
         QueryResponse::Stats(GetCpuTime(), GetTotalTime(), memUsed,m_quota),
         done? QueryResponse::Status::Done:QueryResponse::Status::Partial,
         "",
         resultJson,
         meta,
         rowCount);
+    response->SetContinuationToken(continuationToken);
+    return response;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+QueryResponse::Ptr RunnableRequestBase::CreateECSqlResponse(QueryColumnarResult& result, QueryProperty::List& meta, bool done, std::string const& continuationToken) const {
+    const auto memUsed = (uint32_t)(result.GetByteSize());
+    auto response = std::make_shared<ECSqlResponse>(
+        QueryResponse::Stats(GetCpuTime(), GetTotalTime(), memUsed,m_quota),
+        done? QueryResponse::Status::Done:QueryResponse::Status::Partial,
+        "",
+        result,
+        meta);
+    response->SetContinuationToken(continuationToken);
+    return response;
 }
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-RunnableRequestQueue::RunnableRequestQueue(ECDbCR ecdb): m_nextId(0), m_state(State::Running), m_lastDelayedQueryId(0),m_ecdb(ecdb) {
+RunnableRequestQueue::RunnableRequestQueue(ECDbCR ecdb): m_nextId(0), m_state(State::Running), m_pending(0), m_nextLane(0),
+    m_dequeued(0), m_stolen(0), m_partitioned(0), m_totalWaitTime(0), m_maxWaitTime(0), m_ecdb(ecdb) {
     auto env = ConcurrentQueryMgr::GetConfig(ecdb);
     m_quota = env.GetQuota();
     m_maxQueueSize = env.GetRequestQueueSize();
+    m_ignorePriority = env.GetIgnorePriority();
+    SetLaneCount(1);
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestQueue::SetLaneCount(uint32_t count) {
+    // lanes are created before any executor is started and are never resized while in use.
+    BeAssert(m_pending.load() == 0);
+    if (count < 1)
+        count = 1;
+
+    m_lanes.clear();
+    for (uint32_t i = 0; i < count; ++i)
+        m_lanes.push_back(std::make_unique<Lane>());
 }
 //---------------------------------------------------------------------------------------
 // @bsimethod
@@ -509,74 +747,158 @@ uint32_t RunnableRequestQueue::GetNextId () {
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-void RunnableRequestQueue::InsertSorted(ConnectionCache& conns, std::unique_ptr<RunnableRequestBase>&& request) {
-    guard_t lock(m_mutex);
-    log_trace("%s enqueuing request [id=%" PRIu32 "]", GetTimestamp().c_str(), request->GetId());
-    auto& restartToken = request->GetRequest().GetRestartToken();
-    if (!restartToken.empty()) {
-        log_trace("%s request [id=%" PRIu32 "] has restart token '%s', attempting to cancel any existing request in queue.",GetTimestamp().c_str(), request->GetId(), restartToken.c_str());
-        for (auto it = m_requests.begin(); it != m_requests.end();) {
+RunnableRequestQueue::PriorityClass RunnableRequestQueue::GetPriorityClass(RunnableRequestBase const& request) const {
+    if (m_ignorePriority)
+        return PriorityClass::Normal;
+
+    const auto priority = request.GetRequest().GetPriority();
+    if (priority > 0)
+        return PriorityClass::High;
+    if (priority < 0)
+        return PriorityClass::Low;
+    return PriorityClass::Normal;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestQueue::ForEachLane(std::function<void(std::deque<std::unique_ptr<RunnableRequestBase>>&)> callback) {
+    for (auto& lane : m_lanes) {
+        guard_t lock(lane->m_mutex);
+        for (auto& requests : lane->m_requests)
+            callback(requests);
+    }
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestQueue::CancelRestartToken(ConnectionCache& conns, RunnableRequestBase const& request) {
+    auto& restartToken = request.GetRequest().GetRestartToken();
+    if (restartToken.empty())
+        return;
+
+    log_trace("%s request [id=%" PRIu32 "] has restart token '%s', attempting to cancel any existing request in queue.",GetTimestamp().c_str(), request.GetId(), restartToken.c_str());
+    ForEachLane([&](std::deque<std::unique_ptr<RunnableRequestBase>>& requests) {
+        for (auto it = requests.begin(); it != requests.end();) {
             auto& existingRestartToken = (*it)->GetRequest().GetRestartToken();
             if (restartToken == existingRestartToken) {
                  log_trace("%s found request [id=%" PRIu32 "] with restart token '%s' and will be cancelled in response to request [id=%" PRIu32 "]",
                     GetTimestamp().c_str(),
                     (*it)->GetId(),
                     restartToken.c_str(),
-                    request->GetId());
+                    request.GetId());
                 (*it)->SetResponse((*it)->CreateCancelResponse());
-                it = m_requests.erase(it);
+                it = requests.erase(it);
+                m_pending.fetch_sub(1);
             } else {
                 ++it;
             }
         }
-        log_trace("%s request [id=%" PRIu32 "] has restart token '%s', attempting to interrupt any running query.",GetTimestamp().c_str(), request->GetId(), restartToken.c_str());
-        conns.InterruptIf([&](RunnableRequestBase const& rrb){
-            if (rrb.GetRequest().GetRestartToken() == restartToken) {
-                log_trace("%s found running request [id=%" PRIu32 "] with restart token '%s' and will be cancelled in response to request [id=%" PRIu32 "]",
-                    GetTimestamp().c_str(),
-                    rrb.GetId(),
-                    restartToken.c_str(),
-                    request->GetId());
-                return true;
-            }
-            return false;
-        }, true);
-    }
+    });
+    log_trace("%s request [id=%" PRIu32 "] has restart token '%s', attempting to interrupt any running query.",GetTimestamp().c_str(), request.GetId(), restartToken.c_str());
+    conns.InterruptIf([&](RunnableRequestBase const& rrb){
+        if (rrb.GetRequest().GetRestartToken() == restartToken) {
+            log_trace("%s found running request [id=%" PRIu32 "] with restart token '%s' and will be cancelled in response to request [id=%" PRIu32 "]",
+                GetTimestamp().c_str(),
+                rrb.GetId(),
+                restartToken.c_str(),
+                request.GetId());
+            return true;
+        }
+        return false;
+    }, true);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestQueue::InsertSorted(ConnectionCache& conns, std::unique_ptr<RunnableRequestBase>&& request) {
+    log_trace("%s enqueuing request [id=%" PRIu32 "]", GetTimestamp().c_str(), request->GetId());
+    CancelRestartToken(conns, *request);
     const auto priority = request->GetRequest().GetPriority();
-    for (auto it = m_requests.begin(); it != m_requests.end(); ++ it) {
-        auto cur_priority = it->get()->GetRequest().GetPriority();
-        if (cur_priority > priority) {
-             m_requests.insert( it, std::move(request));
-             return;
+    auto& lane = *m_lanes[m_nextLane.fetch_add(1) % m_lanes.size()];
+    {
+        guard_t lock(lane.m_mutex);
+        auto& requests = lane.m_requests[(int)GetPriorityClass(*request)];
+        // a class is kept in ascending priority. Requests in a class mostly share the same
+        // priority so this is normally an append.
+        auto it = requests.end();
+        if (!m_ignorePriority) {
+            while (it != requests.begin() && (*(it - 1))->GetRequest().GetPriority() > priority)
+                --it;
         }
+        log_trace("%s enqueuing request [id=%" PRIu32 "] complete", GetTimestamp().c_str(), request->GetId());
+        requests.insert(it, std::move(request));
+        m_pending.fetch_add(1);
     }
-    log_trace("%s enqueuing request [id=%" PRIu32 "] complete", GetTimestamp().c_str(), request->GetId());
-    m_requests.insert( m_requests.end(), std::move(request));
+    // take the lock so an executor cannot miss the notification between testing and waiting.
+    guard_t lock(m_mutex);
+    m_cond.notify_one();
 }
 
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::Dequeue() {
-    if (m_requests.empty())
+std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::TryPop(Lane& lane, PriorityClass priorityClass, bool steal) {
+    guard_t lock(lane.m_mutex);
+    auto& requests = lane.m_requests[(int)priorityClass];
+    // a class is in ascending priority so the search starts from the back. Delayed requests are left in place.
+    auto pos = requests.size();
+    for (auto i = requests.size(); i > 0; --i) {
+        auto& request = requests[i - 1];
+        if (pos != requests.size()) {
+            // the owner keeps the newest of the best priority while a thief walks back to the oldest.
+            if (!steal || request->GetRequest().GetPriority() != requests[pos]->GetRequest().GetPriority())
+                break;
+        }
+        if (request->IsReady())
+            pos = i - 1;
+    }
+    if (pos == requests.size())
         return nullptr;
 
-    auto req = std::move(m_requests.back());
-    m_requests.pop_back();
-    if (req->IsReady()) {
-        log_trace("%s dequeued request [id=%" PRIu32 "]", GetTimestamp().c_str(), req->GetId());
-        req->OnDequeued();
-        return req;
-    }
-    if (m_lastDelayedQueryId != req->GetId()) {
-        m_lastDelayedQueryId = req->GetId();
-        log_trace("%s dequeued request [id=%" PRIu32 "] has delay and will be deferred and put back in queue.",GetTimestamp().c_str(), req->GetId());
-    }
-    if (m_requests.size() > 1)
-        m_requests.insert(m_requests.end() - 1, std::move(req));
-    else
-        m_requests.push_back(std::move(req));
+    auto request = std::move(requests[pos]);
+    requests.erase(requests.begin() + pos);
+    m_pending.fetch_sub(1);
+    return request;
+}
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void RunnableRequestQueue::OnDequeued(RunnableRequestBase& request, bool stolen) {
+    request.OnDequeued();
+    const auto waitTime = request.GetWaitTime().count();
+    m_dequeued.fetch_add(1);
+    if (stolen)
+        m_stolen.fetch_add(1);
+
+    m_totalWaitTime.fetch_add(waitTime);
+    auto maxWaitTime = m_maxWaitTime.load();
+    while (waitTime > maxWaitTime && !m_maxWaitTime.compare_exchange_weak(maxWaitTime, waitTime));
+    log_trace("%s dequeued request [id=%" PRIu32 "]%s", GetTimestamp().c_str(), request.GetId(), stolen ? " from another executor lane" : "");
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::Dequeue(uint32_t executorId) {
+    const auto laneCount = (uint32_t)m_lanes.size();
+    const auto ownLane = executorId % laneCount;
+    for (int priorityClass = kPriorityClassCount - 1; priorityClass >= 0; --priorityClass) {
+        if (auto request = TryPop(*m_lanes[ownLane], (PriorityClass)priorityClass, false)) {
+            OnDequeued(*request, false);
+            return request;
+        }
+        for (uint32_t i = 1; i < laneCount; ++i) {
+            if (auto request = TryPop(*m_lanes[(ownLane + i) % laneCount], (PriorityClass)priorityClass, true)) {
+                OnDequeued(*request, true);
+                return request;
+            }
+        }
+    }
+    // only delayed requests are pending.
     std::this_thread::yield();
     return nullptr;
 }
@@ -584,16 +906,40 @@ std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::Dequeue() {
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::WaitForDequeue() {
-    unique_lock_t lock(m_mutex);
-    m_cond.wait(lock, [&](){
-        return !m_requests.empty() || m_state.load() != State::Running;
-    });
+std::unique_ptr<RunnableRequestBase> RunnableRequestQueue::WaitForDequeue(uint32_t executorId) {
+    {
+        unique_lock_t lock(m_mutex);
+        m_cond.wait(lock, [&](){
+            return m_pending.load() > 0 || m_state.load() != State::Running;
+        });
+    }
     if (m_state.load() == State::Running)
-        return Dequeue();
+        return Dequeue(executorId);
 
     return nullptr;
 }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+RunnableRequestQueue::Stats RunnableRequestQueue::GetStats() const {
+    Stats stats;
+    for (auto& lane : m_lanes) {
+        guard_t lock(lane->m_mutex);
+        uint32_t laneDepth = 0;
+        for (uint32_t i = 0; i < kPriorityClassCount; ++i) {
+            stats.m_depth[i] += (uint32_t)lane->m_requests[i].size();
+            laneDepth += (uint32_t)lane->m_requests[i].size();
+        }
+        stats.m_laneDepth.push_back(laneDepth);
+    }
+    stats.m_dequeued = m_dequeued.load();
+    stats.m_stolen = m_stolen.load();
+    stats.m_partitioned = m_partitioned.load();
+    stats.m_totalWaitTime = std::chrono::microseconds(m_totalWaitTime.load());
+    stats.m_maxWaitTime = std::chrono::microseconds(m_maxWaitTime.load());
+    return stats;
+}
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -637,7 +983,7 @@ QueryResponse::Future RunnableRequestQueue::Enqueue(ConnectionCache& conns, Quer
     auto adjustedQuota = AdjustQuota(request->GetQuota());
     auto runnableReq = std::unique_ptr<RunnableRequestBase>(new RunnableRequestWithPromise(*this, std::move(request), adjustedQuota, GetNextId()));
     auto future = ((RunnableRequestWithPromise*)runnableReq.get())->GetFuture();
-    if (m_requests.size() >= m_maxQueueSize) {
+    if (m_pending.load() >= m_maxQueueSize) {
         log_warn("%s queue is full, rejecting request [id=%" PRIu32 "]", GetTimestamp().c_str(), runnableReq->GetId());
         runnableReq->SetResponse(RunnableRequestBase::CreateQueueFullResponse());
     } else  {
@@ -649,7 +995,6 @@ QueryResponse::Future RunnableRequestQueue::Enqueue(ConnectionCache& conns, Quer
                 ExecuteSynchronously(conns, std::move(runnableReq));
             } else {
                 InsertSorted(conns, std::move(runnableReq));
-                m_cond.notify_one();
             }
         }
     }
@@ -671,7 +1016,7 @@ void RunnableRequestQueue::Enqueue(ConnectionCache& conns, QueryRequest::Ptr req
     }
     auto adjustedQuota = AdjustQuota(request->GetQuota());
     auto runnableReq = std::unique_ptr<RunnableRequestBase>(new RunnableRequestWithCallback(*this, std::move(request), adjustedQuota, GetNextId(), onComplete));
-    if (m_requests.size() >= m_maxQueueSize) {
+    if (m_pending.load() >= m_maxQueueSize) {
         log_warn("%s queue is full, rejecting request [id=%" PRIu32 "]", GetTimestamp().c_str(), runnableReq->GetId());
         runnableReq->SetResponse(RunnableRequestBase::CreateQueueFullResponse());
     } else  {
@@ -683,20 +1028,11 @@ void RunnableRequestQueue::Enqueue(ConnectionCache& conns, QueryRequest::Ptr req
                 ExecuteSynchronously(conns, std::move(runnableReq));
             } else {
                 InsertSorted(conns, std::move(runnableReq));
-                m_cond.notify_one();
             }
         }
     }
 }
 
-//---------------------------------------------------------------------------------------
-// @bsimethod
-//---------------------------------------------------------------------------------------
-uint32_t RunnableRequestQueue::Count() {
-    guard_t lock(m_mutex);
-    return (uint32_t)m_requests.size();
-}
-
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -723,10 +1059,14 @@ bool RunnableRequestQueue::Stop() {
     log_trace("%s stopping request queue.", GetTimestamp().c_str());
     m_state.store(State::Stop);
 
+    ForEachLane([&](std::deque<std::unique_ptr<RunnableRequestBase>>& requests) {
+        for(auto & request : requests) {
+            request->SetResponse(request->CreateErrorResponse(QueryResponse::Status::Error,"concurrent query is shutting down"));
+        }
+        m_pending.fetch_sub((uint32_t)requests.size());
+        requests.clear();
+    });
     guard_t lock(m_mutex);
-    for(auto & request : m_requests) {
-        request->SetResponse(request->CreateErrorResponse(QueryResponse::Status::Error,"concurrent query is shutting down"));
-    }
     m_cond.notify_all();
     log_trace("%s request queue stopped.", GetTimestamp().c_str());
     return true;
@@ -736,15 +1076,17 @@ bool RunnableRequestQueue::Stop() {
 // @bsimethod
 //---------------------------------------------------------------------------------------
 void RunnableRequestQueue::RemoveIf (std::function<bool(RunnableRequestBase&)> predicate) {
-    guard_t lock(m_mutex);
-    auto it = m_requests.begin();
-    while(it != m_requests.end()) {
-        if (predicate(*(*it))) {
-            it = m_requests.erase(it);
-        } else {
-            ++it;
+    ForEachLane([&](std::deque<std::unique_ptr<RunnableRequestBase>>& requests) {
+        auto it = requests.begin();
+        while(it != requests.end()) {
+            if (predicate(*(*it))) {
+                it = requests.erase(it);
+                m_pending.fetch_sub(1);
+            } else {
+                ++it;
+            }
         }
-    }
+    });
 }
 
 //---------------------------------------------------------------------------------------
@@ -765,18 +1107,24 @@ bool RunnableRequestQueue::Resume() {
 // @bsimethod
 //---------------------------------------------------------------------------------------
 bool RunnableRequestQueue::CancelRequest(uint32_t id) {
-    guard_t lock(m_mutex);
     log_trace("%s request to cancel [id=%" PRIu32 "]", GetTimestamp().c_str(), id);
-    auto it = std::find_if(std::begin(m_requests), std::end(m_requests), [id](std::unique_ptr<RunnableRequestBase>& v){
-        return v->GetId() == id;
+    bool cancelled = false;
+    ForEachLane([&](std::deque<std::unique_ptr<RunnableRequestBase>>& requests) {
+        if (cancelled)
+            return;
+
+        auto it = std::find_if(std::begin(requests), std::end(requests), [id](std::unique_ptr<RunnableRequestBase>& v){
+            return v->GetId() == id;
+        });
+        if (it != std::end(requests)) {
+            log_trace("%s request [id=%" PRIu32 "] cancelled", GetTimestamp().c_str(), id);
+            (*it)->SetResponse((*it)->CreateCancelResponse());
+            requests.erase(it);
+            m_pending.fetch_sub(1);
+            cancelled = true;
+        }
     });
-    if (it != std::end(m_requests)) {
-        log_trace("%s request [id=%" PRIu32 "] cancelled", GetTimestamp().c_str(), id);
-        (*it)->SetResponse((*it)->CreateCancelResponse());
-        m_requests.erase(it);
-        return true;
-    }
-    return false;
+    return cancelled;
 }
 
 //---------------------------------------------------------------------------------------
@@ -896,6 +1244,88 @@ void QueryHelper::BindLimits(ECSqlStatement& stmt, QueryLimit const& limit) {
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
+void QueryHelper::BindCursorKey(ECSqlStatement& stmt, uint64_t key) {
+    stmt.BindInt64(stmt.GetParameterIndex(CURSOR_VAR_KEY), (int64_t)key);
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static bool ContainsAggregateFunction(ECDbCR primaryDb, Exp const& exp) {
+    static const std::set<std::string> kAggregateFunctions = {"avg", "count", "group_concat", "json_group_array", "json_group_object", "max", "min", "sum", "total"};
+    for (Exp const* funcExp : exp.Find(Exp::Type::FunctionCall, true)) {
+        Utf8String name = funcExp->GetAs<FunctionCallExp>().GetFunctionName();
+        name.ToLower();
+        if (kAggregateFunctions.find(name) != kAggregateFunctions.end())
+            return true;
+
+        for (DbFunction* func : primaryDb.GetSqlFunctions()) {
+            if (func->_IsAggregate() && name.EqualsIAscii(func->GetName()))
+                return true;
+        }
+    }
+    return false;
+}
+//---------------------------------------------------------------------------------------
+// A plain select over a single class that returns its ECInstanceId can be paged by key:
+// the rows are read in ECInstanceId order and each page restarts after the last id returned.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool QueryHelper::TryFormatKeysetQuery(ECDbCR primaryDb, const char* query, std::string& keysetQuery, int& keyColumn) {
+    ECSqlParser parser;
+    std::unique_ptr<Exp> exp = parser.Parse(primaryDb, query, primaryDb.GetImpl().Issues());
+    if (exp == nullptr || exp->GetType() != Exp::Type::Select)
+        return false;
+
+    auto const& selectExp = exp->GetAs<SelectStatementExp>();
+    if (selectExp.IsCompound())
+        return false;
+
+    // the order of the rows has to be free to choose, and every row has to come from exactly one instance.
+    auto const& singleSelect = selectExp.GetFirstStatement();
+    if (singleSelect.IsRowConstructor() || singleSelect.GetSelectionType() == SqlSetQuantifier::Distinct ||
+        singleSelect.GetGroupBy() != nullptr || singleSelect.GetHaving() != nullptr || singleSelect.GetOrderBy() != nullptr ||
+        singleSelect.GetLimitOffset() != nullptr || ContainsAggregateFunction(primaryDb, singleSelect))
+        return false;
+
+    FromExp const* fromExp = singleSelect.GetFrom();
+    if (fromExp == nullptr || fromExp->GetChildrenCount() != 1 || fromExp->GetChildren()[0]->GetType() != Exp::Type::ClassName)
+        return false;
+
+    auto const& classNameExp = fromExp->GetChildren()[0]->GetAs<ClassNameExp>();
+    if (!classNameExp.HasMetaInfo() || classNameExp.GetMemberFunctionCallExp() != nullptr)
+        return false;
+
+    keyColumn = -1;
+    int columnIndex = 0;
+    for (Exp const* derivedPropExp : singleSelect.GetSelection()->GetChildren()) {
+        ValueExp const* valueExp = derivedPropExp->GetAs<DerivedPropertyExp>().GetExpression();
+        if (valueExp != nullptr && valueExp->GetType() == Exp::Type::PropertyName) {
+            auto const& propNameExp = valueExp->GetAs<PropertyNameExp>();
+            if (!propNameExp.IsPropertyRef() && propNameExp.GetClassRefExp() == &classNameExp &&
+                propNameExp.GetSystemPropertyInfo() == ECSqlSystemPropertyInfo::ECInstanceId()) {
+                keyColumn = columnIndex;
+                break;
+            }
+        }
+        ++columnIndex;
+    }
+    if (keyColumn < 0)
+        return false;
+
+    const Utf8String key = classNameExp.GetAlias().empty() ? Utf8String("ECInstanceId") : Utf8PrintfString("[%s].ECInstanceId", classNameExp.GetAlias().c_str());
+    Utf8String condition;
+    if (singleSelect.GetWhere() != nullptr)
+        condition.append("(").append(singleSelect.GetWhere()->GetSearchConditionExp()->ToECSql()).append(") AND ");
+
+    condition.append(key).append(" > :" CURSOR_VAR_KEY);
+    const Utf8String options = singleSelect.GetOptions() != nullptr ? " " + singleSelect.GetOptions()->ToECSql() : Utf8String();
+    keysetQuery = Utf8PrintfString("SELECT %s %s WHERE %s ORDER BY %s LIMIT :" LIMIT_VAR_COUNT " OFFSET :" LIMIT_VAR_OFFSET "%s",
+        singleSelect.GetSelection()->ToECSql().c_str(), fromExp->ToECSql().c_str(), condition.c_str(), key.c_str(), options.c_str());
+    return true;
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
 QueryProperty const& QueryProperty::List::GetPropertyInfo(std::string const& name) const {
     static QueryProperty kNull;
     for(auto& info: *this) {
@@ -988,59 +1418,182 @@ Utf8CP QueryResponse::StatusToString(QueryResponse::Status status) {
     };
     return "Unknow QueryResponse::Status code";
 }
-
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+DbResult QueryHelper::StepPageStart(CachedQueryAdaptor& cachedAdaptor) {
+    auto& stmt = cachedAdaptor.GetStatement();
+    if (cachedAdaptor.IsCursor() && cachedAdaptor.HasCursorKey()) {
+        // a keyset cursor was reset when its last page ended. The offset only applies to the first page.
+        if (cachedAdaptor.GetCursorRowCount() > 0) {
+            stmt.Reset();
+            BindCursorKey(stmt, cachedAdaptor.GetCursorKey());
+            BindLimits(stmt, QueryLimit(-1, 0));
+        }
+    } else if (cachedAdaptor.IsCursor() && cachedAdaptor.GetCursorNeedsRestart()) {
+        // an interrupted statement cannot be stepped further, it is re-executed up to where the last page ended.
+        stmt.Reset();
+        for (uint64_t i = 0; i < cachedAdaptor.GetCursorRowCount(); ++i) {
+            auto rc = stmt.Step();
+            if (rc != BE_SQLITE_ROW)
+                return rc;
+        }
+        cachedAdaptor.SetCursorNeedsRestart(false);
+    }
+    return stmt.Step();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::string QueryHelper::SerializeArgs(ECSqlParams const& args) {
+    ECSqlParams copy(args);
+    Json::Value val;
+    copy.ToJs(val);
+    return val.ToString();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryHelper::Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& runnableRequest) {
+    enum class status { partial, done };
+    auto& request= runnableRequest.GetRequest().GetAsConst<ECSqlRequest>();
+    const auto abbreviateBlobs = request.GetAbbreviateBlobs();
+    const auto includeMetaData= request.GetIncludeMetaData();
+    const auto classIdToClassNames = request.GetConvertClassIdsToClassNames();
+    auto& stmt = cachedAdaptor.GetStatement();
+    auto& adaptor = cachedAdaptor.GetJsonAdaptor();
+    QueryProperty::List props;
+    if (includeMetaData) {
+        adaptor.GetMetaData(props ,stmt);
+    }
+    adaptor.SetAbbreviateBlobs(abbreviateBlobs);
+    adaptor.SetConvertClassIdsToClassNames(classIdToClassNames);
+    adaptor.UseJsNames(request.GetValueFormat() == ECSqlRequest::ECSqlValueFormat::JsNames);
+    uint32_t row_count = 0;
+    // a cursor returns at most one page per request, the rest is read by the next request.
+    const auto pageSize = cachedAdaptor.IsCursor() ? request.GetLimit().GetCount() : -1;
+    std::string& result = cachedAdaptor.ClearAndGetCachedString();
+    result.reserve(QUERY_WORKER_RESULT_RESERVE_BYTES);
+    result.append("[");
+    auto setResult = [&](status st) {
+        result.append("]");
+        if (runnableRequest.IsCancelled())
+            runnableRequest.SetResponse(runnableRequest.CreateCancelResponse());
+        else {
+            if (cachedAdaptor.IsCursor())
+                cachedAdaptor.AddCursorRows(row_count);
+            cachedAdaptor.SetCursorHasMore(cachedAdaptor.IsCursor() && st == status::partial);
+            // a keyset cursor resumes from its last key, it does not keep a read transaction open until the next page.
+            if (cachedAdaptor.HasCursorKey())
+                stmt.Reset();
+            runnableRequest.SetResponse(runnableRequest.CreateECSqlResponse(result, props, row_count, st == status::done, cachedAdaptor.GetCursorHasMore() ? cachedAdaptor.GetCursorToken() : ""));
+        }
+    };
+    auto setError = [&] (QueryResponse::Status status, std::string err) {
+        runnableRequest.SetResponse(runnableRequest.CreateErrorResponse(status, err));
+        log_error("%s. (%s)", err.c_str(), QueryResponse::StatusToString(status));
+    };
+
+    // go over each row and serialize result
+    auto rc = StepPageStart(cachedAdaptor);
+    while (rc == BE_SQLITE_ROW) {
+        auto& rowsDoc = cachedAdaptor.ClearAndGetCachedXmlDocument();
+        BeJsValue rows(rowsDoc);
+        if (adaptor.RenderRow(rows, ECSqlStatementRow(stmt)) != SUCCESS) {
+            setError(QueryResponse::Status::Error_ECSql_RowToJsonFailed, "failed to serialize ecsql statement row to json");
+            return;
+        } else {
+            row_count = row_count + 1;
+            cachedAdaptor.UpdateCursorKey();
+            if (row_count == 1) {
+                result.append(rows.Stringify());
+            } else {
+                result.append(",").append(rows.Stringify());
+            }
+        }
+        if (runnableRequest.IsTimeOrMemoryExceeded(result) || (pageSize > 0 && row_count >= pageSize)) {
+            log_trace("%s time, memory or page size exceeded for request [id=%" PRIu32 "]",GetTimestamp().c_str(), runnableRequest.GetId());
+            setResult(status::partial);
+            return;
+        }
+        rc = stmt.Step();
+    }
+
+    if (rc == BE_SQLITE_INTERRUPT || rc == BE_SQLITE_BUSY) {
+        // an interrupted statement has to be reset, a cursor without a key is re-executed from the start when it is resumed.
+        cachedAdaptor.SetCursorNeedsRestart(cachedAdaptor.IsCursor() && !cachedAdaptor.HasCursorKey());
+        setResult(status::partial);
+    } else if (rc != BE_SQLITE_DONE) {
+        DbResult lastError;
+        std::string sqlStepError = cachedAdaptor.GetWorkerConn()->GetLastError(&lastError);
+        if (lastError != BE_SQLITE_OK) {
+            setError(QueryResponse::Status::Error_ECSql_StepFailed, SqlPrintfString("concurrent query step() failed: %s", sqlStepError.c_str()).GetUtf8CP());
+        }
+        else {
+            setError(QueryResponse::Status::Error_ECSql_StepFailed, "concurrent query step() failed");
+        }
+    } else {
+        setResult(status::done);
+    }
+}
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
-void QueryHelper::Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& runnableRequest) {
+void QueryHelper::ExecuteColumnar(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& runnableRequest) {
     enum class status { partial, done };
     auto& request= runnableRequest.GetRequest().GetAsConst<ECSqlRequest>();
-    const auto abbreviateBlobs = request.GetAbbreviateBlobs();
-    const auto includeMetaData= request.GetIncludeMetaData();
-    const auto classIdToClassNames = request.GetConvertClassIdsToClassNames();
     auto& stmt = cachedAdaptor.GetStatement();
-    auto& adaptor = cachedAdaptor.GetJsonAdaptor();
+    auto& jsonAdaptor = cachedAdaptor.GetJsonAdaptor();
+    auto& adaptor = cachedAdaptor.GetColumnarAdaptor();
     QueryProperty::List props;
-    if (includeMetaData) {
-        adaptor.GetMetaData(props ,stmt);
-    }
-    adaptor.SetAbbreviateBlobs(abbreviateBlobs);
-    adaptor.SetConvertClassIdsToClassNames(classIdToClassNames);
-    adaptor.UseJsNames(request.GetValueFormat() == ECSqlRequest::ECSqlValueFormat::JsNames);
-    uint32_t row_count = 0;
-    std::string& result = cachedAdaptor.ClearAndGetCachedString();
-    result.reserve(QUERY_WORKER_RESULT_RESERVE_BYTES);
-    result.append("[");
+    if (request.GetIncludeMetaData()) {
+        jsonAdaptor.GetMetaData(props ,stmt);
+    }
+    // json adaptor is used for values that cannot be stored in a typed column.
+    jsonAdaptor.SetAbbreviateBlobs(request.GetAbbreviateBlobs());
+    jsonAdaptor.SetConvertClassIdsToClassNames(request.GetConvertClassIdsToClassNames());
+    jsonAdaptor.UseJsNames(request.GetValueFormat() == ECSqlRequest::ECSqlValueFormat::JsNames);
+    adaptor.SetAbbreviateBlobs(request.GetAbbreviateBlobs());
+    // same as the json result, js names also render class ids as class names.
+    adaptor.SetConvertClassIdsToClassNames(request.GetConvertClassIdsToClassNames() || request.GetValueFormat() == ECSqlRequest::ECSqlValueFormat::JsNames);
+
+    QueryColumnarResult result;
+    adaptor.Prepare(result, stmt);
+    const auto pageSize = cachedAdaptor.IsCursor() ? request.GetLimit().GetCount() : -1;
     auto setResult = [&](status st) {
-        result.append("]");
         if (runnableRequest.IsCancelled())
             runnableRequest.SetResponse(runnableRequest.CreateCancelResponse());
-        else
-            runnableRequest.SetResponse(runnableRequest.CreateECSqlResponse(result, props, row_count, st == status::done));
+        else {
+            if (cachedAdaptor.IsCursor())
+                cachedAdaptor.AddCursorRows(result.GetRowCount());
+            cachedAdaptor.SetCursorHasMore(cachedAdaptor.IsCursor() && st == status::partial);
+            if (cachedAdaptor.HasCursorKey())
+                stmt.Reset();
+            runnableRequest.SetResponse(runnableRequest.CreateECSqlResponse(result, props, st == status::done, cachedAdaptor.GetCursorHasMore() ? cachedAdaptor.GetCursorToken() : ""));
+        }
     };
     auto setError = [&] (QueryResponse::Status status, std::string err) {
         runnableRequest.SetResponse(runnableRequest.CreateErrorResponse(status, err));
         log_error("%s. (%s)", err.c_str(), QueryResponse::StatusToString(status));
     };
 
-    // go over each row and serialize result
-    auto rc = stmt.Step();
+    // columns only grow so the size is tracked incrementally instead of summing all buffers per row.
+    size_t resultSize = 0;
+    auto rc = StepPageStart(cachedAdaptor);
     while (rc == BE_SQLITE_ROW) {
-        auto& rowsDoc = cachedAdaptor.ClearAndGetCachedXmlDocument();
-        BeJsValue rows(rowsDoc);
-        if (adaptor.RenderRow(rows, ECSqlStatementRow(stmt)) != SUCCESS) {
-            setError(QueryResponse::Status::Error_ECSql_RowToJsonFailed, "failed to serialize ecsql statement row to json");
+        if (adaptor.AppendRow(result, ECSqlStatementRow(stmt)) != SUCCESS) {
+            setError(QueryResponse::Status::Error_ECSql_RowToJsonFailed, "failed to encode ecsql statement row into columns");
             return;
-        } else {
-            row_count = row_count + 1;
-            if (row_count == 1) {
-                result.append(rows.Stringify());
-            } else {
-                result.append(",").append(rows.Stringify());
-            }
         }
-        if (runnableRequest.IsTimeOrMemoryExceeded(result)) {
-            log_trace("%s time or memory exceeded for request [id=%" PRIu32 "]",GetTimestamp().c_str(), runnableRequest.GetId());
+        cachedAdaptor.UpdateCursorKey();
+        if ((result.GetRowCount() & 0x3f) == 0) {
+            resultSize = result.GetByteSize();
+        }
+        if (runnableRequest.IsTimeOrMemoryExceeded(resultSize) || (pageSize > 0 && result.GetRowCount() >= pageSize)) {
+            log_trace("%s time, memory or page size exceeded for request [id=%" PRIu32 "]",GetTimestamp().c_str(), runnableRequest.GetId());
             setResult(status::partial);
             return;
         }
@@ -1048,6 +1601,8 @@ void QueryHelper::Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase
     }
 
     if (rc == BE_SQLITE_INTERRUPT || rc == BE_SQLITE_BUSY) {
+        // an interrupted statement has to be reset, a cursor without a key is re-executed from the start when it is resumed.
+        cachedAdaptor.SetCursorNeedsRestart(cachedAdaptor.IsCursor() && !cachedAdaptor.HasCursorKey());
         setResult(status::partial);
     } else if (rc != BE_SQLITE_DONE) {
         DbResult lastError;
@@ -1146,6 +1701,592 @@ void QueryHelper::ExecutePing(Json::Value const& pingJson, RunnableRequestBase&
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
+void QueryHelper::Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& runnableRequest, ECSqlRequest::ResultFormat format) {
+    if (format == ECSqlRequest::ResultFormat::Columnar)
+        QueryHelper::ExecuteColumnar(cachedAdaptor, runnableRequest);
+    else
+        QueryHelper::Execute(cachedAdaptor, runnableRequest);
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+PartitionedQuery::SortKey PartitionedQuery::SortKey::From(IECSqlValue const& value) {
+    SortKey key;
+    if (value.IsNull() || !value.GetColumnInfo().GetDataType().IsPrimitive())
+        return key;
+
+    switch (value.GetColumnInfo().GetDataType().GetPrimitiveType()) {
+        case PRIMITIVETYPE_Boolean:
+            key.m_kind = Kind::Number;
+            key.m_int = value.GetBoolean() ? 1 : 0;
+            break;
+        case PRIMITIVETYPE_Integer:
+        case PRIMITIVETYPE_Long:
+            key.m_kind = Kind::Number;
+            key.m_int = value.GetInt64();
+            break;
+        case PRIMITIVETYPE_Double:
+            key.m_kind = Kind::Number;
+            key.m_isReal = true;
+            key.m_real = value.GetDouble();
+            break;
+        case PRIMITIVETYPE_DateTime: {
+            DateTime::Info info;
+            key.m_kind = Kind::Number;
+            key.m_isReal = true;
+            key.m_real = value.GetDateTimeJulianDays(info);
+            break;
+        }
+        case PRIMITIVETYPE_String:
+            key.m_kind = Kind::Text;
+            key.m_bytes = value.GetText();
+            break;
+        default: {
+            int size = 0;
+            auto blob = value.GetBlob(&size);
+            key.m_kind = Kind::Blob;
+            if (blob != nullptr && size > 0)
+                key.m_bytes.assign(static_cast<char const*>(blob), (size_t)size);
+            break;
+        }
+    }
+    return key;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+int PartitionedQuery::SortKey::CompareIntReal(int64_t lhs, double rhs) {
+    if (std::isnan(rhs))
+        return 1;
+
+    // reals outside of the int64 range order before or after every integer.
+    if (rhs < -9223372036854775808.0)
+        return 1;
+
+    if (rhs >= 9223372036854775808.0)
+        return -1;
+
+    // the integral part of the real is exact as int64, only the fraction is left to compare.
+    const int64_t integral = (int64_t)rhs;
+    if (lhs != integral)
+        return lhs < integral ? -1 : 1;
+
+    const double fraction = rhs - (double)integral;
+    return fraction > 0.0 ? -1 : (fraction < 0.0 ? 1 : 0);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+int PartitionedQuery::SortKey::Compare(SortKey const& rhs) const {
+    if (m_kind != rhs.m_kind)
+        return m_kind < rhs.m_kind ? -1 : 1;
+
+    if (m_kind == Kind::Null)
+        return 0;
+
+    if (m_kind == Kind::Number) {
+        if (!m_isReal && !rhs.m_isReal)
+            return m_int < rhs.m_int ? -1 : (m_int > rhs.m_int ? 1 : 0);
+
+        if (!m_isReal)
+            return CompareIntReal(m_int, rhs.m_real);
+
+        if (!rhs.m_isReal)
+            return -CompareIntReal(rhs.m_int, m_real);
+
+        return m_real < rhs.m_real ? -1 : (m_real > rhs.m_real ? 1 : 0);
+    }
+    // text and blobs use the BINARY collation, i.e. bytes compared unsigned and the shorter value first.
+    const int rc = m_bytes.compare(rhs.m_bytes);
+    return rc < 0 ? -1 : (rc > 0 ? 1 : 0);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+int PartitionedQuery::CompareRows(Row const& lhs, Row const& rhs) const {
+    for (size_t i = 0; i < m_descending.size(); ++i) {
+        const int rc = lhs.m_keys[i].Compare(rhs.m_keys[i]);
+        if (rc != 0)
+            return m_descending[i] ? -rc : rc;
+    }
+    return 0;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::unique_ptr<PartitionedQuery> PartitionedQuery::TryCreate(ECDbCR primaryDb, Utf8CP ecsql) {
+    // the request's statement wraps the query to apply limit and offset, which would hide the class scan. The query itself
+    // is split instead and the limit and offset are applied to the merged rows.
+    // preparing memoizes native sql snippets in a cached tree, so it is checked out rather than rendered back to ecsql while another
+    // statement prepares from it. if another statement holds it, or the query was never prepared as is, a private tree is parsed instead.
+    ECSqlParseTreeCache::Lease parseTree = primaryDb.GetImpl().GetECSqlParseTreeCache().CheckOut(ecsql);
+    std::unique_ptr<Exp> privateExp;
+    Exp const* exp = nullptr;
+    if (parseTree.IsValid()) {
+        exp = &parseTree.GetExp();
+    } else {
+        ECSqlParser parser;
+        privateExp = parser.Parse(primaryDb, ecsql, primaryDb.GetImpl().Issues());
+        if (privateExp == nullptr)
+            return nullptr;
+        exp = privateExp.get();
+    }
+    if (exp->GetType() != Exp::Type::Select)
+        return nullptr;
+
+    auto const& selectExp = exp->GetAs<SelectStatementExp>();
+    if (selectExp.IsCompound())
+        return nullptr;
+
+    // only a plain scan can be split, anything that combines rows across tables has to see all of them at once.
+    auto const& singleSelect = selectExp.GetFirstStatement();
+    if (singleSelect.IsRowConstructor() || singleSelect.GetSelectionType() == SqlSetQuantifier::Distinct ||
+        singleSelect.GetGroupBy() != nullptr || singleSelect.GetHaving() != nullptr || singleSelect.GetLimitOffset() != nullptr ||
+        ContainsAggregateFunction(primaryDb, singleSelect))
+        return nullptr;
+
+    FromExp const* fromExp = singleSelect.GetFrom();
+    if (fromExp == nullptr || fromExp->GetChildrenCount() != 1 || fromExp->GetChildren()[0]->GetType() != Exp::Type::ClassName)
+        return nullptr;
+
+    auto const& classNameExp = fromExp->GetChildren()[0]->GetAs<ClassNameExp>();
+    if (!classNameExp.HasMetaInfo() || classNameExp.GetMemberFunctionCallExp() != nullptr ||
+        !classNameExp.GetPolymorphicInfo().IsPolymorphic() || classNameExp.GetPolymorphicInfo().IsDisqualified() ||
+        !(classNameExp.GetTableSpace().empty() || classNameExp.GetTableSpace().EqualsIAscii("main")))
+        return nullptr;
+
+    ClassMap const& classMap = classNameExp.GetInfo().GetMap();
+    StorageDescription const& storage = classMap.GetStorageDescription();
+    if (classMap.GetType() == ClassMap::Type::RelationshipEndTable || !storage.HasMultipleNonVirtualHorizontalPartitions())
+        return nullptr;
+
+    std::unique_ptr<PartitionedQuery> query(new PartitionedQuery());
+    Utf8String sortColumns;
+    bool hasTextSortKey = false;
+    if (OrderByExp const* orderByExp = singleSelect.GetOrderBy()) {
+        // the sort expressions are repeated in the select clause, a parameter would then be bound twice.
+        if (!orderByExp->Find(Exp::Type::Parameter, true).empty() || orderByExp->ToECSql().ContainsI("collate"))
+            return nullptr;
+
+        for (Exp const* specExp : orderByExp->GetChildren()) {
+            auto const& spec = specExp->GetAs<OrderBySpecExp>();
+            auto const& typeInfo = spec.GetSortExpression()->GetTypeInfo();
+            if (!typeInfo.IsNumeric() && !typeInfo.IsBoolean() && !typeInfo.IsDateTime() && !typeInfo.IsString() && !typeInfo.IsBinary())
+                return nullptr;
+
+            hasTextSortKey |= typeInfo.IsString();
+            sortColumns.append(", ").append(spec.GetSortExpression()->ToECSql()).append(" AS ").append(kSortKeyAlias).append(std::to_string(query->m_descending.size()));
+            query->m_descending.push_back(spec.GetSortDirection() == OrderBySpecExp::SortDirection::Descending);
+        }
+    }
+
+    // text keys are merged with the BINARY collation, which has to be the one sqlite sorted each partition with.
+    std::function<bool(DbTable::LinkNode const&)> hasBinaryCollation = [&](DbTable::LinkNode const& node) {
+        for (DbColumn const* column : node.GetTable().GetColumns()) {
+            const auto collation = column->GetConstraints().GetCollation();
+            if (collation != DbColumn::Constraints::Collation::Unset && collation != DbColumn::Constraints::Collation::Binary)
+                return false;
+        }
+        for (DbTable::LinkNode const* child : node.GetChildren()) {
+            if (!hasBinaryCollation(*child))
+                return false;
+        }
+        return true;
+    };
+
+    std::vector<Partition const*> partitions;
+    for (Partition const& partition : storage.GetHorizontalPartitions()) {
+        if (partition.GetTable().GetType() == DbTable::Type::Virtual || partition.GetClassIds().empty())
+            continue;
+
+        if (hasTextSortKey && !hasBinaryCollation(partition.GetTable().GetLinkNode()))
+            return nullptr;
+
+        partitions.push_back(&partition);
+    }
+
+    const Utf8String alias = classNameExp.GetAlias().empty() ? classNameExp.GetClassName() : classNameExp.GetAlias();
+    const Utf8String selection = singleSelect.GetSelection()->ToECSql();
+    const Utf8String where = singleSelect.GetWhere() != nullptr ? singleSelect.GetWhere()->GetSearchConditionExp()->ToECSql() : Utf8String();
+    const Utf8String orderBy = singleSelect.GetOrderBy() != nullptr ? " " + singleSelect.GetOrderBy()->ToECSql() : Utf8String();
+    const Utf8String options = singleSelect.GetOptions() != nullptr ? " " + singleSelect.GetOptions()->ToECSql() : Utf8String();
+    LightweightCache const& lwc = classMap.GetSchemaManager().GetLightweightCache();
+    for (Partition const* partition : partitions) {
+        auto const& classIds = partition->GetClassIds();
+        ECClassCP rootClass = primaryDb.Schemas().GetClass(partition->GetRootClassId());
+        if (rootClass == nullptr)
+            return nullptr;
+
+        // a single class is read with ONLY, a sub hierarchy that lives entirely in this table through its root class.
+        // Anything else keeps the queried class and filters on the class ids of the partition.
+        size_t rootTables = 0;
+        bool rootCoversPartition = false;
+        for (auto const& kvp : lwc.GetHorizontalPartitionsForClass(partition->GetRootClassId())) {
+            if (kvp.first->GetType() == DbTable::Type::Virtual || kvp.second.empty())
+                continue;
+
+            ++rootTables;
+            rootCoversPartition = kvp.first == &partition->GetTable() && kvp.second.size() == classIds.size();
+        }
+
+        Utf8String from;
+        Utf8String classIdFilter;
+        if (classIds.size() == 1)
+            from.Sprintf("ONLY [%s].[%s] [%s]", rootClass->GetSchema().GetName().c_str(), rootClass->GetName().c_str(), alias.c_str());
+        else if (rootTables == 1 && rootCoversPartition)
+            from.Sprintf("[%s].[%s] [%s]", rootClass->GetSchema().GetName().c_str(), rootClass->GetName().c_str(), alias.c_str());
+        else {
+            from.Sprintf("[%s].[%s] [%s]", classMap.GetClass().GetSchema().GetName().c_str(), classMap.GetClass().GetName().c_str(), alias.c_str());
+            classIdFilter.Sprintf("[%s].ECClassId IN (", alias.c_str());
+            for (size_t i = 0; i < classIds.size(); ++i)
+                classIdFilter.append(i == 0 ? "" : ",").append(Utf8PrintfString("%" PRIu64, classIds[i].GetValue()));
+            classIdFilter.append(")");
+        }
+
+        Utf8String partitionECSql;
+        partitionECSql.Sprintf("SELECT %s%s FROM %s", selection.c_str(), sortColumns.c_str(), from.c_str());
+        if (!where.empty() && !classIdFilter.empty())
+            partitionECSql.append(" WHERE (").append(where).append(") AND ").append(classIdFilter);
+        else if (!where.empty())
+            partitionECSql.append(" WHERE ").append(where);
+        else if (!classIdFilter.empty())
+            partitionECSql.append(" WHERE ").append(classIdFilter);
+
+        partitionECSql.append(orderBy).append(options);
+        query->m_ecsql.push_back(partitionECSql);
+    }
+    return query;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void PartitionedQuery::Fail(size_t partition, QueryResponse::Status status, std::string const& error) {
+    {
+    guard_t lock(m_mutex);
+    m_streams[partition].m_errorStatus = status;
+    m_streams[partition].m_error = error;
+    }
+    m_produced.notify_all();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void PartitionedQuery::Produce(QueryAdaptorCache& adaptorCache, std::vector<size_t> const& partitions, RunnableRequestBase const& runnableRequest) {
+    struct Cursor {
+        size_t m_partition;
+        std::shared_ptr<CachedQueryAdaptor> m_adaptor;
+    };
+    auto& request = runnableRequest.GetRequest().GetAsConst<ECSqlRequest>();
+    std::vector<Cursor> cursors;
+    for (size_t partition : partitions) {
+        ECSqlStatus status;
+        std::string err;
+        auto cachedAdaptor = adaptorCache.TryGet(m_ecsql[partition].c_str(), false, request.GetSuppressLogErrors(), status, err);
+        if (cachedAdaptor == nullptr) {
+            const bool interrupted = status.IsSQLiteError() && status.GetSQLiteError() == BE_SQLITE_INTERRUPT;
+            Fail(partition, interrupted ? QueryResponse::Status::Partial : QueryResponse::Status::Error_ECSql_PreparedFailed, err);
+            continue;
+        }
+        if (!request.GetArgs().TryBindTo(cachedAdaptor->GetStatement(), err)) {
+            Fail(partition, QueryResponse::Status::Error_ECSql_BindingFailed, err);
+            continue;
+        }
+        auto& adaptor = cachedAdaptor->GetJsonAdaptor();
+        adaptor.SetAbbreviateBlobs(request.GetAbbreviateBlobs());
+        adaptor.SetConvertClassIdsToClassNames(request.GetConvertClassIdsToClassNames());
+        adaptor.UseJsNames(request.GetValueFormat() == ECSqlRequest::ECSqlValueFormat::JsNames);
+        cursors.push_back({partition, cachedAdaptor});
+    }
+
+    // partitions sharing this connection are stepped in turns so that each of them keeps rows buffered for the merge.
+    std::vector<Row> batch;
+    while (!cursors.empty() && !m_stop.load()) {
+        bool stepped = false;
+        for (auto it = cursors.begin(); it != cursors.end() && !m_stop.load();) {
+            auto& stream = m_streams[it->m_partition];
+            size_t room;
+            {
+            guard_t lock(m_mutex);
+            room = stream.m_rows.size() < kMaxBufferedRows ? kMaxBufferedRows - stream.m_rows.size() : 0;
+            }
+            if (room == 0) {
+                ++it;
+                continue;
+            }
+            stepped = true;
+            auto& stmt = it->m_adaptor->GetStatement();
+            auto& adaptor = it->m_adaptor->GetJsonAdaptor();
+            const int columnCount = stmt.GetColumnCount() - (int)m_descending.size();
+            bool renderFailed = false;
+            DbResult rc = BE_SQLITE_ROW;
+            batch.clear();
+            while (batch.size() < room && !m_stop.load() && (rc = stmt.Step()) == BE_SQLITE_ROW) {
+                auto& rowsDoc = it->m_adaptor->ClearAndGetCachedXmlDocument();
+                BeJsValue rowJson(rowsDoc);
+                if (adaptor.RenderRow(rowJson, ECSqlStatementRow(stmt, columnCount)) != SUCCESS) {
+                    renderFailed = true;
+                    break;
+                }
+                Row row;
+                row.m_json = rowJson.Stringify();
+                for (int i = columnCount; i < stmt.GetColumnCount(); ++i)
+                    row.m_keys.push_back(SortKey::From(stmt.GetValue(i)));
+
+                batch.push_back(std::move(row));
+            }
+            const bool finished = renderFailed || rc != BE_SQLITE_ROW;
+            {
+            guard_t lock(m_mutex);
+            for (auto& row : batch)
+                stream.m_rows.push_back(std::move(row));
+
+            if (renderFailed) {
+                stream.m_errorStatus = QueryResponse::Status::Error_ECSql_RowToJsonFailed;
+                stream.m_error = "failed to serialize ecsql statement row to json";
+            } else if (rc == BE_SQLITE_DONE) {
+                stream.m_done = true;
+            } else if (rc == BE_SQLITE_INTERRUPT || rc == BE_SQLITE_BUSY) {
+                stream.m_errorStatus = QueryResponse::Status::Partial;
+            } else if (rc != BE_SQLITE_ROW) {
+                DbResult lastError;
+                std::string sqlStepError = adaptorCache.GetConnection().GetDb().GetLastError(&lastError);
+                stream.m_errorStatus = QueryResponse::Status::Error_ECSql_StepFailed;
+                stream.m_error = lastError != BE_SQLITE_OK ? SqlPrintfString("concurrent query step() failed: %s", sqlStepError.c_str()).GetUtf8CP() : "concurrent query step() failed";
+            }
+            }
+            m_produced.notify_all();
+            if (finished) {
+                stmt.Reset();
+                it = cursors.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (!stepped) {
+            unique_lock_t lock(m_mutex);
+            m_consumed.wait(lock, [&]() {
+                if (m_stop.load())
+                    return true;
+                for (auto& cursor : cursors) {
+                    if (m_streams[cursor.m_partition].m_rows.size() < kMaxBufferedRows)
+                        return true;
+                }
+                return false;
+            });
+        }
+    }
+    // an open statement would keep the read transaction of the connection alive.
+    for (auto& cursor : cursors)
+        cursor.m_adaptor->GetStatement().Reset();
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+PartitionedQuery::NextResult PartitionedQuery::Next(Row& row, QueryResponse::Status& errorStatus, std::string& error, RunnableRequestBase const& runnableRequest) {
+    unique_lock_t lock(m_mutex);
+    while (true) {
+        Stream* next = nullptr;
+        Stream* failed = nullptr;
+        bool ready = true;
+        if (IsOrdered()) {
+            // the smallest head wins, on a tie the lower partition so the order is the same on every execution.
+            for (auto& stream : m_streams) {
+                if (stream.m_rows.empty()) {
+                    if (stream.HasError()) {
+                        failed = &stream;
+                        break;
+                    }
+                    if (!stream.m_done)
+                        ready = false;
+
+                    continue;
+                }
+                if (next == nullptr || CompareRows(stream.m_rows.front(), next->m_rows.front()) < 0)
+                    next = &stream;
+            }
+        } else {
+            while (m_current < m_streams.size() && m_streams[m_current].m_rows.empty() && m_streams[m_current].m_done)
+                ++m_current;
+
+            if (m_current < m_streams.size()) {
+                auto& stream = m_streams[m_current];
+                if (!stream.m_rows.empty())
+                    next = &stream;
+                else if (stream.HasError())
+                    failed = &stream;
+                else
+                    ready = false;
+            }
+        }
+        if (failed != nullptr) {
+            errorStatus = failed->m_errorStatus;
+            error = failed->m_error;
+            return errorStatus == QueryResponse::Status::Partial ? NextResult::Interrupted : NextResult::Error;
+        }
+        if (ready) {
+            if (next == nullptr)
+                return NextResult::Done;
+
+            row = std::move(next->m_rows.front());
+            next->m_rows.pop_front();
+            lock.unlock();
+            m_consumed.notify_all();
+            return NextResult::Row;
+        }
+        if (runnableRequest.IsCancelled() || runnableRequest.IsTimeExceeded())
+            return NextResult::Interrupted;
+
+        m_produced.wait_for(lock, 100ms);
+    }
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool PartitionedQuery::Execute(QueryAdaptorCache& adaptorCache, CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& runnableRequest) {
+    enum class status { partial, done };
+    auto& request = runnableRequest.GetRequest().GetAsConst<ECSqlRequest>();
+    // rendering a parse tree back to ecsql is not lossless for every construct, such queries run unsplit. Preparing the
+    // partitions here also caches their parse trees, so the pool connections below do not parse them again.
+    for (auto const& partitionECSql : m_ecsql) {
+        ECSqlStatus prepareStatus;
+        std::string err;
+        if (adaptorCache.TryGet(partitionECSql.c_str(), false, true, prepareStatus, err) == nullptr) {
+            log_trace("%s request [id=%" PRIu32 "] runs unsplit, partition failed to prepare: %s", GetTimestamp().c_str(), runnableRequest.GetId(), err.c_str());
+            return false;
+        }
+    }
+
+    // the unsplit statement is only used for the column metadata.
+    QueryProperty::List props;
+    if (request.GetIncludeMetaData()) {
+        auto& adaptor = cachedAdaptor.GetJsonAdaptor();
+        adaptor.GetMetaData(props, cachedAdaptor.GetStatement());
+    }
+
+    m_streams.clear();
+    m_streams.resize(m_ecsql.size());
+    m_current = 0;
+    m_stop.store(false);
+
+    // idle pool connections take one partition each, partitions left over share them round robin. Each connection
+    // reads its own snapshot in WAL mode, the partitions then share the request's connection to see the same data.
+    // Otherwise the read lock taken here keeps writers from committing until every borrowed connection is reading.
+    auto& connCache = adaptorCache.GetConnection().GetConnectionCache();
+    std::vector<std::shared_ptr<CachedConnection>> conns;
+    // borrowed connections are handed back after the producers below are done with them, waking executors waiting for one.
+    struct BorrowedConnections {
+        ConnectionCache& m_cache;
+        std::vector<std::shared_ptr<CachedConnection>>& m_conns;
+        ~BorrowedConnections() {
+            for (auto& conn : m_conns)
+                m_cache.ReleaseConnection(conn);
+        }
+    } borrowed {connCache, conns};
+    auto& requestDb = adaptorCache.GetConnection().GetDbR();
+    const bool canBorrow = !requestDb.IsWalMode() && BE_SQLITE_OK == requestDb.TryExecuteSql("SELECT 1 FROM sqlite_master LIMIT 1");
+    const size_t maxBorrowed = std::min(kMaxBorrowedConnections, (size_t)connCache.GetMaxPoolSize() / 2);
+    while (canBorrow && conns.size() < maxBorrowed && conns.size() + 1 < m_ecsql.size()) {
+        auto conn = connCache.TryGetConnection();
+        if (conn == nullptr)
+            break;
+
+        conns.push_back(conn);
+    }
+    std::vector<std::vector<size_t>> assignments(conns.size() + 1);
+    for (size_t i = 0; i < m_ecsql.size(); ++i)
+        assignments[i % assignments.size()].push_back(i);
+
+    runnableRequest.GetQueue().OnPartitioned();
+    log_trace("%s request [id=%" PRIu32 "] split into %" PRIu64 " partitions on %" PRIu64 " connections", GetTimestamp().c_str(), runnableRequest.GetId(), (uint64_t)m_ecsql.size(), (uint64_t)assignments.size());
+    std::vector<std::future<void>> producers;
+    producers.push_back(std::async(std::launch::async, [&]() {
+        Produce(adaptorCache, assignments[0], runnableRequest);
+    }));
+    for (size_t i = 0; i < conns.size(); ++i) {
+        producers.push_back(std::async(std::launch::async, [&, i]() {
+            conns[i]->Execute([&](QueryAdaptorCache& partitionCache) {
+                Savepoint txn(partitionCache.GetConnection().GetDbR(), "concurrent_query");
+                Produce(partitionCache, assignments[i + 1], runnableRequest);
+            });
+        }));
+    }
+    // connections are not interrupted, they may own cursors of other requests. Producers stop after their current step.
+    auto stopProducers = [&]() {
+        m_stop.store(true);
+        m_consumed.notify_all();
+        for (auto& producer : producers)
+            producer.wait();
+    };
+
+    const auto count = request.GetLimit().GetCount();
+    const auto offset = request.GetLimit().GetOffset();
+    int64_t skipped = 0;
+    uint32_t row_count = 0;
+    std::string& result = cachedAdaptor.ClearAndGetCachedString();
+    result.reserve(QUERY_WORKER_RESULT_RESERVE_BYTES);
+    result.append("[");
+    auto setResult = [&](status st) {
+        stopProducers();
+        result.append("]");
+        if (runnableRequest.IsCancelled())
+            runnableRequest.SetResponse(runnableRequest.CreateCancelResponse());
+        else
+            runnableRequest.SetResponse(runnableRequest.CreateECSqlResponse(result, props, row_count, st == status::done));
+    };
+    auto setError = [&] (QueryResponse::Status st, std::string const& err) {
+        stopProducers();
+        runnableRequest.SetResponse(runnableRequest.CreateErrorResponse(st, err));
+        log_error("%s. (%s)", err.c_str(), QueryResponse::StatusToString(st));
+    };
+
+    Row row;
+    QueryResponse::Status errorStatus;
+    std::string error;
+    while (true) {
+        if (count >= 0 && row_count >= count) {
+            setResult(status::done);
+            return true;
+        }
+        switch (Next(row, errorStatus, error, runnableRequest)) {
+            case NextResult::Done:
+                setResult(status::done);
+                return true;
+            case NextResult::Interrupted:
+                setResult(status::partial);
+                return true;
+            case NextResult::Error:
+                setError(errorStatus, error);
+                return true;
+            case NextResult::Row:
+                break;
+        }
+        if (skipped < offset) {
+            ++skipped;
+            continue;
+        }
+        row_count = row_count + 1;
+        if (row_count > 1)
+            result.append(",");
+
+        result.append(row.m_json);
+        if (runnableRequest.IsTimeOrMemoryExceeded(result)) {
+            log_trace("%s time or memory exceeded for partitioned request [id=%" PRIu32 "]",GetTimestamp().c_str(), runnableRequest.GetId());
+            setResult(status::partial);
+            return true;
+        }
+    }
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
 void QueryHelper::Execute(QueryAdaptorCache& adaptorCache, RunnableRequestBase& runnableRequest) {
     auto setError = [&] (QueryResponse::Status status, std::string err) {
         runnableRequest.SetResponse(runnableRequest.CreateErrorResponse(status, err));
@@ -1169,9 +2310,43 @@ void QueryHelper::Execute(QueryAdaptorCache& adaptorCache, RunnableRequestBase&
             }
         }
         std::string sql = QueryHelper::FormatQuery(request.GetQuery().c_str());
+        const bool isCursorRequest = request.GetUseCursor() || !request.GetContinuationToken().empty();
+        if (isCursorRequest && request.UsePrimaryConnection()) {
+            // the primary connection is shared with the application, a statement cannot be kept open on it between requests.
+            setError(QueryResponse::Status::Error, "cursor is not supported on the primary connection");
+            return;
+        }
+        if (!request.GetContinuationToken().empty()) {
+            auto cursor = adaptorCache.TryGetCursor(request.GetContinuationToken(), sql);
+            if (cursor == nullptr) {
+                setError(QueryResponse::Status::Error, SqlPrintfString("cursor '%s' does not exist, has expired or does not match the query", request.GetContinuationToken().c_str()).GetUtf8CP());
+                return;
+            }
+            if (!request.GetArgs().IsEmpty() && QueryHelper::SerializeArgs(request.GetArgs()) != cursor->GetCursorArgs()) {
+                adaptorCache.ReleaseCursor(*cursor);
+                setError(QueryResponse::Status::Error_ECSql_BindingFailed, SqlPrintfString("cursor '%s' cannot be resumed with different args", request.GetContinuationToken().c_str()).GetUtf8CP());
+                return;
+            }
+            QueryHelper::Execute(*cursor, runnableRequest, request.GetResultFormat());
+            adaptorCache.ReleaseCursor(*cursor);
+            return;
+        }
         ECSqlStatus status;
         std::string err;
-        auto adaptor = adaptorCache.TryGet(sql.c_str(), request.UsePrimaryConnection(), request.GetSuppressLogErrors(), status, err);
+        std::shared_ptr<CachedQueryAdaptor> adaptor;
+        int cursorKeyColumn = -1;
+        if (request.GetUseCursor()) {
+            // a cursor that can be paged by key is prepared without the wrapping query, it is ordered by ECInstanceId instead.
+            std::string keysetSql;
+            if (QueryHelper::TryFormatKeysetQuery(adaptorCache.GetConnection().GetPrimaryDb(), request.GetQuery().c_str(), keysetSql, cursorKeyColumn))
+                adaptor = adaptorCache.TryGet(keysetSql.c_str(), false, true, status, err);
+
+            if (adaptor == nullptr)
+                cursorKeyColumn = -1;
+        }
+        if (adaptor == nullptr)
+            adaptor = adaptorCache.TryGet(sql.c_str(), request.UsePrimaryConnection(), request.GetSuppressLogErrors(), status, err);
+
         if (adaptor == nullptr) {
             if (status.IsSQLiteError()) {
                 if (status.GetSQLiteError() == BE_SQLITE_INTERRUPT) {
@@ -1191,8 +2366,26 @@ void QueryHelper::Execute(QueryAdaptorCache& adaptorCache, RunnableRequestBase&
             setError(QueryResponse::Status::Error_ECSql_BindingFailed, err);
             return;
         }
+        if (request.GetUseCursor()) {
+            // limit count is the page size, the statement itself is only bounded by the offset.
+            BindLimits(adaptor->GetStatement(), QueryLimit(-1, request.GetLimit().GetOffset()));
+            adaptorCache.OpenCursor(adaptor, sql, ConcurrentQueryMgr::GetConfig(adaptorCache.GetConnection().GetPrimaryDb()).GetCursorIdleTimeout());
+            adaptor->SetCursorArgs(QueryHelper::SerializeArgs(request.GetArgs()));
+            if (cursorKeyColumn >= 0) {
+                BindCursorKey(adaptor->GetStatement(), 0);
+                adaptor->SetCursorKeyColumn(cursorKeyColumn);
+            }
+            QueryHelper::Execute(*adaptor, runnableRequest, request.GetResultFormat());
+            adaptorCache.ReleaseCursor(*adaptor);
+            return;
+        }
         BindLimits(adaptor->GetStatement(), request.GetLimit());
-        QueryHelper::Execute(*adaptor, runnableRequest);
+        if (request.GetUsePartitions() && !request.UsePrimaryConnection() && request.GetResultFormat() == ECSqlRequest::ResultFormat::Json) {
+            auto partitioned = PartitionedQuery::TryCreate(adaptorCache.GetConnection().GetPrimaryDb(), request.GetQuery().c_str());
+            if (partitioned != nullptr && partitioned->Execute(adaptorCache, *adaptor, runnableRequest))
+                return;
+        }
+        QueryHelper::Execute(*adaptor, runnableRequest, request.GetResultFormat());
     } else {
         setError(QueryResponse::Status::Error, "unsupported kind of request");
     }
@@ -1211,21 +2404,16 @@ QueryExecutor::QueryExecutor(RunnableRequestQueue& queue, ECDbCR primaryDb, uint
     if (pool_size < 1) {
         pool_size = ConcurrentQueryMgr::GetConfig(primaryDb).GetWorkerThreadCount();
     }
+    m_queue.SetLaneCount(pool_size);
     for (uint32_t i = 0; i < pool_size; ++i) {
         m_threads.emplace_back(std::thread([&](){
             thread_local const auto execId = m_threadCount.fetch_add(1);
             log_trace("%s executor started [id=%" PRIu32 "]",GetTimestamp().c_str(), execId);
             do {
-                auto runnableQuery = m_queue.WaitForDequeue();
+                auto runnableQuery = m_queue.WaitForDequeue(execId);
                 if (runnableQuery != nullptr) {
                     log_trace("%s executor [id=%" PRIu32 "] dequeued request [id=%" PRIu32 "]", GetTimestamp().c_str(), execId, runnableQuery->GetId());
-                    std::shared_ptr<CachedConnection> conn;
-                    conn = m_connCache.GetConnection();
-                    while (conn == nullptr) {
-                        std::this_thread::yield();
-                        std::this_thread::sleep_for(1s);
-                        conn = m_connCache.GetConnection();
-                    }
+                    auto conn = m_connCache.WaitForConnection(*runnableQuery);
                     runnableQuery->SetExecutorContext(execId, conn->Id());
                     log_trace("%s executor [id=%" PRIu32 "] with request [id=%" PRIu32 "] is assigned connection [id=%" PRIu32 "]",
                         GetTimestamp().c_str(),
@@ -1253,6 +2441,7 @@ QueryExecutor::QueryExecutor(RunnableRequestQueue& queue, ECDbCR primaryDb, uint
                             runnableQuery.GetId());
 
                     },std::move(runnableQuery));
+                    m_connCache.ReleaseConnection(conn);
                 }
             } while(m_queue.GetState() != RunnableRequestQueue::State::Stop);
             m_threadCount.fetch_sub(1);
@@ -1302,7 +2491,8 @@ QueryMonitor::QueryMonitor(RunnableRequestQueue& queue, QueryExecutor& executor,
                 }
                 return false;
             }, false);
-
+            m_executor.GetConnectionCache().EvictIdleCursors();
+            SampleQueueStats();
             std::this_thread::sleep_for(m_pollInterval);
             std::this_thread::yield();
         } while (m_stop.load() == false);
@@ -1312,6 +2502,34 @@ QueryMonitor::QueryMonitor(RunnableRequestQueue& queue, QueryExecutor& executor,
     notifyThreadHasStarted = nullptr;
 }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryMonitor::SampleQueueStats() {
+    auto stats = m_queue.GetStats();
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    auto const& lastStats = m_stats.m_queue;
+    const auto dequeued = stats.GetDequeued() - lastStats.GetDequeued();
+    const auto waitTime = stats.GetTotalWaitTime() - lastStats.GetTotalWaitTime();
+    const auto avgWaitTime = dequeued == 0 ? std::chrono::microseconds(0) : std::chrono::microseconds(waitTime.count() / (int64_t)dequeued);
+    if (stats.GetDepth() > 0 || dequeued > 0) {
+        log_trace("%s monitor queue [depth=%" PRIu32 ", high=%" PRIu32 ", normal=%" PRIu32 ", low=%" PRIu32 ", dequeued=%" PRIu64 ", stolen=%" PRIu64 ", avg_wait=%" PRId64 "us, max_wait=%" PRId64 "us]",
+            GetTimestamp().c_str(),
+            stats.GetDepth(),
+            stats.GetDepth(RunnableRequestQueue::PriorityClass::High),
+            stats.GetDepth(RunnableRequestQueue::PriorityClass::Normal),
+            stats.GetDepth(RunnableRequestQueue::PriorityClass::Low),
+            dequeued,
+            stats.GetStolen() - lastStats.GetStolen(),
+            (int64_t)avgWaitTime.count(),
+            (int64_t)stats.GetMaxWaitTime().count());
+    }
+    m_stats.m_intervalDequeued = dequeued;
+    m_stats.m_intervalAvgWaitTime = avgWaitTime;
+    m_stats.m_queue = std::move(stats);
+    ++m_stats.m_sampleCount;
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -1329,6 +2547,8 @@ void ConcurrentQueryMgr::Enqueue(QueryRequest::Ptr request, OnCompletion onCompl
 bool ConcurrentQueryMgr::Suspend(ClearCacheOption clearCache, DetachAttachDbs detachDbs) { return m_impl->Suspend(clearCache,detachDbs); }
 bool ConcurrentQueryMgr::Resume() { return m_impl->Resume(); }
 bool ConcurrentQueryMgr::IsSuspended() const { return m_impl->IsSuspended(); }
+ConcurrentQueryMgr::QueueStats ConcurrentQueryMgr::GetQueueStats() const { return m_impl->GetQueueStats(); }
+ConcurrentQueryMgr::MonitorStats ConcurrentQueryMgr::GetMonitorStats() const { return m_impl->GetMonitorStats(); }
 void ConcurrentQueryMgr::SetWorkerPoolSize(uint32_t newSize) {m_impl->SetWorkerPoolSize(newSize);}
 void ConcurrentQueryMgr::SetRequestQueueMaxSize(uint32_t newSize) {m_impl->SetRequestQueueMaxSize(newSize);}
 void ConcurrentQueryMgr::SetCacheStatementsPerWork(uint32_t newSize) {m_impl->SetCacheStatementsPerWork(newSize);}
@@ -1623,6 +2843,18 @@ void ECSqlRequest::FromJs(BeJsConst const& val) {
     if (val.isNumericMember(JValueFormat)) {
         m_valueFmt = (ECSqlValueFormat)val[JValueFormat].asInt();
     }
+    if (val.isNumericMember(JResultFormat)) {
+        m_resultFmt = (ResultFormat)val[JResultFormat].asInt();
+    }
+    if (val.isBoolMember(JUseCursor)) {
+        m_useCursor = val[JUseCursor].asBool();
+    }
+    if (val.isStringMember(JContinuationToken)) {
+        m_continuationToken = val[JContinuationToken].asCString();
+    }
+    if (val.isBoolMember(JUsePartitions)) {
+        m_usePartitions = val[JUsePartitions].asBool();
+    }
 }
 
 //---------------------------------------------------------------------------------------
@@ -1665,11 +2897,17 @@ void QueryResponse::ToJs(BeJsValue& v, bool includeData) const {
 void ECSqlResponse::ToJs(BeJsValue& v, bool includeData) const {
     QueryResponse::ToJs(v, includeData);
     v[JRowCount] = m_rowCount;
-    if (includeData) {
+    if (m_isColumnar) {
+        // column layout is always reported, buffers only when data is requested.
+        auto data = v[JData];
+        m_columnar.ToJs(data, includeData);
+    } else if (includeData) {
         v[JData] = m_dataJson;
     }
     auto meta = v[JMeta];
     m_properties.ToJs(meta);
+    if (!m_continuationToken.empty())
+        v[JContinuationToken] = m_continuationToken;
 }
 
 //---------------------------------------------------------------------------------------
@@ -1956,7 +3194,8 @@ ConcurrentQueryMgr::Config::Config():
     m_workerThreadCount(DEFAULT_WORKER_THREAD_COUNT),
     m_requestQueueSize(DEFAULT_REQUEST_QUERY_SIZE),
     m_ignorePriority(DEFAULT_IGNORE_PRIORITY),
-    m_ignoreDelay(DEFAULT_IGNORE_DELAY) {
+    m_ignoreDelay(DEFAULT_IGNORE_DELAY),
+    m_cursorIdleTimeout(DEFAULT_CURSOR_IDLE_TIMEOUT) {
 }
 
 //---------------------------------------------------------------------------------------
@@ -1975,6 +3214,8 @@ bool ConcurrentQueryMgr::Config::Equals(Config const& rhs) const {
         return false;
     if (m_ignoreDelay != rhs.GetIgnoreDelay())
         return false;
+    if (m_cursorIdleTimeout != rhs.GetCursorIdleTimeout())
+        return false;
     return true;
 }
 
@@ -2013,6 +3254,7 @@ void ConcurrentQueryMgr::Config::To(BeJsValue val) const {
     val[Config::JQueueSize] = GetRequestQueueSize();
     val[Config::JIgnorePriority] = GetIgnorePriority();
     val[Config::JIgnoreDelay] = GetIgnoreDelay();
+    val[Config::JCursorIdleTimeout] = (uint32_t)GetCursorIdleTimeout().count();
     auto quota = val[Config::JQuota];
     m_quota.ToJs(quota);
 }
@@ -2048,6 +3290,10 @@ ConcurrentQueryMgr::Config ConcurrentQueryMgr::Config::From(BeJsValue val) {
         const auto ignoreDelay = val[Config::JIgnoreDelay].asBool(defaultConfig.GetIgnoreDelay());
         config.SetIgnoreDelay(ignoreDelay);
     }
+    if (val.isNumericMember(Config::JCursorIdleTimeout)) {
+        const auto idleTimeout = val[Config::JCursorIdleTimeout].asUInt((uint32_t)defaultConfig.GetCursorIdleTimeout().count());
+        config.SetCursorIdleTimeout(std::chrono::seconds(idleTimeout));
+    }
     if (val.isObjectMember(Config::JQuota)) {
         auto quota = defaultConfig.GetQuota();
         quota = QueryQuota::FromJs(val[Config::JQuota]);
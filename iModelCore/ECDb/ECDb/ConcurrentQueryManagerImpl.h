@@ -5,7 +5,9 @@
 #pragma once
 #include <ECDb/ConcurrentQueryManager.h>
 #include "QueryJsonAdaptor.h"
+#include "QueryColumnarAdaptor.h"
 #include <queue>
+#include <deque>
 #include <map>
 #include <thread>
 #include <future>
@@ -18,6 +20,7 @@
 #define DEFAULT_REQUEST_QUERY_SIZE      2000
 #define DEFAULT_IGNORE_PRIORITY         false
 #define DEFAULT_IGNORE_DELAY            true
+#define DEFAULT_CURSOR_IDLE_TIMEOUT     std::chrono::seconds(5)
 #define DEFAULT_WORKER_THREAD_COUNT     std::min(4u, std::thread::hardware_concurrency())
 #define MAX_REQUEST_QUERY_SIZE          4000
 #define MIN_WORKER_THREAD_COUNT         2
@@ -56,22 +59,64 @@ struct CachedQueryAdaptor final: std::enable_shared_from_this<CachedQueryAdaptor
     private:
         ECSqlStatement m_stmt;
         std::unique_ptr<QueryJsonAdaptor> m_adaptor;
+        std::unique_ptr<QueryColumnarAdaptor> m_columnarAdaptor;
         std::string m_cachedString;
         rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> m_allocator;
         rapidjson::CrtAllocator m_stackAllocator;
         rapidjson::Document m_cachedXmlDoc;
         Db const* m_conn;
         bool m_usePrimaryConn;
+        std::string m_cursorToken;
+        std::string m_cursorQuery;
+        std::string m_cursorArgs;
+        std::chrono::steady_clock::time_point m_cursorLastUsed;
+        std::chrono::seconds m_cursorIdleTimeout;
+        uint64_t m_cursorRowCount;
+        int m_cursorKeyColumn;
+        uint64_t m_cursorKey;
+        bool m_cursorHasMore;
+        bool m_cursorNeedsRestart;
     public:
-        CachedQueryAdaptor() :m_cachedXmlDoc(&m_allocator, 1024, &m_stackAllocator), m_usePrimaryConn(false) { m_cachedXmlDoc.SetArray(); }
+        CachedQueryAdaptor() :m_cachedXmlDoc(&m_allocator, 1024, &m_stackAllocator), m_usePrimaryConn(false), m_cursorIdleTimeout(DEFAULT_CURSOR_IDLE_TIMEOUT), m_cursorRowCount(0), m_cursorKeyColumn(-1), m_cursorKey(0), m_cursorHasMore(false), m_cursorNeedsRestart(false) { m_cachedXmlDoc.SetArray(); }
         ECSqlStatement& GetStatement() { return m_stmt; }
         QueryJsonAdaptor& GetJsonAdaptor();
+        QueryColumnarAdaptor& GetColumnarAdaptor();
         rapidjson::Document& ClearAndGetCachedXmlDocument() { m_cachedXmlDoc.Clear();  return m_cachedXmlDoc; }
         std::string& ClearAndGetCachedString() { m_cachedString.clear(); return m_cachedString; }
         bool GetUsePrimaryConn() const { return m_usePrimaryConn; }
         void SetUsePrimaryConn(bool val) { m_usePrimaryConn = val; }
         Db const* GetWorkerConn() const { return m_conn; }
         void SetWorkerConn(Db const& conn) { m_conn = &conn; }
+        bool IsCursor() const { return !m_cursorToken.empty(); }
+        std::string const& GetCursorToken() const { return m_cursorToken; }
+        void SetCursorToken(std::string const& token) { m_cursorToken = token; }
+        //! formatted query of the request that opened the cursor, a continuation must send the same query.
+        std::string const& GetCursorQuery() const { return m_cursorQuery; }
+        void SetCursorQuery(std::string const& query) { m_cursorQuery = query; }
+        //! set by the executor when the last page was partial and the statement can be stepped further.
+        bool GetCursorHasMore() const { return m_cursorHasMore; }
+        void SetCursorHasMore(bool hasMore) { m_cursorHasMore = hasMore; }
+        //! args bound by the request that opened the cursor, serialized to json.
+        std::string const& GetCursorArgs() const { return m_cursorArgs; }
+        void SetCursorArgs(std::string const& args) { m_cursorArgs = args; }
+        //! number of rows returned by the cursor so far.
+        uint64_t GetCursorRowCount() const { return m_cursorRowCount; }
+        void AddCursorRows(uint64_t rowCount) { m_cursorRowCount += rowCount; }
+        void ClearCursorRowCount() { m_cursorRowCount = 0; }
+        //! set when a page was interrupted. The statement is then re-executed and skips the rows already returned.
+        bool GetCursorNeedsRestart() const { return m_cursorNeedsRestart; }
+        void SetCursorNeedsRestart(bool needsRestart) { m_cursorNeedsRestart = needsRestart; }
+        //! index of the ECInstanceId column of a keyset cursor, -1 if the cursor keeps its statement open between pages.
+        bool HasCursorKey() const { return m_cursorKeyColumn >= 0; }
+        void SetCursorKeyColumn(int columnIndex) { m_cursorKeyColumn = columnIndex; }
+        //! ECInstanceId of the last row returned by a keyset cursor, the next page starts after it.
+        uint64_t GetCursorKey() const { return m_cursorKey; }
+        void UpdateCursorKey() { if (m_cursorKeyColumn >= 0) m_cursorKey = m_stmt.GetValueUInt64(m_cursorKeyColumn); }
+        void ClearCursorKey() { m_cursorKeyColumn = -1; m_cursorKey = 0; }
+        std::chrono::seconds GetCursorIdleTimeout() const { return m_cursorIdleTimeout; }
+        void SetCursorIdleTimeout(std::chrono::seconds idleTimeout) { m_cursorIdleTimeout = idleTimeout; }
+        std::chrono::steady_clock::time_point GetCursorLastUsed() const { return m_cursorLastUsed; }
+        void TouchCursor() { m_cursorLastUsed = std::chrono::steady_clock::now(); }
         std::shared_ptr<CachedQueryAdaptor> Shared() { return shared_from_this(); }
         static std::shared_ptr<CachedQueryAdaptor> Make() {
             return std::make_shared<CachedQueryAdaptor>();
@@ -84,9 +129,12 @@ struct CachedQueryAdaptor final: std::enable_shared_from_this<CachedQueryAdaptor
 struct ECSqlStatementRow : public IECSqlRow {
     private:
     ECSqlStatementCR m_stmt;
+    int m_columnCount;
     public:
-        ECSqlStatementRow(ECSqlStatement const& stmt):m_stmt(stmt){}
-        virtual int GetColumnCount() const override { return m_stmt.GetColumnCount(); }
+        ECSqlStatementRow(ECSqlStatement const& stmt):m_stmt(stmt), m_columnCount(stmt.GetColumnCount()){}
+        //! expose only the leading columns, trailing columns are used internally (e.g. sort keys of a partitioned query).
+        ECSqlStatementRow(ECSqlStatement const& stmt, int columnCount):m_stmt(stmt), m_columnCount(columnCount){}
+        virtual int GetColumnCount() const override { return m_columnCount; }
         virtual IECSqlValue const& GetValue(int columnIndex) const override { return m_stmt.GetValue(columnIndex);}
 };
 //=======================================================================================
@@ -94,16 +142,27 @@ struct ECSqlStatementRow : public IECSqlRow {
 //=======================================================================================
 struct QueryAdaptorCache final {
     const static uint32_t kDefaultCacheSize =40;
+    const static uint32_t kMaxCursors = 8;
     private:
             std::vector<std::shared_ptr<CachedQueryAdaptor>> m_cache;
+            std::vector<std::shared_ptr<CachedQueryAdaptor>> m_cursors;
             recursive_mutex_t m_mutex;
             CachedConnection& m_conn;
             uint32_t m_maxEntries;
+            uint64_t m_nextCursorId;
     public:
-        QueryAdaptorCache(CachedConnection& conn, uint32_t maxCacheEntries = kDefaultCacheSize):m_conn(conn), m_maxEntries(maxCacheEntries){}
+        QueryAdaptorCache(CachedConnection& conn, uint32_t maxCacheEntries = kDefaultCacheSize):m_conn(conn), m_maxEntries(maxCacheEntries), m_nextCursorId(0){}
         ~QueryAdaptorCache(){}
         std::shared_ptr<CachedQueryAdaptor> TryGet(Utf8CP ecsql, bool usePrimaryConn, bool suppressLogError, ECSqlStatus& status, std::string& ecsql_error);
-        void Reset() { m_cache.clear(); }
+        //! Detach a prepared and bound adaptor from the statement cache so it can be stepped across requests.
+        //! The cursor is closed once it was not used for idleTimeout.
+        void OpenCursor(std::shared_ptr<CachedQueryAdaptor> adaptor, std::string const& query, std::chrono::seconds idleTimeout);
+        std::shared_ptr<CachedQueryAdaptor> TryGetCursor(std::string const& token, std::string const& query);
+        //! Close the cursor unless the last page left rows to read.
+        void ReleaseCursor(CachedQueryAdaptor& adaptor);
+        void EvictIdleCursors();
+        static bool TryParseCursorToken(std::string const& token, uint16_t& connId, uint64_t& cursorId);
+        void Reset() { recursive_guard_t lock(m_mutex); m_cache.clear(); m_cursors.clear(); }
         void SetMaxCacheSize(uint32_t n) { if (n < QueryAdaptorCache::kDefaultCacheSize) return; m_maxEntries = n; }
         CachedConnection& GetConnection() {return m_conn;}
 };
@@ -162,6 +221,7 @@ struct CachedConnection final : std::enable_shared_from_this<CachedConnection> {
         CachedConnection& operator = (const CachedConnection&)=delete;
         CachedConnection& operator = (CachedConnection&&)=delete;
         std::vector<FunctionInfo> GetPrimaryDbSqlFunctions() const;
+        void AttachChangeSummaryCache();
         void SetRequest(std::unique_ptr<RunnableRequestBase> request);
         void ClearRequest();
     public:
@@ -169,6 +229,8 @@ struct CachedConnection final : std::enable_shared_from_this<CachedConnection> {
         ~CachedConnection();
         void Interrupt() const { m_db.Interrupt();}
         void Execute(std::function<void(QueryAdaptorCache&,RunnableRequestBase&)>, std::unique_ptr<RunnableRequestBase>);
+        //! Run part of a request that is owned by another connection, e.g. one partition of a partitioned query.
+        void Execute(std::function<void(QueryAdaptorCache&)>);
         void Reset(bool detachDbs);
         void InterruptIf(std::function<bool(RunnableRequestBase const&)>,bool cancel);
         bool IsSync() const { return m_id == 0; }
@@ -176,9 +238,11 @@ struct CachedConnection final : std::enable_shared_from_this<CachedConnection> {
         ECDb const& GetDb() const {return m_db; }
         ECDb& GetDbR() {return m_db; }
         uint16_t Id() const { return m_id; }
+        ConnectionCache& GetConnectionCache() { return m_cache; }
         std::shared_ptr<CachedConnection> Shared() { return  shared_from_this(); }
         static std::shared_ptr<CachedConnection> Make(ConnectionCache&,uint16_t);
         void SetAdaptorCacheSize(uint32_t newSize);
+        void EvictIdleCursors();
 };
 
 //=======================================================================================
@@ -191,16 +255,28 @@ struct ConnectionCache final {
         ECDb const& m_primaryDb;
         recursive_mutex_t m_mutex;
         uint32_t m_poolSize;
+        std::mutex m_releasedMutex;
+        std::condition_variable m_released;
 
     public:
         ConnectionCache(ECDb const& primaryDb, uint32_t pool_size);
         ECDb const& GetPrimaryDb() const { return m_primaryDb; }
         std::shared_ptr<CachedConnection> GetConnection();
+        //! Same as GetConnection() but gives up instead of waiting for the cache lock, for callers that already hold a connection.
+        std::shared_ptr<CachedConnection> TryGetConnection();
+        //! Connection to run the request on, or nullptr if it is busy. A cursor continuation gets the connection that owns the cursor.
+        std::shared_ptr<CachedConnection> GetConnection(RunnableRequestBase const& request);
+        //! Blocks until a connection for the request is released.
+        std::shared_ptr<CachedConnection> WaitForConnection(RunnableRequestBase const& request);
+        //! Hands a connection back and wakes the executors waiting for one.
+        void ReleaseConnection(std::shared_ptr<CachedConnection>& conn);
         CachedConnection& GetSyncConnection();
         void Interrupt(bool reset_conn, bool detachDbs);
         void InterruptIf(std::function<bool(RunnableRequestBase const&)> predicate, bool cancel);
         void SetCacheStatementsPerWork(uint32_t);
-        void SetMaxPoolSize(uint32_t newSize)  {m_poolSize = newSize; }
+        void SetMaxPoolSize(uint32_t newSize);
+        uint32_t GetMaxPoolSize() const { return m_poolSize; }
+        void EvictIdleCursors();
 };
 
 struct RunnableRequestQueue;
@@ -235,9 +311,12 @@ struct RunnableRequestBase {
         bool IsReady() const { return GetTotalTime() > m_request->GetDelay(); }
         bool IsCancelled () const {return m_cancelled.load(); }
         bool IsTimeExceeded() const { return m_quota.MaxTimeAllowed() == 0s ? false : std::chrono::duration_cast<std::chrono::seconds>(GetTotalTime()) >  m_quota.MaxTimeAllowed();}
-        bool IsMemoryExceeded(std::string const& result) const { return m_quota.MaxMemoryAllowed() == 0 ? false : result.size() > m_quota.MaxMemoryAllowed(); }
-        bool IsTimeOrMemoryExceeded(std::string const& result) const { return IsTimeExceeded() || IsMemoryExceeded(result);}
+        bool IsMemoryExceeded(size_t bytes) const { return m_quota.MaxMemoryAllowed() == 0 ? false : bytes > m_quota.MaxMemoryAllowed(); }
+        bool IsMemoryExceeded(std::string const& result) const { return IsMemoryExceeded(result.size()); }
+        bool IsTimeOrMemoryExceeded(size_t bytes) const { return IsTimeExceeded() || IsMemoryExceeded(bytes);}
+        bool IsTimeOrMemoryExceeded(std::string const& result) const { return IsTimeOrMemoryExceeded(result.size());}
         void OnDequeued()  { m_dequeuedOn = std::chrono::steady_clock::now(); }
+        std::chrono::microseconds GetWaitTime() const { return std::chrono::duration_cast<std::chrono::microseconds>(m_dequeuedOn - m_submittedOn);}
         uint32_t GetExecutorId() const {return m_executorId; }
         uint32_t GetConnectionId() const {return m_connId; }
         void SetExecutorContext(uint32_t executorId, uint32_t connId) { m_executorId = executorId;  m_connId= connId;}
@@ -247,7 +326,8 @@ struct RunnableRequestBase {
         QueryResponse::Ptr CreateTimeoutResponse() const;
         QueryResponse::Ptr CreateCancelResponse() const;
         QueryResponse::Ptr CreateBlobIOResponse(std::vector<uint8_t>& meta, bool done, uint32_t rawBlobSize) const;
-        QueryResponse::Ptr CreateECSqlResponse(std::string& result, QueryProperty::List& meta, uint32_t rowcount, bool done) const;
+        QueryResponse::Ptr CreateECSqlResponse(std::string& result, QueryProperty::List& meta, uint32_t rowcount, bool done, std::string const& continuationToken = "") const;
+        QueryResponse::Ptr CreateECSqlResponse(QueryColumnarResult& result, QueryProperty::List& meta, bool done, std::string const& continuationToken = "") const;
         static QueryResponse::Ptr CreateQueueFullResponse() ;
 
 };
@@ -290,23 +370,51 @@ struct RunnableRequestQueue final {
         Stop,
         Running
     };
+    //! Executors always look for work in a higher class (in any lane) before falling back to a lower one.
+    using PriorityClass = ConcurrentQueryMgr::QueueStats::PriorityClass;
+    using Stats = ConcurrentQueryMgr::QueueStats;
+    static constexpr uint32_t kPriorityClassCount = Stats::kPriorityClassCount;
 
     private:
+        //=======================================================================================
+        //! Requests queued for a single executor. Both the owner and idle executors stealing
+        //! from the lane take the highest priority ready request of a class. Among requests of
+        //! equal priority the owner takes the most recent one while a thief takes the oldest.
+        //! @bsiclass
+        //=======================================================================================
+        struct Lane final {
+            mutex_t m_mutex;
+            std::deque<std::unique_ptr<RunnableRequestBase>> m_requests[kPriorityClassCount];
+        };
+
         mutex_t m_mutex;
         std::condition_variable m_cond;
         std::atomic<State> m_state;
+        std::atomic<uint32_t> m_pending;
+        std::atomic<uint32_t> m_nextLane;
         uint32_t m_maxQueueSize;
         uint32_t m_nextId;
-        uint32_t m_lastDelayedQueryId;
+        bool m_ignorePriority;
         QueryQuota m_quota;
-        std::vector<std::unique_ptr<RunnableRequestBase>> m_requests;
+        std::vector<std::unique_ptr<Lane>> m_lanes;
+        std::atomic<uint64_t> m_dequeued;
+        std::atomic<uint64_t> m_stolen;
+        std::atomic<uint64_t> m_partitioned;
+        std::atomic<int64_t> m_totalWaitTime;
+        std::atomic<int64_t> m_maxWaitTime;
         ECDbCR m_ecdb;
 
     private:
+        void SetLaneCount(uint32_t count);
+        PriorityClass GetPriorityClass(RunnableRequestBase const&) const;
+        void CancelRestartToken(ConnectionCache&, RunnableRequestBase const& request);
         void InsertSorted(ConnectionCache&,std::unique_ptr<RunnableRequestBase>&& request);
         uint32_t GetNextId ();
-        std::unique_ptr<RunnableRequestBase> Dequeue();
-        std::unique_ptr<RunnableRequestBase> WaitForDequeue();
+        std::unique_ptr<RunnableRequestBase> TryPop(Lane& lane, PriorityClass priorityClass, bool steal);
+        std::unique_ptr<RunnableRequestBase> Dequeue(uint32_t executorId);
+        std::unique_ptr<RunnableRequestBase> WaitForDequeue(uint32_t executorId);
+        void OnDequeued(RunnableRequestBase& request, bool stolen);
+        void ForEachLane(std::function<void(std::deque<std::unique_ptr<RunnableRequestBase>>&)> callback);
         QueryQuota AdjustQuota(QueryQuota const& quota) const;
         void ExecuteSynchronously(ConnectionCache&, std::unique_ptr<RunnableRequestBase>);
     public:
@@ -322,7 +430,9 @@ struct RunnableRequestQueue final {
         State GetState() const { return m_state.load(); }
         QueryResponse::Future Enqueue(ConnectionCache&,QueryRequest::Ptr);
         void Enqueue(ConnectionCache&,QueryRequest::Ptr, ConcurrentQueryMgr::OnCompletion onComplete);
-        uint32_t Count();
+        uint32_t Count() const { return m_pending.load(); }
+        void OnPartitioned() { m_partitioned.fetch_add(1); }
+        Stats GetStats() const;
         bool Stop();
 };
 
@@ -343,6 +453,83 @@ struct QueryExecutor final {
         ConnectionCache& GetConnectionCache() {return m_connCache; }
 };
 
+//=======================================================================================
+//! Splits a polymorphic select over a class stored in several tables (horizontal partitions)
+//! into one query per table. The partitions are stepped concurrently on the request's
+//! connection and on idle pool connections. With ORDER BY the sort expressions are
+//! appended to each partition as trailing columns and the rows are merged on them,
+//! otherwise the partitions are returned one after the other in partition order so that
+//! limit/offset paging sees the same order on every execution.
+//! All partitions read the same snapshot: in rollback journal mode the request's connection
+//! holds its read lock while the other connections start reading, so no write can commit in
+//! between. In WAL mode each connection could see a different commit, so all partitions are
+//! stepped on the request's connection.
+//! @bsiclass
+//=======================================================================================
+struct PartitionedQuery final {
+    //! Value of one ORDER BY term, ordered the way sqlite orders storage classes: null, numbers, text, blob.
+    struct SortKey final {
+        enum class Kind { Null = 0, Number = 1, Text = 2, Blob = 3 };
+        private:
+            Kind m_kind;
+            bool m_isReal;
+            int64_t m_int;
+            double m_real;
+            std::string m_bytes;
+            //! compares an integer with a real exactly, the way sqlite does, instead of rounding the integer to a double.
+            static int CompareIntReal(int64_t lhs, double rhs);
+        public:
+            SortKey() : m_kind(Kind::Null), m_isReal(false), m_int(0), m_real(0.0) {}
+            int Compare(SortKey const& rhs) const;
+            static SortKey From(IECSqlValue const& value);
+    };
+
+    struct Row final {
+        std::string m_json;
+        std::vector<SortKey> m_keys;
+    };
+
+    private:
+        //! rows read ahead for one partition before its producer waits for the merge to catch up.
+        static constexpr size_t kMaxBufferedRows = 256;
+        //! pool connections one request may borrow, at most half of the pool is taken so that other requests still find idle ones.
+        static constexpr size_t kMaxBorrowedConnections = 4;
+        static constexpr auto kSortKeyAlias = "sys_ecdb_sort_key_";
+        struct Stream final {
+            std::deque<Row> m_rows;
+            bool m_done = false;
+            QueryResponse::Status m_errorStatus = QueryResponse::Status::Done;
+            std::string m_error;
+            bool HasError() const { return m_errorStatus != QueryResponse::Status::Done; }
+        };
+        enum class NextResult { Row, Done, Interrupted, Error };
+
+        std::vector<std::string> m_ecsql;
+        std::vector<bool> m_descending;
+        mutex_t m_mutex;
+        std::condition_variable m_produced;
+        std::condition_variable m_consumed;
+        std::vector<Stream> m_streams;
+        size_t m_current;
+        std::atomic_bool m_stop;
+
+        PartitionedQuery() : m_current(0), m_stop(false) {}
+        int CompareRows(Row const& lhs, Row const& rhs) const;
+        void Produce(QueryAdaptorCache& adaptorCache, std::vector<size_t> const& partitions, RunnableRequestBase const& runnableRequest);
+        void Fail(size_t partition, QueryResponse::Status status, std::string const& error);
+        NextResult Next(Row& row, QueryResponse::Status& errorStatus, std::string& error, RunnableRequestBase const& runnableRequest);
+    public:
+        //! returns nullptr when the query cannot be split, the request is then executed as a single statement.
+        //! The partitions are built from the ecsql of the request, before it is wrapped to apply limit and offset.
+        static std::unique_ptr<PartitionedQuery> TryCreate(ECDbCR primaryDb, Utf8CP ecsql);
+        size_t GetPartitionCount() const { return m_ecsql.size(); }
+        std::string const& GetECSql(size_t partition) const { return m_ecsql[partition]; }
+        bool IsOrdered() const { return !m_descending.empty(); }
+        //! step all partitions and serialize the merged rows into the response of the request.
+        //! Returns false without setting a response when a partition fails to prepare, the request is then executed as a single statement.
+        bool Execute(QueryAdaptorCache& adaptorCache, CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& runnableRequest);
+};
+
 //=======================================================================================
 //! @bsiclass
 //=======================================================================================
@@ -350,8 +537,14 @@ struct QueryHelper final {
     private:
         static std::string FormatQuery(const char* query);
         static void BindLimits(ECSqlStatement& stmt, QueryLimit const& limit);
+        static bool TryFormatKeysetQuery(ECDbCR primaryDb, const char* query, std::string& keysetQuery, int& keyColumn);
+        static void BindCursorKey(ECSqlStatement& stmt, uint64_t key);
+        static DbResult StepPageStart(CachedQueryAdaptor& cachedAdaptor);
+        static std::string SerializeArgs(ECSqlParams const& args);
         static QueryProperty::List GetMetaInfo(CachedQueryAdaptor&,bool);
         static void Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& request);
+        static void ExecuteColumnar(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& request);
+        static void Execute(CachedQueryAdaptor& cachedAdaptor, RunnableRequestBase& request, ECSqlRequest::ResultFormat format);
         static void ReadBlob(ECDbCR conn, RunnableRequestBase& request);
         static void ExecutePing(Json::Value const& pingJson, RunnableRequestBase& runnableRequest);
     public:
@@ -382,9 +575,13 @@ struct QueryMonitor {
         QueryExecutor& m_executor;
         std::chrono::milliseconds m_pollInterval;
         cancel_callback_type m_cancelBeforeSchemaChanges;
+        mutable std::mutex m_statsMutex;
+        ConcurrentQueryMgr::MonitorStats m_stats;
+        void SampleQueueStats();
     public:
         QueryMonitor(RunnableRequestQueue& queue, QueryExecutor& executor, std::chrono::milliseconds pollInterval = 1000ms);
         ~QueryMonitor() { m_stop.store(true); if (m_thread.joinable()) m_thread.join(); }
+        ConcurrentQueryMgr::MonitorStats GetStats() const { std::lock_guard<std::mutex> lock(m_statsMutex); return m_stats; }
 };
 
 //=======================================================================================
@@ -406,6 +603,8 @@ struct ConcurrentQueryMgr::Impl : ECDb::IECDbCacheClearListener {
         bool Suspend(ClearCacheOption clearCache, DetachAttachDbs detachDbs);
         bool Resume() {return m_queue.Resume();}
         bool IsSuspended() const { return m_queue.GetState() == RunnableRequestQueue::State::Paused;}
+        QueueStats GetQueueStats() const { return m_queue.GetStats(); }
+        MonitorStats GetMonitorStats() const { return m_monitor.GetStats(); }
         // change config
         void SetWorkerPoolSize(uint32_t newSize) { m_executor.SetWorkerPoolSize(newSize); }
         void SetRequestQueueMaxSize(uint32_t newSize) { m_queue.SetRequestQueueMaxSize(newSize); }
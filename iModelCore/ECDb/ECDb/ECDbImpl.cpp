@@ -17,6 +17,34 @@ PragmaManager& ECDb::Impl::GetPragmaManager() const
     return *m_pragmaProcessor;
     }
 
+//--------------------------------------------------------------------------------------
+// @bsimethod
+//---------------+---------------+---------------+---------------+---------------+------
+ECSqlParseTreeCache& ECDb::Impl::GetECSqlParseTreeCache() const
+    {
+    if (m_ecsqlParseTreeCache == nullptr)
+        {
+        BeMutexHolder lock(m_mutex);
+        if (m_ecsqlParseTreeCache == nullptr)
+            m_ecsqlParseTreeCache = std::make_unique<ECSqlParseTreeCache>(m_ecdb);
+        }
+    return *m_ecsqlParseTreeCache;
+    }
+
+//--------------------------------------------------------------------------------------
+// @bsimethod
+//---------------+---------------+---------------+---------------+---------------+------
+ECSqlTranslationCacheListener& ECDb::Impl::GetECSqlTranslationCacheListener() const
+    {
+    if (m_ecsqlTranslationCacheListener == nullptr)
+        {
+        BeMutexHolder lock(m_mutex);
+        if (m_ecsqlTranslationCacheListener == nullptr)
+            m_ecsqlTranslationCacheListener = std::make_unique<ECSqlTranslationCacheListener>(m_ecdb);
+        }
+    return *m_ecsqlTranslationCacheListener;
+    }
+
 ECDb::Impl::Impl(ECDbR ecdb) : m_ecdb(ecdb), m_profileManager(ecdb), m_changeManager(ecdb), m_sqliteStatementCache(50, &m_mutex), m_idSequenceManager(ecdb, bvector<Utf8CP>(1, "ec_instanceidsequence"))
     {
     m_schemaManager = std::make_unique<SchemaManager>(ecdb, m_mutex);
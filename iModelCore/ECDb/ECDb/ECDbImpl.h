@@ -82,6 +82,8 @@ struct IdFactory final: NonCopyableClass {
 };
 
 struct PragmaManager;
+struct ECSqlParseTreeCache;
+struct ECSqlTranslationCacheListener;
 //=======================================================================================
 //! ECDb::Impl is the private implementation of ECDb hidden from the public headers
 //! (PIMPL idiom)
@@ -161,6 +163,8 @@ private:
     mutable std::unique_ptr<PropExistsFunc> m_propExistsFunc;
     mutable EC::ECSqlConfig m_ecSqlConfig;
     mutable std::unique_ptr<PragmaManager> m_pragmaProcessor;
+    mutable std::unique_ptr<ECSqlParseTreeCache> m_ecsqlParseTreeCache;
+    mutable std::unique_ptr<ECSqlTranslationCacheListener> m_ecsqlTranslationCacheListener;
     //Mirrored ECDb methods are only called by ECDb (friend), therefore private
     explicit Impl(ECDbR ecdb);
 
@@ -221,6 +225,9 @@ public:
     BeGuid GetId() const  {return m_id; }
     IdFactory& GetIdFactory() const;
     PragmaManager& GetPragmaManager() const;
+    ECSqlParseTreeCache& GetECSqlParseTreeCache() const;
+    //! Created with the first translation this ECDb publishes to the process-wide ECSqlTranslationCache
+    ECSqlTranslationCacheListener& GetECSqlTranslationCacheListener() const;
     //! The clear cache counter is incremented with every call to ClearECDbCache. This is used
     //! by code that refers to objects held in the cache to invalidate itself.
     //! E.g. Any existing ECSqlStatement would be invalid after ClearECDbCache and would return
@@ -63,6 +63,7 @@
 #include "ChangeSummaryExtractor.h"
 #include "ConcurrentQueryManagerImpl.h"
 #include "QueryJsonAdaptor.h"
+#include "QueryColumnarAdaptor.h"
 #include "InstanceReaderImpl.h"
 #include "IntegrityChecker.h"
 #include "ECSql/NativeSqlBuilder.h"
@@ -123,3 +124,4 @@
 #include "ECSql/ECSqlStatementNoopImpls.h"
 
 #include "ECSql/ECInstanceAdapterHelper.h"
+#include "ECSql/ECSqlRowECInstance.h"
@@ -19,6 +19,16 @@ ArrayECSqlBinder::ArrayECSqlBinder(ECSqlPrepareContext& ctx, ECSqlTypeInfo const
     Initialize();
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ArrayECSqlBinder::ArrayECSqlBinder(SingleECSqlPreparedStatement& preparedStatement, ArrayECSqlBinder const& prototype)
+    : ECSqlBinder(preparedStatement, prototype)
+    {
+    BeAssert(GetTypeInfo().IsArray());
+    Initialize();
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
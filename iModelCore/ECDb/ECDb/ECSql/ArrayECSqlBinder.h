@@ -73,6 +73,7 @@ private:
 
     void _OnClearBindings() override { Initialize(); }
     ECSqlStatus _OnBeforeStep() override;
+    std::unique_ptr<ECSqlBinder> _Clone(SingleECSqlPreparedStatement& preparedStatement) const override { return std::make_unique<ArrayECSqlBinder>(preparedStatement, *this); }
 
     ECSqlStatus _BindNull() override { _OnClearBindings(); return ECSqlStatus::Success; }
     ECSqlStatus _BindBoolean(bool value) override { return m_rootBinder->BindBoolean(value); }
@@ -95,6 +96,7 @@ private:
 
 public:
     ArrayECSqlBinder(ECSqlPrepareContext&, ECSqlTypeInfo const&, SqlParamNameGenerator&);
+    ArrayECSqlBinder(SingleECSqlPreparedStatement&, ArrayECSqlBinder const& prototype);
     ~ArrayECSqlBinder() {}
     };
 
@@ -135,6 +135,7 @@ private:
     //ECSqlField
     ECSqlStatus _OnAfterReset() override;
     ECSqlStatus _OnAfterStep() override;
+    std::unique_ptr<ECSqlField> _Clone(ECSqlSelectPreparedStatement& stmt) const override { return std::make_unique<ArrayECSqlField>(stmt, m_ecsqlColumnInfo, m_sqliteColumnIndex); }
 
     void DoReset() const;
 
@@ -36,6 +36,9 @@ struct DynamicSelectClauseECClass final
     public:
         DynamicSelectClauseECClass() {}
         ECSqlStatus GeneratePropertyIfRequired(ECN::ECPropertyCP& generatedProperty, ECSqlPrepareContext&, DerivedPropertyExp const& selectClauseItemExp, PropertyNameExp const* selectClauseItemPropNameExp);
+        //! Shares the class generated by @p prototype, whose properties the column infos of the prototype's fields refer to.
+        //! The select clause names are not copied as they refer to the prototype's parse tree and are only needed while preparing.
+        void ShareGeneratedClass(DynamicSelectClauseECClass const& prototype) { m_schema = prototype.m_schema; m_class = prototype.m_class; }
     };
 
 END_BENTLEY_SQLITE_EC_NAMESPACE
@@ -68,6 +68,59 @@ ECN::IECInstancePtr ECInstanceECSqlSelectAdapter::GetInstance() const
     if (!m_isValid)
         return nullptr;
 
+    ECN::ECClassCP ecClass = GetRowClass();
+    if (nullptr == ecClass)
+        return nullptr;
+
+    ECN::IECInstancePtr instance = ECInstanceAdapterHelper::CreateECInstance(*ecClass);
+    if (SUCCESS != SetInstanceData(*instance, false))
+        return nullptr;
+
+    return instance;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ECN::IECInstanceCP ECInstanceECSqlSelectAdapter::GetInstanceView() const
+    {
+    if (!m_isValid)
+        return nullptr;
+
+    ECN::ECClassCP ecClass = GetRowClass();
+    if (nullptr == ecClass)
+        return nullptr;
+
+    auto iter = m_instanceViews.find(ecClass->GetId());
+    if (m_instanceViews.end() != iter)
+        return iter->second.get();
+
+    if (ecClass->IsRelationshipClass())
+        {
+        LOG.errorv("ECInstanceECSqlSelectAdapter::GetInstanceView does not support ECRelationshipClasses. Use GetInstance instead. ECSQL: %s", m_ecSqlStatement.GetECSql());
+        return nullptr;
+        }
+
+    // map the select clause to the ClassLayout of the row class once - every following row of this class reuses the view
+    RefCountedPtr<ECSqlRowECInstance> view = ECSqlRowECInstance::Create(*this, m_ecSqlStatement, *ecClass);
+    view->SetECInstanceIdColumn(m_ecInstanceIdColumnIndex);
+    ColumnHandler const propertyHandler = &ECInstanceECSqlSelectAdapter::SetPropertyData;
+    ColumnHandler const navigationHandler = &ECInstanceECSqlSelectAdapter::SetNavigationValue;
+    for (int i = 0; i < m_ecSqlStatement.GetColumnCount(); i++)
+        {
+        if (propertyHandler == m_columnHandlers[i] || navigationHandler == m_columnHandlers[i])
+            view->MapColumn(i);
+        }
+
+    m_instanceViews[ecClass->GetId()] = view;
+    return view.get();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ECN::ECClassCP ECInstanceECSqlSelectAdapter::GetRowClass() const
+    {
     if (!m_isSingleClassSelectClause)
         {
         LOG.error("Can only call ECInstanceECSqlSelectAdapter::GetInstance() for an ECSQL select clause made up properties from a single ECClass.");
@@ -95,16 +148,9 @@ ECN::IECInstancePtr ECInstanceECSqlSelectAdapter::GetInstance() const
         }
 
     if (nullptr == ecClass)
-        {
         LOG.debugv("ECInstanceECSqlSelectAdapter::GetInstance - failed to get ecClass from %s", m_ecSqlStatement.GetECSql());
-        return nullptr;
-        }
 
-    ECN::IECInstancePtr instance = ECInstanceAdapterHelper::CreateECInstance(*ecClass);
-    if (SUCCESS != SetInstanceData(*instance, false))
-        return nullptr;
-
-    return instance;
+    return ecClass;
     }
 
 //----------------------------------------------------------------------------------
@@ -239,7 +285,7 @@ BentleyStatus ECInstanceECSqlSelectAdapter::SetPropertyData(IECInstanceR instanc
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-BentleyStatus ECInstanceECSqlSelectAdapter::SetPrimitiveValue(ECValueR val, ECN::PrimitiveType primitiveType, IECSqlValue const& value) const
+BentleyStatus ECInstanceECSqlSelectAdapter::SetPrimitiveValue(ECValueR val, ECN::PrimitiveType primitiveType, IECSqlValue const& value, bool copyStrings) const
     {
     if (value.IsNull())
         {
@@ -258,7 +304,7 @@ BentleyStatus ECInstanceECSqlSelectAdapter::SetPrimitiveValue(ECValueR val, ECN:
             case ECN::PRIMITIVETYPE_String:
             {
             auto str = value.GetText();
-            val.SetUtf8CP(str);
+            val.SetUtf8CP(str, copyStrings);
             break;
             }
             case ECN::PRIMITIVETYPE_Long:
@@ -507,6 +553,7 @@ BentleyStatus ECInstanceECSqlSelectAdapter::CreateColumnHandlers()
                         case ECSqlSystemPropertyInfo::Class::ECInstanceId:
                         {
                         m_columnHandlers.push_back(&ECInstanceECSqlSelectAdapter::SetInstanceId);
+                        m_ecInstanceIdColumnIndex = i;
                         continue;
                         }
 
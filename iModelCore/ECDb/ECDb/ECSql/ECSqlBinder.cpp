@@ -292,6 +292,31 @@ ECSqlBinder* ECSqlParameterMap::AddBinder(ECSqlPrepareContext& ctx, ParameterExp
     return binderP;
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ECSqlParameterMap::CopyFrom(SingleECSqlPreparedStatement& preparedStatement, ECSqlParameterMap const& prototype)
+    {
+    BeAssert(m_ownedBinders.empty() && "ECSqlParameterMap::CopyFrom must only be called on an empty map");
+    //binders are owned in parameter index order (see AddBinder)
+    BeAssert(prototype.m_ownedBinders.size() == prototype.m_binders.size());
+    for (std::unique_ptr<ECSqlBinder> const& prototypeBinder : prototype.m_ownedBinders)
+        {
+        std::unique_ptr<ECSqlBinder> binder = prototypeBinder->Clone(preparedStatement);
+        ECSqlBinder* binderP = binder.get();
+        m_ownedBinders.push_back(std::move(binder));
+        m_binders.push_back(binderP);
+
+        if (binderP->HasToCallOnBeforeStep())
+            m_bindersToCallOnStep.push_back(binderP);
+
+        if (binderP->HasToCallOnClearBindings())
+            m_bindersToCallOnClearBindings.push_back(binderP);
+        }
+
+    m_nameToIndexMapping = prototype.m_nameToIndexMapping;
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -61,9 +61,15 @@ struct ECSqlBinder : IECSqlBinder
 
         virtual ECSqlStatus _OnBeforeStep() { return ECSqlStatus::Success; }
         virtual void _OnClearBindings() {}
+        virtual std::unique_ptr<ECSqlBinder> _Clone(SingleECSqlPreparedStatement&) const = 0;
 
     protected:
         ECSqlBinder(ECSqlPrepareContext&, ECSqlTypeInfo const&, SqlParamNameGenerator&, int mappedSqlParameterCount, bool hasToCallOnBeforeStep, bool hasToCallOnClearBindings);
+        //! Use this ctor to copy the parameter mapping of @p prototype into another prepared statement of the same ECSQL
+        ECSqlBinder(SingleECSqlPreparedStatement& preparedStatement, ECSqlBinder const& prototype)
+            : m_preparedStatement(preparedStatement), m_typeInfo(prototype.m_typeInfo), m_mappedSqlParameterNames(prototype.m_mappedSqlParameterNames),
+            m_hasToCallOnBeforeStep(prototype.m_hasToCallOnBeforeStep), m_hasToCallOnClearBindings(prototype.m_hasToCallOnClearBindings)
+            {}
         //! Use this ctor for compound binders where the mapped sql parameter count depends on its member binders
         ECSqlBinder(ECSqlPrepareContext& ctx, ECSqlTypeInfo const& typeInfo, SqlParamNameGenerator& paramNameGen, bool hasToCallOnBeforeStep, bool hasToCallOnClearBindings) : ECSqlBinder(ctx, typeInfo, paramNameGen, -1, hasToCallOnBeforeStep, hasToCallOnClearBindings) {}
 
@@ -91,6 +97,10 @@ struct ECSqlBinder : IECSqlBinder
 
         ECSqlStatus OnBeforeStep() { return _OnBeforeStep(); }
         void OnClearBindings() { return _OnClearBindings(); }
+
+        //! Creates a binder with the same parameter mapping for another prepared statement of the same ECSQL.
+        //! Bound values are not copied.
+        std::unique_ptr<ECSqlBinder> Clone(SingleECSqlPreparedStatement& preparedStatement) const { return _Clone(preparedStatement); }
     };
 
 struct IdECSqlBinder;
@@ -148,6 +158,8 @@ struct ECSqlParameterMap final
         int GetIndexForName(Utf8StringCR ecsqlParameterName) const;
 
         ECSqlBinder* AddBinder(ECSqlPrepareContext&, ParameterExp const&);
+        //! Copies the binders of @p prototype, which was prepared from the same ECSQL, into this empty map
+        void CopyFrom(SingleECSqlPreparedStatement&, ECSqlParameterMap const& prototype);
         ECSqlStatus OnBeforeStep();
 
         //Bindings in SQLite have already been cleared at this point. The method
@@ -26,6 +26,7 @@ private:
 
     virtual ECSqlStatus _OnAfterReset() { return ECSqlStatus::Success; }
     virtual ECSqlStatus _OnAfterStep() { return ECSqlStatus::Success; }
+    virtual std::unique_ptr<ECSqlField> _Clone(ECSqlSelectPreparedStatement&) const = 0;
 
 protected:
     ECSqlField(ECSqlSelectPreparedStatement& ecsqlStatement, ECSqlColumnInfo const& ecsqlColumnInfo, bool needsOnAfterStep, bool needsOnAfterReset)
@@ -41,6 +42,9 @@ public:
     ECSqlStatus OnAfterStep() { return _OnAfterStep(); }
     bool RequiresOnAfterReset() const { return m_requiresOnAfterReset; }
     ECSqlStatus OnAfterReset() { return _OnAfterReset(); }
+
+    //! Creates a field with the same column layout for another prepared statement of the same ECSQL
+    std::unique_ptr<ECSqlField> Clone(ECSqlSelectPreparedStatement& stmt) const { return _Clone(stmt); }
     };
 
 END_BENTLEY_SQLITE_EC_NAMESPACE
\ No newline at end of file
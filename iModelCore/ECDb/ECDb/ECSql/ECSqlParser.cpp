@@ -104,6 +104,91 @@ std::unique_ptr<Exp> ECSqlParser::Parse(ECDbCR ecdb, Utf8CP ecsql, IssueDataSour
     return exp;
 }
 
+//-----------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+--------
+ECSqlParseTreeCache::Entry::Entry(Utf8CP ecsql, uint32_t clearCacheCount, std::unique_ptr<Exp> exp)
+    : m_ecsql(ecsql), m_hashCode(ECSqlStatement::GetHashCode(ecsql)), m_clearCacheCount(clearCacheCount), m_exp(std::move(exp)), m_isCheckedOut(true)
+    {
+    BeAssert(m_exp != nullptr);
+    }
+
+//-----------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+--------
+ECSqlParseTreeCache::ECSqlParseTreeCache(ECDbCR ecdb, uint32_t maxEntries) : m_ecdb(ecdb), m_maxEntries(maxEntries)
+    {
+    const_cast<ECDbR>(m_ecdb).AddECDbCacheClearListener(*this);
+    }
+
+//-----------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+--------
+ECSqlParseTreeCache::~ECSqlParseTreeCache()
+    {
+    const_cast<ECDbR>(m_ecdb).RemoveECDbCacheClearListener(*this);
+    }
+
+//-----------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+--------
+ECSqlParseTreeCache::Lease ECSqlParseTreeCache::CheckOut(Utf8CP ecsql) const
+    {
+    const uint64_t hashCode = ECSqlStatement::GetHashCode(ecsql);
+    BeMutexHolder lock(m_mutex);
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [hashCode, ecsql] (EntryPtr const& entry)
+        {
+        return entry->GetHashCode() == hashCode && entry->GetECSql().Equals(ecsql);
+        });
+
+    if (it == m_entries.end())
+        return Lease();
+
+    EntryPtr entry = *it;
+    if (it != m_entries.begin())
+        {
+        m_entries.erase(it);
+        m_entries.insert(m_entries.begin(), entry);
+        }
+
+    //another statement is preparing from the tree, the caller parses its own
+    if (!entry->TryCheckOut())
+        return Lease();
+
+    return Lease(entry);
+    }
+
+//-----------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+--------
+void ECSqlParseTreeCache::Add(EntryPtr entry)
+    {
+    BeMutexHolder lock(m_mutex);
+    //the schema objects the tree refers to were released when the ECDb cache was cleared
+    if (entry->GetClearCacheCount() != m_ecdb.GetImpl().GetClearCacheCounter().GetValue())
+        return;
+
+    for (EntryPtr const& existing : m_entries)
+        {
+        if (existing == entry || (existing->GetHashCode() == entry->GetHashCode() && existing->GetECSql().Equals(entry->GetECSql())))
+            return;
+        }
+
+    if (m_entries.size() >= m_maxEntries)
+        m_entries.pop_back();
+
+    m_entries.insert(m_entries.begin(), entry);
+    }
+
+//-----------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+--------
+void ECSqlParseTreeCache::Clear()
+    {
+    BeMutexHolder lock(m_mutex);
+    m_entries.clear();
+    }
+
 //-----------------------------------------------------------------------------------------
 // @bsimethod
 //+---------------+---------------+---------------+---------------+---------------+--------
@@ -10,6 +10,7 @@
 #include "DeleteStatementExp.h"
 #include "PragmaStatementExp.h"
 #include "CommonTableExp.h"
+#include <atomic>
 BEGIN_BENTLEY_SQLITE_EC_NAMESPACE
 
 //=======================================================================================
@@ -250,4 +251,104 @@ public:
     std::unique_ptr<Exp> Parse(ECDbCR, Utf8CP ecsql, IssueDataSource const&) const;
     };
 
+//=======================================================================================
+//! Caches the parse trees of recently prepared ECSQL statements of an ECDb connection.
+//! All statements parsed against the connection share it, including those prepared by
+//! concurrent query workers, which parse against the primary connection's schemas and
+//! only prepare the SQLite statement on their own connection.
+//! The trees refer to the connection's schema objects, so the cache is emptied whenever
+//! the ECDb cache is cleared.
+// @bsiclass
+//+===============+===============+===============+===============+===============+======
+struct ECSqlParseTreeCache final : ECDb::IECDbCacheClearListener
+    {
+    //=======================================================================================
+    //! A parse tree and the ECSQL it was parsed from. Preparing a statement memoizes native
+    //! SQL snippets in the tree, so a tree is used by one statement at a time: it is checked
+    //! out with a compare-and-set on its in-use flag, and no lock is held while using it.
+    // @bsiclass
+    //+===============+===============+===============+===============+===============+======
+    struct Entry final
+        {
+    private:
+        Utf8String m_ecsql;
+        uint64_t m_hashCode;
+        uint32_t m_clearCacheCount;
+        std::unique_ptr<Exp> m_exp;
+        mutable std::atomic<bool> m_isCheckedOut;
+
+        //not copyable
+        Entry(Entry const&) = delete;
+        Entry& operator=(Entry const&) = delete;
+
+    public:
+        //! A new entry is checked out by the statement that parsed it.
+        Entry(Utf8CP ecsql, uint32_t clearCacheCount, std::unique_ptr<Exp> exp);
+
+        Utf8StringCR GetECSql() const { return m_ecsql; }
+        uint64_t GetHashCode() const { return m_hashCode; }
+        //! Value of the ECDb clear cache counter when the ECSQL was parsed
+        uint32_t GetClearCacheCount() const { return m_clearCacheCount; }
+        Exp const& GetExp() const { return *m_exp; }
+        bool TryCheckOut() const { bool expected = false; return m_isCheckedOut.compare_exchange_strong(expected, true); }
+        void CheckIn() const { m_isCheckedOut.store(false); }
+        };
+
+    typedef std::shared_ptr<Entry> EntryPtr;
+
+    //=======================================================================================
+    //! Exclusive use of a checked out parse tree. The tree is checked in when the lease is destroyed.
+    // @bsiclass
+    //+===============+===============+===============+===============+===============+======
+    struct Lease final
+        {
+    private:
+        EntryPtr m_entry;
+
+        //not copyable
+        Lease(Lease const&) = delete;
+        Lease& operator=(Lease const&) = delete;
+
+    public:
+        Lease() {}
+        //! @p entry must have been checked out by the caller
+        explicit Lease(EntryPtr entry) : m_entry(entry) {}
+        Lease(Lease&& rhs) : m_entry(std::move(rhs.m_entry)) {}
+        Lease& operator=(Lease&& rhs) { if (this != &rhs) { Release(); m_entry = std::move(rhs.m_entry); } return *this; }
+        ~Lease() { Release(); }
+
+        void Release() { if (m_entry != nullptr) { m_entry->CheckIn(); m_entry = nullptr; } }
+        bool IsValid() const { return m_entry != nullptr; }
+        EntryPtr const& GetEntry() const { return m_entry; }
+        Exp const& GetExp() const { return m_entry->GetExp(); }
+        };
+    static const uint32_t DEFAULT_MAX_ENTRIES = 100;
+
+private:
+    ECDbCR m_ecdb;
+    mutable BeMutex m_mutex;
+    mutable bvector<EntryPtr> m_entries; //most recently used first
+    uint32_t m_maxEntries;
+
+    //not copyable
+    ECSqlParseTreeCache(ECSqlParseTreeCache const&) = delete;
+    ECSqlParseTreeCache& operator=(ECSqlParseTreeCache const&) = delete;
+
+    void _OnBeforeClearECDbCache() override { Clear(); }
+
+public:
+    explicit ECSqlParseTreeCache(ECDbCR, uint32_t maxEntries = DEFAULT_MAX_ENTRIES);
+    ~ECSqlParseTreeCache();
+
+    //! Checks out the cached parse tree for the ECSQL. The cache mutex is only held for the lookup.
+    //! Returns an invalid lease if the ECSQL is not cached, or if its tree is checked out by another statement.
+    Lease CheckOut(Utf8CP ecsql) const;
+    //! Publishes a tree that was successfully prepared, unless a tree for the same ECSQL was published in
+    //! the meantime, in which case the cached tree is kept. Trees parsed before the ECDb cache was last
+    //! cleared are ignored as well.
+    void Add(EntryPtr);
+    void Clear();
+    size_t Size() const { BeMutexHolder lock(m_mutex); return m_entries.size(); }
+    };
+
 END_BENTLEY_SQLITE_EC_NAMESPACE
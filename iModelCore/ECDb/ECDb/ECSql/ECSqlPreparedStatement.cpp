@@ -29,6 +29,18 @@ ECSqlStatus IECSqlPreparedStatement::Prepare(ECSqlPrepareContext& ctx, Exp const
     return _Prepare(ctx, exp);
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void IECSqlPreparedStatement::InitializeFrom(IECSqlPreparedStatement const& prototype)
+    {
+    BeAssert(&m_ecdb == &prototype.m_ecdb && m_type == prototype.m_type);
+    //the statement refers to the same schema objects as the prototype, so it is only valid as long as the prototype
+    m_preparationClearCacheCounter = prototype.m_preparationClearCacheCounter;
+    m_ecsql.assign(prototype.m_ecsql);
+    m_isNoopInSqlite = prototype.m_isNoopInSqlite;
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -135,13 +147,21 @@ ECSqlStatus SingleECSqlPreparedStatement::_Prepare(ECSqlPrepareContext& ctx, Exp
         return ECSqlStatus::Success;
         }
 
+    return PrepareNativeSql(ctx.GetDataSourceConnection(), nativeSql.c_str(), ctx.Issues());
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ECSqlStatus SingleECSqlPreparedStatement::PrepareNativeSql(Db const& dataSourceDb, Utf8CP nativeSql, IssueDataSource const& issues)
+    {
     //don't let BeSQLite log and assert on error (therefore use TryPrepare instead of Prepare)
-    const DbResult nativeSqlStat = m_sqliteStatement.TryPrepare(ctx.GetDataSourceConnection(), nativeSql.c_str());
+    const DbResult nativeSqlStat = m_sqliteStatement.TryPrepare(dataSourceDb, nativeSql);
 
     if (nativeSqlStat != BE_SQLITE_OK)
         {
-        ctx.Issues().ReportV(IssueSeverity::Error, IssueCategory::BusinessProperties, IssueType::ECSQL, "Preparing the ECSQL '%s' failed. Underlying SQLite statement failed to prepare: %s %s [SQL: %s]", GetECSql(),
-            ECDb::InterpretDbResult(nativeSqlStat), ctx.GetDataSourceConnection().GetLastError().c_str(), nativeSql.c_str());
+        issues.ReportV(IssueSeverity::Error, IssueCategory::BusinessProperties, IssueType::ECSQL, "Preparing the ECSQL '%s' failed. Underlying SQLite statement failed to prepare: %s %s [SQL: %s]", GetECSql(),
+            ECDb::InterpretDbResult(nativeSqlStat), dataSourceDb.GetLastError().c_str(), nativeSql);
 
         //even if this is a SQLite error, we want this to be an InvalidECSql error as the reason usually
         //is a wrong ECSQL provided by the user.
@@ -151,8 +171,17 @@ ECSqlStatus SingleECSqlPreparedStatement::_Prepare(ECSqlPrepareContext& ctx, Exp
         return ECSqlStatus::InvalidECSql;
         }
 
-        SetDataSourceDb(ctx.GetDataSourceConnection());
-        return ECSqlStatus::Success;
+    SetDataSourceDb(dataSourceDb);
+    return ECSqlStatus::Success;
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void SingleECSqlPreparedStatement::CopyTranslation(SingleECSqlPreparedStatement const& prototype)
+    {
+    InitializeFrom(prototype);
+    m_parameterMap.CopyFrom(*this, prototype.m_parameterMap);
     }
 
 
@@ -484,6 +513,23 @@ void ECSqlSelectPreparedStatement::AddField(std::unique_ptr<ECSqlField> field)
         }
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::unique_ptr<ECSqlSelectPreparedStatement> ECSqlSelectPreparedStatement::CloneTranslation() const
+    {
+    std::unique_ptr<ECSqlSelectPreparedStatement> clone = std::make_unique<ECSqlSelectPreparedStatement>(m_ecdb);
+    clone->CopyTranslation(*this);
+    //the column infos of computed select clause items refer to the properties of the generated class
+    clone->m_dynamicSelectClauseECClass.ShareGeneratedClass(m_dynamicSelectClauseECClass);
+    for (std::unique_ptr<ECSqlField> const& field : m_fields)
+        {
+        clone->AddField(field->Clone(*clone));
+        }
+
+    return clone;
+    }
+
 
 //***************************************************************************************
 //    ECSqlInsertPreparedStatement
@@ -1680,4 +1726,160 @@ IECSqlBinder& CompoundECSqlPreparedStatement::ProxyECSqlBinder::_AddArrayElement
     return *m_arrayElementProxyBinder;
     }
 
+//***************************************************************************************
+//    ECSqlTranslationCache
+//***************************************************************************************
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ECSqlTranslationCache::Entry::Entry(ECSqlSelectPreparedStatement const& preparedStatement, Utf8StringCR configKey)
+    : m_ecdbId(preparedStatement.GetECDb().GetImpl().GetId()), m_ecsql(preparedStatement.GetECSql()), m_hashCode(ECSqlStatement::GetHashCode(preparedStatement.GetECSql())),
+    m_profileVersion(preparedStatement.GetECDb().GetECDbProfileVersion()), m_clearCacheCount(preparedStatement.GetPreparationClearCacheCounter().GetValue()),
+    m_configKey(configKey), m_nativeSql(preparedStatement.GetNativeSql()), m_prototype(preparedStatement.CloneTranslation())
+    {}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+bool ECSqlTranslationCache::Entry::Matches(BeGuid ecdbId, uint64_t hashCode, Utf8CP ecsql, ProfileVersion const& profileVersion, uint32_t clearCacheCount, Utf8StringCR configKey) const
+    {
+    return m_hashCode == hashCode && m_ecdbId == ecdbId && m_clearCacheCount == clearCacheCount && m_ecsql.Equals(ecsql) &&
+        m_profileVersion == profileVersion && m_configKey.Equals(configKey);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+//static
+ECSqlTranslationCache& ECSqlTranslationCache::Get()
+    {
+    //never freed, as ECDb connections may still remove their entries while static objects are destroyed
+    static ECSqlTranslationCache* s_cache = new ECSqlTranslationCache(DEFAULT_MAX_ENTRIES);
+    return *s_cache;
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+//static
+Utf8String ECSqlTranslationCache::GetConfigKey(ECDbCR ecdb)
+    {
+    ECSqlConfig& config = ecdb.GetECSqlConfig();
+    Utf8String key;
+    key.Sprintf("%d%d%d", config.GetExperimentalFeaturesEnabled() ? 1 : 0,
+                config.GetOptimizationOption(OptimizationOptions::OptimizeJoinForClassIds) ? 1 : 0,
+                config.GetOptimizationOption(OptimizationOptions::OptimizeJoinForNestedSelectQuery) ? 1 : 0);
+
+    for (Utf8StringCR disabledFunction : config.GetDisableFunctions().GetList())
+        {
+        key.append(";").append(disabledFunction);
+        }
+
+    return key;
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ECSqlTranslationCache::EntryPtr ECSqlTranslationCache::Find(ECDbCR ecdb, Utf8CP ecsql) const
+    {
+    const BeGuid ecdbId = ecdb.GetImpl().GetId();
+    const uint64_t hashCode = ECSqlStatement::GetHashCode(ecsql);
+    const uint32_t clearCacheCount = ecdb.GetImpl().GetClearCacheCounter().GetValue();
+    const Utf8String configKey = GetConfigKey(ecdb);
+    ProfileVersion const& profileVersion = ecdb.GetECDbProfileVersion();
+
+    BeMutexHolder lock(m_mutex);
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [&] (EntryPtr const& entry)
+        {
+        return entry->Matches(ecdbId, hashCode, ecsql, profileVersion, clearCacheCount, configKey);
+        });
+
+    if (it == m_entries.end())
+        return nullptr;
+
+    EntryPtr entry = *it;
+    if (it != m_entries.begin())
+        {
+        m_entries.erase(it);
+        m_entries.insert(m_entries.begin(), entry);
+        }
+
+    return entry;
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ECSqlTranslationCache::Add(ECSqlSelectPreparedStatement const& preparedStatement)
+    {
+    ECDbCR ecdb = preparedStatement.GetECDb();
+    //the schema objects the translation refers to were released when the ECDb cache was cleared
+    if (preparedStatement.GetPreparationClearCacheCounter() != ecdb.GetImpl().GetClearCacheCounter() || preparedStatement.IsNoopInSqlite())
+        return;
+
+    //make sure the entries are removed when the ECDb cache is cleared. Must be called before the cache mutex is acquired,
+    //as the listener is called by ECDb::ClearECDbCache while the ECDb mutex is held.
+    ecdb.GetImpl().GetECSqlTranslationCacheListener();
+
+    //the prototype is cloned outside of the cache mutex
+    EntryPtr entry = std::make_shared<Entry>(preparedStatement, GetConfigKey(ecdb));
+
+    BeMutexHolder lock(m_mutex);
+    for (EntryPtr const& existing : m_entries)
+        {
+        if (existing->Matches(*entry))
+            return;
+        }
+
+    if (m_entries.size() >= m_maxEntries)
+        m_entries.pop_back();
+
+    m_entries.insert(m_entries.begin(), entry);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void ECSqlTranslationCache::Remove(BeGuid ecdbId)
+    {
+    //entries are only released after the cache mutex was released
+    bvector<EntryPtr> removedEntries;
+    BeMutexHolder lock(m_mutex);
+    auto it = std::stable_partition(m_entries.begin(), m_entries.end(), [ecdbId] (EntryPtr const& entry) { return entry->GetECDbId() != ecdbId; });
+    removedEntries.insert(removedEntries.end(), it, m_entries.end());
+    m_entries.erase(it, m_entries.end());
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+size_t ECSqlTranslationCache::Size(ECDbCR ecdb) const
+    {
+    const BeGuid ecdbId = ecdb.GetImpl().GetId();
+    BeMutexHolder lock(m_mutex);
+    return (size_t) std::count_if(m_entries.begin(), m_entries.end(), [ecdbId] (EntryPtr const& entry) { return entry->GetECDbId() == ecdbId; });
+    }
+
+//***************************************************************************************
+//    ECSqlTranslationCacheListener
+//***************************************************************************************
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ECSqlTranslationCacheListener::ECSqlTranslationCacheListener(ECDbCR ecdb) : m_ecdb(ecdb), m_ecdbId(ecdb.GetImpl().GetId())
+    {
+    const_cast<ECDbR>(m_ecdb).AddECDbCacheClearListener(*this);
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+ECSqlTranslationCacheListener::~ECSqlTranslationCacheListener()
+    {
+    //the ECDb is closed
+    ECSqlTranslationCache::Get().Remove(m_ecdbId);
+    const_cast<ECDbR>(m_ecdb).RemoveECDbCacheClearListener(*this);
+    }
+
 END_BENTLEY_SQLITE_EC_NAMESPACE
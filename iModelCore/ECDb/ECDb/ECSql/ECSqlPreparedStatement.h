@@ -44,6 +44,8 @@ struct IECSqlPreparedStatement
     protected:
         IECSqlPreparedStatement(ECDb const& ecdb, ECSqlType type, bool isCompoundStmt) : m_ecdb(ecdb), m_type(type), m_isCompoundStatement(isCompoundStmt), m_dataSourceDb(nullptr) {}
         void SetDataSourceDb(Db const& db) { m_dataSourceDb = &db; }
+        //! Takes over the ECSQL and the preparation state of @p prototype which was prepared from the same ECSQL
+        void InitializeFrom(IECSqlPreparedStatement const& prototype);
         BentleyStatus AssertIsValid() const;
 
     public:
@@ -64,6 +66,7 @@ struct IECSqlPreparedStatement
         ECDb const& GetECDb() const { return m_ecdb; }
         bool IsCompoundStatement() const { return m_isCompoundStatement; }
         ECSqlType GetType() const { return m_type; }
+        ECDb::Impl::ClearCacheCounter const& GetPreparationClearCacheCounter() const { return m_preparationClearCacheCounter; }
     };
 
 //=======================================================================================
@@ -89,9 +92,14 @@ protected:
     ECSqlStatus _Prepare(ECSqlPrepareContext&, Exp const&) override;
     ECSqlStatus _Reset() override;
 
+    //! Copies the ECSQL and the parameter map of @p prototype which was prepared from the same ECSQL
+    void CopyTranslation(SingleECSqlPreparedStatement const& prototype);
+
 public:
     virtual ~SingleECSqlPreparedStatement() {}
 
+    //! Prepares the SQLite statement from the native SQL the ECSQL was translated to
+    ECSqlStatus PrepareNativeSql(Db const& dataSourceDb, Utf8CP nativeSql, IssueDataSource const&);
     DbResult DoStep();
 
     ECSqlParameterMap const& GetParameterMap() const { return m_parameterMap; }
@@ -260,6 +268,10 @@ struct ECSqlSelectPreparedStatement final : SingleECSqlPreparedStatement
 
         void AddField(std::unique_ptr<ECSqlField>);
         DynamicSelectClauseECClass& GetDynamicSelectClauseECClassR() { return m_dynamicSelectClauseECClass; }
+
+        //! Creates a statement with the translation of this statement, i.e. its parameter map and its ECSqlFields.
+        //! The SQLite statement of the clone is not prepared yet, see PrepareNativeSql.
+        std::unique_ptr<ECSqlSelectPreparedStatement> CloneTranslation() const;
     };
 
 //=======================================================================================
@@ -515,4 +527,101 @@ public:
     DbResult Step();
     };
 
+//=======================================================================================
+//! Process-wide cache of translated SELECT statements. An entry holds the native SQL and an
+//! unprepared prototype of the prepared statement (parameter map and ECSqlField layout), so that
+//! preparing the same ECSQL again - on the ECDb or on any other connection to the same file used
+//! as data source (e.g. by the concurrent query workers) - only prepares the native SQL in SQLite.
+//! Binders and fields refer to the schema objects of the ECDb that translated the ECSQL, so entries
+//! are keyed on that ECDb connection, the ECSQL, the ECDb profile version, the ECDb clear cache counter
+//! and the ECSqlConfig options that affect the translation. The ECDb's ECSqlTranslationCacheListener
+//! removes its entries when the ECDb cache is cleared (e.g. by a schema import) or the ECDb is closed.
+// @bsiclass
+//+===============+===============+===============+===============+===============+======
+struct ECSqlTranslationCache final
+    {
+    //=======================================================================================
+    // @bsiclass
+    //+===============+===============+===============+===============+===============+======
+    struct Entry final
+        {
+    private:
+        BeGuid m_ecdbId;
+        Utf8String m_ecsql;
+        uint64_t m_hashCode;
+        ProfileVersion m_profileVersion;
+        uint32_t m_clearCacheCount;
+        Utf8String m_configKey;
+        Utf8String m_nativeSql;
+        std::unique_ptr<ECSqlSelectPreparedStatement> m_prototype;
+
+        //not copyable
+        Entry(Entry const&) = delete;
+        Entry& operator=(Entry const&) = delete;
+
+    public:
+        Entry(ECSqlSelectPreparedStatement const& preparedStatement, Utf8StringCR configKey);
+
+        bool Matches(BeGuid ecdbId, uint64_t hashCode, Utf8CP ecsql, ProfileVersion const& profileVersion, uint32_t clearCacheCount, Utf8StringCR configKey) const;
+        bool Matches(Entry const& rhs) const { return Matches(rhs.m_ecdbId, rhs.m_hashCode, rhs.m_ecsql.c_str(), rhs.m_profileVersion, rhs.m_clearCacheCount, rhs.m_configKey); }
+        BeGuid GetECDbId() const { return m_ecdbId; }
+        Utf8StringCR GetECSql() const { return m_ecsql; }
+        Utf8StringCR GetNativeSql() const { return m_nativeSql; }
+        //! The prototype must not be prepared or stepped. Statements are created from it with ECSqlSelectPreparedStatement::CloneTranslation
+        ECSqlSelectPreparedStatement const& GetPrototype() const { return *m_prototype; }
+        };
+
+    typedef std::shared_ptr<Entry const> EntryPtr;
+    static const uint32_t DEFAULT_MAX_ENTRIES = 500;
+
+private:
+    mutable BeMutex m_mutex;
+    mutable bvector<EntryPtr> m_entries; //most recently used first
+    uint32_t m_maxEntries;
+
+    //not copyable
+    ECSqlTranslationCache(ECSqlTranslationCache const&) = delete;
+    ECSqlTranslationCache& operator=(ECSqlTranslationCache const&) = delete;
+
+    explicit ECSqlTranslationCache(uint32_t maxEntries) : m_maxEntries(maxEntries) {}
+
+    static Utf8String GetConfigKey(ECDbCR);
+
+public:
+    static ECSqlTranslationCache& Get();
+
+    //! Returns the translation of the SELECT @p ecsql prepared against @p ecdb or nullptr if it is not cached.
+    //! The cache mutex is only held for the lookup, creating a statement from the entry happens outside of it.
+    EntryPtr Find(ECDbCR ecdb, Utf8CP ecsql) const;
+    //! Publishes the translation of a successfully prepared SELECT statement, unless the same ECSQL was
+    //! published in the meantime or the ECDb cache was cleared since the statement was prepared.
+    void Add(ECSqlSelectPreparedStatement const&);
+    //! Removes all entries translated by the ECDb with the specified id
+    void Remove(BeGuid ecdbId);
+    size_t Size() const { BeMutexHolder lock(m_mutex); return m_entries.size(); }
+    size_t Size(ECDbCR) const;
+    };
+
+//=======================================================================================
+//! Removes the ECSqlTranslationCache entries of an ECDb when its cache is cleared or when it is
+//! closed. Owned by ECDb::Impl.
+// @bsiclass
+//+===============+===============+===============+===============+===============+======
+struct ECSqlTranslationCacheListener final : ECDb::IECDbCacheClearListener
+    {
+private:
+    ECDbCR m_ecdb;
+    BeGuid m_ecdbId;
+
+    //not copyable
+    ECSqlTranslationCacheListener(ECSqlTranslationCacheListener const&) = delete;
+    ECSqlTranslationCacheListener& operator=(ECSqlTranslationCacheListener const&) = delete;
+
+    void _OnBeforeClearECDbCache() override { ECSqlTranslationCache::Get().Remove(m_ecdbId); }
+
+public:
+    explicit ECSqlTranslationCacheListener(ECDbCR);
+    ~ECSqlTranslationCacheListener();
+    };
+
 END_BENTLEY_SQLITE_EC_NAMESPACE
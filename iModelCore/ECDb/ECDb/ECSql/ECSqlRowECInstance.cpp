@@ -0,0 +1,161 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#include "ECDbPch.h"
+
+USING_NAMESPACE_BENTLEY_EC
+
+BEGIN_BENTLEY_SQLITE_EC_NAMESPACE
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ECSqlRowECInstance::ECSqlRowECInstance(ECInstanceECSqlSelectAdapter const& adapter, ECSqlStatement const& statement, ECClassCR ecClass)
+    : m_adapter(adapter), m_statement(statement), m_ecClass(ecClass), m_classLayout(ecClass.GetDefaultStandaloneEnabler()->GetClassLayout())
+    {
+    m_slots.resize(m_classLayout.GetPropertyCount());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ECSqlRowECInstance::MapColumn(int columnIndex)
+    {
+    ECSqlColumnInfo const& columnInfo = m_statement.GetColumnInfo(columnIndex);
+    ECPropertyCP prop = columnInfo.GetProperty();
+    if (nullptr == prop || columnInfo.IsGeneratedProperty() || nullptr == m_ecClass.GetPropertyP(prop->GetName().c_str()))
+        return;
+
+    MapProperty(*prop, prop->GetName(), columnIndex, bvector<Utf8CP>());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ECSqlRowECInstance::MapProperty(ECPropertyCR prop, Utf8StringCR accessString, int columnIndex, bvector<Utf8CP> const& memberPath)
+    {
+    uint32_t propertyIndex = 0;
+    if (ECObjectsStatus::Success != m_classLayout.GetPropertyIndex(propertyIndex, accessString.c_str()) || propertyIndex >= m_slots.size())
+        return;
+
+    m_slots[propertyIndex].m_property = &prop;
+    m_slots[propertyIndex].m_columnIndex = columnIndex;
+    m_slots[propertyIndex].m_memberPath = memberPath;
+
+    StructECPropertyCP structProp = prop.GetAsStructProperty();
+    if (nullptr == structProp)
+        return;
+
+    for (ECPropertyCP memberProp : structProp->GetType().GetProperties(true))
+        {
+        bvector<Utf8CP> memberMemberPath(memberPath);
+        memberMemberPath.push_back(memberProp->GetName().c_str());
+        Utf8String memberAccessString(accessString);
+        memberAccessString.append(".").append(memberProp->GetName());
+        MapProperty(*memberProp, memberAccessString, columnIndex, memberMemberPath);
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+IECSqlValue const* ECSqlRowECInstance::GetSqlValue(uint32_t propertyIndex) const
+    {
+    if (propertyIndex >= m_slots.size() || m_slots[propertyIndex].m_columnIndex < 0)
+        return nullptr;
+
+    PropertySlot const& slot = m_slots[propertyIndex];
+    IECSqlValue const* value = &m_statement.GetValue(slot.m_columnIndex);
+    for (Utf8CP memberName : slot.m_memberPath)
+        value = &(*value)[memberName];
+
+    return value;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Utf8String ECSqlRowECInstance::_GetInstanceId() const
+    {
+    if (m_ecInstanceIdColumnIndex < 0)
+        return Utf8String();
+
+    return m_statement.GetValueId<ECInstanceId>(m_ecInstanceIdColumnIndex).ToString();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ECObjectsStatus ECSqlRowECInstance::_GetValue(ECValueR v, uint32_t propertyIndex, bool useArrayIndex, uint32_t arrayIndex) const
+    {
+    PropertyLayoutCP propertyLayout = nullptr;
+    if (ECObjectsStatus::Success != m_classLayout.GetPropertyLayoutByIndex(propertyLayout, propertyIndex) || nullptr == propertyLayout)
+        return ECObjectsStatus::PropertyNotFound;
+
+    ECTypeDescriptor const& typeDescriptor = propertyLayout->GetTypeDescriptor();
+    if (useArrayIndex && !typeDescriptor.IsArray())
+        return ECObjectsStatus::PropertyNotFound;
+
+    v.Clear();
+    if (typeDescriptor.IsStruct())
+        {
+        // same as for ECDBuffer based instances, embedded structs can only be accessed member by member
+        v.SetStruct(nullptr);
+        return ECObjectsStatus::Success;
+        }
+
+    // properties which are not in the select clause are null
+    IECSqlValue const* value = GetSqlValue(propertyIndex);
+    if (typeDescriptor.IsPrimitive())
+        {
+        if (nullptr == value)
+            {
+            v = ECValue(typeDescriptor.GetPrimitiveType());
+            return ECObjectsStatus::Success;
+            }
+        return SUCCESS == m_adapter.SetPrimitiveValue(v, typeDescriptor.GetPrimitiveType(), *value, false) ? ECObjectsStatus::Success : ECObjectsStatus::Error;
+        }
+
+    if (typeDescriptor.IsNavigation())
+        {
+        if (nullptr == value || value->IsNull())
+            return v.SetNavigationInfo();
+
+        ECClassId relClassId;
+        ECInstanceId navId = value->GetNavigation<ECInstanceId>(&relClassId);
+        if (relClassId.IsValid())
+            return v.SetNavigationInfo(navId, relClassId);
+        return v.SetNavigationInfo(navId);
+        }
+
+    if (!typeDescriptor.IsArray())
+        return ECObjectsStatus::DataTypeNotSupported;
+
+    const uint32_t arrayLength = (nullptr == value || value->IsNull()) ? 0 : (uint32_t) value->GetArrayLength();
+    if (!useArrayIndex)
+        {
+        if (typeDescriptor.IsPrimitiveArray())
+            return v.SetPrimitiveArrayInfo(typeDescriptor.GetPrimitiveType(), arrayLength, false);
+        return v.SetStructArrayInfo(arrayLength, false);
+        }
+
+    if (arrayIndex >= arrayLength)
+        return ECObjectsStatus::IndexOutOfRange;
+
+    uint32_t i = 0;
+    for (IECSqlValue const& arrayElementValue : value->GetArrayIterable())
+        {
+        if (i++ != arrayIndex)
+            continue;
+
+        // struct array elements are the only values which are materialized into standalone struct instances
+        BentleyStatus stat = typeDescriptor.IsPrimitiveArray() ? m_adapter.SetPrimitiveValue(v, typeDescriptor.GetPrimitiveType(), arrayElementValue, false)
+            : m_adapter.SetStructArrayElement(v, m_slots[propertyIndex].m_property->GetAsStructArrayProperty()->GetStructElementType(), arrayElementValue);
+        return SUCCESS == stat ? ECObjectsStatus::Success : ECObjectsStatus::Error;
+        }
+
+    return ECObjectsStatus::IndexOutOfRange;
+    }
+
+END_BENTLEY_SQLITE_EC_NAMESPACE
@@ -0,0 +1,67 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#pragma once
+#include <ECDb/ECInstanceAdapter.h>
+
+BEGIN_BENTLEY_SQLITE_EC_NAMESPACE
+
+//======================================================================================
+//! Read-only IECInstance which reads its property values from the current row of an
+//! ECSqlStatement when they are requested, instead of copying them into an ECDBuffer.
+//! Properties are looked up by their ClassLayout property index, which is mapped to the
+//! ECSQL column (and struct member path within the column) once, when the view is created.
+//! The view is reused for every row of the statement, so it does not allocate per row.
+//! @see ECInstanceECSqlSelectAdapter::GetInstanceView
+// @bsiclass
+//+===============+===============+===============+===============+===============+======
+struct ECSqlRowECInstance final : ECN::IECInstance
+    {
+    private:
+        //======================================================================================
+        // @bsiclass
+        //+===============+===============+===============+===============+===============+======
+        struct PropertySlot final
+            {
+            ECN::ECPropertyCP m_property = nullptr;
+            int m_columnIndex = -1;
+            bvector<Utf8CP> m_memberPath;
+            };
+
+        ECInstanceECSqlSelectAdapter const& m_adapter;
+        ECSqlStatement const& m_statement;
+        ECN::ECClassCR m_ecClass;
+        ECN::ClassLayoutCR m_classLayout;
+        int m_ecInstanceIdColumnIndex = -1;
+        bvector<PropertySlot> m_slots;
+
+        ECSqlRowECInstance(ECInstanceECSqlSelectAdapter const&, ECSqlStatement const&, ECN::ECClassCR);
+
+        void MapProperty(ECN::ECPropertyCR, Utf8StringCR accessString, int columnIndex, bvector<Utf8CP> const& memberPath);
+        IECSqlValue const* GetSqlValue(uint32_t propertyIndex) const;
+
+        Utf8String _GetInstanceId() const override;
+        ECN::ECObjectsStatus _GetValue(ECN::ECValueR, uint32_t propertyIndex, bool useArrayIndex, uint32_t arrayIndex) const override;
+        ECN::ECObjectsStatus _SetValue(uint32_t propertyIndex, ECN::ECValueCR, bool useArrayIndex, uint32_t arrayIndex) override { return ECN::ECObjectsStatus::UnableToSetReadOnlyInstance; }
+        ECN::ECObjectsStatus _InsertArrayElements(uint32_t propertyIndex, uint32_t index, uint32_t size) override { return ECN::ECObjectsStatus::UnableToSetReadOnlyInstance; }
+        ECN::ECObjectsStatus _AddArrayElements(uint32_t propertyIndex, uint32_t size) override { return ECN::ECObjectsStatus::UnableToSetReadOnlyInstance; }
+        ECN::ECObjectsStatus _RemoveArrayElement(uint32_t propertyIndex, uint32_t index) override { return ECN::ECObjectsStatus::UnableToSetReadOnlyInstance; }
+        ECN::ECObjectsStatus _ClearArray(uint32_t propertyIndex) override { return ECN::ECObjectsStatus::UnableToSetReadOnlyInstance; }
+        ECN::ECObjectsStatus _SetInstanceId(Utf8CP) override { return ECN::ECObjectsStatus::UnableToSetReadOnlyInstance; }
+        ECN::ECEnablerCR _GetEnabler() const override { return *m_ecClass.GetDefaultStandaloneEnabler(); }
+        bool _IsReadOnly() const override { return true; }
+        Utf8String _ToString(Utf8CP indent) const override { return ""; }
+        size_t _GetOffsetToIECInstance() const override { return 0; }
+
+    public:
+        static RefCountedPtr<ECSqlRowECInstance> Create(ECInstanceECSqlSelectAdapter const& adapter, ECSqlStatement const& statement, ECN::ECClassCR ecClass) { return new ECSqlRowECInstance(adapter, statement, ecClass); }
+
+        //! Maps the property of the specified ECSQL column to the ClassLayout property indices of this view,
+        //! if the property belongs to the view's ECClass
+        void MapColumn(int columnIndex);
+        //! Makes the view read its ECInstanceId from the specified ECSQL column
+        void SetECInstanceIdColumn(int columnIndex) { m_ecInstanceIdColumnIndex = columnIndex; }
+    };
+
+END_BENTLEY_SQLITE_EC_NAMESPACE
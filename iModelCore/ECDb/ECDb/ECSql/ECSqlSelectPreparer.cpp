@@ -272,7 +272,9 @@ ECSqlStatus ECSqlSelectPreparer::PrepareDerivedPropertyExp(NativeSqlBuilder::Lis
             return status;
         }
 
+    //the parse tree may be prepared more than once when it is reused from the ECSqlParseTreeCache
     std::vector<Utf8String> & resultSet = const_cast<DerivedPropertyExp&>(exp).SqlResultSetR();
+    resultSet.clear();
     Utf8String alias = exp.GetColumnAlias();
     if (alias.empty() || exp.FindParent(Exp::Type::Subquery) != nullptr)
         alias = exp.GetNestedAlias();
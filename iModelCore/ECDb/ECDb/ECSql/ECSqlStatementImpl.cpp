@@ -62,15 +62,41 @@ ECSqlStatus ECSqlStatement::Impl::Prepare(ECDbCR ecdb, Db const* dataSourceECDb,
 #ifndef NDEBUG
     Diagnostics diag(ecsql, GetPrepareDiagnosticsLogger(), true);
 #endif
-    //Step 1: parse the ECSQL
-    ECSqlParser parser;
-    std::unique_ptr<Exp> exp = parser.Parse(ecdb, ecsql, filteredScope.Source());
-    if (exp == nullptr)
+    //if the SELECT was translated against this ECDb before - on any data source connection - skip parsing and translating
+    //and only prepare the native SQL. If dataSourceECDb is nullptr, the primary ECDb is used
+    Db const& dataSource = dataSourceECDb != nullptr ? *dataSourceECDb : ecdb;
+    if (ECSqlTranslationCache::EntryPtr translation = ECSqlTranslationCache::Get().Find(ecdb, ecsql))
         {
-        Finalize();
-        return ECSqlStatus::InvalidECSql;
+        std::unique_ptr<ECSqlSelectPreparedStatement> translatedStatement = translation->GetPrototype().CloneTranslation();
+        ECSqlStatus stat = translatedStatement->PrepareNativeSql(dataSource, translation->GetNativeSql().c_str(), filteredScope.Source());
+        if (!stat.IsSuccess())
+            return stat;
+
+        m_preparedStatement = std::move(translatedStatement);
+        return stat;
+        }
+
+    //Step 1: parse the ECSQL unless another statement has already parsed the same ECSQL against this ECDb.
+    //Preparing memoizes native SQL snippets in the parse tree, so the tree is checked out for exclusive use;
+    //if another statement is preparing from the cached tree right now, this one parses its own.
+    ECSqlParseTreeCache& parseTreeCache = ecdb.GetImpl().GetECSqlParseTreeCache();
+    ECSqlParseTreeCache::Lease parseTree = parseTreeCache.CheckOut(ecsql);
+    if (!parseTree.IsValid())
+        {
+        const uint32_t clearCacheCount = ecdb.GetImpl().GetClearCacheCounter().GetValue();
+        ECSqlParser parser;
+        std::unique_ptr<Exp> parsedExp = parser.Parse(ecdb, ecsql, filteredScope.Source());
+        if (parsedExp == nullptr)
+            {
+            Finalize();
+            return ECSqlStatus::InvalidECSql;
+            }
+
+        parseTree = ECSqlParseTreeCache::Lease(std::make_shared<ECSqlParseTreeCache::Entry>(ecsql, clearCacheCount, std::move(parsedExp)));
         }
 
+    Exp const* exp = &parseTree.GetExp();
+
     //Step 2: translate into SQLite SQL and prepare SQLite statement
     IECSqlPreparedStatement& preparedStatement = CreatePreparedStatement(ecdb, *exp);
 
@@ -82,11 +108,20 @@ ECSqlStatus ECSqlStatement::Impl::Prepare(ECDbCR ecdb, Db const* dataSourceECDb,
         return ECSqlStatus::Error;
         }
 
-    //if dataSourceECDb is nullptr, the primary ECDb is used
-    ECSqlPrepareContext ctx(preparedStatement, dataSourceECDb != nullptr ? *dataSourceECDb : ecdb, filteredScope.Source());
+    ECSqlPrepareContext ctx(preparedStatement, dataSource, filteredScope.Source());
     ECSqlStatus stat = preparedStatement.Prepare(ctx, *exp, ecsql);
     if (!stat.IsSuccess())
+        {
         Finalize();
+        return stat;
+        }
+
+    //PRAGMA statements are cheap to parse, so their trees are not kept
+    if (exp->GetType() != Exp::Type::Pragma)
+        parseTreeCache.Add(parseTree.GetEntry());
+
+    if (preparedStatement.GetType() == ECSqlType::Select)
+        ECSqlTranslationCache::Get().Add(static_cast<ECSqlSelectPreparedStatement const&>(preparedStatement));
 
     return stat;
     }
@@ -25,6 +25,8 @@ private:
         return GetSqliteStatement().GetParameterIndex(GetMappedSqlParameterNames()[0].c_str());
         }
 
+    std::unique_ptr<ECSqlBinder> _Clone(SingleECSqlPreparedStatement& preparedStatement) const override { return std::make_unique<IdECSqlBinder>(preparedStatement, *this); }
+
 public:
     ECSqlStatus _BindNull() override;
     ECSqlStatus _BindBoolean(bool value) override;
@@ -47,6 +49,7 @@ public:
 
     public:
         IdECSqlBinder(ECSqlPrepareContext&, ECSqlTypeInfo const&, bool isNoop, SqlParamNameGenerator&);
+        IdECSqlBinder(SingleECSqlPreparedStatement& preparedStatement, IdECSqlBinder const& prototype) : ECSqlBinder(preparedStatement, prototype), m_isNoop(prototype.m_isNoop) {}
         ~IdECSqlBinder() { OnClearBindings(); }
     };
 
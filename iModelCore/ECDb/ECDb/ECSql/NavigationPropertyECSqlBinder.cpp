@@ -16,6 +16,18 @@ NavigationPropertyECSqlBinder::NavigationPropertyECSqlBinder(ECSqlPrepareContext
     Initialize(ctx, paramNameGen);
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+NavigationPropertyECSqlBinder::NavigationPropertyECSqlBinder(SingleECSqlPreparedStatement& preparedStatement, NavigationPropertyECSqlBinder const& prototype)
+    : ECSqlBinder(preparedStatement, prototype)
+    {
+    //the mapped sql parameter names of the member binders were already copied from the prototype
+    BeAssert(prototype.m_idBinder != nullptr && prototype.m_relECClassIdBinder != nullptr);
+    m_idBinder = std::make_unique<IdECSqlBinder>(preparedStatement, *prototype.m_idBinder);
+    m_relECClassIdBinder = std::make_unique<IdECSqlBinder>(preparedStatement, *prototype.m_relECClassIdBinder);
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -20,8 +20,11 @@ struct NavigationPropertyECSqlBinder final : public ECSqlBinder
         std::unique_ptr<IdECSqlBinder> m_relECClassIdBinder = nullptr;
 
         NavigationPropertyECSqlBinder(ECSqlPrepareContext&, ECSqlTypeInfo const&, SqlParamNameGenerator&);
+        NavigationPropertyECSqlBinder(SingleECSqlPreparedStatement&, NavigationPropertyECSqlBinder const& prototype);
         BentleyStatus Initialize(ECSqlPrepareContext&, SqlParamNameGenerator&);
 
+        std::unique_ptr<ECSqlBinder> _Clone(SingleECSqlPreparedStatement& preparedStatement) const override { return std::unique_ptr<ECSqlBinder>(new NavigationPropertyECSqlBinder(preparedStatement, *this)); }
+
         ECSqlStatus _BindNull() override;
         ECSqlStatus _BindBoolean(bool value) override;
         ECSqlStatus _BindBlob(const void* value, int binarySize, IECSqlBinder::MakeCopy) override;
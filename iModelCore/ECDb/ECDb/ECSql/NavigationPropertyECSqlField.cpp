@@ -18,6 +18,17 @@ void NavigationPropertyECSqlField::SetMembers(std::unique_ptr<ECSqlField> idFiel
     BeAssert(m_idField != nullptr && m_relClassIdField != nullptr);
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::unique_ptr<ECSqlField> NavigationPropertyECSqlField::_Clone(ECSqlSelectPreparedStatement& stmt) const
+    {
+    BeAssert(m_idField != nullptr && m_relClassIdField != nullptr);
+    std::unique_ptr<NavigationPropertyECSqlField> clone = std::make_unique<NavigationPropertyECSqlField>(stmt, m_ecsqlColumnInfo);
+    clone->SetMembers(m_idField->Clone(stmt), m_relClassIdField->Clone(stmt));
+    return clone;
+    }
+
 
 //---------------------------------------------------------------------------------------
 // @bsimethod
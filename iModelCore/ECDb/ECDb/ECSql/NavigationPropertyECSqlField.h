@@ -66,6 +66,7 @@ struct NavigationPropertyECSqlField final : public ECSqlField, IECSqlValueIterab
         //ECSqlField
         ECSqlStatus _OnAfterReset() override;
         ECSqlStatus _OnAfterStep() override;
+        std::unique_ptr<ECSqlField> _Clone(ECSqlSelectPreparedStatement&) const override;
 
     public:
         NavigationPropertyECSqlField(ECSqlSelectPreparedStatement& stmt, ECSqlColumnInfo const& colInfo) : ECSqlField(stmt, colInfo, false, false) {}
@@ -41,6 +41,8 @@ struct PointECSqlBinder final : public ECSqlBinder
 
         IECSqlBinder& _AddArrayElement() override;
 
+        std::unique_ptr<ECSqlBinder> _Clone(SingleECSqlPreparedStatement& preparedStatement) const override { return std::make_unique<PointECSqlBinder>(preparedStatement, *this); }
+
         int GetCoordSqlParamIndex(Coordinate coord) const
             {
             BeAssert(GetMappedSqlParameterNames().size() == (m_isPoint3d ? 3 : 2));
@@ -56,6 +58,8 @@ struct PointECSqlBinder final : public ECSqlBinder
             : ECSqlBinder(ctx, typeInfo, paramNameGen, isPoint3d ? 3 : 2, false, false), m_isPoint3d(isPoint3d)
             {}
 
+        PointECSqlBinder(SingleECSqlPreparedStatement& preparedStatement, PointECSqlBinder const& prototype) : ECSqlBinder(preparedStatement, prototype), m_isPoint3d(prototype.m_isPoint3d) {}
+
         ~PointECSqlBinder() {}
     };
 
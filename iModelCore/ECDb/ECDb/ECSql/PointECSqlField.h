@@ -37,6 +37,8 @@ private:
     int _GetArrayLength() const override;
     IECSqlValueIterable const& _GetArrayIterable() const override;
 
+    std::unique_ptr<ECSqlField> _Clone(ECSqlSelectPreparedStatement& stmt) const override { return std::make_unique<PointECSqlField>(stmt, m_ecsqlColumnInfo, m_xColumnIndex, m_yColumnIndex, m_zColumnIndex); }
+
     bool IsPoint3d() const { return m_zColumnIndex >= 0; }
 
 public:
@@ -35,6 +35,8 @@ private:
 
     IECSqlBinder& _AddArrayElement() override;
 
+    std::unique_ptr<ECSqlBinder> _Clone(SingleECSqlPreparedStatement& preparedStatement) const override { return std::make_unique<PrimitiveECSqlBinder>(preparedStatement, *this); }
+
     int GetSqlParameterIndex() const 
         { 
         BeAssert(GetMappedSqlParameterNames().size() == 1); 
@@ -44,6 +46,7 @@ private:
 
 public:
     PrimitiveECSqlBinder(ECSqlPrepareContext& ctx, ECSqlTypeInfo const& typeInfo, SqlParamNameGenerator& paramNameGen) : ECSqlBinder(ctx, typeInfo, paramNameGen, 1, false, false) {}
+    PrimitiveECSqlBinder(SingleECSqlPreparedStatement& preparedStatement, PrimitiveECSqlBinder const& prototype) : ECSqlBinder(preparedStatement, prototype) {}
     ~PrimitiveECSqlBinder() { OnClearBindings(); }
     };
 
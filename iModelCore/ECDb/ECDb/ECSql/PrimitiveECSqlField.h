@@ -35,6 +35,8 @@ private:
     int _GetArrayLength() const override;
     IECSqlValueIterable const& _GetArrayIterable() const override;
 
+    std::unique_ptr<ECSqlField> _Clone(ECSqlSelectPreparedStatement& stmt) const override { return std::make_unique<PrimitiveECSqlField>(stmt, m_ecsqlColumnInfo, m_sqliteColumnIndex); }
+
 public:
     PrimitiveECSqlField(ECSqlSelectPreparedStatement&, ECSqlColumnInfo const&, int ecsqlColumnIndex);
     ~PrimitiveECSqlField() {}
@@ -15,6 +15,19 @@ StructECSqlBinder::StructECSqlBinder(ECSqlPrepareContext& ctx, ECSqlTypeInfo con
     Initialize(ctx, paramNameGen);
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+StructECSqlBinder::StructECSqlBinder(SingleECSqlPreparedStatement& preparedStatement, StructECSqlBinder const& prototype)
+    : ECSqlBinder(preparedStatement, prototype)
+    {
+    //the mapped sql parameter names of the member binders were already copied from the prototype
+    for (auto const& kvPair : prototype.m_memberBinders)
+        {
+        m_memberBinders[kvPair.first] = kvPair.second->Clone(preparedStatement);
+        }
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
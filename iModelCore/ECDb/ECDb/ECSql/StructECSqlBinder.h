@@ -17,10 +17,12 @@ struct StructECSqlBinder final : public ECSqlBinder
         std::map<ECN::ECPropertyId, std::unique_ptr<ECSqlBinder>> m_memberBinders;
 
         StructECSqlBinder(ECSqlPrepareContext&, ECSqlTypeInfo const&, SqlParamNameGenerator&);
+        StructECSqlBinder(SingleECSqlPreparedStatement&, StructECSqlBinder const& prototype);
         BentleyStatus Initialize(ECSqlPrepareContext&, SqlParamNameGenerator&);
 
         void _OnClearBindings() override;
         ECSqlStatus _OnBeforeStep() override;
+        std::unique_ptr<ECSqlBinder> _Clone(SingleECSqlPreparedStatement& preparedStatement) const override { return std::unique_ptr<ECSqlBinder>(new StructECSqlBinder(preparedStatement, *this)); }
 
         ECSqlStatus _BindNull() override;
         ECSqlStatus _BindBoolean(bool value) override;
@@ -57,6 +57,20 @@ void StructECSqlField::AppendField(std::unique_ptr<ECSqlField> field)
     m_structMemberFields[memberName] = std::move(field);
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+std::unique_ptr<ECSqlField> StructECSqlField::_Clone(ECSqlSelectPreparedStatement& stmt) const
+    {
+    std::unique_ptr<StructECSqlField> clone = std::make_unique<StructECSqlField>(stmt, m_ecsqlColumnInfo);
+    for (auto const& kvPair : m_structMemberFields)
+        {
+        clone->AppendField(kvPair.second->Clone(stmt));
+        }
+
+    return clone;
+    }
+
 //-----------------------------------------------------------------------------------------
 // @bsimethod
 //+---------------+---------------+---------------+---------------+---------------+--------
@@ -61,6 +61,7 @@ struct StructECSqlField final : public ECSqlField, IECSqlValueIterable
         //ECSqlField
         ECSqlStatus _OnAfterReset() override;
         ECSqlStatus _OnAfterStep() override;
+        std::unique_ptr<ECSqlField> _Clone(ECSqlSelectPreparedStatement&) const override;
     public:
         StructECSqlField(ECSqlSelectPreparedStatement& stmt, ECSqlColumnInfo const& colInfo) : ECSqlField(stmt, colInfo, false, false) {}
         //Before calling this, the child field must be complete. You must not add child fields to the child fields afterwards
@@ -24,6 +24,8 @@ struct VirtualSetBinder final : public ECSqlBinder
             BeAssert(!GetMappedSqlParameterNames()[0].empty());
             return GetSqliteStatement().GetParameterIndex(GetMappedSqlParameterNames()[0].c_str());
             }
+
+        std::unique_ptr<ECSqlBinder> _Clone(SingleECSqlPreparedStatement& preparedStatement) const override { return std::make_unique<VirtualSetBinder>(preparedStatement, *this); }
     public:
         ECSqlStatus _BindNull() override;
         ECSqlStatus _BindBoolean(bool value) override;
@@ -46,6 +48,7 @@ struct VirtualSetBinder final : public ECSqlBinder
 
     public:
         VirtualSetBinder(ECSqlPrepareContext&, ECSqlTypeInfo const&, SqlParamNameGenerator&);
+        VirtualSetBinder(SingleECSqlPreparedStatement& preparedStatement, VirtualSetBinder const& prototype) : ECSqlBinder(preparedStatement, prototype) {}
         ~VirtualSetBinder() { OnClearBindings(); };
     };
 
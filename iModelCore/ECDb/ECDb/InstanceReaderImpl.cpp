@@ -36,6 +36,9 @@ struct ClassIdECSqlField : ECSqlField {
         virtual int64_t _GetInt64() const override {
             return static_cast<int64_t>(m_classId.GetValueUnchecked());
         }
+        virtual std::unique_ptr<ECSqlField> _Clone(ECSqlSelectPreparedStatement& ecsqlStatement) const override {
+            return std::make_unique<ClassIdECSqlField>(ecsqlStatement, m_ecsqlColumnInfo, m_classId);
+        }
 
     public:
         ClassIdECSqlField(ECSqlSelectPreparedStatement& ecsqlStatement, ECSqlColumnInfo const& ecsqlColumnInfo, ECN::ECClassId classId)
@@ -0,0 +1,259 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#include "ECDbPch.h"
+
+BEGIN_BENTLEY_SQLITE_EC_NAMESPACE
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryColumnarResult::Column::AppendRow(bool hasValue) {
+    const auto byteIndex = m_rowCount >> 3;
+    if (byteIndex >= m_validity.size())
+        m_validity.push_back(0);
+
+    if (hasValue)
+        m_validity[byteIndex] |= (uint8_t)(1 << (m_rowCount & 7));
+
+    ++m_rowCount;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryColumnarResult::Column::AppendNull() {
+    if (IsVariableLength()) {
+        m_offsets.push_back((uint32_t)m_values.size());
+    } else {
+        const auto width = m_type == ColumnType::Boolean ? sizeof(uint8_t) : sizeof(uint64_t);
+        m_values.resize(m_values.size() + width, 0);
+    }
+    AppendRow(false);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryColumnarResult::Column::AppendBytes(void const* data, uint32_t size) {
+    BeAssert(IsVariableLength());
+    if (size > 0) {
+        auto const pos = m_values.size();
+        m_values.resize(pos + size);
+        memcpy(&m_values[pos], data, size);
+    }
+    m_offsets.push_back((uint32_t)m_values.size());
+    AppendRow(true);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+uint8_t const* QueryColumnarResult::Column::GetBytes(uint32_t row, uint32_t& size) const {
+    BeAssert(IsVariableLength());
+    size = m_offsets[row + 1] - m_offsets[row];
+    return size == 0 ? nullptr : &m_values[m_offsets[row]];
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+size_t QueryColumnarResult::GetByteSize() const {
+    size_t size = 0;
+    for (auto& column : m_columns)
+        size += column.GetByteSize();
+
+    return size;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryColumnarResult::ToJs(BeJsValue& val, bool includeData) const {
+    val.toObject();
+    val[JRowCount] = m_rowCount;
+    auto columns = val[JColumns];
+    columns.toArray();
+    for (auto& column : m_columns) {
+        auto jsColumn = columns.appendObject();
+        jsColumn[JType] = (int)column.GetType();
+        if (!includeData)
+            continue;
+
+        jsColumn[JValues].SetBinary(column.GetValues());
+        jsColumn[JValidity].SetBinary(column.GetValidity());
+        if (column.IsVariableLength())
+            jsColumn[JOffsets].SetBinary((Byte const*)column.GetOffsets().data(), column.GetOffsets().size() * sizeof(uint32_t));
+    }
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+QueryColumnarAdaptor::ColumnType QueryColumnarAdaptor::GetColumnType(ECSqlColumnInfo const& col, bool classIdToClassNames) {
+    auto prop = col.GetProperty();
+    if (prop == nullptr || !prop->GetIsPrimitive())
+        return ColumnType::Json;
+
+    auto primProp = prop->GetAsPrimitiveProperty();
+    switch (primProp->GetType()) {
+        case ECN::PRIMITIVETYPE_Long: {
+            const auto extendTypeId = ExtendedTypeHelper::GetExtendedType(primProp->GetExtendedTypeName());
+            if (classIdToClassNames && Enum::Intersects<ExtendedTypeHelper::ExtendedType>(extendTypeId, ExtendedTypeHelper::ExtendedType::ClassIds))
+                return ColumnType::String;
+            if (Enum::Intersects<ExtendedTypeHelper::ExtendedType>(extendTypeId, ExtendedTypeHelper::ExtendedType::All))
+                return ColumnType::Id;
+            return ColumnType::Int64;
+        }
+        case ECN::PRIMITIVETYPE_Integer:
+            return ColumnType::Int64;
+        case ECN::PRIMITIVETYPE_Double:
+            return ColumnType::Double;
+        case ECN::PRIMITIVETYPE_Boolean:
+            return ColumnType::Boolean;
+        case ECN::PRIMITIVETYPE_String:
+        case ECN::PRIMITIVETYPE_DateTime:
+            return ColumnType::String;
+        case ECN::PRIMITIVETYPE_Binary:
+            // guid is rendered as a string to match json output.
+            if (primProp->GetExtendedTypeName().EqualsIAscii("BeGuid"))
+                return ColumnType::String;
+            return ColumnType::Blob;
+        default:
+            break;
+    }
+    return ColumnType::Json;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+void QueryColumnarAdaptor::Prepare(QueryColumnarResult& result, ECSqlStatement const& stmt) {
+    const int count = stmt.GetColumnCount();
+    for (int columnIndex = 0; columnIndex < count; columnIndex++)
+        result.AddColumn(GetColumnType(stmt.GetColumnInfo(columnIndex), m_classIdToClassNames));
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+BentleyStatus QueryColumnarAdaptor::AppendRow(QueryColumnarResult& result, IECSqlRow const& row) {
+    const int count = row.GetColumnCount();
+    if (count != (int)result.GetColumns().size()) {
+        BeAssert(false && "column count does not match prepared result");
+        return ERROR;
+    }
+    for (int columnIndex = 0; columnIndex < count; columnIndex++) {
+        auto& column = result.GetColumnR(columnIndex);
+        IECSqlValue const& ecsqlValue = row.GetValue(columnIndex);
+        if (ecsqlValue.IsNull()) {
+            column.AppendNull();
+            continue;
+        }
+        if (SUCCESS != AppendValue(column, ecsqlValue))
+            return ERROR;
+    }
+    result.AddRow();
+    return SUCCESS;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+BentleyStatus QueryColumnarAdaptor::AppendValue(QueryColumnarResult::Column& column, IECSqlValue const& in) {
+    switch (column.GetType()) {
+        case ColumnType::Boolean:
+            column.AppendBoolean(in.GetBoolean());
+            return SUCCESS;
+        case ColumnType::Int64:
+            column.AppendInt64(in.GetInt64());
+            return SUCCESS;
+        case ColumnType::Double:
+            column.AppendDouble(in.GetDouble());
+            return SUCCESS;
+        case ColumnType::Id: {
+            const auto id = in.GetId<BeInt64Id>();
+            if (id.IsValid())
+                column.AppendId(id.GetValue());
+            else
+                column.AppendNull();
+            return SUCCESS;
+        }
+        case ColumnType::String: {
+            auto prop = in.GetColumnInfo().GetProperty()->GetAsPrimitiveProperty();
+            if (prop->GetType() == ECN::PRIMITIVETYPE_Long) {
+                // a class id, the json adaptor renders it as the class name.
+                return AppendJsonString(column, in);
+            } else if (prop->GetType() == ECN::PRIMITIVETYPE_DateTime) {
+                const auto str = in.GetDateTime().ToString();
+                column.AppendBytes(str.c_str(), (uint32_t)str.size());
+            } else if (prop->GetType() == ECN::PRIMITIVETYPE_Binary) {
+                int size = 0;
+                auto data = in.GetBlob(&size);
+                if (size != sizeof(BeGuid)) {
+                    column.AppendNull();
+                    return SUCCESS;
+                }
+                BeGuid guid;
+                std::memcpy(&guid, data, sizeof(guid));
+                const auto str = guid.ToString();
+                column.AppendBytes(str.c_str(), (uint32_t)str.size());
+            } else {
+                Utf8CP str = in.GetText();
+                column.AppendBytes(str, (uint32_t)strlen(str));
+            }
+            return SUCCESS;
+        }
+        case ColumnType::Blob: {
+            int size = 0;
+            auto data = in.GetBlob(&size);
+            if (m_abbreviateBlobs && size > 1)
+                size = 1;
+            column.AppendBytes(data, (uint32_t)size);
+            return SUCCESS;
+        }
+        case ColumnType::Json:
+            return AppendJson(column, in);
+    }
+    BeAssert(false && "column type unsupported");
+    return ERROR;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+BentleyStatus QueryColumnarAdaptor::AppendJson(QueryColumnarResult::Column& column, IECSqlValue const& in) {
+    BeJsDocument doc;
+    BeJsValue val(doc);
+    if (SUCCESS != m_jsonAdaptor.RenderValue(val, in))
+        return ERROR;
+
+    if (val.isNull()) {
+        column.AppendNull();
+        return SUCCESS;
+    }
+    const auto json = val.Stringify();
+    column.AppendBytes(json.c_str(), (uint32_t)json.size());
+    return SUCCESS;
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+BentleyStatus QueryColumnarAdaptor::AppendJsonString(QueryColumnarResult::Column& column, IECSqlValue const& in) {
+    BeJsDocument doc;
+    BeJsValue val(doc);
+    if (SUCCESS != m_jsonAdaptor.RenderValue(val, in))
+        return ERROR;
+
+    if (!val.isString()) {
+        column.AppendNull();
+        return SUCCESS;
+    }
+    const auto str = val.asString();
+    column.AppendBytes(str.c_str(), (uint32_t)str.size());
+    return SUCCESS;
+}
+
+END_BENTLEY_SQLITE_EC_NAMESPACE
@@ -0,0 +1,40 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#pragma once
+#include <ECDb/ECSqlStatement.h>
+#include <ECDb/ConcurrentQueryManager.h>
+#include "QueryJsonAdaptor.h"
+
+BEGIN_BENTLEY_SQLITE_EC_NAMESPACE
+
+//=======================================================================================
+//! Encode ECSqlStatement rows directly into typed column buffers. Values that have no
+//! natural columnar representation (points, navigation, struct, array and geometry) are
+//! rendered as json text using the QueryJsonAdaptor.
+//! @bsiclass
+//=======================================================================================
+struct QueryColumnarAdaptor {
+    using ColumnType = QueryColumnarResult::ColumnType;
+private:
+    QueryJsonAdaptor& m_jsonAdaptor;
+    bool m_abbreviateBlobs;
+    bool m_classIdToClassNames;
+
+private:
+    BentleyStatus AppendValue(QueryColumnarResult::Column& column, IECSqlValue const& in);
+    BentleyStatus AppendJson(QueryColumnarResult::Column& column, IECSqlValue const& in);
+    BentleyStatus AppendJsonString(QueryColumnarResult::Column& column, IECSqlValue const& in);
+
+public:
+    explicit QueryColumnarAdaptor(QueryJsonAdaptor& jsonAdaptor):m_jsonAdaptor(jsonAdaptor), m_abbreviateBlobs(true), m_classIdToClassNames(false){}
+    QueryColumnarAdaptor& SetAbbreviateBlobs(bool v) { m_abbreviateBlobs = v; return *this;}
+    //! class ids are stored as class names in a string column, rendered by the json adaptor.
+    QueryColumnarAdaptor& SetConvertClassIdsToClassNames(bool v) { m_classIdToClassNames = v; return *this; }
+    void Prepare(QueryColumnarResult& result, ECSqlStatement const& stmt);
+    BentleyStatus AppendRow(QueryColumnarResult& result, IECSqlRow const& row);
+    static ColumnType GetColumnType(ECSqlColumnInfo const& col, bool classIdToClassNames = false);
+};
+
+END_BENTLEY_SQLITE_EC_NAMESPACE
@@ -13,6 +13,7 @@ using namespace std::chrono_literals;
 typedef uint32_t TaskId;
 struct ECDb;
 struct ECSqlStatement;
+struct RunnableRequestQueue;
 
 //=======================================================================================
 // @bsiclass
@@ -262,6 +263,10 @@ struct ECSqlRequest : public QueryRequest{
         ECSqlNames = 0,
         JsNames = 1
     };
+    enum class ResultFormat {
+        Json = 0,       // rows serialized as a json array of arrays.
+        Columnar = 1    // rows encoded into typed column buffers (see QueryColumnarResult).
+    };
     private:
         static constexpr auto JQuery = "query";
         static constexpr auto JArgs = "args";
@@ -271,6 +276,10 @@ struct ECSqlRequest : public QueryRequest{
         static constexpr auto JConvertClassIdsToClassNames = "convertClassIdsToClassNames";
         static constexpr auto JLimit = "limit";
         static constexpr auto JValueFormat = "valueFormat";
+        static constexpr auto JResultFormat = "resultFormat";
+        static constexpr auto JUseCursor = "useCursor";
+        static constexpr auto JContinuationToken = "continuationToken";
+        static constexpr auto JUsePartitions = "usePartitions";
         std::string m_query;
         ECSqlParams m_args;
         QueryLimit m_limit;
@@ -279,9 +288,13 @@ struct ECSqlRequest : public QueryRequest{
         bool m_includeMetaData;
         bool m_convertClassIdsToClassNames;
         ECSqlValueFormat m_valueFmt;
+        ResultFormat m_resultFmt;
+        bool m_useCursor;
+        std::string m_continuationToken;
+        bool m_usePartitions;
     public:
         ECSqlRequest(std::string const& query, ECSqlParams&& args)
-            :QueryRequest(Kind::ECSql), m_query(query), m_args(std::move(args)),m_abbreviateBlobs(false), m_suppressLogErrors(false),m_includeMetaData(true), m_convertClassIdsToClassNames(false),m_valueFmt(ECSqlValueFormat::ECSqlNames){}
+            :QueryRequest(Kind::ECSql), m_query(query), m_args(std::move(args)),m_abbreviateBlobs(false), m_suppressLogErrors(false),m_includeMetaData(true), m_convertClassIdsToClassNames(false),m_valueFmt(ECSqlValueFormat::ECSqlNames),m_resultFmt(ResultFormat::Json),m_useCursor(false),m_usePartitions(false){}
         virtual ~ECSqlRequest(){}
         std::string const& GetQuery() const { return m_query; }
         ECSqlParams const& GetArgs() const { return  m_args; }
@@ -292,7 +305,29 @@ struct ECSqlRequest : public QueryRequest{
         bool GetConvertClassIdsToClassNames() const {return m_convertClassIdsToClassNames; }
         QueryLimit const& GetLimit() const {return m_limit;}
         ECSqlValueFormat GetValueFormat() const { return m_valueFmt; }
+        ResultFormat GetResultFormat() const { return m_resultFmt; }
+        //! When set, a partial page leaves a cursor open on the worker connection and the response carries a
+        //! continuation token. Limit count is then the page size. Cursors are not supported on the primary connection.
+        //! A select over a single class without ORDER BY, DISTINCT, GROUP BY, LIMIT or aggregates that returns the
+        //! ECInstanceId of the class is paged by key: rows come in ECInstanceId order, the statement is reset after each
+        //! page and the next page starts after the last ECInstanceId returned, so each page reads its own snapshot.
+        //! Any other query keeps its statement stepped between pages, which holds a read transaction on the worker
+        //! connection until the cursor is exhausted or closed after Config::GetCursorIdleTimeout(). In rollback journal
+        //! mode that blocks writers, in WAL mode it keeps checkpoints from completing.
+        bool GetUseCursor() const { return m_useCursor; }
+        //! Token returned by a previous partial response. The next page is read from the open cursor instead of re-executing the query.
+        //! The cursor keeps the args bound by the request that opened it, a continuation passing other args fails.
+        std::string const& GetContinuationToken() const { return m_continuationToken; }
+        //! When set, a polymorphic select over a class stored in several tables is split into one query per table and the
+        //! tables are read concurrently on separate worker connections. Limit and offset apply to the merged rows.
+        //! Queries that cannot be split run as usual. In WAL mode every connection could read a different commit, so the
+        //! tables are then read one after another on the request's connection and the split does not add concurrency.
+        bool GetUsePartitions() const { return m_usePartitions; }
         ECSqlRequest& SetValueFmt(ECSqlValueFormat fmt) noexcept { m_valueFmt = fmt; return *this;}
+        ECSqlRequest& SetResultFormat(ResultFormat fmt) noexcept { m_resultFmt = fmt; return *this;}
+        ECSqlRequest& SetUseCursor(bool useCursor) noexcept { m_useCursor = useCursor; return *this;}
+        ECSqlRequest& SetContinuationToken(std::string const& token) { m_continuationToken = token; return *this;}
+        ECSqlRequest& SetUsePartitions(bool usePartitions) noexcept { m_usePartitions = usePartitions; return *this;}
         ECSqlRequest& SetLimit(QueryLimit limit) noexcept { m_limit = limit; return *this;}
         ECSqlRequest& SetAbbreviateBlobs(bool abbreviateBlobs) { m_abbreviateBlobs = abbreviateBlobs; return *this;}
         ECSqlRequest& SetSuppressLogErrors(bool suppressLogErrors) { m_suppressLogErrors = suppressLogErrors; return *this;}
@@ -468,6 +503,89 @@ struct QueryProperty final: IJsSerializable {
         ECDB_EXPORT void ToJs(BeJsValue& val) const override;
 };
 
+//=======================================================================================
+//! Column oriented encoding of ECSql rows. Every column owns a buffer of values, a
+//! validity bitmap (bit i is set when row i has a value, least significant bit first)
+//! and, for variable length types, a buffer of rowCount + 1 byte offsets into the values.
+//! Fixed width values are stored in native byte order and null rows are zero filled.
+// @bsiclass
+//=======================================================================================
+struct QueryColumnarResult final {
+    static constexpr auto JRowCount = "rowCount";
+    static constexpr auto JColumns = "columns";
+    static constexpr auto JType = "type";
+    static constexpr auto JValues = "values";
+    static constexpr auto JOffsets = "offsets";
+    static constexpr auto JValidity = "validity";
+    enum class ColumnType : uint8_t {
+        Boolean = 0,    // 1 byte per row
+        Int64 = 1,      // 8 bytes per row
+        Double = 2,     // 8 bytes per row
+        Id = 3,         // 8 bytes per row, unsigned
+        String = 4,     // utf-8 text addressed by offsets
+        Blob = 5,       // raw bytes addressed by offsets
+        Json = 6,       // value rendered as json text addressed by offsets
+    };
+    struct Column final {
+        private:
+            ColumnType m_type;
+            uint32_t m_rowCount;
+            std::vector<uint8_t> m_values;
+            std::vector<uint32_t> m_offsets;
+            std::vector<uint8_t> m_validity;
+            void AppendRow(bool hasValue);
+            template<typename T> void AppendFixed(T val) {
+                auto const pos = m_values.size();
+                m_values.resize(pos + sizeof(T));
+                memcpy(&m_values[pos], &val, sizeof(T));
+                AppendRow(true);
+            }
+            template<typename T> T GetFixed(uint32_t row) const {
+                T val;
+                memcpy(&val, &m_values[row * sizeof(T)], sizeof(T));
+                return val;
+            }
+        public:
+            explicit Column(ColumnType type):m_type(type), m_rowCount(0) { if (IsVariableLength()) m_offsets.push_back(0); }
+            ColumnType GetType() const { return m_type; }
+            bool IsVariableLength() const { return m_type == ColumnType::String || m_type == ColumnType::Blob || m_type == ColumnType::Json; }
+            uint32_t GetRowCount() const { return m_rowCount; }
+            std::vector<uint8_t> const& GetValues() const { return m_values; }
+            std::vector<uint32_t> const& GetOffsets() const { return m_offsets; }
+            std::vector<uint8_t> const& GetValidity() const { return m_validity; }
+            size_t GetByteSize() const { return m_values.size() + m_offsets.size() * sizeof(uint32_t) + m_validity.size(); }
+            bool IsNull(uint32_t row) const { return row >= m_rowCount || (m_validity[row >> 3] & (1 << (row & 7))) == 0; }
+            ECDB_EXPORT void AppendNull();
+            void AppendBoolean(bool val) { BeAssert(m_type == ColumnType::Boolean); AppendFixed<uint8_t>(val ? 1 : 0); }
+            void AppendInt64(int64_t val) { BeAssert(m_type == ColumnType::Int64); AppendFixed<int64_t>(val); }
+            void AppendDouble(double val) { BeAssert(m_type == ColumnType::Double); AppendFixed<double>(val); }
+            void AppendId(uint64_t val) { BeAssert(m_type == ColumnType::Id); AppendFixed<uint64_t>(val); }
+            ECDB_EXPORT void AppendBytes(void const* data, uint32_t size);
+            bool GetBoolean(uint32_t row) const { return GetFixed<uint8_t>(row) != 0; }
+            int64_t GetInt64(uint32_t row) const { return GetFixed<int64_t>(row); }
+            double GetDouble(uint32_t row) const { return GetFixed<double>(row); }
+            uint64_t GetId(uint32_t row) const { return GetFixed<uint64_t>(row); }
+            ECDB_EXPORT uint8_t const* GetBytes(uint32_t row, uint32_t& size) const;
+            std::string GetString(uint32_t row) const { uint32_t size; auto data = GetBytes(row, size); return std::string((char const*)data, size); }
+    };
+    private:
+        std::vector<Column> m_columns;
+        uint32_t m_rowCount;
+    public:
+        QueryColumnarResult():m_rowCount(0){}
+        QueryColumnarResult(QueryColumnarResult&&) = default;
+        QueryColumnarResult& operator = (QueryColumnarResult&&) = default;
+        bool IsEmpty() const { return m_columns.empty(); }
+        uint32_t GetRowCount() const { return m_rowCount; }
+        std::vector<Column> const& GetColumns() const { return m_columns; }
+        Column const& GetColumn(int index) const { return m_columns[index]; }
+        Column& GetColumnR(int index) { return m_columns[index]; }
+        void AddColumn(ColumnType type) { m_columns.emplace_back(type); }
+        void AddRow() { ++m_rowCount; }
+        ECDB_EXPORT size_t GetByteSize() const;
+        ECDB_EXPORT void ToJs(BeJsValue& val, bool includeData) const;
+};
+
 //=======================================================================================
 // @bsiclass
 //=======================================================================================
@@ -477,16 +595,27 @@ struct ECSqlResponse final : public QueryResponse{
     private:
         static constexpr auto JRowCount = "rowCount";
         static constexpr auto JMeta = "meta";
+        static constexpr auto JContinuationToken = "continuationToken";
         std::string m_dataJson;
+        std::string m_continuationToken;
         uint32_t m_rowCount;
         QueryProperty::List m_properties;
+        QueryColumnarResult m_columnar;
+        bool m_isColumnar;
     public:
         ECSqlResponse(Stats stats, Status status, std::string error, std::string & data, QueryProperty::List& meta, uint32_t rowCount)
-            :QueryResponse(Kind::ECSql,stats, status, error), m_dataJson(std::move(data)), m_properties(std::move(meta)),m_rowCount(rowCount) {}
+            :QueryResponse(Kind::ECSql,stats, status, error), m_dataJson(std::move(data)), m_rowCount(rowCount), m_properties(std::move(meta)), m_isColumnar(false) {}
+        // m_rowCount is declared before m_columnar, so the row count is read before data is moved from.
+        ECSqlResponse(Stats stats, Status status, std::string error, QueryColumnarResult& data, QueryProperty::List& meta)
+            :QueryResponse(Kind::ECSql,stats, status, error), m_rowCount(data.GetRowCount()), m_properties(std::move(meta)), m_columnar(std::move(data)), m_isColumnar(true) {}
         virtual ~ECSqlResponse(){}
         QueryProperty::List const& GetProperties() const { return m_properties; }
         std::string const& asJsonString() const {return m_dataJson; }
+        bool IsColumnar() const { return m_isColumnar; }
+        QueryColumnarResult const& GetColumnarResult() const { return m_columnar; }
         uint32_t GetRowCount() const {return m_rowCount;}
+        std::string const& GetContinuationToken() const { return m_continuationToken; }
+        ECSqlResponse& SetContinuationToken(std::string const& token) { m_continuationToken = token; return *this; }
         ECDB_EXPORT void virtual ToJs(BeJsValue& v, bool includeData) const override;
 };
 
@@ -524,12 +653,14 @@ struct ConcurrentQueryMgr final {
          static constexpr auto JIgnorePriority = "ignorePriority";
          static constexpr auto JQuota = "globalQuota";
          static constexpr auto JIgnoreDelay = "ignoreDelay";
+         static constexpr auto JCursorIdleTimeout = "cursorIdleTimeout";
         private:
             QueryQuota m_quota;
             uint32_t m_workerThreadCount;
             uint32_t m_requestQueueSize;
             bool m_ignorePriority;
             bool m_ignoreDelay;
+            std::chrono::seconds m_cursorIdleTimeout;
             static Config From(std::string const& json);
         public:
             ECDB_EXPORT Config();
@@ -540,7 +671,10 @@ struct ConcurrentQueryMgr final {
             uint32_t GetRequestQueueSize() const{ return m_requestQueueSize;}
             bool GetIgnorePriority() const {return m_ignorePriority; }
             bool GetIgnoreDelay() const {return m_ignoreDelay; }
+            //! Time after which a cursor that was not resumed is closed. Applies to cursors opened after it was set.
+            std::chrono::seconds GetCursorIdleTimeout() const { return m_cursorIdleTimeout; }
             Config& SetIgnoreDelay(bool ignoreDelay) { m_ignoreDelay = ignoreDelay; return *this; }
+            Config& SetCursorIdleTimeout(std::chrono::seconds idleTimeout) { m_cursorIdleTimeout = idleTimeout; return *this; }
             Config& SetQuota(QueryQuota const& quota) { m_quota = quota; return *this; }
             Config& SetWorkerThreadCount(uint32_t workerThreadCount) { m_workerThreadCount = workerThreadCount; return *this;}
             Config& SetRequestQueueSize(uint32_t requestQueueSize) { m_requestQueueSize = requestQueueSize; return *this;}
@@ -553,6 +687,66 @@ struct ConcurrentQueryMgr final {
             ECDB_EXPORT void To(BeJsValue) const;
             void Reset() { *this = GetDefault(); }
     };
+    //=======================================================================================
+    //! Snapshot of the request queue. Depths are the requests waiting at the time of the call,
+    //! counters and wait times accumulate from the time the manager was created.
+    // @bsiclass
+    //=======================================================================================
+    struct QueueStats final {
+        friend struct RunnableRequestQueue;
+        //! Requests are bucketed by the sign of QueryRequest::GetPriority().
+        enum class PriorityClass {
+            Low = 0,
+            Normal = 1,
+            High = 2,
+        };
+        static constexpr uint32_t kPriorityClassCount = 3;
+        private:
+            uint32_t m_depth[kPriorityClassCount];
+            std::vector<uint32_t> m_laneDepth;
+            uint64_t m_dequeued;
+            uint64_t m_stolen;
+            uint64_t m_partitioned;
+            std::chrono::microseconds m_totalWaitTime;
+            std::chrono::microseconds m_maxWaitTime;
+        public:
+            QueueStats():m_depth{0, 0, 0}, m_dequeued(0), m_stolen(0), m_partitioned(0), m_totalWaitTime(0), m_maxWaitTime(0){}
+            uint32_t GetDepth() const { return m_depth[0] + m_depth[1] + m_depth[2]; }
+            uint32_t GetDepth(PriorityClass priorityClass) const { return m_depth[(int)priorityClass]; }
+            //! requests waiting in the lane of each executor thread.
+            std::vector<uint32_t> const& GetLaneDepth() const { return m_laneDepth; }
+            uint64_t GetDequeued() const { return m_dequeued; }
+            //! requests an executor took from the lane of another executor.
+            uint64_t GetStolen() const { return m_stolen; }
+            //! requests that were split into partitions, see ECSqlRequest::GetUsePartitions().
+            uint64_t GetPartitioned() const { return m_partitioned; }
+            std::chrono::microseconds GetTotalWaitTime() const { return m_totalWaitTime; }
+            std::chrono::microseconds GetMaxWaitTime() const { return m_maxWaitTime; }
+            std::chrono::microseconds GetAvgWaitTime() const { return m_dequeued == 0 ? std::chrono::microseconds(0) : std::chrono::microseconds(m_totalWaitTime.count() / (int64_t)m_dequeued); }
+    };
+    //=======================================================================================
+    //! The request queue as last sampled by the query monitor, which samples it once per poll
+    //! interval (one second). Interval values cover the time between the last two samples.
+    // @bsiclass
+    //=======================================================================================
+    struct MonitorStats final {
+        friend struct QueryMonitor;
+        private:
+            QueueStats m_queue;
+            uint64_t m_sampleCount;
+            uint64_t m_intervalDequeued;
+            std::chrono::microseconds m_intervalAvgWaitTime;
+        public:
+            MonitorStats():m_sampleCount(0), m_intervalDequeued(0), m_intervalAvgWaitTime(0){}
+            //! the queue at the time of the last sample. Depths are the requests that were waiting then.
+            QueueStats const& GetQueueStats() const { return m_queue; }
+            //! number of samples taken so far. Zero until the monitor has sampled the queue once.
+            uint64_t GetSampleCount() const { return m_sampleCount; }
+            //! requests dequeued between the last two samples.
+            uint64_t GetIntervalDequeued() const { return m_intervalDequeued; }
+            //! average time spent in the queue by the requests dequeued between the last two samples.
+            std::chrono::microseconds GetIntervalAvgWaitTime() const { return m_intervalAvgWaitTime; }
+    };
     public:
         struct Impl; // prevent circular dependency on ECDb
     private:
@@ -569,6 +763,8 @@ struct ConcurrentQueryMgr final {
         ECDB_EXPORT bool Suspend(ClearCacheOption clearCache, DetachAttachDbs detachDbs);
         ECDB_EXPORT bool Resume();
         ECDB_EXPORT bool IsSuspended() const;
+        ECDB_EXPORT QueueStats GetQueueStats() const;
+        ECDB_EXPORT MonitorStats GetMonitorStats() const;
         // change config
         ECDB_EXPORT void SetWorkerPoolSize(uint32_t);
         ECDB_EXPORT void SetRequestQueueMaxSize(uint32_t);
@@ -114,6 +114,7 @@ struct ECSqlConfig {
                 return false;
             }
             void Clear() {m_disabledFuncList.clear();}
+            bvector<Utf8String> const& GetList() const {return m_disabledFuncList;}
     };
     private:
         DisableSqlFunctions m_disabledFunctions;
@@ -6,6 +6,9 @@
 #include <ECDb/ECSqlStatement.h>
 
 BEGIN_BENTLEY_SQLITE_EC_NAMESPACE
+
+struct ECSqlRowECInstance;
+
 //======================================================================================
 //! Allows reading of EC data from an @ref ECDbFile "ECDb file" 
 //! directly as @ref ECN::IECInstance "ECInstances". 
@@ -21,16 +24,20 @@ BEGIN_BENTLEY_SQLITE_EC_NAMESPACE
 //+===============+===============+===============+===============+===============+======
 struct ECInstanceECSqlSelectAdapter final
     {
+friend struct ECSqlRowECInstance;
+
 private:
     typedef BentleyStatus(ECInstanceECSqlSelectAdapter::*ColumnHandler)(ECN::IECInstanceR instance, IECSqlValue const& value) const;
     bvector<ColumnHandler> m_columnHandlers;
 
     ECSqlStatement const& m_ecSqlStatement;
     bool m_isValid = false;
+    int m_ecInstanceIdColumnIndex = -1;
     int m_ecClassIdColumnIndex = -1;
     int m_sourceECClassIdColumnIndex = -1;
     int m_targetECClassIdColumnIndex = -1;
     bool m_isSingleClassSelectClause = false;
+    mutable bmap<ECN::ECClassId, ECN::IECInstancePtr> m_instanceViews;
 
     //not copyable
     ECInstanceECSqlSelectAdapter(ECInstanceECSqlSelectAdapter const&) = delete;
@@ -44,10 +51,11 @@ private:
     BentleyStatus SetRelationshipTarget(ECN::IECInstanceR instance, IECSqlValue const& value) const;
 
     BentleyStatus SetStructArrayElement(ECN::ECValueR val, ECN::ECClassCR structType, IECSqlValue const& value) const;
-    BentleyStatus SetPrimitiveValue(ECN::ECValueR val, ECN::PrimitiveType primitiveType, IECSqlValue const& value) const;
+    BentleyStatus SetPrimitiveValue(ECN::ECValueR val, ECN::PrimitiveType primitiveType, IECSqlValue const& value, bool copyStrings = true) const;
     BentleyStatus SetNavigationValue(ECN::IECInstanceR instance, IECSqlValue const& value) const;
     ECN::IECInstancePtr FindRelationshipEndpoint(ECInstanceId endpointInstanceId, ECN::ECClassId endpointClassId, ECN::StandaloneECRelationshipInstance*, bool isSource) const;
     BentleyStatus CreateColumnHandlers();
+    ECN::ECClassCP GetRowClass() const;
 
 public:
     //! Creates a new instance of the adapter
@@ -78,6 +86,15 @@ public:
     //! Creates an IECInstancePtr from the current row of the ECSqlStatement for the given ECClass.  
     ECDB_EXPORT ECN::IECInstancePtr GetInstance(ECN::ECClassId) const;
 
+    //! Gets a read-only view of the current row of the ECSqlStatement as an ECInstance.
+    //! Unlike GetInstance, the view does not copy the row's values: property values are read from the
+    //! current row when they are requested. The same view is returned for every row of the same ECClass,
+    //! so it always reflects the row the statement is currently positioned on. Use GetInstance
+    //! to get an ECInstance which outlives the current row.
+    //! This method has the same select clause requirements as GetInstance() and it does not support ECRelationshipClasses.
+    //! @return the view of the current row, or nullptr in case of errors. The view is owned by this adapter.
+    ECDB_EXPORT ECN::IECInstanceCP GetInstanceView() const;
+
     //! Retrieves the ECInstanceId from the current row in the ECSqlStatement.  
     //! The SELECT clause must specifically request the ECInstanceId property in order for this to work
     //! (unless doing 'SELECT *', in which case the ECInstanceId will be retrieved automatically).
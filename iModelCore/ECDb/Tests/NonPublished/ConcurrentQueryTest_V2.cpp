@@ -9,8 +9,10 @@ USING_NAMESPACE_BENTLEY_EC
 #include <future>
 #include <chrono>
 #include <queue>
+#include <set>
 #include <thread>
 #include <memory>
+#include <mutex>
 BEGIN_ECDBUNITTESTS_NAMESPACE
 using namespace std::chrono_literals;
 
@@ -555,6 +557,163 @@ TEST_F(ConcurrentQueryFixture, RestartToken) {
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ConcurrentQueryFixture, QueueLanesAndPriorityClasses) {
+    ASSERT_EQ(BE_SQLITE_OK, SetupECDb("conn_query.ecdb"));
+    ConcurrentQueryMgr::Config conf = ConcurrentQueryMgr::GetConfig(m_ecdb);
+    conf.SetWorkerThreadCount(2);
+    ConcurrentQueryMgr::ResetConfig(m_ecdb, conf);
+
+    auto& mgr = ConcurrentQueryMgr::GetInstance(m_ecdb);
+    ASSERT_TRUE(mgr.Suspend(ConcurrentQueryMgr::ClearCacheOption::No, ConcurrentQueryMgr::DetachAttachDbs::No));
+    const auto sql = "with cnt(x) as (values(0) union select x+1 from cnt where x < ? ) select x from cnt";
+    std::vector<QueryResponse::Future> futures;
+    for (auto priority : {5, 0, -5, 1, 0}) {
+        auto req = ECSqlRequest::MakeRequest(sql, ECSqlParams().BindInt(1, 10));
+        req->SetPriority(priority);
+        futures.push_back(mgr.Enqueue(std::move(req)));
+    }
+
+    // requests are handed out to the executor lanes round-robin and bucketed by the sign of their priority.
+    using PriorityClass = ConcurrentQueryMgr::QueueStats::PriorityClass;
+    auto stats = mgr.GetQueueStats();
+    ASSERT_EQ(stats.GetDepth(), 5);
+    ASSERT_EQ(stats.GetDepth(PriorityClass::High), 2);
+    ASSERT_EQ(stats.GetDepth(PriorityClass::Normal), 2);
+    ASSERT_EQ(stats.GetDepth(PriorityClass::Low), 1);
+    ASSERT_EQ(stats.GetLaneDepth(), std::vector<uint32_t>({3, 2}));
+    ASSERT_EQ(stats.GetDequeued(), 0);
+
+    ASSERT_TRUE(mgr.Resume());
+    for (auto& future : futures)
+        ASSERT_TRUE(future.Get()->IsDone());
+
+    stats = mgr.GetQueueStats();
+    ASSERT_EQ(stats.GetDepth(), 0);
+    ASSERT_EQ(stats.GetLaneDepth(), std::vector<uint32_t>({0, 0}));
+    ASSERT_EQ(stats.GetDequeued(), 5);
+    ASSERT_LE(stats.GetStolen(), 5);
+    ASSERT_LE(stats.GetAvgWaitTime(), stats.GetMaxWaitTime());
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ConcurrentQueryFixture, MonitorPublishesQueueStats) {
+    ASSERT_EQ(BE_SQLITE_OK, SetupECDb("conn_query.ecdb"));
+    auto& mgr = ConcurrentQueryMgr::GetInstance(m_ecdb);
+    // wait until the monitor has taken a sample after the given one.
+    auto waitForSample = [&](uint64_t sampleCount) {
+        const auto deadline = std::chrono::steady_clock::now() + 10s;
+        auto stats = mgr.GetMonitorStats();
+        while (stats.GetSampleCount() <= sampleCount && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(50ms);
+            stats = mgr.GetMonitorStats();
+        }
+        EXPECT_GT(stats.GetSampleCount(), sampleCount);
+        return stats;
+    };
+
+    ASSERT_TRUE(mgr.Suspend(ConcurrentQueryMgr::ClearCacheOption::No, ConcurrentQueryMgr::DetachAttachDbs::No));
+    const auto sql = "with cnt(x) as (values(0) union select x+1 from cnt where x < ? ) select x from cnt";
+    std::vector<QueryResponse::Future> futures;
+    for (auto priority : {5, 0, -5}) {
+        auto req = ECSqlRequest::MakeRequest(sql, ECSqlParams().BindInt(1, 10));
+        req->SetPriority(priority);
+        futures.push_back(mgr.Enqueue(std::move(req)));
+    }
+
+    // the requests wait in the queue while it is suspended, so the next sample sees them.
+    using PriorityClass = ConcurrentQueryMgr::QueueStats::PriorityClass;
+    auto stats = waitForSample(mgr.GetMonitorStats().GetSampleCount());
+    ASSERT_EQ(stats.GetQueueStats().GetDepth(), 3);
+    ASSERT_EQ(stats.GetQueueStats().GetDepth(PriorityClass::High), 1);
+    ASSERT_EQ(stats.GetQueueStats().GetDepth(PriorityClass::Normal), 1);
+    ASSERT_EQ(stats.GetQueueStats().GetDepth(PriorityClass::Low), 1);
+    ASSERT_EQ(stats.GetIntervalDequeued(), 0);
+
+    ASSERT_TRUE(mgr.Resume());
+    for (auto& future : futures)
+        ASSERT_TRUE(future.Get()->IsDone());
+
+    // the samples after resuming see the queue drained, with the wait time of the dequeued requests.
+    // a sample may fall between two dequeues, so the intervals are summed until all three are seen.
+    uint64_t intervalDequeued = 0;
+    for (int i = 0; i < 10 && intervalDequeued < 3; ++i) {
+        stats = waitForSample(stats.GetSampleCount());
+        intervalDequeued += stats.GetIntervalDequeued();
+        if (stats.GetIntervalDequeued() > 0) {
+            ASSERT_GT(stats.GetIntervalAvgWaitTime().count(), 0);
+            ASSERT_LE(stats.GetIntervalAvgWaitTime(), stats.GetQueueStats().GetMaxWaitTime());
+        }
+    }
+    ASSERT_EQ(intervalDequeued, 3);
+    ASSERT_EQ(stats.GetQueueStats().GetDepth(), 0);
+    ASSERT_EQ(stats.GetQueueStats().GetDequeued(), 3);
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ConcurrentQueryFixture, WorkStealingTakesHighestPriorityFirst) {
+    ASSERT_EQ(BE_SQLITE_OK, SetupECDb("conn_query.ecdb"));
+    ConcurrentQueryMgr::Config conf = ConcurrentQueryMgr::GetConfig(m_ecdb);
+    conf.SetWorkerThreadCount(2);
+    conf.SetIgnoreDelay(false);
+    ConcurrentQueryMgr::ResetConfig(m_ecdb, conf);
+
+    auto& mgr = ConcurrentQueryMgr::GetInstance(m_ecdb);
+    ASSERT_TRUE(mgr.Suspend(ConcurrentQueryMgr::ClearCacheOption::No, ConcurrentQueryMgr::DetachAttachDbs::No));
+    const auto sql = "with cnt(x) as (values(0) union select x+1 from cnt where x < ? ) select x from cnt";
+    const std::vector<int32_t> priorities = {3, -2, 7, 1, -6, 4, 0, 9, -1, 5, 2, 8};
+    const auto delay = 2000ms;
+    std::mutex mutex;
+    std::vector<int32_t> completed;
+    std::promise<void> allCompleted;
+    std::vector<QueryResponse::Future> delayed;
+    for (auto priority : priorities) {
+        // the first lane only holds delayed requests so its executor has to steal from the second lane.
+        auto delayedReq = ECSqlRequest::MakeRequest(sql, ECSqlParams().BindInt(1, 10));
+        delayedReq->SetDelay(delay);
+        delayed.push_back(mgr.Enqueue(std::move(delayedReq)));
+
+        auto req = ECSqlRequest::MakeRequest(sql, ECSqlParams().BindInt(1, 5000));
+        req->SetPriority(priority);
+        mgr.Enqueue(std::move(req), [&, priority](QueryResponse::Ptr r) {
+            EXPECT_TRUE(r->IsDone());
+            std::lock_guard<std::mutex> lock(mutex);
+            completed.push_back(priority);
+            if (completed.size() == priorities.size())
+                allCompleted.set_value();
+        });
+    }
+    ASSERT_EQ(mgr.GetQueueStats().GetLaneDepth(), std::vector<uint32_t>({(uint32_t)priorities.size(), (uint32_t)priorities.size()}));
+
+    // a request without delay is only ready once its submit time is in the past.
+    std::this_thread::sleep_for(10ms);
+    ASSERT_TRUE(mgr.Resume());
+    allCompleted.get_future().get();
+    for (auto& future : delayed)
+        ASSERT_TRUE(future.Get()->IsDone());
+
+    // owner and thief both take the highest priority first. A request is only dequeued once every
+    // request with a higher priority has been, so at most the one running on the other executor
+    // completes after it.
+    for (size_t i = 0; i < completed.size(); ++i) {
+        size_t completedLater = 0;
+        for (size_t j = i + 1; j < completed.size(); ++j) {
+            if (completed[j] > completed[i])
+                ++completedLater;
+        }
+        ASSERT_LE(completedLater, 1) << "priority " << completed[i];
+    }
+
+    auto stats = mgr.GetQueueStats();
+    ASSERT_EQ(stats.GetDepth(), 0);
+    ASSERT_EQ(stats.GetDequeued(), 2 * priorities.size());
+    ASSERT_GT(stats.GetStolen(), 0);
+    ASSERT_GE(stats.GetMaxWaitTime(), delay);
+}
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
 TEST_F(ConcurrentQueryFixture, FutureAndCallback) {
     auto testSchema = SchemaItem(R"xml(<?xml version="1.0" encoding="utf-8" ?>
         <ECSchema schemaName="TestSchema" alias="ts" version="1.0" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.1">
@@ -889,5 +1048,368 @@ TEST_F(ConcurrentQueryFixture, BlobIO) {
 }
 
 
+//---------------------------------------------------------------------------------------
+//@bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ConcurrentQueryFixture, ColumnarResult) {
+    auto testSchema = SchemaItem(R"xml(<?xml version="1.0" encoding="utf-8" ?>
+        <ECSchema schemaName="TestSchema" alias="ts" version="1.0" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.1">
+            <ECSchemaReference name="ECDbMap" version="02.00" alias="ecdbmap" />
+            <ECEntityClass typeName="Foo" >
+                <ECCustomAttributes>
+                    <ClassMap xmlns="ECDbMap.02.00">
+                        <MapStrategy>TablePerHierarchy</MapStrategy>
+                    </ClassMap>
+                    </ECCustomAttributes>
+                <ECProperty propertyName="I" typeName="int" />
+                <ECProperty propertyName="D" typeName="double" />
+                <ECProperty propertyName="S" typeName="string" />
+                <ECProperty propertyName="P" typeName="point2d" />
+            </ECEntityClass>
+        </ECSchema>)xml");
+
+    ASSERT_EQ(BE_SQLITE_OK, SetupECDb("ConcurrentQuery_Simple.ecdb", testSchema));
+    ECSqlStatement stmt;
+    ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "insert into ts.Foo(ECInstanceId, I, D, S, P) VALUES(?, ?, ?, ?, ?)"));
+    const auto kRows = 10;
+    for (auto i = 1; i <= kRows; ++i) {
+        stmt.ClearBindings();
+        stmt.Reset();
+        stmt.BindInt(1, i);
+        stmt.BindInt(2, i * 10);
+        stmt.BindDouble(3, i * 0.5);
+        // every odd row has a null string.
+        if (i % 2 == 0)
+            stmt.BindText(4, Utf8PrintfString("str%d", i).c_str(), IECSqlBinder::MakeCopy::Yes);
+        stmt.BindPoint2d(5, DPoint2d::From(i, i));
+        ASSERT_EQ(stmt.Step(), BE_SQLITE_DONE);
+    }
+    m_ecdb.SaveChanges();
+
+    auto& mgr = ConcurrentQueryMgr::GetInstance(m_ecdb);
+    auto request = ECSqlRequest::MakeRequest("select ECInstanceId, I, D, S, P from ts.Foo order by ECInstanceId");
+    request->SetResultFormat(ECSqlRequest::ResultFormat::Columnar);
+    auto resp = mgr.Enqueue(std::move(request)).Get();
+    ASSERT_TRUE(resp->IsDone());
+    auto& ecsqlResp = resp->GetAsConst<ECSqlResponse>();
+    ASSERT_TRUE(ecsqlResp.IsColumnar());
+    ASSERT_EQ(ecsqlResp.GetRowCount(), kRows);
+    ASSERT_TRUE(ecsqlResp.asJsonString().empty());
+
+    auto& result = ecsqlResp.GetColumnarResult();
+    ASSERT_EQ(result.GetColumns().size(), 5);
+    ASSERT_EQ(result.GetColumn(0).GetType(), QueryColumnarResult::ColumnType::Id);
+    ASSERT_EQ(result.GetColumn(1).GetType(), QueryColumnarResult::ColumnType::Int64);
+    ASSERT_EQ(result.GetColumn(2).GetType(), QueryColumnarResult::ColumnType::Double);
+    ASSERT_EQ(result.GetColumn(3).GetType(), QueryColumnarResult::ColumnType::String);
+    ASSERT_EQ(result.GetColumn(4).GetType(), QueryColumnarResult::ColumnType::Json);
+    for (uint32_t row = 0; row < kRows; ++row) {
+        const auto i = row + 1;
+        ASSERT_EQ(result.GetColumn(0).GetId(row), i);
+        ASSERT_EQ(result.GetColumn(1).GetInt64(row), i * 10);
+        ASSERT_DOUBLE_EQ(result.GetColumn(2).GetDouble(row), i * 0.5);
+        if (i % 2 == 0) {
+            ASSERT_FALSE(result.GetColumn(3).IsNull(row));
+            ASSERT_STREQ(result.GetColumn(3).GetString(row).c_str(), Utf8PrintfString("str%d", i).c_str());
+        } else {
+            ASSERT_TRUE(result.GetColumn(3).IsNull(row));
+        }
+        auto pt = Json::Value::From(result.GetColumn(4).GetString(row));
+        ASSERT_EQ(pt["X"].asDouble(), (double)i);
+        ASSERT_EQ(pt["Y"].asDouble(), (double)i);
+    }
+    ASSERT_EQ(result.GetColumn(3).GetOffsets().size(), kRows + 1);
+    ASSERT_EQ(result.GetColumn(3).GetValidity().size(), 2);
+
+    // class ids are converted to the same class names as in the json result.
+    const auto classIdECSql = "select ECClassId from ts.Foo limit 1";
+    auto jsonRequest = ECSqlRequest::MakeRequest(classIdECSql);
+    jsonRequest->SetConvertClassIdsToClassNames(true);
+    auto jsonResp = mgr.Enqueue(std::move(jsonRequest)).Get();
+    ASSERT_TRUE(jsonResp->IsDone());
+    auto jsonRows = Json::Value::From(jsonResp->GetAsConst<ECSqlResponse>().asJsonString());
+    ASSERT_TRUE(jsonRows[0][0].isString());
+
+    auto columnarRequest = ECSqlRequest::MakeRequest(classIdECSql);
+    columnarRequest->SetResultFormat(ECSqlRequest::ResultFormat::Columnar);
+    columnarRequest->SetConvertClassIdsToClassNames(true);
+    auto columnarResp = mgr.Enqueue(std::move(columnarRequest)).Get();
+    ASSERT_TRUE(columnarResp->IsDone());
+    auto& classNames = columnarResp->GetAsConst<ECSqlResponse>().GetColumnarResult();
+    ASSERT_EQ(classNames.GetColumn(0).GetType(), QueryColumnarResult::ColumnType::String);
+    ASSERT_STREQ(classNames.GetColumn(0).GetString(0).c_str(), jsonRows[0][0].asCString());
+}
+
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(ConcurrentQueryFixture, CursorPaging) {
+    auto testSchema = SchemaItem(R"xml(<?xml version="1.0" encoding="utf-8" ?>
+        <ECSchema schemaName="TestSchema" alias="ts" version="1.0" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.1">
+            <ECEntityClass typeName="Foo" >
+                <ECProperty propertyName="I" typeName="int" />
+            </ECEntityClass>
+        </ECSchema>)xml");
+
+    ASSERT_EQ(BE_SQLITE_OK, SetupECDb("ConcurrentQuery_Cursor.ecdb", testSchema));
+    ECSqlStatement stmt;
+    ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "insert into ts.Foo(ECInstanceId, I) VALUES(?, ?)"));
+    const auto kRows = 100;
+    for (auto i = 1; i <= kRows; ++i) {
+        stmt.ClearBindings();
+        stmt.Reset();
+        stmt.BindInt(1, i);
+        stmt.BindInt(2, i);
+        ASSERT_EQ(stmt.Step(), BE_SQLITE_DONE);
+    }
+    m_ecdb.SaveChanges();
+
+    const auto ecsql = "select I from ts.Foo order by I";
+    const auto kPageSize = 30;
+    auto& mgr = ConcurrentQueryMgr::GetInstance(m_ecdb);
+    auto request = ECSqlRequest::MakeRequest(ecsql);
+    request->SetUseCursor(true);
+    request->SetLimit(QueryLimit(kPageSize, 5));
+    auto resp = mgr.Enqueue(std::move(request)).Get();
+
+    // rows 6..100 are read from the same statement, one page per request.
+    int expected = 6;
+    std::string lastToken;
+    while (true) {
+        ASSERT_FALSE(resp->IsError()) << resp->GetError();
+        auto& ecsqlResp = resp->GetAsConst<ECSqlResponse>();
+        auto rows = Json::Value::From(ecsqlResp.asJsonString());
+        ASSERT_LE(rows.size(), kPageSize);
+        for (Json::ArrayIndex i = 0; i < rows.size(); ++i)
+            ASSERT_EQ(rows[i][0].asInt(), expected++);
+
+        if (resp->IsDone()) {
+            ASSERT_TRUE(ecsqlResp.GetContinuationToken().empty());
+            break;
+        }
+        ASSERT_FALSE(ecsqlResp.GetContinuationToken().empty());
+        lastToken = ecsqlResp.GetContinuationToken();
+        auto next = ECSqlRequest::MakeRequest(ecsql);
+        next->SetContinuationToken(lastToken);
+        next->SetLimit(QueryLimit(kPageSize));
+        resp = mgr.Enqueue(std::move(next)).Get();
+    }
+    ASSERT_EQ(expected, kRows + 1);
+
+    // cursor is closed once exhausted.
+    auto stale = ECSqlRequest::MakeRequest(ecsql);
+    stale->SetContinuationToken(lastToken);
+    ASSERT_TRUE(mgr.Enqueue(std::move(stale)).Get()->IsError());
+
+    // a token cannot be used with a different query.
+    request = ECSqlRequest::MakeRequest(ecsql);
+    request->SetUseCursor(true);
+    request->SetLimit(QueryLimit(kPageSize));
+    resp = mgr.Enqueue(std::move(request)).Get();
+    ASSERT_TRUE(resp->IsPartial());
+    auto other = ECSqlRequest::MakeRequest("select I from ts.Foo");
+    other->SetContinuationToken(resp->GetAsConst<ECSqlResponse>().GetContinuationToken());
+    ASSERT_TRUE(mgr.Enqueue(std::move(other)).Get()->IsError());
+
+    // a statement cannot be kept open on the primary connection.
+    request = ECSqlRequest::MakeRequest(ecsql);
+    request->SetUseCursor(true);
+    request->SetUsePrimaryConnection(true);
+    request->SetLimit(QueryLimit(kPageSize));
+    ASSERT_TRUE(mgr.Enqueue(std::move(request)).Get()->IsError());
+
+    // a continuation keeps the args the cursor was opened with.
+    const auto filteredECSql = "select I from ts.Foo where I > ? order by I";
+    request = ECSqlRequest::MakeRequest(filteredECSql, ECSqlParams().BindInt(1, 10));
+    request->SetUseCursor(true);
+    request->SetLimit(QueryLimit(kPageSize));
+    resp = mgr.Enqueue(std::move(request)).Get();
+    ASSERT_TRUE(resp->IsPartial());
+    const auto filteredToken = resp->GetAsConst<ECSqlResponse>().GetContinuationToken();
+    auto changedArgs = ECSqlRequest::MakeRequest(filteredECSql, ECSqlParams().BindInt(1, 50));
+    changedArgs->SetContinuationToken(filteredToken);
+    changedArgs->SetLimit(QueryLimit(kPageSize));
+    ASSERT_TRUE(mgr.Enqueue(std::move(changedArgs)).Get()->IsError());
+    auto sameArgs = ECSqlRequest::MakeRequest(filteredECSql, ECSqlParams().BindInt(1, 10));
+    sameArgs->SetContinuationToken(filteredToken);
+    sameArgs->SetLimit(QueryLimit(kPageSize));
+    resp = mgr.Enqueue(std::move(sameArgs)).Get();
+    ASSERT_FALSE(resp->IsError()) << resp->GetError();
+    auto rows = Json::Value::From(resp->GetAsConst<ECSqlResponse>().asJsonString());
+    ASSERT_EQ(kPageSize, rows.size());
+    ASSERT_EQ(10 + kPageSize + 1, rows[0][0].asInt());
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(ConcurrentQueryFixture, CursorPagingByKey) {
+    auto testSchema = SchemaItem(R"xml(<?xml version="1.0" encoding="utf-8" ?>
+        <ECSchema schemaName="TestSchema" alias="ts" version="1.0" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.1">
+            <ECEntityClass typeName="Foo" >
+                <ECProperty propertyName="I" typeName="int" />
+            </ECEntityClass>
+        </ECSchema>)xml");
+
+    ASSERT_EQ(BE_SQLITE_OK, SetupECDb("ConcurrentQuery_CursorByKey.ecdb", testSchema));
+    ECSqlStatement stmt;
+    ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "insert into ts.Foo(ECInstanceId, I) VALUES(?, ?)"));
+    const auto kRows = 100;
+    // ids are inserted out of order, a keyset cursor returns them in ECInstanceId order.
+    for (auto i = kRows; i >= 1; --i) {
+        stmt.ClearBindings();
+        stmt.Reset();
+        stmt.BindInt(1, i);
+        stmt.BindInt(2, i);
+        ASSERT_EQ(stmt.Step(), BE_SQLITE_DONE);
+    }
+    m_ecdb.SaveChanges();
+
+    const auto ecsql = "select ECInstanceId, I from ts.Foo where I > ?";
+    const auto kPageSize = 30;
+    auto& mgr = ConcurrentQueryMgr::GetInstance(m_ecdb);
+    auto request = ECSqlRequest::MakeRequest(ecsql, ECSqlParams().BindInt(1, 10));
+    request->SetUseCursor(true);
+    request->SetLimit(QueryLimit(kPageSize, 5));
+    auto resp = mgr.Enqueue(std::move(request)).Get();
+
+    // rows 16..100 and the row inserted after the first page.
+    int expected = 16;
+    bool inserted = false;
+    while (true) {
+        ASSERT_FALSE(resp->IsError()) << resp->GetError();
+        auto& ecsqlResp = resp->GetAsConst<ECSqlResponse>();
+        auto rows = Json::Value::From(ecsqlResp.asJsonString());
+        ASSERT_LE(rows.size(), kPageSize);
+        for (Json::ArrayIndex i = 0; i < rows.size(); ++i) {
+            ASSERT_EQ(rows[i][1].asInt(), expected);
+            expected = expected == kRows ? 1000 : expected + 1;
+        }
+        if (resp->IsDone())
+            break;
+
+        if (!inserted) {
+            // the cursor was reset after the page, so it does not hold a read transaction that would block this write.
+            stmt.Finalize();
+            ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "insert into ts.Foo(ECInstanceId, I) VALUES(1000, 1000)"));
+            ASSERT_EQ(stmt.Step(), BE_SQLITE_DONE);
+            stmt.Finalize();
+            ASSERT_EQ(BE_SQLITE_OK, m_ecdb.SaveChanges());
+            inserted = true;
+        }
+        auto next = ECSqlRequest::MakeRequest(ecsql);
+        next->SetContinuationToken(ecsqlResp.GetContinuationToken());
+        next->SetLimit(QueryLimit(kPageSize));
+        resp = mgr.Enqueue(std::move(next)).Get();
+    }
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(1001, expected);
+
+    // idle cursors are closed after the configured timeout.
+    auto config = ConcurrentQueryMgr::GetConfig(m_ecdb);
+    ConcurrentQueryMgr::ResetConfig(m_ecdb, ConcurrentQueryMgr::Config(config).SetCursorIdleTimeout(std::chrono::seconds(0)));
+    request = ECSqlRequest::MakeRequest(ecsql, ECSqlParams().BindInt(1, 10));
+    request->SetUseCursor(true);
+    request->SetLimit(QueryLimit(kPageSize));
+    resp = mgr.Enqueue(std::move(request)).Get();
+    ASSERT_TRUE(resp->IsPartial());
+    auto expired = ECSqlRequest::MakeRequest(ecsql);
+    expired->SetContinuationToken(resp->GetAsConst<ECSqlResponse>().GetContinuationToken());
+    ASSERT_TRUE(mgr.Enqueue(std::move(expired)).Get()->IsError());
+    ConcurrentQueryMgr::ResetConfig(m_ecdb, config);
+}
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(ConcurrentQueryFixture, PartitionedQuery) {
+    // Foo, Goo and Hoo are each mapped to their own table, Ioo shares the table of Goo.
+    auto testSchema = SchemaItem(R"xml(<?xml version="1.0" encoding="utf-8" ?>
+        <ECSchema schemaName="TestSchema" alias="ts" version="1.0" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.1">
+            <ECSchemaReference name="ECDbMap" version="02.00" alias="ecdbmap" />
+            <ECEntityClass typeName="Foo" >
+                <ECProperty propertyName="I" typeName="int" />
+                <ECProperty propertyName="S" typeName="string" />
+            </ECEntityClass>
+            <ECEntityClass typeName="Goo" >
+                <ECCustomAttributes>
+                    <ClassMap xmlns="ECDbMap.02.00">
+                        <MapStrategy>TablePerHierarchy</MapStrategy>
+                    </ClassMap>
+                </ECCustomAttributes>
+                <BaseClass>Foo</BaseClass>
+            </ECEntityClass>
+            <ECEntityClass typeName="Ioo" >
+                <BaseClass>Goo</BaseClass>
+            </ECEntityClass>
+            <ECEntityClass typeName="Hoo" >
+                <BaseClass>Foo</BaseClass>
+            </ECEntityClass>
+        </ECSchema>)xml");
+
+    ASSERT_EQ(BE_SQLITE_OK, SetupECDb("ConcurrentQuery_Partitioned.ecdb", testSchema));
+    const auto kRowsPerClass = 500;
+    const char* classes[] = {"ts.Foo", "ts.Goo", "ts.Ioo", "ts.Hoo"};
+    for (auto k = 0; k < 4; ++k) {
+        ECSqlStatement stmt;
+        ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, Utf8PrintfString("insert into %s(I, S) VALUES(?, ?)", classes[k]).c_str()));
+        for (auto i = 0; i < kRowsPerClass; ++i) {
+            stmt.ClearBindings();
+            stmt.Reset();
+            // values interleave across the tables and repeat, so the merge has ties to resolve.
+            stmt.BindInt(1, (i * 7 + k) % 101);
+            if (i % 5 != 0)
+                stmt.BindText(2, Utf8PrintfString("s%d", (i * 13 + k) % 37).c_str(), IECSqlBinder::MakeCopy::Yes);
+            ASSERT_EQ(stmt.Step(), BE_SQLITE_DONE);
+        }
+    }
+    m_ecdb.SaveChanges();
+
+    auto& mgr = ConcurrentQueryMgr::GetInstance(m_ecdb);
+    auto run = [&](Utf8CP ecsql, bool usePartitions, QueryLimit limit) {
+        auto request = ECSqlRequest::MakeRequest(ecsql);
+        request->SetUsePartitions(usePartitions);
+        request->SetLimit(limit);
+        auto resp = mgr.Enqueue(std::move(request)).Get();
+        EXPECT_TRUE(resp->IsDone()) << ecsql << " " << resp->GetError();
+        return Json::Value::From(resp->GetAsConst<ECSqlResponse>().asJsonString());
+    };
+    auto partitioned = [&]() { return mgr.GetQueueStats().GetPartitioned(); };
+
+    // merged on the sort keys, rows come back exactly as from the unsplit query.
+    auto ordered = "select ECInstanceId, ECClassId, I, S from ts.Foo f where f.I % 3 <> 0 order by f.S desc, I, ECInstanceId";
+    auto expected = run(ordered, false, QueryLimit());
+    ASSERT_GT(expected.size(), 0);
+    ASSERT_EQ(0, partitioned());
+    ASSERT_EQ(run(ordered, true, QueryLimit()), expected);
+    ASSERT_EQ(1, partitioned());
+    auto page = run(ordered, true, QueryLimit(25, 40));
+    ASSERT_EQ(2, partitioned());
+    ASSERT_EQ(page.size(), 25);
+    for (Json::ArrayIndex i = 0; i < page.size(); ++i)
+        ASSERT_EQ(page[i], expected[i + 40]);
+
+    // without ORDER BY the partitions follow each other, the same rows in the same order on every execution.
+    auto unordered = "select ECInstanceId, I from ts.Foo where I > 50";
+    auto all = run(unordered, true, QueryLimit());
+    std::set<std::string> ids;
+    for (auto& row : all)
+        ids.insert(row[0].asString());
+    ASSERT_EQ(ids.size(), all.size());
+    ASSERT_EQ(all.size(), run(unordered, false, QueryLimit()).size());
+    page = run(unordered, true, QueryLimit(100, 150));
+    ASSERT_EQ(page.size(), 100);
+    for (Json::ArrayIndex i = 0; i < page.size(); ++i)
+        ASSERT_EQ(page[i], all[i + 150]);
+    ASSERT_EQ(4, partitioned());
+
+    // queries that cannot be split are executed as usual.
+    auto count = run("select count(*) from ts.Foo", true, QueryLimit());
+    ASSERT_EQ(count[0][0].asInt(), 4 * kRowsPerClass);
+    ASSERT_EQ(run("select I from ts.Foo order by I limit 10", true, QueryLimit()), run("select I from ts.Foo order by I limit 10", false, QueryLimit()));
+    ASSERT_EQ(run("select I from ts.Hoo", true, QueryLimit()).size(), kRowsPerClass);
+    ASSERT_EQ(4, partitioned());
+}
 
 END_ECDBUNITTESTS_NAMESPACE
@@ -372,4 +372,144 @@ TEST_F(ECSqlStatementCacheTests, CacheExcess)
     ASSERT_EQ(1, stmt2->GetRefCount()) << "Statement was removed from cache, so only holder is expected to be stmt1B";
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ECSqlStatementCacheTests, SharedParseTreeIsDroppedOnSchemaChange)
+    {
+    ASSERT_EQ(SUCCESS, SetupECDb("SharedParseTree.ecdb", SchemaItem(R"xml(<?xml version="1.0" encoding="utf-8"?>
+        <ECSchema schemaName="TestSchema" alias="ts" version="01.00.00" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.2">
+            <ECEntityClass typeName="Foo">
+                <ECProperty propertyName="A" typeName="int" />
+            </ECEntityClass>
+        </ECSchema>)xml")));
+
+    ASSERT_EQ(BE_SQLITE_DONE, GetHelper().ExecuteECSql("INSERT INTO ts.Foo(A) VALUES(1)"));
+    Utf8CP ecsql = "SELECT * FROM ts.Foo WHERE A=?";
+
+    int columnCount = 0;
+    {
+    //the second statement reuses the parse tree of the first one and must translate to the same SQL
+    ECSqlStatement stmt1, stmt2;
+    ASSERT_EQ(ECSqlStatus::Success, stmt1.Prepare(m_ecdb, ecsql));
+    ASSERT_EQ(ECSqlStatus::Success, stmt2.Prepare(m_ecdb, ecsql));
+    ASSERT_STREQ(stmt1.GetNativeSql(), stmt2.GetNativeSql());
+    columnCount = stmt1.GetColumnCount();
+    ASSERT_EQ(columnCount, stmt2.GetColumnCount());
+
+    ASSERT_EQ(ECSqlStatus::Success, stmt2.BindInt(1, 1));
+    ASSERT_EQ(BE_SQLITE_ROW, stmt2.Step());
+    ASSERT_EQ(1, stmt2.GetValueInt(columnCount - 1));
+    ASSERT_EQ(BE_SQLITE_DONE, stmt2.Step());
+    }
+
+    //the schema import clears the ECDb cache, so the ECSQL must be parsed again against the new schema
+    ASSERT_EQ(SUCCESS, ImportSchema(SchemaItem(R"xml(<?xml version="1.0" encoding="utf-8"?>
+        <ECSchema schemaName="TestSchema" alias="ts" version="01.00.01" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.2">
+            <ECEntityClass typeName="Foo">
+                <ECProperty propertyName="A" typeName="int" />
+                <ECProperty propertyName="B" typeName="string" />
+            </ECEntityClass>
+        </ECSchema>)xml")));
+
+    ECSqlStatement stmt;
+    ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, ecsql));
+    ASSERT_EQ(columnCount + 1, stmt.GetColumnCount());
+    ASSERT_EQ(ECSqlStatus::Success, stmt.BindInt(1, 1));
+    ASSERT_EQ(BE_SQLITE_ROW, stmt.Step());
+    ASSERT_TRUE(stmt.IsValueNull(columnCount));
+    }
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ECSqlStatementCacheTests, SharedTranslationAcrossDataSourceConnections)
+    {
+    ASSERT_EQ(SUCCESS, SetupECDb("SharedTranslation.ecdb", SchemaItem(R"xml(<?xml version="1.0" encoding="utf-8"?>
+        <ECSchema schemaName="TestSchema" alias="ts" version="01.00.00" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.2">
+            <ECStructClass typeName="Pt">
+                <ECProperty propertyName="X" typeName="double" />
+                <ECProperty propertyName="Y" typeName="double" />
+            </ECStructClass>
+            <ECEntityClass typeName="Foo">
+                <ECProperty propertyName="A" typeName="int" />
+                <ECStructProperty propertyName="S" typeName="Pt" />
+                <ECArrayProperty propertyName="Arr" typeName="int" />
+            </ECEntityClass>
+        </ECSchema>)xml")));
+
+    ASSERT_EQ(BE_SQLITE_DONE, GetHelper().ExecuteECSql("INSERT INTO ts.Foo(A,S.X,S.Y) VALUES(1,1.5,2.5)"));
+    ASSERT_EQ(BE_SQLITE_DONE, GetHelper().ExecuteECSql("INSERT INTO ts.Foo(A,S.X,S.Y) VALUES(2,3.5,4.5)"));
+    m_ecdb.SaveChanges();
+
+    ECDb dataSource;
+    ASSERT_EQ(BE_SQLITE_OK, dataSource.OpenBeSQLiteDb(BeFileName(m_ecdb.GetDbFileName(), true), ECDb::OpenParams(ECDb::OpenMode::Readonly)));
+
+    //the computed select clause item makes the statement generate a property for the select clause
+    Utf8CP ecsql = "SELECT A, S, Arr, A + 10 AS Plus FROM ts.Foo WHERE A>=:minA AND S.X<? ORDER BY A";
+    auto assertStatement = [] (ECSqlStatement& stmt)
+        {
+        ASSERT_EQ(4, stmt.GetColumnCount());
+        ASSERT_STREQ("Plus", stmt.GetColumnInfo(3).GetProperty()->GetName().c_str());
+        ASSERT_EQ(1, stmt.GetParameterIndex("minA"));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindInt(stmt.GetParameterIndex("minA"), 2));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindDouble(2, 10.0));
+        ASSERT_EQ(BE_SQLITE_ROW, stmt.Step());
+        ASSERT_EQ(2, stmt.GetValueInt(0));
+        ASSERT_DOUBLE_EQ(3.5, stmt.GetValue(1)["X"].GetDouble());
+        ASSERT_DOUBLE_EQ(4.5, stmt.GetValue(1)["Y"].GetDouble());
+        ASSERT_EQ(0, stmt.GetValue(2).GetArrayLength());
+        ASSERT_EQ(12, stmt.GetValueInt(3));
+        ASSERT_EQ(BE_SQLITE_DONE, stmt.Step());
+
+        stmt.Reset();
+        stmt.ClearBindings();
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindInt(1, 1));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindDouble(2, 2.0));
+        ASSERT_EQ(BE_SQLITE_ROW, stmt.Step());
+        ASSERT_EQ(1, stmt.GetValueInt(0));
+        ASSERT_DOUBLE_EQ(1.5, stmt.GetValue(1)["X"].GetDouble());
+        ASSERT_EQ(BE_SQLITE_DONE, stmt.Step());
+        };
+
+    ECSqlStatement primaryStmt;
+    ASSERT_EQ(ECSqlStatus::Success, primaryStmt.Prepare(m_ecdb, ecsql));
+    assertStatement(primaryStmt);
+
+    {
+    //the statements on the other connection reuse the translation of the statement prepared against the primary ECDb
+    ECSqlStatement dataSourceStmt1, dataSourceStmt2;
+    ASSERT_EQ(ECSqlStatus::Success, dataSourceStmt1.Prepare(m_ecdb.Schemas(), dataSource, ecsql));
+    ASSERT_EQ(ECSqlStatus::Success, dataSourceStmt2.Prepare(m_ecdb.Schemas(), dataSource, ecsql));
+    ASSERT_STREQ(primaryStmt.GetNativeSql(), dataSourceStmt1.GetNativeSql());
+    ASSERT_STREQ(primaryStmt.GetNativeSql(), dataSourceStmt2.GetNativeSql());
+    assertStatement(dataSourceStmt1);
+    assertStatement(dataSourceStmt2);
+    //the statements do not share bindings
+    ASSERT_EQ(ECSqlStatus::Success, dataSourceStmt1.BindInt(1, 3));
+    ASSERT_EQ(ECSqlStatus::Success, dataSourceStmt1.BindDouble(2, 10.0));
+    ASSERT_EQ(BE_SQLITE_DONE, dataSourceStmt1.Step());
+    ASSERT_EQ(ECSqlStatus::Success, dataSourceStmt2.BindInt(1, 1));
+    ASSERT_EQ(ECSqlStatus::Success, dataSourceStmt2.BindDouble(2, 10.0));
+    ASSERT_EQ(BE_SQLITE_ROW, dataSourceStmt2.Step());
+    }
+
+    //clearing the ECDb cache invalidates existing statements and the cached translations
+    m_ecdb.ClearECDbCache();
+    ASSERT_EQ(BE_SQLITE_ERROR, primaryStmt.Step());
+
+    ECSqlStatement stmt;
+    ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb.Schemas(), dataSource, ecsql));
+    ASSERT_STREQ(primaryStmt.GetNativeSql(), stmt.GetNativeSql());
+    assertStatement(stmt);
+    stmt.Finalize();
+
+    //translations are bound to the ECDb that translated them, not to the file
+    ECSqlStatement otherECDbStmt;
+    ASSERT_EQ(ECSqlStatus::Success, otherECDbStmt.Prepare(dataSource, ecsql));
+    assertStatement(otherECDbStmt);
+    otherECDbStmt.Finalize();
+    dataSource.CloseDb();
+    }
+
 END_ECDBUNITTESTS_NAMESPACE
@@ -8537,6 +8537,107 @@ TEST_F(ECSqlStatementTestFixture, StructUpdateWithDotOperator)
         }
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//+---------------+---------------+---------------+---------------+---------------+------
+TEST_F(ECSqlStatementTestFixture, InstanceViewReadsValuesFromCurrentRow)
+    {
+    ASSERT_EQ(SUCCESS, SetupECDb("ecsqlinstanceview.ecdb", SchemaItem(
+        R"xml(<ECSchema schemaName="TestSchema" alias="ts" version="1.0" xmlns="http://www.bentley.com/schemas/Bentley.ECXML.3.1">
+              <ECStructClass typeName="MyStruct">
+                    <ECProperty propertyName="i" typeName="int" />
+                    <ECProperty propertyName="s" typeName="string" />
+              </ECStructClass>
+              <ECEntityClass typeName="Foo">
+                    <ECProperty propertyName="I" typeName="int" />
+                    <ECProperty propertyName="S" typeName="string" />
+                    <ECProperty propertyName="P3D" typeName="Point3d" />
+                    <ECArrayProperty propertyName="L_Array" typeName="long" />
+                    <ECStructProperty propertyName="Struct" typeName="MyStruct" />
+                    <ECStructArrayProperty propertyName="Struct_Array" typeName="MyStruct" />
+             </ECEntityClass>
+        </ECSchema>)xml")));
+
+    std::vector<ECInstanceKey> keys;
+    for (int i = 1; i <= 2; i++)
+        {
+        ECSqlStatement stmt;
+        ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "INSERT INTO ts.Foo(I, S, P3D, L_Array, Struct.i, Struct.s, Struct_Array) VALUES(?, ?, ?, ?, ?, ?, ?)"));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindInt(1, i));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindText(2, Utf8PrintfString("Foo %d", i).c_str(), IECSqlBinder::MakeCopy::Yes));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindPoint3d(3, DPoint3d::From(i, i, i)));
+        for (int j = 0; j < i; j++)
+            ASSERT_EQ(ECSqlStatus::Success, stmt.GetBinder(4).AddArrayElement().BindInt64(i * 10 + j));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindInt(5, i * 100));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.BindText(6, Utf8PrintfString("Struct %d", i).c_str(), IECSqlBinder::MakeCopy::Yes));
+        ASSERT_EQ(ECSqlStatus::Success, stmt.GetBinder(7).AddArrayElement()["i"].BindInt(i * 1000));
+
+        ECInstanceKey key;
+        ASSERT_EQ(BE_SQLITE_DONE, stmt.Step(key)) << stmt.GetECSql();
+        keys.push_back(key);
+        }
+
+    ECSqlStatement stmt;
+    ASSERT_EQ(ECSqlStatus::Success, stmt.Prepare(m_ecdb, "SELECT ECInstanceId, ECClassId, I, S, P3D, L_Array, Struct, Struct_Array FROM ts.Foo ORDER BY I"));
+    ECInstanceECSqlSelectAdapter adapter(stmt);
+    ASSERT_TRUE(adapter.IsValid());
+
+    IECInstanceCP firstRowView = nullptr;
+    for (int i = 1; i <= 2; i++)
+        {
+        ASSERT_EQ(BE_SQLITE_ROW, stmt.Step()) << stmt.GetECSql();
+        IECInstanceCP view = adapter.GetInstanceView();
+        ASSERT_TRUE(view != nullptr);
+        if (nullptr == firstRowView)
+            firstRowView = view;
+        EXPECT_EQ(firstRowView, view) << "The same view is expected to be reused for every row of the same class";
+        EXPECT_STREQ(keys[i - 1].GetInstanceId().ToString().c_str(), view->GetInstanceId().c_str());
+
+        ECValue v;
+        ASSERT_EQ(ECObjectsStatus::Success, view->GetValue(v, "I"));
+        EXPECT_EQ(i, v.GetInteger());
+        ASSERT_EQ(ECObjectsStatus::Success, view->GetValue(v, "S"));
+        EXPECT_STREQ(Utf8PrintfString("Foo %d", i).c_str(), v.GetUtf8CP());
+        ASSERT_EQ(ECObjectsStatus::Success, view->GetValue(v, "P3D"));
+        EXPECT_TRUE(DPoint3d::From(i, i, i).IsEqual(v.GetPoint3d()));
+        ASSERT_EQ(ECObjectsStatus::Success, view->GetValue(v, "Struct.i"));
+        EXPECT_EQ(i * 100, v.GetInteger());
+        ASSERT_EQ(ECObjectsStatus::Success, view->GetValue(v, "Struct.s"));
+        EXPECT_STREQ(Utf8PrintfString("Struct %d", i).c_str(), v.GetUtf8CP());
+
+        ASSERT_EQ(ECObjectsStatus::Success, view->GetValue(v, "L_Array"));
+        ASSERT_TRUE(v.IsArray());
+        ASSERT_EQ((uint32_t) i, v.GetArrayInfo().GetCount());
+        for (int j = 0; j < i; j++)
+            {
+            ASSERT_EQ(ECObjectsStatus::Success, view->GetValue(v, "L_Array", (uint32_t) j));
+            EXPECT_EQ(i * 10 + j, v.GetLong());
+            }
+        EXPECT_EQ(ECObjectsStatus::IndexOutOfRange, view->GetValue(v, "L_Array", (uint32_t) i));
+
+        ASSERT_EQ(ECObjectsStatus::Success, view->GetValue(v, "Struct_Array", 0));
+        ASSERT_TRUE(v.IsStruct() && v.GetStruct().IsValid());
+        ECValue memberValue;
+        ASSERT_EQ(ECObjectsStatus::Success, v.GetStruct()->GetValue(memberValue, "i"));
+        EXPECT_EQ(i * 1000, memberValue.GetInteger());
+
+        // the view has to expose the same values as the copied instance
+        IECInstancePtr instance = adapter.GetInstance();
+        ASSERT_TRUE(instance.IsValid());
+        for (Utf8CP accessString : {"I", "S", "P3D", "Struct.i", "Struct.s"})
+            {
+            ECValue expected, actual;
+            ASSERT_EQ(ECObjectsStatus::Success, instance->GetValue(expected, accessString));
+            ASSERT_EQ(ECObjectsStatus::Success, view->GetValue(actual, accessString));
+            EXPECT_TRUE(expected.Equals(actual)) << accessString;
+            }
+        }
+    ASSERT_EQ(BE_SQLITE_DONE, stmt.Step());
+
+    ECValue v(5);
+    EXPECT_EQ(ECObjectsStatus::UnableToSetReadOnlyInstance, const_cast<IECInstanceP>(firstRowView)->SetValue("I", v));
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsiclass
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -6,6 +6,7 @@
 
 #include <ECPresentation/ECPresentation.h>
 #include <ECPresentation/ECPresentationErrors.h>
+#include <atomic>
 
 BEGIN_BENTLEY_ECPRESENTATION_NAMESPACE
 
@@ -169,6 +170,34 @@ struct Diagnostics
         void AddValueToArrayAttribute(Utf8CP name, Utf8String value, bool unique);
     };
 
+    /*=================================================================================**//**
+    * A lock-free histogram of durations, measured in microseconds. Values are put into
+    * power-of-two buckets: bucket `i` contains values in range `[2^(i-1), 2^i)`.
+    * @bsiclass
+    +===============+===============+===============+===============+===============+======*/
+    struct Histogram
+    {
+    public:
+        static const size_t BUCKETS_COUNT = 32;
+    private:
+        Utf8String m_name;
+        std::atomic<uint64_t> m_buckets[BUCKETS_COUNT];
+        std::atomic<uint64_t> m_count;
+        std::atomic<uint64_t> m_sum;
+        std::atomic<uint64_t> m_max;
+    public:
+        ECPRESENTATION_EXPORT Histogram(Utf8String name);
+        Utf8StringCR GetName() const {return m_name;}
+        ECPRESENTATION_EXPORT static size_t GetBucketIndex(uint64_t value);
+        ECPRESENTATION_EXPORT void Record(uint64_t microseconds);
+        ECPRESENTATION_EXPORT void Reset();
+        uint64_t GetCount() const {return m_count.load();}
+        uint64_t GetSum() const {return m_sum.load();}
+        uint64_t GetMax() const {return m_max.load();}
+        uint64_t GetBucketCount(size_t index) const {return (index < BUCKETS_COUNT) ? m_buckets[index].load() : 0;}
+        ECPRESENTATION_EXPORT rapidjson::Document BuildJson(rapidjson::Document::AllocatorType* allocator = nullptr) const;
+    };
+
 private:
     static void SetCurrentScope(std::shared_ptr<Scope>);
     static Scope* GetCurrentScopeRaw();
@@ -180,6 +209,13 @@ public:
     ECPRESENTATION_EXPORT static void EditorLog(DiagnosticsCategory, NativeLogging::SEVERITY, Utf8String msg);
     ECPRESENTATION_EXPORT static void SetCapturedAttributes(bvector<Utf8CP> const& attributes);
     ECPRESENTATION_EXPORT static void AddValueToArrayAttribute(Utf8CP name, Utf8String value, bool unique);
+
+    //! Get a process-wide histogram with the given name. The histogram is created on first request.
+    ECPRESENTATION_EXPORT static Histogram& GetHistogram(Utf8CP name);
+    //! Build a JSON object with all process-wide histograms, keyed by their names.
+    ECPRESENTATION_EXPORT static rapidjson::Document GetHistogramsJson(rapidjson::Document::AllocatorType* allocator = nullptr);
+    //! Reset all process-wide histograms.
+    ECPRESENTATION_EXPORT static void ResetHistograms();
 };
 
 #define DIAGNOSTICS_LOG(category, devSeverity, editorSeverity, msg)     Diagnostics::Log(category, devSeverity, editorSeverity, msg);
@@ -189,4 +225,7 @@ public:
 
 #define DIAGNOSTICS_SCOPE_ATTRIBUTE_Rules "rules"
 
+#define DIAGNOSTICS_HISTOGRAM_TasksQueueWait        "tasks-queue-wait"
+#define DIAGNOSTICS_HISTOGRAM_TasksSchedulerCheck   "tasks-scheduler-check"
+
 END_BENTLEY_ECPRESENTATION_NAMESPACE
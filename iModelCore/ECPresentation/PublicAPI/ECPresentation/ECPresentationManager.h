@@ -195,10 +195,11 @@ struct ECPresentationManager : public NonCopyableClass
             uint64_t m_diskCacheFileSizeLimit;
             Nullable<uint64_t> m_diskCacheMemoryCacheSize;
             BeFileName m_cacheDirectory;
+            bool m_shareCacheByChangeset;
         public:
-            CachingParams() : m_mode(Mode::Disk), m_diskCacheFileSizeLimit(DEFAULT_DISK_CACHE_SIZE_LIMIT), m_cacheDirectory(L"") {}
-            CachingParams(uint64_t diskCacheFileSizeLimit): m_mode(Mode::Disk), m_diskCacheFileSizeLimit(diskCacheFileSizeLimit), m_cacheDirectory(L"") {}
-            CachingParams(Utf8StringCR cacheDirectory) : m_mode(Mode::Disk), m_diskCacheFileSizeLimit(DEFAULT_DISK_CACHE_SIZE_LIMIT), m_cacheDirectory(cacheDirectory) {}
+            CachingParams() : m_mode(Mode::Disk), m_diskCacheFileSizeLimit(DEFAULT_DISK_CACHE_SIZE_LIMIT), m_cacheDirectory(L""), m_shareCacheByChangeset(false) {}
+            CachingParams(uint64_t diskCacheFileSizeLimit): m_mode(Mode::Disk), m_diskCacheFileSizeLimit(diskCacheFileSizeLimit), m_cacheDirectory(L""), m_shareCacheByChangeset(false) {}
+            CachingParams(Utf8StringCR cacheDirectory) : m_mode(Mode::Disk), m_diskCacheFileSizeLimit(DEFAULT_DISK_CACHE_SIZE_LIMIT), m_cacheDirectory(cacheDirectory), m_shareCacheByChangeset(false) {}
             //! Is hierarchy caching on disk disabled
             Mode GetCacheMode() const {return m_mode;}
             void SetCacheMode(Mode value) {m_mode = value;}
@@ -213,6 +214,11 @@ struct ECPresentationManager : public NonCopyableClass
             //! Maximum allowed size of the memory cache used by the disk-based hierarchy cache.
             Nullable<uint64_t> const& GetDiskCacheMemoryCacheSize() const {return m_diskCacheMemoryCacheSize;}
             void SetDiskCacheMemoryCacheSize(Nullable<uint64_t> value) {m_diskCacheMemoryCacheSize = value;}
+            //! Should disk caches of read-only connections be keyed by iModel id and parent changeset id instead of iModel file name.
+            //! Such caches outlive the session and are shared by all processes using the same cache directory, so a backend opening
+            //! an iModel at a changeset some other backend has already seen starts with its hierarchies cached.
+            bool ShouldShareCacheByChangeset() const {return m_shareCacheByChangeset;}
+            void SetShareCacheByChangeset(bool value) {m_shareCacheByChangeset = value;}
         };
 
         //===================================================================================
@@ -159,6 +159,19 @@ void ContentCache::ClearCache(Utf8StringCR rulesetId)
     Erase(m_cacheEntries, pred);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ContentCache::ClearCache(ContentProviderKey const& key, RulesetVariables const& relatedVariables)
+    {
+    BeMutexHolder lock(m_mutex);
+    auto iter = std::remove_if(m_cacheEntries.begin(), m_cacheEntries.end(), [&key, &relatedVariables](ContentCacheEntry const& entry)
+        {
+        return entry.GetProviderKey() == key && entry.GetRelatedVariables() == relatedVariables;
+        });
+    m_cacheEntries.erase(iter, m_cacheEntries.end());
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -208,6 +221,22 @@ bvector<SpecificationContentProviderPtr> ContentCache::GetProviders(IConnectionC
     return providers;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bvector<ContentCacheEntry> ContentCache::GetEntries(IConnectionCR connection) const
+    {
+    BeMutexHolder lock(m_mutex);
+    bvector<ContentCacheEntry> entries;
+    for (ContentCacheEntry const& entry : m_cacheEntries)
+        {
+        ContentProviderKey const& key = entry.GetProviderKey();
+        if (key.GetConnectionId().Equals(connection.GetId()))
+            entries.push_back(entry);
+        }
+    return entries;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
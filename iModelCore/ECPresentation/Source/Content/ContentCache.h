@@ -86,8 +86,10 @@ public:
     void ClearCache() {BeMutexHolder lock(m_mutex); m_cacheEntries.clear();}
     ECPRESENTATION_EXPORT void ClearCache(IConnectionCR connection);
     ECPRESENTATION_EXPORT void ClearCache(Utf8StringCR rulesetId);
+    ECPRESENTATION_EXPORT void ClearCache(ContentProviderKey const& key, RulesetVariables const& relatedVariables);
     ECPRESENTATION_EXPORT SpecificationContentProviderPtr GetProvider(ContentProviderKey const& key, RulesetVariables const& variables);
     ECPRESENTATION_EXPORT bvector<SpecificationContentProviderPtr> GetProviders(IConnectionCR) const;
+    ECPRESENTATION_EXPORT bvector<ContentCacheEntry> GetEntries(IConnectionCR) const;
     ECPRESENTATION_EXPORT bvector<SpecificationContentProviderPtr> GetProviders(Utf8CP rulesetId, Utf8CP settingId) const;
     ECPRESENTATION_EXPORT void CacheProvider(ContentProviderKey key, SpecificationContentProviderR provider);
 };
@@ -114,6 +114,52 @@ void SpecificationContentProvider::_OnDescriptorChanged()
     ContentProvider::_OnDescriptorChanged();
     }
 
+/*=================================================================================**//**
+* Detects content specifications whose results depend on ECInstance property values.
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct ValueDependentSpecificationsDetector : PresentationRuleSpecificationVisitor
+{
+private:
+    bool m_result;
+protected:
+    void _Visit(ContentInstancesOfSpecificClassesSpecification const& spec) override {m_result |= !spec.GetInstanceFilter().empty();}
+    void _Visit(ContentRelatedInstancesSpecification const& spec) override {m_result |= !spec.GetInstanceFilter().empty();}
+public:
+    ValueDependentSpecificationsDetector() : m_result(false) {}
+    bool HasValueDependentSpecifications() const {return m_result;}
+};
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool SpecificationContentProvider::_HasValueDependentContent() const
+    {
+    ValueDependentSpecificationsDetector detector;
+    for (ContentRuleInstanceKeys const& rule : m_rules)
+        {
+        for (ContentSpecificationCP spec : rule.GetRule().GetSpecifications())
+            spec->Accept(detector);
+        }
+    return detector.HasValueDependentSpecifications();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool SpecificationContentProvider::_IsInputInstance(ECInstanceId id) const
+    {
+    for (ContentRuleInstanceKeys const& rule : m_rules)
+        {
+        for (ECInstanceKeyCR key : rule.GetInstanceKeys())
+            {
+            if (key.GetInstanceId() == id)
+                return true;
+            }
+        }
+    return false;
+    }
+
 /*=================================================================================**//**
 * @bsiclass
 +===============+===============+===============+===============+===============+======*/
@@ -822,6 +868,7 @@ void ContentProvider::InvalidateRecords()
     {
     BeMutexHolder lock(GetMutex());
     m_records = nullptr;
+    m_recordIndexesByInstanceId.clear();
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -1115,7 +1162,7 @@ void ContentProvider::_OnDescriptorChanged()
 void ContentProvider::_OnPageOptionsChanged()
     {
     BeMutexHolder lock(GetMutex());
-    m_records = nullptr;
+    InvalidateRecords();
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -1214,6 +1261,7 @@ void ContentProvider::Initialize()
             }
         }
     m_records = std::make_unique<bvector<ContentSetItemPtr>>(std::move(records));
+    IndexRecords();
     DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_INFO, Utf8PrintfString("Read content items: %" PRIu64, (uint64_t)m_records->size()));
     }
 
@@ -1295,6 +1343,272 @@ bool ContentProvider::GetContentSetItem(ContentSetItemPtr& item, size_t index) c
     return true;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ContentProvider::IndexRecords()
+    {
+    BeMutexHolder lock(GetMutex());
+    m_recordIndexesByInstanceId.clear();
+    if (nullptr == m_records)
+        return;
+
+    for (size_t i = 0; i < m_records->size(); ++i)
+        {
+        ContentSetItemCR record = *m_records->at(i);
+        for (ECClassInstanceKeyCR key : record.GetKeys())
+            m_recordIndexesByInstanceId[key.GetId()].insert(i);
+        for (auto const& entry : record.GetFieldInstanceKeys())
+            {
+            for (ECClassInstanceKeyCR key : entry.second)
+                m_recordIndexesByInstanceId[key.GetId()].insert(i);
+            }
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bvector<ContentSetItemPtr> ContentProvider::ReadRecords(size_t start, size_t count) const
+    {
+    // read using a private clone - this provider may be in use by a request, so its own
+    // context can't be re-adopted
+    ContentProviderPtr provider = _Clone();
+    provider->GetContextR().ShallowAdoptToSameConnection(nullptr);
+    provider->SetPageOptions(PageOptions(start, count));
+    provider->Initialize();
+    if (nullptr == provider->m_records)
+        return bvector<ContentSetItemPtr>();
+    return *provider->m_records;
+    }
+
+/*=================================================================================**//**
+* Detects instance label overrides whose values are taken from related instances.
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct RelatedInstanceLabelsDetector : InstanceLabelOverrideValueSpecificationVisitor
+{
+private:
+    bool m_result;
+protected:
+    void _Visit(InstanceLabelOverrideCompositeValueSpecification const& spec) override
+        {
+        for (InstanceLabelOverrideCompositeValueSpecification::Part const* part : spec.GetValueParts())
+            {
+            if (nullptr != part->GetSpecification())
+                part->GetSpecification()->Accept(*this);
+            }
+        }
+    void _Visit(InstanceLabelOverridePropertyValueSpecification const& spec) override {m_result |= !spec.GetPathToRelatedInstanceSpecification().GetSteps().empty();}
+    void _Visit(InstanceLabelOverrideRelatedInstanceLabelSpecification const&) override {m_result = true;}
+public:
+    RelatedInstanceLabelsDetector() : m_result(false) {}
+    bool HasRelatedInstanceLabels() const {return m_result;}
+};
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool HasRelatedInstanceLabels(PresentationRuleSetCR ruleset)
+    {
+    // deprecated label overrides are ECExpressions which may reference anything
+    if (!ruleset.GetLabelOverrides().empty())
+        return true;
+
+    RelatedInstanceLabelsDetector detector;
+    for (InstanceLabelOverrideCP labelOverride : ruleset.GetInstanceLabelOverrides())
+        {
+        for (InstanceLabelOverrideValueSpecification const* spec : labelOverride->GetValueSpecifications())
+            spec->Accept(detector);
+        }
+    return detector.HasRelatedInstanceLabels();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static void CollectInvolvedClasses(bset<ECClassCP>& classes, bvector<RelatedClass> const& path)
+    {
+    for (RelatedClass const& related : path)
+        {
+        if (!related.IsValid())
+            continue;
+        classes.insert(related.GetSourceClass());
+        classes.insert(&related.GetTargetClass().GetClass());
+        if (related.GetRelationship().IsValid())
+            classes.insert(&related.GetRelationship().GetClass());
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Collects classes whose instances are used by given fields. Returns false if any of the
+* fields has values that can't be attributed to specific instances.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool CollectInvolvedClasses(bset<ECClassCP>& classes, bvector<ContentDescriptor::Field*> const& fields)
+    {
+    for (ContentDescriptor::Field const* field : fields)
+        {
+        if (field->IsCalculatedPropertyField())
+            return false;
+
+        if (field->IsPropertiesField())
+            {
+            for (ContentDescriptor::Property const& prop : field->AsPropertiesField()->GetProperties())
+                classes.insert(&prop.GetPropertyClass());
+            }
+
+        if (field->IsNestedContentField())
+            {
+            ContentDescriptor::NestedContentField const& nestedField = *field->AsNestedContentField();
+            classes.insert(&nestedField.GetContentClass());
+            if (nullptr != nestedField.AsRelatedContentField())
+                CollectInvolvedClasses(classes, nestedField.AsRelatedContentField()->GetPathFromSelectToContentClass());
+            if (!CollectInvolvedClasses(classes, nestedField.GetFields()))
+                return false;
+            }
+        }
+    return true;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool IsClassInvolved(bset<ECClassCP> const& classes, ECClassCR changedClass)
+    {
+    for (ECClassCP involvedClass : classes)
+        {
+        if (changedClass.Is(involvedClass) || involvedClass->Is(&changedClass))
+            return true;
+        }
+    return false;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool AreKeysEqual(bvector<ECClassInstanceKey> const& lhs, bvector<ECClassInstanceKey> const& rhs)
+    {
+    if (lhs.size() != rhs.size())
+        return false;
+    for (size_t i = 0; i < lhs.size(); ++i)
+        {
+        if (!(lhs[i] == rhs[i]))
+            return false;
+        }
+    return true;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Attempts to apply given ECInstance changes to this provider without dropping its
+* content. Only property value updates of instances whose values are displayed in the
+* current page are applied in place by re-reading affected records - any other change
+* that may affect the content invalidates the provider.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ContentChangesResult ContentProvider::ApplyChanges(bvector<ECInstanceChangeEventSource::ChangedECInstance> const& changes)
+    {
+    BeMutexHolder lock(GetMutex());
+    auto scope = Diagnostics::Scope::Create("Apply changes to content provider");
+
+    ContentDescriptorCP descriptor = GetContentDescriptor();
+    if (nullptr == descriptor)
+        {
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, "Descriptor is NULL. Invalidate.");
+        return ContentChangesResult::Invalidated;
+        }
+
+    if (descriptor->MergeResults() || !descriptor->GetFieldsFilterExpression().empty() || nullptr != descriptor->GetInstanceFilter()
+        || _HasValueDependentContent() || HasRelatedInstanceLabels(GetContext().GetRuleset()))
+        {
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, "Content depends on property values of unknown instances. Invalidate.");
+        return ContentChangesResult::Invalidated;
+        }
+
+    bset<ECClassCP> involvedClasses;
+    if (!CollectInvolvedClasses(involvedClasses, descriptor->GetAllFields()))
+        {
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, "Descriptor contains calculated fields. Invalidate.");
+        return ContentChangesResult::Invalidated;
+        }
+    for (SelectClassInfo const& selectClass : descriptor->GetSelectClasses())
+        {
+        involvedClasses.insert(&selectClass.GetSelectClass().GetClass());
+        CollectInvolvedClasses(involvedClasses, selectClass.GetPathFromInputToSelectClass());
+        for (RelatedClassPath const& path : selectClass.GetRelatedPropertyPaths())
+            CollectInvolvedClasses(involvedClasses, path);
+        for (RelatedClassPath const& path : selectClass.GetRelatedInstancePaths())
+            CollectInvolvedClasses(involvedClasses, path);
+        CollectInvolvedClasses(involvedClasses, selectClass.GetNavigationPropertyClasses());
+        }
+
+    bset<size_t> affectedRecordIndexes;
+    for (ECInstanceChangeEventSource::ChangedECInstance const& change : changes)
+        {
+        if (!change.IsValid())
+            continue;
+
+        if (_IsInputInstance(change.GetInstanceId()))
+            {
+            DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, Utf8PrintfString("Input instance %s changed. Invalidate.", change.GetInstanceId().ToString().c_str()));
+            return ContentChangesResult::Invalidated;
+            }
+
+        if (!IsClassInvolved(involvedClasses, *change.GetClass()))
+            continue;
+
+        if (ChangeType::Update != change.GetChangeType() || nullptr == m_records)
+            {
+            DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, Utf8PrintfString("Instance of involved class %s inserted, deleted or updated "
+                "without loaded records. Invalidate.", change.GetClass()->GetFullName()));
+            return ContentChangesResult::Invalidated;
+            }
+
+        auto indexesIter = m_recordIndexesByInstanceId.find(change.GetInstanceId());
+        if (m_recordIndexesByInstanceId.end() == indexesIter)
+            {
+            // the update might make an instance appear in this page or change values of some
+            // instance which isn't tracked (e.g. a navigation property target)
+            DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, Utf8PrintfString("Updated instance %s is not tracked by loaded records. Invalidate.",
+                change.GetInstanceId().ToString().c_str()));
+            return ContentChangesResult::Invalidated;
+            }
+        affectedRecordIndexes.insert(indexesIter->second.begin(), indexesIter->second.end());
+        }
+
+    if (affectedRecordIndexes.empty())
+        {
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, "Content is not affected by the changes.");
+        return ContentChangesResult::Unaffected;
+        }
+
+    // re-read all affected records with a single query over the span of the page they occupy
+    size_t firstIndex = *affectedRecordIndexes.begin();
+    size_t spanSize = *affectedRecordIndexes.rbegin() - firstIndex + 1;
+    DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_INFO, Utf8PrintfString("Re-reading %" PRIu64 " affected records in a span of %" PRIu64 ".",
+        (uint64_t)affectedRecordIndexes.size(), (uint64_t)spanSize));
+    bvector<ContentSetItemPtr> records = ReadRecords(GetPageOptions().GetPageStart() + firstIndex, spanSize);
+    for (size_t index : affectedRecordIndexes)
+        {
+        ContentSetItemPtr record = (index - firstIndex < records.size()) ? records[index - firstIndex] : nullptr;
+        if (record.IsNull() || !AreKeysEqual(record->GetKeys(), m_records->at(index)->GetKeys()))
+            {
+            // the update moved records around (e.g. changed sorting) or made some instance
+            // disappear from content - the whole page has to be re-read
+            DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Content, LOG_TRACE, Utf8PrintfString("Record at %" PRIu64 " changed its identity. Drop all records.", (uint64_t)index));
+            InvalidateRecords();
+            InvalidateFullContentSetSize();
+            break;
+            }
+        (*m_records)[index] = record;
+        }
+
+    IndexRecords();
+    InvalidateNestedContentProviders();
+    _OnRecordsChanged();
+    return ContentChangesResult::Updated;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
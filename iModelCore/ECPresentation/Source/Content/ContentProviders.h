@@ -67,6 +67,17 @@ public:
     void SetQueryContext(ContentProviderContextCR other) {RulesDrivenProviderContext::SetQueryContext(other);}
 };
 
+/*=================================================================================**//**
+* Result of applying ECInstance changes to a content provider.
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+enum class ContentChangesResult
+    {
+    Unaffected,  //!< None of the changes affect provider's content.
+    Updated,     //!< Affected records were re-read in place - the provider is still valid.
+    Invalidated, //!< Changes can't be applied incrementally - the provider has to be dropped.
+    };
+
 /*=================================================================================**//**
 * @bsiclass
 +===============+===============+===============+===============+===============+======*/
@@ -76,6 +87,7 @@ private:
     ContentProviderContextPtr m_context;
     PageOptions m_pageOptions;
     std::unique_ptr<bvector<ContentSetItemPtr>> m_records;
+    bmap<ECInstanceId, bset<size_t>> m_recordIndexesByInstanceId;
     mutable std::unique_ptr<size_t> m_fullContentSetSize;
     mutable bmap<ContentDescriptor::NestedContentField const*, NestedContentProviderPtr> m_nestedContentProviders;
     mutable BeMutex m_mutex;
@@ -86,6 +98,8 @@ private:
     void LoadNestedContent(ContentSetItemR) const;
     void LoadNestedContentFieldValue(ContentSetItemR, ContentDescriptor::NestedContentField const&, bool) const;
     void LoadCompositePropertiesFieldValue(ContentSetItemR, ContentDescriptor::ECPropertiesField const&) const;
+    void IndexRecords();
+    bvector<ContentSetItemPtr> ReadRecords(size_t start, size_t count) const;
 
 protected:
     ECPRESENTATION_EXPORT ContentProvider(ContentProviderContextR);
@@ -100,6 +114,9 @@ protected:
     virtual ContentProviderPtr _Clone() const = 0;
     virtual void _OnDescriptorChanged();
     virtual void _OnPageOptionsChanged();
+    virtual void _OnRecordsChanged() {}
+    virtual bool _HasValueDependentContent() const {return false;}
+    virtual bool _IsInputInstance(ECInstanceId) const {return false;}
 
 public:
     void Initialize();
@@ -119,6 +136,7 @@ public:
     ECPRESENTATION_EXPORT size_t GetFullContentSetSize() const;
 
     void InvalidateContent() {_OnDescriptorChanged();}
+    ECPRESENTATION_EXPORT ContentChangesResult ApplyChanges(bvector<ECInstanceChangeEventSource::ChangedECInstance> const&);
 };
 
 /*=================================================================================**//**
@@ -143,6 +161,9 @@ protected:
     QuerySet _GetCountQuerySet() const override;
     ContentProviderPtr _Clone() const override {return new SpecificationContentProvider(*this);}
     void _OnDescriptorChanged() override;
+    void _OnRecordsChanged() override {m_distinctValuesCache.clear();}
+    bool _HasValueDependentContent() const override;
+    bool _IsInputInstance(ECInstanceId) const override;
 public:
     static SpecificationContentProviderPtr Create(ContentProviderContextR context, ContentRuleInstanceKeysContainer const& specs) {return new SpecificationContentProvider(context, specs);}
     static SpecificationContentProviderPtr Create(ContentProviderContextR context, ContentRuleInstanceKeys const& spec)
@@ -47,7 +47,7 @@ protected:
         taskParams.SetOtherTasksBlockingPredicate([connectionId = connection->GetId()](IECPresentationTaskCR task)
             {
             return task.GetDependencies().Has(TaskDependencyOnConnection(connectionId));
-            });
+            }, std::make_shared<TaskDependencyOnConnection>(connection->GetId()));
         m_manager.GetTasksManager().CreateAndExecute([&, connectionId = connection->GetId(), changes](IECPresentationTaskR task)
             {
             IConnectionPtr taskConnection = connections.GetConnection(connectionId.c_str());
@@ -96,12 +96,13 @@ private:
     InterruptResult BlockInterruptTasks(InterruptAction action, IConnectionCR connection)
         {
         BeMutexHolder lock(m_tasksManager.GetMutex());
+        TaskDependencyOnConnection connectionDependency(connection.GetId());
         auto tasksPredicate = [&](IECPresentationTaskCR task)
             {
-            return task.GetDependencies().Has(TaskDependencyOnConnection(connection.GetId()));
+            return task.GetDependencies().Has(connectionDependency);
             };
         TasksCancelationResult cancelation =
-            (CANCEL == action) ? m_tasksManager.Cancel(tasksPredicate) :
+            (CANCEL == action) ? m_tasksManager.Cancel(connectionDependency) :
             (RESTART == action) ? m_tasksManager.Restart(tasksPredicate) :
             TasksCancelationResult(bset<IECPresentationTaskCPtr>());
         auto blocker = m_tasksManager.Block([connectionId = connection.GetId(), tasks = cancelation.GetTasks()](IECPresentationTaskCR task)
@@ -204,10 +205,7 @@ protected:
         if (nullptr == GetRulesetCallbacksHandler())
             return;
 
-        m_tasksManager.Cancel([&](IECPresentationTaskCR task)
-            {
-            return task.GetDependencies().Has(TaskDependencyOnRuleset(ruleset.GetRuleSetId()));
-            }).GetCompletion().wait();
+        m_tasksManager.Cancel(TaskDependencyOnRuleset(ruleset.GetRuleSetId())).GetCompletion().wait();
         GetRulesetCallbacksHandler()->_OnRulesetDispose(locater, ruleset);
         }
     void _OnRulesetCreated(RuleSetLocaterCR locater, PresentationRuleSetR ruleset) override
@@ -433,7 +431,7 @@ static ECPresentationTaskParams CreateNodesTaskParams(ECPresentationManager::Imp
     taskParams.SetOtherTasksBlockingPredicate([parentId](auto const& task)
         {
         return task.GetDependencies().Has(TaskDependencyOnParentNode(parentId));
-        });
+        }, std::make_shared<TaskDependencyOnParentNode>(parentId));
 
     // set predicate which checks if this task is blocked
     taskParams.SetThisTaskBlockingPredicate([&impl, connectionId = connection.GetId(), identifier = CombinedHierarchyLevelIdentifier(connection.GetId(), requestParams.GetRulesetId(), parentId)]()
@@ -560,7 +558,7 @@ folly::Future<NodePathsResponse> ECPresentationManager::GetNodePaths(AsyncNodePa
     taskParams.SetOtherTasksBlockingPredicate([connectionId = connection.GetId(), rulesetId = params.GetRulesetId()](auto const& task)
         {
         return task.GetDependencies().Has(TaskDependencyOnConnection(connectionId)) && task.GetDependencies().Has(TaskDependencyOnRuleset(rulesetId));
-        });
+        }, std::make_shared<TaskDependencyOnRuleset>(params.GetRulesetId()));
 
     return m_tasksManager->CreateAndExecute<NodePathsResponse>([&, params, connectionId = connection.GetId()](auto& task) mutable
         {
@@ -603,7 +601,7 @@ folly::Future<NodePathsResponse> ECPresentationManager::GetNodePaths(AsyncNodePa
     taskParams.SetOtherTasksBlockingPredicate([connectionId = connection.GetId(), rulesetId = params.GetRulesetId()](auto const& task)
         {
         return task.GetDependencies().Has(TaskDependencyOnConnection(connectionId)) && task.GetDependencies().Has(TaskDependencyOnRuleset(rulesetId));
-        });
+        }, std::make_shared<TaskDependencyOnRuleset>(params.GetRulesetId()));
     return m_tasksManager->CreateAndExecute<NodePathsResponse>([&, params, connectionId = connection.GetId()](auto& task) mutable
         {
         CALL_TASK_START_CALLBACK(params);
@@ -652,15 +650,19 @@ folly::Future<ContentClassesResponse> ECPresentationManager::GetContentClasses(A
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-static bool ShouldCancelContentRequest(IECPresentationTaskCR request, Utf8StringCR displayType, Utf8StringCR connectionId, SelectionInfoCR selectionInfo)
+static void CancelContentRequests(ECPresentationTasksManager& tasksManager, Utf8StringCR displayType, Utf8StringCR connectionId, SelectionInfoCR selectionInfo)
     {
-    return request.GetDependencies().Has(TaskDependencyOnDisplayType(displayType))
-        && request.GetDependencies().Has(TaskDependencyOnConnection(connectionId))
-        && request.GetDependencies().Has(TaskDependencyOnSelection::CreatePredicate([&selectionInfo](SelectionInfoCR dependencySelectionInfo)
-            {
-            return dependencySelectionInfo.GetSelectionProviderName().Equals(selectionInfo.GetSelectionProviderName())
-                && dependencySelectionInfo.GetTimestamp() != selectionInfo.GetTimestamp();
-            }));
+    // note: the display type dependency is used to look up candidate tasks in the tasks index, the rest of
+    // dependencies are checked on the candidates
+    tasksManager.Cancel(TaskDependencyOnDisplayType(displayType), [&](IECPresentationTaskCR request)
+        {
+        return request.GetDependencies().Has(TaskDependencyOnConnection(connectionId))
+            && request.GetDependencies().Has(TaskDependencyOnSelection::CreatePredicate([&selectionInfo](SelectionInfoCR dependencySelectionInfo)
+                {
+                return dependencySelectionInfo.GetSelectionProviderName().Equals(selectionInfo.GetSelectionProviderName())
+                    && dependencySelectionInfo.GetTimestamp() != selectionInfo.GetTimestamp();
+                }));
+        });
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -675,10 +677,7 @@ folly::Future<ContentDescriptorResponse> ECPresentationManager::GetContentDescri
 
     if (params.GetSelectionInfo())
         {
-        m_tasksManager->Cancel([&](IECPresentationTaskCR task)
-            {
-            return ShouldCancelContentRequest(task, params.GetPreferredDisplayType(), connection.GetId(), *params.GetSelectionInfo());
-            });
+        CancelContentRequests(*m_tasksManager, params.GetPreferredDisplayType(), connection.GetId(), *params.GetSelectionInfo());
         }
 
     TaskDependencies dependencies
@@ -713,10 +712,7 @@ folly::Future<ContentResponse> ECPresentationManager::GetContent(WithPageOptions
     Diagnostics::SetCapturedAttributes({ DIAGNOSTICS_SCOPE_ATTRIBUTE_Rules });
     if (params.GetContentDescriptor().GetSelectionInfo())
         {
-        m_tasksManager->Cancel([&](IECPresentationTaskCR task)
-            {
-            return ShouldCancelContentRequest(task, params.GetContentDescriptor().GetPreferredDisplayType(), params.GetContentDescriptor().GetConnectionId().c_str(), *params.GetContentDescriptor().GetSelectionInfo());
-            });
+        CancelContentRequests(*m_tasksManager, params.GetContentDescriptor().GetPreferredDisplayType(), params.GetContentDescriptor().GetConnectionId(), *params.GetContentDescriptor().GetSelectionInfo());
         }
 
     TaskDependencies dependencies
@@ -754,10 +750,7 @@ folly::Future<ContentSetSizeResponse> ECPresentationManager::GetContentSetSize(A
     Diagnostics::SetCapturedAttributes({ DIAGNOSTICS_SCOPE_ATTRIBUTE_Rules });
     if (params.GetContentDescriptor().GetSelectionInfo())
         {
-        m_tasksManager->Cancel([&](IECPresentationTaskCR task)
-            {
-            return ShouldCancelContentRequest(task, params.GetContentDescriptor().GetPreferredDisplayType(), params.GetContentDescriptor().GetConnectionId().c_str(), *params.GetContentDescriptor().GetSelectionInfo());
-            });
+        CancelContentRequests(*m_tasksManager, params.GetContentDescriptor().GetPreferredDisplayType(), params.GetContentDescriptor().GetConnectionId(), *params.GetContentDescriptor().GetSelectionInfo());
         }
 
     TaskDependencies dependencies
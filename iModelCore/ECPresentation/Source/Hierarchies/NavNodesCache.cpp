@@ -7,6 +7,7 @@
 #include <ECPresentation/DefaultECPresentationSerializer.h>
 #include <ECDb/ECDbApi.h>
 #include <BeSQLite/Profiler.h>
+#include <Bentley/BeFileListIterator.h>
 #include "../Shared/ExtendedData.h"
 #include "../UpdateHandler.h"
 #include "NavNodesHelper.h"
@@ -304,6 +305,7 @@ static int64_t GetConnectionLastModTime(IConnectionCR connection)
 static PropertySpec s_versionPropertySpec("Version", "HierarchyCache");
 static PropertySpec s_cachesUpdateDataFlagPropertySpec("CachesUpdateData", "HierarchyCache");
 static PropertySpec s_connectionLastModTimePropertySpec("ConnectionLastModTime", "HierarchyCache");
+static PropertySpec s_connectionChangesetIdPropertySpec("ConnectionChangesetId", "HierarchyCache");
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -318,8 +320,16 @@ static BeVersion GetCacheVersion(BeSQLite::Db const& db)
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-static bool IsConnectionAndCacheOutOfSync(BeSQLite::Db const& db, IConnectionCR connection)
+static bool IsConnectionAndCacheOutOfSync(BeSQLite::Db const& db, IConnectionCR connection, Utf8StringCR changesetId)
     {
+    if (!changesetId.empty())
+        {
+        // caches shared by changeset are valid for as long as they're keyed by the same changeset, no matter
+        // which process and which copy of the iModel created them
+        Utf8String cachedChangesetId;
+        return BE_SQLITE_ROW != db.QueryProperty(cachedChangesetId, s_connectionChangesetIdPropertySpec) || !changesetId.Equals(cachedChangesetId);
+        }
+
     Utf8String lastModValueStr;
     if (BE_SQLITE_ROW != db.QueryProperty(lastModValueStr, s_connectionLastModTimePropertySpec))
         return false;
@@ -369,6 +379,53 @@ static BeFileName GetCacheDbPath(BeFileNameCR directory, IConnectionCR connectio
     return path;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Get the id of the changeset the connection's hierarchy cache may be shared by. Only read-only checkpoints and
+* standalone files with a known parent changeset and no local txns qualify - briefcases may contain local
+* changes on top of it, even when opened read-only.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static Utf8String GetSharedCacheChangesetId(IConnectionCR connection)
+    {
+    ECDbCR db = connection.GetECDb();
+    if (!db.IsReadonly() || !db.GetDbGuid().IsValid() || !db.GetBriefcaseId().IsStandalone())
+        return "";
+
+    if (db.TableExists("dgn_Txns"))
+        {
+        Statement stmt;
+        if (BE_SQLITE_OK != stmt.Prepare(db, "SELECT 1 FROM [dgn_Txns] LIMIT 1") || BE_SQLITE_ROW == stmt.Step())
+            return "";
+        }
+
+    Utf8String changesetId;
+    if (BE_SQLITE_ROW != db.QueryBriefcaseLocalValue(changesetId, "ParentChangeSetId"))
+        return "";
+    return changesetId;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static BeFileName GetSharedCacheDbPath(BeFileNameCR directory, IConnectionCR connection, Utf8StringCR changesetId)
+    {
+    BeFileName path;
+    if (directory.IsEmpty())
+        {
+        path = BeFileName(connection.GetECDb().GetDbFileName()).GetDirectoryName();
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_TRACE, Utf8PrintfString("Cache directory not set, using iModel directory: '%s'", path.GetNameUtf8().c_str()));
+        }
+    else
+        {
+        DIAGNOSTICS_ASSERT_SOFT(DiagnosticsCategory::HierarchiesCache, directory.DoesPathExist(), Utf8PrintfString("Provided cache directory does not exist: '%s'", directory.GetNameUtf8().c_str()));
+        path = directory;
+        }
+    // key the file by iModel and changeset rather than by file name, so every copy of the iModel at the same changeset finds it
+    path.AppendToPath(BeFileName(Utf8PrintfString("%s-%s", connection.GetECDb().GetDbGuid().ToString().c_str(), changesetId.c_str())));
+    path.AppendString(NAVNODES_CACHE_DB_SUFFIX);
+    return path;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -384,7 +441,7 @@ static bool IsMemoryCache(NodesCacheType cacheType)
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult NodesCache::DbFactory::CheckCacheCompatibility(BeSQLite::Db& db, IConnectionCR connection)
+DbResult NodesCache::DbFactory::CheckCacheCompatibility(BeSQLite::Db& db, IConnectionCR connection, Utf8StringCR changesetId)
     {
     DbResult result = BE_SQLITE_OK;
     if (GetCacheVersion(db).GetMajor() != NAVNODES_CACHE_DB_VERSION_MAJOR)
@@ -394,7 +451,7 @@ DbResult NodesCache::DbFactory::CheckCacheCompatibility(BeSQLite::Db& db, IConne
         result = BE_SQLITE_ERROR_ProfileTooOld;
         DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_TRACE, "Profile too old, deleted DB file");
         }
-    else if (IsConnectionAndCacheOutOfSync(db, connection))
+    else if (IsConnectionAndCacheOutOfSync(db, connection, changesetId))
         {
         // if connection modification date does not match cached date delete cache (hierarchies may be out of sync)
         db.CloseDb();
@@ -407,7 +464,7 @@ DbResult NodesCache::DbFactory::CheckCacheCompatibility(BeSQLite::Db& db, IConne
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult NodesCache::DbFactory::CreateCacheDb(IConnectionCR connection, BeSQLite::Db& db, BeFileNameCR path, DefaultTxn txnLockType, RefCountedPtr<BusyRetry> busyHandler)
+DbResult NodesCache::DbFactory::CreateCacheDb(IConnectionCR connection, BeSQLite::Db& db, BeFileNameCR path, DefaultTxn txnLockType, RefCountedPtr<BusyRetry> busyHandler, Utf8StringCR changesetId)
     {
     DbResult result = db.CreateNewDb(path,Db::CreateParams(Db::PageSize::PAGESIZE_4K, Db::Encoding::Utf8,
         true, txnLockType, busyHandler.get()));
@@ -421,25 +478,27 @@ DbResult NodesCache::DbFactory::CreateCacheDb(IConnectionCR connection, BeSQLite
         // save the cache version
         static BeVersion s_cacheVersion(NAVNODES_CACHE_DB_VERSION_MAJOR, NAVNODES_CACHE_DB_VERSION_MINOR);
         db.SaveProperty(s_versionPropertySpec, s_cacheVersion.ToString(), nullptr, 0);
+        if (!changesetId.empty())
+            db.SaveProperty(s_connectionChangesetIdPropertySpec, changesetId, nullptr, 0);
         db.SaveChanges();
         return BE_SQLITE_OK;
         }
 
     // in case other process created hierarchy cache check if it's compatible
-    return CheckCacheCompatibility(db, connection);
+    return CheckCacheCompatibility(db, connection, changesetId);
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult NodesCache::DbFactory::OpenCacheDb(IConnectionCR connection, BeSQLite::Db& db, BeFileNameCR path, DefaultTxn txnLockType, RefCountedPtr<BusyRetry> busyHandler)
+DbResult NodesCache::DbFactory::OpenCacheDb(IConnectionCR connection, BeSQLite::Db& db, BeFileNameCR path, DefaultTxn txnLockType, RefCountedPtr<BusyRetry> busyHandler, Utf8StringCR changesetId)
     {
     DbResult result = db.OpenBeSQLiteDb(path, Db::OpenParams(Db::OpenMode::ReadWrite, txnLockType, busyHandler.get()));
     if (BE_SQLITE_OK != result)
         return result;
 
     DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_TRACE, "DB opened for read-write successfully");
-    return CheckCacheCompatibility(db, connection);
+    return CheckCacheCompatibility(db, connection, changesetId);
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -630,18 +689,21 @@ DbResult NodesCache::DbFactory::CreateTempDiskDb(Db& db, BeFileNameCR baseFileNa
     {
     BeFileName path(baseFileName);
     path.AppendUtf8(Utf8PrintfString("-%s", BeGuid(true).ToString().c_str()).c_str());
-    return CreateCacheDb(connection, db, path, DefaultTxn::Yes, InfiniteBusyRetry::Create());
+    return CreateCacheDb(connection, db, path, DefaultTxn::Yes, InfiniteBusyRetry::Create(), "");
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DbResult NodesCache::DbFactory::InitializeDiskDb(Db& db, BeFileNameCR directory, IConnectionCR connection, NodesCacheType cacheType, bool& tempCache)
+DbResult NodesCache::DbFactory::InitializeDiskDb(Db& db, BeFileNameCR directory, IConnectionCR connection, NodesCacheType cacheType, bool& tempCache, Utf8StringR changesetId)
     {
-    BeFileName path = GetCacheDbPath(directory, connection);
+    BeFileName path = changesetId.empty() ? GetCacheDbPath(directory, connection) : GetSharedCacheDbPath(directory, connection, changesetId);
 
     if (tempCache)
+        {
+        changesetId.clear();
         return CreateTempDiskDb(db, path, connection, cacheType);
+        }
 
     DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_TRACE, Utf8PrintfString("Using path '%s'", path.GetNameUtf8().c_str()));
 
@@ -654,7 +716,7 @@ DbResult NodesCache::DbFactory::InitializeDiskDb(Db& db, BeFileNameCR directory,
     if (path.DoesPathExist())
         {
         DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_TRACE, Utf8PrintfString("File exists: '%s'", path.GetNameUtf8().c_str()));
-        DbResult result = OpenCacheDb(connection, db, path, DefaultTxn::No, InfiniteBusyRetry::Create());
+        DbResult result = OpenCacheDb(connection, db, path, DefaultTxn::No, InfiniteBusyRetry::Create(), changesetId);
         if (BE_SQLITE_OK == result)
             return BE_SQLITE_OK;
 
@@ -667,12 +729,13 @@ DbResult NodesCache::DbFactory::InitializeDiskDb(Db& db, BeFileNameCR directory,
     // attempt to create new cache db
     if (createNewCache)
         {
-        DbResult result = CreateCacheDb(connection, db, path, DefaultTxn::No, InfiniteBusyRetry::Create());
+        DbResult result = CreateCacheDb(connection, db, path, DefaultTxn::No, InfiniteBusyRetry::Create(), changesetId);
         if (BE_SQLITE_OK == result)
             return BE_SQLITE_OK;
         }
 
     tempCache = true;
+    changesetId.clear();
     DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_TRACE, "Could not open or create main cache DB, switching to a temporary cache");
     return CreateTempDiskDb(db, path, connection, cacheType);
     }
@@ -711,11 +774,43 @@ DbResult NodesCache::DbFactory::OpenDiskDb(Db& db) const
     return result;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Delete caches of this iModel shared by other changesets. Caches still used by other processes are left alone.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void NodesCache::DbFactory::DeleteStaleSharedCaches(IConnectionCR connection, BeFileNameCR currentPath)
+    {
+    BeFileName pattern = currentPath.GetDirectoryName();
+    pattern.AppendToPath(BeFileName(Utf8PrintfString("%s-*", connection.GetECDb().GetDbGuid().ToString().c_str())));
+    pattern.AppendString(NAVNODES_CACHE_DB_SUFFIX);
+
+    bvector<BeFileName> stalePaths;
+    BeFileListIterator iter(pattern, false);
+    BeFileName path;
+    while (SUCCESS == iter.GetNextFileName(path))
+        {
+        if (!path.EqualsI(currentPath))
+            stalePaths.push_back(path);
+        }
+
+    for (BeFileNameCR stalePath : stalePaths)
+        {
+        // same as when closing the cache - if the db can't be opened in exclusive mode, someone is still using it
+        Db db;
+        if (BE_SQLITE_OK != db.OpenBeSQLiteDb(stalePath, Db::OpenParams(Db::OpenMode::ReadWrite, DefaultTxn::Exclusive)))
+            continue;
+        db.CloseDb();
+
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_INFO, Utf8PrintfString("Deleting stale shared cache: '%s'", stalePath.GetNameUtf8().c_str()));
+        stalePath.BeDeleteFile();
+        }
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 std::shared_ptr<NodesCache::DbFactory> NodesCache::DbFactory::Create(IConnectionCR connection, BeFileNameCR directory, NodesCacheType cacheType,
-    uint64_t sizeLimit, Nullable<uint64_t> const& memoryCacheLimit)
+    uint64_t sizeLimit, Nullable<uint64_t> const& memoryCacheLimit, bool shareByChangeset)
     {
     auto scope = Diagnostics::Scope::Create("Initialize hierarchy cache");
     DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_INFO, Utf8PrintfString("Directory: '%s', Connection: '%s', CacheType: '%s'",
@@ -735,8 +830,12 @@ std::shared_ptr<NodesCache::DbFactory> NodesCache::DbFactory::Create(IConnection
     if (IsMemoryCache(cacheType))
         return std::make_shared<DbFactory>(connection, nullptr, sizeLimit, memoryCacheLimit);
 
+    Utf8String changesetId = shareByChangeset ? GetSharedCacheChangesetId(connection) : "";
+    if (!changesetId.empty())
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_INFO, Utf8PrintfString("Sharing cache by changeset '%s'", changesetId.c_str()));
+
     Db db;
-    DbResult result = InitializeDiskDb(db, directory, connection, cacheType, tempCache);
+    DbResult result = InitializeDiskDb(db, directory, connection, cacheType, tempCache, changesetId);
     if (result != DbResult::BE_SQLITE_OK)
         {
         DIAGNOSTICS_HANDLE_FAILURE(DiagnosticsCategory::HierarchiesCache, Utf8PrintfString("Failed to initialize nodes cache. Directory: '%s', "
@@ -749,7 +848,9 @@ std::shared_ptr<NodesCache::DbFactory> NodesCache::DbFactory::Create(IConnection
         DIAGNOSTICS_HANDLE_FAILURE(DiagnosticsCategory::HierarchiesCache, Utf8PrintfString("Failed to initialize nodes cache tables."));
 
     db.SaveChanges();
-    return std::make_shared<DbFactory>(connection, db.GetDbFileName(), sizeLimit, memoryCacheLimit, tempCache);
+    if (!changesetId.empty())
+        DeleteStaleSharedCaches(connection, BeFileName(db.GetDbFileName()));
+    return std::make_shared<DbFactory>(connection, db.GetDbFileName(), sizeLimit, memoryCacheLimit, tempCache, changesetId);
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -775,7 +876,9 @@ NodesCache::DbFactory::~DbFactory()
     if (BE_SQLITE_OK != openResult)
         return;
 
-    db.SaveProperty(s_connectionLastModTimePropertySpec, std::to_string(GetConnectionLastModTime(m_connection)), nullptr, 0);
+    // caches shared by changeset are validated by changeset id, so modification time of this particular copy of the iModel doesn't matter
+    if (m_changesetId.empty())
+        db.SaveProperty(s_connectionLastModTimePropertySpec, std::to_string(GetConnectionLastModTime(m_connection)), nullptr, 0);
     db.GetDefaultTransaction()->Commit();
     NodesCacheHelpers::LimitCacheSize(db, m_sizeLimit, false);
     }
@@ -792,6 +895,38 @@ DbResult NodesCache::DbFactory::CreateDbConnection(Db& db) const
     return OpenDiskDb(db);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+std::shared_ptr<NodesCache::DbFactory> NodesCache::DbFactory::CreatePrivateCopy() const
+    {
+    if (!IsSharedByChangeset())
+        return nullptr;
+
+    BeFileName copyPath(m_cachePath);
+    copyPath.AppendUtf8(Utf8PrintfString("-%s", BeGuid(true).ToString().c_str()).c_str());
+    DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_INFO, Utf8PrintfString("Copying shared cache to '%s'", copyPath.GetNameUtf8().c_str()));
+
+    Db db;
+    auto busyRetry = InfiniteBusyRetry::Create();
+    if (BE_SQLITE_OK != db.OpenBeSQLiteDb(m_cachePath.c_str(), Db::OpenParams(Db::OpenMode::Readonly, DefaultTxn::No, busyRetry.get())))
+        return nullptr;
+
+    // VACUUM INTO takes a consistent snapshot without blocking other processes that use the shared cache
+    Statement stmt;
+    if (BE_SQLITE_OK != stmt.Prepare(db, "VACUUM INTO ?"))
+        return nullptr;
+    stmt.BindText(1, copyPath.GetNameUtf8(), Statement::MakeCopy::Yes);
+    if (BE_SQLITE_DONE != stmt.Step())
+        {
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_ERROR, Utf8PrintfString("Failed to copy shared cache: '%s'", db.GetLastError().c_str()));
+        copyPath.BeDeleteFile();
+        return nullptr;
+        }
+
+    return std::make_shared<DbFactory>(m_connection, copyPath.GetNameUtf8().c_str(), m_sizeLimit, m_memoryCacheLimit, true);
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -814,9 +949,9 @@ std::shared_ptr<NodesCache> NodesCache::Create(std::shared_ptr<DbFactory> initia
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 std::shared_ptr<NodesCache> NodesCache::Create(IConnectionCR connection, BeFileNameCR directory, NavNodesFactoryCR nodesFactory, INodesProviderContextFactoryCR contextFactory,
-    INodesProviderFactoryCR providersFactory, NodesCacheType type, bool ensureThreadSafety)
+    INodesProviderFactoryCR providersFactory, NodesCacheType type, bool ensureThreadSafety, bool shareByChangeset)
     {
-    auto dbFactory = DbFactory::Create(connection, directory, type, 0, nullptr);
+    auto dbFactory = DbFactory::Create(connection, directory, type, 0, nullptr, shareByChangeset);
     return Create(dbFactory, nodesFactory, contextFactory, providersFactory, ensureThreadSafety);
     }
 
@@ -851,7 +986,7 @@ BentleyStatus NodesCache::OpenCache()
 NodesCache::NodesCache(std::shared_ptr<DbFactory> dbFactory, NavNodesFactoryCR nodesFactory, INodesProviderContextFactoryCR contextFactory,
     INodesProviderFactoryCR providersFactory, bool ensureThreadSafety)
     : m_dbFactory(dbFactory), m_nodesFactory(nodesFactory), m_contextFactory(contextFactory), m_providersFactory(providersFactory),
-    m_statements(50), m_ensureThreadSafety(ensureThreadSafety)
+    m_ensureThreadSafety(ensureThreadSafety), m_isQueryOnly(false), m_statements(50)
     {
     }
 
@@ -871,7 +1006,8 @@ NodesCache::~NodesCache()
 #define LOCK_MUTEX_ON_CONDITION(mutex, condition) \
     BeMutexHolder lock(mutex, BeMutexHolder::Lock::No); \
     if (condition) \
-        lock.lock();
+        lock.lock(); \
+    PrepareForWrite();
 
 /*=================================================================================**//**
 * @bsiclass
@@ -881,22 +1017,54 @@ struct SavePointWithMutexHolder
     private:
         BeMutexHolder m_mutexHolder;
         WalSavepoint m_savepoint;
+        NodesCache const& m_cache;
 
     public:
-        SavePointWithMutexHolder(BeMutex& mutex, bool lockMutex, Db& db, Utf8CP name, BeSQLiteTxnMode txnMode)
-            : m_mutexHolder(mutex, BeMutexHolder::Lock::No), m_savepoint(db, name, txnMode, false)
+        SavePointWithMutexHolder(BeMutex& mutex, bool lockMutex, NodesCache const& cache, Db& db, Utf8CP name, BeSQLiteTxnMode txnMode)
+            : m_mutexHolder(mutex, BeMutexHolder::Lock::No), m_savepoint(db, name, txnMode, false), m_cache(cache)
             {
             if (lockMutex)
                 m_mutexHolder.lock();
 
-            m_savepoint.Begin();
+            if (m_cache.PrepareForWrite())
+                m_savepoint.Begin();
             }
-        ~SavePointWithMutexHolder() {m_savepoint.Commit();}
+        ~SavePointWithMutexHolder() {Commit();}
         void Cancel() {m_savepoint.Cancel();}
         bool IsActive() const {return m_savepoint.IsActive();}
-        DbResult Commit() {return m_savepoint.Commit();}
+        DbResult Commit()
+            {
+            if (!m_savepoint.IsActive())
+                return BE_SQLITE_OK;
+
+            // the cache got detached while this transaction was running - what it wrote may be based on changes
+            // the shared cache must not see
+            if (m_cache.IsDetached())
+                return m_savepoint.Cancel();
+
+            return m_savepoint.Commit();
+            }
     };
 
+/*---------------------------------------------------------------------------------**//**
+* Once the factory is detached, the cache file is no longer ours to write to. Transactions in progress are
+* cancelled instead of committed, and the connection is switched to read-only as soon as none is running.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool NodesCache::PrepareForWrite() const
+    {
+    if (m_isQueryOnly)
+        return false;
+
+    if (!m_dbFactory->IsDetached() || m_db.IsTransactionActive())
+        return true;
+
+    m_db.TryExecuteSql("PRAGMA query_only=1");
+    m_isQueryOnly = true;
+    DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::HierarchiesCache, LOG_INFO, "Cache detached, stopped writing to it");
+    return false;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -912,7 +1080,7 @@ void NodesCache::Optimize()
 +---------------+---------------+---------------+---------------+---------------+------*/
 void NodesCache::_OnRulesetUsed(PresentationRuleSetCR ruleset)
     {
-    SavePointWithMutexHolder savepoint(m_mutex, m_ensureThreadSafety, m_db, "OnRulesetUsed", BeSQLiteTxnMode::Immediate);
+    SavePointWithMutexHolder savepoint(m_mutex, m_ensureThreadSafety, *this, m_db, "OnRulesetUsed", BeSQLiteTxnMode::Immediate);
 
     static Utf8CP query = "SELECT [Id], [Hash] FROM [" NODESCACHE_TABLENAME_Rulesets "] WHERE [Identifier] = ?";
     CachedStatementPtr stmt;
@@ -963,7 +1131,8 @@ void NodesCache::_OnRulesetUsed(PresentationRuleSetCR ruleset)
     stmt = nullptr;
     savepoint.Commit();
 
-    NodesCacheHelpers::LimitCacheSize(m_db, m_dbFactory->GetSizeLimit());
+    if (!IsDetached())
+        NodesCacheHelpers::LimitCacheSize(m_db, m_dbFactory->GetSizeLimit());
 
 #ifdef NAVNODES_CACHE_DEBUG
     Persist();
@@ -993,9 +1162,9 @@ struct NodesCache::Savepoint : IHierarchyCache::Savepoint
             }
     public:
         Savepoint(NodesCache& cache, bool lockMutex, BeSQLiteTxnMode txnMode, bool optimize)
-            : m_sqliteSavepoint(cache.GetMutex(), lockMutex, cache.m_db, BeGuid(true).ToString().c_str(), txnMode), m_cache(cache), m_isCancelled(false), m_optimize(optimize)
+            : m_sqliteSavepoint(cache.GetMutex(), lockMutex, cache, cache.m_db, BeGuid(true).ToString().c_str(), txnMode), m_cache(cache), m_isCancelled(false), m_optimize(optimize)
             {
-            DIAGNOSTICS_ASSERT_SOFT(DiagnosticsCategory::HierarchiesCache, m_sqliteSavepoint.IsActive(), "Failed to start transaction");
+            DIAGNOSTICS_ASSERT_SOFT(DiagnosticsCategory::HierarchiesCache, m_sqliteSavepoint.IsActive() || cache.IsDetached(), "Failed to start transaction");
             }
         ~Savepoint()
             {
@@ -1045,7 +1214,7 @@ std::shared_ptr<IHierarchyLevelLocker> NodesCache::_CreateHierarchyLevelLocker(C
 +---------------+---------------+---------------+---------------+---------------+------*/
 void NodesCache::RemoveHierarchyLevelLock(BeGuidCR hierarchyLevelId)
     {
-    SavePointWithMutexHolder savepoint(m_mutex, m_ensureThreadSafety, m_db, "RemoveHierarchyLevelLock", BeSQLiteTxnMode::Immediate);
+    SavePointWithMutexHolder savepoint(m_mutex, m_ensureThreadSafety, *this, m_db, "RemoveHierarchyLevelLock", BeSQLiteTxnMode::Immediate);
 
     static Utf8CP query =
         " UPDATE [" NODESCACHE_TABLENAME_HierarchyLevels "] "
@@ -1512,7 +1681,7 @@ BeGuid NodesCache::CacheHierarchyLevel(BeGuidCR parentNodeId, Utf8StringCR rules
 +---------------+---------------+---------------+---------------+---------------+------*/
 BeGuid NodesCache::CacheOrGetPhysicalHierarchyLevel(CombinedHierarchyLevelIdentifier const& identifier)
     {
-    SavePointWithMutexHolder savepoint(m_mutex, m_ensureThreadSafety, m_db, "CacheOrGetPhysicalHierarchyLevel", BeSQLiteTxnMode::Immediate);
+    SavePointWithMutexHolder savepoint(m_mutex, m_ensureThreadSafety, *this, m_db, "CacheOrGetPhysicalHierarchyLevel", BeSQLiteTxnMode::Immediate);
 
     BeGuid levelId = FindPhysicalHierarchyLevelId(identifier);
     if (levelId.IsValid())
@@ -2271,7 +2440,7 @@ void NodesCache::_Update(DataSourceInfo const& info, int partsToUpdate)
         return;
         }
 
-    SavePointWithMutexHolder savepoint(m_mutex, m_ensureThreadSafety, m_db, "UpdateDataSource", BeSQLiteTxnMode::Immediate);
+    SavePointWithMutexHolder savepoint(m_mutex, m_ensureThreadSafety, *this, m_db, "UpdateDataSource", BeSQLiteTxnMode::Immediate);
 
     if (0 != ((DataSourceInfo::PARTS_All & ~DataSourceInfo::PART_RelatedClasses) & partsToUpdate))
         {
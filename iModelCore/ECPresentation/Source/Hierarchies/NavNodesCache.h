@@ -225,30 +225,47 @@ struct NodesCache : INavNodesCache
             uint64_t m_sizeLimit;
             Nullable<uint64_t> m_memoryCacheLimit;
             Utf8String m_cachePath;
+            Utf8String m_changesetId;
             bool m_deleteDb;
+            std::atomic<bool> m_isDetached;
             BeMutex m_mutex;
 
         private:
-            static DbResult CheckCacheCompatibility(BeSQLite::Db& db, IConnectionCR connection);
-            static DbResult CreateCacheDb(IConnectionCR connection, BeSQLite::Db& db, BeFileNameCR path, DefaultTxn txnLockType, RefCountedPtr<BusyRetry> busyHandler);
-            static DbResult OpenCacheDb(IConnectionCR connection, BeSQLite::Db& db, BeFileNameCR path, DefaultTxn txnLockType, RefCountedPtr<BusyRetry> busyHandler);
+            static DbResult CheckCacheCompatibility(BeSQLite::Db& db, IConnectionCR connection, Utf8StringCR changesetId);
+            static DbResult CreateCacheDb(IConnectionCR connection, BeSQLite::Db& db, BeFileNameCR path, DefaultTxn txnLockType, RefCountedPtr<BusyRetry> busyHandler, Utf8StringCR changesetId);
+            static DbResult OpenCacheDb(IConnectionCR connection, BeSQLite::Db& db, BeFileNameCR path, DefaultTxn txnLockType, RefCountedPtr<BusyRetry> busyHandler, Utf8StringCR changesetId);
             static DbResult CreateTempDiskDb(Db& db, BeFileNameCR baseFileName, IConnectionCR connection, NodesCacheType cacheType);
-            static DbResult InitializeDiskDb(Db& db, BeFileNameCR directory, IConnectionCR connection, NodesCacheType cacheType, bool& tempCache);
+            static DbResult InitializeDiskDb(Db& db, BeFileNameCR directory, IConnectionCR connection, NodesCacheType cacheType, bool& tempCache, Utf8StringR changesetId);
             static void SetupDbConnection(Db& db, NodesCacheType type, Nullable<uint64_t> const& memoryCacheLimit);
             static BentleyStatus InitializeCacheTables(Db& db);
+            static void DeleteStaleSharedCaches(IConnectionCR connection, BeFileNameCR currentPath);
             DbResult OpenMemoryDb(Db& db) const;
             DbResult OpenDiskDb(Db& db) const;
 
         public:
-            DbFactory(IConnectionCR connection, Utf8CP path, uint64_t sizeLimit, Nullable<uint64_t> memoryCacheLimit, bool deleteDb = false)
-                : m_connection(connection), m_cachePath(path), m_sizeLimit(sizeLimit), m_memoryCacheLimit(memoryCacheLimit), m_deleteDb(deleteDb)
+            DbFactory(IConnectionCR connection, Utf8CP path, uint64_t sizeLimit, Nullable<uint64_t> memoryCacheLimit, bool deleteDb = false, Utf8String changesetId = "")
+                : m_connection(connection), m_sizeLimit(sizeLimit), m_memoryCacheLimit(memoryCacheLimit), m_cachePath(path), m_changesetId(changesetId), m_deleteDb(deleteDb), m_isDetached(false)
                 {}
             ~DbFactory();
-            ECPRESENTATION_EXPORT static std::shared_ptr<DbFactory> Create(IConnectionCR, BeFileNameCR, NodesCacheType, uint64_t, Nullable<uint64_t> const& memoryCacheLimit);
+            //! Create a factory for the given connection's cache. When `shareByChangeset` is set and the connection is a read-only
+            //! connection to an iModel with a known parent changeset, the cache file is keyed by iModel id and changeset id, so it
+            //! outlives the session and is shared with other processes using the same cache directory.
+            ECPRESENTATION_EXPORT static std::shared_ptr<DbFactory> Create(IConnectionCR, BeFileNameCR, NodesCacheType, uint64_t, Nullable<uint64_t> const& memoryCacheLimit,
+                bool shareByChangeset = false);
             ECPRESENTATION_EXPORT DbResult CreateDbConnection(Db& db) const;
+            //! Copy the shared cache into a private temporary cache, which is deleted when the factory is destroyed. Returns nullptr
+            //! if this cache is not shared or copying fails.
+            ECPRESENTATION_EXPORT std::shared_ptr<DbFactory> CreatePrivateCopy() const;
 
             IConnectionCR GetConnection() const {return m_connection;}
             Utf8StringCR GetCachePath() const {return m_cachePath;}
+            //! Id of the changeset the cache is keyed by. Empty if the cache is not shared by changeset.
+            Utf8StringCR GetChangesetId() const {return m_changesetId;}
+            bool IsSharedByChangeset() const {return !m_changesetId.empty();}
+            //! Stop caches created by this factory from persisting anything to the cache file. Used when the connection
+            //! stops matching the changeset the cache is shared by, while some caches may still be in use.
+            void Detach() {m_isDetached.store(true);}
+            bool IsDetached() const {return m_isDetached.load();}
             uint64_t GetSizeLimit() const {return m_sizeLimit;}
             void SetSizeLimit(uint64_t limit) {BeMutexHolder lock(m_mutex); m_sizeLimit = limit;}
         };
@@ -259,6 +276,7 @@ private:
     INodesProviderContextFactoryCR m_contextFactory;
     INodesProviderFactoryCR m_providersFactory;
     bool m_ensureThreadSafety;
+    mutable bool m_isQueryOnly;
     mutable BeSQLite::Db m_db;
     mutable BeSQLite::StatementCache m_statements;
     mutable bvector<bpair<BeGuid, NavNodePtr>> m_quickNodesCache;
@@ -338,7 +356,7 @@ public:
     ECPRESENTATION_EXPORT static std::shared_ptr<NodesCache> Create(std::shared_ptr<DbFactory>, NavNodesFactoryCR, INodesProviderContextFactoryCR,
         INodesProviderFactoryCR, bool ensureThreadSafety = true);
     ECPRESENTATION_EXPORT static std::shared_ptr<NodesCache> Create(IConnectionCR, BeFileNameCR, NavNodesFactoryCR, INodesProviderContextFactoryCR,
-        INodesProviderFactoryCR, NodesCacheType type, bool ensureThreadSafety = true);
+        INodesProviderFactoryCR, NodesCacheType type, bool ensureThreadSafety = true, bool shareByChangeset = false);
     ECPRESENTATION_EXPORT ~NodesCache();
 
     ECPRESENTATION_EXPORT void SetRemovalId(CombinedHierarchyLevelIdentifier const&);
@@ -356,6 +374,9 @@ public:
     BeSQLite::Db const& GetDb() const {return m_db;}
     BeSQLite::Db& GetDb() {return m_db;}
     void SetCacheFileSizeLimit(uint64_t size) {m_dbFactory->SetSizeLimit(size);}
+    bool IsDetached() const {return m_dbFactory->IsDetached();}
+    //! Returns false if the cache got detached from its file and must not write to it anymore. Must be called with the cache mutex locked.
+    ECPRESENTATION_EXPORT bool PrepareForWrite() const;
 
     void RemoveQuick(std::function<bool(NavNodeCR)> const&) const;
 
@@ -372,12 +393,16 @@ protected:
     virtual std::shared_ptr<INavNodesCache> _GetCache(Utf8StringCR connectionId, BeGuidCR rootNodeId) const = 0;
     virtual std::shared_ptr<NodesCache> _GetPersistentCache(Utf8StringCR connectionId) const = 0;
     virtual void _ClearCaches(Utf8CP rulesetId) const = 0;
+    virtual bool _DetachSharedCache(IConnectionCR) const {return false;}
 
 public:
     virtual ~INodesCacheManager() {}
     std::shared_ptr<INavNodesCache> GetCache(Utf8StringCR connectionId, BeGuidCR rootNodeId = BeGuid()) const {return _GetCache(connectionId, rootNodeId);}
     std::shared_ptr<NodesCache> GetPersistentCache(Utf8StringCR connectionId) const {return _GetPersistentCache(connectionId);}
     void ClearCaches(Utf8CP rulesetId) const {_ClearCaches(rulesetId);}
+    //! Switch the connection from a cache shared with other processes to a private copy, so changes to the connection's
+    //! data don't leak into hierarchies cached for the changeset. Returns true if the cache was detached.
+    bool DetachSharedCache(IConnectionCR connection) const {return _DetachSharedCache(connection);}
 };
 
 /*=================================================================================**//**
@@ -173,13 +173,14 @@ private:
     BeFileName m_cacheDirectory;
     uint64_t m_cacheSizeLimit;
     Nullable<uint64_t> m_diskCacheMemoryCacheSize;
+    bool m_shareByChangeset;
 
     NavNodesFactoryCR m_nodeFactory;
     INodesProviderContextFactoryCR m_contextFactory;
     INodesProviderFactoryCR m_providersFactory;
     IConnectionManagerCR m_connections;
 
-    bmap<Utf8String, std::shared_ptr<NodesCache::DbFactory>> m_initializedCaches;
+    mutable bmap<Utf8String, std::shared_ptr<NodesCache::DbFactory>> m_initializedCaches;
     mutable BeMutex m_mutex;
 
 private:
@@ -205,12 +206,13 @@ protected:
     virtual std::shared_ptr<NodesCache> _FindCache(Utf8StringCR connectionId) const = 0;
     virtual void _OnConnectionOpened(IConnectionCR connection) {}
     virtual void _OnConnectionClosed(IConnectionCR connection) {}
+    virtual void _OnCacheReplaced(IConnectionCR connection) const {}
 
 protected:
     NodesCacheManager(BeFileNameCR tempDirectory, NavNodesFactoryCR nodeFactory, INodesProviderContextFactoryCR nodeProviderContextFactory, INodesProviderFactoryCR nodeProvidersFactory,
-        IConnectionManagerCR connectionManager, uint64_t cacheSizeLimit, Nullable<uint64_t> diskCacheMemoryCacheSize)
+        IConnectionManagerCR connectionManager, uint64_t cacheSizeLimit, Nullable<uint64_t> diskCacheMemoryCacheSize, bool shareByChangeset)
         : m_cacheDirectory(tempDirectory), m_nodeFactory(nodeFactory), m_contextFactory(nodeProviderContextFactory), m_connections(connectionManager),
-        m_cacheSizeLimit(cacheSizeLimit), m_providersFactory(nodeProvidersFactory), m_diskCacheMemoryCacheSize(diskCacheMemoryCacheSize)
+        m_cacheSizeLimit(cacheSizeLimit), m_providersFactory(nodeProvidersFactory), m_diskCacheMemoryCacheSize(diskCacheMemoryCacheSize), m_shareByChangeset(shareByChangeset)
         {
         m_connections.AddListener(*this);
         }
@@ -235,7 +237,7 @@ protected:
         if (event.GetEventType() == ConnectionEventType::Opened)
             {
             auto scope = Diagnostics::Scope::Create("NodesCacheManager: Connection opened");
-            auto dbFactory = NodesCache::DbFactory::Create(event.GetConnection(), m_cacheDirectory, _GetCacheType(), m_cacheSizeLimit, m_diskCacheMemoryCacheSize);
+            auto dbFactory = NodesCache::DbFactory::Create(event.GetConnection(), m_cacheDirectory, _GetCacheType(), m_cacheSizeLimit, m_diskCacheMemoryCacheSize, m_shareByChangeset);
             m_initializedCaches.Insert(event.GetConnection().GetId(), dbFactory);
             _OnConnectionOpened(event.GetConnection());
             }
@@ -263,6 +265,25 @@ protected:
         {
         IterateCaches([&](std::shared_ptr<NodesCache> cache) {cache->Clear(rulesetId);});
         }
+
+    bool _DetachSharedCache(IConnectionCR connection) const override
+        {
+        BeMutexHolder lock(m_mutex);
+        auto iter = m_initializedCaches.find(connection.GetId());
+        if (m_initializedCaches.end() == iter || !iter->second->IsSharedByChangeset())
+            return false;
+
+        auto scope = Diagnostics::Scope::Create("NodesCacheManager: Detach shared cache");
+        // keep the warm hierarchies by continuing with a private copy - if that fails, start over with a cache of our own
+        auto dbFactory = iter->second->CreatePrivateCopy();
+        if (nullptr == dbFactory)
+            dbFactory = NodesCache::DbFactory::Create(connection, m_cacheDirectory, _GetCacheType(), m_cacheSizeLimit, m_diskCacheMemoryCacheSize);
+        // caches that are still in use by requests in flight must not write to the shared file anymore
+        iter->second->Detach();
+        iter->second = dbFactory;
+        _OnCacheReplaced(connection);
+        return true;
+        }
 };
 
 /*=================================================================================**//**
@@ -302,7 +323,7 @@ protected:
 public:
     MemoryNodesCacheManager(BeFileNameCR tempDirectory, NavNodesFactoryCR nodeFactory, INodesProviderContextFactoryCR nodeProviderContextFactory, INodesProviderFactoryCR nodeProvidersFactory,
         IConnectionManagerCR connectionManager, uint64_t cacheSizeLimit)
-        : NodesCacheManager(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, nullptr)
+        : NodesCacheManager(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, nullptr, false)
         {}
 };
 
@@ -343,6 +364,14 @@ protected:
             caches->erase(connection.GetId());
         }
 
+    void _OnCacheReplaced(IConnectionCR connection) const override
+        {
+        // threads pick up the new cache the next time they ask for one
+        BeMutexHolder lock(GetMutex());
+        for (auto caches : m_allCaches)
+            caches->erase(connection.GetId());
+        }
+
     std::shared_ptr<NodesCache> _FindCache(Utf8StringCR connectionId) const override
         {
         bmap<Utf8String, std::shared_ptr<NodesCache>>& threadCaches = GetCachesForCurrentThread();
@@ -354,8 +383,8 @@ protected:
 
 public:
     DiskNodesCacheManager(BeFileNameCR tempDirectory, NavNodesFactoryCR nodeFactory, INodesProviderContextFactoryCR nodeProviderContextFactory, INodesProviderFactoryCR nodeProvidersFactory,
-        IConnectionManagerCR connectionManager, uint64_t cacheSizeLimit, Nullable<uint64_t> memoryCacheSize)
-        : NodesCacheManager(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, memoryCacheSize)
+        IConnectionManagerCR connectionManager, uint64_t cacheSizeLimit, Nullable<uint64_t> memoryCacheSize, bool shareByChangeset)
+        : NodesCacheManager(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, memoryCacheSize, shareByChangeset)
         {}
 
     ~DiskNodesCacheManager()
@@ -383,8 +412,8 @@ protected:
 
 public:
     HybridNodesCacheManager(BeFileNameCR tempDirectory, NavNodesFactoryCR nodeFactory, INodesProviderContextFactoryCR nodeProviderContextFactory, INodesProviderFactoryCR nodeProvidersFactory,
-        IConnectionManagerCR connectionManager, uint64_t cacheSizeLimit, Nullable<uint64_t> diskCacheMemoryCacheSize)
-        : DiskNodesCacheManager(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize)
+        IConnectionManagerCR connectionManager, uint64_t cacheSizeLimit, Nullable<uint64_t> diskCacheMemoryCacheSize, bool shareByChangeset)
+        : DiskNodesCacheManager(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize, shareByChangeset)
         {}
 };
 
@@ -392,17 +421,18 @@ public:
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 static std::unique_ptr<INodesCacheManager> CreateCacheManager(BeFileNameCR tempDirectory, NavNodesFactoryCR nodeFactory, INodesProviderContextFactoryCR nodeProviderContextFactory, INodesProviderFactoryCR nodeProvidersFactory,
-    IConnectionManagerCR connectionManager, RulesDrivenECPresentationManagerImpl::Params::CachingParams::Mode mode, uint64_t cacheSizeLimit, Nullable<uint64_t> diskCacheMemoryCacheSize)
+    IConnectionManagerCR connectionManager, RulesDrivenECPresentationManagerImpl::Params::CachingParams::Mode mode, uint64_t cacheSizeLimit, Nullable<uint64_t> diskCacheMemoryCacheSize,
+    bool shareByChangeset)
     {
     switch (mode)
         {
         case ECPresentationManager::Params::CachingParams::Mode::Memory:
             return std::make_unique<MemoryNodesCacheManager>(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit);
         case ECPresentationManager::Params::CachingParams::Mode::Hybrid:
-            return std::make_unique<HybridNodesCacheManager>(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize);
+            return std::make_unique<HybridNodesCacheManager>(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize, shareByChangeset);
         case ECPresentationManager::Params::CachingParams::Mode::Disk:
         default:
-            return std::make_unique<DiskNodesCacheManager>(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize);
+            return std::make_unique<DiskNodesCacheManager>(tempDirectory, nodeFactory, nodeProviderContextFactory, nodeProvidersFactory, connectionManager, cacheSizeLimit, diskCacheMemoryCacheSize, shareByChangeset);
         }
     }
 
@@ -756,7 +786,8 @@ RulesDrivenECPresentationManagerImpl::RulesDrivenECPresentationManagerImpl(Param
     m_nodesFactory = new NavNodesFactory();
 
     m_nodesCachesManager = CreateCacheManager(params.GetCachingParams().GetCacheDirectoryPath(), *m_nodesFactory, *m_nodesProviderContextFactory, *m_nodesProviderFactory,
-        *m_connections, params.GetCachingParams().GetCacheMode(), params.GetCachingParams().GetDiskCacheFileSizeLimit(), params.GetCachingParams().GetDiskCacheMemoryCacheSize());
+        *m_connections, params.GetCachingParams().GetCacheMode(), params.GetCachingParams().GetDiskCacheFileSizeLimit(), params.GetCachingParams().GetDiskCacheMemoryCacheSize(),
+        params.GetCachingParams().ShouldShareCacheByChangeset());
     m_contentCache = new ContentCache(params.GetContentCachingParams().GetPrivateCacheSize());
 
     m_updateHandler = new UpdateHandler(*m_nodesCachesManager, m_contentCache, *m_connections, *m_nodesProviderContextFactory,
@@ -433,3 +433,134 @@ void Diagnostics::AddValueToArrayAttribute(Utf8CP name, Utf8String value, bool u
         scope.AddValueToArrayAttribute(name, value, unique);
         });
     }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Diagnostics::Histogram::Histogram(Utf8String name)
+    : m_name(name), m_count(0), m_sum(0), m_max(0)
+    {
+    for (auto& bucket : m_buckets)
+        bucket.store(0);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+size_t Diagnostics::Histogram::GetBucketIndex(uint64_t value)
+    {
+    size_t index = 0;
+    while (value > 0 && index < BUCKETS_COUNT - 1)
+        {
+        value >>= 1;
+        ++index;
+        }
+    return index;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Diagnostics::Histogram::Record(uint64_t microseconds)
+    {
+    m_buckets[GetBucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(microseconds, std::memory_order_relaxed);
+    uint64_t currMax = m_max.load(std::memory_order_relaxed);
+    while (currMax < microseconds && !m_max.compare_exchange_weak(currMax, microseconds, std::memory_order_relaxed))
+        ;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Diagnostics::Histogram::Reset()
+    {
+    for (auto& bucket : m_buckets)
+        bucket.store(0);
+    m_count.store(0);
+    m_sum.store(0);
+    m_max.store(0);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+rapidjson::Document Diagnostics::Histogram::BuildJson(rapidjson::Document::AllocatorType* allocator) const
+    {
+    rapidjson::Document json(allocator);
+    json.SetObject();
+    json.AddMember("count", GetCount(), json.GetAllocator());
+    json.AddMember("sum", GetSum(), json.GetAllocator());
+    json.AddMember("max", GetMax(), json.GetAllocator());
+    rapidjson::Value bucketsJson(rapidjson::kArrayType);
+    for (size_t i = 0; i < BUCKETS_COUNT; ++i)
+        {
+        uint64_t count = GetBucketCount(i);
+        if (0 == count)
+            continue;
+
+        rapidjson::Value bucketJson(rapidjson::kObjectType);
+        bucketJson.AddMember("upperBound", (uint64_t)1 << i, json.GetAllocator());
+        bucketJson.AddMember("count", count, json.GetAllocator());
+        bucketsJson.PushBack(bucketJson, json.GetAllocator());
+        }
+    json.AddMember("buckets", bucketsJson, json.GetAllocator());
+    return json;
+    }
+
+/*=================================================================================**//**
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct HistogramsRegistry
+    {
+    BeMutex m_mutex;
+    bmap<Utf8String, std::unique_ptr<Diagnostics::Histogram>> m_histograms;
+    };
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static HistogramsRegistry& GetHistogramsRegistry()
+    {
+    // note: intentionally leaked to allow recording from threads that outlive static destruction
+    static HistogramsRegistry* s_registry = new HistogramsRegistry();
+    return *s_registry;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Diagnostics::Histogram& Diagnostics::GetHistogram(Utf8CP name)
+    {
+    HistogramsRegistry& registry = GetHistogramsRegistry();
+    BeMutexHolder lock(registry.m_mutex);
+    auto iter = registry.m_histograms.find(name);
+    if (registry.m_histograms.end() == iter)
+        iter = registry.m_histograms.insert(std::make_pair(Utf8String(name), std::make_unique<Histogram>(name))).first;
+    return *iter->second;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+rapidjson::Document Diagnostics::GetHistogramsJson(rapidjson::Document::AllocatorType* allocator)
+    {
+    HistogramsRegistry& registry = GetHistogramsRegistry();
+    BeMutexHolder lock(registry.m_mutex);
+    rapidjson::Document json(allocator);
+    json.SetObject();
+    for (auto const& entry : registry.m_histograms)
+        json.AddMember(rapidjson::Value(entry.first.c_str(), json.GetAllocator()), entry.second->BuildJson(&json.GetAllocator()), json.GetAllocator());
+    return json;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Diagnostics::ResetHistograms()
+    {
+    HistogramsRegistry& registry = GetHistogramsRegistry();
+    BeMutexHolder lock(registry.m_mutex);
+    for (auto& entry : registry.m_histograms)
+        entry.second->Reset();
+    }
@@ -989,21 +989,21 @@ bool ECExpressionsHelper::EvaluateECExpression(ECValueR result, Utf8StringCR exp
     {
     auto scope = Diagnostics::Scope::Create("EvaluateECExpression");
 
-    NodePtr node = GetNodeFromExpression(expression.c_str());
-    if (node.IsNull())
+    CompiledExpressionPtr compiledExpression = GetCompiledExpression(expression.c_str());
+    if (compiledExpression.IsNull())
         {
         DIAGNOSTICS_LOG(DiagnosticsCategory::ECExpressions, LOG_INFO, LOG_ERROR, Utf8PrintfString("Failed to parse ECExpression: %s", expression.c_str()));
         return false;
         }
 
-    ValueResultPtr valueResult;
-    if (ExpressionStatus::Success != node->GetValue(valueResult, context))
+    EvaluationResult evalResult;
+    if (ExpressionStatus::Success != compiledExpression->GetValue(evalResult, context))
         {
         DIAGNOSTICS_LOG(DiagnosticsCategory::ECExpressions, LOG_INFO, LOG_ERROR, Utf8PrintfString("Failed to evaluate ECExpression: %s", expression.c_str()));
         return false;
         }
 
-    if (ExpressionStatus::Success != valueResult->GetECValue(result))
+    if (ExpressionStatus::Success != evalResult.GetECValue(result))
         {
         DIAGNOSTICS_HANDLE_FAILURE(DiagnosticsCategory::ECExpressions, "Could not get ECValue from value result");
         return false;
@@ -2532,6 +2532,24 @@ NodePtr ECExpressionsHelper::GetNodeFromExpression(Utf8CP expr)
     return node;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+CompiledExpressionPtr ECExpressionsHelper::GetCompiledExpression(Utf8CP expr)
+    {
+    CompiledExpressionPtr compiledExpression;
+    if (SUCCESS == m_cache.Get(compiledExpression, expr))
+        return compiledExpression;
+
+    NodePtr node = GetNodeFromExpression(expr);
+    if (node.IsNull())
+        return nullptr;
+
+    compiledExpression = CompiledExpression::Create(*node);
+    m_cache.Add(expr, compiledExpression);
+    return compiledExpression;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -2558,6 +2576,19 @@ BentleyStatus ECExpressionsCache::Get(OptimizedExpressionPtr& optimizedExpr, Utf
     return SUCCESS;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BentleyStatus ECExpressionsCache::Get(CompiledExpressionPtr& compiledExpr, Utf8CP expression) const
+    {
+    BeMutexHolder lock(m_mutex);
+    auto iter = m_compiledCache.find(expression);
+    if (m_compiledCache.end() == iter)
+        return ERROR;
+    compiledExpr = iter->second;
+    return SUCCESS;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -2597,6 +2628,15 @@ void ECExpressionsCache::Add(Utf8CP expression, OptimizedExpressionPtr node)
     m_optimizedCache.Insert(expression, node);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ECExpressionsCache::Add(Utf8CP expression, CompiledExpressionPtr compiledExpr)
+    {
+    BeMutexHolder lock(m_mutex);
+    m_compiledCache.Insert(expression, compiledExpr);
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -2614,4 +2654,5 @@ void ECExpressionsCache::Clear()
     BeMutexHolder lock(m_mutex);
     m_cache.clear();
     m_optimizedCache.clear();
+    m_compiledCache.clear();
     }
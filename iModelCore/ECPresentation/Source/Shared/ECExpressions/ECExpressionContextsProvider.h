@@ -145,6 +145,7 @@ struct ECExpressionsCache
 private:
     bmap<Utf8String, NodePtr> m_cache;
     bmap<Utf8String, OptimizedExpressionPtr> m_optimizedCache;
+    bmap<Utf8String, CompiledExpressionPtr> m_compiledCache;
     bmap<Utf8String, bvector<Utf8String>> m_usedClasses;
     mutable BeMutex m_mutex;
 
@@ -152,10 +153,12 @@ public:
     ECExpressionsCache() {}
     ECPRESENTATION_EXPORT BentleyStatus Get(NodePtr&, Utf8CP expression) const;
     ECPRESENTATION_EXPORT BentleyStatus Get(OptimizedExpressionPtr&, Utf8CP expression) const;
+    ECPRESENTATION_EXPORT BentleyStatus Get(CompiledExpressionPtr&, Utf8CP expression) const;
     bvector<Utf8String> const* GetUsedClasses(Utf8CP expression) const;
     bool HasOptimizedExpression(Utf8CP expression) const;
     void Add(Utf8CP expression, NodePtr);
     void Add(Utf8CP expression, OptimizedExpressionPtr);
+    void Add(Utf8CP expression, CompiledExpressionPtr);
     bvector<Utf8String> const& Add(Utf8CP expression, bvector<Utf8String>&);
     void Clear();
     BeMutex& GetMutex() const {return m_mutex;}
@@ -184,6 +187,7 @@ public:
     ECExpressionsHelper(ECExpressionsCache& cache) : m_cache(cache) {}
     bool EvaluateECExpression(ECValueR result, Utf8StringCR expression, ExpressionContextR context);
     ECPRESENTATION_EXPORT NodePtr GetNodeFromExpression(Utf8CP expression);
+    ECPRESENTATION_EXPORT CompiledExpressionPtr GetCompiledExpression(Utf8CP expression);
     ECPRESENTATION_EXPORT QueryClauseAndBindings ConvertToECSql(Utf8StringCR expression, IPresentationQueryFieldTypesProvider const*, ExpressionContext*);
     ECPRESENTATION_EXPORT bvector<Utf8String> GetUsedClasses(Utf8StringCR expression);
 };
@@ -317,18 +317,20 @@ bool RulesPreprocessor::VerifyCondition(Utf8CP condition, ECExpressionsCache& ex
             return optimizedExp->Value(*optimizedParams);
         }
 
-    NodePtr node = ECExpressionsHelper(expressionsCache).GetNodeFromExpression(condition);
+    CompiledExpressionPtr compiledExpression = ECExpressionsHelper(expressionsCache).GetCompiledExpression(condition);
+    if (compiledExpression.IsNull())
+        return false;
 
-    ValueResultPtr valueResult;
+    EvaluationResult evalResult;
     ExpressionContextPtr context = contextPreparer();
-    if (ExpressionStatus::Success != node->GetValue(valueResult, *context))
+    if (ExpressionStatus::Success != compiledExpression->GetValue(evalResult, *context))
         {
         DIAGNOSTICS_LOG(DiagnosticsCategory::ECExpressions, LOG_INFO, LOG_ERROR, Utf8PrintfString("Failed to evaluate ECExpression: %s", condition));
         return false;
         }
 
     ECValue value;
-    if (ExpressionStatus::Success != valueResult->GetECValue(value))
+    if (ExpressionStatus::Success != evalResult.GetECValue(value))
         return false;
 
     return value.IsBoolean() && value.GetBoolean();
@@ -204,6 +204,75 @@ IECPresentationTask::Predicate ECPresentationTasksScheduler::CreateTasksFilter(T
         };
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Note: Must be called within a mutex
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ECPresentationTasksScheduler::AddRunningTask(IECPresentationTaskR task)
+    {
+    m_runningTasks.insert(&task);
+    for (auto const& dependency : task.GetDependencies())
+        {
+        Utf8String key = dependency->GetIndexKey();
+        if (!key.empty())
+            m_runningTasksIndex[key].insert(&task);
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Note: Must be called within a mutex
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void ECPresentationTasksScheduler::RemoveRunningTask(IECPresentationTaskPtr const& task)
+    {
+    m_runningTasks.erase(task);
+    for (auto const& dependency : task->GetDependencies())
+        {
+        auto indexIter = m_runningTasksIndex.find(dependency->GetIndexKey());
+        if (m_runningTasksIndex.end() == indexIter)
+            continue;
+        indexIter->second.erase(task.get());
+        if (indexIter->second.empty())
+            m_runningTasksIndex.erase(indexIter);
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Tests the task's other tasks blocking predicate against the running tasks. When the task
+* says which dependency the tasks it blocks have, only the running tasks indexed under that
+* dependency's lookup keys are tested.
+* Note: Must be called within a mutex
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool ECPresentationTasksScheduler::IsBlockingRunningTasks(IECPresentationTaskCR task) const
+    {
+    auto const& isBlockingOtherTasksPredicate = task.GetOtherTasksBlockingPredicate();
+    if (!isBlockingOtherTasksPredicate)
+        return false;
+
+    auto isBlocking = [&](IECPresentationTaskCR runningTask)
+        {
+        if (!isBlockingOtherTasksPredicate(runningTask))
+            return false;
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Task `%s` can't be executed - it's blocking an already running task `%s`",
+            task.GetId().ToString().c_str(), runningTask.GetId().ToString().c_str()));
+        return true;
+        };
+
+    ITaskDependency const* blockedDependency = task.GetOtherTasksBlockingDependency();
+    bvector<Utf8String> keys = blockedDependency ? blockedDependency->GetLookupKeys() : bvector<Utf8String>();
+    if (keys.empty())
+        return std::any_of(m_runningTasks.begin(), m_runningTasks.end(), [&](IECPresentationTaskPtr const& runningTask){return isBlocking(*runningTask);});
+
+    for (Utf8StringCR key : keys)
+        {
+        auto indexIter = m_runningTasksIndex.find(key);
+        if (m_runningTasksIndex.end() != indexIter && std::any_of(indexIter->second.begin(), indexIter->second.end(), [&](IECPresentationTask const* runningTask){return isBlocking(*runningTask);}))
+            return true;
+        }
+    return false;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * Note: Must be called within a mutex
 * @bsimethod
@@ -219,21 +288,9 @@ bool ECPresentationTasksScheduler::CanExecute(IECPresentationTaskCR task) const
             }
         }
 
-    // check if this task might block other task
-    auto const& isBlockingOtherTasksPredicate = task.GetOtherTasksBlockingPredicate();
-    if (isBlockingOtherTasksPredicate)
-        {
-        for (IECPresentationTaskPtr const& runningTask : m_runningTasks)
-            {
-            // we can't execute a task that wants to block an already running one
-            if (isBlockingOtherTasksPredicate(*runningTask))
-                {
-                DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Task `%s` can't be executed - it's blocking an already running task `%s`",
-                    task.GetId().ToString().c_str(), runningTask->GetId().ToString().c_str()));
-                return false;
-                }
-            }
-        }
+    // we can't execute a task that wants to block an already running one
+    if (IsBlockingRunningTasks(task))
+        return false;
 
     // check if this task is blocked by something
     if (task.IsBlocked())
@@ -249,7 +306,7 @@ bool ECPresentationTasksScheduler::CanExecute(IECPresentationTaskCR task) const
 * Note: Must be called within a mutex
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-IECPresentationTaskPtr ECPresentationTasksScheduler::PopTask(IECPresentationTask::Predicate const& filter, TThreadAllocationsMap& availableThreadAllocationsMap)
+IECPresentationTaskPtr ECPresentationTasksScheduler::PopTask(IECPresentationTask::Predicate const& filter, TThreadAllocationsMap& availableThreadAllocationsMap, IECPresentationTasksQueue::PopCursor& cursor)
     {
     auto scope = Diagnostics::Scope::Create("Tasks scheduler: pop task");
 
@@ -267,7 +324,13 @@ IECPresentationTaskPtr ECPresentationTasksScheduler::PopTask(IECPresentationTask
         }
     // note: we don't need to update the allocations map if we return a task from
     // the pending tasks list - it's already been accounted for when it got into that list
-    IECPresentationTaskPtr result = m_queue->Pop(filter);
+    // note: priority filter lets the queue skip whole priority buckets that have no idle threads, and the
+    // cursor lets it skip tasks that were already rejected by `filter` during this pass
+    IECPresentationTaskPtr result = m_queue->Pop([&availableThreadAllocationsMap](int priority)
+        {
+        auto slot = ThreadsHelper::FindAllocationSlot(availableThreadAllocationsMap, priority);
+        return slot != availableThreadAllocationsMap.end() && slot->second > 0;
+        }, filter, &cursor);
     if (result.IsValid())
         {
         auto slot = ThreadsHelper::FindAllocationSlot(availableThreadAllocationsMap, result->GetPriority());
@@ -278,14 +341,36 @@ IECPresentationTaskPtr ECPresentationTasksScheduler::PopTask(IECPresentationTask
     return result;
     }
 
+/*=================================================================================**//**
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct EnsureTaskCleanup
+    {
+    std::function<void()> m_cleanupFunc;
+    EnsureTaskCleanup(std::function<void()> cleanupFunc) : m_cleanupFunc(cleanupFunc) {}
+    ~EnsureTaskCleanup() {if (m_cleanupFunc) m_cleanupFunc();}
+    void DoCleanup()
+        {
+        if (m_cleanupFunc) m_cleanupFunc();
+        m_cleanupFunc = nullptr;
+        }
+    };
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 void ECPresentationTasksScheduler::CheckTasks()
     {
     auto scope = Diagnostics::Scope::Create("Tasks scheduler: check tasks");
+    static Diagnostics::Histogram& s_checkDurationHistogram = Diagnostics::GetHistogram(DIAGNOSTICS_HISTOGRAM_TasksSchedulerCheck);
+    auto start = std::chrono::steady_clock::now();
 
     BeMutexHolder lock(GetMutex());
+    EnsureTaskCleanup recordDuration([start]()
+        {
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        s_checkDurationHistogram.Record((uint64_t)duration.count());
+        });
     if (m_runningTasks.size() >= m_threadsCount)
         {
         DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Can't execute any tasks - all threads are busy. Running tasks: %" PRIu64, (uint64_t)m_runningTasks.size()));
@@ -295,9 +380,12 @@ void ECPresentationTasksScheduler::CheckTasks()
     auto tasksToRun = m_threadsCount - m_runningTasks.size();
     auto availableAllocationsMap = CreateAvailableAllocationsMap();
     auto filter = CreateTasksFilter(availableAllocationsMap);
+    // note: `filter` captures the blocking state at the start of this pass, so a task it rejects stays
+    // rejected until the pass ends - the cursor makes sure such tasks are tested only once per pass
+    IECPresentationTasksQueue::PopCursor cursor;
     while (tasksToRun--)
         {
-        IECPresentationTaskPtr task = PopTask(filter, availableAllocationsMap);
+        IECPresentationTaskPtr task = PopTask(filter, availableAllocationsMap, cursor);
         if (task.IsNull())
             {
             // scheduler has no more tasks available to run
@@ -330,21 +418,6 @@ void ECPresentationTasksScheduler::CheckTasks()
         }
     }
 
-/*=================================================================================**//**
-* @bsiclass
-+===============+===============+===============+===============+===============+======*/
-struct EnsureTaskCleanup
-    {
-    std::function<void()> m_cleanupFunc;
-    EnsureTaskCleanup(std::function<void()> cleanupFunc) : m_cleanupFunc(cleanupFunc) {}
-    ~EnsureTaskCleanup() {if (m_cleanupFunc) m_cleanupFunc();}
-    void DoCleanup()
-        {
-        if (m_cleanupFunc) m_cleanupFunc();
-        m_cleanupFunc = nullptr;
-        }
-    };
-
 /*=================================================================================**//**
 * @bsiclass
 +===============+===============+===============+===============+===============+======*/
@@ -372,7 +445,7 @@ void ECPresentationTasksScheduler::ExecuteTask(IECPresentationTaskR task)
     {
     BeMutexHolder lock(GetMutex());
     ICancelationTokenCPtr cancelationToken = task.GetCancelationToken();
-    m_runningTasks.insert(&task);
+    AddRunningTask(task);
     folly::via(&m_executor).then([this, task = IECPresentationTaskPtr(&task), cancelationToken]() mutable
         {
         BeMutexHolder lock(GetMutex());
@@ -382,7 +455,7 @@ void ECPresentationTasksScheduler::ExecuteTask(IECPresentationTaskR task)
         EnsureTaskCleanup cleanup([this, task]()
             {
             auto completeScope = Diagnostics::Scope::Create(Utf8PrintfString("Task `%s` completing", task->GetId().ToString().c_str()));
-            m_runningTasks.erase(task);
+            RemoveRunningTask(task);
             task->Complete();
             CheckTasks();
             });
@@ -403,6 +476,32 @@ void ECPresentationTasksScheduler::ExecuteTask(IECPresentationTaskR task)
         });
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool CancelTask(bset<IECPresentationTaskCPtr>& matchingTasks, IECPresentationTaskR task, bool complete)
+    {
+    // we still want to include the task in the result list even
+    // if it wasn't actually canceled - the callers want to get completions list
+    // of all tasks matching predicate
+    matchingTasks.insert(&task);
+
+    // no cancelation token means the task is not cancelable
+    if (task.GetCancelationToken() == nullptr)
+        {
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Task `%s` is not cancellable", task.GetId().ToString().c_str()));
+        return false;
+        }
+
+    DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Cancelling task `%s`", task.GetId().ToString().c_str()));
+    task.Cancel();
+    if (!complete)
+        return false;
+
+    task.Complete();
+    return true;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -412,29 +511,8 @@ static void CancelTasks(bset<IECPresentationTaskCPtr>& matchingTasks, TContainer
     bset<IECPresentationTaskCPtr> tasksToRemove;
     for (IECPresentationTaskPtr const& task : tasks)
         {
-        if (!pred || pred(*task))
-            {
-            // no cancelation token means the task is not cancelable
-            if (task->GetCancelationToken() != nullptr)
-                {
-                DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Cancelling task `%s`", task->GetId().ToString().c_str()));
-                task->Cancel();
-                if (complete)
-                    {
-                    task->Complete();
-                    tasksToRemove.insert(task);
-                    }
-                }
-            else
-                {
-                DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Task `%s` is not cancellable", task->GetId().ToString().c_str()));
-                }
-
-            // we still want to include the task in the result list even
-            // if it wasn't actually canceled - the callers want to get completions list
-            // of all tasks matching predicate
-            matchingTasks.insert(task);
-            }
+        if ((!pred || pred(*task)) && CancelTask(matchingTasks, *task, complete))
+            tasksToRemove.insert(task);
         }
     if (!tasksToRemove.empty())
         {
@@ -446,21 +524,12 @@ static void CancelTasks(bset<IECPresentationTaskCPtr>& matchingTasks, TContainer
     }
 
 /*---------------------------------------------------------------------------------**//**
+* Note: Must be called within a mutex
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-TasksCancelationResult ECPresentationTasksScheduler::_Cancel(IECPresentationTask::Predicate const& pred)
+TasksCancelationResult ECPresentationTasksScheduler::CancelNonQueuedTasks(TasksCancelationResult&& queueCancelationResult, IECPresentationTask::Predicate const& pred)
     {
-    auto scope = Diagnostics::Scope::Create("Tasks scheduler: cancel tasks");
-    BeMutexHolder lock(GetMutex());
-    bset<IECPresentationTaskCPtr> matchingTasks;
-
-    // cancel queued tasks
-    {
-    auto queuedTasksScope = Diagnostics::Scope::Create("Cancel queued tasks");
-    TasksCancelationResult queueCancelationResult = m_queue->Cancel(pred);
-    for (IECPresentationTaskCPtr const& task : queueCancelationResult.GetTasks())
-        matchingTasks.insert(task);
-    }
+    bset<IECPresentationTaskCPtr> matchingTasks = queueCancelationResult.GetTasks();
 
     // cancel pending tasks
     {
@@ -477,6 +546,39 @@ TasksCancelationResult ECPresentationTasksScheduler::_Cancel(IECPresentationTask
     return TasksCancelationResult(matchingTasks);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TasksCancelationResult ECPresentationTasksScheduler::_Cancel(IECPresentationTask::Predicate const& pred)
+    {
+    auto scope = Diagnostics::Scope::Create("Tasks scheduler: cancel tasks");
+    BeMutexHolder lock(GetMutex());
+    TasksCancelationResult queueCancelationResult = [&]()
+        {
+        auto queuedTasksScope = Diagnostics::Scope::Create("Cancel queued tasks");
+        return m_queue->Cancel(pred);
+        }();
+    return CancelNonQueuedTasks(std::move(queueCancelationResult), pred);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TasksCancelationResult ECPresentationTasksScheduler::_CancelDependent(ITaskDependency const& dependency, IECPresentationTask::Predicate const& pred)
+    {
+    auto scope = Diagnostics::Scope::Create(Utf8PrintfString("Tasks scheduler: cancel tasks dependent on `%s`", dependency.GetDependencyType()));
+    BeMutexHolder lock(GetMutex());
+    TasksCancelationResult queueCancelationResult = [&]()
+        {
+        auto queuedTasksScope = Diagnostics::Scope::Create("Cancel queued tasks");
+        return m_queue->Cancel(dependency, pred);
+        }();
+    return CancelNonQueuedTasks(std::move(queueCancelationResult), [&dependency, &pred](IECPresentationTaskCR task)
+        {
+        return task.GetDependencies().Has(dependency) && (!pred || pred(task));
+        });
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -545,31 +647,77 @@ folly::Future<folly::Unit> ECPresentationTasksScheduler::_GetAllTasksCompletion(
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-bool ECPresentationTasksQueue::_HasTasks() const
+void ECPresentationTasksQueue::_Add(IECPresentationTask& task)
     {
+    auto scope = Diagnostics::Scope::Create(Utf8PrintfString("Tasks queue: add task `%s`", task.GetId().ToString().c_str()));
     BeMutexHolder lock(m_mutex);
-    return !m_prioritizedQueue.empty();
+    if (m_queuedTasks.end() != m_queuedTasks.find(&task))
+        {
+        DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Task `%s` is already queued", task.GetId().ToString().c_str()));
+        return;
+        }
+
+    QueuedTaskInfo info;
+    info.m_priority = task.GetPriority();
+    info.m_sequenceNumber = m_sequenceNumber++;
+    info.m_enqueueTime = std::chrono::steady_clock::now();
+
+    TasksBucket& bucket = m_prioritizedQueue[info.m_priority];
+    info.m_position = bucket.insert(std::make_pair(info.m_sequenceNumber, IECPresentationTaskPtr(&task))).first;
+
+    for (auto const& dependency : task.GetDependencies())
+        {
+        Utf8String key = dependency->GetIndexKey();
+        if (key.empty())
+            continue;
+        m_dependencyIndex[key].insert(&task);
+        info.m_indexKeys.push_back(key);
+        }
+
+    m_queuedTasks.Insert(&task, info);
+    ++m_tasksCount;
     }
 
 /*---------------------------------------------------------------------------------**//**
+* Note: Must be called within a mutex
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-void ECPresentationTasksQueue::_Add(IECPresentationTask& task)
+IECPresentationTaskPtr ECPresentationTasksQueue::Remove(IECPresentationTask const& task)
     {
-    auto scope = Diagnostics::Scope::Create(Utf8PrintfString("Tasks queue: add task `%s`", task.GetId().ToString().c_str()));
-    BeMutexHolder lock(m_mutex);
-    int priority = task.GetPriority();
-    auto iter = m_prioritizedQueue.find(priority);
-    if (m_prioritizedQueue.end() == iter)
-        iter = m_prioritizedQueue.Insert(priority, std::deque<IECPresentationTaskPtr>()).first;
-    iter->second.push_back(&task);
+    auto infoIter = m_queuedTasks.find(&task);
+    if (m_queuedTasks.end() == infoIter)
+        return nullptr;
+
+    QueuedTaskInfo const& info = infoIter->second;
+    IECPresentationTaskPtr result = info.m_position->second;
+
+    auto bucketIter = m_prioritizedQueue.find(info.m_priority);
+    bucketIter->second.erase(info.m_position);
+    if (bucketIter->second.empty())
+        m_prioritizedQueue.erase(bucketIter);
+
+    for (Utf8StringCR key : info.m_indexKeys)
+        {
+        auto indexIter = m_dependencyIndex.find(key);
+        if (m_dependencyIndex.end() == indexIter)
+            continue;
+        indexIter->second.erase(&task);
+        if (indexIter->second.empty())
+            m_dependencyIndex.erase(indexIter);
+        }
+
+    m_queuedTasks.erase(infoIter);
+    --m_tasksCount;
+    return result;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-IECPresentationTaskPtr ECPresentationTasksQueue::_Pop(IECPresentationTask::Predicate const& filter)
+IECPresentationTaskPtr ECPresentationTasksQueue::_PopPrioritized(PriorityPredicate const& priorityFilter, IECPresentationTask::Predicate const& filter, PopCursor* cursor)
     {
+    static Diagnostics::Histogram& s_waitTimeHistogram = Diagnostics::GetHistogram(DIAGNOSTICS_HISTOGRAM_TasksQueueWait);
+
     auto scope = Diagnostics::Scope::Create("Tasks queue: pop task");
     BeMutexHolder lock(m_mutex);
     if (m_prioritizedQueue.empty())
@@ -579,20 +727,35 @@ IECPresentationTaskPtr ECPresentationTasksQueue::_Pop(IECPresentationTask::Predi
         }
 
     // note: m_prioritizedQueue is sorted from highest priority to lowest
-    for (auto priorityBucketIter = m_prioritizedQueue.begin(); priorityBucketIter != m_prioritizedQueue.end(); ++priorityBucketIter)
+    for (auto const& priorityBucket : m_prioritizedQueue)
         {
-        auto& priorityBucket = *priorityBucketIter;
-        for (auto taskIter = priorityBucket.second.begin(); taskIter != priorityBucket.second.end(); ++taskIter)
+        if (priorityFilter && !priorityFilter(priorityBucket.first))
+            continue;
+
+        // skip tasks that were already rejected while using this cursor
+        TasksBucket const& bucket = priorityBucket.second;
+        auto iter = bucket.begin();
+        if (nullptr != cursor)
+            {
+            auto cursorIter = cursor->m_scannedPositions.find(priorityBucket.first);
+            if (cursor->m_scannedPositions.end() != cursorIter)
+                iter = bucket.upper_bound(cursorIter->second);
+            }
+
+        for (; iter != bucket.end(); ++iter)
             {
-            IECPresentationTaskPtr task = *taskIter;
-            if (!filter || filter(*task))
-                {
-                priorityBucket.second.erase(taskIter);
-                if (priorityBucket.second.empty())
-                    m_prioritizedQueue.erase(priorityBucketIter);
-                DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Returning `%s`", task->GetId().ToString().c_str()));
-                return task;
-                }
+            IECPresentationTaskPtr const& task = iter->second;
+            if (nullptr != cursor)
+                cursor->m_scannedPositions[priorityBucket.first] = iter->first;
+            if (filter && !filter(*task))
+                continue;
+
+            auto waitTime = std::chrono::steady_clock::now() - m_queuedTasks[task.get()].m_enqueueTime;
+            s_waitTimeHistogram.Record((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(waitTime).count());
+
+            IECPresentationTaskPtr result = Remove(*task);
+            DIAGNOSTICS_DEV_LOG(DiagnosticsCategory::Tasks, LOG_TRACE, Utf8PrintfString("Returning `%s`", result->GetId().ToString().c_str()));
+            return result;
             }
         }
     return nullptr;
@@ -606,34 +769,113 @@ bvector<IECPresentationTaskPtr> ECPresentationTasksQueue::_Get(IECPresentationTa
     auto scope = Diagnostics::Scope::Create("Tasks queue: get filtered tasks");
     BeMutexHolder lock(m_mutex);
     bvector<IECPresentationTaskPtr> tasks;
-    for (auto priorityBucketIter = m_prioritizedQueue.begin(); priorityBucketIter != m_prioritizedQueue.end(); ++priorityBucketIter)
+    for (auto const& priorityBucket : m_prioritizedQueue)
         {
-        auto& priorityBucket = *priorityBucketIter;
-        for (IECPresentationTaskPtr task : priorityBucket.second)
+        for (auto const& entry : priorityBucket.second)
             {
-            if (!filter || filter(*task))
-                tasks.push_back(task);
+            if (!filter || filter(*entry.second))
+                tasks.push_back(entry.second);
             }
         }
     return tasks;
     }
 
 /*---------------------------------------------------------------------------------**//**
+* Looks up tasks matching the dependency using the dependencies index. Returns `false` if
+* the dependency can't be looked up in the index, in which case callers should fall back to
+* a full scan.
+* Note: Must be called within a mutex
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-TasksCancelationResult ECPresentationTasksQueue::_Cancel(IECPresentationTask::Predicate const& pred)
+bool ECPresentationTasksQueue::FindDependentTasks(bvector<IECPresentationTaskPtr>& tasks, ITaskDependency const& dependency, IECPresentationTask::Predicate const& filter) const
     {
-    auto scope = Diagnostics::Scope::Create("Tasks queue: cancel");
+    bvector<Utf8String> keys = dependency.GetLookupKeys();
+    if (keys.empty())
+        return false;
+
+    bset<IECPresentationTask const*> candidates;
+    for (Utf8StringCR key : keys)
+        {
+        auto indexIter = m_dependencyIndex.find(key);
+        if (m_dependencyIndex.end() != indexIter)
+            candidates.insert(indexIter->second.begin(), indexIter->second.end());
+        }
+
+    bvector<QueuedTaskInfo const*> matches;
+    for (IECPresentationTask const* candidate : candidates)
+        {
+        if (!candidate->GetDependencies().Has(dependency))
+            continue;
+        QueuedTaskInfo const& info = m_queuedTasks.find(candidate)->second;
+        if (!filter || filter(*info.m_position->second))
+            matches.push_back(&info);
+        }
+
+    // keep the same order as a full scan would: highest priority first, then in order of addition
+    std::sort(matches.begin(), matches.end(), [](QueuedTaskInfo const* lhs, QueuedTaskInfo const* rhs)
+        {
+        if (lhs->m_priority != rhs->m_priority)
+            return lhs->m_priority > rhs->m_priority;
+        return lhs->m_sequenceNumber < rhs->m_sequenceNumber;
+        });
+    for (QueuedTaskInfo const* info : matches)
+        tasks.push_back(info->m_position->second);
+    return true;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bvector<IECPresentationTaskPtr> ECPresentationTasksQueue::_GetDependent(ITaskDependency const& dependency, IECPresentationTask::Predicate const& filter) const
+    {
+    auto scope = Diagnostics::Scope::Create("Tasks queue: get dependent tasks");
     BeMutexHolder lock(m_mutex);
+    bvector<IECPresentationTaskPtr> tasks;
+    if (!FindDependentTasks(tasks, dependency, filter))
+        return _Get(CreateDependencyPredicate(dependency, filter));
+    return tasks;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Note: Must be called within a mutex
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TasksCancelationResult ECPresentationTasksQueue::CancelTasks(bvector<IECPresentationTaskPtr> const& tasks, IECPresentationTask::Predicate const& pred)
+    {
     bset<IECPresentationTaskCPtr> matchingTasks;
-    bvector<int> emptyBuckets;
-    for (auto& bucket : m_prioritizedQueue)
+    for (IECPresentationTaskPtr const& task : tasks)
         {
-        CancelTasks(matchingTasks, bucket.second, pred, true);
-        if (bucket.second.empty())
-            emptyBuckets.push_back(bucket.first);
+        if ((!pred || pred(*task)) && CancelTask(matchingTasks, *task, true))
+            Remove(*task);
         }
-    for (int bucketId : emptyBuckets)
-        m_prioritizedQueue.erase(bucketId);
     return TasksCancelationResult(matchingTasks);
     }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TasksCancelationResult ECPresentationTasksQueue::_Cancel(IECPresentationTask::Predicate const& pred)
+    {
+    auto scope = Diagnostics::Scope::Create("Tasks queue: cancel");
+    BeMutexHolder lock(m_mutex);
+    bvector<IECPresentationTaskPtr> tasks;
+    for (auto const& priorityBucket : m_prioritizedQueue)
+        {
+        for (auto const& entry : priorityBucket.second)
+            tasks.push_back(entry.second);
+        }
+    return CancelTasks(tasks, pred);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TasksCancelationResult ECPresentationTasksQueue::_CancelDependent(ITaskDependency const& dependency, IECPresentationTask::Predicate const& pred)
+    {
+    auto scope = Diagnostics::Scope::Create("Tasks queue: cancel dependent");
+    BeMutexHolder lock(m_mutex);
+    bvector<IECPresentationTaskPtr> tasks;
+    if (!FindDependentTasks(tasks, dependency, pred))
+        return _Cancel(CreateDependencyPredicate(dependency, pred));
+    return CancelTasks(tasks, nullptr);
+    }
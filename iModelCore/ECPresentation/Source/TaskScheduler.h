@@ -7,6 +7,9 @@
 #include <folly/BeFolly.h>
 #include <folly/futures/SharedPromise.h>
 #include <numeric>
+#include <atomic>
+#include <chrono>
+#include <map>
 
 BEGIN_BENTLEY_ECPRESENTATION_NAMESPACE
 
@@ -18,10 +21,20 @@ struct ITaskDependency
 protected:
     virtual Utf8CP _GetDependencyType() const = 0;
     virtual bool _Matches(ITaskDependency const& other) const {return _GetDependencyType() == other._GetDependencyType();}
+    virtual Utf8String _GetIndexKey() const {return "";}
+    virtual bvector<Utf8String> _GetLookupKeys() const
+        {
+        Utf8String key = _GetIndexKey();
+        return key.empty() ? bvector<Utf8String>() : bvector<Utf8String>{ key };
+        }
 public:
     virtual ~ITaskDependency() {}
     Utf8CP GetDependencyType() const {return _GetDependencyType();}
     bool Matches(ITaskDependency const& other) const {return _Matches(other);}
+    //! Key under which tasks having this dependency are indexed. Empty key means the dependency can't be indexed.
+    Utf8String GetIndexKey() const {return _GetIndexKey();}
+    //! Index keys of all dependencies that match this one. Empty list means matching tasks can only be found by a full scan.
+    bvector<Utf8String> GetLookupKeys() const {return _GetLookupKeys();}
 };
 
 /*=================================================================================**//**
@@ -37,6 +50,7 @@ protected:
         return ITaskDependency::_Matches(other)
             && m_value.Equals(static_cast<StringBasedTaskDependency const&>(other).m_value);
         }
+    virtual Utf8String _GetIndexKey() const override {return Utf8PrintfString("%s:%s", _GetDependencyType(), m_value.c_str());}
     StringBasedTaskDependency(Utf8String value) : m_value(value) {}
     static std::function<bool(ITaskDependency const&)> CreatePredicate(Utf8CP dependencyType, std::function<bool(Utf8StringCR)>);
 public:
@@ -57,6 +71,14 @@ protected:
         return ITaskDependency::_Matches(other)
             && (GetValue().Equals(static_cast<TaskDependencyOnConnection const&>(other).GetValue()) || GetValue().Equals("*"));
         }
+    bvector<Utf8String> _GetLookupKeys() const override
+        {
+        // tasks depending on "*" connection match any connection
+        bvector<Utf8String> keys = StringBasedTaskDependency::_GetLookupKeys();
+        if (!GetValue().Equals("*"))
+            keys.push_back(Utf8PrintfString("%s:*", s_dependencyType));
+        return keys;
+        }
 public:
     TaskDependencyOnConnection(Utf8String connectionId) : StringBasedTaskDependency(connectionId) { }
     static std::function<bool(ITaskDependency const&)> CreatePredicate(std::function<bool(Utf8StringCR)> pred) {return StringBasedTaskDependency::CreatePredicate(s_dependencyType, pred);}
@@ -117,6 +139,7 @@ protected:
         BeGuid otherParentId = static_cast<TaskDependencyOnParentNode const&>(other).m_parentId;
         return m_parentId == otherParentId;
         }
+    Utf8String _GetIndexKey() const override {return Utf8PrintfString("%s:%s", _GetDependencyType(), m_parentId.ToString().c_str());}
 public:
     TaskDependencyOnParentNode(): m_parentId() {}
     TaskDependencyOnParentNode(BeGuid parentId) : m_parentId(parentId) {}
@@ -173,6 +196,7 @@ protected:
     virtual std::function<void()> _Execute() = 0;
     virtual TaskDependencies const& _GetDependencies() const = 0;
     virtual Predicate const& _GetOtherTasksBlockingPredicate() const = 0;
+    virtual ITaskDependency const* _GetOtherTasksBlockingDependency() const {return nullptr;}
     virtual bool _IsBlocked() const = 0;
     virtual void _SetTaskConnection(IConnectionCR) = 0;
 public:
@@ -189,6 +213,9 @@ public:
     std::function<void()> Execute() {return _Execute();}
     TaskDependencies const& GetDependencies() const {return _GetDependencies();}
     Predicate const& GetOtherTasksBlockingPredicate() const {return _GetOtherTasksBlockingPredicate();}
+    //! Dependency that every task matching the other tasks blocking predicate has. The scheduler uses it to look up the running tasks
+    //! this task might block by index instead of testing the predicate against every one of them. Null means there's no such dependency.
+    ITaskDependency const* GetOtherTasksBlockingDependency() const {return _GetOtherTasksBlockingDependency();}
     bool IsBlocked() const {return _IsBlocked();}
     void SetTaskConnection(IConnectionCR connection) {_SetTaskConnection(connection);}
 };
@@ -222,6 +249,7 @@ private:
     TaskDependencies m_dependencies;
     int m_priority;
     IECPresentationTask::Predicate m_otherTasksBlockingPredicate;
+    std::shared_ptr<ITaskDependency> m_otherTasksBlockingDependency;
     std::function<bool()> m_blockPredicate;
     folly::SharedPromise<folly::Unit> m_completionPromise;
     folly::Executor* m_futureExecutor;
@@ -330,6 +358,7 @@ protected:
     virtual TaskDependencies const& _GetDependencies() const override {return m_dependencies;}
     virtual int _GetPriority() const override {return m_priority;}
     virtual IECPresentationTask::Predicate const& _GetOtherTasksBlockingPredicate() const override {return m_otherTasksBlockingPredicate;}
+    virtual ITaskDependency const* _GetOtherTasksBlockingDependency() const override {return m_otherTasksBlockingDependency.get();}
     virtual bool _IsBlocked() const override {return m_blockPredicate && m_blockPredicate();}
     void _SetTaskConnection(IConnectionCR connection) override {BeMutexHolder lock(m_mutex); m_connection = &connection;}
 public:
@@ -368,7 +397,7 @@ public:
     void SetDependencies(TaskDependencies deps) {m_dependencies = deps;}
     void SetPriority(int priority) {m_priority = priority;}
     void SetIsCancelable(bool isCancelable) {m_cancelationToken = isCancelable ? SimpleCancelationToken::Create() : nullptr;}
-    void SetOtherTasksBlockingPredicate(IECPresentationTask::Predicate pred) {m_otherTasksBlockingPredicate = pred;}
+    void SetOtherTasksBlockingPredicate(IECPresentationTask::Predicate pred, std::shared_ptr<ITaskDependency> dependency = nullptr) {m_otherTasksBlockingPredicate = pred; m_otherTasksBlockingDependency = dependency;}
     void SetThisTaskBlockingPredicate(std::function<bool()> pred) {m_blockPredicate = pred;}
     void SetFutureExecutor(folly::Executor* e) {m_futureExecutor = e;}
 };
@@ -436,21 +465,53 @@ public:
 +===============+===============+===============+===============+===============+======*/
 struct IECPresentationTasksQueue
 {
+    typedef std::function<bool(int)> PriorityPredicate;
+
+    /*=============================================================================**//**
+    * Remembers how far a series of `Pop` calls has scanned the queue, so tasks rejected by
+    * the filter aren't tested again. The filter must keep rejecting a task for as long as the
+    * cursor is used - e.g. within a single scheduling pass. Tasks added after the cursor
+    * passed them are still tested.
+    * @bsiclass
+    +===============+===============+===============+===============+===============+======*/
+    struct PopCursor
+        {
+        bmap<int, uint64_t> m_scannedPositions;
+        };
+
 protected:
+    static IECPresentationTask::Predicate CreateDependencyPredicate(ITaskDependency const& dependency, IECPresentationTask::Predicate const& pred)
+        {
+        return [&dependency, &pred](IECPresentationTaskCR task){return task.GetDependencies().Has(dependency) && (!pred || pred(task));};
+        }
+    static IECPresentationTask::Predicate CreatePriorityPredicate(PriorityPredicate const& priorityFilter, IECPresentationTask::Predicate const& pred)
+        {
+        return [&priorityFilter, &pred](IECPresentationTaskCR task){return (!priorityFilter || priorityFilter(task.GetPriority())) && (!pred || pred(task));};
+        }
     virtual BeMutex& _GetMutex() const = 0;
     virtual bool _HasTasks() const = 0;
     virtual void _Add(IECPresentationTask&) = 0;
     virtual IECPresentationTaskPtr _Pop(IECPresentationTask::Predicate const&) = 0;
+    virtual IECPresentationTaskPtr _PopPrioritized(PriorityPredicate const& priorityFilter, IECPresentationTask::Predicate const& filter, PopCursor*) {return _Pop(CreatePriorityPredicate(priorityFilter, filter));}
     virtual bvector<IECPresentationTaskPtr> _Get(IECPresentationTask::Predicate const&) const = 0;
+    virtual bvector<IECPresentationTaskPtr> _GetDependent(ITaskDependency const& dependency, IECPresentationTask::Predicate const& filter) const {return _Get(CreateDependencyPredicate(dependency, filter));}
     virtual TasksCancelationResult _Cancel(IECPresentationTask::Predicate const&) = 0;
+    virtual TasksCancelationResult _CancelDependent(ITaskDependency const& dependency, IECPresentationTask::Predicate const& pred) {return _Cancel(CreateDependencyPredicate(dependency, pred));}
 public:
     virtual ~IECPresentationTasksQueue() {}
     BeMutex& GetMutex() const {return _GetMutex();}
     bool HasTasks() const {return _HasTasks();}
     void Add(IECPresentationTask& task) {_Add(task);}
     IECPresentationTaskPtr Pop(IECPresentationTask::Predicate const& filter = nullptr) {return _Pop(filter);}
+    //! Pop the first task matching the filter, skipping whole priority buckets rejected by `priorityFilter`.
+    //! When `cursor` is provided, tasks that were rejected by earlier calls with the same cursor are skipped without testing them again.
+    IECPresentationTaskPtr Pop(PriorityPredicate const& priorityFilter, IECPresentationTask::Predicate const& filter, PopCursor* cursor = nullptr) {return _PopPrioritized(priorityFilter, filter, cursor);}
     bvector<IECPresentationTaskPtr> Get(IECPresentationTask::Predicate const& filter = nullptr) const {return _Get(filter);}
+    //! Get tasks that have a dependency matching the given one and match the filter.
+    bvector<IECPresentationTaskPtr> Get(ITaskDependency const& dependency, IECPresentationTask::Predicate const& filter = nullptr) const {return _GetDependent(dependency, filter);}
     TasksCancelationResult Cancel(IECPresentationTask::Predicate const& pred = [](IECPresentationTaskCR){return true;}) {return _Cancel(pred);}
+    //! Cancel tasks that have a dependency matching the given one and match the predicate.
+    TasksCancelationResult Cancel(ITaskDependency const& dependency, IECPresentationTask::Predicate const& pred = nullptr) {return _CancelDependent(dependency, pred);}
 };
 
 /*=================================================================================**//**
@@ -458,16 +519,46 @@ public:
 +===============+===============+===============+===============+===============+======*/
 struct ECPresentationTasksQueue : IECPresentationTasksQueue
 {
+private:
+    // tasks of one priority, keyed by sequence number (i.e. in order of addition)
+    // note: std::map, because QueuedTaskInfo keeps iterators that must stay valid while other tasks are added and removed
+    typedef std::map<uint64_t, IECPresentationTaskPtr> TasksBucket;
+    struct QueuedTaskInfo
+        {
+        int m_priority;
+        uint64_t m_sequenceNumber;
+        TasksBucket::iterator m_position;
+        std::chrono::steady_clock::time_point m_enqueueTime;
+        bvector<Utf8String> m_indexKeys;
+        };
+
 private:
     mutable BeMutex m_mutex;
-    bmap<int, std::deque<IECPresentationTaskPtr>, std::greater<int>> m_prioritizedQueue;
+    std::atomic<size_t> m_tasksCount;
+    uint64_t m_sequenceNumber;
+    bmap<int, TasksBucket, std::greater<int>> m_prioritizedQueue;
+    bmap<IECPresentationTask const*, QueuedTaskInfo> m_queuedTasks;
+    bmap<Utf8String, bset<IECPresentationTask const*>> m_dependencyIndex;
+
+private:
+    IECPresentationTaskPtr Remove(IECPresentationTask const&);
+    bool FindDependentTasks(bvector<IECPresentationTaskPtr>&, ITaskDependency const&, IECPresentationTask::Predicate const&) const;
+    TasksCancelationResult CancelTasks(bvector<IECPresentationTaskPtr> const&, IECPresentationTask::Predicate const&);
+
 protected:
     virtual BeMutex& _GetMutex() const override {return m_mutex;}
-    ECPRESENTATION_EXPORT virtual bool _HasTasks() const override;
+    virtual bool _HasTasks() const override {return m_tasksCount.load() > 0;}
     ECPRESENTATION_EXPORT virtual void _Add(IECPresentationTask& task) override;
-    ECPRESENTATION_EXPORT virtual IECPresentationTaskPtr _Pop(IECPresentationTask::Predicate const&) override;
+    virtual IECPresentationTaskPtr _Pop(IECPresentationTask::Predicate const& filter) override {return _PopPrioritized(nullptr, filter, nullptr);}
+    ECPRESENTATION_EXPORT virtual IECPresentationTaskPtr _PopPrioritized(PriorityPredicate const&, IECPresentationTask::Predicate const&, PopCursor*) override;
     ECPRESENTATION_EXPORT virtual bvector<IECPresentationTaskPtr> _Get(IECPresentationTask::Predicate const&) const override;
+    ECPRESENTATION_EXPORT virtual bvector<IECPresentationTaskPtr> _GetDependent(ITaskDependency const&, IECPresentationTask::Predicate const&) const override;
     ECPRESENTATION_EXPORT virtual TasksCancelationResult _Cancel(IECPresentationTask::Predicate const&) override;
+    ECPRESENTATION_EXPORT virtual TasksCancelationResult _CancelDependent(ITaskDependency const&, IECPresentationTask::Predicate const&) override;
+
+public:
+    ECPresentationTasksQueue() : m_tasksCount(0), m_sequenceNumber(0) {}
+    size_t GetTasksCount() const {return m_tasksCount.load();}
 };
 
 //=======================================================================================
@@ -500,6 +591,10 @@ protected:
     virtual BeMutex& _GetMutex() const = 0;
     virtual void _Schedule(IECPresentationTaskR) = 0;
     virtual TasksCancelationResult _Cancel(IECPresentationTask::Predicate const&) = 0;
+    virtual TasksCancelationResult _CancelDependent(ITaskDependency const& dependency, IECPresentationTask::Predicate const& pred)
+        {
+        return _Cancel([&dependency, &pred](IECPresentationTaskCR task){return task.GetDependencies().Has(dependency) && (!pred || pred(task));});
+        }
     virtual TasksCancelationResult _Restart(IECPresentationTask::Predicate const&) = 0;
     virtual void _Block(IECPresentationTasksBlocker const*) = 0;
     virtual void _Unblock(IECPresentationTasksBlocker const*) = 0;
@@ -509,6 +604,7 @@ public:
     BeMutex& GetMutex() const { return _GetMutex(); }
     void Schedule(IECPresentationTaskR task) {_Schedule(task);}
     TasksCancelationResult Cancel(IECPresentationTask::Predicate const& pred = nullptr) {return _Cancel(pred);}
+    TasksCancelationResult Cancel(ITaskDependency const& dependency, IECPresentationTask::Predicate const& pred = nullptr) {return _CancelDependent(dependency, pred);}
     TasksCancelationResult Restart(IECPresentationTask::Predicate const& pred = nullptr) {return _Restart(pred);}
     void Block(IECPresentationTasksBlocker const* blocker) {_Block(blocker);}
     void Unblock(IECPresentationTasksBlocker const* blocker) {_Unblock(blocker);}
@@ -525,20 +621,26 @@ private:
     folly::Executor& m_executor;
     bvector<IECPresentationTaskPtr> m_pendingTasks;
     bset<IECPresentationTaskPtr> m_runningTasks;
-    bvector<IECPresentationTasksBlocker const*> m_blockers;
+    bmap<Utf8String, bset<IECPresentationTask const*>> m_runningTasksIndex; // running tasks by index keys of their dependencies
+    bvector<IECPresentationTasksBlocker const*> m_blockers; // note: blockers are few and short-lived, so they're not indexed and are tested one by one
     TThreadAllocationsMap m_threadAllocations;
     unsigned m_threadsCount;
 private:
     void CheckTasks();
-    IECPresentationTaskPtr PopTask(IECPresentationTask::Predicate const& filter, TThreadAllocationsMap&);
+    void AddRunningTask(IECPresentationTaskR);
+    void RemoveRunningTask(IECPresentationTaskPtr const&);
+    bool IsBlockingRunningTasks(IECPresentationTaskCR) const;
+    IECPresentationTaskPtr PopTask(IECPresentationTask::Predicate const& filter, TThreadAllocationsMap&, IECPresentationTasksQueue::PopCursor&);
     bool CanExecute(IECPresentationTaskCR) const;
     void ExecuteTask(IECPresentationTaskR);
     IECPresentationTask::Predicate CreateTasksFilter(TThreadAllocationsMap const&) const;
     TThreadAllocationsMap CreateAvailableAllocationsMap() const;
+    TasksCancelationResult CancelNonQueuedTasks(TasksCancelationResult&& queueCancelationResult, IECPresentationTask::Predicate const&);
 protected:
     BeMutex& _GetMutex() const override {return m_queue->GetMutex();}
     ECPRESENTATION_EXPORT void _Schedule(IECPresentationTaskR) override;
     ECPRESENTATION_EXPORT TasksCancelationResult _Cancel(IECPresentationTask::Predicate const&) override;
+    ECPRESENTATION_EXPORT TasksCancelationResult _CancelDependent(ITaskDependency const&, IECPresentationTask::Predicate const&) override;
     ECPRESENTATION_EXPORT TasksCancelationResult _Restart(IECPresentationTask::Predicate const&) override;
     ECPRESENTATION_EXPORT void _Block(IECPresentationTasksBlocker const*) override;
     ECPRESENTATION_EXPORT void _Unblock(IECPresentationTasksBlocker const*) override;
@@ -590,6 +692,7 @@ private:
     bool m_isCancellable;
     TaskDependencies m_dependencies;
     IECPresentationTask::Predicate m_otherTasksBlockingPredicate;
+    std::shared_ptr<ITaskDependency> m_otherTasksBlockingDependency;
     std::function<bool()> m_blockPredicate;
 public:
     ECPresentationTaskParams() : m_priority(1000), m_isCancellable(true) {}
@@ -604,7 +707,10 @@ public:
     void SetIsCancelable(bool value) {m_isCancellable = value;}
 
     IECPresentationTask::Predicate const& GetOtherTasksBlockingPredicate() const {return m_otherTasksBlockingPredicate;}
-    void SetOtherTasksBlockingPredicate(IECPresentationTask::Predicate pred) {m_otherTasksBlockingPredicate = pred;}
+    std::shared_ptr<ITaskDependency> const& GetOtherTasksBlockingDependency() const {return m_otherTasksBlockingDependency;}
+    //! Set the predicate that matches the tasks this task blocks. If every matching task is known to have some dependency, pass
+    //! it as `dependency` to let the scheduler find them through its index.
+    void SetOtherTasksBlockingPredicate(IECPresentationTask::Predicate pred, std::shared_ptr<ITaskDependency> dependency = nullptr) {m_otherTasksBlockingPredicate = pred; m_otherTasksBlockingDependency = dependency;}
 
     std::function<bool()> const& GetThisTaskBlockingPredicate() const {return m_blockPredicate;}
     void SetThisTaskBlockingPredicate(std::function<bool()> pred) {m_blockPredicate = pred;}
@@ -616,7 +722,7 @@ public:
         task.SetIsCancelable(IsCancellable());
         task.SetPriority(GetPriority());
         task.SetThisTaskBlockingPredicate(GetThisTaskBlockingPredicate());
-        task.SetOtherTasksBlockingPredicate(GetOtherTasksBlockingPredicate());
+        task.SetOtherTasksBlockingPredicate(GetOtherTasksBlockingPredicate(), GetOtherTasksBlockingDependency());
         }
 };
 
@@ -656,6 +762,7 @@ public:
         return Execute<TResult>(*task);
         }
     TasksCancelationResult Cancel(IECPresentationTask::Predicate const& pred) {return m_scheduler->Cancel(pred);}
+    TasksCancelationResult Cancel(ITaskDependency const& dependency, IECPresentationTask::Predicate const& pred = nullptr) {return m_scheduler->Cancel(dependency, pred);}
     TasksCancelationResult Restart(IECPresentationTask::Predicate const& pred) {return m_scheduler->Restart(pred);}
     RefCountedPtr<ECPresentationTasksBlocker> Block(IECPresentationTask::Predicate pred) {return ECPresentationTasksBlocker::Create(*m_scheduler, pred);}
     folly::Future<folly::Unit> GetAllTasksCompletion(IECPresentationTask::Predicate const& pred = nullptr) const {return m_scheduler->GetAllTasksCompletion(pred);}
@@ -125,6 +125,58 @@ public:
         {}
 };
 
+/*=================================================================================**//**
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct UpdateContentTask : IUpdateTask
+{
+private:
+    UpdateTasksFactoryCR m_tasksFactory;
+    UpdateContext& m_updateContext;
+    ContentCache& m_contentCache;
+    ContentCacheEntry m_entry;
+    bvector<ECInstanceChangeEventSource::ChangedECInstance> m_changes;
+protected:
+    uint32_t _GetPriority() const override {return TASK_PRIORITY_InvalidateContent;}
+    bvector<IUpdateTaskPtr> _Perform() override
+        {
+        bvector<IUpdateTaskPtr> subTasks;
+        SpecificationContentProviderR provider = m_entry.GetProvider();
+        ContentChangesResult result = provider.ApplyChanges(m_changes);
+        if (ContentChangesResult::Unaffected == result)
+            return subTasks;
+
+        // updated providers are updated in place, invalidated ones have to be dropped
+        if (ContentChangesResult::Invalidated == result)
+            m_contentCache.ClearCache(m_entry.GetProviderKey(), m_entry.GetRelatedVariables());
+
+        Utf8StringCR rulesetId = provider.GetContext().GetRuleset().GetRuleSetId();
+        if (m_updateContext.GetReportedContentRulesetIds().end() == m_updateContext.GetReportedContentRulesetIds().find(rulesetId))
+            {
+            Utf8String ecdbFileName = provider.GetContext().GetConnection().GetECDb().GetDbFileName();
+            subTasks.push_back(m_tasksFactory.CreateReportTask(FullUpdateRecord(rulesetId, ecdbFileName, FullUpdateRecord::UpdateTarget::Content)));
+            m_updateContext.GetReportedContentRulesetIds().insert(rulesetId);
+            }
+        return subTasks;
+        }
+    Utf8CP _GetName() const override {return "UpdateContentTask";}
+    Utf8String _GetPrintStr() const override
+        {
+        Utf8String str;
+        if (!DidPerform())
+            {
+            str.append(Utf8PrintfString("RulesetId = '%s', DisplayType = '%s', Changes = %" PRIu64, m_entry.GetProviderKey().GetRulesetId().c_str(),
+                m_entry.GetProviderKey().GetPreferredDisplayType().c_str(), (uint64_t)m_changes.size()));
+            }
+        return str;
+        }
+public:
+    UpdateContentTask(UpdateTasksFactoryCR factory, UpdateContext& updateContext, ContentCache& contentCache, ContentCacheEntry const& entry,
+        bvector<ECInstanceChangeEventSource::ChangedECInstance> const& changes)
+        : m_tasksFactory(factory), m_updateContext(updateContext), m_contentCache(contentCache), m_entry(entry), m_changes(changes)
+        {}
+};
+
 /*=================================================================================**//**
 * @bsiclass
 +===============+===============+===============+===============+===============+======*/
@@ -164,6 +216,15 @@ IUpdateTaskPtr UpdateTasksFactory::CreateContentInvalidationTask(ContentCache& c
     return new InvalidateContentTask(*this, updateContext, contentCache, provider);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+IUpdateTaskPtr UpdateTasksFactory::CreateContentUpdateTask(ContentCache& contentCache, UpdateContext& updateContext, ContentCacheEntry const& entry,
+    bvector<ECInstanceChangeEventSource::ChangedECInstance> const& changes) const
+    {
+    return new UpdateContentTask(*this, updateContext, contentCache, entry, changes);
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -324,11 +385,11 @@ bvector<IUpdateTaskPtr> UpdateHandler::CreateUpdateTasks(UpdateContext& updateCo
 
     if (nullptr != m_contentCache)
         {
-        bvector<SpecificationContentProviderPtr> affectedContentProviders = m_contentCache->GetProviders(connection);
-        for (SpecificationContentProviderPtr& provider : affectedContentProviders)
+        bvector<ContentCacheEntry> cacheEntries = m_contentCache->GetEntries(connection);
+        for (ContentCacheEntry const& entry : cacheEntries)
             {
-            provider->GetContextR().ShallowAdoptToSameConnection(nullptr);
-            AddTask(tasks, *m_tasksFactory.CreateContentInvalidationTask(*m_contentCache, updateContext, *provider));
+            // the cached provider itself is updated, so requests that get it from cache later see the changes
+            AddTask(tasks, *m_tasksFactory.CreateContentUpdateTask(*m_contentCache, updateContext, entry, changes));
             }
         }
     return tasks;
@@ -434,6 +495,11 @@ void UpdateHandler::ExecuteTasks(bvector<IUpdateTaskPtr>& tasks) const
 void UpdateHandler::NotifyECInstancesChanged(IConnectionCR connection, bvector<ECInstanceChangeEventSource::ChangedECInstance> const& changes)
     {
     auto scope = Diagnostics::Scope::Create(Utf8PrintfString("ECInstances changed (%" PRIu64 "). Update.", changes.size()));
+
+    // the connection no longer matches the changeset its hierarchy cache is shared by - continue with a private cache,
+    // so the updates below don't leak into hierarchies cached for that changeset
+    m_nodesCachesManager.DetachSharedCache(connection);
+
     UpdateContext updateContext;
     updateContext.SetNodesCache(m_nodesCachesManager.GetPersistentCache(connection.GetId()));
     bvector<IUpdateTaskPtr> tasks = CreateUpdateTasks(updateContext, connection, changes);
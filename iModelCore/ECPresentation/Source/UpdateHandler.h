@@ -117,6 +117,7 @@ public:
 
     // content-related update tasks
     ECPRESENTATION_EXPORT IUpdateTaskPtr CreateContentInvalidationTask(ContentCache&, UpdateContext&, ContentProviderR) const;
+    ECPRESENTATION_EXPORT IUpdateTaskPtr CreateContentUpdateTask(ContentCache&, UpdateContext&, ContentCacheEntry const&, bvector<ECInstanceChangeEventSource::ChangedECInstance> const&) const;
 
     // reporting tasks
     ECPRESENTATION_EXPORT IUpdateTaskPtr CreateReportTask(FullUpdateRecord) const;
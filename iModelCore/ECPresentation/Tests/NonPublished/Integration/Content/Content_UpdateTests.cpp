@@ -399,3 +399,94 @@ TEST_F (ContentUpdateTests, DoesNotInvalidateWhenUnusedUserSettingChanges)
     // expect 0 update records
     ASSERT_EQ(0, m_updateRecordsHandler->GetFullUpdateRecords().size());
     }
+
+/*---------------------------------------------------------------------------------**//**
+* @betest
++---------------+---------------+---------------+---------------+---------------+------*/
+DEFINE_SCHEMA(UpdatesContentRecordAfterPropertyValueUpdate, R"*(
+    <ECEntityClass typeName="A">
+        <ECProperty propertyName="Prop" typeName="string" />
+    </ECEntityClass>
+)*");
+TEST_F (ContentUpdateTests, UpdatesContentRecordAfterPropertyValueUpdate)
+    {
+    ECClassCP classA = GetClass("A");
+
+    // insert some instances
+    IECInstancePtr instance1 = RulesEngineTestHelpers::InsertInstance(m_db, *classA, [](IECInstanceR instance){instance.SetValue("Prop", ECValue("1"));});
+    IECInstancePtr instance2 = RulesEngineTestHelpers::InsertInstance(m_db, *classA, [](IECInstanceR instance){instance.SetValue("Prop", ECValue("2"));}, true);
+
+    // create the rule set
+    PresentationRuleSetPtr rules = PresentationRuleSet::CreateInstance(BeTest::GetNameOfCurrentTest());
+    m_locater->AddRuleSet(*rules);
+
+    ContentRule* rule = new ContentRule("", 1, false);
+    rule->AddSpecification(*new ContentInstancesOfSpecificClassesSpecification(1, "", classA->GetFullName(), false, false));
+    rules->AddPresentationRule(*rule);
+
+    // request content
+    ContentDescriptorCPtr descriptor = GetValidatedResponse(m_manager->GetContentDescriptor(AsyncContentDescriptorRequestParams::Create(m_db, rules->GetRuleSetId(), RulesetVariables(), "", 0, *KeySet::Create())));
+    ContentCPtr content = GetValidatedResponse(m_manager->GetContent(AsyncContentRequestParams::Create(m_db, *descriptor)));
+    ASSERT_EQ(2, content->GetContentSet().GetSize());
+    EXPECT_STREQ("2", content->GetContentSet()[1]->GetDisplayValues()[FIELD_NAME(classA, "Prop")].GetString());
+
+    // update one of the instances
+    instance2->SetValue("Prop", ECValue("3"));
+    ECInstanceUpdater updater(m_db, *instance2, nullptr);
+    updater.Update(*instance2);
+    m_db.SaveChanges();
+    m_eventsSource->NotifyECInstanceUpdated(m_db, *instance2);
+
+    // expect the updated value
+    content = GetValidatedResponse(m_manager->GetContent(AsyncContentRequestParams::Create(m_db, *descriptor)));
+    ASSERT_EQ(2, content->GetContentSet().GetSize());
+    EXPECT_STREQ(instance1->GetInstanceId().c_str(), content->GetContentSet()[0]->GetKeys()[0].GetId().ToString().c_str());
+    EXPECT_STREQ("1", content->GetContentSet()[0]->GetDisplayValues()[FIELD_NAME(classA, "Prop")].GetString());
+    EXPECT_STREQ(instance2->GetInstanceId().c_str(), content->GetContentSet()[1]->GetKeys()[0].GetId().ToString().c_str());
+    EXPECT_STREQ("3", content->GetContentSet()[1]->GetDisplayValues()[FIELD_NAME(classA, "Prop")].GetString());
+
+    // expect one full update record
+    ASSERT_EQ(1, m_updateRecordsHandler->GetFullUpdateRecords().size());
+    EXPECT_EQ(FullUpdateRecord::UpdateTarget::Content, m_updateRecordsHandler->GetFullUpdateRecords()[0].GetUpdateTarget());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @betest
++---------------+---------------+---------------+---------------+---------------+------*/
+DEFINE_SCHEMA(DoesNotUpdateContentAfterUnrelatedECInstanceInsert, R"*(
+    <ECEntityClass typeName="A" />
+    <ECEntityClass typeName="B" />
+)*");
+TEST_F (ContentUpdateTests, DoesNotUpdateContentAfterUnrelatedECInstanceInsert)
+    {
+    ECClassCP classA = GetClass("A");
+    ECClassCP classB = GetClass("B");
+
+    // insert an instance
+    IECInstancePtr instanceA = RulesEngineTestHelpers::InsertInstance(m_db, *classA, nullptr, true);
+
+    // create the rule set
+    PresentationRuleSetPtr rules = PresentationRuleSet::CreateInstance(BeTest::GetNameOfCurrentTest());
+    m_locater->AddRuleSet(*rules);
+
+    ContentRule* rule = new ContentRule("", 1, false);
+    rule->AddSpecification(*new ContentInstancesOfSpecificClassesSpecification(1, "", classA->GetFullName(), false, false));
+    rules->AddPresentationRule(*rule);
+
+    // request content
+    ContentDescriptorCPtr descriptor = GetValidatedResponse(m_manager->GetContentDescriptor(AsyncContentDescriptorRequestParams::Create(m_db, rules->GetRuleSetId(), RulesetVariables(), "", 0, *KeySet::Create())));
+    ContentCPtr content = GetValidatedResponse(m_manager->GetContent(AsyncContentRequestParams::Create(m_db, *descriptor)));
+    ASSERT_EQ(1, content->GetContentSet().GetSize());
+
+    // insert an instance of unrelated class
+    IECInstancePtr instanceB = RulesEngineTestHelpers::InsertInstance(m_db, *classB, nullptr, true);
+    m_eventsSource->NotifyECInstanceInserted(m_db, *instanceB);
+
+    // expect the same content
+    content = GetValidatedResponse(m_manager->GetContent(AsyncContentRequestParams::Create(m_db, *descriptor)));
+    ASSERT_EQ(1, content->GetContentSet().GetSize());
+    EXPECT_STREQ(instanceA->GetInstanceId().c_str(), content->GetContentSet()[0]->GetKeys()[0].GetId().ToString().c_str());
+
+    // expect no update records
+    EXPECT_EQ(0, m_updateRecordsHandler->GetFullUpdateRecords().size());
+    }
@@ -178,6 +178,63 @@ TEST_F(ContentCacheTests, ClearsCacheByRulesetId)
     EXPECT_EQ(1, m_cache.GetProviders("ruleset id 2", TEST_RELATED_SETTING).size());
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ContentCacheTests, ClearsCacheBySingleProviderKey)
+    {
+    ContentProviderKey key1("connection id", "ruleset id", "display type 1", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr);
+    ContentProviderKey key2("connection id", "ruleset id", "display type 2", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr);
+    SpecificationContentProviderP provider1 = CacheProvider(key1);
+    SpecificationContentProviderP provider2 = CacheProvider(key2);
+
+    m_cache.ClearCache(key1, RulesetVariables(provider1->GetContext().GetRelatedRulesetVariables()));
+
+    EXPECT_TRUE(m_cache.GetProvider(key1, RulesetVariables(provider1->GetContext().GetRelatedRulesetVariables())).IsNull());
+    EXPECT_EQ(provider2, m_cache.GetProvider(key2, RulesetVariables(provider2->GetContext().GetRelatedRulesetVariables())).get());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ContentCacheTests, ReturnsCacheEntriesByConnection)
+    {
+    ECDb db1;
+    IConnectionPtr connection1 = new TestConnection(db1);
+    ContentProviderKey key1(connection1->GetId(), "ruleset id", "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr);
+    SpecificationContentProviderP provider = CacheProvider(key1);
+
+    ECDb db2;
+    IConnectionPtr connection2 = new TestConnection(db2);
+    ContentProviderKey key2(connection2->GetId(), "ruleset id", "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr);
+    CacheProvider(key2);
+
+    bvector<ContentCacheEntry> entries = m_cache.GetEntries(*connection1);
+    ASSERT_EQ(1, entries.size());
+    EXPECT_TRUE(key1 == entries[0].GetProviderKey());
+    EXPECT_EQ(provider, &entries[0].GetProvider());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ContentCacheTests, ReturnsCachedProviderInCacheEntriesWhenProviderIsInUse)
+    {
+    ECDb db;
+    IConnectionPtr connection = new TestConnection(db);
+    ContentProviderKey key(connection->GetId(), "ruleset id", "display type", 0, ECPresentation::UnitSystem::Undefined, *NavNodeKeyListContainer::Create(), nullptr);
+    SpecificationContentProviderP provider = CacheProvider(key);
+
+    // a provider that's in use is handed out as a clone by GetProvider...
+    SpecificationContentProviderPtr inUse = provider;
+    EXPECT_NE(provider, m_cache.GetProvider(key, RulesetVariables(provider->GetContext().GetRelatedRulesetVariables())).get());
+
+    // ...but cache entries always reference the cached provider, so updates applied to them aren't lost
+    bvector<ContentCacheEntry> entries = m_cache.GetEntries(*connection);
+    ASSERT_EQ(1, entries.size());
+    EXPECT_EQ(provider, &entries[0].GetProvider());
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsitest
 +---------------+---------------+---------------+---------------+---------------+------*/
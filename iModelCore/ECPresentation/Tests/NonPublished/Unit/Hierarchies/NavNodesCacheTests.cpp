@@ -2086,6 +2086,217 @@ TEST_F(DiskNodesCacheLocationTests, CreatesCacheInTheSameDirectoryAsIModelIfDire
     EXPECT_STREQ(expectedPath.GetNameUtf8().c_str(), cache->GetDb().GetDbFileName());
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+static BeFileName CreateIModelCopyAtChangeset(BeFileNameCR seedPath, BeFileNameCR directory, WCharCP fileName, Utf8CP changesetId)
+    {
+    BeFileName path(directory);
+    path.AppendToPath(fileName);
+    path.BeDeleteFile();
+    EXPECT_EQ(BeFileNameStatus::Success, BeFileName::BeCopyFile(seedPath, path));
+
+    ECDb db;
+    EXPECT_EQ(BE_SQLITE_OK, db.OpenBeSQLiteDb(path, ECDb::OpenParams(Db::OpenMode::ReadWrite)));
+    EXPECT_EQ(BE_SQLITE_OK, db.SaveBriefcaseLocalValue("ParentChangeSetId", Utf8String(changesetId)));
+    EXPECT_EQ(BE_SQLITE_OK, db.SaveChanges());
+    return path;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, SharesCacheByChangesetBetweenCopiesOfReadOnlyIModel)
+    {
+    s_project->GetECDb().SaveChanges();
+    Utf8CP changesetId = "8f3e0c1b5a2d4e6f7a8b9c0d1e2f3a4b5c6d7e8f";
+    BeFileName firstPath = CreateIModelCopyAtChangeset(BeFileName(s_project->GetECDbPath()), m_directory, L"FirstCopy.ecdb", changesetId);
+    BeFileName secondPath = CreateIModelCopyAtChangeset(BeFileName(s_project->GetECDbPath()), m_directory, L"SecondCopy.ecdb", changesetId);
+
+    ECDb firstDb, secondDb;
+    ASSERT_EQ(BE_SQLITE_OK, firstDb.OpenBeSQLiteDb(firstPath, ECDb::OpenParams(Db::OpenMode::Readonly)));
+    ASSERT_EQ(BE_SQLITE_OK, secondDb.OpenBeSQLiteDb(secondPath, ECDb::OpenParams(Db::OpenMode::Readonly)));
+    IConnectionPtr firstConnection = m_connections.NotifyConnectionOpened(firstDb);
+    IConnectionPtr secondConnection = m_connections.NotifyConnectionOpened(secondDb);
+
+    BeFileName expectedPath = m_directory;
+    expectedPath.AppendSeparator().AppendUtf8(Utf8PrintfString("%s-%s-hierarchies", firstDb.GetDbGuid().ToString().c_str(), changesetId).c_str());
+    expectedPath.BeDeleteFile();
+
+    PresentationRuleSetPtr ruleset = PresentationRuleSet::CreateInstance("TestRuleset");
+    {
+    auto cache = NodesCache::Create(*firstConnection, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Disk, true, true);
+    EXPECT_STREQ(expectedPath.GetNameUtf8().c_str(), cache->GetDb().GetDbFileName());
+    cache->OnRulesetUsed(*ruleset);
+    }
+
+    // a copy of the iModel with different name and modification time at the same changeset picks up the cache
+    auto cache = NodesCache::Create(*secondConnection, m_directory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, NodesCacheType::Disk, true, true);
+    EXPECT_STREQ(expectedPath.GetNameUtf8().c_str(), cache->GetDb().GetDbFileName());
+    Statement stmt;
+    ASSERT_EQ(BE_SQLITE_OK, stmt.Prepare(cache->GetDb(), "SELECT 1 FROM [" NODESCACHE_TABLENAME_Rulesets "] WHERE [Identifier] = ?"));
+    stmt.BindText(1, ruleset->GetRuleSetId(), Statement::MakeCopy::No);
+    EXPECT_EQ(BE_SQLITE_ROW, stmt.Step());
+
+    stmt.Finalize();
+    cache = nullptr;
+    m_connections.NotifyConnectionClosed(*firstConnection);
+    m_connections.NotifyConnectionClosed(*secondConnection);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, DoesntShareCacheOfWritableIModel)
+    {
+    s_project->GetECDb().SaveChanges();
+    BeFileName path = CreateIModelCopyAtChangeset(BeFileName(s_project->GetECDbPath()), m_directory, L"WritableCopy.ecdb", "8f3e0c1b5a2d4e6f7a8b9c0d1e2f3a4b5c6d7e8f");
+
+    ECDb db;
+    ASSERT_EQ(BE_SQLITE_OK, db.OpenBeSQLiteDb(path, ECDb::OpenParams(Db::OpenMode::ReadWrite)));
+    IConnectionPtr connection = m_connections.NotifyConnectionOpened(db);
+
+    BeFileName expectedPath = m_directory;
+    expectedPath.AppendSeparator().AppendUtf8("WritableCopy.ecdb-hierarchies");
+
+    auto factory = NodesCache::DbFactory::Create(*connection, m_directory, NodesCacheType::Disk, 0, nullptr, true);
+    EXPECT_FALSE(factory->IsSharedByChangeset());
+    EXPECT_STREQ(expectedPath.GetNameUtf8().c_str(), factory->GetCachePath().c_str());
+
+    factory = nullptr;
+    m_connections.NotifyConnectionClosed(*connection);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, CreatesPrivateCopyOfSharedCache)
+    {
+    s_project->GetECDb().SaveChanges();
+    BeFileName path = CreateIModelCopyAtChangeset(BeFileName(s_project->GetECDbPath()), m_directory, L"DetachedCopy.ecdb", "0a1b2c3d4e5f60718293a4b5c6d7e8f901234567");
+
+    ECDb db;
+    ASSERT_EQ(BE_SQLITE_OK, db.OpenBeSQLiteDb(path, ECDb::OpenParams(Db::OpenMode::Readonly)));
+    IConnectionPtr connection = m_connections.NotifyConnectionOpened(db);
+
+    auto sharedFactory = NodesCache::DbFactory::Create(*connection, m_directory, NodesCacheType::Disk, 0, nullptr, true);
+    ASSERT_TRUE(sharedFactory->IsSharedByChangeset());
+
+    auto privateFactory = sharedFactory->CreatePrivateCopy();
+    ASSERT_TRUE(nullptr != privateFactory);
+    EXPECT_FALSE(privateFactory->IsSharedByChangeset());
+    EXPECT_STRNE(sharedFactory->GetCachePath().c_str(), privateFactory->GetCachePath().c_str());
+
+    BeFileName privatePath(privateFactory->GetCachePath());
+    EXPECT_TRUE(privatePath.DoesPathExist());
+    privateFactory = nullptr;
+    EXPECT_FALSE(privatePath.DoesPathExist());
+
+    sharedFactory = nullptr;
+    m_connections.NotifyConnectionClosed(*connection);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, DoesntShareCacheOfReadOnlyBriefcase)
+    {
+    s_project->GetECDb().SaveChanges();
+    BeFileName path = CreateIModelCopyAtChangeset(BeFileName(s_project->GetECDbPath()), m_directory, L"BriefcaseCopy.ecdb", "8f3e0c1b5a2d4e6f7a8b9c0d1e2f3a4b5c6d7e8f");
+    {
+    ECDb db;
+    ASSERT_EQ(BE_SQLITE_OK, db.OpenBeSQLiteDb(path, ECDb::OpenParams(Db::OpenMode::ReadWrite)));
+    ASSERT_EQ(BE_SQLITE_OK, db.ResetBriefcaseId(BeBriefcaseId(BeBriefcaseId::FirstValidBriefcaseId())));
+    ASSERT_EQ(BE_SQLITE_OK, db.SaveChanges());
+    }
+
+    // a briefcase may carry local changes on top of its changeset, even when opened read-only
+    ECDb db;
+    ASSERT_EQ(BE_SQLITE_OK, db.OpenBeSQLiteDb(path, ECDb::OpenParams(Db::OpenMode::Readonly)));
+    IConnectionPtr connection = m_connections.NotifyConnectionOpened(db);
+
+    auto factory = NodesCache::DbFactory::Create(*connection, m_directory, NodesCacheType::Disk, 0, nullptr, true);
+    EXPECT_FALSE(factory->IsSharedByChangeset());
+
+    factory = nullptr;
+    m_connections.NotifyConnectionClosed(*connection);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, DeletesCachesSharedByOtherChangesets)
+    {
+    s_project->GetECDb().SaveChanges();
+    BeFileName oldPath = CreateIModelCopyAtChangeset(BeFileName(s_project->GetECDbPath()), m_directory, L"OldChangeset.ecdb", "1111111111111111111111111111111111111111");
+    BeFileName newPath = CreateIModelCopyAtChangeset(BeFileName(s_project->GetECDbPath()), m_directory, L"NewChangeset.ecdb", "2222222222222222222222222222222222222222");
+
+    BeFileName oldCachePath;
+    {
+    ECDb db;
+    ASSERT_EQ(BE_SQLITE_OK, db.OpenBeSQLiteDb(oldPath, ECDb::OpenParams(Db::OpenMode::Readonly)));
+    IConnectionPtr connection = m_connections.NotifyConnectionOpened(db);
+    auto factory = NodesCache::DbFactory::Create(*connection, m_directory, NodesCacheType::Disk, 0, nullptr, true);
+    ASSERT_TRUE(factory->IsSharedByChangeset());
+    oldCachePath = BeFileName(factory->GetCachePath());
+    factory = nullptr;
+    m_connections.NotifyConnectionClosed(*connection);
+    }
+    EXPECT_TRUE(oldCachePath.DoesPathExist());
+
+    ECDb db;
+    ASSERT_EQ(BE_SQLITE_OK, db.OpenBeSQLiteDb(newPath, ECDb::OpenParams(Db::OpenMode::Readonly)));
+    IConnectionPtr connection = m_connections.NotifyConnectionOpened(db);
+    auto factory = NodesCache::DbFactory::Create(*connection, m_directory, NodesCacheType::Disk, 0, nullptr, true);
+    ASSERT_TRUE(factory->IsSharedByChangeset());
+    EXPECT_TRUE(BeFileName(factory->GetCachePath()).DoesPathExist());
+    EXPECT_FALSE(oldCachePath.DoesPathExist());
+
+    factory = nullptr;
+    m_connections.NotifyConnectionClosed(*connection);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DiskNodesCacheLocationTests, DetachedCacheDoesntWriteToSharedCache)
+    {
+    s_project->GetECDb().SaveChanges();
+    BeFileName path = CreateIModelCopyAtChangeset(BeFileName(s_project->GetECDbPath()), m_directory, L"InFlightCopy.ecdb", "3333333333333333333333333333333333333333");
+
+    ECDb db;
+    ASSERT_EQ(BE_SQLITE_OK, db.OpenBeSQLiteDb(path, ECDb::OpenParams(Db::OpenMode::Readonly)));
+    IConnectionPtr connection = m_connections.NotifyConnectionOpened(db);
+
+    auto factory = NodesCache::DbFactory::Create(*connection, m_directory, NodesCacheType::Disk, 0, nullptr, true);
+    ASSERT_TRUE(factory->IsSharedByChangeset());
+    auto cache = NodesCache::Create(factory, m_nodesFactory, m_nodesProviderContextFactory, m_providersFactory, true);
+
+    // a transaction that's in progress when the cache gets detached is not committed
+    PresentationRuleSetPtr inFlightRuleset = PresentationRuleSet::CreateInstance("InFlightRuleset");
+    auto savepoint = cache->CreateSavepoint();
+    cache->OnRulesetUsed(*inFlightRuleset);
+    factory->Detach();
+    savepoint = nullptr;
+
+    // and nothing is written after that
+    PresentationRuleSetPtr laterRuleset = PresentationRuleSet::CreateInstance("LaterRuleset");
+    cache->OnRulesetUsed(*laterRuleset);
+    EXPECT_TRUE(cache->IsDetached());
+    cache = nullptr;
+
+    Db cacheDb;
+    ASSERT_EQ(BE_SQLITE_OK, cacheDb.OpenBeSQLiteDb(BeFileName(factory->GetCachePath()), Db::OpenParams(Db::OpenMode::Readonly)));
+    Statement stmt;
+    ASSERT_EQ(BE_SQLITE_OK, stmt.Prepare(cacheDb, "SELECT 1 FROM [" NODESCACHE_TABLENAME_Rulesets "]"));
+    EXPECT_EQ(BE_SQLITE_DONE, stmt.Step());
+
+    stmt.Finalize();
+    cacheDb.CloseDb();
+    factory = nullptr;
+    m_connections.NotifyConnectionClosed(*connection);
+    }
+
 /*=================================================================================**//**
 * @bsiclass
 +===============+===============+===============+===============+===============+======*/
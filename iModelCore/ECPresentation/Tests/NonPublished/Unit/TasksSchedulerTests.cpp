@@ -317,6 +317,174 @@ TEST_F(ECPresentationTasksQueueTests, Cancel_CancelsOnlyCancelableTasks)
     EXPECT_TRUE(m_queue.HasTasks());
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ECPresentationTasksQueueTests, Get_ReturnsTasksWithMatchingDependencyInFIFOModeByPriority)
+    {
+    auto task1 = CreateTask();
+    task1->SetDependencies({ std::make_shared<TaskDependencyOnConnection>("a") });
+    task1->SetPriority(1);
+    m_queue.Add(*task1);
+
+    auto task2 = CreateTask();
+    task2->SetDependencies({ std::make_shared<TaskDependencyOnConnection>("b") });
+    m_queue.Add(*task2);
+
+    auto task3 = CreateTask();
+    task3->SetDependencies({ std::make_shared<TaskDependencyOnRuleset>("r"), std::make_shared<TaskDependencyOnConnection>("*") });
+    task3->SetPriority(1);
+    m_queue.Add(*task3);
+
+    auto task4 = CreateTask();
+    task4->SetDependencies({ std::make_shared<TaskDependencyOnConnection>("a") });
+    task4->SetPriority(2);
+    m_queue.Add(*task4);
+
+    auto tasks = m_queue.Get(TaskDependencyOnConnection("a"));
+    ASSERT_EQ(3, tasks.size());
+    EXPECT_EQ(task4, tasks[0]);
+    EXPECT_EQ(task1, tasks[1]);
+    EXPECT_EQ(task3, tasks[2]);
+
+    tasks = m_queue.Get(TaskDependencyOnRuleset("r"));
+    ASSERT_EQ(1, tasks.size());
+    EXPECT_EQ(task3, tasks[0]);
+
+    tasks = m_queue.Get(TaskDependencyOnConnection("a"), [&](IECPresentationTaskCR task){return task.GetPriority() == 1;});
+    ASSERT_EQ(2, tasks.size());
+    EXPECT_EQ(task1, tasks[0]);
+    EXPECT_EQ(task3, tasks[1]);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ECPresentationTasksQueueTests, Cancel_RemovesFromQueueTasksWithMatchingDependency)
+    {
+    auto task1 = CreateCancelableTask();
+    task1->SetDependencies({ std::make_shared<TaskDependencyOnRuleset>("a") });
+    m_queue.Add(*task1);
+
+    auto task2 = CreateCancelableTask();
+    task2->SetDependencies({ std::make_shared<TaskDependencyOnRuleset>("b") });
+    m_queue.Add(*task2);
+
+    auto result = m_queue.Cancel(TaskDependencyOnRuleset("b"));
+    ASSERT_EQ(1, result.GetTasks().size());
+    EXPECT_EQ(task2.get(), result.GetTasks().begin()->get());
+    EXPECT_TRUE(result.GetCompletion().hasValue());
+
+    EXPECT_FALSE(task1->GetCancelationToken()->IsCanceled());
+    EXPECT_TRUE(task2->GetCancelationToken()->IsCanceled());
+
+    EXPECT_EQ(1, m_queue.GetTasksCount());
+    EXPECT_TRUE(m_queue.Get(TaskDependencyOnRuleset("b")).empty());
+    EXPECT_EQ(task1, m_queue.Pop());
+    EXPECT_FALSE(m_queue.HasTasks());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ECPresentationTasksQueueTests, Pop_SkipsPriorityBucketsRejectedByPriorityFilter)
+    {
+    auto task1 = CreateTask();
+    task1->SetPriority(2);
+    m_queue.Add(*task1);
+
+    auto task2 = CreateTask();
+    task2->SetPriority(1);
+    m_queue.Add(*task2);
+
+    bvector<int> checkedPriorities;
+    auto priorityFilter = [&](int priority){checkedPriorities.push_back(priority); return priority < 2;};
+    EXPECT_EQ(task2, m_queue.Pop(priorityFilter, nullptr));
+    EXPECT_EQ(bvector<int>({ 2, 1 }), checkedPriorities);
+    EXPECT_TRUE(m_queue.Pop(priorityFilter, nullptr).IsNull());
+    EXPECT_EQ(task1, m_queue.Pop());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ECPresentationTasksQueueTests, Pop_WithCursorDoesntRetestRejectedTasks)
+    {
+    auto task1 = CreateTask();
+    m_queue.Add(*task1);
+    auto task2 = CreateTask();
+    m_queue.Add(*task2);
+    auto task3 = CreateTask();
+    m_queue.Add(*task3);
+
+    bvector<IECPresentationTaskCP> testedTasks;
+    auto filter = [&](IECPresentationTaskCR task){testedTasks.push_back(&task); return &task != task1.get();};
+    IECPresentationTasksQueue::PopCursor cursor;
+    EXPECT_EQ(task2, m_queue.Pop(nullptr, filter, &cursor));
+    EXPECT_EQ(bvector<IECPresentationTaskCP>({ task1.get(), task2.get() }), testedTasks);
+
+    // task1 was rejected using this cursor - it's not tested again, but a newly added task is
+    testedTasks.clear();
+    auto task4 = CreateTask();
+    m_queue.Add(*task4);
+    EXPECT_EQ(task3, m_queue.Pop(nullptr, filter, &cursor));
+    EXPECT_EQ(task4, m_queue.Pop(nullptr, filter, &cursor));
+    EXPECT_TRUE(m_queue.Pop(nullptr, filter, &cursor).IsNull());
+    EXPECT_EQ(bvector<IECPresentationTaskCP>({ task3.get(), task4.get() }), testedTasks);
+
+    // without a cursor all tasks are tested
+    testedTasks.clear();
+    EXPECT_TRUE(m_queue.Pop(nullptr, filter).IsNull());
+    EXPECT_EQ(bvector<IECPresentationTaskCP>({ task1.get() }), testedTasks);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ECPresentationTasksQueueTests, Pop_RecordsQueueWaitTime)
+    {
+    Diagnostics::Histogram& histogram = Diagnostics::GetHistogram(DIAGNOSTICS_HISTOGRAM_TasksQueueWait);
+    histogram.Reset();
+
+    auto task1 = CreateTask();
+    m_queue.Add(*task1);
+    auto task2 = CreateTask();
+    m_queue.Add(*task2);
+    EXPECT_EQ(0, histogram.GetCount());
+
+    m_queue.Pop();
+    m_queue.Pop();
+    EXPECT_EQ(2, histogram.GetCount());
+
+    rapidjson::Document json = Diagnostics::GetHistogramsJson();
+    ASSERT_TRUE(json.HasMember(DIAGNOSTICS_HISTOGRAM_TasksQueueWait));
+    EXPECT_EQ(2, json[DIAGNOSTICS_HISTOGRAM_TasksQueueWait]["count"].GetUint64());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ECPresentationTasksQueueTests, Histogram_BucketsValuesByPowersOfTwo)
+    {
+    Diagnostics::Histogram histogram("test");
+    histogram.Record(0);
+    histogram.Record(1);
+    histogram.Record(5);
+    histogram.Record(7);
+    histogram.Record(8);
+    EXPECT_EQ(5, histogram.GetCount());
+    EXPECT_EQ(21, histogram.GetSum());
+    EXPECT_EQ(8, histogram.GetMax());
+    EXPECT_EQ(1, histogram.GetBucketCount(0));
+    EXPECT_EQ(1, histogram.GetBucketCount(1));
+    EXPECT_EQ(2, histogram.GetBucketCount(3));
+    EXPECT_EQ(1, histogram.GetBucketCount(4));
+
+    histogram.Reset();
+    EXPECT_EQ(0, histogram.GetCount());
+    EXPECT_EQ(0, histogram.GetBucketCount(3));
+    }
+
 /*=================================================================================**//**
 * @bsiclass
 +===============+===============+===============+===============+===============+======*/
@@ -588,6 +756,58 @@ TEST_F(ECPresentationTasksSchedulerExecutionTests, Schedule_DoesntExecuteTasksWh
     EXPECT_TRUE(m_scheduler->GetRunningTasks().empty());
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsitest
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(ECPresentationTasksSchedulerExecutionTests, Schedule_TestsOnlyRunningTasksWithBlockedDependency)
+    {
+    m_scheduler->SetThreadAllocationsMap(CreateSimpleAllocationsMap(3));
+
+    auto task1 = CreateTask();
+    task1->SetDependencies(TaskDependencies{std::make_shared<TaskDependencyOnRuleset>("a")});
+    auto task2 = CreateTask();
+    m_scheduler->Schedule(*task1);
+    m_scheduler->Schedule(*task2);
+    EXPECT_EQ(2, m_scheduler->GetRunningTasks().size());
+
+    // task3 blocks tasks depending on ruleset "a" - only task1 has to be tested
+    bset<IECPresentationTask const*> testedTasks;
+    auto task3 = CreateTask();
+    task3->SetOtherTasksBlockingPredicate([&](IECPresentationTaskCR task)
+        {
+        testedTasks.insert(&task);
+        return task.GetDependencies().Has(TaskDependencyOnRuleset("a"));
+        }, std::make_shared<TaskDependencyOnRuleset>("a"));
+    m_scheduler->Schedule(*task3);
+    EXPECT_EQ(1, m_scheduler->GetPendingTasks().size());
+    EXPECT_TRUE(testedTasks.end() != testedTasks.find(task1.get()));
+    EXPECT_TRUE(testedTasks.end() == testedTasks.find(task2.get()));
+
+    // task4 blocks tasks depending on ruleset "b" - there are none, so it runs without testing any running task
+    bool task4Tested = false;
+    auto task4 = CreateTask();
+    task4->SetOtherTasksBlockingPredicate([&](IECPresentationTaskCR task)
+        {
+        task4Tested = true;
+        return task.GetDependencies().Has(TaskDependencyOnRuleset("b"));
+        }, std::make_shared<TaskDependencyOnRuleset>("b"));
+    m_scheduler->Schedule(*task4);
+    EXPECT_TRUE(m_scheduler->GetRunningTasks().end() != m_scheduler->GetRunningTasks().find(task4));
+    EXPECT_FALSE(task4Tested);
+
+    // once task1 completes, task3 is no longer blocked
+    m_executor.drive();
+    EXPECT_TRUE(task1->GetCompletion().poll().hasValue());
+    EXPECT_TRUE(m_scheduler->GetPendingTasks().empty());
+    EXPECT_TRUE(m_scheduler->GetRunningTasks().end() != m_scheduler->GetRunningTasks().find(task3));
+
+    // let task2, task4 and task3 complete
+    m_executor.drive();
+    m_executor.drive();
+    m_executor.drive();
+    EXPECT_TRUE(m_scheduler->GetRunningTasks().empty());
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsitest
 +---------------+---------------+---------------+---------------+---------------+------*/
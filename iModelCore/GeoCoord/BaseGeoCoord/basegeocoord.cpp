@@ -21,10 +21,21 @@
 #else
 # include <unistd.h>
 #endif
+#if defined (BENTLEY_WIN32)
+# ifndef NOMINMAX
+#  define NOMINMAX
+# endif
+# include <windows.h>
+#elif !defined (BENTLEY_WINRT)
+# include <sys/mman.h>
+#endif
 #include <GeoCoord/BaseGeoTiffKeysList.h>
 #include    <BeXml/BeXml.h>
 #include <algorithm>
 #include <cctype>
+#include <future>
+#include <mutex>
+#include <thread>
 
 // cs_wkt requires __CPP__ to be defined and the class TrcWktElement to be defined (what's up with that?)
 #define __CPP__
@@ -35,8 +46,8 @@ class TrcWktElement;
 USING_NAMESPACE_BENTLEY_LOGGING
 
 BEGIN_EXTERN_C
- extern int      cs_Error;
- extern char     csErrnam[];
+ extern csTHREAD_LOCAL int      cs_Error;
+ extern csTHREAD_LOCAL char     csErrnam[];
  extern struct   cs_Unittab_     cs_Unittab[];
  extern struct   cs_PrjprmMap_   cs_PrjprmMap[];
  extern struct   cs_Prjtab_      cs_Prjtab[];
@@ -581,8 +592,8 @@ StatusInt     FindGCSNameFromEPSGCode(Utf8String& outName, uint16_t epsgCode)
     if (0 == epsgCode)
         return ERROR;
 
- //   static std::mutex EPSGCacheMutex;
- //   std::lock_guard<std::mutex> EPSGCacheLock(EPSGCacheMutex);
+    static std::mutex EPSGCacheMutex;
+    std::lock_guard<std::mutex> EPSGCacheLock(EPSGCacheMutex);
 
     static bool cacheComplete = false;
     static uint32_t cacheNextIndex = 0;
@@ -1068,9 +1079,8 @@ bool FindDatumFromTransformationParams(Utf8String& paramDatumName, const Utf8Str
         return true;
         }
 
-// To be activated once we go thread safe
-// static std::mutex transformCacheMutex;
-// std::lock_guard<std::mutex> transformCacheLock(transformCacheMutex);
+    static std::mutex transformCacheMutex;
+    std::lock_guard<std::mutex> transformCacheLock(transformCacheMutex);
     static bool cacheComplete = false;
     static uint32_t cacheNextIndex = 0;
     static bmap<TransformParams, Utf8String> transformCache;
@@ -8371,6 +8381,18 @@ typedef struct VerticalDatumConverter *             VerticalDatumConverterP;
 typedef struct VerticalDatumConverter&              VerticalDatumConverterR;
 typedef struct VerticalDatumConverter const&        VerticalDatumConverterCR;
 
+/*---------------------------------------------------------------------------------**//**
+* Serializes access to the state CS-MAP keeps in globals rather than in the converters:
+* the dictionaries read while a datum converter is set up, and the geoid and VERTCON
+* grids used by vertical datum conversions.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static std::recursive_mutex& getCSMapSharedStateMutex()
+    {
+    static std::recursive_mutex s_csMapSharedStateMutex;
+    return s_csMapSharedStateMutex;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -8441,6 +8463,7 @@ VertDatumCode outputVdc
     if (!BaseGCS::IsLibraryInitialized())
         return;
 
+    std::lock_guard<std::recursive_mutex> lock(getCSMapSharedStateMutex());
     CSvrtconCls();
     CS_geoidCls();
     }
@@ -8460,6 +8483,8 @@ GeoPointCR  inLatLong
     if (!BaseGCS::IsLibraryInitialized())
         return GEOCOORDERR_GeoCoordNotInitialized;
 
+    std::lock_guard<std::recursive_mutex> lock(getCSMapSharedStateMutex());
+
     // The process of datum conversion can be complex here depending on the set of in/out
     // vertical datums. Note that the vdcFromDatum value indicates that the ellipsoidal height is
     // used. This height is related to the horizontal datum and conversion may be necessary
@@ -8983,6 +9008,341 @@ struct GeoCoordWorkspaces {
 static bool s_loadLocalFiles = true;
 void BaseGCS::EnableLocalGcsFiles(bool yesNo) { s_loadLocalFiles = yesNo; }
 
+//=======================================================================================
+// Read-only image of a grid shift file. Files from the assets directory are memory mapped,
+// workspace resources (and files that cannot be mapped) are loaded in memory once.
+// @bsiclass
+//=======================================================================================
+struct GridFileImage : RefCountedBase, NonCopyableClass {
+    Byte const* m_data = nullptr;
+    size_t m_size = 0;
+    bvector<Byte> m_contents;
+#if defined (BENTLEY_WIN32)
+    HANDLE m_mapping = nullptr;
+#elif !defined (BENTLEY_WINRT)
+    bool m_mapped = false;
+#endif
+
+    ~GridFileImage() {
+#if defined (BENTLEY_WIN32)
+        if (nullptr != m_mapping) {
+            UnmapViewOfFile(m_data);
+            CloseHandle(m_mapping);
+        }
+#elif !defined (BENTLEY_WINRT)
+        if (m_mapped)
+            munmap((void*)m_data, m_size);
+#endif
+    }
+
+    bool Map(FILE* file) {
+#if defined (BENTLEY_WIN32)
+        HANDLE fileHandle = (HANDLE)_get_osfhandle(_fileno(file));
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || 0 == fileSize.QuadPart)
+            return false;
+        if (nullptr == (m_mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr)))
+            return false;
+        if (nullptr == (m_data = (Byte const*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0))) {
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+            return false;
+        }
+        m_size = (size_t)fileSize.QuadPart;
+        return true;
+#elif !defined (BENTLEY_WINRT)
+        struct stat fileStat;
+        if (0 != fstat(_fileno(file), &fileStat) || 0 >= fileStat.st_size)
+            return false;
+        void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, _fileno(file), 0);
+        if (MAP_FAILED == data)
+            return false;
+        m_data = (Byte const*)data;
+        m_size = (size_t)fileStat.st_size;
+        m_mapped = true;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool Load(FILE* file) {
+        if (0 != fseek(file, 0, SEEK_END))
+            return false;
+        long fileSize = ftell(file);
+        if (0 >= fileSize || 0 != fseek(file, 0, SEEK_SET))
+            return false;
+        m_contents.resize((size_t)fileSize);
+        if (m_contents.size() != fread(m_contents.data(), 1, m_contents.size(), file))
+            return false;
+        m_data = m_contents.data();
+        m_size = m_contents.size();
+        return true;
+    }
+
+    bool Load(_csFile& file) {
+        if (0 != file.seek(0, SEEK_END))
+            return false;
+        int64_t fileSize = file.tell();
+        if (0 >= fileSize || 0 != file.seek(0, SEEK_SET))
+            return false;
+        m_contents.resize((size_t)fileSize);
+        if (m_contents.size() != file.read(m_contents.data(), 1, m_contents.size()))
+            return false;
+        m_data = m_contents.data();
+        m_size = m_contents.size();
+        return true;
+    }
+};
+DEFINE_REF_COUNTED_PTR(GridFileImage);
+
+//=======================================================================================
+// A grid shift file opened by CS-MAP, read from a cached GridFileImage. Each open gets its
+// own position so several transforms may read the same image at once.
+// @bsiclass
+//=======================================================================================
+struct GridFileView : _csFile {
+    GridFileImagePtr m_image;
+    int64_t m_offset = 0;
+
+    GridFileView(GridFileImage& image) : m_image(&image) {}
+    virtual size_t read(void* buffer, size_t size, size_t count) override {
+        if (0 == size || m_offset >= (int64_t)m_image->m_size)
+            return 0;
+        size_t available = (m_image->m_size - (size_t)m_offset) / size;
+        if (count > available)
+            count = available;
+        memcpy(buffer, m_image->m_data + m_offset, size * count);
+        m_offset += size * count;
+        return count;
+    }
+    virtual int seek(int64_t offset, int origin) override {
+        switch (origin) {
+        case SEEK_END:
+            offset += m_image->m_size;
+            break;
+        case SEEK_CUR:
+            offset += m_offset;
+            break;
+        }
+        if (0 > offset)
+            return -1;
+        m_offset = offset;
+        return 0;
+    }
+    virtual int getc() override {
+        unsigned char c;
+        return 1 == read(&c, 1, 1) ? c : EOF;
+    }
+    virtual char* gets(char* s, int n) override {
+        int ch = EOF;
+        char* p = s;
+        while (s - p < n - 1 && (ch = getc()) != EOF) {
+            *s++ = (char)ch;
+            if (ch == '\n')
+                break;
+        }
+        *s = '\0';
+        return (ch == EOF && p == s) ? nullptr : p;
+    }
+    virtual int64_t tell() override { return m_offset; }
+    virtual int close() override { return 0; }
+    virtual int setvbuf(char* buffer, int mode, size_t size) override { return 0; }
+    virtual int eof() override { return m_offset >= (int64_t)m_image->m_size; }
+    virtual int error() override { return 0; }
+    int readonly() {
+        BeAssert(false && "grid files are always readonly");
+        return 0;
+    }
+    virtual int flush() override { return readonly(); }
+    virtual int putc(int character) override { return readonly(); }
+    virtual int puts(const char* str) override { return readonly(); }
+    virtual size_t write(const void* ptr, size_t size, size_t count) override { return readonly(); }
+    virtual int truncate(long writePosition) override { return readonly(); }
+    virtual int printf(Utf8CP format...) override { return readonly(); }
+};
+
+//=======================================================================================
+// Process-wide cache of the grid shift files read by datum transforms. CS-MAP opens, reads
+// in small pieces and releases grid files repeatedly; with the cache every open after the
+// first one for a given file is served from the same image without touching the file.
+// Images of local files are checked against the file's modification time and size on every
+// open, and reloaded if the file changed. The least recently used images are dropped when
+// the cached images exceed the size limit.
+// @bsiclass
+//=======================================================================================
+struct GridFileCache {
+    struct Entry {
+        GridFileImagePtr m_image;
+        bool m_fromWorkspace = false;   // workspace resources don't change while the workspace is open, so they're not checked
+        int64_t m_fileTime = 0;         // modification time and size of the local file when it was read, 0 if unknown
+        int64_t m_fileSize = 0;
+        uint64_t m_lastUse = 0;
+    };
+
+    static std::mutex& GetMutex() {
+        static std::mutex s_mutex;
+        return s_mutex;
+    }
+    static bmap<Utf8String, Entry>& GetEntries() {
+        static bmap<Utf8String, Entry> s_entries;
+        return s_entries;
+    }
+    static BaseGCS::GridFileCacheStatistics& GetStatistics() {
+        static BaseGCS::GridFileCacheStatistics s_statistics;
+        return s_statistics;
+    }
+    static size_t& GetMaxBytes() {
+        static size_t s_maxBytes = 256 * 1024 * 1024;
+        return s_maxBytes;
+    }
+
+    // Only the binary grid files distributed with the GCS data are cached. Dictionaries and files CS-MAP generates from text sources are not.
+    static bool IsGridFile(Utf8CP filename) {
+        static Utf8CP s_gridExtensions[] = {"gsb", "las", "los", "geo", "bin", "byn", "gtx"};
+        Utf8CP extension = strrchr(filename, '.');
+        if (nullptr == extension || nullptr != strpbrk(extension, "/\\"))
+            return false;
+        for (Utf8CP gridExtension : s_gridExtensions) {
+            if (0 == BeStringUtilities::StricmpAscii(extension + 1, gridExtension))
+                return true;
+        }
+        return false;
+    }
+
+    // Get the modification time and size of a local grid file. Returns false if the file can't be found under that exact name.
+    static bool GetFileStamp(Utf8CP filename, int64_t& fileTime, int64_t& fileSize) {
+        struct _stat statBufr;
+        if (0 != _stat(toAssetName(filename).c_str(), &statBufr))
+            return false;
+        fileTime = (int64_t)statBufr.st_mtime;
+        fileSize = (int64_t)statBufr.st_size;
+        return true;
+    }
+
+    static bool LoadImage(Entry& entry, Utf8CP filename) {
+        GridFileImagePtr image = new GridFileImage();
+        std::unique_ptr<_csFile> wsFile(GeoCoordWorkspaces::FindResource(filename));
+        if (nullptr != wsFile) {
+            bool loaded = image->Load(*wsFile);
+            wsFile->close();
+            if (!loaded)
+                return false;
+            entry.m_image = image;
+            entry.m_fromWorkspace = true;
+            return true;
+        }
+
+        if (!s_loadLocalFiles)
+            return false;
+
+        FILE* file = CS_fopen_caseInsensitive(toAssetName(filename).c_str(), "rb");
+        if (nullptr == file)
+            return false;
+
+        bool loaded = image->Map(file) || image->Load(file);
+        fclose(file);
+        if (!loaded)
+            return false;
+        entry.m_image = image;
+        entry.m_fromWorkspace = false;
+        if (!GetFileStamp(filename, entry.m_fileTime, entry.m_fileSize))
+            entry.m_fileTime = entry.m_fileSize = 0;
+        return true;
+    }
+
+    // An image of a local file is stale if the file's modification time or size changed since it was read.
+    static bool IsStale(Entry const& entry, Utf8CP filename) {
+        if (entry.m_fromWorkspace || (0 == entry.m_fileTime && 0 == entry.m_fileSize))
+            return false;
+        int64_t fileTime, fileSize;
+        if (!GetFileStamp(filename, fileTime, fileSize))
+            return false;
+        return fileTime != entry.m_fileTime || fileSize != entry.m_fileSize;
+    }
+
+    // Must be called with the mutex held.
+    static void Remove(bmap<Utf8String, Entry>::iterator iter) {
+        auto& statistics = GetStatistics();
+        --statistics.m_numFiles;
+        statistics.m_numBytes -= iter->second.m_image->m_size;
+        GetEntries().erase(iter);
+    }
+
+    // Drop least recently used images until the cache fits its size limit. The most recently used image is always kept.
+    // Must be called with the mutex held.
+    static void Trim() {
+        auto& entries = GetEntries();
+        auto& statistics = GetStatistics();
+        while (statistics.m_numBytes > GetMaxBytes() && entries.size() > 1) {
+            auto oldest = entries.begin();
+            for (auto iter = entries.begin(); iter != entries.end(); ++iter) {
+                if (iter->second.m_lastUse < oldest->second.m_lastUse)
+                    oldest = iter;
+            }
+            Remove(oldest);
+            ++statistics.m_evictions;
+        }
+    }
+
+    // Returns nullptr if filename is not a grid file or cannot be read, in which case it is opened as any other GCS file.
+    static _csFile* Open(Utf8CP filename) {
+        if (!IsGridFile(filename))
+            return nullptr;
+
+        static uint64_t s_useCounter = 0;
+        std::lock_guard<std::mutex> lock(GetMutex());
+        auto& entries = GetEntries();
+        auto& statistics = GetStatistics();
+        auto found = entries.find(filename);
+        if (found != entries.end()) {
+            if (!IsStale(found->second, filename)) {
+                ++statistics.m_hits;
+                found->second.m_lastUse = ++s_useCounter;
+                return new GridFileView(*found->second.m_image);
+            }
+            Remove(found);
+        }
+
+        Entry entry;
+        if (!LoadImage(entry, filename))
+            return nullptr;
+
+        ++statistics.m_misses;
+        ++statistics.m_numFiles;
+        statistics.m_numBytes += entry.m_image->m_size;
+        entry.m_lastUse = ++s_useCounter;
+        GridFileImagePtr image = entry.m_image;
+        entries[filename] = entry;
+        Trim();
+        return new GridFileView(*image);
+    }
+
+    static void Clear() {
+        std::lock_guard<std::mutex> lock(GetMutex());
+        GetEntries().clear();
+        GetStatistics().m_numFiles = 0;
+        GetStatistics().m_numBytes = 0;
+    }
+
+    static void SetMaxBytes(size_t maxBytes) {
+        std::lock_guard<std::mutex> lock(GetMutex());
+        GetMaxBytes() = maxBytes;
+        Trim();
+    }
+};
+
+BaseGCS::GridFileCacheStatistics BaseGCS::GetGridFileCacheStatistics() {
+    std::lock_guard<std::mutex> lock(GridFileCache::GetMutex());
+    BaseGCS::GridFileCacheStatistics statistics = GridFileCache::GetStatistics();
+    statistics.m_maxBytes = GridFileCache::GetMaxBytes();
+    return statistics;
+}
+
+void BaseGCS::ClearGridFileCache() { GridFileCache::Clear(); }
+
+void BaseGCS::SetGridFileCacheMaxBytes(size_t maxBytes) { GridFileCache::SetMaxBytes(maxBytes); }
+
 /** Add a new entry to the list of gcs WorkspaceDbs */
 bool BaseGCS::AddWorkspaceDb(Utf8String dbName, CloudContainerP container, int priority) {
     WorkspaceDbPtr newDb = new WorkspaceDb(priority, dbName, container);
@@ -9209,34 +9569,120 @@ void BaseGCS::InitHorizontal() {
     m_foundEPSGCode                 = 0;
 }
 
+#define MIN_POINTS_PER_CONVERSION_WORKER 4096
+
 /*---------------------------------------------------------------------------------**//**
+* Guards the links between a BaseGCS and the BaseGCS that cache it as their target
+* (m_targetGCS and m_listOfPointingGCS). No other lock is acquired while it is held.
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-void BaseGCS::Clear() {
+static std::recursive_mutex& getDestinationLinksMutex()
+    {
+    static std::recursive_mutex s_destinationLinksMutex;
+    return s_destinationLinksMutex;
+    }
 
-    if (m_targetGCS != NULL)
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool isCachedTarget(BaseGCSCP const& cachedTargetGCS, BaseGCSCR targetGCS)
+    {
+    std::lock_guard<std::recursive_mutex> lock(getDestinationLinksMutex());
+    return &targetGCS == cachedTargetGCS;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Combines the status of a conversion step with the status of the previous steps.
+* The hardest error is the first one encountered that is not a warning (value 1 [REPROJECT_CSMAPERR_OutOfUsefulRange])
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static ReprojectStatus combineReprojectStatus(ReprojectStatus status, ReprojectStatus stepStatus)
+    {
+    if ((REPROJECT_Success == stepStatus) || ((REPROJECT_Success != status) && (REPROJECT_CSMAPERR_OutOfUsefulRange != status) && (REPROJECT_CSMAPERR_VerticalDatumConversionError != status)))
+        return status;
+
+    if (0 > stepStatus) // If stepStatus is negative ... this is the one ...
+        return stepStatus;
+
+    // Both are positive (status may be REPROJECT_Success) we use the highest value which is either warning or error
+    return (stepStatus > status ? stepStatus : status);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static ReprojectStatus combineReprojectStatus(ReprojectStatus const* statuses, size_t numPoints)
+    {
+    ReprojectStatus status = REPROJECT_Success;
+    for (size_t i = 0; i < numPoints; ++i)
+        status = combineReprojectStatus(status, statuses[i]);
+
+    return status;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Reports the same status for all points of an array conversion.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static ReprojectStatus setReprojectStatus(ReprojectStatus* statuses, size_t numPoints, ReprojectStatus status)
+    {
+    if (NULL != statuses)
+        std::fill(statuses, statuses + numPoints, status);
+
+    return status;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Calls convertRange(start, end) over consecutive ranges covering numPoints points. Large
+* arrays are split in one range per available core, the ranges being converted concurrently.
+* convertRange must only use the const state of the projection (cs_Csprm_) which CS-MAP does
+* not modify while converting.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+template <typename RangeConverter> static void convertPointRanges(size_t numPoints, RangeConverter const& convertRange)
+    {
+    size_t numWorkers = std::min((size_t) std::thread::hardware_concurrency(), numPoints / MIN_POINTS_PER_CONVERSION_WORKER);
+    if (numWorkers < 2)
         {
-        m_targetGCS->UnRegisterIsADestinationOf(*this);
-        m_targetGCS = NULL;
+        convertRange(0, numPoints);
+        return;
         }
 
-    if (NULL != m_datumConverter)
+    size_t pointsPerWorker = (numPoints + numWorkers - 1) / numWorkers;
+    bvector<std::future<void>> workers;
+    for (size_t start = pointsPerWorker; start < numPoints; start += pointsPerWorker)
         {
-        m_datumConverter->Destroy();
-        m_datumConverter = NULL;
+        size_t end = std::min(start + pointsPerWorker, numPoints);
+        workers.push_back(std::async(std::launch::async, [&convertRange, start, end]() {convertRange(start, end);}));
         }
 
+    convertRange(0, pointsPerWorker);
+    for (auto& worker : workers)
+        worker.get();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void BaseGCS::Clear() {
+
+    ClearConverterCache();
+
     if (m_datum != nullptr)
         {
         m_datum->Destroy();
         m_datum = nullptr;
         }
 
-    // Clear the link between other BaseGCS to this one used as a cached targets
-    for (size_t i = 0 ; i < m_listOfPointingGCS.size() ; i++)
-        m_listOfPointingGCS[i]->ClearCache();
+    // Clear the link between other BaseGCS to this one used as a cached targets.
+    // Their datum converters are rebuilt the next time they are used.
+        {
+        std::lock_guard<std::recursive_mutex> linksLock(getDestinationLinksMutex());
+        for (size_t i = 0 ; i < m_listOfPointingGCS.size() ; i++)
+            m_listOfPointingGCS[i]->m_targetGCS = NULL;
 
-    m_listOfPointingGCS.clear();
+        m_listOfPointingGCS.clear();
+        }
 
     CSMAP_FREE_AND_CLEAR (m_csParameters);
 
@@ -11226,26 +11672,51 @@ ReprojectStatus BaseGCS::CartesianFromCartesian(DPoint3dR outCartesian, DPoint3d
 
     stat3 = targetGCS.CartesianFromLatLong(outCartesian, outLatLong);
 
-    if (REPROJECT_Success == status)
+    // Status returns hardest error found in the three error statuses
+    status = combineReprojectStatus(status, stat1);
+    status = combineReprojectStatus(status, stat2);
+    status = combineReprojectStatus(status, stat3);
+
+    return status;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* CartesianFromCartesian - Converts an array of points from the Cartesian representation
+* of a GCS to the Cartesian of the target. The datum conversion is done in a single
+* locked pass while the projection steps are split across workers for large arrays.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ReprojectStatus BaseGCS::CartesianFromCartesian(DPoint3dP outCartesian, ReprojectStatus* outStatus, DPoint3dCP inCartesian, size_t numPoints, BaseGCSCR targetGCS) const
+    {
+    // Given the library is NOT initialized ...
+    if (!IsLibraryInitialized())
         {
-        // Status returns hardest error found in the three error statuses
-        // The hardest error is the first one encountered that is not a warning (value 1 [REPROJECT_CSMAPERR_OutOfUsefulRange])
-        if (REPROJECT_Success != stat1)
-            status = stat1;
-        if ((REPROJECT_Success != stat2) && ((REPROJECT_Success == status) || (REPROJECT_CSMAPERR_OutOfUsefulRange == status) || (REPROJECT_CSMAPERR_VerticalDatumConversionError == status))) // If stat2 has error and status not already hard error
-            {
-            if (0 > stat2) // If stat2 is negative ... this is the one ...
-                status = stat2;
-            else  // Both are positive (status may be REPROJECT_Success) we use the highest value which is either warning or error
-                status = (stat2 > status ? stat2 : status);
-            }
-        if ((REPROJECT_Success != stat3) && ((REPROJECT_Success == status) || (REPROJECT_CSMAPERR_OutOfUsefulRange == status) || (REPROJECT_CSMAPERR_VerticalDatumConversionError == status))) // If stat3 has error and status not already hard error
-            {
-            if (0 > stat3) // If stat3 is negative ... this is the one ...
-                status = stat3;
-            else  // Both are positive (status may be SUCCESS) we use the highest value
-                status = (stat3 > status ? stat3 : status);
-            }
+        m_csError = GEOCOORDERR_GeoCoordNotInitialized;
+        return setReprojectStatus(outStatus, numPoints, (ReprojectStatus)m_csError);
+        }
+
+    if ((NULL == m_csParameters) || (NULL == targetGCS.m_csParameters))
+        return setReprojectStatus(outStatus, numPoints, (ReprojectStatus)GEOCOORDERR_InvalidCoordSys);
+
+    bvector<GeoPoint> inLatLong(numPoints);
+    bvector<ReprojectStatus> stat1(numPoints);
+    LatLongFromCartesian(inLatLong.data(), stat1.data(), inCartesian, numPoints);
+
+    bvector<GeoPoint> outLatLong(numPoints);
+    bvector<ReprojectStatus> stat2(numPoints);
+    LatLongFromLatLong(outLatLong.data(), stat2.data(), inLatLong.data(), numPoints, targetGCS);
+
+    bvector<ReprojectStatus> stat3(numPoints);
+    targetGCS.CartesianFromLatLong(outCartesian, stat3.data(), outLatLong.data(), numPoints);
+
+    ReprojectStatus status = REPROJECT_Success;
+    for (size_t i = 0; i < numPoints; ++i)
+        {
+        ReprojectStatus pointStatus = combineReprojectStatus(combineReprojectStatus(stat1[i], stat2[i]), stat3[i]);
+        if (NULL != outStatus)
+            outStatus[i] = pointStatus;
+
+        status = combineReprojectStatus(status, pointStatus);
         }
 
     return status;
@@ -14750,17 +15221,7 @@ StatusInt BaseGCS::DefinitionComplete ()
     m_csParameters = newParams;
 
     // Clear cached target GCS and datum converter if any
-    if (NULL != m_targetGCS)
-        {
-        m_targetGCS->UnRegisterIsADestinationOf(*this);
-        m_targetGCS = NULL;
-        }
-
-    if (NULL != m_datumConverter)
-        {
-        m_datumConverter->Destroy();
-        m_datumConverter = NULL;
-        }
+    ClearConverterCache();
 
     SetModified(false);
 
@@ -15250,17 +15711,7 @@ VertDatumCode   verticalDatumCode
         return GEOCOORDERR_CantSetVerticalDatum;
 
     // Clear datum converter caches
-    if (NULL != m_targetGCS)
-    {
-        m_targetGCS->UnRegisterIsADestinationOf(*this);
-        m_targetGCS = NULL;
-    }
-
-    if (NULL != m_datumConverter)
-        {
-        m_datumConverter->Destroy();
-        m_datumConverter = NULL;
-        }
+    ClearConverterCache();
 
     m_verticalDatum = verticalDatumCode;
 
@@ -19234,6 +19685,66 @@ GeoPointCR      inLatLong           // => latitude longitude
     return status;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ReprojectStatus BaseGCS::LatLongFromCartesian
+(
+GeoPointP           outLatLong,     // <= latitude longitude
+ReprojectStatus*    outStatus,      // <= status of each point, may be NULL
+DPoint3dCP          inCartesian,    // => Cartesian, in GCS's units.
+size_t              numPoints       // => number of points
+) const
+    {
+    if (NULL == m_csParameters)
+        return setReprojectStatus(outStatus, numPoints, (ReprojectStatus)GEOCOORDERR_InvalidCoordSys);
+
+    bvector<ReprojectStatus> statuses;
+    if (NULL == outStatus)
+        {
+        statuses.resize(numPoints);
+        outStatus = statuses.data();
+        }
+
+    convertPointRanges(numPoints, [&](size_t start, size_t end)
+        {
+        for (size_t i = start; i < end; ++i)
+            outStatus[i] = LatLongFromCartesian(outLatLong[i], inCartesian[i]);
+        });
+
+    return combineReprojectStatus(outStatus, numPoints);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ReprojectStatus BaseGCS::CartesianFromLatLong
+(
+DPoint3dP           outCartesian,   // <= Cartesian, in GCS's units.
+ReprojectStatus*    outStatus,      // <= status of each point, may be NULL
+GeoPointCP          inLatLong,      // => latitude longitude
+size_t              numPoints       // => number of points
+) const
+    {
+    if (NULL == m_csParameters)
+        return setReprojectStatus(outStatus, numPoints, (ReprojectStatus)GEOCOORDERR_InvalidCoordSys);
+
+    bvector<ReprojectStatus> statuses;
+    if (NULL == outStatus)
+        {
+        statuses.resize(numPoints);
+        outStatus = statuses.data();
+        }
+
+    convertPointRanges(numPoints, [&](size_t start, size_t end)
+        {
+        for (size_t i = start; i < end; ++i)
+            outStatus[i] = CartesianFromLatLong(outCartesian[i], inLatLong[i]);
+        });
+
+    return combineReprojectStatus(outStatus, numPoints);
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -19373,6 +19884,7 @@ DatumConverterP BaseGCS::SetupDatumConverterFor
 BaseGCSCR        targetGCS         // => target coordinate system
 ) const
     {
+    std::lock_guard<std::recursive_mutex> lock(m_datumConverterMutex);
     if (NULL != m_datumConverter)
         {
         m_datumConverter->Destroy();
@@ -19380,15 +19892,16 @@ BaseGCSCR        targetGCS         // => target coordinate system
         }
     m_datumConverter = DatumConverter::Create (*this, targetGCS);
 
+    if (m_datumConverter!=NULL)
+        m_datumConverter->SetReprojectElevation (m_reprojectElevation);
+
+    std::lock_guard<std::recursive_mutex> linksLock(getDestinationLinksMutex());
     if (NULL != m_targetGCS)
         m_targetGCS->UnRegisterIsADestinationOf(*this);
 
     m_targetGCS = &targetGCS;
     m_targetGCS->RegisterIsADestinationOf(*this);
 
-    if (m_datumConverter!=NULL)
-        m_datumConverter->SetReprojectElevation (m_reprojectElevation);
-
     return m_datumConverter;
     }
 
@@ -19397,6 +19910,7 @@ BaseGCSCR        targetGCS         // => target coordinate system
 +---------------+---------------+---------------+---------------+---------------+------*/
 void BaseGCS::ClearCache() const
     {
+    std::lock_guard<std::recursive_mutex> lock(m_datumConverterMutex);
     // Clean up cache data so we release our hold upon other BaseGCS
     if (NULL != m_datumConverter)
         {
@@ -19406,6 +19920,7 @@ void BaseGCS::ClearCache() const
 
     // Normally the caller is the pointed GCS of which the address is m_targetGCS
     // We do not need to unregister the present GCS from the list of pointed GCS of the caller.
+    std::lock_guard<std::recursive_mutex> linksLock(getDestinationLinksMutex());
     m_targetGCS = NULL;
     }
 
@@ -19414,6 +19929,7 @@ void BaseGCS::ClearCache() const
 +---------------+---------------+---------------+---------------+---------------+------*/
 void BaseGCS::ClearConverterCache() const
     {
+    std::lock_guard<std::recursive_mutex> lock(m_datumConverterMutex);
     // Clean up cache data so we release our hold upon other BaseGCS
     if (NULL != m_datumConverter)
         {
@@ -19421,6 +19937,7 @@ void BaseGCS::ClearConverterCache() const
         m_datumConverter = NULL;
         }
 
+    std::lock_guard<std::recursive_mutex> linksLock(getDestinationLinksMutex());
     if (nullptr != m_targetGCS)
         {
         m_targetGCS->UnRegisterIsADestinationOf(*this);
@@ -19433,6 +19950,7 @@ void BaseGCS::ClearConverterCache() const
 +---------------+---------------+---------------+---------------+---------------+------*/
 void BaseGCS::RegisterIsADestinationOf(BaseGCSCR baseGCSThatUsesCurrentAsADestination) const
     {
+    std::lock_guard<std::recursive_mutex> lock(getDestinationLinksMutex());
     m_listOfPointingGCS.push_back(&baseGCSThatUsesCurrentAsADestination);
     }
 
@@ -19441,6 +19959,7 @@ void BaseGCS::RegisterIsADestinationOf(BaseGCSCR baseGCSThatUsesCurrentAsADestin
 +---------------+---------------+---------------+---------------+---------------+------*/
 void BaseGCS::UnRegisterIsADestinationOf(BaseGCSCR baseGCSThatUsesCurrentAsADestination) const
     {
+    std::lock_guard<std::recursive_mutex> lock(getDestinationLinksMutex());
     for (bvector<BaseGCSCP>::iterator itr = m_listOfPointingGCS.begin() ; itr != m_listOfPointingGCS.end() ; itr++)
         {
         if ((*itr) == &baseGCSThatUsesCurrentAsADestination)
@@ -19460,17 +19979,7 @@ void BaseGCS::SetModified(bool modified)
     if (modified)
         {
         // We clear all cache parameters
-        if (NULL != m_targetGCS)
-            {
-            m_targetGCS->UnRegisterIsADestinationOf(*this);
-            m_targetGCS = NULL;
-            }
-
-        if (NULL != m_datumConverter)
-            {
-            m_datumConverter->Destroy();
-            m_datumConverter = NULL;
-            }
+        ClearConverterCache();
 
         if (nullptr != m_datum && !m_customDatum)
             {
@@ -19491,9 +20000,11 @@ void BaseGCS::SetModified(bool modified)
         if (nullptr != m_originalWKT)
             m_originalWKT->clear();
 
-        // Clear the link between other BaseGCS to this one used as a cached target
+        // Clear the link between other BaseGCS to this one used as a cached target.
+        // Their datum converters are rebuilt the next time they are used.
+        std::lock_guard<std::recursive_mutex> linksLock(getDestinationLinksMutex());
         for (size_t i = 0; i < m_listOfPointingGCS.size(); i++)
-            m_listOfPointingGCS[i]->ClearCache();
+            m_listOfPointingGCS[i]->m_targetGCS = NULL;
 
         m_listOfPointingGCS.clear();
         }
@@ -19506,6 +20017,7 @@ void BaseGCS::SetModified(bool modified)
 +---------------+---------------+---------------+---------------+---------------+------*/
 bool            BaseGCS::SetReprojectElevation (bool value)
     {
+    std::lock_guard<std::recursive_mutex> lock(m_datumConverterMutex);
     bool    returnValue = m_reprojectElevation;
     m_reprojectElevation = value;
 
@@ -19533,8 +20045,10 @@ GeoPointCR      inLatLong,          // => latitude longitude in this GCS
 BaseGCSCR       targetGCS           // => target coordinate system
 ) const
     {
+    std::lock_guard<std::recursive_mutex> lock(m_datumConverterMutex);
+
     // make sure datum converter is set up for the destination.
-    if (&targetGCS != m_targetGCS)
+    if (!isCachedTarget(m_targetGCS, targetGCS))
         SetupDatumConverterFor(targetGCS);
 
     if (NULL == m_csParameters)
@@ -19572,8 +20086,10 @@ BaseGCSCR       targetGCS           // => target coordinate system
 	if (NULL == targetGCS.m_csParameters)
 		return (ReprojectStatus)GEOCOORDERR_InvalidCoordSys;
 
+    std::lock_guard<std::recursive_mutex> lock(m_datumConverterMutex);
+
     // make sure datum converter is set up for the destination.
-    if (&targetGCS != m_targetGCS)
+    if (!isCachedTarget(m_targetGCS, targetGCS))
         SetupDatumConverterFor (targetGCS);
 
     ReprojectStatus status = REPROJECT_Success;
@@ -19588,6 +20104,50 @@ BaseGCSCR       targetGCS           // => target coordinate system
     return status;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* The datum converter is resolved once for the array. A BaseGCS lets one thread at a time
+* use its datum converter so the points are converted sequentially.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ReprojectStatus BaseGCS::LatLongFromLatLong
+(
+GeoPointP           outLatLong,     // <= latitude longitude in targetGCS
+ReprojectStatus*    outStatus,      // <= status of each point, may be NULL
+GeoPointCP          inLatLong,      // => latitude longitude in this GCS
+size_t              numPoints,      // => number of points
+BaseGCSCR           targetGCS       // => target coordinate system
+) const
+    {
+    if ((NULL == m_csParameters) || (NULL == targetGCS.m_csParameters))
+        return setReprojectStatus(outStatus, numPoints, (ReprojectStatus)GEOCOORDERR_InvalidCoordSys);
+
+    std::lock_guard<std::recursive_mutex> lock(m_datumConverterMutex);
+
+    // make sure datum converter is set up for the destination.
+    if (!isCachedTarget(m_targetGCS, targetGCS))
+        SetupDatumConverterFor(targetGCS);
+
+    if (NULL == m_datumConverter)
+        {
+        if (outLatLong != inLatLong)
+            std::copy(inLatLong, inLatLong + numPoints, outLatLong);
+
+        return setReprojectStatus(outStatus, numPoints, REPROJECT_CSMAPERR_DatumConverterNotSet); // May be interpreted as a warning.
+        }
+
+    ReprojectStatus status = REPROJECT_Success;
+    for (size_t i = 0; i < numPoints; ++i)
+        {
+        ReprojectStatus pointStatus = m_datumConverter->ConvertLatLong3D(outLatLong[i], inLatLong[i]);
+        if (NULL != outStatus)
+            outStatus[i] = pointStatus;
+
+        status = combineReprojectStatus(status, pointStatus);
+        }
+
+    return status;
+    }
+
 static bool     s_radiansPerDegreeInitialized = false;
 static double   s_radiansPerDegree;
 /*---------------------------------------------------------------------------------**//**
@@ -19658,8 +20218,11 @@ DPoint3dCR      inXYZ
 
         // If elevation datum is NGVD29 based then we need to initialize the vertical datum conversion.
         if (vdcNGVD29 == elevationDatumCode)
+            {
+            std::lock_guard<std::recursive_mutex> lock(getCSMapSharedStateMutex());
             if (0 != CSvrtconInit())
                 return REPROJECT_CSMAPERR_VerticalDatumConversionError;
+            }
 
         VerticalDatumConverter* vertConverter =  new VerticalDatumConverter (IsNAD27(), vdcEllipsoid, elevationDatumCode);
 
@@ -19721,8 +20284,11 @@ GeoPointCR      inLatLong
 
         // If elevation datum is NGVD29 based then we need to initialize the vertical datum conversion.
         if (vdcNGVD29 == elevationDatumCode)
+            {
+            std::lock_guard<std::recursive_mutex> lock(getCSMapSharedStateMutex());
             if (0 != CSvrtconInit())
                 return REPROJECT_CSMAPERR_VerticalDatumConversionError;
+            }
 
         VerticalDatumConverter* vertConverter =  new VerticalDatumConverter (IsNAD27(), elevationDatumCode, vdcEllipsoid);
 
@@ -19981,6 +20547,7 @@ BaseGCSCR       to
     if (!from.IsValid() || !to.IsValid())
         return NULL;
 
+    std::lock_guard<std::recursive_mutex> lock(getCSMapSharedStateMutex());
     VerticalDatumConverter* verticalDatumConverter = GetVerticalDatumConverter (from, to);
     // TODO Remove everything and go directly to the datum portion?
     CSDatumConvert  *datumConvert = CSMap::CS_dtcsu (from.GetCSParameters(), to.GetCSParameters());
@@ -20038,6 +20605,7 @@ DatumConverterP         DatumConverter::Create
     if (!fromDatum.IsValid() || !toDatum.IsValid())
         return NULL;
 
+    std::lock_guard<std::recursive_mutex> lock(getCSMapSharedStateMutex());
     CSDatum* srcCSDatum = fromDatum.GetCSDatum();
     CSDatum* dstCSDatum = toDatum.GetCSDatum();
 
@@ -20242,6 +20810,7 @@ DatumConverter::~DatumConverter
     if (!BaseGCS::IsLibraryInitialized())
         return ;
 
+    std::lock_guard<std::recursive_mutex> lock(getCSMapSharedStateMutex());
     if (NULL != m_datumConvert)
         {
         CSMap::CS_dtcls (m_datumConvert);
@@ -27313,6 +27882,10 @@ cs_Time_ CS_fileModTime(Utf8CP filePath) {
 
 _csFile* CS_fopen(Utf8CP filename, Utf8CP mode) {
     if (0 == strncmp(mode, "r", 1)) {
+        auto gridFile = nullptr == strchr(mode, '+') ? BentleyApi::GeoCoordinates::GridFileCache::Open(filename) : nullptr;
+        if (gridFile)
+            return gridFile;
+
         auto wsFile = BentleyApi::GeoCoordinates::GeoCoordWorkspaces::FindResource(filename);
         if (wsFile)
             return wsFile;
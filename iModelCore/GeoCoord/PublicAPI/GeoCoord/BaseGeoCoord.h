@@ -25,6 +25,7 @@ typedef struct cs_GeodeticTransform_ CSGeodeticTransformDef;
 #include <Bentley/Bentley.h>
 #include <Bentley/RefCounted.h>
 #include <Bentley/bvector.h>
+#include <mutex>
 
 /** @namespace BentleyApi::GeoCoordinates Geographic Coordinate System classes @see GeoCoordinate */
 BEGIN_BENTLEY_NAMESPACE
@@ -394,6 +395,7 @@ protected:
     mutable BaseGCSCP m_targetGCS;                  // current target coordinate system.
     mutable bvector<BaseGCSCP> m_listOfPointingGCS; // List of BaseGCS that are using the current BaseGCS as a cached target GCS
     mutable DatumConverterP m_datumConverter;       // datum converter from this Lat/Long to the Lat/Long of m_targetGCS.
+    mutable std::recursive_mutex m_datumConverterMutex; // guards m_datumConverter and its use. Each BaseGCS has its own so conversions through different BaseGCS can overlap.
     bool m_reprojectElevation;                      // if true, LatLongFromLatLong adjusts elevation values.
     int32_t m_coordSysId;                           // our internal coordinate system ID
     VertDatumCode m_verticalDatum;
@@ -473,6 +475,28 @@ public:
     // @param priority 0=highest (loaded first)
     BASEGEOCOORD_EXPORTED static bool AddWorkspaceDb(Utf8String dbName, BeSQLite::CloudContainerP container, int priority);
 
+    // Statistics of the process-wide cache of grid shift files used by datum transforms.
+    // Every transform opening a cached grid file reads the same memory mapped (or, for
+    // workspace resources, loaded) image instead of the file itself. A cached image of a local
+    // file is read again if the file's modification time or size changed.
+    struct GridFileCacheStatistics {
+        uint64_t m_hits = 0;        // opens served from an image already in the cache
+        uint64_t m_misses = 0;      // opens that had to map or load the file
+        uint64_t m_evictions = 0;   // images dropped to keep the cache within m_maxBytes
+        size_t m_numFiles = 0;      // number of grid files currently cached
+        size_t m_numBytes = 0;      // total size of the cached grid files
+        size_t m_maxBytes = 0;      // size limit of the cache
+    };
+
+    BASEGEOCOORD_EXPORTED static GridFileCacheStatistics GetGridFileCacheStatistics();
+
+    // Drop the cached grid file images. Images still in use by a datum transform are released when it closes them.
+    BASEGEOCOORD_EXPORTED static void ClearGridFileCache();
+
+    // Set the total size of the cached grid file images (256 MB by default). When it is exceeded, the least recently
+    // used images are dropped; the most recently used one is always kept, even if it alone exceeds the limit.
+    BASEGEOCOORD_EXPORTED static void SetGridFileCacheMaxBytes(size_t maxBytes);
+
     BASEGEOCOORD_EXPORTED static BaseGCSPtr CreateGCS(CSParameters const& csParameters, int32_t coordSysId);
     BASEGEOCOORD_EXPORTED static BaseGCSPtr CreateGCS(CSParameters const& csParameters, int32_t coordSysId, CSGeodeticTransformDef* geodeticTransform = nullptr);
 
@@ -961,6 +985,21 @@ BASEGEOCOORD_EXPORTED  ReprojectStatus     GetLinearTransformToECEF
 +---------------+---------------+---------------+---------------+---------------+------*/
 BASEGEOCOORD_EXPORTED ReprojectStatus  CartesianFromCartesian(DPoint3dR outCartesian, DPoint3dCR inCartesian, BaseGCSCR targetGCS) const;
 
+/*---------------------------------------------------------------------------------**//**
+* Converts an array of points from the cartesian representation of this GCS to the cartesian
+* of the target. The datum converter to the target is resolved once for the whole array and
+* the projection steps of large arrays are split across worker threads.
+* @return The hardest error encountered over all points, with the same meaning as for the
+*         single point CartesianFromCartesian.
+* @param    outCartesian   OUT Receives numPoints output coordinates.
+* @param    outStatus      OUT If not NULL, receives the status of each of the numPoints conversions.
+* @param    inCartesian    IN  The input coordinates.
+* @param    numPoints      IN  Number of points to convert.
+* @param    targetGCS      IN  target coordinate system
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BASEGEOCOORD_EXPORTED ReprojectStatus  CartesianFromCartesian(DPoint3dP outCartesian, ReprojectStatus* outStatus, DPoint3dCP inCartesian, size_t numPoints, BaseGCSCR targetGCS) const;
+
 
 /*---------------------------------------------------------------------------------**//**
 * Private - We do not wish to publicise this method yet.
@@ -2741,6 +2780,24 @@ DPoint3dR       outCartesian,       // <= cartesian coordinates in this GCS
 GeoPointCR      inLatLong           // => latitude longitude in this GCS
 ) const;
 
+/*---------------------------------------------------------------------------------**//**
+* Calculates the cartesian coordinates of an array of Longitude/Latitude/Elevation points.
+* Large arrays are split across worker threads.
+* @param    outCartesian    OUT     Receives numPoints calculated cartesian coordinates.
+* @param    outStatus       OUT     If not NULL, receives the status of each of the numPoints conversions.
+* @param    inLatLong       IN      The longitude,latitude,elevation points in the datum of this GCS.
+* @param    numPoints       IN      Number of points to convert.
+* @return   The hardest error encountered over all points.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BASEGEOCOORD_EXPORTED ReprojectStatus   CartesianFromLatLong
+(
+DPoint3dP           outCartesian,   // <= cartesian coordinates in this GCS
+ReprojectStatus*    outStatus,      // <= status of each point, may be NULL
+GeoPointCP          inLatLong,      // => latitude longitude in this GCS
+size_t              numPoints       // => number of points
+) const;
+
 /*---------------------------------------------------------------------------------**//**
 * Calculates the cartesian x and y of the input Longitude/Latitude point. The input elevation is ignored.
 * @param    outCartesian    OUT     The calculated cartesian coordinates.
@@ -2765,6 +2822,24 @@ GeoPointR       outLatLong,         // <= latitude longitude in this GCS
 DPoint3dCR      inCartesian         // => cartesian coordinates in this GCS
 ) const;
 
+/*---------------------------------------------------------------------------------**//**
+* Calculates the longitude, latitude, and elevation of an array of cartesian points.
+* Large arrays are split across worker threads.
+* @param    outLatLong      OUT     Receives numPoints longitude,latitude,elevation in the datum of this GCS.
+* @param    outStatus       OUT     If not NULL, receives the status of each of the numPoints conversions.
+* @param    inCartesian     IN      The input cartesian coordinates.
+* @param    numPoints       IN      Number of points to convert.
+* @return   The hardest error encountered over all points.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BASEGEOCOORD_EXPORTED ReprojectStatus   LatLongFromCartesian
+(
+GeoPointP           outLatLong,     // <= latitude longitude in this GCS
+ReprojectStatus*    outStatus,      // <= status of each point, may be NULL
+DPoint3dCP          inCartesian,    // => cartesian coordinates in this GCS
+size_t              numPoints       // => number of points
+) const;
+
 /*---------------------------------------------------------------------------------**//**
 * Calculates the longitude and latitude from cartesian x and y. Elevation is unchanged.
 * @param    outLatLong      OUT     The calculated longitude and latitude in the datum of this GCS.
@@ -2858,6 +2933,26 @@ GeoPointCR      inLatLong,
 BaseGCSCR       targetGCS
 ) const;
 
+/*---------------------------------------------------------------------------------**//**
+* Calculates the longitude and latitude in the target GCS of an array of points, applying the
+* appropriate datum shift. The datum converter is resolved once for the whole array.
+* @param    outLatLong      OUT     Receives numPoints longitude,latitude,elevation in the datum of targetGCS.
+* @param    outStatus       OUT     If not NULL, receives the status of each of the numPoints conversions.
+* @param    inLatLong       IN      The longitude,latitude,elevation points in the datum of this GCS.
+* @param    numPoints       IN      Number of points to convert.
+* @param    targetGCS       IN      The Coordinate System corresponding to outLatLong.
+* @return   The hardest error encountered over all points.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BASEGEOCOORD_EXPORTED ReprojectStatus   LatLongFromLatLong
+(
+GeoPointP           outLatLong,
+ReprojectStatus*    outStatus,
+GeoPointCP          inLatLong,
+size_t              numPoints,
+BaseGCSCR           targetGCS
+) const;
+
 /*---------------------------------------------------------------------------------**//**
 * Calculates the longitude and latitude in the target GCS, applying the appropriate datum shift.
 * @param    outLatLong      OUT     The calculated longitude,latitude in the datum of targetGCS.
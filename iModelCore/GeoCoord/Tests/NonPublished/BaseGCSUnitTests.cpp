@@ -9,6 +9,7 @@
 #include <Bentley/Desktop/FileSystem.h>
 #include <GeoCoord/BaseGeoCoord.h>
 #include <GeoCoord/BaseGeoTiffKeysList.h>
+#include <thread>
 
 #include "GeoCoordTestCommon.h"
 
@@ -240,6 +241,152 @@ TEST_F(BaseGCSUnitTests, SpecificGetLinearTransformInvalidExtent_Test2)
     ASSERT_FALSE(REPROJECT_Success == secondGCS->GetLinearTransform(&tfReproject, extent, *firstGCS, &maxError, &meanError));
 }
 
+/*---------------------------------------------------------------------------------**//**
+* The array conversion must give the same results as converting each point separately,
+* including when the array is large enough to be split across worker threads.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(BaseGCSUnitTests, CartesianFromCartesianArray)
+{
+    GeoCoordinates::BaseGCSPtr firstGCS = GeoCoordinates::BaseGCS::CreateGCS("UTM84-13N");
+    GeoCoordinates::BaseGCSPtr secondGCS = GeoCoordinates::BaseGCS::CreateGCS("UTM84-14N");
+
+    ASSERT_TRUE(firstGCS.IsValid() && firstGCS->IsValid());
+    ASSERT_TRUE(secondGCS.IsValid() && secondGCS->IsValid());
+
+    bvector<DPoint3d> inPoints;
+    for (int i = 0; i < 200; i++)
+        for (int j = 0; j < 200; j++)
+            inPoints.push_back(DPoint3d::From(400000.0 + i * 500.0, 4000000.0 + j * 500.0, 100.0 + i));
+
+    bvector<DPoint3d> outPoints(inPoints.size());
+    bvector<ReprojectStatus> outStatus(inPoints.size());
+    ReprojectStatus status = firstGCS->CartesianFromCartesian(outPoints.data(), outStatus.data(), inPoints.data(), inPoints.size(), *secondGCS);
+
+    bool allSucceeded = true;
+    for (size_t i = 0; i < inPoints.size(); i++)
+        {
+        DPoint3d expectedPoint;
+        ReprojectStatus pointStatus = firstGCS->CartesianFromCartesian(expectedPoint, inPoints[i], *secondGCS);
+        allSucceeded = allSucceeded && (REPROJECT_Success == pointStatus);
+
+        EXPECT_EQ(pointStatus, outStatus[i]);
+        EXPECT_NEAR(expectedPoint.x, outPoints[i].x, 1e-9);
+        EXPECT_NEAR(expectedPoint.y, outPoints[i].y, 1e-9);
+        EXPECT_NEAR(expectedPoint.z, outPoints[i].z, 1e-9);
+        }
+
+    EXPECT_EQ(allSucceeded, REPROJECT_Success == status);
+
+    // Passing no status array only reports the combined status
+    EXPECT_EQ(status, firstGCS->CartesianFromCartesian(outPoints.data(), nullptr, inPoints.data(), inPoints.size(), *secondGCS));
+}
+
+/*---------------------------------------------------------------------------------**//**
+* Datum conversions through different BaseGCS may run at the same time.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(BaseGCSUnitTests, LatLongFromLatLongConcurrent)
+{
+    GeoCoordinates::BaseGCSPtr sourceGCS = GeoCoordinates::BaseGCS::CreateGCS("UTM83-13");
+    GeoCoordinates::BaseGCSPtr targetGCS = GeoCoordinates::BaseGCS::CreateGCS("UTM84-13N");
+
+    ASSERT_TRUE(sourceGCS.IsValid() && sourceGCS->IsValid());
+    ASSERT_TRUE(targetGCS.IsValid() && targetGCS->IsValid());
+
+    bvector<GeoPoint> inLatLong;
+    for (int i = 0; i < 100; i++)
+        for (int j = 0; j < 100; j++)
+            {
+            GeoPoint point;
+            point.Init(-107.0 + i * 0.01, 35.0 + j * 0.01, 100.0);
+            inLatLong.push_back(point);
+            }
+
+    bvector<GeoPoint> expected(inLatLong.size());
+    ReprojectStatus expectedStatus = sourceGCS->LatLongFromLatLong(expected.data(), nullptr, inLatLong.data(), inLatLong.size(), *targetGCS);
+
+    const size_t numThreads = 4;
+    bvector<bvector<GeoPoint>> results(numThreads, bvector<GeoPoint>(inLatLong.size()));
+    bvector<ReprojectStatus> statuses(numThreads);
+    bvector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; t++)
+        {
+        threads.push_back(std::thread([&, t]()
+            {
+            GeoCoordinates::BaseGCSPtr threadSource = GeoCoordinates::BaseGCS::CreateGCS(*sourceGCS);
+            GeoCoordinates::BaseGCSPtr threadTarget = GeoCoordinates::BaseGCS::CreateGCS(*targetGCS);
+            statuses[t] = threadSource->LatLongFromLatLong(results[t].data(), nullptr, inLatLong.data(), inLatLong.size(), *threadTarget);
+            }));
+        }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t t = 0; t < numThreads; t++)
+        {
+        EXPECT_EQ(expectedStatus, statuses[t]);
+        for (size_t i = 0; i < inLatLong.size(); i++)
+            {
+            EXPECT_NEAR(expected[i].longitude, results[t][i].longitude, 1e-12);
+            EXPECT_NEAR(expected[i].latitude, results[t][i].latitude, 1e-12);
+            EXPECT_NEAR(expected[i].elevation, results[t][i].elevation, 1e-9);
+            }
+        }
+}
+
+/*---------------------------------------------------------------------------------**//**
+* Grid shift files read by a datum transform are loaded once and shared by later transforms.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(BaseGCSUnitTests, GridFileCacheStatistics)
+{
+    GeoCoordinates::BaseGCS::ClearGridFileCache();
+    auto statistics = GeoCoordinates::BaseGCS::GetGridFileCacheStatistics();
+    EXPECT_EQ(0, statistics.m_numFiles);
+    EXPECT_EQ(0, statistics.m_numBytes);
+
+    auto transformNad27ToNad83 = []()
+        {
+        GeoCoordinates::BaseGCSPtr nad27GCS = GeoCoordinates::BaseGCS::CreateGCS("UTM27-16");
+        GeoCoordinates::BaseGCSPtr nad83GCS = GeoCoordinates::BaseGCS::CreateGCS("UTM83-16");
+        ASSERT_TRUE(nad27GCS.IsValid() && nad27GCS->IsValid());
+        ASSERT_TRUE(nad83GCS.IsValid() && nad83GCS->IsValid());
+
+        GeoPoint inLatLong = {-87.0, 35.0, 0.0};
+        GeoPoint outLatLong;
+        nad27GCS->LatLongFromLatLong(outLatLong, inLatLong, *nad83GCS);
+        };
+
+    // The first transform loads the NADCON grid files into the cache
+    uint64_t misses = statistics.m_misses;
+    transformNad27ToNad83();
+    auto firstStatistics = GeoCoordinates::BaseGCS::GetGridFileCacheStatistics();
+    EXPECT_GT(firstStatistics.m_numFiles, 0);
+    EXPECT_GT(firstStatistics.m_numBytes, 0);
+    EXPECT_EQ(firstStatistics.m_misses - misses, firstStatistics.m_numFiles);
+
+    // The second transform is served from the cache without loading any file again
+    transformNad27ToNad83();
+    statistics = GeoCoordinates::BaseGCS::GetGridFileCacheStatistics();
+    EXPECT_GT(statistics.m_hits, firstStatistics.m_hits);
+    EXPECT_EQ(firstStatistics.m_misses, statistics.m_misses);
+    EXPECT_EQ(firstStatistics.m_numFiles, statistics.m_numFiles);
+
+    // A size limit smaller than the cached images drops all but the most recently used one
+    size_t maxBytes = statistics.m_maxBytes;
+    GeoCoordinates::BaseGCS::SetGridFileCacheMaxBytes(1);
+    statistics = GeoCoordinates::BaseGCS::GetGridFileCacheStatistics();
+    EXPECT_EQ(1, statistics.m_numFiles);
+    EXPECT_EQ(firstStatistics.m_numFiles - 1, statistics.m_evictions - firstStatistics.m_evictions);
+    GeoCoordinates::BaseGCS::SetGridFileCacheMaxBytes(maxBytes);
+
+    GeoCoordinates::BaseGCS::ClearGridFileCache();
+    statistics = GeoCoordinates::BaseGCS::GetGridFileCacheStatistics();
+    EXPECT_EQ(0, statistics.m_numFiles);
+    EXPECT_EQ(0, statistics.m_numBytes);
+}
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -1217,6 +1217,28 @@ bvector<PolyfaceHeaderPtr> &resultAaboveB,
 bvector<PolyfaceHeaderPtr> &resultBaboveA
 );
 
+//! @description Tiled form of ComputeCutAndFill for large meshes.
+//! The xy range of the inputs is split into square tiles, and each tile's clipped facets are processed independently
+//! on up to numThreads threads.  The tile results are then welded along the tile seams into at most one mesh per result array.
+//! @remarks As with ComputeCutAndFill, the results are upper and lower surfaces without side panels.  Facets that cross a
+//!    tile seam are split on the seam.
+//! @param [in] polyfaceA first facet set (e.g. road surface)
+//! @param [in] polyfaceB second facet set (e.g. ground dtm)
+//! @param [in] tileSize xy edge length of tiles.  If zero or negative, the whole range is a single tile.
+//!    If the range would need more than 65536 tiles, the tile size is enlarged to stay within that count.
+//! @param [out] resultAaboveB volume where polyfaceA is above polyfaceB
+//! @param [out] resultBaboveA volume where polyfaceB is above polyfaceA
+//! @param [in] numThreads maximum number of threads.  0 means use the hardware concurrency.
+static GEOMDLLIMPEXP void ComputeCutAndFillTiled
+(
+PolyfaceHeaderCR polyfaceA,
+PolyfaceHeaderCR polyfaceB,
+double tileSize,
+bvector<PolyfaceHeaderPtr> &resultAaboveB,
+bvector<PolyfaceHeaderPtr> &resultBaboveA,
+size_t numThreads = 0
+);
+
 
 
 //! @description "Punch" through target polygons.
@@ -2429,6 +2451,28 @@ PolyfaceHeaderPtr &cutMesh,         //!< [out] facets for cut volumes (road belo
 PolyfaceHeaderPtr &fillMesh        //!< [out] facets for fill volumes (road above dtm)
 );
 
+//! Tiled form of ComputeSingleSheetCutFill for large meshes.
+//!<ul>
+//!<li> The xy range of the inputs is split into square tiles.
+//!<li> Each tile's facets are clipped out and processed independently, on up to numThreads threads, so working memory follows tile size rather than mesh size.
+//!<li> The surfaces of all tiles are welded along the tile seams before side panels are added, so as with ComputeSingleSheetCutFill
+//!     the outputs are a single cut mesh and a single fill mesh with panels only on the outer boundaries of the volumes.
+//!     Facets that cross a tile seam are split on the seam.
+//!<li> The welding and side panel steps run on the calling thread over the whole output.
+//!<li> The number of tiles is capped at 65536; a smaller tileSize is enlarged to stay within that count.
+//!<li> Tiles are in xy, so viewVector is expected to be the z direction.
+//!</ul>
+static GEOMDLLIMPEXP void ComputeSingleSheetCutFillTiled
+(
+PolyfaceHeaderCR dtm,                //!< [in] dtm mesh
+PolyfaceHeaderCR road,               //!< [in] "road" mesh.
+DVec3dCR viewVector,                 //!< [in]  viewDirection
+double tileSize,                     //!< [in] xy edge length of tiles.  If zero or negative, the whole range is a single tile.
+PolyfaceHeaderPtr &cutMesh,          //!< [out] facets for cut volumes (road below dtm)
+PolyfaceHeaderPtr &fillMesh,         //!< [out] facets for fill volumes (road above dtm)
+size_t numThreads = 0                //!< [in] maximum number of threads.  0 means use the hardware concurrency.
+);
+
 //! Decimate (in place) by simple rules that aggressively collapse short edges.
 //! This is the fastest decimation, but it does not protect boundary points.
 //! @return number of collapses.
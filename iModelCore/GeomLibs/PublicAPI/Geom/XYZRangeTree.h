@@ -496,6 +496,55 @@ GEOMDLLIMPEXP void RunSearch (XYZRangeTreeRootP treeA, XYZRangeTreeRootP treeB,
 };
 
 
+struct PolyfaceFacetBVH;
+typedef RefCountedPtr<PolyfaceFacetBVH>  PolyfaceFacetBVHPtr;
+
+// Flat bounding volume hierarchy over the facet ranges of a polyface.
+// Nodes are stored in a single array (sibling pairs adjacent) and split by binned surface area heuristic.
+// Build and clash search can use multiple threads.
+struct PolyfaceFacetBVH : public RefCountedBase
+{
+public:
+// A node is a leaf if m_count is nonzero; its facets are at [m_start, m_start + m_count) of the facet arrays.
+// Children of an interior node are at m_start and m_start + 1.
+struct Node
+    {
+    DRange3d m_range;
+    uint32_t m_start;
+    uint32_t m_count;
+    bool IsLeaf () const {return m_count != 0;}
+    };
+private:
+bvector<Node> m_nodes;
+bvector<DRange3d> m_facetRanges;    // in leaf order
+bvector<size_t> m_readIndices;      // in leaf order
+
+PolyfaceFacetBVH ();
+size_t LoadPolyface (PolyfaceQueryCR source, size_t numThreads);
+public:
+// Build the hierarchy for the facets of a polyface.
+// numThreads = 0 uses the hardware concurrency.
+GEOMDLLIMPEXP static PolyfaceFacetBVHPtr CreateForPolyface (PolyfaceQueryCR source, size_t numThreads = 0);
+
+bvector<Node> const &GetNodes () const {return m_nodes;}
+bvector<DRange3d> const &GetFacetRanges () const {return m_facetRanges;}
+bvector<size_t> const &GetReadIndices () const {return m_readIndices;}
+
+// Search for clashing pairs, with the same facet tests as PolyfaceRangeTree::CollectClashPairs.
+// hits are sorted by (readIndexA, readIndexB).
+// If more than maxHits pairs clash, which maxHits of them are returned is not specified.
+static GEOMDLLIMPEXP void CollectClashPairs (
+PolyfaceQueryCR polyfaceA,          //!< first polyface
+PolyfaceFacetBVH const &treeA,      //!< hierarchy for polyfaceA
+PolyfaceQueryCR polyfaceB,          //!< second polyface
+PolyfaceFacetBVH const &treeB,      //!< hierarchy for polyfaceB
+double proximity,                   //!< collect hits within this proximity.
+bvector<std::pair<size_t, size_t>> &hits,   //!< read indices of clashing pairs
+size_t maxHits,                     //!< maximum number of hits to collect.
+size_t numThreads = 0               //!< number of threads to use. 0 uses the hardware concurrency.
+);
+};
+
 // Sample range-box-only clash tester.
 // User can further override TestLeafLeafPair to do more detailed test.
 struct SimpleRangeClashTester : DRange3dPairRecursionHandler
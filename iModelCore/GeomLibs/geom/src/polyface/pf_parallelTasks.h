@@ -0,0 +1,44 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#include <atomic>
+#include <thread>
+
+BEGIN_BENTLEY_GEOMETRY_NAMESPACE
+
+// Number of threads to use when the caller passes 0.
+static size_t ResolveThreadCount (size_t numThreads)
+    {
+    if (numThreads == 0)
+        numThreads = std::thread::hardware_concurrency ();
+    return numThreads == 0 ? 1 : numThreads;
+    }
+
+// Call work (taskIndex, threadIndex) for each taskIndex in [0, numTasks), spread over up to numThreads threads.
+// The calling thread is thread 0.
+template <typename Work>
+static void RunTasksInParallel (size_t numTasks, size_t numThreads, Work const &work)
+    {
+    numThreads = std::min (numThreads, numTasks);
+    if (numThreads <= 1)
+        {
+        for (size_t i = 0; i < numTasks; i++)
+            work (i, 0);
+        return;
+        }
+    std::atomic<size_t> nextTask (0);
+    auto worker = [&] (size_t threadIndex)
+        {
+        for (size_t i = nextTask++; i < numTasks; i = nextTask++)
+            work (i, threadIndex);
+        };
+    std::vector<std::thread> threads;
+    for (size_t threadIndex = 1; threadIndex < numThreads; threadIndex++)
+        threads.push_back (std::thread (worker, threadIndex));
+    worker (0);
+    for (auto &thread : threads)
+        thread.join ();
+    }
+
+END_BENTLEY_GEOMETRY_NAMESPACE
@@ -7,6 +7,7 @@
 
 
 #include <Geom/XYZRangeTree.h>
+#include "pf_parallelTasks.h"
 
 
 
@@ -244,6 +245,33 @@ void XYZRangeTreeMultiSearch::RunSearch(XYZRangeTreeRootP treeA, XYZRangeTreeRoo
         }
     }
 
+// Test if two facets (selected by read index) clash, or for positive proximity, approach within that distance.
+static bool FacetsClash
+(
+PolyfaceVisitor &visitorA,
+size_t indexA,
+PolyfaceVisitor &visitorB,
+size_t indexB,
+double proximity
+)
+    {
+    visitorA.MoveToFacetByReadIndex (indexA);
+    visitorB.MoveToFacetByReadIndex (indexB);
+    if (proximity <= 0.0)
+        return bsiDPoint3dArray_polygonClashXYZ (
+            visitorA.GetPointCP (), (int) visitorA.Point ().size (),
+            visitorB.GetPointCP (), (int) visitorB.Point ().size ()
+            );
+
+    DPoint3d pointA, pointB;
+    return bsiPolygon_closestApproachBetweenPolygons (
+                &pointA, &pointB,
+                visitorA.GetPointCP (), (int) visitorA.Point ().size (),
+                visitorB.GetPointCP (), (int) visitorB.Point ().size ()
+            )
+        && pointA.DistanceSquared (pointB) < proximity * proximity;
+    }
+
 // Collect indices of intersecting facets.
 //
 // 
@@ -316,31 +344,8 @@ void TestLeafLeafPair (DRange3dCR rangeA, size_t indexA, DRange3dCR rangeB, size
     {
     if (m_LL.Count (rangeA.IntersectsWith (rangeB, m_rangeExpansion, 3)))
         {
-        m_visitorA->MoveToFacetByReadIndex (indexA);
-        m_visitorB->MoveToFacetByReadIndex (indexB);
-        if (m_proximity <= 0.0)
-            {
-        if (m_LLClash.Count (bsiDPoint3dArray_polygonClashXYZ (
-            m_visitorA->GetPointCP (), (int) m_visitorA->Point ().size (),
-            m_visitorB->GetPointCP (), (int) m_visitorB->Point ().size ()
-            )))
-                {
-                m_hits.push_back (std::pair <size_t, size_t> (indexA, indexB));
-                }
-            }
-        else
-            {
-            DPoint3d pointA, pointB;
-            if (m_LLClash.Count (bsiPolygon_closestApproachBetweenPolygons (
-                        &pointA, &pointB,
-                        m_visitorA->GetPointCP (), (int) m_visitorA->Point ().size (),
-                        m_visitorB->GetPointCP (), (int) m_visitorB->Point ().size ()
-                    )))
-                {
-                if (pointA.DistanceSquared (pointB) < m_proximity * m_proximity)
+        if (m_LLClash.Count (FacetsClash (*m_visitorA, indexA, *m_visitorB, indexB, m_proximity)))
             m_hits.push_back (std::pair <size_t, size_t> (indexA, indexB));
-                }            
-            }
         }
     }
 
@@ -369,8 +374,408 @@ XYZRangeTreeMutltiSearchR searcher    //! (to be reused over multiple calls)
     searcher.RunSearch (treeA.GetXYZRangeTree (), treeB.GetXYZRangeTree (), collector);
     }
 
+//================================================================================
+// Half the surface area of a range (0 for null range).
+static double HalfSurfaceArea (DRange3dCR range)
+    {
+    double dx = range.XLength (), dy = range.YLength (), dz = range.ZLength ();
+    return dx * dy + dy * dz + dz * dx;
+    }
+
+// Binned SAH builder for PolyfaceFacetBVH.
+// Facet indices in m_order are partitioned in place, so disjoint subtrees can be built concurrently.
+struct FacetBVHBuilder
+{
+static const uint32_t s_maxLeafSize = 4;        // always split above this count ...
+static const uint32_t s_maxSAHLeafSize = 16;    // ... unless SAH prefers a leaf up to this count.
+static const int s_numBins = 16;
+typedef PolyfaceFacetBVH::Node Node;
 
+struct PendingNode
+    {
+    uint32_t m_node;
+    uint32_t m_begin;
+    uint32_t m_end;
+    };
 
+bvector<DRange3d> const &m_ranges;
+bvector<DPoint3d> m_centroids;
+bvector<uint32_t> m_order;
 
+FacetBVHBuilder (bvector<DRange3d> const &ranges) : m_ranges (ranges)
+    {
+    m_centroids.reserve (ranges.size ());
+    m_order.reserve (ranges.size ());
+    for (size_t i = 0; i < ranges.size (); i++)
+        {
+        m_centroids.push_back (DPoint3d::FromInterpolate (ranges[i].low, 0.5, ranges[i].high));
+        m_order.push_back ((uint32_t) i);
+        }
+    }
+
+int BinIndex (double value, double low, double scale) const
+    {
+    int bin = (int) ((value - low) * scale);
+    return bin < 0 ? 0 : (bin >= s_numBins ? s_numBins - 1 : bin);
+    }
+
+// Choose the split of [begin, end) with least SAH cost, partition m_order accordingly, and return the split position.
+// Return begin if the facets should stay in a leaf.
+uint32_t Split (uint32_t begin, uint32_t end, DRange3dCR nodeRange)
+    {
+    uint32_t count = end - begin;
+    if (count <= s_maxLeafSize)
+        return begin;
+
+    DRange3d centroidRange = DRange3d::NullRange ();
+    for (uint32_t i = begin; i < end; i++)
+        centroidRange.Extend (m_centroids[m_order[i]]);
+
+    int bestAxis = -1, bestBin = 0;
+    double bestCost = DBL_MAX;
+    for (int axis = 0; axis < 3; axis++)
+        {
+        double low = centroidRange.low.GetComponent (axis);
+        double extent = centroidRange.high.GetComponent (axis) - low;
+        if (extent <= 0.0)
+            continue;
+        double scale = s_numBins / extent;
+        uint32_t binCounts[s_numBins] = {0};
+        DRange3d binRanges[s_numBins];
+        for (int k = 0; k < s_numBins; k++)
+            binRanges[k].Init ();
+        for (uint32_t i = begin; i < end; i++)
+            {
+            uint32_t facet = m_order[i];
+            int bin = BinIndex (m_centroids[facet].GetComponent (axis), low, scale);
+            binCounts[bin]++;
+            binRanges[bin].Extend (m_ranges[facet]);
+            }
+
+        // rightCost[k] = cost of bins k+1 .. s_numBins-1
+        double rightCost[s_numBins];
+        DRange3d rightRange = DRange3d::NullRange ();
+        uint32_t rightCount = 0;
+        for (int k = s_numBins - 1; k > 0; k--)
+            {
+            rightRange.Extend (binRanges[k]);
+            rightCount += binCounts[k];
+            rightCost[k - 1] = rightCount * HalfSurfaceArea (rightRange);
+            }
+        DRange3d leftRange = DRange3d::NullRange ();
+        uint32_t leftCount = 0;
+        for (int k = 0; k < s_numBins - 1; k++)
+            {
+            leftRange.Extend (binRanges[k]);
+            leftCount += binCounts[k];
+            if (leftCount == 0 || leftCount == count)
+                continue;
+            double cost = leftCount * HalfSurfaceArea (leftRange) + rightCost[k];
+            if (cost < bestCost)
+                {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = k;
+                }
+            }
+        }
+
+    if (bestAxis < 0)
+        {
+        // All centroids coincide.  Split by position to keep leaves small.
+        return count <= s_maxSAHLeafSize ? begin : begin + count / 2;
+        }
+    if (count <= s_maxSAHLeafSize && bestCost >= count * HalfSurfaceArea (nodeRange))
+        return begin;
+
+    double low = centroidRange.low.GetComponent (bestAxis);
+    double scale = s_numBins / (centroidRange.high.GetComponent (bestAxis) - low);
+    auto mid = std::partition (m_order.begin () + begin, m_order.begin () + end,
+        [&] (uint32_t facet) {return BinIndex (m_centroids[facet].GetComponent (bestAxis), low, scale) <= bestBin;});
+    return (uint32_t) (mid - m_order.begin ());
+    }
+
+// Build the subtree for [begin, end) with its root at nodes[rootIndex].
+// If deferSize is nonzero, subtrees with at most deferSize facets are left as unbuilt placeholders and recorded in deferred.
+void BuildSubtree (bvector<Node> &nodes, uint32_t rootIndex, uint32_t begin, uint32_t end, uint32_t deferSize, bvector<PendingNode> *deferred)
+    {
+    bvector<PendingNode> stack;
+    stack.push_back ({rootIndex, begin, end});
+    while (!stack.empty ())
+        {
+        PendingNode pending = stack.back ();
+        stack.pop_back ();
+        if (nullptr != deferred && pending.m_end - pending.m_begin <= deferSize)
+            {
+            deferred->push_back (pending);
+            continue;
+            }
+        DRange3d range = DRange3d::NullRange ();
+        for (uint32_t i = pending.m_begin; i < pending.m_end; i++)
+            range.Extend (m_ranges[m_order[i]]);
+        nodes[pending.m_node].m_range = range;
+        uint32_t mid = Split (pending.m_begin, pending.m_end, range);
+        if (mid == pending.m_begin)
+            {
+            nodes[pending.m_node].m_start = pending.m_begin;
+            nodes[pending.m_node].m_count = pending.m_end - pending.m_begin;
+            continue;
+            }
+        uint32_t childIndex = (uint32_t) nodes.size ();
+        nodes[pending.m_node].m_start = childIndex;
+        nodes[pending.m_node].m_count = 0;
+        nodes.push_back (Node ());
+        nodes.push_back (Node ());
+        stack.push_back ({childIndex + 1, mid, pending.m_end});
+        stack.push_back ({childIndex, pending.m_begin, mid});
+        }
+    }
+
+void Build (bvector<Node> &nodes, size_t numThreads)
+    {
+    nodes.clear ();
+    uint32_t numFacets = (uint32_t) m_ranges.size ();
+    if (numFacets == 0)
+        return;
+    nodes.push_back (Node ());
+    // Build the top of the tree here, and subtrees of roughly numFacets / (4 * numThreads) facets in parallel.
+    uint32_t deferSize = (uint32_t) std::max ((size_t) 1024, numFacets / (4 * numThreads));
+    if (numThreads <= 1 || numFacets <= 2 * deferSize)
+        {
+        BuildSubtree (nodes, 0, 0, numFacets, 0, nullptr);
+        return;
+        }
+    bvector<PendingNode> deferred;
+    BuildSubtree (nodes, 0, 0, numFacets, deferSize, &deferred);
+
+    bvector<bvector<Node>> subtrees (deferred.size ());
+    RunTasksInParallel (deferred.size (), numThreads, [&] (size_t i, size_t)
+        {
+        subtrees[i].push_back (Node ());
+        BuildSubtree (subtrees[i], 0, deferred[i].m_begin, deferred[i].m_end, 0, nullptr);
+        });
+
+    // Splice each subtree: its root replaces the placeholder, the rest is appended.
+    for (size_t i = 0; i < deferred.size (); i++)
+        {
+        uint32_t offset = (uint32_t) nodes.size () - 1;
+        for (size_t k = 0; k < subtrees[i].size (); k++)
+            {
+            Node node = subtrees[i][k];
+            if (!node.IsLeaf ())
+                node.m_start += offset;
+            if (k == 0)
+                nodes[deferred[i].m_node] = node;
+            else
+                nodes.push_back (node);
+            }
+        }
+    }
+};
+
+PolyfaceFacetBVH::PolyfaceFacetBVH () {}
+
+size_t PolyfaceFacetBVH::LoadPolyface (PolyfaceQueryCR source, size_t numThreads)
+    {
+    bvector<DRange3d> ranges;
+    bvector<size_t> readIndices;
+    PolyfaceVisitorPtr visitor = PolyfaceVisitor::Attach (source, false);
+    for (visitor->Reset (); visitor->AdvanceToNextFace ();)
+        {
+        readIndices.push_back (visitor->GetReadIndex ());
+        ranges.push_back (DRange3d::From (visitor->Point ()));
+        }
+
+    FacetBVHBuilder builder (ranges);
+    builder.Build (m_nodes, ResolveThreadCount (numThreads));
+    m_facetRanges.clear ();
+    m_readIndices.clear ();
+    m_facetRanges.reserve (ranges.size ());
+    m_readIndices.reserve (ranges.size ());
+    for (uint32_t facet : builder.m_order)
+        {
+        m_facetRanges.push_back (ranges[facet]);
+        m_readIndices.push_back (readIndices[facet]);
+        }
+    return ranges.size ();
+    }
+
+PolyfaceFacetBVHPtr PolyfaceFacetBVH::CreateForPolyface (PolyfaceQueryCR source, size_t numThreads)
+    {
+    PolyfaceFacetBVH *bvh = new PolyfaceFacetBVH ();
+    bvh->LoadPolyface (source, numThreads);
+    return bvh;
+    }
+
+// Simultaneous descent of two PolyfaceFacetBVH.
+// Node pairs near the roots are collected first; each pair is then searched as an independent task.
+struct FacetBVHClashSearch
+{
+typedef PolyfaceFacetBVH::Node Node;
+typedef std::pair<uint32_t, uint32_t> NodePair;
+
+PolyfaceQueryCR m_polyfaceA;
+PolyfaceQueryCR m_polyfaceB;
+PolyfaceFacetBVH const &m_treeA;
+PolyfaceFacetBVH const &m_treeB;
+double m_rangeExpansion;
+double m_proximity;
+size_t m_maxHits;
+std::atomic<size_t> m_numHits;
+
+FacetBVHClashSearch
+(
+PolyfaceQueryCR polyfaceA,
+PolyfaceFacetBVH const &treeA,
+PolyfaceQueryCR polyfaceB,
+PolyfaceFacetBVH const &treeB,
+double rangeExpansion,
+double proximity,
+size_t maxHits
+)
+: m_polyfaceA (polyfaceA),
+  m_polyfaceB (polyfaceB),
+  m_treeA (treeA),
+  m_treeB (treeB),
+  m_rangeExpansion (rangeExpansion),
+  m_proximity (proximity),
+  m_maxHits (maxHits),
+  m_numHits (0)
+    {
+    if (m_rangeExpansion < proximity)
+        m_rangeExpansion = proximity;
+    }
+
+bool TestOverlap (DRange3dCR rangeA, DRange3dCR rangeB) const
+    {
+    return rangeA.IntersectsWith (rangeB, m_rangeExpansion, 3);
+    }
+
+bool StillSearching () const {return m_numHits.load (std::memory_order_relaxed) < m_maxHits;}
+
+// Push the overlapping child pairs of an (overlapping) node pair with at least one interior node.
+// The larger interior node is split.
+void PushChildPairs (NodePair pair, bvector<NodePair> &pairs) const
+    {
+    Node const &nodeA = m_treeA.GetNodes ()[pair.first];
+    Node const &nodeB = m_treeB.GetNodes ()[pair.second];
+    bool splitA = !nodeA.IsLeaf () && (nodeB.IsLeaf () || nodeA.m_range.ExtentSquared () >= nodeB.m_range.ExtentSquared ());
+    for (uint32_t child = 0; child < 2; child++)
+        {
+        NodePair childPair = splitA ? NodePair (nodeA.m_start + child, pair.second) : NodePair (pair.first, nodeB.m_start + child);
+        if (TestOverlap (m_treeA.GetNodes ()[childPair.first].m_range, m_treeB.GetNodes ()[childPair.second].m_range))
+            pairs.push_back (childPair);
+        }
+    }
+
+bool IsLeafPair (NodePair pair) const
+    {
+    return m_treeA.GetNodes ()[pair.first].IsLeaf () && m_treeB.GetNodes ()[pair.second].IsLeaf ();
+    }
+
+void TestLeafPair (NodePair pair, PolyfaceVisitor &visitorA, PolyfaceVisitor &visitorB, bvector<std::pair<size_t, size_t>> &hits)
+    {
+    Node const &nodeA = m_treeA.GetNodes ()[pair.first];
+    Node const &nodeB = m_treeB.GetNodes ()[pair.second];
+    for (uint32_t i = nodeA.m_start; i < nodeA.m_start + nodeA.m_count; i++)
+        {
+        DRange3dCR rangeA = m_treeA.GetFacetRanges ()[i];
+        for (uint32_t j = nodeB.m_start; j < nodeB.m_start + nodeB.m_count; j++)
+            {
+            if (!TestOverlap (rangeA, m_treeB.GetFacetRanges ()[j]))
+                continue;
+            size_t indexA = m_treeA.GetReadIndices ()[i];
+            size_t indexB = m_treeB.GetReadIndices ()[j];
+            if (FacetsClash (visitorA, indexA, visitorB, indexB, m_proximity))
+                {
+                hits.push_back (std::pair<size_t, size_t> (indexA, indexB));
+                m_numHits++;
+                }
+            }
+        }
+    }
+
+void SearchFrom (NodePair pair, PolyfaceVisitor &visitorA, PolyfaceVisitor &visitorB, bvector<NodePair> &stack, bvector<std::pair<size_t, size_t>> &hits)
+    {
+    stack.clear ();
+    stack.push_back (pair);
+    while (!stack.empty () && StillSearching ())
+        {
+        NodePair top = stack.back ();
+        stack.pop_back ();
+        if (IsLeafPair (top))
+            TestLeafPair (top, visitorA, visitorB, hits);
+        else
+            PushChildPairs (top, stack);
+        }
+    }
+
+void Run (bvector<std::pair<size_t, size_t>> &hits, size_t numThreads)
+    {
+    hits.clear ();
+    if (m_treeA.GetNodes ().empty () || m_treeB.GetNodes ().empty () || m_maxHits == 0
+        || !TestOverlap (m_treeA.GetNodes ()[0].m_range, m_treeB.GetNodes ()[0].m_range))
+        return;
+
+    // Expand the root pair breadth first until there are enough independent tasks.
+    bvector<NodePair> tasks, next;
+    tasks.push_back (NodePair (0, 0));
+    size_t targetTasks = numThreads <= 1 ? 1 : 8 * numThreads;
+    bool expanded = true;
+    while (tasks.size () < targetTasks && expanded)
+        {
+        expanded = false;
+        next.clear ();
+        for (NodePair pair : tasks)
+            {
+            if (IsLeafPair (pair))
+                next.push_back (pair);
+            else
+                {
+                PushChildPairs (pair, next);
+                expanded = true;
+                }
+            }
+        tasks.swap (next);
+        }
+
+    bvector<bvector<std::pair<size_t, size_t>>> taskHits (tasks.size ());
+    bvector<PolyfaceVisitorPtr> visitorsA (numThreads), visitorsB (numThreads);
+    bvector<bvector<NodePair>> stacks (numThreads);
+    RunTasksInParallel (tasks.size (), numThreads, [&] (size_t taskIndex, size_t threadIndex)
+        {
+        if (!visitorsA[threadIndex].IsValid ())
+            {
+            visitorsA[threadIndex] = PolyfaceVisitor::Attach (m_polyfaceA);
+            visitorsB[threadIndex] = PolyfaceVisitor::Attach (m_polyfaceB);
+            }
+        SearchFrom (tasks[taskIndex], *visitorsA[threadIndex], *visitorsB[threadIndex], stacks[threadIndex], taskHits[taskIndex]);
+        });
+
+    for (auto &h : taskHits)
+        hits.insert (hits.end (), h.begin (), h.end ());
+    std::sort (hits.begin (), hits.end ());
+    if (hits.size () > m_maxHits)
+        hits.resize (m_maxHits);
+    }
+};
+
+// Search for clashing pairs.
+//
+GEOMDLLIMPEXP void PolyfaceFacetBVH::CollectClashPairs (
+PolyfaceQueryCR polyfaceA,          //!< first polyface
+PolyfaceFacetBVH const &treeA,      //!< hierarchy for polyfaceA
+PolyfaceQueryCR polyfaceB,          //!< second polyface
+PolyfaceFacetBVH const &treeB,      //!< hierarchy for polyfaceB
+double proximity,
+bvector<std::pair<size_t, size_t>> &hits,   //!< read indices of clashing pairs
+size_t maxHits,                     //!< maximum number of hits to collect.
+size_t numThreads                   //!< number of threads to use. 0 uses the hardware concurrency.
+)
+    {
+    double rangeExpansion = proximity + 1.0e-12;
+    FacetBVHClashSearch search (polyfaceA, treeA, polyfaceB, treeB, rangeExpansion, proximity, maxHits);
+    search.Run (hits, ResolveThreadCount (numThreads));
+    }
 
-END_BENTLEY_GEOMETRY_NAMESPACE
\ No newline at end of file
+END_BENTLEY_GEOMETRY_NAMESPACE
@@ -4,9 +4,18 @@
 *--------------------------------------------------------------------------------------------*/
 #include <bsibasegeomPCH.h>
 #include <Bentley/BeTimeUtilities.h>
+#include "pf_parallelTasks.h"
 
 BEGIN_BENTLEY_GEOMETRY_NAMESPACE
 
+// Upper and lower surfaces of the volumes where meshA is over meshB, without the side panels that close them.
+static PolyfaceHeaderPtr ComputeSingleSheetSurfaces (PolyfaceHeaderCR meshA, PolyfaceHeaderCR meshB)
+    {
+    PolyfaceHeaderPtr ATop, AUnder;
+    PolyfaceQuery::ComputeOverAndUnderXY (meshA, nullptr, meshB, nullptr, ATop, AUnder);
+    return PolyfaceHeader::CloneWithTVertexFixup (bvector<PolyfaceHeaderPtr> {ATop, AUnder});
+    }
+
 // Use repeated undercut to construct upper and lower surfaces in both orders.
 void PolyfaceHeader::ComputeSingleSheetCutFill
 (
@@ -17,17 +26,256 @@ PolyfaceHeaderPtr &cutMesh,
 PolyfaceHeaderPtr &fillMesh
 )
     {
-    PolyfaceHeaderPtr ATop, AUnder, BTop, BUnder;
+    cutMesh = PolyfaceHeader::CloneWithSidePanelsInserted (bvector<PolyfaceHeaderPtr>{ComputeSingleSheetSurfaces (meshA, meshB)}, viewVector);
+    fillMesh = PolyfaceHeader::CloneWithSidePanelsInserted (bvector<PolyfaceHeaderPtr> {ComputeSingleSheetSurfaces (meshB, meshA)}, viewVector);
+    }
 
-    PolyfaceQuery::ComputeOverAndUnderXY (meshA, nullptr, meshB, nullptr, ATop, AUnder);
-    ATop = PolyfaceHeader::CloneWithTVertexFixup (bvector<PolyfaceHeaderPtr> {ATop, AUnder});
-    cutMesh = PolyfaceHeader::CloneWithSidePanelsInserted (bvector<PolyfaceHeaderPtr>{ATop}, viewVector);
+//================================================================================
+// Tiled cut/fill.
+// The xy range of the two inputs is split into a grid of tiles.  Each facet's read index is recorded in
+// every tile its xy range touches, so a tile's facets can be gathered into a small mesh and clipped to the tile
+// without revisiting the whole input.  Tiles are then processed independently on worker threads.
+// The per-tile outputs are welded into a single mesh, so the results have no seams.
+// The number of tiles is capped; a tileSize that would exceed the cap is enlarged.
+//================================================================================
+static const double s_maxCutFillTiles = 65536.0;
+
+struct CutFillTileGrid
+{
+bvector<double> m_xBreaks;      // numX + 1 tile boundaries, shared by adjacent tiles so seams match exactly.
+bvector<double> m_yBreaks;
+double m_zLow, m_zHigh;
+
+CutFillTileGrid (DRange3dCR range, double tileSize)
+    {
+    m_zLow = range.low.z;
+    m_zHigh = range.high.z;
+    tileSize = ClampTileSize (range, tileSize);
+    FillBreaks (m_xBreaks, range.low.x, range.high.x, tileSize);
+    FillBreaks (m_yBreaks, range.low.y, range.high.y, tileSize);
+    }
+
+// Number of tiles along an axis of given length (computed in double so tiny tiles cannot overflow size_t).
+static double NumTilesAlong (double length, double tileSize)
+    {
+    if (!(tileSize > 0.0) || !(length > 0.0))
+        return 1.0;
+    return std::max (1.0, ceil (length / tileSize));
+    }
+
+// Enlarge tileSize until the grid over range has at most s_maxCutFillTiles tiles.  Returns 0 (single tile) for non-positive tileSize.
+static double ClampTileSize (DRange3dCR range, double tileSize)
+    {
+    if (!(tileSize > 0.0))
+        return 0.0;
+    for (;;)
+        {
+        double numTiles = NumTilesAlong (range.XLength (), tileSize) * NumTilesAlong (range.YLength (), tileSize);
+        if (numTiles <= s_maxCutFillTiles)
+            return tileSize;
+        tileSize *= std::max (1.01, sqrt (numTiles / s_maxCutFillTiles));
+        }
+    }
+
+static void FillBreaks (bvector<double> &breaks, double a0, double a1, double tileSize)
+    {
+    size_t numTile = (size_t)NumTilesAlong (a1 - a0, tileSize);
+    breaks.push_back (a0);
+    for (size_t i = 1; i < numTile; i++)
+        breaks.push_back (a0 + i * tileSize);
+    breaks.push_back (a1);
+    }
+
+size_t NumX () const {return m_xBreaks.size () - 1;}
+size_t NumY () const {return m_yBreaks.size () - 1;}
+size_t NumTiles () const {return NumX () * NumY ();}
+
+// range of tile, with z expanded so clipping only acts in xy.
+DRange3d TileRange (size_t tileIndex) const
+    {
+    size_t i = tileIndex % NumX ();
+    size_t j = tileIndex / NumX ();
+    double dz = 1.0 + (m_zHigh - m_zLow);
+    return DRange3d::From (m_xBreaks[i], m_yBreaks[j], m_zLow - dz, m_xBreaks[i + 1], m_yBreaks[j + 1], m_zHigh + dz);
+    }
+
+// index interval [i0,i1] of tiles touched by [a0,a1] along one axis.
+static void TouchedInterval (bvector<double> const &breaks, double a0, double a1, size_t &i0, size_t &i1)
+    {
+    size_t numTile = breaks.size () - 1;
+    i0 = (size_t)(std::upper_bound (breaks.begin () + 1, breaks.end () - 1, a0) - breaks.begin ()) - 1;
+    i1 = (size_t)(std::lower_bound (breaks.begin () + 1, breaks.end () - 1, a1) - breaks.begin ()) - 1;
+    if (i1 >= numTile)
+        i1 = numTile - 1;
+    if (i0 > i1)
+        i0 = i1;
+    }
 
+// Record each facet's read index in the buckets of all tiles touched by the facet's xy range.
+void BucketFacets (PolyfaceQueryCR mesh, bvector<bvector<size_t>> &buckets) const
+    {
+    buckets.clear ();
+    buckets.resize (NumTiles ());
+    for (PolyfaceVisitorPtr visitor = PolyfaceVisitor::Attach (mesh, false); visitor->AdvanceToNextFace ();)
+        {
+        DRange3d facetRange = DRange3d::From (visitor->Point ());
+        size_t i0, i1, j0, j1;
+        TouchedInterval (m_xBreaks, facetRange.low.x, facetRange.high.x, i0, i1);
+        TouchedInterval (m_yBreaks, facetRange.low.y, facetRange.high.y, j0, j1);
+        for (size_t j = j0; j <= j1; j++)
+            for (size_t i = i0; i <= i1; i++)
+                buckets[j * NumX () + i].push_back (visitor->GetReadIndex ());
+        }
+    }
+};
+
+// Capture the single output of a ClipToRange call.
+struct CutFillTileClipOutput : PolyfaceQuery::IClipToPlaneSetOutput
+{
+PolyfaceHeaderPtr m_source;
+PolyfaceHeaderPtr m_result;
+CutFillTileClipOutput (PolyfaceHeaderPtr &source) : m_source (source) {}
+StatusInt _ProcessUnclippedPolyface (PolyfaceQueryCR polyfaceQuery) override {m_result = m_source; return SUCCESS;}
+StatusInt _ProcessClippedPolyface (PolyfaceHeaderR polyfaceHeader) override {m_result = &polyfaceHeader; return SUCCESS;}
+};
+
+// Gather the bucketed facets of mesh into a new mesh and clip it to the tile range.
+// Returns nullptr if nothing of the mesh is in the tile.
+static PolyfaceHeaderPtr ExtractTileMesh (PolyfaceQueryCR mesh, bvector<size_t> const &readIndices, DRange3dCR tileRange)
+    {
+    if (readIndices.empty ())
+        return nullptr;
+    PolyfaceHeaderPtr tileMesh = PolyfaceHeader::CreateVariableSizeIndexed ();
+    PolyfaceVisitorPtr visitor = PolyfaceVisitor::Attach (mesh, false);
+    for (size_t readIndex : readIndices)
+        {
+        if (visitor->MoveToFacetByReadIndex (readIndex))
+            tileMesh->AddPolygon (visitor->Point ());
+        }
+    CutFillTileClipOutput output (tileMesh);
+    tileMesh->ClipToRange (tileRange, output, false);
+    if (output.m_result.IsValid () && output.m_result->GetPointIndexCount () == 0)
+        return nullptr;
+    return output.m_result;
+    }
+
+// Clip meshA and meshB to each tile and call tileFunction (tileIndex, tileMeshA, tileMeshB) for tiles where both have facets.
+// Tile indices are handed out to up to numThreads threads; the calling thread also does tiles.
+// Per-tile memory is released as each tile completes.
+template <typename TileFunction>
+static void ForEachCutFillTile (PolyfaceQueryCR meshA, PolyfaceQueryCR meshB, CutFillTileGrid const &grid, size_t numThreads, TileFunction const &tileFunction)
+    {
+    bvector<bvector<size_t>> bucketsA, bucketsB;
+    grid.BucketFacets (meshA, bucketsA);
+    grid.BucketFacets (meshB, bucketsB);
+    RunTasksInParallel (grid.NumTiles (), ResolveThreadCount (numThreads), [&] (size_t tileIndex, size_t)
+        {
+        if (bucketsA[tileIndex].empty () || bucketsB[tileIndex].empty ())
+            return;
+        DRange3d tileRange = grid.TileRange (tileIndex);
+        PolyfaceHeaderPtr tileA = ExtractTileMesh (meshA, bucketsA[tileIndex], tileRange);
+        PolyfaceHeaderPtr tileB = ExtractTileMesh (meshB, bucketsB[tileIndex], tileRange);
+        if (tileA.IsValid () && tileB.IsValid ())
+            tileFunction (tileIndex, *tileA, *tileB);
+        });
+    }
+
+static DRange3d CutFillInputRange (PolyfaceQueryCR meshA, PolyfaceQueryCR meshB)
+    {
+    DRange3d range;
+    range.InitFrom (meshA.GetPointCP (), (int)meshA.GetPointCount ());
+    range.Extend (meshB.GetPointCP (), (int)meshB.GetPointCount ());
+    return range;
+    }
+
+// Merge the per-tile meshes into one mesh.  Tiles clip along identical seams, so seam vertices are welded and vertices
+// that only one side of a seam has are inserted into the edges of the other side.  Returns nullptr if no tile has facets.
+static PolyfaceHeaderPtr StitchTileMeshes (bvector<PolyfaceHeaderPtr> const &perTile)
+    {
+    bvector<PolyfaceHeaderPtr> meshes;
+    for (auto &mesh : perTile)
+        {
+        if (mesh.IsValid () && mesh->GetPointIndexCount () > 0)
+            meshes.push_back (mesh);
+        }
+    if (meshes.empty ())
+        return nullptr;
+    return PolyfaceHeader::CloneWithTVertexFixup (meshes);
+    }
 
-    PolyfaceQuery::ComputeOverAndUnderXY (meshB, nullptr, meshA, nullptr, BTop, BUnder);
-    BTop = PolyfaceHeader::CloneWithTVertexFixup (bvector<PolyfaceHeaderPtr> {BTop, BUnder});
-    fillMesh = PolyfaceHeader::CloneWithSidePanelsInserted (bvector<PolyfaceHeaderPtr> {BTop}, viewVector);
+void PolyfaceHeader::ComputeSingleSheetCutFillTiled
+(
+PolyfaceHeaderCR dtm,
+PolyfaceHeaderCR road,
+DVec3dCR viewVector,
+double tileSize,
+PolyfaceHeaderPtr &cutMesh,
+PolyfaceHeaderPtr &fillMesh,
+size_t numThreads
+)
+    {
+    cutMesh = nullptr;
+    fillMesh = nullptr;
+    if (dtm.GetPointCount () == 0 || road.GetPointCount () == 0)
+        return;
+    CutFillTileGrid grid (CutFillInputRange (dtm, road), tileSize);
+    bvector<PolyfaceHeaderPtr> tileCut (grid.NumTiles ()), tileFill (grid.NumTiles ());
+    ForEachCutFillTile (dtm, road, grid, numThreads,
+        [&] (size_t tileIndex, PolyfaceHeaderR tileDtm, PolyfaceHeaderR tileRoad)
+            {
+            tileCut[tileIndex] = ComputeSingleSheetSurfaces (tileDtm, tileRoad);
+            tileFill[tileIndex] = ComputeSingleSheetSurfaces (tileRoad, tileDtm);
+            });
+
+    // The surfaces are stitched before the side panels are built, so panels only close the outer boundaries of the volumes
+    // and no panels are created on the tile seams.
+    PolyfaceHeaderPtr cutSurfaces = StitchTileMeshes (tileCut);
+    tileCut.clear ();
+    if (cutSurfaces.IsValid ())
+        cutMesh = CloneWithSidePanelsInserted (bvector<PolyfaceHeaderPtr> {cutSurfaces}, viewVector);
+    PolyfaceHeaderPtr fillSurfaces = StitchTileMeshes (tileFill);
+    tileFill.clear ();
+    if (fillSurfaces.IsValid ())
+        fillMesh = CloneWithSidePanelsInserted (bvector<PolyfaceHeaderPtr> {fillSurfaces}, viewVector);
+    }
+
+void PolyfaceQuery::ComputeCutAndFillTiled
+(
+PolyfaceHeaderCR polyfaceA,
+PolyfaceHeaderCR polyfaceB,
+double tileSize,
+bvector<PolyfaceHeaderPtr> &resultAaboveB,
+bvector<PolyfaceHeaderPtr> &resultBaboveA,
+size_t numThreads
+)
+    {
+    resultAaboveB.clear ();
+    resultBaboveA.clear ();
+    if (polyfaceA.GetPointCount () == 0 || polyfaceB.GetPointCount () == 0)
+        return;
+    CutFillTileGrid grid (CutFillInputRange (polyfaceA, polyfaceB), tileSize);
+    bvector<bvector<PolyfaceHeaderPtr>> tileAaboveB (grid.NumTiles ()), tileBaboveA (grid.NumTiles ());
+    ForEachCutFillTile (polyfaceA, polyfaceB, grid, numThreads,
+        [&] (size_t tileIndex, PolyfaceHeaderR tileA, PolyfaceHeaderR tileB)
+            {
+            ComputeCutAndFill (tileA, tileB, tileAaboveB[tileIndex], tileBaboveA[tileIndex]);
+            });
 
+    // ComputeCutAndFill returns upper and lower surfaces without side panels, so the tiles only need to be welded.
+    bvector<PolyfaceHeaderPtr> allAaboveB, allBaboveA;
+    for (size_t i = 0; i < grid.NumTiles (); i++)
+        {
+        allAaboveB.insert (allAaboveB.end (), tileAaboveB[i].begin (), tileAaboveB[i].end ());
+        allBaboveA.insert (allBaboveA.end (), tileBaboveA[i].begin (), tileBaboveA[i].end ());
+        }
+    tileAaboveB.clear ();
+    tileBaboveA.clear ();
+    PolyfaceHeaderPtr stitchedAaboveB = StitchTileMeshes (allAaboveB);
+    if (stitchedAaboveB.IsValid ())
+        resultAaboveB.push_back (stitchedAaboveB);
+    PolyfaceHeaderPtr stitchedBaboveA = StitchTileMeshes (allBaboveA);
+    if (stitchedBaboveA.IsValid ())
+        resultBaboveA.push_back (stitchedBaboveA);
     }
 
 END_BENTLEY_GEOMETRY_NAMESPACE
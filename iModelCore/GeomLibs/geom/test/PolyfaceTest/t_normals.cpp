@@ -204,6 +204,139 @@ TEST(FastCutFill,SlopedWithCrossings)
     Check::ClearGeometry ("FastCutFill.SlopedWithCrossings");
     }
 
+// Sum the areas of the vertical facets (side panels) of a mesh.
+static double SumVerticalFacetAreas (PolyfaceHeaderCR mesh)
+    {
+    double sum = 0.0;
+    auto visitor = PolyfaceVisitor::Attach (mesh);
+    for (visitor->Reset (); visitor->AdvanceToNextFace ();)
+        {
+        DVec3d areaNormal = PolygonOps::AreaNormal (visitor->Point ());
+        double area = areaNormal.Magnitude ();
+        if (area > 0.0 && fabs (areaNormal.z) <= 1.0e-8 * area)
+            sum += area;
+        }
+    return sum;
+    }
+
+// Compare a tiled cut or fill mesh to the single pass mesh: same closed volume, same range, and no extra side panels on tile seams.
+static void CheckStitchedCutFillMesh (PolyfaceHeaderPtr &singlePass, PolyfaceHeaderPtr &tiled, char const *name)
+    {
+    if (!Check::True (tiled.IsValid (), name))
+        return;
+    Check::True (tiled->IsClosedByEdgePairing (), "tiled mesh is closed");
+    auto volume1 = GetVolume (singlePass);
+    auto volume2 = tiled->ValidatedVolume ();
+    Check::True (volume2.IsValid (), "tiled volume valid");
+    Check::Near (volume1.Value (), volume2.Value (), "tiled volume");
+    DRange3d range1 = singlePass->PointRange ();
+    DRange3d range2 = tiled->PointRange ();
+    Check::Near (range1.low, range2.low, "tiled range low");
+    Check::Near (range1.high, range2.high, "tiled range high");
+    Check::Near (SumVerticalFacetAreas (*singlePass), SumVerticalFacetAreas (*tiled), "tiled side panel area");
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST(FastCutFill,TiledMatchesSinglePass)
+    {
+    double dtmSide = 2.5;
+    double roadSide = 1.0;
+    auto road = UnitGridPolyface (
+            DPoint3dDVec3dDVec3d (DPoint3d::From (1,1,1),   DVec3d::From (roadSide,0,0),   DVec3d::From (0,roadSide,-0.3)),
+                            9, 6, false);
+    DRange3d roadRange = road->PointRange ();
+    int dtmNumX = 1 + (int)((roadRange.XLength () + dtmSide) / dtmSide);
+    int dtmNumY = 1 + (int)((roadRange.YLength () + dtmSide) / dtmSide);
+    auto dtm = UnitGridPolyface (
+            DPoint3dDVec3dDVec3d (DPoint3d::From (0,0,0),   DVec3d::From (dtmSide,0,0),   DVec3d::From (0,dtmSide,0)),
+                            dtmNumX, dtmNumY, false);
+
+    PolyfaceHeaderPtr cutMesh, fillMesh;
+    PolyfaceHeader::ComputeSingleSheetCutFill (*dtm, *road, DVec3d::From (0,0,1), cutMesh, fillMesh);
+    auto cutVolume1 = GetVolume (cutMesh);
+    auto fillVolume1 = GetVolume (fillMesh);
+    Check::True (cutVolume1.IsValid (), "single pass cut volume");
+    Check::True (fillVolume1.IsValid (), "single pass fill volume");
+
+    for (double tileSize : bvector<double> {0.0, 3.0, 1.7})
+        {
+        for (size_t numThreads : bvector<size_t> {1, 4})
+            {
+            SaveAndRestoreCheckTransform shifter (30.0, 0, 0);
+            PolyfaceHeaderPtr cutMesh2, fillMesh2;
+            PolyfaceHeader::ComputeSingleSheetCutFillTiled (*dtm, *road, DVec3d::From (0,0,1), tileSize,
+                        cutMesh2, fillMesh2, numThreads);
+            if (cutMesh2.IsValid ())
+                Check::SaveTransformed (*cutMesh2);
+            if (fillMesh2.IsValid ())
+                Check::SaveTransformed (*fillMesh2);
+            CheckStitchedCutFillMesh (cutMesh, cutMesh2, "tiled cut mesh");
+            CheckStitchedCutFillMesh (fillMesh, fillMesh2, "tiled fill mesh");
+            }
+        }
+
+    // A tiny tile size is enlarged to keep the tile count bounded.
+    PolyfaceHeaderPtr cutMesh3, fillMesh3;
+    PolyfaceHeader::ComputeSingleSheetCutFillTiled (*dtm, *road, DVec3d::From (0,0,1), 1.0e-12, cutMesh3, fillMesh3);
+    CheckStitchedCutFillMesh (cutMesh, cutMesh3, "clamped tiles cut mesh");
+    CheckStitchedCutFillMesh (fillMesh, fillMesh3, "clamped tiles fill mesh");
+    Check::ClearGeometry ("FastCutFill.TiledMatchesSinglePass");
+    }
+
+// Sum the volumes of cut/fill pieces after healing their vertical panels.  Invalid if any piece volume is invalid.
+static ValidatedDouble SumHealedVolumes (bvector<PolyfaceHeaderPtr> &meshes)
+    {
+    ValidatedDouble sum (0.0, true);
+    for (auto &m : meshes)
+        {
+        PolyfaceHeaderPtr m1;
+        PolyfaceQuery::HealVerticalPanels (*m, true, false, m1);
+        auto volume = m1.IsValid () ? m1->ValidatedVolume () : ValidatedDouble (0.0, false);
+        sum = ValidatedDouble (sum.Value () + volume.Value (), sum.IsValid () && volume.IsValid ());
+        }
+    return sum;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST(Polyface,CutFillTiled)
+    {
+    double dtmSide = 2.5;
+    double roadSide = 1.0;
+    auto road = UnitGridPolyface (
+            DPoint3dDVec3dDVec3d (DPoint3d::From (1,1,1),   DVec3d::From (roadSide,0,0),   DVec3d::From (0,roadSide,0)),
+                            6, 6, false);
+    auto dtm = UnitGridPolyface (
+            DPoint3dDVec3dDVec3d (DPoint3d::From (0,0,0),   DVec3d::From (dtmSide,0,0),   DVec3d::From (0,dtmSide,0)),
+                            4, 4, false);
+    bvector<PolyfaceHeaderPtr> roadAbove1, dtmAbove1;
+    PolyfaceQuery::ComputeCutAndFill (*road, *dtm, roadAbove1, dtmAbove1);
+    auto volume1 = SumHealedVolumes (roadAbove1);
+    Check::True (volume1.IsValid (), "single pass volume");
+    Check::Near (36.0, fabs (volume1.Value ()), "single pass volume is road area times height");
+
+    for (double tileSize : bvector<double> {0.0, 3.0, 1.7})
+        {
+        for (size_t numThreads : bvector<size_t> {1, 4})
+            {
+            SaveAndRestoreCheckTransform shifter (30.0, 0, 0);
+            bvector<PolyfaceHeaderPtr> roadAbove2, dtmAbove2;
+            PolyfaceQuery::ComputeCutAndFillTiled (*road, *dtm, tileSize, roadAbove2, dtmAbove2, numThreads);
+            for (auto &m : roadAbove2)
+                Check::SaveTransformed (*m);
+            Check::True (dtmAbove2.empty (), "road is entirely above dtm");
+            auto volume2 = SumHealedVolumes (roadAbove2);
+            Check::True (volume2.IsValid (), "tiled volume valid");
+            Check::Near (volume1.Value (), volume2.Value (), "tiled volume");
+            Check::Size (1, roadAbove2.size (), "tiles are stitched into one mesh");
+            }
+        }
+    Check::ClearGeometry ("Polyface.CutFillTiled");
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -186,6 +186,57 @@ TEST(PFRangeTree,CollectClash)
     PolyfaceRangeTree::CollectClashPairs (*mesh1, *rangeTree1, *mesh2, *rangeTree2, 0.0, hits, 10000, searcher);
     Check::Size (numX * numY, hits.size (), "hits");    
     }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST(PFRangeTree,FacetBVHClashMatchesRangeTree)
+    {
+    // small rectangles parallel to xz plane, in a lattice big enough for the parallel build
+    bvector<DPoint3d> rectangle;
+    rectangle.push_back (DPoint3d::From (0,0,0));
+    rectangle.push_back (DPoint3d::From (0.9,0,0));
+    rectangle.push_back (DPoint3d::From (0.9,0,0.5));
+    rectangle.push_back (DPoint3d::From (0,0,0.5));
+    PolyfaceHeaderPtr mesh1 = CreateSpaceBlockMesh (rectangle, 20, 16, 8, DVec3d::From (0,0,0), 1.0);
+
+    // tilted triangles in a shifted lattice, so that some pairs clash and some are just near
+    bvector<DPoint3d> triangle;
+    triangle.push_back (DPoint3d::From (0,-0.2,0));
+    triangle.push_back (DPoint3d::From (0.6,0.3,0.1));
+    triangle.push_back (DPoint3d::From (0.2,0.1,0.7));
+    PolyfaceHeaderPtr mesh2 = CreateSpaceBlockMesh (triangle, 10, 9, 6, DVec3d::From (0.35,0.02,0.1), 1.7);
+
+    PolyfaceRangeTreePtr rangeTree1 = PolyfaceRangeTree::CreateForPolyface (*mesh1);
+    PolyfaceRangeTreePtr rangeTree2 = PolyfaceRangeTree::CreateForPolyface (*mesh2);
+    XYZRangeTreeMultiSearch searcher;
+    for (size_t numThreads : {1, 4})
+        {
+        PolyfaceFacetBVHPtr bvh1 = PolyfaceFacetBVH::CreateForPolyface (*mesh1, numThreads);
+        PolyfaceFacetBVHPtr bvh2 = PolyfaceFacetBVH::CreateForPolyface (*mesh2, numThreads);
+        Check::Size (mesh1->GetNumFacet (), bvh1->GetReadIndices ().size (), "facets in bvh");
+        for (double proximity : {0.0, 0.05, 0.3})
+            {
+            bvector<std::pair<size_t, size_t>> expectedHits, hits;
+            PolyfaceRangeTree::CollectClashPairs (*mesh1, *rangeTree1, *mesh2, *rangeTree2, proximity, expectedHits, SIZE_MAX, searcher);
+            PolyfaceFacetBVH::CollectClashPairs (*mesh1, *bvh1, *mesh2, *bvh2, proximity, hits, SIZE_MAX, numThreads);
+            std::sort (expectedHits.begin (), expectedHits.end ());
+            Check::True (expectedHits.size () > 0, "clashes expected");
+            if (Check::Size (expectedHits.size (), hits.size (), "bvh clash count"))
+                {
+                for (size_t i = 0; i < hits.size (); i++)
+                    {
+                    Check::Size (expectedHits[i].first, hits[i].first, "bvh clash facet A");
+                    Check::Size (expectedHits[i].second, hits[i].second, "bvh clash facet B");
+                    }
+                }
+
+            PolyfaceFacetBVH::CollectClashPairs (*mesh1, *bvh1, *mesh2, *bvh2, proximity, hits, 3, numThreads);
+            Check::Size (std::min ((size_t) 3, expectedHits.size ()), hits.size (), "bvh clash count limited by maxHits");
+            }
+        }
+    }
+
 #ifdef COMPILE_bvRangeTree
 
 void TestPolyfaceRangeTree01 (size_t numX, size_t numY, size_t numZ)
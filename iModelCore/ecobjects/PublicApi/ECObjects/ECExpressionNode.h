@@ -560,10 +560,17 @@ protected:
     ExpressionStatus PromoteCommon(EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context, bool allowStrings);
     ExpressionStatus GetOperandValues(EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context);
 
+    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+
+    //  Applies the operator to operand values that have already been evaluated. The operand values may be modified by promotion.
+    virtual ExpressionStatus _ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
+                                        { return ExpressionStatus::NotImpl; }
+
 public:
     BinaryNode (ExpressionToken operatorCode, NodeR left, NodeR right) : m_operatorCode(operatorCode), m_left(&left), m_right(&right) {}
 
-    //  virtual abstract ECEvaluationResult ApplyOperator (ECEvaluationResult leftValue, ECEvaluationResult rightValue);
+    ExpressionStatus ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
+                                        { return _ApplyOperator(evalResult, leftResult, rightResult, context); }
 
 };  //  End of struct Binary
 
@@ -576,7 +583,7 @@ public:
 struct          ArithmeticNode : BinaryNode  //  No modifiers -- see ModifierNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context) override;
 
     virtual ExpressionStatus _Promote(EvaluationResult& leftResult, EvaluationResult& rightResult, 
                                         ExpressionContextR context) { return ExpressionStatus::NotImpl; }
@@ -605,7 +612,7 @@ public:
 struct          ExponentNode : ArithmeticNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context) override;
 
 public:
     ExponentNode(NodeR left, NodeR right) : ArithmeticNode (TOKEN_Exponentiation, left, right) {}
@@ -621,7 +628,7 @@ public:
 struct          MultiplyNode : ArithmeticNode  //  No modifiers -- see ModifierNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context) override;
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveMultiplyNode(*this);}
 
 public:
@@ -637,7 +644,7 @@ public:
 struct          DivideNode : ArithmeticNode  //  No modifiers -- see ModifierNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context) override;
 
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveDivideNode(*this);}
 public:
@@ -676,7 +683,7 @@ public:
 struct          ConcatenateNode : ArithmeticNode 
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context) override;
 
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveConcatenateNode(*this);}
 public:
@@ -693,7 +700,7 @@ public:
 struct          ShiftNode : BinaryNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context) override;
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override { return context._ResolveShiftNode(*this); }
 
 public:
@@ -710,7 +717,7 @@ public:
 struct          ComparisonNode : BinaryNode
 {
 protected:
-    ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context) override;
 
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveComparisonNode(*this);}
 
@@ -729,6 +736,7 @@ struct          LogicalNode : BinaryNode
 {
 protected:
     ExpressionStatus _GetValue(EvaluationResult& evalResult, ExpressionContextR context) override;
+    ExpressionStatus _ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context) override;
     ResolvedTypeNodePtr _GetResolvedTree(ExpressionResolverR context) override {return context._ResolveLogicalNode(*this);}
     bool _SetOperation(ExpressionToken operatorCode) override
         {
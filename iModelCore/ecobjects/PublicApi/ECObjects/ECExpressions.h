@@ -38,6 +38,7 @@ EXPR_TYPEDEFS(ArgumentTreeNode)
 EXPR_TYPEDEFS(ArithmeticNode)
 EXPR_TYPEDEFS(BinaryNode)
 EXPR_TYPEDEFS(CallNode)
+EXPR_TYPEDEFS(CompiledExpression)
 EXPR_TYPEDEFS(LambdaNode)
 EXPR_TYPEDEFS(ComparisonNode)
 EXPR_TYPEDEFS(ConcatenateNode)
@@ -80,6 +81,7 @@ BEGIN_BENTLEY_ECOBJECT_NAMESPACE
 
 typedef RefCountedPtr<ArgumentTreeNode>             ArgumentTreeNodePtr;
 typedef RefCountedPtr<CallNode>                     CallNodePtr;
+typedef RefCountedPtr<CompiledExpression>           CompiledExpressionPtr;
 typedef RefCountedPtr<LambdaNode>                   LambdaNodePtr;
 typedef RefCountedPtr<ContextSymbol>                ContextSymbolPtr;
 typedef RefCountedPtr<DotNode>                      DotNodePtr;
@@ -1087,6 +1089,73 @@ public:
     ECOBJECTS_EXPORT Utf8String  ToExpressionString() const;
 };  //  End of struct Node
 
+/*=================================================================================**//**
+* An expression tree lowered into a flat sequence of instructions which are executed by
+* a single loop over a value stack sized at compile time. Constant subexpressions are
+* folded, comparisons and arithmetic on same-typed primitive operands are evaluated in
+* place and the short-circuit operators and IIf become jumps. Subtrees which access
+* symbols are kept in a table of slots and evaluated against the context passed to GetValue.
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct          CompiledExpression : RefCountedBase
+{
+#ifndef DOCUMENTATION_GENERATOR
+private:
+    enum class OpCode : uint8_t
+        {
+        PushConstant,       //  push m_constants[m_operand]
+        LoadSlot,           //  evaluate m_slots[m_operand] and push the result
+        Unary,              //  apply m_operator to the top value
+        Binary,             //  apply m_node's operator to the two top values
+        CompareConstant,    //  compare the top value to m_constants[m_operand] using m_node's operator
+        Jump,               //  continue at m_operand
+        JumpIfFalse,        //  pop the condition and continue at m_operand if it's false
+        BeginOrElse,        //  errors until the matching ShortCircuit evaluate the lefthand value to false
+        ShortCircuit,       //  continue at m_operand if the lefthand value of m_operator decides the result
+        Combine,            //  combine lefthand and righthand values of m_operator
+        };
+
+    struct Instruction
+        {
+        OpCode          m_opCode;
+        ExpressionToken m_operator;
+        uint32_t        m_operand;
+        NodeP           m_node;
+        Instruction(OpCode opCode, ExpressionToken op = TOKEN_None, uint32_t operand = 0, NodeP node = nullptr)
+            : m_opCode(opCode), m_operator(op), m_operand(operand), m_node(node)
+            {}
+        };
+
+    struct Compiler;
+
+    NodePtr                 m_root;
+    bvector<Instruction>    m_instructions;
+    bvector<ECValue>        m_constants;
+    bvector<NodePtr>        m_slots;
+    uint32_t                m_maxStackDepth;
+    uint32_t                m_maxGuardDepth;
+
+    CompiledExpression(NodeR root) : m_root(&root), m_maxStackDepth(0), m_maxGuardDepth(0) {}
+    ExpressionStatus Execute(EvaluationResult** stack, uint32_t* guards, ExpressionContextR context) const;
+#endif
+
+public:
+    //! Compiles the given expression tree. The tree is referenced by the compiled expression and must not be modified afterwards.
+    ECOBJECTS_EXPORT static CompiledExpressionPtr Create(NodeR root);
+
+    //! Returns the value of the compiled expression using the supplied context
+    ECOBJECTS_EXPORT ExpressionStatus GetValue(EvaluationResult& evalResult, ExpressionContextR context) const;
+
+    //! Returns the expression tree this expression was compiled from
+    NodeR GetNode() const {return *m_root;}
+
+#ifndef DOCUMENTATION_GENERATOR
+    size_t GetInstructionsCount() const {return m_instructions.size();}
+    size_t GetConstantsCount() const {return m_constants.size();}
+    size_t GetSlotsCount() const {return m_slots.size();}
+#endif
+};  //  End of struct CompiledExpression
+
 /** @endGroup */
 END_BENTLEY_ECOBJECT_NAMESPACE
 
@@ -2247,16 +2247,9 @@ ExpressionStatus IIfNode::_GetValue(EvaluationResult& evalResult, ExpressionCont
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus  ArithmeticNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus  ArithmeticNode::_ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
     {
-    EvaluationResult    leftResult;
-    EvaluationResult    rightResult;
-    ExpressionStatus    status = GetOperandValues(leftResult, rightResult, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
-    status = _Promote(leftResult, rightResult, context);
+    ExpressionStatus    status = _Promote(leftResult, rightResult, context);
     if (ExpressionStatus::Success != status)
         return status;
 
@@ -2266,36 +2259,23 @@ ExpressionStatus  ArithmeticNode::_GetValue(EvaluationResult& evalResult, Expres
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus  ConcatenateNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus  ConcatenateNode::_ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
     {
-    EvaluationResult    leftResult;
-    EvaluationResult    rightResult;
-    ExpressionStatus    status = GetOperandValues(leftResult, rightResult, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
+    ExpressionStatus    status;
     if (((status = Operations::ConvertToString(leftResult)) != ExpressionStatus::Success) || ((status = Operations::ConvertToString(rightResult)) != ExpressionStatus::Success))
         return status;
 
     performConcatenation (evalResult.InitECValue(), *leftResult.GetECValue(), *rightResult.GetECValue());
 
-    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ConcatenateNode::_GetValue: Result: ", evalResult.ToString().c_str()).c_str());
+    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ConcatenateNode::_ApplyOperator: Result: ", evalResult.ToString().c_str()).c_str());
     return ExpressionStatus::Success;
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus  ShiftNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus  ShiftNode::_ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
     {
-    EvaluationResult    leftResult;
-    EvaluationResult    rightResult;
-    ExpressionStatus    status = GetOperandValues(leftResult, rightResult, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
     return Operations::PerformShift(evalResult, m_operatorCode, leftResult, rightResult);
     }
 
@@ -2315,7 +2295,7 @@ ExpressionStatus  LogicalNode::_GetValue(EvaluationResult& evalResult, Expressio
     case TOKEN_Xor:
         status = GetOperandValues(leftResult, rightResult, context);
         if (ExpressionStatus::Success == status)
-            status = Operations::PerformJunctionOperator(evalResult, _GetOperation(), leftResult, rightResult);
+            status = _ApplyOperator(evalResult, leftResult, rightResult, context);
         break;
 
     case TOKEN_AndAlso:
@@ -2349,6 +2329,38 @@ ExpressionStatus  LogicalNode::_GetValue(EvaluationResult& evalResult, Expressio
     return status;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus  LogicalNode::_ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
+    {
+    switch (m_operatorCode)
+        {
+    case TOKEN_And:
+    case TOKEN_Or:
+    case TOKEN_Xor:
+        return Operations::PerformJunctionOperator(evalResult, m_operatorCode, leftResult, rightResult);
+        }
+
+    // Short-circuit operators need the lefthand value before evaluating the righthand expression
+    return ExpressionStatus::NotImpl;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus BinaryNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+    {
+    EvaluationResult    leftResult;
+    EvaluationResult    rightResult;
+    ExpressionStatus    status = GetOperandValues(leftResult, rightResult, context);
+
+    if (ExpressionStatus::Success != status)
+        return status;
+
+    return _ApplyOperator(evalResult, leftResult, rightResult, context);
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -2502,57 +2514,36 @@ ExpressionStatus BinaryNode::PromoteCommon(EvaluationResult& leftResult, Evaluat
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus ExponentNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus ExponentNode::_ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
     {
-    EvaluationResult    left;
-    EvaluationResult    right;
-    ExpressionStatus status = GetOperandValues(left, right, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
-    return Operations::PerformExponentiation(evalResult, left, right);
+    return Operations::PerformExponentiation(evalResult, leftResult, rightResult);
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus MultiplyNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus MultiplyNode::_ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
     {
-    EvaluationResult    left;
-    EvaluationResult    right;
-    ExpressionStatus status = GetOperandValues(left, right, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
-    return Operations::PerformMultiplication(evalResult, left, right);
+    return Operations::PerformMultiplication(evalResult, leftResult, rightResult);
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus DivideNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus DivideNode::_ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
     {
-    EvaluationResult    left;
-    EvaluationResult    right;
-    ExpressionStatus status = GetOperandValues(left, right, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
     switch(m_operatorCode)
         {
         case TOKEN_IntegerDivide:
-            return Operations::PerformIntegerDivision(evalResult, left, right);
+            return Operations::PerformIntegerDivision(evalResult, leftResult, rightResult);
         case TOKEN_Slash:
-            return Operations::PerformDivision(evalResult, left, right);
+            return Operations::PerformDivision(evalResult, leftResult, rightResult);
         case TOKEN_Mod:
-            return Operations::PerformMod(evalResult, left, right);
+            return Operations::PerformMod(evalResult, leftResult, rightResult);
         }
 
     BeAssert (false && L"bad divide operator");
-    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, Utf8PrintfString("DivideNode::_GetValue: UnknownError. Bad divide operator (left: %s, right: %s)", left.ToString().c_str(), right.ToString().c_str()).c_str());
+    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, Utf8PrintfString("DivideNode::_ApplyOperator: UnknownError. Bad divide operator (left: %s, right: %s)", leftResult.ToString().c_str(), rightResult.ToString().c_str()).c_str());
     return ExpressionStatus::UnknownError;
     }
 
@@ -2681,24 +2672,16 @@ template<> /*static*/ bool     PerformCompare<double> (double l, ExpressionToken
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ExpressionStatus ComparisonNode::_GetValue(EvaluationResult& evalResult, ExpressionContextR context)
+ExpressionStatus ComparisonNode::_ApplyOperator(EvaluationResult& evalResult, EvaluationResult& leftResult, EvaluationResult& rightResult, ExpressionContextR context)
     {
-    EvaluationResult    leftResult;
-    EvaluationResult    rightResult;
-
-    ExpressionStatus status = GetOperandValues(leftResult, rightResult, context);
-
-    if (ExpressionStatus::Success != status)
-        return status;
-
-    status = PromoteCommon(leftResult, rightResult, context, true);
+    ExpressionStatus status = PromoteCommon(leftResult, rightResult, context, true);
 
     if (ExpressionStatus::Success != status)
         return status;
 
     if (TOKEN_Like == m_operatorCode)
         {
-        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, Utf8PrintfString("ComparisonNode::_GetValue: NotImplemented (operator: %s)", Lexer::GetString(m_operatorCode).c_str()).c_str());
+        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, Utf8PrintfString("ComparisonNode::_ApplyOperator: NotImplemented (operator: %s)", Lexer::GetString(m_operatorCode).c_str()).c_str());
         return ExpressionStatus::NotImpl;
         }
 
@@ -2717,7 +2700,7 @@ ExpressionStatus ComparisonNode::_GetValue(EvaluationResult& evalResult, Express
 
         //  Maybe the not's should be true for this
         evalResult.InitECValue().SetBoolean(boolResult);
-        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
         return ExpressionStatus::Success;
         }
 
@@ -2740,7 +2723,7 @@ ExpressionStatus ComparisonNode::_GetValue(EvaluationResult& evalResult, Express
             }
 
         evalResult.InitECValue().SetBoolean(boolResult);
-        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+        ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
         return ExpressionStatus::Success;
         }
 
@@ -2748,27 +2731,27 @@ ExpressionStatus ComparisonNode::_GetValue(EvaluationResult& evalResult, Express
         {
         case PRIMITIVETYPE_Boolean:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetBoolean(), m_operatorCode, ecRight.GetBoolean()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         case PRIMITIVETYPE_Double:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetDouble(), m_operatorCode, ecRight.GetDouble()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         case PRIMITIVETYPE_Integer:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetInteger(), m_operatorCode, ecRight.GetInteger()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         case PRIMITIVETYPE_Long:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetLong(), m_operatorCode, ecRight.GetLong()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         case PRIMITIVETYPE_DateTime:
             evalResult.InitECValue().SetBoolean(PerformCompare(ecLeft.GetDateTimeTicks(), m_operatorCode, ecRight.GetDateTimeTicks()));
-            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_GetValue: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
+            ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("ComparisonNode::_ApplyOperator: (%s %s %s) = %s", ecLeft.ToString().c_str(), Lexer::GetString(m_operatorCode).c_str(), ecRight.ToString().c_str(), evalResult.ToString().c_str()).c_str());
             return ExpressionStatus::Success;
         }
 
-    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, "ComparisonNode::_GetValue: WrongType");
+    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_ERROR, "ComparisonNode::_ApplyOperator: WrongType");
     return ExpressionStatus::WrongType;
     }
 
@@ -4607,4 +4590,525 @@ ExpressionStatus    LambdaValue::Evaluate (IValueListResultCR valueList, LambdaV
     return ExpressionStatus::Success;
     }
 
+static const uint32_t COMPILED_EXPRESSION_INLINE_STACK_SIZE = 4;
+static const uint32_t COMPILED_EXPRESSION_INLINE_GUARDS_COUNT = 2;
+
+/*=================================================================================**//**
+* @bsiclass
++===============+===============+===============+===============+===============+======*/
+struct CompiledExpression::Compiler
+{
+private:
+    CompiledExpression& m_expression;
+    SymbolExpressionContextPtr m_foldingContext;
+    uint32_t m_stackDepth;
+    uint32_t m_guardDepth;
+
+private:
+    uint32_t GetNextAddress() const {return (uint32_t)m_expression.m_instructions.size();}
+    uint32_t Emit(Instruction const& instruction) {m_expression.m_instructions.push_back(instruction); return GetNextAddress() - 1;}
+    void Patch(uint32_t address) {m_expression.m_instructions[address].m_operand = GetNextAddress();}
+    uint32_t AddConstant(ECValueCR value) {m_expression.m_constants.push_back(value); return (uint32_t)m_expression.m_constants.size() - 1;}
+
+    void Push()
+        {
+        if (++m_stackDepth > m_expression.m_maxStackDepth)
+            m_expression.m_maxStackDepth = m_stackDepth;
+        }
+    void Pop() {BeAssert(m_stackDepth > 0); m_stackDepth--;}
+
+    /*---------------------------------------------------------------------------------**//**
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    static bool IsShortCircuit(NodeCR node)
+        {
+        return nullptr != dynamic_cast<LogicalNodeCP>(&node)
+            && (TOKEN_AndAlso == node.GetOperation() || TOKEN_OrElse == node.GetOperation());
+        }
+
+    /*---------------------------------------------------------------------------------**//**
+    * Binary operators whose value only depends on the operand values (assignment is not one of them).
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    static bool IsOperator(NodeCR node)
+        {
+        return nullptr != dynamic_cast<ArithmeticNodeCP>(&node)
+            || nullptr != dynamic_cast<ComparisonNodeCP>(&node)
+            || nullptr != dynamic_cast<LogicalNodeCP>(&node)
+            || nullptr != dynamic_cast<ShiftNodeCP>(&node);
+        }
+
+    /*---------------------------------------------------------------------------------**//**
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    static bool IsFoldable(NodeCR node)
+        {
+        if (nullptr != dynamic_cast<LiteralNode const*>(&node))
+            return true;
+
+        if (nullptr != dynamic_cast<UnaryArithmeticNodeCP>(&node))
+            return IsFoldable(*node.GetLeftCP());
+
+        if (IsOperator(node))
+            return IsFoldable(*node.GetLeftCP()) && IsFoldable(*node.GetRightCP());
+
+        IIfNodeCP iif = dynamic_cast<IIfNodeCP>(&node);
+        if (nullptr != iif)
+            return IsFoldable(*iif->GetConditionP()) && IsFoldable(*iif->GetTrueP()) && IsFoldable(*iif->GetFalseP());
+
+        return false;
+        }
+
+    /*---------------------------------------------------------------------------------**//**
+    * Operator which may be evaluated directly on same-typed primitive operands, TOKEN_None
+    * if the node's own implementation has to be used.
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    static ExpressionToken GetSpecializedOperator(NodeCR node)
+        {
+        switch (node.GetOperation())
+            {
+            case TOKEN_Equal:
+            case TOKEN_NotEqual:
+            case TOKEN_Less:
+            case TOKEN_LessEqual:
+            case TOKEN_Greater:
+            case TOKEN_GreaterEqual:
+                return (nullptr != dynamic_cast<ComparisonNodeCP>(&node)) ? node.GetOperation() : TOKEN_None;
+            case TOKEN_Plus:
+            case TOKEN_Minus:
+                return (nullptr != dynamic_cast<PlusMinusNodeCP>(&node)) ? node.GetOperation() : TOKEN_None;
+            }
+        return TOKEN_None;
+        }
+
+    /*---------------------------------------------------------------------------------**//**
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    bool TryEvaluateConstant(ECValueR value, NodeR node)
+        {
+        if (!IsFoldable(node))
+            return false;
+
+        if (m_foldingContext.IsNull())
+            m_foldingContext = SymbolExpressionContext::Create(nullptr);
+
+        // constant subexpressions which fail to evaluate are left for the runtime to report
+        EvaluationResult result;
+        if (ExpressionStatus::Success != node.GetValue(result, *m_foldingContext) || !result.IsECValue())
+            return false;
+
+        value = *result.GetECValue();
+        return true;
+        }
+
+    /*---------------------------------------------------------------------------------**//**
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    void CompileShortCircuit(NodeR node)
+        {
+        ExpressionToken op = node.GetOperation();
+        uint32_t guardAddress = 0;
+        if (TOKEN_OrElse == op)
+            {
+            // errors in the lefthand expression of OrElse evaluate it to false instead of failing the expression
+            guardAddress = Emit(Instruction(OpCode::BeginOrElse));
+            if (++m_guardDepth > m_expression.m_maxGuardDepth)
+                m_expression.m_maxGuardDepth = m_guardDepth;
+            }
+
+        Compile(*node.GetLeftP());
+
+        if (TOKEN_OrElse == op)
+            {
+            Patch(guardAddress);
+            m_guardDepth--;
+            }
+
+        uint32_t shortCircuitAddress = Emit(Instruction(OpCode::ShortCircuit, op));
+        Compile(*node.GetRightP());
+        Emit(Instruction(OpCode::Combine, op));
+        Pop();
+        Patch(shortCircuitAddress);
+        }
+
+    /*---------------------------------------------------------------------------------**//**
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    void CompileIIf(IIfNodeR node)
+        {
+        Compile(*node.GetConditionP());
+        uint32_t jumpToFalseAddress = Emit(Instruction(OpCode::JumpIfFalse));
+        Pop();
+
+        Compile(*node.GetTrueP());
+        uint32_t jumpToEndAddress = Emit(Instruction(OpCode::Jump));
+        Pop();
+
+        Patch(jumpToFalseAddress);
+        Compile(*node.GetFalseP());
+        Patch(jumpToEndAddress);
+        }
+
+    /*---------------------------------------------------------------------------------**//**
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    void CompileOperator(NodeR node)
+        {
+        ECValue constantValue;
+        if (nullptr != dynamic_cast<ComparisonNodeCP>(&node) && TOKEN_Like != node.GetOperation()
+            && TryEvaluateConstant(constantValue, *node.GetRightP()))
+            {
+            Compile(*node.GetLeftP());
+            Emit(Instruction(OpCode::CompareConstant, GetSpecializedOperator(node), AddConstant(constantValue), &node));
+            return;
+            }
+
+        Compile(*node.GetLeftP());
+        Compile(*node.GetRightP());
+        Emit(Instruction(OpCode::Binary, GetSpecializedOperator(node), 0, &node));
+        Pop();
+        }
+
+    /*---------------------------------------------------------------------------------**//**
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    void Compile(NodeR node)
+        {
+        ECValue constantValue;
+        if (TryEvaluateConstant(constantValue, node))
+            {
+            Emit(Instruction(OpCode::PushConstant, TOKEN_None, AddConstant(constantValue)));
+            Push();
+            return;
+            }
+
+        if (nullptr != dynamic_cast<UnaryArithmeticNodeCP>(&node))
+            {
+            Compile(*node.GetLeftP());
+            if (TOKEN_Plus != node.GetOperation())
+                Emit(Instruction(OpCode::Unary, node.GetOperation()));
+            return;
+            }
+
+        if (IsShortCircuit(node))
+            {
+            CompileShortCircuit(node);
+            return;
+            }
+
+        if (IsOperator(node))
+            {
+            CompileOperator(node);
+            return;
+            }
+
+        IIfNodeP iif = dynamic_cast<IIfNodeP>(&node);
+        if (nullptr != iif)
+            {
+            CompileIIf(*iif);
+            return;
+            }
+
+        // symbol access, method calls, lambdas and assignments are evaluated by the node itself
+        m_expression.m_slots.push_back(&node);
+        Emit(Instruction(OpCode::LoadSlot, TOKEN_None, (uint32_t)m_expression.m_slots.size() - 1));
+        Push();
+        }
+
+public:
+    Compiler(CompiledExpression& expression) : m_expression(expression), m_stackDepth(0), m_guardDepth(0) {}
+
+    /*---------------------------------------------------------------------------------**//**
+    * @bsimethod
+    +---------------+---------------+---------------+---------------+---------------+------*/
+    void Run()
+        {
+        Compile(*m_expression.m_root);
+        BeAssert(1 == m_stackDepth && 0 == m_guardDepth);
+        }
+};
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+CompiledExpressionPtr CompiledExpression::Create(NodeR root)
+    {
+    CompiledExpressionPtr expression = new CompiledExpression(root);
+    Compiler(*expression).Run();
+    ECEXPRESSIONS_EVALUATE_LOG(NativeLogging::LOG_TRACE, Utf8PrintfString("CompiledExpression::Create: %s => %" PRIu64 " instructions, %" PRIu64 " slots",
+        root.ToExpressionString().c_str(), (uint64_t)expression->m_instructions.size(), (uint64_t)expression->m_slots.size()).c_str());
+    return expression;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Compares two same-typed non-null primitive values the same way ComparisonNode does and
+* stores the result in the lefthand value. Returns false if the operands need promotion.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool performSpecializedCompare(ECValueR left, ExpressionToken op, ECValueCR right)
+    {
+    if (!left.IsPrimitive() || !right.IsPrimitive() || left.IsNull() || right.IsNull() || left.GetPrimitiveType() != right.GetPrimitiveType())
+        return false;
+
+    bool result;
+    switch (left.GetPrimitiveType())
+        {
+        case PRIMITIVETYPE_String:      result = PerformCompare(strcmp(left.GetUtf8CP(), right.GetUtf8CP()), op, 0); break;
+        case PRIMITIVETYPE_Boolean:     result = PerformCompare(left.GetBoolean(), op, right.GetBoolean()); break;
+        case PRIMITIVETYPE_Double:      result = PerformCompare(left.GetDouble(), op, right.GetDouble()); break;
+        case PRIMITIVETYPE_Integer:     result = PerformCompare(left.GetInteger(), op, right.GetInteger()); break;
+        case PRIMITIVETYPE_Long:        result = PerformCompare(left.GetLong(), op, right.GetLong()); break;
+        case PRIMITIVETYPE_DateTime:    result = PerformCompare(left.GetDateTimeTicks(), op, right.GetDateTimeTicks()); break;
+        default:                        return false;
+        }
+
+    left.SetBoolean(result);
+    return true;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Adds or subtracts two same-typed non-null numeric values the same way PlusMinusNode does and
+* stores the result in the lefthand value. Returns false if the operands need promotion.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool performSpecializedPlusMinus(ECValueR left, ExpressionToken op, ECValueCR right)
+    {
+    if (!left.IsPrimitive() || !right.IsPrimitive() || left.IsNull() || right.IsNull() || left.GetPrimitiveType() != right.GetPrimitiveType())
+        return false;
+
+    bool isPlus = (TOKEN_Plus == op);
+    switch (left.GetPrimitiveType())
+        {
+        case PRIMITIVETYPE_Integer: left.SetInteger(isPlus ? left.GetInteger() + right.GetInteger() : left.GetInteger() - right.GetInteger()); return true;
+        case PRIMITIVETYPE_Long:    left.SetLong(isPlus ? left.GetLong() + right.GetLong() : left.GetLong() - right.GetLong()); return true;
+        case PRIMITIVETYPE_Double:  left.SetDouble(isPlus ? left.GetDouble() + right.GetDouble() : left.GetDouble() - right.GetDouble()); return true;
+        }
+    return false;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool performSpecializedOperator(EvaluationResultR left, ExpressionToken op, ECValueCR right)
+    {
+    if (TOKEN_None == op || !left.IsECValue())
+        return false;
+
+    if (TOKEN_Plus == op || TOKEN_Minus == op)
+        return performSpecializedPlusMinus(*left.GetECValue(), op, right);
+
+    return performSpecializedCompare(*left.GetECValue(), op, right);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static ExpressionStatus performUnary(EvaluationResultR value, ExpressionToken op)
+    {
+    ECValueP ecValue = value.IsECValue() ? value.GetECValue() : nullptr;
+    if (nullptr != ecValue && ecValue->IsPrimitive() && !ecValue->IsNull())
+        {
+        switch (ecValue->GetPrimitiveType())
+            {
+            case PRIMITIVETYPE_Boolean:
+                if (TOKEN_Minus != op)
+                    {
+                    ecValue->SetBoolean(!ecValue->GetBoolean());
+                    return ExpressionStatus::Success;
+                    }
+                break;
+            case PRIMITIVETYPE_Integer:
+                ecValue->SetInteger(TOKEN_Minus == op ? -ecValue->GetInteger() : ~ecValue->GetInteger());
+                return ExpressionStatus::Success;
+            case PRIMITIVETYPE_Double:
+                if (TOKEN_Minus == op)
+                    {
+                    ecValue->SetDouble(-ecValue->GetDouble());
+                    return ExpressionStatus::Success;
+                    }
+                break;
+            }
+        }
+
+    EvaluationResult result;
+    ExpressionStatus status = (TOKEN_Minus == op) ? Operations::PerformUnaryMinus(result, value) : Operations::PerformUnaryNot(result, value);
+    if (ExpressionStatus::Success == status)
+        value = result;
+    return status;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static ExpressionStatus applyOperator(EvaluationResultR left, EvaluationResultR right, NodeR node, ExpressionContextR context)
+    {
+    EvaluationResult result;
+    ExpressionStatus status = static_cast<BinaryNodeR>(node).ApplyOperator(result, left, right, context);
+    if (ExpressionStatus::Success == status)
+        left = result;
+    return status;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus CompiledExpression::Execute(EvaluationResult** stack, uint32_t* guards, ExpressionContextR context) const
+    {
+    Instruction const* instructions = m_instructions.data();
+    uint32_t instructionsCount = (uint32_t)m_instructions.size();
+    uint32_t pc = 0;
+    uint32_t sp = 0;
+    uint32_t guardsCount = 0;
+    bool orElseLeftFailed = false;
+
+    while (pc < instructionsCount)
+        {
+        Instruction const& instruction = instructions[pc++];
+        ExpressionStatus status = ExpressionStatus::Success;
+        switch (instruction.m_opCode)
+            {
+            case OpCode::PushConstant:
+                *stack[sp++] = m_constants[instruction.m_operand];
+                break;
+
+            case OpCode::LoadSlot:
+                stack[sp]->Clear();
+                status = m_slots[instruction.m_operand]->GetValue(*stack[sp++], context);
+                break;
+
+            case OpCode::Unary:
+                status = performUnary(*stack[sp - 1], instruction.m_operator);
+                break;
+
+            case OpCode::Binary:
+                --sp;
+                if (!stack[sp]->IsECValue() || !performSpecializedOperator(*stack[sp - 1], instruction.m_operator, *stack[sp]->GetECValue()))
+                    status = applyOperator(*stack[sp - 1], *stack[sp], *instruction.m_node, context);
+                break;
+
+            case OpCode::CompareConstant:
+                if (!performSpecializedOperator(*stack[sp - 1], instruction.m_operator, m_constants[instruction.m_operand]))
+                    {
+                    EvaluationResult right;
+                    right = m_constants[instruction.m_operand];
+                    status = applyOperator(*stack[sp - 1], right, *instruction.m_node, context);
+                    }
+                break;
+
+            case OpCode::Jump:
+                pc = instruction.m_operand;
+                break;
+
+            case OpCode::JumpIfFalse:
+                {
+                bool condition = false;
+                status = stack[--sp]->GetBoolean(condition, false);
+                if (ExpressionStatus::Success == status && !condition)
+                    pc = instruction.m_operand;
+                break;
+                }
+
+            case OpCode::BeginOrElse:
+                guards[2 * guardsCount] = sp;
+                guards[2 * guardsCount + 1] = instruction.m_operand;
+                guardsCount++;
+                break;
+
+            case OpCode::ShortCircuit:
+                {
+                bool isAndAlso = (TOKEN_AndAlso == instruction.m_operator);
+                bool leftValue = false;
+                if (orElseLeftFailed)
+                    {
+                    // the guard has already been removed when the lefthand expression failed
+                    orElseLeftFailed = false;
+                    }
+                else
+                    {
+                    if (!isAndAlso)
+                        guardsCount--;
+
+                    // AndAlso fails if the lefthand value is not a boolean, OrElse treats it as false
+                    status = stack[sp - 1]->GetBoolean(leftValue, false);
+                    if (ExpressionStatus::Success != status)
+                        {
+                        if (isAndAlso)
+                            break;
+                        leftValue = false;
+                        status = ExpressionStatus::Success;
+                        }
+                    }
+
+                stack[sp - 1]->InitECValue().SetBoolean(leftValue);
+                if (leftValue != isAndAlso)
+                    pc = instruction.m_operand;
+                break;
+                }
+
+            case OpCode::Combine:
+                {
+                // the lefthand value didn't decide the result, so the result is the righthand value
+                bool rightValue;
+                --sp;
+                status = stack[sp]->GetBoolean(rightValue, false);
+                if (ExpressionStatus::Success == status)
+                    *stack[sp - 1] = *stack[sp]->GetECValue();
+                break;
+                }
+            }
+
+        if (ExpressionStatus::Success == status)
+            continue;
+
+        if (0 == guardsCount)
+            return status;
+
+        // the lefthand expression of the innermost OrElse failed - continue as if it evaluated to false
+        guardsCount--;
+        sp = guards[2 * guardsCount] + 1;
+        pc = guards[2 * guardsCount + 1];
+        orElseLeftFailed = true;
+        }
+
+    BeAssert(1 == sp && 0 == guardsCount);
+    return ExpressionStatus::Success;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ExpressionStatus CompiledExpression::GetValue(EvaluationResult& evalResult, ExpressionContextR context) const
+    {
+    // the bottom of the stack is the result, the rest lives on the call stack unless the expression is unusually deep
+    EvaluationResult inlineValues[COMPILED_EXPRESSION_INLINE_STACK_SIZE - 1];
+    EvaluationResult* inlineStack[COMPILED_EXPRESSION_INLINE_STACK_SIZE];
+    uint32_t inlineGuards[2 * COMPILED_EXPRESSION_INLINE_GUARDS_COUNT];
+    bvector<EvaluationResult> values;
+    bvector<EvaluationResult*> stack;
+    bvector<uint32_t> guards;
+
+    EvaluationResult** stackP = inlineStack;
+    EvaluationResult* valuesP = inlineValues;
+    if (m_maxStackDepth > COMPILED_EXPRESSION_INLINE_STACK_SIZE)
+        {
+        values.resize(m_maxStackDepth - 1);
+        stack.resize(m_maxStackDepth);
+        stackP = stack.data();
+        valuesP = values.data();
+        }
+    stackP[0] = &evalResult;
+    for (uint32_t i = 1; i < m_maxStackDepth; ++i)
+        stackP[i] = &valuesP[i - 1];
+
+    uint32_t* guardsP = inlineGuards;
+    if (m_maxGuardDepth > COMPILED_EXPRESSION_INLINE_GUARDS_COUNT)
+        {
+        guards.resize(2 * m_maxGuardDepth);
+        guardsP = guards.data();
+        }
+
+    return Execute(stackP, guardsP, context);
+    }
+
 END_BENTLEY_ECOBJECT_NAMESPACE
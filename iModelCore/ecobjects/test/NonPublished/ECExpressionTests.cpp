@@ -193,6 +193,119 @@ TEST_F(ExpressionTests, LambdaValue_EvaluatesValueListOfContexts)
     EXPECT_EQ(ECValue(456), *agg.m_evaluatedValues[1].GetECValue());
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsistruct
++---------------+---------------+---------------+---------------+---------------+------*/
+struct CompiledExpressionTests : ExpressionTests
+    {
+    SymbolExpressionContextPtr m_context;
+
+    void SetUp() override
+        {
+        ExpressionTests::SetUp();
+        m_context = SymbolExpressionContext::Create(nullptr);
+        m_context->AddSymbol(*ValueSymbol::Create("i", ECValue(5)));
+        m_context->AddSymbol(*ValueSymbol::Create("d", ECValue(1.5)));
+        m_context->AddSymbol(*ValueSymbol::Create("s", ECValue("abc")));
+        m_context->AddSymbol(*ValueSymbol::Create("b", ECValue(true)));
+        m_context->AddSymbol(*ValueSymbol::Create("n", ECValue()));
+        }
+
+    CompiledExpressionPtr Compile(Utf8CP expr)
+        {
+        NodePtr tree = ECEvaluator::ParseValueExpressionAndCreateTree(expr);
+        EXPECT_NOT_NULL(tree.get());
+        return CompiledExpression::Create(*tree);
+        }
+
+    void ExpectSameResultAsTree(Utf8CP expr)
+        {
+        NodePtr tree = ECEvaluator::ParseValueExpressionAndCreateTree(expr);
+        ASSERT_TRUE(tree.IsValid()) << expr;
+
+        EvaluationResult treeResult;
+        ExpressionStatus treeStatus = tree->GetValue(treeResult, *m_context);
+
+        EvaluationResult compiledResult;
+        ExpressionStatus compiledStatus = CompiledExpression::Create(*tree)->GetValue(compiledResult, *m_context);
+
+        EXPECT_EQ((int)treeStatus, (int)compiledStatus) << expr;
+        if (ExpressionStatus::Success != treeStatus || ExpressionStatus::Success != compiledStatus)
+            return;
+
+        ASSERT_TRUE(treeResult.IsECValue()) << expr;
+        ASSERT_TRUE(compiledResult.IsECValue()) << expr;
+        EXPECT_TRUE(treeResult.GetECValue()->Equals(*compiledResult.GetECValue()))
+            << "Expected: " << treeResult.ToString().c_str() << " Actual: " << compiledResult.ToString().c_str() << " Expr: " << expr;
+        }
+    };
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(CompiledExpressionTests, EvaluatesSameAsExpressionTree)
+    {
+    Utf8CP expressions[] =
+        {
+        "i + 2", "i - 7 * 2", "d + 1", "i + \"3\"", "s + \"def\"", "s & i", "i \\ 2", "i Mod 2", "i ^ 2", "i << 1",
+        "-i", "-d", "Not b", "Not i", "-s",
+        "i = 5", "i <> 5", "i < 6", "d >= 1.5", "d = i", "s = \"abc\"", "s > \"abd\"", "\"abc\" = s", "n = Null", "n <> i", "b = True", "s Like \"a%\"",
+        "b And i", "b Or False", "i Xor 3",
+        "b AndAlso i > 3", "b AndAlso i", "i < 3 AndAlso Missing", "Missing AndAlso b", "s AndAlso b",
+        "b OrElse Missing", "Missing OrElse b", "Missing OrElse Missing", "s OrElse i > 3", "(Missing AndAlso b) OrElse (i = 5 AndAlso s = \"abc\")",
+        "IIf(i > 3, s, d)", "IIf(n, 1, 2)", "IIf(Missing, 1, 2)", "IIf(b, IIf(i < 3, 1, 2), 3) + 10",
+        "1 + 2 * 3", "\"a\" & \"b\" = \"ab\"", "1 / 0", "Missing + 1",
+        };
+    for (Utf8CP expr : expressions)
+        ExpectSameResultAsTree(expr);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(CompiledExpressionTests, FoldsConstantSubexpressions)
+    {
+    CompiledExpressionPtr expression = Compile("(1 + 2) * 3 = 9");
+    EXPECT_EQ(1, expression->GetInstructionsCount());
+    EXPECT_EQ(1, expression->GetConstantsCount());
+    EXPECT_EQ(0, expression->GetSlotsCount());
+
+    EvaluationResult result;
+    EXPECT_SUCCESS(expression->GetValue(result, *m_context));
+    EXPECT_EQ(ECValue(true), *result.GetECValue());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(CompiledExpressionTests, EvaluatesSymbolsInSlotsAgainstGivenContext)
+    {
+    CompiledExpressionPtr expression = Compile("i * 2 = 10 AndAlso s = \"abc\"");
+    EXPECT_EQ(2, expression->GetSlotsCount());
+
+    EvaluationResult result;
+    EXPECT_SUCCESS(expression->GetValue(result, *m_context));
+    EXPECT_EQ(ECValue(true), *result.GetECValue());
+
+    SymbolExpressionContextPtr otherContext = SymbolExpressionContext::Create(nullptr);
+    otherContext->AddSymbol(*ValueSymbol::Create("i", ECValue(5)));
+    otherContext->AddSymbol(*ValueSymbol::Create("s", ECValue("xyz")));
+    EXPECT_SUCCESS(expression->GetValue(result, *otherContext));
+    EXPECT_EQ(ECValue(false), *result.GetECValue());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(CompiledExpressionTests, EvaluatesExpressionsDeeperThanInlineStack)
+    {
+    CompiledExpressionPtr expression = Compile("i + (i + (i + (i + (i + (i + i)))))");
+
+    EvaluationResult result;
+    EXPECT_SUCCESS(expression->GetValue(result, *m_context));
+    EXPECT_EQ(ECValue(35), *result.GetECValue());
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
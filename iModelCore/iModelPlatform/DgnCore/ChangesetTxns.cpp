@@ -7,6 +7,7 @@
 #include <DgnPlatform/DgnChangeSummary.h>
 #include <ECDb/ChangeIterator.h>
 #include <folly/ProducerConsumerQueue.h>
+#include <future>
 #include <thread>
 
 USING_NAMESPACE_BENTLEY_SQLITE
@@ -223,6 +224,65 @@ public:
     }
 };
 
+//=======================================================================================
+// The id and schema changes of a changeset file, read by streaming the file once through a fixed-size buffer.
+// Verified on a background thread by TxnManager::MergeChangesets while the previous changeset is applied,
+// so it must not touch the DgnDb.
+// @bsiclass
+//=======================================================================================
+struct VerifiedChangeset {
+    ChangesetPropsCR m_props;
+    DgnDbR m_dgndb;
+    DbResult m_result = BE_SQLITE_OK;
+    Utf8String m_id;
+    bool m_containsSchemaChanges = false;
+    DdlChanges m_ddlChanges;
+    double m_elapsed = 0;
+
+    VerifiedChangeset(ChangesetPropsCR props, DgnDbR dgndb) : m_props(props), m_dgndb(dgndb) {}
+
+    //---------------------------------------------------------------------------------------
+    // Compute the id the same way as ChangesetIdGenerator::GenerateId, and read the schema changes.
+    // @bsimethod
+    //---------------------------------------------------------------------------------------
+    void Verify() {
+        StopWatch timer(true);
+        if (!m_props.GetFileName().DoesPathExist()) {
+            m_result = BE_SQLITE_CANTOPEN;
+            return;
+        }
+
+        ChangesetFileReader file(m_props.GetFileName(), m_dgndb);
+        auto reader = file.MakeReader();
+        m_result = reader->GetSchemaChanges(m_containsSchemaChanges, m_ddlChanges);
+        if (BE_SQLITE_OK != m_result)
+            return;
+
+        ChangesetIdGenerator idGen;
+        idGen.AddStringToHash(m_props.GetParentId());
+        Utf8StringCR prefix = reader->GetPrefix(m_result);
+        if (BE_SQLITE_OK != m_result)
+            return;
+
+        if (!prefix.empty())
+            idGen._Append((Byte const*)prefix.c_str(), (int)prefix.SizeInBytes());
+
+        Byte buffer[64 * 1024];
+        int nRead;
+        do {
+            nRead = (int)sizeof(buffer);
+            m_result = reader->_Read(buffer, &nRead);
+            if (BE_SQLITE_OK != m_result)
+                return;
+
+            idGen._Append(buffer, nRead);
+        } while (nRead > 0);
+
+        m_id = idGen.m_hash.GetHashString();
+        m_elapsed = timer.GetCurrentSeconds();
+    }
+};
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -434,8 +494,8 @@ struct ChangeStreamQueueConsumer : ChangeStream {
  *
  * into a file about to become a changeset file.
  */
-void TxnManager::WriteChangesToFile(BeFileNameCR pathname, DdlChangesCR ddlChanges, ChangeGroupCR dataChangeGroup, Rebaser* rebaser) {
-    ChangesetFileWriter writer(pathname, dataChangeGroup.ContainsEcSchemaChanges(), ddlChanges, m_dgndb);
+void TxnManager::WriteChangesToFile(BeFileNameCR pathname, DdlChangesCR ddlChanges, ChangeGroupCR dataChangeGroup, Rebaser* rebaser, ChangesetFileFormat format) {
+    ChangesetFileWriter writer(pathname, dataChangeGroup.ContainsEcSchemaChanges(), ddlChanges, m_dgndb, LzmaEncoder::LzmaParams(), format);
 
     if (BE_SQLITE_OK !=  writer.Initialize())
         m_dgndb.ThrowException("unable to initialize change writer", (int) ChangesetStatus::FileWriteError);
@@ -475,7 +535,7 @@ void TxnManager::WriteChangesToFile(BeFileNameCR pathname, DdlChangesCR ddlChang
  * takes a "extension" argument that is appended to the filename before ".changeset" is added. That's so tests
  * can save more than one changeset while they work (without mocking iModelHub.)
  */
-ChangesetPropsPtr TxnManager::StartCreateChangeset(Utf8CP extension) {
+ChangesetPropsPtr TxnManager::StartCreateChangeset(Utf8CP extension, ChangesetFileFormat format) {
     if (m_changesetInProgress.IsValid())
         m_dgndb.ThrowException("a changeset is currently in progress", (int) ChangesetStatus::IsCreatingChangeset);
 
@@ -522,7 +582,7 @@ ChangesetPropsPtr TxnManager::StartCreateChangeset(Utf8CP extension) {
         m_dgndb.ThrowException("rebase failed", (int) ChangesetStatus::SQLiteError);
 
     BeFileName changesetFileName((m_dgndb.GetTempFileBaseName() + (extension ? extension : "") +  ".changeset").c_str());
-    WriteChangesToFile(changesetFileName, ddlChanges, dataChangeGroup, (lastRebaseId != 0) ? &rebaser : nullptr);
+    WriteChangesToFile(changesetFileName, ddlChanges, dataChangeGroup, (lastRebaseId != 0) ? &rebaser : nullptr, format);
 
     auto parentRevId = GetParentChangesetId();
     auto revId = ChangesetIdGenerator::GenerateId(parentRevId, changesetFileName, m_dgndb);
@@ -598,10 +658,86 @@ void TxnManager::StopCreateChangeset(bool keepFile) {
 //--------------------------------------------------------------------------------------
 // @bsimethod
 //--------------------------------------------------------------------------------------
-ChangesetStatus TxnManager::ProcessRevisions(bvector<ChangesetPropsCP> const &revisions, RevisionProcessOption processOptions) {
+ChangesetStatus TxnManager::MergeChangesets(bvector<ChangesetPropsCP> const& revisions, MergeTimings* timings) {
+    MergeTimings localTimings;
+    MergeTimings& times = (nullptr != timings) ? *timings : localTimings;
+    times = MergeTimings();
+    if (revisions.empty())
+        return ChangesetStatus::Success;
+
+    auto verify = [this](ChangesetPropsCR revision) {
+        return std::async(std::launch::async, [this, &revision]() {
+            auto verified = std::make_unique<VerifiedChangeset>(revision, m_dgndb);
+            verified->Verify();
+            return verified;
+        });
+    };
+
+    auto next = verify(*revisions.front());
+    for (size_t i = 0; i < revisions.size(); ++i) {
+        ChangesetPropsCR revision = *revisions[i];
+        StopWatch timer(true);
+        std::unique_ptr<VerifiedChangeset> current = next.get();
+        times.m_wait += timer.GetCurrentSeconds();
+        times.m_prepare += current->m_elapsed;
+
+        if (i + 1 < revisions.size())
+            next = verify(*revisions[i + 1]);
+
+        CheckCanMerge(revision);
+
+        if (revision.GetDbGuid() != m_dgndb.GetDbGuid().ToString())
+            m_dgndb.ThrowException("changeset did not originate from this iModel", (int) ChangesetStatus::WrongDgnDb);
+
+        if (BE_SQLITE_CANTOPEN == current->m_result)
+            m_dgndb.ThrowException("changeset file does not exist", (int) ChangesetStatus::FileNotFound);
+
+        if (BE_SQLITE_OK != current->m_result)
+            m_dgndb.ThrowException(current->m_result == BE_SQLITE_ERROR_InvalidChangeSetVersion ? "invalid changeset version" : "corrupted changeset", current->m_result);
+
+        if (current->m_id != revision.GetChangesetId())
+            m_dgndb.ThrowException("incorrect id for changeset", (int) ChangesetStatus::CorruptedChangeStream);
+
+        if (GetParentChangesetId() != revision.GetParentId())
+            m_dgndb.ThrowException("changeset out of order", (int) ChangesetStatus::ParentMismatch);
+
+        // Note: Schema changes may not necessary imply ddl changes. They could just be 'minor' ecschema/mapping changes.
+        if (!current->m_ddlChanges._IsEmpty()) {
+            timer.Start();
+            DbResult result = ApplyDdlChanges(current->m_ddlChanges);
+            times.m_schema += timer.GetCurrentSeconds();
+            if (BE_SQLITE_OK != result)
+                return ChangesetStatus::ApplyError;
+        }
+
+        // The data changes are streamed from the file again rather than held in memory from the verify pass.
+        timer.Start();
+        ChangesetFileReader changeStream(revision.GetFileName(), m_dgndb);
+        ChangesetStatus status = MergeDataChanges(revision, changeStream, current->m_containsSchemaChanges);
+        times.m_apply += timer.GetCurrentSeconds();
+        if (ChangesetStatus::Success != status)
+            return status;
+
+        ++times.m_changesets;
+    }
+
+    LOG.infov("Merged %u changesets: prepare %.3fs (background), wait %.3fs, schema %.3fs, apply %.3fs", times.m_changesets, times.m_prepare, times.m_wait, times.m_schema, times.m_apply);
+    return ChangesetStatus::Success;
+}
+
+//--------------------------------------------------------------------------------------
+// @bsimethod
+//--------------------------------------------------------------------------------------
+ChangesetStatus TxnManager::ProcessRevisions(bvector<ChangesetPropsCP> const &revisions, RevisionProcessOption processOptions, bool pipelineMerge) {
     ChangesetStatus status;
     switch (processOptions) {
     case RevisionProcessOption::Merge:
+        if (pipelineMerge) {
+            status = MergeChangesets(revisions);
+            if (ChangesetStatus::Success != status)
+                return status;
+            break;
+        }
         for (ChangesetPropsCP revision : revisions) {
             status = MergeChangeset(*revision);
             if (ChangesetStatus::Success != status)
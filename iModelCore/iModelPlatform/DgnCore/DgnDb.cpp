@@ -160,11 +160,21 @@ DgnDb::~DgnDb() {
 +---------------+---------------+---------------+---------------+---------------+------*/
 void DgnDb::_OnDbClose()
     {
+    m_models.SaveRangeIndexSnapshots();
     Domains().OnDbClose();
     Destroy();
     T_Super::_OnDbClose();
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void DgnDb::_OnBeforeCheckpoint()
+    {
+    m_models.SaveRangeIndexSnapshots();
+    T_Super::_OnBeforeCheckpoint();
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -182,7 +192,7 @@ DbResult DgnDb::_OnDbOpened(Db::OpenParams const& params)
         }
 
     m_geoLocation.Load();
-
+    m_models.DeleteStaleRangeIndexSnapshots();
 
     if (DisqualifyTypeIndexForBisCoreExternalSourceAspect() != BE_SQLITE_OK)
         return BE_SQLITE_ERROR;
@@ -300,7 +310,7 @@ DbResult DgnDb::ProcessRevisions(Db::OpenParams const& params)
     if (revisions.empty())
         return BE_SQLITE_OK;
 
-    ChangesetStatus status = Txns().ProcessRevisions(revisions, schemaUpgradeOptions.GetRevisionProcessOption());
+    ChangesetStatus status = Txns().ProcessRevisions(revisions, schemaUpgradeOptions.GetRevisionProcessOption(), schemaUpgradeOptions.GetPipelineMerge());
     return status == ChangesetStatus::Success ? BE_SQLITE_OK : BE_SQLITE_ERROR_SchemaUpgradeFailed;
     }
 
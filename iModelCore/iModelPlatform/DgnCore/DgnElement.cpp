@@ -1196,6 +1196,11 @@ DgnDbStatus DgnElement::_UpdateInDb()
 +---------------+---------------+---------------+---------------+---------------+------*/
 DgnDbStatus DgnElement::_LoadFromDb()
     {
+    // DgnElements::LoadElements may already have selected this element's row as part of a batch.
+    DgnElements::PrefetchedRow const* prefetched = GetDgnDb().Elements().m_prefetchedRow;
+    if (nullptr != prefetched && prefetched->m_id == GetElementId())
+        return _ReadSelectParams(prefetched->m_statement, prefetched->m_params);
+
     DgnElements::ElementSelectStatement select = GetDgnDb().Elements().GetPreparedSelectStatement(*this);
     if (select.m_statement.IsNull())
         return DgnDbStatus::Success;
@@ -7,83 +7,236 @@
 BEGIN_BENTLEY_DGN_NAMESPACE
 
 //=======================================================================================
-// Most Recently Used cache of DgnElements for a DgnDb. Holds the N most recently used
-// elements for a DgnDb. As a newer element is added, the least recently used one is dropped
-// if the cache holds more than the maximum size.
+// Cache of DgnElements for a DgnDb, bounded by the approximate memory used by the cached
+// elements and optionally by their number. Elements are spread over a fixed number of shards
+// by id, each with its own lock, so that lookups on different threads rarely contend. The
+// limits apply to the cache as a whole: the memory used and element count are kept in
+// atomics, and whichever thread pushes them over a limit evicts elements from the shards in
+// turn until they fit again. Within a shard, elements are evicted in CLOCK order: a lookup
+// marks an element as referenced, and the eviction hand gives each referenced element a
+// second chance before dropping it. Rotating over the shards approximates a single CLOCK over
+// the whole cache. There is no admission filter; every loaded element is cached. Dropped
+// elements are released only after the shard lock is released, since freeing an element may
+// need the DgnElements mutex.
 // @bsiclass
 //=======================================================================================
-struct ElementMRU
+struct ElementCache
 {
-    struct ElemEntry : NonCopyableClass
+    enum {SHARD_BITS = 3, SHARD_COUNT = 1 << SHARD_BITS};
+    static constexpr uint64_t DEFAULT_MEMORY_LIMIT = 64 * 1024 * 1024;
+
+    struct Slot
     {
-        uint64_t m_id;
         DgnElementCPtr m_el;
-        ElemEntry(uint64_t id, DgnElementCPtr el) : m_id(id), m_el(el) {}
+        uint32_t m_size = 0;
+        bool m_referenced = false;
     };
 
-    typedef std::list<ElemEntry> EntryList;
+    struct Shard
+    {
+        BeMutex m_mutex;
+        bvector<Slot> m_slots;
+        bvector<uint32_t> m_freeSlots;
+        std::unordered_map<uint64_t, uint32_t> m_map;
+        uint32_t m_hand = 0;
+        uint64_t m_memoryUsed = 0;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_evictions = 0;
+
+        // returns the size of the removed element.
+        uint32_t Remove(uint32_t index, bvector<DgnElementCPtr>& dropped)
+            {
+            Slot& slot = m_slots[index];
+            uint32_t size = slot.m_size;
+            m_map.erase(slot.m_el->GetElementId().GetValue());
+            m_memoryUsed -= size;
+            dropped.push_back(std::move(slot.m_el));
+            slot = Slot();
+            m_freeSlots.push_back(index);
+            return size;
+            }
 
-    EntryList m_list;
-    std::unordered_map<uint64_t, EntryList::iterator> m_map;
-    uint32_t m_maxSize;
+        // advance the CLOCK hand until an unreferenced element is found and evict it. Returns false if the shard is empty.
+        bool EvictOne(uint32_t& size, bvector<DgnElementCPtr>& dropped)
+            {
+            while (!m_map.empty())
+                {
+                if (m_hand >= m_slots.size())
+                    m_hand = 0;
+
+                Slot& slot = m_slots[m_hand++];
+                if (!slot.m_el.IsValid())
+                    continue;
+
+                if (slot.m_referenced)
+                    {
+                    slot.m_referenced = false;
+                    continue;
+                    }
+
+                size = Remove(m_hand - 1, dropped);
+                ++m_evictions;
+                return true;
+                }
+            return false;
+            }
+    };
 
-    explicit ElementMRU(uint32_t size = 2000) : m_maxSize(size) {}
-    void SetMaxSize(uint32_t newSize) { m_maxSize = newSize; Purge(); }
-    void Clear() {m_map.clear(); m_list.clear();}
-    void MoveToFront(EntryList::iterator it) {m_list.splice(m_list.begin(), m_list, it);}
+    Shard m_shards[SHARD_COUNT];
+    std::atomic<uint64_t> m_memoryLimit {DEFAULT_MEMORY_LIMIT};
+    std::atomic<uint32_t> m_maxCount {0xffffffff};
+    std::atomic<uint64_t> m_memoryUsed {0};
+    std::atomic<uint32_t> m_count {0};
+    std::atomic<uint32_t> m_victimShard {0};
 
-    // add an element to the front of the MRU cache.
-    void AddElement(DgnElementCR el)
+    static uint32_t GetShardIndex(uint64_t id) {return (uint32_t) ((id * 0x9E3779B97F4A7C15ull) >> (64 - SHARD_BITS));}
+    Shard& GetShard(uint64_t id) {return m_shards[GetShardIndex(id)];}
+
+    bool IsOverLimit() const {return m_memoryUsed.load() > m_memoryLimit.load() || m_count.load() > m_maxCount.load();}
+
+    void OnRemoved(uint32_t size) {m_memoryUsed -= size; --m_count;}
+
+    // evict elements from the shards in turn until the cache is within its limits. Must be called without holding any shard lock.
+    void Purge()
         {
-        if (0 == m_maxSize)
-            return;
+        uint32_t emptyShards = 0;
+        while (IsOverLimit() && emptyShards < SHARD_COUNT)
+            {
+            Shard& shard = m_shards[m_victimShard++ % SHARD_COUNT];
+            bvector<DgnElementCPtr> dropped;
+            BeMutexHolder lock(shard.m_mutex);
+            uint32_t size;
+            if (shard.EvictOne(size, dropped))
+                {
+                OnRemoved(size);
+                emptyShards = 0;
+                }
+            else
+                {
+                ++emptyShards;
+                }
+            }
+        }
+
+    void SetMaxCount(uint32_t maxCount) {m_maxCount = maxCount; Purge();}
+    void SetMemoryLimit(uint64_t limit) {m_memoryLimit = limit; Purge();}
+
+    void Clear()
+        {
+        for (auto& shard : m_shards)
+            {
+            bvector<DgnElementCPtr> dropped;
+            BeMutexHolder lock(shard.m_mutex);
+            for (uint32_t i = 0; i < shard.m_slots.size(); ++i)
+                {
+                if (shard.m_slots[i].m_el.IsValid())
+                    OnRemoved(shard.Remove(i, dropped));
+                }
+            shard.m_slots.clear();
+            shard.m_freeSlots.clear();
+            shard.m_hand = 0;
+            }
+        }
 
+    // add an element to the cache. Elements that are larger than the whole memory limit are not cached.
+    void AddElement(DgnElementCR el)
+        {
         uint64_t id = el.GetElementId().GetValue();
-        auto iter = m_map.find(id);
-        if (iter != m_map.end())
+        uint32_t size = el.GetMemorySize();
+        Shard& shard = GetShard(id);
             {
-            iter->second->m_el = &el;
-            MoveToFront(iter->second);
-            return;
+            bvector<DgnElementCPtr> dropped;
+            BeMutexHolder lock(shard.m_mutex);
+
+            auto iter = shard.m_map.find(id);
+            if (iter != shard.m_map.end())
+                OnRemoved(shard.Remove(iter->second, dropped));
+
+            if (0 == m_maxCount.load() || size > m_memoryLimit.load())
+                return;
+
+            uint32_t index;
+            if (shard.m_freeSlots.empty())
+                {
+                index = (uint32_t) shard.m_slots.size();
+                shard.m_slots.push_back(Slot());
+                }
+            else
+                {
+                index = shard.m_freeSlots.back();
+                shard.m_freeSlots.pop_back();
+                }
+
+            Slot& slot = shard.m_slots[index];
+            slot.m_el = &el;
+            slot.m_size = size;
+            slot.m_referenced = false;
+            shard.m_map[id] = index;
+            shard.m_memoryUsed += size;
+            m_memoryUsed += size;
+            ++m_count;
             }
 
-        m_list.emplace_front(id, &el);
-        m_map[id] = m_list.begin();
         Purge();
         }
 
-    // look for the element in the MRU cache. If found, move it to most recent
-    DgnElementCP FindElement(DgnElementId eid)
+    // look for the element in the cache. If found, mark it as recently referenced.
+    DgnElementCPtr FindElement(DgnElementId eid)
         {
         auto id = eid.GetValue();
-        auto iter = m_map.find(id);
-        if (iter == m_map.end())
+        Shard& shard = GetShard(id);
+        BeMutexHolder lock(shard.m_mutex);
+        auto iter = shard.m_map.find(id);
+        if (iter == shard.m_map.end())
+            {
+            ++shard.m_misses;
             return nullptr;
+            }
 
-        MoveToFront(iter->second);
-        return iter->second->m_el.get();
+        ++shard.m_hits;
+        Slot& slot = shard.m_slots[iter->second];
+        slot.m_referenced = true;
+        return slot.m_el;
         }
 
-    // drop an element from MRU cache.
+    // drop an element from the cache.
     bool DropElement(DgnElementId eid)
         {
         auto id = eid.GetValue();
-        auto iter = m_map.find(id);
-        if (iter == m_map.end())
+        Shard& shard = GetShard(id);
+        bvector<DgnElementCPtr> dropped;
+        BeMutexHolder lock(shard.m_mutex);
+        auto iter = shard.m_map.find(id);
+        if (iter == shard.m_map.end())
             return false;
 
-        m_list.erase(iter->second);
-        m_map.erase(iter);
+        OnRemoved(shard.Remove(iter->second, dropped));
         return true;
         }
 
-    // purge MRU cache until it is less than the maximum size.
-    void Purge()
+    DgnElements::CacheStats GetStats()
+        {
+        DgnElements::CacheStats stats;
+        stats.m_memoryLimit = m_memoryLimit;
+        for (auto& shard : m_shards)
+            {
+            BeMutexHolder lock(shard.m_mutex);
+            stats.m_hits += shard.m_hits;
+            stats.m_misses += shard.m_misses;
+            stats.m_evictions += shard.m_evictions;
+            stats.m_memoryUsed += shard.m_memoryUsed;
+            stats.m_elementCount += (uint32_t) shard.m_map.size();
+            }
+        return stats;
+        }
+
+    void ResetStats()
         {
-        while (m_map.size() > m_maxSize)
+        for (auto& shard : m_shards)
             {
-            m_map.erase(m_list.back().m_id);
-            m_list.pop_back();
+            BeMutexHolder lock(shard.m_mutex);
+            shard.m_hits = shard.m_misses = shard.m_evictions = 0;
             }
         }
 };
@@ -112,8 +265,15 @@ void DgnElements::Destroy()
 +---------------+---------------+---------------+---------------+---------------+------*/
 void DgnElements::SetCacheSize(uint32_t newSize)
     {
-    BeMutexHolder _v_v(m_mutex);
-    m_mruCache->SetMaxSize(newSize);
+    m_cache->SetMaxCount(newSize);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void DgnElements::SetCacheMemoryLimit(uint64_t maxBytes)
+    {
+    m_cache->SetMemoryLimit(maxBytes);
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -121,8 +281,23 @@ void DgnElements::SetCacheSize(uint32_t newSize)
 +---------------+---------------+---------------+---------------+---------------+------*/
 void DgnElements::ClearCache()
     {
-    BeMutexHolder _v_v(m_mutex);
-    m_mruCache->Clear();
+    m_cache->Clear();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+DgnElements::CacheStats DgnElements::GetCacheStats() const
+    {
+    return m_cache->GetStats();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void DgnElements::ResetCacheStats()
+    {
+    m_cache->ResetStats();
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -130,8 +305,7 @@ void DgnElements::ClearCache()
 +---------------+---------------+---------------+---------------+---------------+------*/
 void DgnElements::AddToPool(DgnElementCR element) const
     {
-    BeMutexHolder _v_v(m_mutex);
-    m_mruCache->AddElement(element);
+    m_cache->AddElement(element);
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -139,17 +313,16 @@ void DgnElements::AddToPool(DgnElementCR element) const
 +---------------+---------------+---------------+---------------+---------------+------*/
 void DgnElements::DropFromPool(DgnElementCR element) const
     {
-    BeMutexHolder _v_v(m_mutex);
-    m_mruCache->DropElement(element.GetElementId());
+    m_cache->DropElement(element.GetElementId());
     }
 
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-DgnElementCP DgnElements::FindLoadedElement(DgnElementId id) const
+DgnElementCPtr DgnElements::FindLoadedElement(DgnElementId id) const
     {
-    BeMutexHolder _v_v(m_mutex);
-    return m_mruCache->FindElement(id);
+    BeMutexHolder _v(m_mutex);
+    return m_cache->FindElement(id);
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -199,7 +372,7 @@ DgnElement::~DgnElement()
 +---------------+---------------+---------------+---------------+---------------+------*/
 DgnElements::DgnElements(DgnDbR dgndb) : DgnDbTable(dgndb), m_stmts(20), m_snappyFrom(m_snappyFromBuffer, _countof(m_snappyFromBuffer))
     {
-    m_mruCache.reset(new ElementMRU());
+    m_cache.reset(new ElementCache());
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -324,8 +497,178 @@ DgnElementCPtr DgnElements::LoadElement(DgnElementId elementId,  bool makePersis
      // since we can load elements on more than one thread, we need to check that the element doesn't already exist
      // *with the lock held* before we load it. This avoids a race condition where an element is loaded on more than one thread.
      BeMutexHolder _v(m_mutex);
-     DgnElementCP element = FindLoadedElement(elementId);
-     return (nullptr != element) ? element : LoadElement(elementId, true);
+     DgnElementCPtr element = m_cache->FindElement(elementId);
+     return element.IsValid() ? element : LoadElement(elementId, true);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Load elements that are not in the element cache. The base rows of all of the elements are read
+* with one query, then their subclass rows are read with one query per ECClass. Each element is
+* then created from its rows by the usual DgnElement::_LoadFromDb path.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void DgnElements::LoadElementBatch(bmap<DgnElementId, DgnElementCPtr>& loaded, bvector<DgnElementId> const& sortedIds) const
+    {
+    struct PendingElement
+        {
+        DgnElement::CreateParams m_params;
+        Utf8String m_jsonProps;
+        bool m_loaded = false;
+        PendingElement(DgnElement::CreateParams const& params, Utf8CP jsonProps) : m_params(params) {m_jsonProps.AssignOrClear(jsonProps);}
+        };
+
+    bmap<DgnClassId, bvector<PendingElement>> pendingByClass;
+        {
+        enum Column : int {Id=0,ClassId=1,ModelId=2,CodeSpec=3,CodeScope=4,CodeValue=5,UserLabel=6,ParentId=7,ParentRelClassId=8,FederationGuid=9,JsonProps=10};
+        CachedStatementPtr stmt = GetStatement("SELECT Id,ECClassId,ModelId,CodeSpecId,CodeScopeId,CodeValue,UserLabel,ParentId,ParentRelECClassId,FederationGuid,JsonProperties FROM " BIS_TABLE(BIS_CLASS_Element)
+                                               " WHERE Id BETWEEN ? AND ? AND InVirtualSet(?,Id)");
+        DgnElementIdSet idSet;
+        for (auto id : sortedIds)
+            idSet.insert(id);
+
+        stmt->BindId(1, sortedIds.front());
+        stmt->BindId(2, sortedIds.back());
+        stmt->BindVirtualSet(3, idSet);
+
+        while (BE_SQLITE_ROW == stmt->Step())
+            {
+            DgnCode code(stmt->GetValueId<CodeSpecId>(Column::CodeSpec), stmt->GetValueId<DgnElementId>(Column::CodeScope), stmt->GetValueText(Column::CodeValue));
+
+            DgnElement::CreateParams createParams(m_dgndb, stmt->GetValueId<DgnModelId>(Column::ModelId),
+                            stmt->GetValueId<DgnClassId>(Column::ClassId),
+                            code,
+                            stmt->GetValueText(Column::UserLabel),
+                            stmt->GetValueId<DgnElementId>(Column::ParentId),
+                            stmt->GetValueId<DgnClassId>(Column::ParentRelClassId),
+                            stmt->GetValueGuid(Column::FederationGuid));
+
+            createParams.SetElementId(stmt->GetValueId<DgnElementId>(Column::Id));
+            createParams.SetIsLoadingElement(true);
+            pendingByClass[createParams.m_classId].push_back(PendingElement(createParams, stmt->GetValueText(Column::JsonProps)));
+            }
+        }
+
+    auto loadElement = [&](PendingElement& pending, PrefetchedRow const* row)
+        {
+        pending.m_loaded = true;
+        DgnElementId id = pending.m_params.m_id;
+
+        // the element may have been loaded while loading an earlier element of this batch.
+        DgnElementCPtr el = m_cache->FindElement(id);
+        if (el.IsValid())
+            {
+            loaded[id] = el;
+            return;
+            }
+
+        PrefetchedRow const* outerRow = m_prefetchedRow;
+        m_prefetchedRow = row;
+        try {
+            loaded[id] = LoadElement(pending.m_params, pending.m_jsonProps.empty() ? nullptr : pending.m_jsonProps.c_str(), true);
+        } catch (Napi::Error const& jsError) {
+            m_prefetchedRow = outerRow;
+            throw jsError; // allow Javascript to handle exception
+        } catch (std::exception const& e) {
+            BeAssert(false && "exception in loadElement");
+            LOG.errorv("exception in loadElement: %s", e.what());
+        } catch (...) {
+            BeAssert(false && "exception in loadElement");
+            LOG.error("exception in loadElement");
+        }
+        m_prefetchedRow = outerRow;
+        };
+
+    for (auto& entry : pendingByClass)
+        {
+        bvector<PendingElement>& pending = entry.second;
+        bmap<DgnElementId, PendingElement*> pendingById;
+        auto classIds = std::make_shared<DgnElementIdSet>();
+        for (auto& element : pending)
+            {
+            pendingById[element.m_params.m_id] = &element;
+            classIds->insert(element.m_params.m_id);
+            }
+
+        ECInstanceId firstId(pendingById.begin()->first.GetValue());
+        ECInstanceId lastId(pendingById.rbegin()->first.GetValue());
+        CachedECSqlStatementPtr select = FindClassInfo(entry.first).GetBatchSelectStmt(m_dgndb, classIds, firstId, lastId);
+        if (select.IsValid())
+            {
+            ECSqlClassParamsCR params = GetECSqlClassParams(entry.first);
+            int idColumn = select->GetColumnCount() - 1;
+            while (BE_SQLITE_ROW == select->Step())
+                {
+                DgnElementId id = select->GetValueId<DgnElementId>(idColumn);
+                auto found = pendingById.find(id);
+                if (found == pendingById.end() || found->second->m_loaded)
+                    continue;
+
+                PrefetchedRow row(id, *select, params);
+                loadElement(*found->second, &row);
+                }
+            }
+
+        // elements of classes without SELECT properties, and any element whose subclass row was not found, load one at a time.
+        for (auto& element : pending)
+            {
+            if (!element.m_loaded)
+                loadElement(element, nullptr);
+            }
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bvector<DgnElementCPtr> DgnElements::LoadElements(bvector<DgnElementId> const& elementIds) const
+    {
+    // each batch holds ids that are close together, so that its queries visit only a narrow range of the primary key index.
+    static const size_t s_maxBatchSize = 1000;
+    static const uint64_t s_maxBatchIdGap = 64;
+
+    bvector<DgnElementCPtr> elements(elementIds.size());
+
+    // as in GetElement, hold the lock so that no element is loaded on more than one thread.
+    BeMutexHolder _v(m_mutex);
+    DgnElementIdSet missing;
+    for (size_t i = 0; i < elementIds.size(); ++i)
+        {
+        if (!elementIds[i].IsValid())
+            continue;
+
+        elements[i] = m_cache->FindElement(elementIds[i]);
+        if (!elements[i].IsValid())
+            missing.insert(elementIds[i]);
+        }
+
+    if (missing.empty())
+        return elements;
+
+    bmap<DgnElementId, DgnElementCPtr> loaded;
+    bvector<DgnElementId> batch;
+    for (auto id : missing)
+        {
+        if (!batch.empty() && (batch.size() >= s_maxBatchSize || id.GetValue() - batch.back().GetValue() > s_maxBatchIdGap))
+            {
+            LoadElementBatch(loaded, batch);
+            batch.clear();
+            }
+        batch.push_back(id);
+        }
+
+    LoadElementBatch(loaded, batch);
+
+    for (size_t i = 0; i < elementIds.size(); ++i)
+        {
+        if (elements[i].IsValid())
+            continue;
+
+        auto found = loaded.find(elementIds[i]);
+        if (found != loaded.end())
+            elements[i] = found->second;
+        }
+
+    return elements;
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -548,7 +891,7 @@ DgnDbStatus DgnElements::UpdateElement(DgnElementR replacement)
     DgnDb::VerifyClientThread();
 
     // Get a pointer to the original element. Note: this means that the pre-changed element will be in the
-    // MRU cache for the duration of this method. Until we're done all other threads will see the unchanged element.
+    // element cache for the duration of this method. Until we're done all other threads will see the unchanged element.
     DgnElementCPtr orig = GetElement(replacement.GetElementId());
     if (!orig.IsValid())
         return  DgnDbStatus::InvalidId;
@@ -610,7 +953,7 @@ DgnDbStatus DgnElements::UpdateElement(DgnElementR replacement)
             parent->_OnChildUpdated(element);
         }
 
-    // now drop the old element from MRU cache. The next request will load the updated element.
+    // now drop the old element from the element cache. The next request will load the updated element.
     DropFromPool(element);
 
     return DgnDbStatus::Success;
@@ -3,6 +3,7 @@
 * See LICENSE.md in the repository root for full copyright notice.
 *--------------------------------------------------------------------------------------------*/
 #include <DgnPlatformInternal.h>
+#include <Bentley/BeFileListIterator.h>
 
 /*---------------------------------------------------------------------------------**/ /**
 @bsimethod
@@ -813,15 +814,26 @@ DateTime DgnModel::QueryLastModifyTime() const {
 /*---------------------------------------------------------------------------------**/ /**
  @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-BeGuid GeometricModel::QueryGeometryGuid() const {
+static bool queryGeometryGuid(BeGuid& guid, DgnDbR db, DgnModelId modelId) {
     ECSqlStatement stmt;
-    if (!stmt.Prepare(GetDgnDb(), "SELECT GeometryGuid FROM " BIS_SCHEMA(BIS_CLASS_GeometricModel) " WHERE ECInstanceId=?", false).IsSuccess())
-        return BeGuid();
+    if (!stmt.Prepare(db, "SELECT GeometryGuid FROM " BIS_SCHEMA(BIS_CLASS_GeometricModel) " WHERE ECInstanceId=?", false).IsSuccess())
+        return false;
 
-    stmt.BindId(1, m_modelId);
-    stmt.Step();
+    stmt.BindId(1, modelId);
+    if (BE_SQLITE_ROW != stmt.Step())
+        return false;
 
-    return stmt.GetValueGuid(0);
+    guid = stmt.GetValueGuid(0);
+    return true;
+}
+
+/*---------------------------------------------------------------------------------**/ /**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BeGuid GeometricModel::QueryGeometryGuid() const {
+    BeGuid guid;
+    queryGeometryGuid(guid, GetDgnDb(), m_modelId);
+    return guid;
 }
 
 /*---------------------------------------------------------------------------------**/ /**
@@ -1006,6 +1018,131 @@ DgnDbStatus DgnModel::_OnUpdate() {
     return DgnDbStatus::Success;
 }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static BeFileName getRangeIndexSnapshotFileName(DgnDbR db, DgnModelId modelId) {
+    BeFileName fileName(db.GetDbFileName());
+    fileName.AppendUtf8(Utf8PrintfString(".%s.rangeindex", modelId.ToHexStr().c_str()).c_str());
+    return fileName;
+}
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BeFileName GeometricModel::GetRangeIndexSnapshotFileName() const {
+    return getRangeIndexSnapshotFileName(GetDgnDb(), GetModelId());
+}
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static Utf8String makeRangeIndexSnapshotKey(DgnDbR db, DgnModelId modelId, BeGuid geometryGuid) {
+    return Utf8PrintfString("%s|%s|%s", modelId.ToHexStr().c_str(), db.Txns().GetParentChangesetId().c_str(), geometryGuid.ToString().c_str());
+}
+
+/*---------------------------------------------------------------------------------**//**
+* A snapshot is only valid for the state of the model as of a changeset, so there is no key when there are local changes.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Utf8String GeometricModel::GetRangeIndexSnapshotKey() const {
+    if (GetDgnDb().Txns().HasLocalChanges())
+        return Utf8String();
+
+    return makeRangeIndexSnapshotKey(GetDgnDb(), GetModelId(), QueryGeometryGuid());
+}
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BentleyStatus GeometricModel::SaveRangeIndexSnapshot() const {
+    BeMutexHolder lock(m_mutex);
+    if (nullptr == m_rangeIndex)
+        return ERROR;
+
+    Utf8String key = GetRangeIndexSnapshotKey();
+    if (key.empty())
+        return ERROR;
+
+    if (key == m_rangeIndexSnapshotKey)
+        return SUCCESS;
+
+    if (SUCCESS != m_rangeIndex->SaveSnapshot(GetRangeIndexSnapshotFileName(), key))
+        return ERROR;
+
+    m_rangeIndexSnapshotKey = key;
+    return SUCCESS;
+}
+
+/*---------------------------------------------------------------------------------**//**
+* Called by _FillRangeIndex with an empty range index. A snapshot that cannot be used for the current state of the model is deleted.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool GeometricModel::LoadRangeIndexSnapshot() {
+    BeFileName fileName = GetRangeIndexSnapshotFileName();
+    if (!fileName.DoesPathExist())
+        return false;
+
+    Utf8String key = GetRangeIndexSnapshotKey();
+    if (key.empty())
+        return false; // local changes. The snapshot may become valid again if they are abandoned.
+
+    if (SUCCESS != m_rangeIndex->LoadSnapshot(fileName, key)) {
+        fileName.BeDeleteFile();
+        return false;
+    }
+
+    m_rangeIndexSnapshotKey = key;
+    return true;
+}
+
+/*---------------------------------------------------------------------------------**//**
+* Called when the DgnDb is closed or checkpointed.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void DgnModels::SaveRangeIndexSnapshots() {
+    BeMutexHolder lock(m_mutex);
+    if (m_models.empty() || GetDgnDb().Txns().HasLocalChanges())
+        return;
+
+    for (auto& kvp : m_models) {
+        auto geomModel = kvp.second->ToGeometricModel();
+        if (nullptr != geomModel && nullptr != geomModel->GetRangeIndex())
+            geomModel->SaveRangeIndexSnapshot();
+    }
+}
+
+/*---------------------------------------------------------------------------------**//**
+* Called when the DgnDb is opened. Deletes the range index snapshots of this DgnDb that were written for an earlier changeset,
+* for an earlier state of the geometry of their model, or for a model that no longer exists.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void DgnModels::DeleteStaleRangeIndexSnapshots() {
+    BeFileName pattern(GetDgnDb().GetDbFileName());
+    pattern.AppendString(L".*.rangeindex*");
+
+    bvector<BeFileName> stalePaths;
+    BeFileListIterator iter(pattern, false);
+    BeFileName path;
+    while (SUCCESS == iter.GetNextFileName(path)) {
+        // ".tmp" files are left behind by a failed save.
+        Utf8String key = path.GetExtension().EqualsI(L"rangeindex") ? RangeIndex::Tree::ReadSnapshotKey(path) : Utf8String();
+        size_t idEnd = key.find('|');
+        if (Utf8String::npos != idEnd) {
+            // check the model without loading it.
+            DgnModelId modelId(BeInt64Id::FromString(key.substr(0, idEnd).c_str()).GetValue());
+            BeGuid geometryGuid;
+            if (modelId.IsValid() && path == getRangeIndexSnapshotFileName(GetDgnDb(), modelId) && queryGeometryGuid(geometryGuid, GetDgnDb(), modelId) &&
+                key == makeRangeIndexSnapshotKey(GetDgnDb(), modelId, geometryGuid))
+                continue;
+        }
+        stalePaths.push_back(path);
+    }
+
+    for (BeFileNameCR stalePath : stalePaths)
+        stalePath.BeDeleteFile();
+}
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -1015,6 +1152,10 @@ DgnDbStatus GeometricModel3d::_FillRangeIndex() {
         return DgnDbStatus::Success;
 
     m_rangeIndex.reset(new RangeIndex::Tree(true, 20));
+    if (LoadRangeIndexSnapshot())
+        return DgnDbStatus::Success;
+
+    bvector<RangeIndex::Entry> entries;
 
     if (!m_isNotSpatiallyLocated) {
         // use the spatial index because it doesn't need any data from the GeometricElement3d table.
@@ -1032,7 +1173,7 @@ DgnDbStatus GeometricModel3d::_FillRangeIndex() {
                 stmt.GetValueDouble(5),
                 stmt.GetValueDouble(6)
             );
-            m_rangeIndex->AddEntry(RangeIndex::Entry(RangeIndex::FBox(range, false), stmt.GetValueId<DgnElementId>(0)));
+            entries.push_back(RangeIndex::Entry(RangeIndex::FBox(range, false), stmt.GetValueId<DgnElementId>(0)));
         }
     } else {
         // this is only for models that are not in the spatial index (e.g. plan projection models). This is a rare case.
@@ -1054,10 +1195,11 @@ DgnDbStatus GeometricModel3d::_FillRangeIndex() {
                                     ElementAlignedBox3d(low.x, low.y, low.z, high.x, high.y, high.z));
 
             RangeIndex::FBox fBox(placement.CalculateRange(), false);
-            m_rangeIndex->AddEntry(RangeIndex::Entry(fBox, stmt->GetValueId<DgnElementId>(0)));
+            entries.push_back(RangeIndex::Entry(fBox, stmt->GetValueId<DgnElementId>(0)));
         }
     }
 
+    m_rangeIndex->LoadEntries(entries);
     return DgnDbStatus::Success;
 }
 
@@ -1093,6 +1235,10 @@ DgnDbStatus GeometricModel2d::_FillRangeIndex() {
         return DgnDbStatus::Success;
 
     m_rangeIndex.reset(new RangeIndex::Tree(false, 20));
+    if (LoadRangeIndexSnapshot())
+        return DgnDbStatus::Success;
+
+    bvector<RangeIndex::Entry> entries;
 
     auto stmt = m_dgndb.GetPreparedECSqlStatement("SELECT ECInstanceId,Origin,Rotation,BBoxLow,BBoxHigh FROM " BIS_SCHEMA(BIS_CLASS_GeometricElement2d) " WHERE Model.Id=?");
     stmt->BindId(1, GetModelId());
@@ -1109,9 +1255,10 @@ DgnDbStatus GeometricModel2d::_FillRangeIndex() {
                               ElementAlignedBox2d(low.x, low.y, high.x, high.y));
 
         RangeIndex::FBox fbox(placement.CalculateRange(), true);
-        m_rangeIndex->AddEntry(RangeIndex::Entry(fbox, stmt->GetValueId<DgnElementId>(0)));
+        entries.push_back(RangeIndex::Entry(fbox, stmt->GetValueId<DgnElementId>(0)));
     }
 
+    m_rangeIndex->LoadEntries(entries);
     return DgnDbStatus::Success;
 }
 
@@ -126,7 +126,7 @@ uint16_t ECSqlClassParams::BuildInsertECSql(Utf8StringR ecsql, DgnDbCR dgndb, EC
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-uint16_t ECSqlClassParams::BuildSelectECSql(Utf8StringR ecsql, DgnDbCR dgndb, ECClassCR ecclass) const
+uint16_t ECSqlClassParams::BuildSelectECSql(Utf8StringR ecsql, DgnDbCR dgndb, ECClassCR ecclass, bool batch) const
     {
     ecsql.clear();
     ecsql.append("SELECT ");
@@ -143,9 +143,16 @@ uint16_t ECSqlClassParams::BuildSelectECSql(Utf8StringR ecsql, DgnDbCR dgndb, EC
         return 0;
         }
 
+    if (batch)
+        ecsql.append(",ECInstanceId");
+
     ecsql.append(" FROM ONLY ");
     AppendClassName(ecsql, dgndb, ecclass);
-    ecsql.append(" WHERE ECInstanceId=? ECSQLOPTIONS NoECClassIdFilter");
+    if (batch)
+        ecsql.append(" WHERE ECInstanceId BETWEEN ? AND ? AND InVirtualSet(?,ECInstanceId) ECSQLOPTIONS NoECClassIdFilter");
+    else
+        ecsql.append(" WHERE ECInstanceId=? ECSQLOPTIONS NoECClassIdFilter");
+
     return numSelectParams;
     }
 
@@ -181,18 +188,20 @@ uint16_t ECSqlClassParams::BuildUpdateECSql(Utf8StringR ecsql, DgnDbCR dgndb, EC
 +---------------+---------------+---------------+---------------+---------------+------*/
 bool ECSqlClassParams::BuildClassInfo(ECSqlClassInfo& info, DgnDbCR dgndb, DgnClassId classId) const
     {
-    Utf8String select, insert, update;
+    Utf8String select, selectBatch, insert, update;
     ECClassCP ecclass = dgndb.Schemas().GetClass(classId);
     BeAssert(nullptr != ecclass);
     if (nullptr == ecclass)
         return false;
 
     BuildSelectECSql(select, dgndb, *ecclass);
+    BuildSelectECSql(selectBatch, dgndb, *ecclass, true);
     BuildInsertECSql(insert, dgndb, *ecclass);
     uint16_t numUpdateParams = BuildUpdateECSql(update, dgndb, *ecclass);
 
     info.m_updateParameterIndex = numUpdateParams + 1;
     info.m_select = select;
+    info.m_selectBatch = selectBatch;
     info.m_insert = insert;
     info.m_update = update;
 
@@ -280,6 +289,24 @@ CachedECSqlStatementPtr ECSqlClassInfo::GetSelectStmt(DgnDbCR dgndb, ECInstanceI
     return stmt;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* Get a statement that selects the rows of the instances in instanceIds, which must all lie between firstId and lastId.
+* The range lets SQLite visit only that part of the primary key index instead of testing every row against the set.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+CachedECSqlStatementPtr ECSqlClassInfo::GetBatchSelectStmt(DgnDbCR dgndb, std::shared_ptr<VirtualSet> instanceIds, ECInstanceId firstId, ECInstanceId lastId) const
+    {
+    CachedECSqlStatementPtr stmt = m_selectBatch.empty() ? nullptr : dgndb.GetPreparedECSqlStatement(m_selectBatch.c_str());
+    if (stmt.IsValid())
+        {
+        stmt->BindId(1, firstId);
+        stmt->BindId(2, lastId);
+        stmt->BindVirtualSet(3, instanceIds);
+        }
+
+    return stmt;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
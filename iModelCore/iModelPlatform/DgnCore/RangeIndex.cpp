@@ -4,6 +4,15 @@
 *--------------------------------------------------------------------------------------------*/
 #include <DgnPlatformInternal.h>
 
+// Leaf entries are tested against filters 8 at a time with AVX2 when the build enables it, 4 at a time with SSE2 (always available on x64), and one at a time otherwise.
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define RANGEINDEX_USE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define RANGEINDEX_USE_SSE2
+#endif
+
 using namespace RangeIndex;
 
 BEGIN_UNNAMED_NAMESPACE
@@ -144,6 +153,96 @@ static double checkSeparation(SplitEntryP entries, size_t count, SplitAxis axis)
 
     return  maxSeparation;
     }
+
+/*---------------------------------------------------------------------------------**//**
+* Reorder items by Sort-Tile-Recursive so that each consecutive run of groupSize items is spatially compact. Items are sorted by
+* the x coordinate of their centers and cut into slices, each slice is sorted by y and (for 3d) cut into strips that are sorted by z.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+template<typename T, typename GetRange> static void sortTileRecursive(T* items, size_t count, size_t groupSize, bool is3d, GetRange getRange)
+    {
+    auto byX = [&](T const& lhs, T const& rhs) {FBoxCR l = getRange(lhs), r = getRange(rhs); return l.Low().x + l.High().x < r.Low().x + r.High().x;};
+    auto byY = [&](T const& lhs, T const& rhs) {FBoxCR l = getRange(lhs), r = getRange(rhs); return l.Low().y + l.High().y < r.Low().y + r.High().y;};
+    auto byZ = [&](T const& lhs, T const& rhs) {FBoxCR l = getRange(lhs), r = getRange(rhs); return l.Low().z + l.High().z < r.Low().z + r.High().z;};
+
+    size_t nGroups = (count + groupSize - 1) / groupSize;
+    if (nGroups <= 1)
+        return;
+
+    size_t nSlices = (size_t) std::ceil(is3d ? std::cbrt((double) nGroups) : std::sqrt((double) nGroups));
+    size_t sliceSize = groupSize * ((nGroups + nSlices - 1) / nSlices);
+
+    std::sort(items, items + count, byX);
+    for (size_t sliceStart = 0; sliceStart < count; sliceStart += sliceSize)
+        {
+        size_t sliceCount = std::min(sliceSize, count - sliceStart);
+        std::sort(items + sliceStart, items + sliceStart + sliceCount, byY);
+        if (!is3d)
+            continue;
+
+        size_t sliceGroups = (sliceCount + groupSize - 1) / groupSize;
+        size_t stripSize = groupSize * ((sliceGroups + nSlices - 1) / nSlices);
+        for (size_t stripStart = 0; stripStart < sliceCount; stripStart += stripSize)
+            {
+            T* strip = items + sliceStart + stripStart;
+            std::sort(strip, strip + std::min(stripSize, sliceCount - stripStart), byZ);
+            }
+        }
+    }
+
+//=======================================================================================
+//! The start of a range index snapshot file. It is followed by the key, and then by the nodes of the tree in depth-first order.
+//! Each node is a SnapshotNode followed by its entries (for leaves) or its children (for internal nodes). Entries are written as
+//! they are held in memory, so a snapshot is only readable by a build with the same Entry layout and byte order.
+// @bsiclass
+//=======================================================================================
+struct SnapshotHeader
+{
+    static constexpr uint32_t FormatVersion = 1;
+
+    char m_signature[8];
+    uint32_t m_formatVersion;
+    uint32_t m_entrySize;
+    uint32_t m_is3d;
+    uint32_t m_internalNodeSize;
+    uint32_t m_leafNodeSize;
+    uint32_t m_keySize;
+    uint64_t m_entryCount;
+
+    static char const* Signature() {return "RangeIdx";}
+};
+
+//=======================================================================================
+// @bsiclass
+//=======================================================================================
+struct SnapshotNode
+{
+    uint32_t m_isLeaf;
+    uint32_t m_childCount;
+};
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static void appendBytes(bvector<Byte>& buffer, void const* data, size_t size)
+    {
+    Byte const* bytes = static_cast<Byte const*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static bool readBytes(Byte const*& pos, Byte const* end, void* data, size_t size)
+    {
+    if ((size_t) (end - pos) < size)
+        return false;
+
+    memcpy(data, pos, size);
+    pos += size;
+    return true;
+    }
+
 END_UNNAMED_NAMESPACE
 
 /*---------------------------------------------------------------------------------**//**
@@ -299,7 +398,7 @@ Tree::Node* Tree::InternalNode::ChooseBestNode(FBoxCP pRange, TreeR root)
 void Tree::InternalNode::AddEntry(Entry const& entry, TreeR root)
     {
     m_nodeRange.Extend(entry.m_range);
-    auto* node = ChooseBestNode(&entry.m_range, root);
+    auto* node = root.MakeWritable(ChooseBestNode(&entry.m_range, root));
 
     LeafNodeP leaf = node->ToLeaf();
     if (leaf)
@@ -357,6 +456,40 @@ void Tree::InternalNode::DropNode(Node* entry, TreeR root)
     BeAssert(false); // we were asked to drop a child we didn't hold
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::InternalNode::ReplaceChild(Node* oldChild, Node* newChild)
+    {
+    for (auto curr = &m_firstChild[0]; curr < m_endChild; ++curr)
+        {
+        if (*curr == oldChild)
+            {
+            *curr = newChild;
+            return;
+            }
+        }
+
+    BeAssert(false); // we were asked to replace a child we didn't hold
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Tree::InternalNode* Tree::InternalNode::CloneInternal(TreeR root) const
+    {
+    InternalNodeP copy = root.AllocateInternalNode();
+    copy->m_nodeRange = m_nodeRange;
+    copy->m_parent = m_parent;
+    for (auto curr = &m_firstChild[0]; curr < m_endChild; ++curr)
+        {
+        (*curr)->SetParent(copy);   // only writers follow parent pointers, so this is safe even though the child may be shared with readers.
+        *copy->m_endChild++ = *curr;
+        }
+
+    return copy;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -411,6 +544,7 @@ void Tree::LeafNode::AddEntryToLeaf(Entry const& entry, TreeR root)
     {
     m_nodeRange.Extend(entry.m_range);
 
+    m_bounds.Set(GetEntryCount(), entry.m_range);
     *m_endChild = entry;
     ++m_endChild;
 
@@ -422,6 +556,157 @@ void Tree::LeafNode::AddEntryToLeaf(Entry const& entry, TreeR root)
         SplitLeafNode(root);
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::LeafNode::Bounds::Set(size_t index, FBoxCR range)
+    {
+    BeAssert(index < MAX_ENTRIES);
+    m_lowX[index] = range.Low().x;
+    m_lowY[index] = range.Low().y;
+    m_lowZ[index] = range.Low().z;
+    m_highX[index] = range.High().x;
+    m_highY[index] = range.High().y;
+    m_highZ[index] = range.High().z;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::LeafNode::Bounds::Move(size_t to, size_t from, size_t count)
+    {
+    if (0 == count)
+        return;
+
+    BeAssert(to + count <= MAX_ENTRIES && from + count <= MAX_ENTRIES);
+    memmove(m_lowX + to, m_lowX + from, count * sizeof(float));
+    memmove(m_lowY + to, m_lowY + from, count * sizeof(float));
+    memmove(m_lowZ + to, m_lowZ + from, count * sizeof(float));
+    memmove(m_highX + to, m_highX + from, count * sizeof(float));
+    memmove(m_highY + to, m_highY + from, count * sizeof(float));
+    memmove(m_highZ + to, m_highZ + from, count * sizeof(float));
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Return a mask with bit n set if the range of entry n overlaps the supplied range. The vector loops may read past the last
+* entry (but never past MAX_ENTRIES); those lanes are masked off.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+uint32_t Tree::LeafNode::Bounds::Overlaps(size_t count, FBoxCR range, bool is3d) const
+    {
+    uint32_t mask = 0;
+
+#if defined(RANGEINDEX_USE_AVX2)
+    const __m256 lowX = _mm256_set1_ps(range.Low().x), lowY = _mm256_set1_ps(range.Low().y), lowZ = _mm256_set1_ps(range.Low().z);
+    const __m256 highX = _mm256_set1_ps(range.High().x), highY = _mm256_set1_ps(range.High().y), highZ = _mm256_set1_ps(range.High().z);
+    for (size_t i = 0; i < count; i += 8)
+        {
+        __m256 in = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(m_lowX + i), highX, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(m_highX + i), lowX, _CMP_GE_OQ));
+        in = _mm256_and_ps(in, _mm256_cmp_ps(_mm256_loadu_ps(m_lowY + i), highY, _CMP_LE_OQ));
+        in = _mm256_and_ps(in, _mm256_cmp_ps(_mm256_loadu_ps(m_highY + i), lowY, _CMP_GE_OQ));
+        if (is3d)
+            {
+            in = _mm256_and_ps(in, _mm256_cmp_ps(_mm256_loadu_ps(m_lowZ + i), highZ, _CMP_LE_OQ));
+            in = _mm256_and_ps(in, _mm256_cmp_ps(_mm256_loadu_ps(m_highZ + i), lowZ, _CMP_GE_OQ));
+            }
+        mask |= (uint32_t) _mm256_movemask_ps(in) << i;
+        }
+#elif defined(RANGEINDEX_USE_SSE2)
+    const __m128 lowX = _mm_set1_ps(range.Low().x), lowY = _mm_set1_ps(range.Low().y), lowZ = _mm_set1_ps(range.Low().z);
+    const __m128 highX = _mm_set1_ps(range.High().x), highY = _mm_set1_ps(range.High().y), highZ = _mm_set1_ps(range.High().z);
+    for (size_t i = 0; i < count; i += 4)
+        {
+        __m128 in = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(m_lowX + i), highX), _mm_cmpge_ps(_mm_loadu_ps(m_highX + i), lowX));
+        in = _mm_and_ps(in, _mm_cmple_ps(_mm_loadu_ps(m_lowY + i), highY));
+        in = _mm_and_ps(in, _mm_cmpge_ps(_mm_loadu_ps(m_highY + i), lowY));
+        if (is3d)
+            {
+            in = _mm_and_ps(in, _mm_cmple_ps(_mm_loadu_ps(m_lowZ + i), highZ));
+            in = _mm_and_ps(in, _mm_cmpge_ps(_mm_loadu_ps(m_highZ + i), lowZ));
+            }
+        mask |= (uint32_t) _mm_movemask_ps(in) << i;
+        }
+#else
+    for (size_t i = 0; i < count; ++i)
+        {
+        if (m_lowX[i] <= range.High().x && m_highX[i] >= range.Low().x && m_lowY[i] <= range.High().y && m_highY[i] >= range.Low().y &&
+            (!is3d || (m_lowZ[i] <= range.High().z && m_highZ[i] >= range.Low().z)))
+            mask |= 1u << i;
+        }
+#endif
+
+    return mask & ((1u << count) - 1);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Return a mask with bit n set if the range of entry n is not entirely outside of any of the supplied planes. For each plane
+* only the corner of the range that is furthest along its normal needs to be tested, and since that choice is the same for
+* every entry it is made once per plane.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+uint32_t Tree::LeafNode::Bounds::Inside(size_t count, FPlaneCP planes, size_t nPlanes, bool is3d) const
+    {
+    uint32_t mask = (1u << count) - 1;
+
+    for (size_t iPlane = 0; iPlane < nPlanes && 0 != mask; ++iPlane)
+        {
+        FPlaneCR plane = planes[iPlane];
+        float const* xs = plane.m_a > 0 ? m_highX : m_lowX;
+        float const* ys = plane.m_b > 0 ? m_highY : m_lowY;
+        float const* zs = plane.m_c > 0 ? m_highZ : m_lowZ;
+        float c = is3d ? plane.m_c : 0.0f;
+        uint32_t planeMask = 0;
+
+#if defined(RANGEINDEX_USE_AVX2)
+        const __m256 a = _mm256_set1_ps(plane.m_a), b = _mm256_set1_ps(plane.m_b), cz = _mm256_set1_ps(c), d = _mm256_set1_ps(plane.m_d), zero = _mm256_setzero_ps();
+        for (size_t i = 0; i < count; i += 8)
+            {
+            __m256 v = _mm256_add_ps(_mm256_mul_ps(a, _mm256_loadu_ps(xs + i)), _mm256_mul_ps(b, _mm256_loadu_ps(ys + i)));
+            v = _mm256_add_ps(v, _mm256_add_ps(_mm256_mul_ps(cz, _mm256_loadu_ps(zs + i)), d));
+            planeMask |= (uint32_t) _mm256_movemask_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ)) << i;
+            }
+#elif defined(RANGEINDEX_USE_SSE2)
+        const __m128 a = _mm_set1_ps(plane.m_a), b = _mm_set1_ps(plane.m_b), cz = _mm_set1_ps(c), d = _mm_set1_ps(plane.m_d), zero = _mm_setzero_ps();
+        for (size_t i = 0; i < count; i += 4)
+            {
+            __m128 v = _mm_add_ps(_mm_mul_ps(a, _mm_loadu_ps(xs + i)), _mm_mul_ps(b, _mm_loadu_ps(ys + i)));
+            v = _mm_add_ps(v, _mm_add_ps(_mm_mul_ps(cz, _mm_loadu_ps(zs + i)), d));
+            planeMask |= (uint32_t) _mm_movemask_ps(_mm_cmpge_ps(v, zero)) << i;
+            }
+#else
+        for (size_t i = 0; i < count; ++i)
+            {
+            if ((plane.m_a * xs[i] + plane.m_b * ys[i]) + (c * zs[i] + plane.m_d) >= 0.0f)
+                planeMask |= 1u << i;
+            }
+#endif
+
+        mask &= planeMask;
+        }
+
+    return mask;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+uint32_t Tree::LeafNode::FilterEntries(Traverser const& traverser, bool is3d) const
+    {
+    size_t count = GetEntryCount();
+    uint32_t accepted = (1u << count) - 1;
+
+    FBoxCP box = traverser._GetEntryFilterBox();
+    if (nullptr != box)
+        accepted &= m_bounds.Overlaps(count, *box, is3d);
+
+    size_t nPlanes;
+    FPlaneCP planes = traverser._GetEntryFilterPlanes(nPlanes);
+    if (nullptr != planes && 0 != accepted)
+        accepted &= m_bounds.Inside(count, planes, nPlanes, is3d);
+
+    return accepted;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -437,6 +722,29 @@ EntryCP Tree::LeafNode::FindElement(DgnElementId id) const
     return nullptr;
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Tree::LeafNode* Tree::LeafNode::CloneLeaf(TreeR root) const
+    {
+    LeafNodeP copy = root.AllocateLeafNode();
+    copy->m_nodeRange = m_nodeRange;
+    copy->m_parent = m_parent;
+    copy->m_type = m_type;
+    for (EntryCP curr = &m_firstChild[0]; curr < m_endChild; ++curr)
+        {
+        copy->m_bounds.Set(copy->GetEntryCount(), curr->m_range);
+        *copy->m_endChild++ = *curr;
+
+        auto it = root.m_leafIdx.find(curr->m_id);
+        BeAssert(it != root.m_leafIdx.end());
+        if (it != root.m_leafIdx.end())
+            it->second = copy;
+        }
+
+    return copy;
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -449,7 +757,11 @@ bool Tree::LeafNode::DropElement(DgnElementId id, TreeR root)
 
         FBox range = curr->m_range;
         if (curr+1 < m_endChild)
+            {
+            size_t index = curr - m_firstChild;
+            m_bounds.Move(index, index+1, GetEntryCount() - (index+1));
             memmove(curr, curr+1, (m_endChild - curr) * sizeof(Entry));
+            }
 
         --m_endChild;
 
@@ -541,12 +853,13 @@ Traverser::Stop Tree::LeafNode::Traverse(Traverser& traverser, TreeCR tree, bool
     {
     if (Traverser::Accept::Yes == traverser._CheckRangeTreeNode(GetRange(), is3d))
         {
-        for (Entry* curr = &m_firstChild[0]; curr < m_endChild; ++curr)
+        uint32_t accepted = FilterEntries(traverser, is3d);
+        for (Entry* curr = &m_firstChild[0]; curr < m_endChild && 0 != accepted; ++curr, accepted >>= 1)
             {
-            if (Traverser::Stop::Yes == traverser._VisitRangeTreeEntry(*curr))
-                return Traverser::Stop::Yes;
+            if (0 == (accepted & 1))
+                continue;
 
-            if (tree.m_writeRequest && traverser._AbortOnWriteRequest())
+            if (Traverser::Stop::Yes == traverser._VisitRangeTreeEntry(*curr))
                 return Traverser::Stop::Yes;
             }
         }
@@ -560,6 +873,10 @@ Traverser::Stop Tree::LeafNode::Traverse(Traverser& traverser, TreeCR tree, bool
 Tree::Tree(bool is3d, size_t leafSize) : m_is3d(is3d)
     {
     m_internalNodeSize = m_leafNodeSize = 0;
+    m_readRoot.store(nullptr);
+    m_epoch.store(0);
+    m_readers[0].store(0);
+    m_readers[1].store(0);
 
     if (0 >= leafSize || leafSize>20)
         leafSize = 20;
@@ -581,11 +898,69 @@ void Tree::AddEntry(Entry const& entry)
 
     BeAssert(m_leafIdx.find(entry.m_id) == m_leafIdx.end());
 
-    LeafNodeP leaf = m_root->ToLeaf();
+    Node* root = MakeWritable(m_root);
+    LeafNodeP leaf = root->ToLeaf();
     if (leaf)
         leaf->AddEntryToLeaf(entry, *this);
     else
-        ((InternalNodeP)m_root)->AddEntry(entry, *this);
+        ((InternalNodeP)root)->AddEntry(entry, *this);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::LoadEntries(bvector<Entry>& entries)
+    {
+    WriteLock lock(*this);
+    if (!m_leafIdx.empty())
+        {
+        for (auto const& entry : entries)
+            AddEntry(entry);
+        return;
+        }
+
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](EntryCR entry) {return !entry.m_range.IsValid();}), entries.end());
+    if (entries.empty())
+        return;
+
+    sortTileRecursive(entries.data(), entries.size(), m_leafNodeSize, m_is3d, [](EntryCR entry) -> FBoxCR {return entry.m_range;});
+
+    bvector<Node*> nodes;
+    nodes.reserve((entries.size() + m_leafNodeSize - 1) / m_leafNodeSize);
+    for (size_t start = 0; start < entries.size(); start += m_leafNodeSize)
+        {
+        LeafNodeP leaf = AllocateLeafNode();
+        size_t end = std::min(start + m_leafNodeSize, entries.size());
+        for (size_t i = start; i < end; ++i)
+            leaf->AddEntryToLeaf(entries[i], *this);
+
+        nodes.push_back(leaf);
+        }
+
+    // build each level of internal nodes from the level below, until only the root is left.
+    while (nodes.size() > 1)
+        {
+        sortTileRecursive(nodes.data(), nodes.size(), m_internalNodeSize, m_is3d, [](Node* node) -> FBoxCR {return node->GetRange();});
+
+        bvector<Node*> parents;
+        parents.reserve((nodes.size() + m_internalNodeSize - 1) / m_internalNodeSize);
+        for (size_t start = 0; start < nodes.size(); start += m_internalNodeSize)
+            {
+            InternalNodeP parent = AllocateInternalNode();
+            size_t end = std::min(start + m_internalNodeSize, nodes.size());
+            for (size_t i = start; i < end; ++i)
+                parent->AddInternalNode(nodes[i], *this);
+
+            parents.push_back(parent);
+            }
+
+        nodes.swap(parents);
+        }
+
+    if (nullptr != m_root)
+        RetireNode(m_root); // the empty leaf left behind by removing every entry
+
+    m_root = nodes.front();
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -593,16 +968,16 @@ void Tree::AddEntry(Entry const& entry)
 +---------------+---------------+---------------+---------------+---------------+------*/
 StatusInt Tree::RemoveElement(DgnElementId id)
     {
+    WriteLock lock(*this);
     if (nullptr == m_root)
         return ERROR;
 
-    WriteLock lock(*this);
-
     auto it = m_leafIdx.find(id);
     if (it == m_leafIdx.end())
         return ERROR;
 
-    bool dropped = it->second->DropElement(id, *this);
+    LeafNodeP leaf = (LeafNodeP) MakeWritable(it->second);
+    bool dropped = leaf->DropElement(id, *this);
     BeAssert(dropped);
     UNUSED_VARIABLE(dropped);
     m_leafIdx.erase(it);
@@ -613,11 +988,12 @@ StatusInt Tree::RemoveElement(DgnElementId id)
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-EntryCP Tree::FindElement(DgnElementId id) const
+Nullable<Entry> Tree::FindElement(DgnElementId id) const
     {
-    ReadLock lock(*this);
+    BeMutexHolder lock(m_writeMutex); // the leaf index is only maintained for writers
     auto it = m_leafIdx.find(id);
-    return it == m_leafIdx.end() ? nullptr : it->second->FindElement(id);
+    EntryCP entry = it == m_leafIdx.end() ? nullptr : it->second->FindElement(id);
+    return entry ? Nullable<Entry>(*entry) : nullptr;
     }
 
 /*---------------------------------------------------------------------------------**//**
@@ -625,6 +1001,7 @@ EntryCP Tree::FindElement(DgnElementId id) const
 +---------------+---------------+---------------+---------------+---------------+------*/
 void Tree::SetNodeSizes(size_t internalNodeSize, size_t leafNodeSize)
     {
+    BeAssert(leafNodeSize < LeafNode::MAX_ENTRIES);
     m_internalNodeSize = internalNodeSize;
     m_leafNodeSize = leafNodeSize;
 
@@ -638,5 +1015,337 @@ void Tree::SetNodeSizes(size_t internalNodeSize, size_t leafNodeSize)
 Traverser::Stop Tree::Traverse(Traverser& traverser)
     {
     ReadLock lock(*this);
-    return (nullptr == m_root) ? Traverser::Stop::No : m_root->Traverse(traverser, *this, Is3d());
+    Node* root = m_readRoot.load();
+    return (nullptr == root) ? Traverser::Stop::No : root->Traverse(traverser, *this, Is3d());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Register a reader in the current epoch. If a writer advances the epoch between reading it and registering,
+* the registration may have been missed, so back out and try again. This never waits on a writer.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+uint32_t Tree::PinEpoch() const
+    {
+    for (;;)
+        {
+        uint32_t epoch = m_epoch.load();
+        m_readers[epoch & 1].fetch_add(1);
+        if (epoch == m_epoch.load())
+            return epoch;
+
+        m_readers[epoch & 1].fetch_sub(1);
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::UnpinEpoch(uint32_t epoch) const
+    {
+    auto readers = m_readers[epoch & 1].fetch_sub(1);
+    BeAssert(readers > 0);
+    UNUSED_VARIABLE(readers);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::BeginWrite()
+    {
+    m_writeMutex.lock();
+    if (0 == m_writeDepth++)
+        ++m_writeVersion; // every node that exists now may be visible to readers, and must be copied before it is modified.
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::EndWrite()
+    {
+    BeAssert(m_writeDepth > 0);
+    if (0 == --m_writeDepth)
+        {
+        m_readRoot.store(m_root);
+        ReclaimNodes();
+        }
+
+    m_writeMutex.unlock();
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Return a copy of node that belongs to the current write and can be modified without disturbing readers. The
+* path from the root to the node is copied as well, so that the copy is reachable from the writer's root.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Tree::Node* Tree::MakeWritable(Node* node)
+    {
+    BeAssert(m_writeDepth > 0);
+    if (node->GetVersion() == m_writeVersion)
+        return node;
+
+    // copying the parent updates the parent pointer of all its children, including this node.
+    InternalNodeP parent = (nullptr != node->GetParent()) ? (InternalNodeP) MakeWritable(node->GetParent()) : nullptr;
+
+    LeafNodeP leaf = node->ToLeaf();
+    Node* copy = leaf ? (Node*) leaf->CloneLeaf(*this) : (Node*) ((InternalNodeP) node)->CloneInternal(*this);
+
+    if (nullptr == parent)
+        {
+        BeAssert(node == m_root);
+        m_root = copy;
+        }
+    else
+        {
+        parent->ReplaceChild(node, copy);
+        }
+
+    RetireNode(node);
+    return copy;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::RetireNode(Node* node)
+    {
+    RetiredNode retired;
+    retired.m_node = node;
+    retired.m_epoch = m_epoch.load();
+    m_retired.push_back(retired);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* Readers are only ever pinned to the current epoch or the one before it. Once the readers of the previous epoch
+* have drained, advance the epoch so that new readers are counted separately from those that may still see nodes
+* retired during this one. A node may be freed when no reader pinned to the epoch in which it was retired (or earlier) remains.
+* Nodes are retired in epoch order, so we can stop at the first one that must be kept.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::ReclaimNodes()
+    {
+    if (m_retired.empty())
+        return;
+
+    uint32_t epoch = m_epoch.load();
+    if (0 == m_readers[(epoch + 1) & 1].load())
+        m_epoch.store(++epoch);
+
+    while (!m_retired.empty())
+        {
+        RetiredNode const& retired = m_retired.front();
+        uint32_t age = epoch - retired.m_epoch;
+        if (age < 1 || (1 == age && 0 != m_readers[retired.m_epoch & 1].load()))
+            break;
+
+        FreeNode(retired.m_node);
+        m_retired.pop_front();
+        }
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+void Tree::WriteSnapshotNode(bvector<Byte>& buffer, Node* node, uint64_t& entryCount) const
+    {
+    LeafNodeP leaf = node->ToLeaf();
+    SnapshotNode header;
+    header.m_isLeaf = leaf ? 1 : 0;
+    header.m_childCount = (uint32_t) (leaf ? leaf->GetEntryCount() : ((InternalNodeP) node)->GetEntryCount());
+    appendBytes(buffer, &header, sizeof(header));
+
+    if (leaf)
+        {
+        appendBytes(buffer, leaf->m_firstChild, header.m_childCount * sizeof(Entry));
+        entryCount += header.m_childCount;
+        return;
+        }
+
+    InternalNodeP internal = (InternalNodeP) node;
+    for (auto curr = &internal->m_firstChild[0]; curr < internal->m_endChild; ++curr)
+        WriteSnapshotNode(buffer, *curr, entryCount);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* A snapshot is read twice: first to validate it without building anything (build=false), then to build the nodes. The second
+* pass cannot fail, so the index is never left partially loaded.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+bool Tree::ReadSnapshotNode(Byte const*& pos, Byte const* end, bool build, uint64_t& entryCount, Node** node)
+    {
+    SnapshotNode header;
+    if (!readBytes(pos, end, &header, sizeof(header)) || 0 == header.m_childCount)
+        return false;
+
+    if (header.m_isLeaf)
+        {
+        if (header.m_childCount > m_leafNodeSize || (size_t) (end - pos) < header.m_childCount * sizeof(Entry))
+            return false;
+
+        entryCount += header.m_childCount;
+        if (build)
+            {
+            LeafNodeP leaf = AllocateLeafNode();
+            Entry entry;
+            for (uint32_t i = 0; i < header.m_childCount; ++i)
+                {
+                readBytes(pos, end, &entry, sizeof(entry));
+                leaf->AddEntryToLeaf(entry, *this);
+                }
+            *node = leaf;
+            }
+        else
+            {
+            pos += header.m_childCount * sizeof(Entry);
+            }
+
+        return true;
+        }
+
+    if (header.m_childCount > m_internalNodeSize)
+        return false;
+
+    InternalNodeP internal = build ? AllocateInternalNode() : nullptr;
+    for (uint32_t i = 0; i < header.m_childCount; ++i)
+        {
+        Node* child = nullptr;
+        if (!ReadSnapshotNode(pos, end, build, entryCount, &child))
+            return false;
+
+        if (build)
+            internal->AddInternalNode(child, *this);
+        }
+
+    *node = internal;
+    return true;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BentleyStatus Tree::SaveSnapshot(BeFileNameCR fileName, Utf8StringCR key) const
+    {
+    bvector<Byte> buffer;
+    SnapshotHeader header;
+    memcpy(header.m_signature, SnapshotHeader::Signature(), sizeof(header.m_signature));
+    header.m_formatVersion = SnapshotHeader::FormatVersion;
+    header.m_entrySize = (uint32_t) sizeof(Entry);
+    header.m_is3d = m_is3d ? 1 : 0;
+    header.m_internalNodeSize = (uint32_t) m_internalNodeSize;
+    header.m_leafNodeSize = (uint32_t) m_leafNodeSize;
+    header.m_keySize = (uint32_t) key.size();
+    header.m_entryCount = 0;
+    appendBytes(buffer, &header, sizeof(header));
+    appendBytes(buffer, key.c_str(), key.size());
+
+        {
+        ReadLock lock(*this);
+        Node* root = m_readRoot.load();
+        if (nullptr != root && (!root->IsLeaf() || 0 != root->ToLeaf()->GetEntryCount()))
+            WriteSnapshotNode(buffer, root, header.m_entryCount);
+        }
+
+    memcpy(buffer.data() + offsetof(SnapshotHeader, m_entryCount), &header.m_entryCount, sizeof(header.m_entryCount));
+
+    BeFileName tmpFileName(fileName);
+    tmpFileName.AppendString(L".tmp");
+
+    BeFile file;
+    if (BeFileStatus::Success != file.Create(tmpFileName.c_str(), true))
+        return ERROR;
+
+    Byte const* pos = buffer.data();
+    size_t remaining = buffer.size();
+    while (remaining > 0)
+        {
+        uint32_t chunk = (uint32_t) std::min(remaining, (size_t) 0x10000000);
+        uint32_t written = 0;
+        if (BeFileStatus::Success != file.Write(&written, pos, chunk) || written != chunk)
+            {
+            file.Close();
+            BeFileName::BeDeleteFile(tmpFileName.c_str());
+            return ERROR;
+            }
+        pos += chunk;
+        remaining -= chunk;
+        }
+
+    file.Close();
+    if (BeFileNameStatus::Success != BeFileName::BeMoveFile(tmpFileName, fileName))
+        {
+        BeFileName::BeDeleteFile(tmpFileName.c_str());
+        return ERROR;
+        }
+
+    return SUCCESS;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+Utf8String Tree::ReadSnapshotKey(BeFileNameCR fileName)
+    {
+    BeFile file;
+    if (BeFileStatus::Success != file.Open(fileName.c_str(), BeFileAccess::Read))
+        return Utf8String();
+
+    SnapshotHeader header;
+    uint32_t bytesRead = 0;
+    if (BeFileStatus::Success != file.Read(&header, &bytesRead, (uint32_t) sizeof(header)) || sizeof(header) != bytesRead ||
+        0 != memcmp(header.m_signature, SnapshotHeader::Signature(), sizeof(header.m_signature)) || SnapshotHeader::FormatVersion != header.m_formatVersion ||
+        sizeof(Entry) != header.m_entrySize || 0 == header.m_keySize || header.m_keySize > 0x1000)
+        return Utf8String();
+
+    Utf8String key;
+    key.resize(header.m_keySize);
+    if (BeFileStatus::Success != file.Read(&key[0], &bytesRead, header.m_keySize) || header.m_keySize != bytesRead)
+        return Utf8String();
+
+    return key;
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+BentleyStatus Tree::LoadSnapshot(BeFileNameCR fileName, Utf8StringCR key)
+    {
+    BeFile file;
+    bvector<Byte> buffer;
+    if (BeFileStatus::Success != file.Open(fileName.c_str(), BeFileAccess::Read) || BeFileStatus::Success != file.ReadEntireFile(buffer))
+        return ERROR;
+
+    file.Close();
+
+    Byte const* pos = buffer.data();
+    Byte const* end = pos + buffer.size();
+    SnapshotHeader header;
+    if (!readBytes(pos, end, &header, sizeof(header)) || 0 != memcmp(header.m_signature, SnapshotHeader::Signature(), sizeof(header.m_signature)) ||
+        SnapshotHeader::FormatVersion != header.m_formatVersion || sizeof(Entry) != header.m_entrySize || (m_is3d ? 1 : 0) != header.m_is3d ||
+        m_internalNodeSize != header.m_internalNodeSize || m_leafNodeSize != header.m_leafNodeSize || key.size() != header.m_keySize ||
+        (size_t) (end - pos) < key.size() || 0 != memcmp(pos, key.c_str(), key.size()))
+        return ERROR;
+
+    pos += key.size();
+    Byte const* nodesStart = pos;
+
+    WriteLock lock(*this);
+    if (!m_leafIdx.empty())
+        return ERROR;
+
+    if (0 == header.m_entryCount)
+        return pos == end ? SUCCESS : ERROR;
+
+    uint64_t entryCount = 0;
+    Node* root = nullptr;
+    if (!ReadSnapshotNode(pos, end, false, entryCount, &root) || pos != end || entryCount != header.m_entryCount)
+        return ERROR;
+
+    pos = nodesStart;
+    entryCount = 0;
+    ReadSnapshotNode(pos, end, true, entryCount, &root);
+
+    if (nullptr != m_root)
+        RetireNode(m_root); // the empty leaf left behind by removing every entry
+
+    m_root = root;
+    return SUCCESS;
     }
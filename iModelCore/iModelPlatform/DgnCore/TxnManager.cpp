@@ -831,7 +831,7 @@ ChangesetStatus TxnManager::MergeDdlChanges(ChangesetPropsCR revision, Changeset
 /*---------------------------------------------------------------------------------**//**
  * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ChangesetStatus TxnManager::MergeDataChanges(ChangesetPropsCR revision, ChangesetFileReader& changeStream, bool containsSchemaChanges) {
+ChangesetStatus TxnManager::MergeDataChanges(ChangesetPropsCR revision, ChangeStream& changeStream, bool containsSchemaChanges) {
     // if we don't have any pending txns, this is merely an Apply, no merging or propagation needed.
     bool mergeNeeded = HasPendingTxns() && m_initTableHandlers; // if tablehandlers are not present we can't merge - happens for schema upgrade
     Rebase rebase;
@@ -966,9 +966,10 @@ void TxnManager::ReverseChangeset(ChangesetPropsCR changeset) {
 }
 
 /*---------------------------------------------------------------------------------**/ /**
+ * throw an exception if the briefcase is not in a state where the changeset can be merged. Does not verify the content of the changeset.
  * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
-ChangesetStatus TxnManager::MergeChangeset(ChangesetPropsCR changeset) {
+void TxnManager::CheckCanMerge(ChangesetPropsCR changeset) {
     ThrowIfChangesetInProgress();
 
     if (m_dgndb.IsReadonly())
@@ -976,6 +977,13 @@ ChangesetStatus TxnManager::MergeChangeset(ChangesetPropsCR changeset) {
 
     if (HasChanges())
         m_dgndb.ThrowException("unsaved changes present", (int) ChangesetStatus::HasUncommittedChanges);
+}
+
+/*---------------------------------------------------------------------------------**/ /**
+ * @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+ChangesetStatus TxnManager::MergeChangeset(ChangesetPropsCR changeset) {
+    CheckCanMerge(changeset);
 
     changeset.ValidateContent(m_dgndb);
 
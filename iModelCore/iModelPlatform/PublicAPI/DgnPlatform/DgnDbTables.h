@@ -357,6 +357,8 @@ private:
 
     DgnModelPtr LoadDgnModel(DgnModelId modelId);
     void Empty();
+    void SaveRangeIndexSnapshots();
+    void DeleteStaleRangeIndexSnapshots();
     void AddLoadedModel(DgnModelR);
     void DropLoadedModel(DgnModelR);
 
@@ -88,6 +88,7 @@ private:
     DomainUpgradeOptions m_domainUpgradeOptions = DomainUpgradeOptions::CheckRequiredUpgrades;
     bvector<ChangesetPropsCP> m_revisions;
     RevisionProcessOption m_revisionProcessOption = RevisionProcessOption::None;
+    bool m_pipelineMerge = false;
 
 public:
     //! Default constructor
@@ -132,6 +133,13 @@ public:
     //! Get the option that controls the processing of revisions
     RevisionProcessOption GetRevisionProcessOption() const { return m_revisionProcessOption;  }
 
+    //! Merge revisions with TxnManager::MergeChangesets, verifying each changeset on a background thread while the previous one is applied.
+    //! Off by default, in which case revisions are merged one at a time with TxnManager::MergeChangeset.
+    void SetPipelineMerge(bool pipelineMerge) { m_pipelineMerge = pipelineMerge; }
+
+    //! Returns true if revisions are to be merged with TxnManager::MergeChangesets.
+    bool GetPipelineMerge() const { return m_pipelineMerge; }
+
     //! Returns true if schemas are to be upgraded from the domains.
     bool AreDomainUpgradesAllowed() const { return m_domainUpgradeOptions == DomainUpgradeOptions::Upgrade; }
 
@@ -141,6 +149,7 @@ public:
         m_domainUpgradeOptions = DomainUpgradeOptions::CheckRequiredUpgrades;
         m_revisions.clear();
         m_revisionProcessOption = RevisionProcessOption::None;
+        m_pipelineMerge = false;
         }
 };
 
@@ -3836,9 +3836,17 @@ private:
         ECSqlClassParamsCR m_params;
         ElementSelectStatement(BeSQLite::EC::CachedECSqlStatement* stmt, ECSqlClassParamsCR params) : m_statement(stmt), m_params(params) {}
     };
+    // The current row of a batch SELECT statement, from which DgnElement::_LoadFromDb reads the element with the same id.
+    struct PrefetchedRow
+    {
+        DgnElementId m_id;
+        BeSQLite::EC::ECSqlStatement& m_statement;
+        ECSqlClassParamsCR m_params;
+        PrefetchedRow(DgnElementId id, BeSQLite::EC::ECSqlStatement& stmt, ECSqlClassParamsCR params) : m_id(id), m_statement(stmt), m_params(params) {}
+    };
     typedef bmap<DgnClassId, ECSqlClassInfo> ClassInfoMap;
     typedef bmap<DgnClassId, ECSqlClassParams> T_ClassParamsMap;
-    std::unique_ptr<struct ElementMRU> m_mruCache;
+    std::unique_ptr<struct ElementCache> m_cache;
     uint64_t m_extant = 0;
     BeSQLite::StatementCache m_stmts;
     Byte m_snappyFromBuffer[BeSQLite::SnappyReader::SNAPPY_UNCOMPRESSED_BUFFER_SIZE];
@@ -3849,11 +3857,13 @@ private:
     mutable T_ClassParamsMap m_classParams; // information about custom-handled properties
     mutable AutoHandledPropertyUpdaterCache m_updaterCache;
     mutable std::map<uint64_t, std::unique_ptr<BeSQLite::EC::JsonECSqlSelectAdapter>> m_jsonSelectAdapterCache;
+    mutable PrefetchedRow const* m_prefetchedRow = nullptr;
 
     void Destroy();
     void AddToPool(DgnElementCR) const;
     DgnElementCPtr LoadElement(DgnElement::CreateParams const& params, Utf8CP jsonProps, bool makePersistent) const;
     DgnElementCPtr LoadElement(DgnElementId elementId, bool makePersistent) const;
+    void LoadElementBatch(bmap<DgnElementId, DgnElementCPtr>& loaded, bvector<DgnElementId> const& sortedIds) const;
     DgnElementCPtr PerformInsert(DgnElementR element, DgnDbStatus&);
     DgnDbStatus PerformDelete(DgnElementCR);
     explicit DgnElements(DgnDbR db);
@@ -3896,10 +3906,10 @@ public:
     DGNPLATFORM_EXPORT bool ElementExists(DgnElementId);
 
     //! Look up an element in the pool of loaded elements for this DgnDb.
-    //! @return A pointer to the element, or nullptr if the is not in the pool.
-    //! @note This method is rarely needed. You should almost always use GetElement. It will return nullptr if the element is not currently loaded. That does not mean the element doesn't exist in the database.
+    //! @return The element, or an invalid pointer if the element is not in the pool. The returned reference keeps the element alive even if it gets evicted from the pool.
+    //! @note This method is rarely needed. You should almost always use GetElement. It will return an invalid pointer if the element is not currently loaded. That does not mean the element doesn't exist in the database.
     //! @private
-    DGNPLATFORM_EXPORT DgnElementCP FindLoadedElement(DgnElementId id) const;
+    DGNPLATFORM_EXPORT DgnElementCPtr FindLoadedElement(DgnElementId id) const;
 
     //! Query the DgnModelId of the model that contains the specified element.
     DGNPLATFORM_EXPORT DgnModelId QueryModelId(DgnElementId elementId) const;
@@ -3929,6 +3939,13 @@ public:
     //! @return Invalid if the element does not exist.
     DGNPLATFORM_EXPORT DgnElementCPtr GetElement(DgnElementId id) const;
 
+    //! Get many DgnElements from this DgnDb by their DgnElementIds.
+    //! @remarks Elements that are not already loaded are read with one query per class for each batch of ids, rather than one
+    //! query per element. The loaded elements are added to the element cache.
+    //! @param[in] elementIds The ids of the elements to get. The ids need not be sorted, and may contain duplicates.
+    //! @return The elements, in the same order as elementIds. An entry is invalid if its element does not exist.
+    DGNPLATFORM_EXPORT bvector<DgnElementCPtr> LoadElements(bvector<DgnElementId> const& elementIds) const;
+
     //! Get a DgnElement by its DgnElementId, and dynamic_cast the result to a specific subclass of DgnElement.
     //! This is merely a templated shortcut to dynamic_cast the return of #GetElement to a subclass of DgnElement.
     template<class T> RefCountedCPtr<T> Get(DgnElementId id) const {return dynamic_cast<T const*>(GetElement(id).get());}
@@ -4001,15 +4018,40 @@ public:
     //! @note This method is merely a shortcut to #GetElement and then #Delete
     DgnDbStatus Delete(DgnElementId id) {auto el=GetElement(id); return el.IsValid() ? Delete(*el) : DgnDbStatus::NotFound;}
 
-    //! Set the maximum number of elements to be held by the "Most Recentley Used" element cache for this DgnDb.
-    //! @param newMax The maximum number of elements to be held in the element MRU cache. After this many elements are in memory,
-    //! the least recently used element is discarded. Set to 0 to disable MRU cache.
-    //! @note If there are currently more than newMax elements in memory, the oldest ones are removed until the size is newMax.
+    //! Set the maximum number of elements to be held by the element cache for this DgnDb. By default, the number of elements is
+    //! limited only by the memory limit of the cache.
+    //! @param newMax The maximum number of elements to be held in the element cache. After this many elements are in memory,
+    //! an element that has not been used recently is discarded. Set to 0 to disable the element cache.
+    //! @note If there are currently more than newMax elements in memory, elements are removed until the size is newMax.
+    //! While other threads are adding elements at the same time, the cache may briefly hold a few more.
+    //! @see SetCacheMemoryLimit
     DGNPLATFORM_EXPORT void SetCacheSize(uint32_t newMax);
 
-    //! Empty the Most Recentley Used element cache for this DgnDb.
+    //! Set the maximum amount of memory, in bytes, held by the elements in the element cache for this DgnDb. The size of each
+    //! element is estimated by DgnElement::GetMemorySize when it is added to the cache. The default limit is 64MB.
+    //! @note If the cached elements currently use more than maxBytes, elements that have not been used recently are removed until they fit.
+    DGNPLATFORM_EXPORT void SetCacheMemoryLimit(uint64_t maxBytes);
+
+    //! Empty the element cache for this DgnDb.
     DGNPLATFORM_EXPORT void ClearCache();
 
+    //! Counters that describe the use of the element cache of a DgnDb.
+    struct CacheStats
+    {
+        uint64_t m_hits = 0; //!< The number of lookups that found the element in the cache
+        uint64_t m_misses = 0; //!< The number of lookups that did not find the element in the cache
+        uint64_t m_evictions = 0; //!< The number of elements dropped from the cache to stay within its limits
+        uint64_t m_memoryUsed = 0; //!< The approximate number of bytes held by the cached elements
+        uint64_t m_memoryLimit = 0; //!< The maximum number of bytes held by the cached elements
+        uint32_t m_elementCount = 0; //!< The number of elements in the cache
+    };
+
+    //! Get the hit, miss and eviction counters and the current memory use of the element cache for this DgnDb.
+    DGNPLATFORM_EXPORT CacheStats GetCacheStats() const;
+
+    //! Reset the hit, miss and eviction counters of the element cache for this DgnDb.
+    DGNPLATFORM_EXPORT void ResetCacheStats();
+
     //! Find all geometric elements that reference the specified geometry part Id(s) in their geometry streams.
     //! @note This is an exhaustive search - it may take a very long time to complete.
     DGNPLATFORM_EXPORT DgnElementIdSet FindGeometryPartReferences(BeSQLite::IdSet<DgnGeometryPartId> const& partIds, bool is2d) const;
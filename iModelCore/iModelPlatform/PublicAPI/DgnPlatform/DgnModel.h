@@ -885,12 +885,15 @@ public:
 
 protected:
     mutable std::unique_ptr<RangeIndex::Tree> m_rangeIndex;
+    mutable Utf8String m_rangeIndexSnapshotKey; // the key of the snapshot file the range index was loaded from or last saved to
     Formatter m_displayInfo;
 
     DGNPLATFORM_EXPORT void AddToRangeIndex(DgnElementCR);
     DGNPLATFORM_EXPORT void UpdateRangeIndex(DgnElementCR modified, DgnElementCR original);
 
     virtual DgnDbStatus _FillRangeIndex() = 0;//!< @private
+    DGNPLATFORM_EXPORT bool LoadRangeIndexSnapshot(); //!< @private
+    DGNPLATFORM_EXPORT Utf8String GetRangeIndexSnapshotKey() const; //!< @private
     DGNPLATFORM_EXPORT virtual AxisAlignedBox3d _QueryElementsRange() const;//!< @private
     virtual AxisAlignedBox3d _QueryNonElementModelRange() const { return AxisAlignedBox3d(DRange3d::NullRange()); }
 
@@ -920,6 +923,16 @@ public:
 
     RangeIndex::Tree* GetRangeIndex() const {return m_rangeIndex.get();}
 
+    //! Get the name of the file, next to the DgnDb, that holds the snapshot of the range index of this model.
+    DGNPLATFORM_EXPORT BeFileName GetRangeIndexSnapshotFileName() const;
+
+    //! Save the range index of this model to a snapshot file, so that FillRangeIndex can load it rather than rebuild it the next time this
+    //! model is opened. A snapshot is tied to the parent changeset of the briefcase and is only saved and used when the briefcase has no local changes.
+    //! The DgnDb saves the snapshots of all loaded models when it is closed or checkpointed.
+    //! @return SUCCESS if the snapshot was saved or is already up to date. ERROR if the range index has not been filled, the briefcase has local changes,
+    //! or the file could not be written.
+    DGNPLATFORM_EXPORT BentleyStatus SaveRangeIndexSnapshot() const;
+
     //! Get the AxisAlignedBox3d of the contents of this model.
     AxisAlignedBox3d QueryElementsRange() const {return _QueryElementsRange();}
 
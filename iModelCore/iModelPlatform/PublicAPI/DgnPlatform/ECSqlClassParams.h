@@ -31,6 +31,7 @@ private:
     friend struct DgnElements;
 
     Utf8String  m_select;
+    Utf8String  m_selectBatch;
     Utf8String  m_selectEcProps; // lazy-initialized by DgnElements::GetSelectEcPropsECSql using its mutex
     Utf8String  m_insert;
     Utf8String  m_update;
@@ -46,6 +47,8 @@ public:
     //! @private
     Utf8StringCR GetSelectECSql() const { return m_select; }
     //! @private
+    Utf8StringCR GetBatchSelectECSql() const { return m_selectBatch; }
+    //! @private
     Utf8StringCR GetInsertECSql() const { return m_insert; }
     //! @private
     Utf8StringCR GetUpdateECSql() const { return m_update; }
@@ -53,6 +56,8 @@ public:
     //! @private
     BeSQLite::EC::CachedECSqlStatementPtr GetSelectStmt(DgnDbCR dgndb, BeSQLite::EC::ECInstanceId instanceId) const;
     //! @private
+    BeSQLite::EC::CachedECSqlStatementPtr GetBatchSelectStmt(DgnDbCR dgndb, std::shared_ptr<BeSQLite::VirtualSet> instanceIds, BeSQLite::EC::ECInstanceId firstId, BeSQLite::EC::ECInstanceId lastId) const;
+    //! @private
     BeSQLite::EC::CachedECSqlStatementPtr GetInsertStmt(DgnDbCR dgndb) const;
     //! @private
     BeSQLite::EC::CachedECSqlStatementPtr GetUpdateStmt(DgnDbCR dgndb, BeSQLite::EC::ECInstanceId instanceId) const;
@@ -121,7 +126,7 @@ private:
     Entries const& GetEntries() const { return m_entries; }
     uint16_t BuildInsertECSql(Utf8StringR ecsql, DgnDbCR dgndb, ECN::ECClassCR ecclass) const; // Build INSERT ECSql returning the number of INSERT params
     uint16_t BuildUpdateECSql(Utf8StringR ecsql, DgnDbCR dgndb, ECN::ECClassCR ecclass) const; // Build UPDATE ECSql returning the number of UPDATE params
-    uint16_t BuildSelectECSql(Utf8StringR ecsql, DgnDbCR dgndb, ECN::ECClassCR ecclass) const; // BUILD SELECT ECSql returning the number of SELECT params
+    uint16_t BuildSelectECSql(Utf8StringR ecsql, DgnDbCR dgndb, ECN::ECClassCR ecclass, bool batch = false) const; // BUILD SELECT ECSql returning the number of SELECT params. A batch SELECT appends the ECInstanceId column.
 
     static void AppendClassName(Utf8StringR className, DgnDbCR db, ECN::ECClassCR ecclass);
 public:
@@ -5,6 +5,9 @@
 #pragma once
 
 #include <PlacementOnEarth/Placement.h>
+#include <Bentley/Nullable.h>
+#include <atomic>
+#include <deque>
 
 BEGIN_BENTLEY_DGN_NAMESPACE
 
@@ -114,7 +117,25 @@ public:
         }
 };
 
+//=======================================================================================
+//! A single-precision plane for filtering the entries of a RangeIndex. Points for which a*x + b*y + c*z + d >= 0
+//! are on the inside of the plane. The constant term is rounded up so that the plane is never tighter than the
+//! double-precision plane it was made from.
+// @bsiclass
+//=======================================================================================
+struct FPlane
+{
+    float m_a;
+    float m_b;
+    float m_c;
+    float m_d;
+
+    FPlane() : m_a(0), m_b(0), m_c(0), m_d(0) {}
+    FPlane(double a, double b, double c, double d) : m_a((float) a), m_b((float) b), m_c((float) c), m_d(FBox::RoundUp(d)) {}
+};
+
 DEFINE_POINTER_SUFFIX_TYPEDEFS(FBox);
+DEFINE_POINTER_SUFFIX_TYPEDEFS(FPlane);
 DEFINE_POINTER_SUFFIX_TYPEDEFS(Entry);
 DEFINE_POINTER_SUFFIX_TYPEDEFS(Tree);
 
@@ -136,6 +157,7 @@ struct Entry
 struct Traverser
 {
     virtual ~Traverser() {}
+    //! @private Readers traverse a consistent snapshot of the tree and are never asked to yield to a writer, so this is no longer consulted.
     virtual bool _AbortOnWriteRequest() const {return true;}
 
     enum class Accept : bool {Yes=1, No=0,};
@@ -143,6 +165,14 @@ struct Traverser
 
     enum class Stop {No= 0, Yes= 1,};
     virtual Stop _VisitRangeTreeEntry(EntryCR) = 0;
+
+    //! Return a box that an entry must overlap to be of interest, or nullptr to visit every entry of an accepted node.
+    //! When supplied, the entries of each leaf are tested against it several at a time and only those that overlap it are visited.
+    virtual FBoxCP _GetEntryFilterBox() const {return nullptr;}
+
+    //! Return planes (e.g. of a view frustum) that an entry must not lie entirely outside of to be of interest, or nullptr.
+    //! When supplied, the entries of each leaf are tested against them several at a time and only those that pass are visited.
+    virtual FPlaneCP _GetEntryFilterPlanes(size_t& nPlanes) const {nPlanes = 0; return nullptr;}
 };
 
 //=======================================================================================
@@ -154,27 +184,31 @@ struct Tree
     struct LeafNode;
 
     //=======================================================================================
-    //! On construction block until no write active. Then hold read lock until destruction.
+    //! Pin the most recently published version of the tree until destruction. This never blocks: writers
+    //! copy the nodes they change rather than modifying them in place, and only free the nodes they
+    //! replaced once every reader that could still be looking at them has released its pin.
     //! Note that there can be more than one simultaneous readers.
     // @bsiclass
     //=======================================================================================
     struct ReadLock
     {
         TreeCR m_tree;
-        ReadLock(TreeCR tree) : m_tree(tree) {BeMutexHolder holder(tree.m_cv.GetMutex()); while (tree.m_writeActive) tree.m_cv.InfiniteWait(holder); ++tree.m_readers;}
-        ~ReadLock() {{BeMutexHolder holder(m_tree.m_cv.GetMutex()); --m_tree.m_readers; BeAssert(m_tree.m_readers>=0);} m_tree.m_cv.notify_all();}
+        uint32_t m_epoch;
+        ReadLock(TreeCR tree) : m_tree(tree) {m_epoch = tree.PinEpoch();}
+        ~ReadLock() {m_tree.UnpinEpoch(m_epoch);}
     };
 
     //=======================================================================================
-    //! On construction block until no readers. Then hold write lock until destruction.
-    //! There can only be one writer.
+    //! Serialize writers until destruction. Readers never wait for a writer; the changes made while the
+    //! outermost WriteLock is held become visible to new readers all at once when it is released.
+    //! WriteLocks may be nested on the same thread, which is how a batch of changes is published together.
     // @bsiclass
     //=======================================================================================
     struct WriteLock
     {
         TreeR m_tree;
-        WriteLock(TreeR tree) : m_tree(tree) {BeMutexHolder holder(tree.m_cv.GetMutex()); while (tree.m_readers>0){tree.m_writeRequest=true; tree.m_cv.InfiniteWait(holder);} tree.m_writeRequest=false; BeAssert(!tree.m_writeActive); tree.m_writeActive=true;}
-        ~WriteLock() {{BeMutexHolder holder(m_tree.m_cv.GetMutex()); BeAssert(m_tree.m_writeActive); m_tree.m_writeActive=false; } m_tree.m_cv.notify_all();}
+        WriteLock(TreeR tree) : m_tree(tree) {m_tree.BeginWrite();}
+        ~WriteLock() {m_tree.EndWrite();}
     };
 
     //=======================================================================================
@@ -187,12 +221,16 @@ struct Tree
     protected:
         FBox m_nodeRange;
         InternalNode* m_parent;
+        uint64_t m_version = 0;    // the write in which this node was created. Nodes from earlier writes may be visible to readers and are never modified.
         NodeType m_type;
         bool m_is3d;
 
     public:
         Node(NodeType type, bool is3d) : m_type(type), m_is3d(is3d), m_parent(nullptr) {ClearRange();}
         void SetParent(InternalNode* parent) {m_parent = parent;}
+        InternalNode* GetParent() const {return m_parent;}
+        uint64_t GetVersion() const {return m_version;}
+        void SetVersion(uint64_t version) {m_version = version;}
         LeafNode* ToLeaf() const {return m_type != NodeType::Internal ? (LeafNode*)const_cast<Node*>(this) : nullptr;}
         bool IsLeaf() const {return nullptr != ToLeaf();}
         void ClearRange() {m_nodeRange.Invalidate();}
@@ -208,6 +246,25 @@ struct Tree
     //=======================================================================================
     struct LeafNode : Node
     {
+        static const size_t MAX_ENTRIES = 24;  // leaf size (at most 20) plus the entry that causes a split, rounded up to a multiple of 8
+
+        //! The ranges of the entries, stored as structure-of-arrays so that they can be tested against a filter several at a time.
+        struct Bounds
+        {
+            float m_lowX[MAX_ENTRIES];
+            float m_lowY[MAX_ENTRIES];
+            float m_lowZ[MAX_ENTRIES];
+            float m_highX[MAX_ENTRIES];
+            float m_highY[MAX_ENTRIES];
+            float m_highZ[MAX_ENTRIES];
+
+            void Set(size_t index, FBoxCR range);
+            void Move(size_t to, size_t from, size_t count);
+            uint32_t Overlaps(size_t count, FBoxCR range, bool is3d) const;
+            uint32_t Inside(size_t count, FPlaneCP planes, size_t nPlanes, bool is3d) const;
+        };
+
+        Bounds m_bounds;
         Entry* m_endChild;
         Entry m_firstChild[1];
 
@@ -219,6 +276,8 @@ struct Tree
         bool DropElement(DgnElementId, TreeR);
         size_t GetEntryCount() const {return m_endChild - m_firstChild;}
         EntryCP FindElement(DgnElementId) const;
+        LeafNode* CloneLeaf(TreeR) const;
+        uint32_t FilterEntries(Traverser const&, bool is3d) const;
         Traverser::Stop Traverse(Traverser&, TreeCR tree, bool is3d);
     };
 
@@ -237,6 +296,8 @@ struct Tree
         void SplitInternalNode(TreeR);
         void DropRange(FBoxCR range);
         void DropNode(Node* child, TreeR root);
+        void ReplaceChild(Node* oldChild, Node* newChild);
+        InternalNode* CloneInternal(TreeR) const;
         void ValidateInternalRange();
         size_t GetEntryCount() const {return m_endChild - m_firstChild;}
         void ClearChildren() {m_endChild = m_firstChild; ClearRange();}
@@ -249,55 +310,90 @@ private:
     friend struct LeafNode;
     typedef bmap<DgnElementId,LeafNode*> LeafIdx;
 
+    struct RetiredNode
+    {
+        Node* m_node;
+        uint32_t m_epoch;   // the reader epoch in which the node was replaced
+    };
+
     DgnMemoryPool<LeafNode,128> m_leafNodes;
     DgnMemoryPool<InternalNode,512> m_internalNodes;
     LeafIdx m_leafIdx;      // map to the leaf holding each entry
-    Node* m_root = nullptr;
+    Node* m_root = nullptr; // the root as seen by the writer
+    std::atomic<Node*> m_readRoot;  // the root as of the last completed write, as seen by readers
     bool m_is3d;
-    bool m_writeActive = false;
-    bool m_writeRequest = false;
-    mutable int m_readers = 0;
+    int m_writeDepth = 0;
+    uint64_t m_writeVersion = 0;
+    mutable std::atomic<uint32_t> m_epoch;
+    mutable std::atomic<int32_t> m_readers[2];  // pinned readers, indexed by the parity of the epoch they pinned
+    std::deque<RetiredNode> m_retired;          // nodes replaced by a writer that readers may still be using, oldest first
     size_t m_internalNodeSize;
     size_t m_leafNodeSize;
-    mutable BentleyApi::BeConditionVariable m_cv;
+    mutable BeMutex m_writeMutex;
 
-    InternalNode* AllocateInternalNode() {return new (m_internalNodes.AllocateNode()) InternalNode(m_is3d);}
-    LeafNode* AllocateLeafNode() {return new (m_leafNodes.AllocateNode()) LeafNode(m_is3d);}
+    InternalNode* AllocateInternalNode() {auto node = new (m_internalNodes.AllocateNode()) InternalNode(m_is3d); node->SetVersion(m_writeVersion); return node;}
+    LeafNode* AllocateLeafNode() {auto node = new (m_leafNodes.AllocateNode()) LeafNode(m_is3d); node->SetVersion(m_writeVersion); return node;}
     void FreeInternalNode(InternalNode* node) {m_internalNodes.FreeNode(node);}
     void FreeLeafNode(LeafNode* node) {m_leafNodes.FreeNode(node);}
+    void FreeNode(Node* node) {if (node->IsLeaf()) FreeLeafNode(node->ToLeaf()); else FreeInternalNode((InternalNode*) node);}
+
+    uint32_t PinEpoch() const;
+    void UnpinEpoch(uint32_t epoch) const;
+    void BeginWrite();
+    void EndWrite();
+    Node* MakeWritable(Node* node);
+    void RetireNode(Node* node);
+    void ReclaimNodes();
+    void WriteSnapshotNode(bvector<Byte>& buffer, Node* node, uint64_t& entryCount) const;
+    bool ReadSnapshotNode(Byte const*& pos, Byte const* end, bool build, uint64_t& entryCount, Node** node);
 
 public:
     size_t DebugElementCount() const {return m_root ? ((InternalNode*) m_root)->GetElementCount() : 0;} //! @private
     size_t DebugAllocation() const {return m_leafNodes.GetMemoryAllocated() + m_internalNodes.GetMemoryAllocated();} //! @private
 
-    FBox GetExtents() {return m_root ? m_root->GetRange() : FBox();}
+    FBox GetExtents() const {ReadLock lock(*this); Node* root = m_readRoot.load(); return root ? root->GetRange() : FBox();}
     DGNPLATFORM_EXPORT Tree(bool is3d, size_t leafSize);
     Node* GetRoot(){return m_root;}
     size_t GetInternalNodeSize() {return m_internalNodeSize;}
     size_t GetLeafNodeSize() {return m_leafNodeSize;}
     void SetNodeSizes(size_t internalNodeSize, size_t leafNodeSize);
     bool Is3d() const {return m_is3d;}
-    size_t GetCount() const {return m_leafIdx.size();}
+    //! Get the number of elements in the index. Like FindElement, this waits for any active writer to finish.
+    size_t GetCount() const {BeMutexHolder lock(m_writeMutex); return m_leafIdx.size();}
 
+    //=======================================================================================
+    //! Iterates the elements in the index by id. The id index is only maintained for writers and is not protected
+    //! by ReadLock, so iteration must only be done while holding a WriteLock on the tree, or on the only thread that modifies it.
+    // @bsiclass
+    //=======================================================================================
     struct Iterator :  LeafIdx::const_iterator
     {
         Iterator(LeafIdx::const_iterator it) : LeafIdx::const_iterator(it) {}
         DgnElementId GetElementId(){return (*this)->first;}
-        EntryCP GetEntry(){return (*this)->second->FindElement((*this)->first);}
+        Nullable<Entry> GetEntry() {EntryCP entry = (*this)->second->FindElement((*this)->first); return entry ? Nullable<Entry>(*entry) : nullptr;}
     };
 
     typedef Iterator const_iterator;
+    //! @note Only call while holding a WriteLock, or on the only thread that modifies the tree. See Iterator.
     const_iterator begin() const {return m_leafIdx.begin();}
+    //! @note Only call while holding a WriteLock, or on the only thread that modifies the tree. See Iterator.
     const_iterator end() const {return m_leafIdx.end();}
 
     DGNPLATFORM_EXPORT Traverser::Stop Traverse(Traverser&);
 
     DGNPLATFORM_EXPORT void AddEntry(Entry const&);
 
+    //! Add many entries to an empty range index at once. The entries are ordered by Sort-Tile-Recursive packing and the tree is built
+    //! bottom-up from full nodes, which is much faster than adding them one at a time and produces a tree whose nodes overlap less.
+    //! If the index is not empty, the entries are added one at a time.
+    //! @param[in] entries The entries to add. Their order is changed by this method. Entries with invalid ranges are ignored.
+    DGNPLATFORM_EXPORT void LoadEntries(bvector<Entry>& entries);
+
     //! Find an element in the range index and return the Entry information.
+    //! @note Unlike Traverse, this waits for any active writer to finish.
     //! @param[in] id The id of the element to find
-    //! @return the Entry for the specified element. Will be nullptr if the element is not in the index.
-    DGNPLATFORM_EXPORT EntryCP FindElement(DgnElementId id) const;
+    //! @return a copy of the Entry for the specified element, since the leaf holding it may be retired as soon as the lock is released. Will be null if the element is not in the index.
+    DGNPLATFORM_EXPORT Nullable<Entry> FindElement(DgnElementId id) const;
 
     //! Add a new geometric element into the range index.
     //! @param[in] geom the element to add to the range index.
@@ -310,6 +406,24 @@ public:
             }
         }
 
+    //! Write the contents of this range index to a snapshot file that LoadSnapshot can read much faster than the index can be rebuilt.
+    //! The snapshot is written to a temporary file that is then renamed, so a partially written snapshot is never seen.
+    //! @param[in] fileName The name of the snapshot file
+    //! @param[in] key Identifies the state of the data from which this index was built. LoadSnapshot rejects a snapshot with a different key.
+    //! @return SUCCESS if the snapshot was written.
+    DGNPLATFORM_EXPORT BentleyStatus SaveSnapshot(BeFileNameCR fileName, Utf8StringCR key) const;
+
+    //! Fill an empty range index from a snapshot file written by SaveSnapshot.
+    //! @param[in] fileName The name of the snapshot file
+    //! @param[in] key Identifies the state of the data from which this index should have been built.
+    //! @return SUCCESS if the index was loaded. ERROR if the index is not empty, or the file does not exist, is not a valid snapshot,
+    //! was written for different node sizes or dimensions, or has a different key. The index is unchanged on error.
+    DGNPLATFORM_EXPORT BentleyStatus LoadSnapshot(BeFileNameCR fileName, Utf8StringCR key);
+
+    //! Get the key a snapshot file was written with, without reading the rest of the file.
+    //! @return The key, or an empty string if the file does not exist or is not a snapshot in the current format.
+    DGNPLATFORM_EXPORT static Utf8String ReadSnapshotKey(BeFileNameCR fileName);
+
     //! Remove an element from the range index.
     //! @param[in] id The id of the element to remove
     //! @return SUCCESS if the element was removed. ERROR if the the id was not in the range index.
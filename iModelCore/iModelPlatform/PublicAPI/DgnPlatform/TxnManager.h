@@ -470,10 +470,11 @@ private:
     DgnDbStatus ReinstateActions(TxnRange const& revTxn);
 
     void ClearSavedChangesetValues();
-    void WriteChangesToFile(BeFileNameCR pathname, BeSQLite::DdlChangesCR ddlChanges, BeSQLite::ChangeGroupCR dataChangeGroup, BeSQLite::Rebaser*);
+    void WriteChangesToFile(BeFileNameCR pathname, BeSQLite::DdlChangesCR ddlChanges, BeSQLite::ChangeGroupCR dataChangeGroup, BeSQLite::Rebaser*, BeSQLite::ChangesetFileFormat format);
     ChangesetStatus MergeDdlChanges(ChangesetPropsCR revision, ChangesetFileReader& revisionReader);
-    ChangesetStatus MergeDataChanges(ChangesetPropsCR revision, ChangesetFileReader& revisionReader, bool containsSchemaChanges);
-    ChangesetStatus ProcessRevisions(bvector<ChangesetPropsCP> const &revisions, RevisionProcessOption processOptions);
+    ChangesetStatus MergeDataChanges(ChangesetPropsCR revision, BeSQLite::ChangeStream& revisionStream, bool containsSchemaChanges);
+    void CheckCanMerge(ChangesetPropsCR revision);
+    ChangesetStatus ProcessRevisions(bvector<ChangesetPropsCP> const &revisions, RevisionProcessOption processOptions, bool pipelineMerge = false);
 
     TxnTable* FindTxnTable(Utf8CP tableName) const;
     bool IsMultiTxnMember(TxnId rowid) const;
@@ -484,16 +485,35 @@ private:
     void ThrowIfChangesetInProgress();
 
 public:
+    //! The number of changesets merged by MergeChangesets and the time spent in each phase, in seconds.
+    struct MergeTimings
+    {
+        uint32_t m_changesets = 0; //!< The number of changesets merged
+        double m_prepare = 0; //!< Reading and verifying the changesets. Done on a background thread while the previous changeset is applied.
+        double m_wait = 0; //!< Waiting for the next changeset to be prepared
+        double m_schema = 0; //!< Applying DDL changes
+        double m_apply = 0; //!< Applying data changes, including propagating indirect changes, notifying monitors and saving
+    };
+
     void StartNewSession();
     void CallJsTxnManager(Utf8CP methodName) { DgnDb::CallJsFunction(m_dgndb.GetJsTxns(), methodName, {}); };
 
     bool IsChangesetInProgress() const { return m_changesetInProgress.IsValid(); }
     DGNPLATFORM_EXPORT Utf8String GetParentChangesetId() const;
     DGNPLATFORM_EXPORT void GetParentChangesetIndex(int32_t& index, Utf8StringR id) const;
-    DGNPLATFORM_EXPORT ChangesetPropsPtr StartCreateChangeset(Utf8CP extension = nullptr);
+    //! Write the pending Txns to a new changeset file.
+    //! @param[in] extension Appended to the file name, so tests can keep more than one changeset.
+    //! @param[in] format The format of the file. Only SingleStream can be read by versions that predate the block formats.
+    DGNPLATFORM_EXPORT ChangesetPropsPtr StartCreateChangeset(Utf8CP extension = nullptr, BeSQLite::ChangesetFileFormat format = BeSQLite::ChangesetFileFormat::SingleStream);
     DGNPLATFORM_EXPORT void FinishCreateChangeset(int32_t changesetIndex, bool keepFile = false);
     DGNPLATFORM_EXPORT void StopCreateChangeset(bool keepFile);
     DGNPLATFORM_EXPORT ChangesetStatus MergeChangeset(ChangesetPropsCR revision);
+    //! Merge a sequence of changesets, in order. While each changeset is applied, the next one is verified (its id and schema
+    //! changes read) on a background thread. Both threads stream the changeset files, so memory use does not grow with changeset size.
+    //! Stops at the first changeset that fails to merge.
+    //! @param[in] revisions The changesets to merge. The first one must be the child of the current parent changeset.
+    //! @param[out] timings If not nullptr, receives the time spent in each phase.
+    DGNPLATFORM_EXPORT ChangesetStatus MergeChangesets(bvector<ChangesetPropsCP> const& revisions, MergeTimings* timings = nullptr);
     DGNPLATFORM_EXPORT void ReverseChangeset(ChangesetPropsCR revision);
     void SaveParentChangeset(Utf8StringCR revisionId, int32_t changesetIndex);
     ChangesetPropsPtr CreateChangesetProps(BeFileNameCR pathName);
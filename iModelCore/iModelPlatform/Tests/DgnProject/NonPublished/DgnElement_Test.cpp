@@ -557,7 +557,7 @@ TEST_F(DgnElementTests, GetSetAutoHandledProperties)
         // Update the element
         DgnDbStatus stat = editEl->Update();
         ASSERT_EQ(DgnDbStatus::Success, stat);
-        ASSERT_TRUE(nullptr == m_db->Elements().FindLoadedElement(editEl->GetElementId())); // after update, element should not be in MRU cache.
+        ASSERT_TRUE(m_db->Elements().FindLoadedElement(editEl->GetElementId()).IsNull()); // after update, element should not be in MRU cache.
         m_db->SaveChanges();
         }
 
@@ -1815,6 +1815,158 @@ TEST_F(DgnElementTests, SimpleInsert)
     ASSERT_TRUE(informationRecord->Insert().IsValid()) << "InformationRecordElements should be able to be inserted into an InformationRecordModel";
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DgnElementTests, ElementCacheMemoryLimit)
+    {
+    SetupSeedProject();
+    PhysicalModelPtr model = DgnDbTestUtils::InsertPhysicalModel(*m_db, "TestModel");
+    DgnCategoryId categoryId = DgnDbTestUtils::InsertSpatialCategory(*m_db, "TestCategory");
+
+    bvector<DgnElementId> elementIds;
+    for (int i = 0; i < 50; ++i)
+        {
+        GenericPhysicalObjectPtr element = GenericPhysicalObject::Create(*model, categoryId);
+        ASSERT_TRUE(element->Insert().IsValid());
+        elementIds.push_back(element->GetElementId());
+        }
+
+    DgnElements& elements = m_db->Elements();
+    elements.ClearCache();
+    elements.ResetCacheStats();
+    DgnElements::CacheStats stats = elements.GetCacheStats();
+    EXPECT_EQ(0, stats.m_hits);
+    EXPECT_EQ(0, stats.m_misses);
+    EXPECT_EQ(0, stats.m_elementCount);
+    EXPECT_EQ(0, stats.m_memoryUsed);
+
+    // the first lookup of each element misses and loads it into the cache
+    for (auto elementId : elementIds)
+        ASSERT_TRUE(elements.GetElement(elementId).IsValid());
+
+    stats = elements.GetCacheStats();
+    EXPECT_GE(stats.m_misses, elementIds.size());
+    EXPECT_GE(stats.m_elementCount, elementIds.size());
+    EXPECT_GT(stats.m_memoryUsed, 0);
+    EXPECT_LE(stats.m_memoryUsed, stats.m_memoryLimit);
+
+    // the second lookup finds each element in the cache
+    uint64_t hits = stats.m_hits;
+    for (auto elementId : elementIds)
+        EXPECT_TRUE(elements.FindLoadedElement(elementId).IsValid());
+
+    stats = elements.GetCacheStats();
+    EXPECT_EQ(hits + elementIds.size(), stats.m_hits);
+
+    // lowering the memory limit evicts elements until the rest fit
+    uint64_t memoryLimit = stats.m_memoryUsed / 4;
+    elements.SetCacheMemoryLimit(memoryLimit);
+    stats = elements.GetCacheStats();
+    EXPECT_GT(stats.m_evictions, 0);
+    EXPECT_LE(stats.m_memoryUsed, memoryLimit);
+    EXPECT_LT(stats.m_elementCount, elementIds.size());
+
+    // evicted elements are loaded again on request
+    for (auto elementId : elementIds)
+        EXPECT_TRUE(elements.GetElement(elementId).IsValid());
+
+    EXPECT_LE(elements.GetCacheStats().m_memoryUsed, memoryLimit);
+
+    // the count limit applies to the whole cache, even when it is smaller than the number of shards
+    elements.SetCacheMemoryLimit(64 * 1024 * 1024);
+    elements.SetCacheSize(3);
+    EXPECT_LE(elements.GetCacheStats().m_elementCount, 3);
+    for (auto elementId : elementIds)
+        EXPECT_TRUE(elements.GetElement(elementId).IsValid());
+
+    EXPECT_EQ(3, elements.GetCacheStats().m_elementCount);
+
+    // a cache size of 0 disables the cache
+    elements.SetCacheSize(0);
+    EXPECT_EQ(0, elements.GetCacheStats().m_elementCount);
+    EXPECT_TRUE(elements.GetElement(elementIds.front()).IsValid());
+    EXPECT_TRUE(elements.FindLoadedElement(elementIds.front()).IsNull());
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DgnElementTests, LoadElements)
+    {
+    SetupSeedProject();
+    PhysicalModelPtr model = DgnDbTestUtils::InsertPhysicalModel(*m_db, "TestModel");
+    DgnCategoryId categoryId = DgnDbTestUtils::InsertSpatialCategory(*m_db, "TestCategory");
+
+    bvector<DgnElementId> elementIds;
+    for (int i = 0; i < 20; ++i)
+        {
+        TestElementPtr testElement = TestElement::Create(*m_db, model->GetModelId(), categoryId);
+        testElement->SetUserLabel(Utf8PrintfString("Element %d", i).c_str());
+        ASSERT_TRUE(testElement->Insert().IsValid());
+        elementIds.push_back(testElement->GetElementId());
+
+        GenericPhysicalObjectPtr physicalObject = GenericPhysicalObject::Create(*model, categoryId);
+        ASSERT_TRUE(physicalObject->Insert().IsValid());
+        elementIds.push_back(physicalObject->GetElementId());
+        }
+    m_db->SaveChanges();
+
+    // request the elements out of order, with a duplicate, an invalid id, an id that does not exist, and an element of another model
+    bvector<DgnElementId> requestIds(elementIds.rbegin(), elementIds.rend());
+    requestIds.push_back(elementIds[3]);
+    requestIds.push_back(DgnElementId());
+    requestIds.push_back(DgnElementId((uint64_t) 0xffffffff));
+    requestIds.push_back(m_db->Elements().GetRootSubjectId());
+
+    m_db->Elements().ClearCache();
+    DgnElementCPtr alreadyLoaded = m_db->Elements().GetElement(elementIds[5]);
+
+    bvector<DgnElementCPtr> elements = m_db->Elements().LoadElements(requestIds);
+    ASSERT_EQ(requestIds.size(), elements.size());
+    for (size_t i = 0; i < requestIds.size(); ++i)
+        {
+        if (!requestIds[i].IsValid() || 0xffffffff == requestIds[i].GetValue())
+            {
+            EXPECT_FALSE(elements[i].IsValid());
+            continue;
+            }
+
+        ASSERT_TRUE(elements[i].IsValid());
+        EXPECT_EQ(requestIds[i], elements[i]->GetElementId());
+        EXPECT_EQ(elements[i].get(), m_db->Elements().FindLoadedElement(requestIds[i]).get()) << "LoadElements should fill the element cache";
+        }
+
+    EXPECT_EQ(elements[0].get(), m_db->Elements().FindLoadedElement(elementIds.back()).get());
+    EXPECT_EQ(alreadyLoaded.get(), m_db->Elements().FindLoadedElement(elementIds[5]).get()) << "LoadElements should not reload an element that is already loaded";
+
+    // the elements must match the elements loaded one at a time
+    m_db->Elements().ClearCache();
+    for (size_t i = 0; i < requestIds.size(); ++i)
+        {
+        if (!elements[i].IsValid())
+            continue;
+
+        DgnElementCPtr single = m_db->Elements().GetElement(requestIds[i]);
+        ASSERT_TRUE(single.IsValid());
+        EXPECT_EQ(single->GetElementClassId(), elements[i]->GetElementClassId());
+        EXPECT_EQ(single->GetModelId(), elements[i]->GetModelId());
+        EXPECT_TRUE(single->GetCode() == elements[i]->GetCode());
+        EXPECT_STREQ(single->GetUserLabel(), elements[i]->GetUserLabel());
+        EXPECT_EQ(single->GetFederationGuid(), elements[i]->GetFederationGuid());
+
+        GeometrySource3dCP singleGeom = single->ToGeometrySource3d();
+        GeometrySource3dCP batchGeom = elements[i]->ToGeometrySource3d();
+        ASSERT_EQ(nullptr == singleGeom, nullptr == batchGeom);
+        if (nullptr == singleGeom)
+            continue;
+
+        EXPECT_EQ(singleGeom->GetCategoryId(), batchGeom->GetCategoryId());
+        EXPECT_EQ(singleGeom->GetGeometryStream().GetSize(), batchGeom->GetGeometryStream().GetSize());
+        EXPECT_TRUE(singleGeom->GetPlacement().GetElementBox().IsEqual(batchGeom->GetPlacement().GetElementBox()));
+        }
+    }
+
 /*---------------------------------------------------------------------------------**//**
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
@@ -87,7 +87,7 @@ void DgnModelTests::TestRangeIndex3d()
     int count = 0;
     for (auto& el : model->MakeIterator())
         {
-        EXPECT_TRUE(nullptr != rangeIndex->FindElement(el.GetElementId()));
+        EXPECT_TRUE(rangeIndex->FindElement(el.GetElementId()).IsValid());
         ++count;
         }
     EXPECT_TRUE(count == 4);
@@ -103,7 +103,7 @@ void DgnModelTests::TestRangeIndex3d()
     count = 0;
     for (auto& el : model->MakeIterator())
         {
-        EXPECT_TRUE(nullptr != rangeIndex->FindElement(el.GetElementId()));
+        EXPECT_TRUE(rangeIndex->FindElement(el.GetElementId()).IsValid());
         ++count;
         }
 
@@ -139,7 +139,7 @@ void DgnModelTests::TestRangeIndex3d()
     EXPECT_TRUE(indexbox.IsEqual(AxisAlignedBox3d(pt1,pt2), .00001));
 
     EXPECT_TRUE(DgnDbStatus::Success == el2->Delete());  // deleting the element should remove it from the range index
-    EXPECT_TRUE(nullptr == rangeIndex->FindElement(id1));
+    EXPECT_TRUE(rangeIndex->FindElement(id1).IsNull());
     indexbox = AxisAlignedBox3d(rangeIndex->GetExtents().ToRange3d()); // and the new extent of the model should be back to what it was before we added the large element
     EXPECT_TRUE(indexbox.IsEqual(queryRange, .00001));
     }
@@ -190,7 +190,7 @@ void DgnModelTests::TestRangeIndex2d()
     int count = 0;
     for (auto& el : drawingModel->MakeIterator())
         {
-        EXPECT_TRUE(nullptr != rangeIndex->FindElement(el.GetElementId()));
+        EXPECT_TRUE(rangeIndex->FindElement(el.GetElementId()).IsValid());
         ++count;
         }
     EXPECT_TRUE(count == 4);
@@ -223,6 +223,59 @@ TEST_F(DgnModelTests, RangeIndex)
     CheckEmptyModel();
     }
 
+/*---------------------------------------------------------------------------------**//**
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+TEST_F(DgnModelTests, RangeIndexSnapshot)
+    {
+    SetupSeedProject(BeSQLite::Db::OpenMode::ReadWrite, true);
+    DgnModelId modelId = m_defaultModelId;
+    for (int i = 0; i < 3; ++i)
+        EXPECT_TRUE(InsertElement(modelId).IsValid());
+
+    m_db->SaveChanges();
+    m_db->Txns().DeleteAllTxns(); // snapshots are only saved without local changes
+
+    auto model = m_db->Models().Get<GeometricModel>(modelId);
+    ASSERT_TRUE(model.IsValid());
+    ASSERT_EQ(DgnDbStatus::Success, model->FillRangeIndex());
+    BeFileName snapshotFile = model->GetRangeIndexSnapshotFileName();
+    BeFileName dbFileName = m_db->GetFileName();
+    BeFileName::BeDeleteFile(snapshotFile.c_str());
+    model = nullptr;
+
+    // closing the db saves the snapshot of a loaded range index.
+    CloseDb();
+    ASSERT_TRUE(snapshotFile.DoesPathExist());
+    ASSERT_FALSE(RangeIndex::Tree::ReadSnapshotKey(snapshotFile).empty());
+
+    // a snapshot that does not belong to an existing model is deleted when the db is opened.
+    BeFileName orphanFile(dbFileName);
+    orphanFile.AppendUtf8(".0xffffff.rangeindex");
+    ASSERT_EQ(BeFileNameStatus::Success, BeFileName::BeCopyFile(snapshotFile, orphanFile));
+
+    OpenDb(m_db, dbFileName, BeSQLite::Db::OpenMode::ReadWrite, true);
+    ASSERT_TRUE(snapshotFile.DoesPathExist());
+    ASSERT_FALSE(orphanFile.DoesPathExist());
+
+    model = m_db->Models().Get<GeometricModel>(modelId);
+    ASSERT_EQ(DgnDbStatus::Success, model->FillRangeIndex());
+    ASSERT_TRUE(3 == model->GetRangeIndex()->GetCount());
+
+    // changing the geometry of the model makes its snapshot stale.
+    EXPECT_TRUE(InsertElement(modelId).IsValid());
+    m_db->SaveChanges();
+    model = nullptr;
+    CloseDb();
+    ASSERT_TRUE(snapshotFile.DoesPathExist()); // not saved while there are local changes
+
+    OpenDb(m_db, dbFileName, BeSQLite::Db::OpenMode::ReadWrite, true);
+    ASSERT_FALSE(snapshotFile.DoesPathExist());
+    model = m_db->Models().Get<GeometricModel>(modelId);
+    ASSERT_EQ(DgnDbStatus::Success, model->FillRangeIndex());
+    ASSERT_TRUE(4 == model->GetRangeIndex()->GetCount());
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -1000,7 +1053,7 @@ TEST_F(DgnModelTests, UpdateRangeIndexForTxns)
         {
         auto el = m_db->Elements().Get<GeometricElement3d>(id);
         auto entry = model->GetRangeIndex()->FindElement(id);
-        EXPECT_EQ(nullptr == entry, el.IsNull());
+        EXPECT_EQ(entry.IsNull(), el.IsNull());
         EXPECT_EQ(el.IsValid(), expectValid);
         if (el.IsValid())
             {
@@ -407,6 +407,46 @@ TEST_F(RevisionTestFixture, MoreWorkflow)
     expectToThrow([&]() { m_db->Txns().MergeChangeset(*revision1); }, "failed to apply changes");
     }
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST_F(RevisionTestFixture, MergeMultipleChangesets)
+    {
+    SetupDgnDb(RevisionTestFixture::s_seedFileInfo.fileName, L"MergeMultipleChangesets.bim");
+    m_db->SaveChanges("Created Initial Model");
+    ChangesetPropsPtr initialRevision = CreateRevision("-cs1");
+    ASSERT_TRUE(initialRevision.IsValid());
+
+    BackupTestFile();
+    bvector<DgnElementId> elementIds;
+    bvector<ChangesetPropsPtr> revisions;
+    for (int i = 0; i < 3; ++i)
+        {
+        DgnElementId elementId = RevisionTestFixture::InsertPhysicalElement(*m_db, *m_defaultModel, m_defaultCategoryId, i, i, i);
+        ASSERT_TRUE(elementId.IsValid());
+        elementIds.push_back(elementId);
+        m_db->SaveChanges("Inserted an element");
+
+        ChangesetPropsPtr revision = CreateRevision(Utf8PrintfString("-cs%d", i + 2).c_str());
+        ASSERT_TRUE(revision.IsValid());
+        revisions.push_back(revision);
+        }
+
+    // Merging out of order should fail before anything is applied
+    RestoreTestFile();
+    expectToThrow([&]() { m_db->Txns().MergeChangesets({revisions[1].get(), revisions[2].get()}); }, "changeset out of order");
+    EXPECT_STREQ(initialRevision->GetChangesetId().c_str(), m_db->Txns().GetParentChangesetId().c_str());
+
+    TxnManager::MergeTimings timings;
+    ChangesetStatus status = m_db->Txns().MergeChangesets({revisions[0].get(), revisions[1].get(), revisions[2].get()}, &timings);
+    ASSERT_EQ(ChangesetStatus::Success, status);
+    EXPECT_EQ(3u, timings.m_changesets);
+    EXPECT_STREQ(revisions[2]->GetChangesetId().c_str(), m_db->Txns().GetParentChangesetId().c_str());
+
+    for (DgnElementId elementId : elementIds)
+        EXPECT_TRUE(m_db->Elements().GetElement(elementId).IsValid());
+    }
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
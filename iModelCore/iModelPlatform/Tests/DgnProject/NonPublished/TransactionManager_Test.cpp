@@ -342,6 +342,110 @@ static void testRangeIndex()
         ASSERT_TRUE(found->m_range.IsBitwiseEqual(entry.m_range));
         }
 
+    // testing leaf entries against a filter in batches must accept the same entries as testing them one at a time.
+    struct FilterTraverser : RangeIndex::Traverser
+        {
+        RangeIndex::FBox m_box;
+        bvector<RangeIndex::FPlane> m_planes;
+        size_t m_count = 0;
+        Accept _CheckRangeTreeNode(RangeIndex::FBoxCR, bool) const override {return Accept::Yes;}
+        Stop _VisitRangeTreeEntry(RangeIndex::EntryCR) override {++m_count; return Stop::No;}
+        RangeIndex::FBoxCP _GetEntryFilterBox() const override {return m_box.IsValid() ? &m_box : nullptr;}
+        RangeIndex::FPlaneCP _GetEntryFilterPlanes(size_t& nPlanes) const override {nPlanes = m_planes.size(); return m_planes.empty() ? nullptr : m_planes.data();}
+        };
+
+    FilterTraverser boxFilter;
+    boxFilter.m_box = RangeIndex::FBox(DRange3d::From(-1000., -1000., -1000., 1000., 1000., 1000.), false);
+    size_t expectedInBox = 0;
+    for (auto& entry : entries)
+        expectedInBox += entry.m_range.IntersectsWith(boxFilter.m_box) ? 1 : 0;
+
+    tree.Traverse(boxFilter);
+    ASSERT_TRUE(expectedInBox > 0 && expectedInBox < count);
+    ASSERT_TRUE(boxFilter.m_count == expectedInBox);
+
+    FilterTraverser planeFilter;
+    planeFilter.m_planes.push_back(RangeIndex::FPlane(1., 0., 0., 0.)); // x >= 0
+    size_t expectedInside = 0;
+    for (auto& entry : entries)
+        expectedInside += entry.m_range.High().x >= 0 ? 1 : 0;
+
+    tree.Traverse(planeFilter);
+    ASSERT_TRUE(expectedInside > 0 && expectedInside < count);
+    ASSERT_TRUE(planeFilter.m_count == expectedInside);
+
+    // a bulk loaded tree holds the same entries as one built an entry at a time.
+    bvector<RangeIndex::Entry> bulkEntries = entries;
+    RangeIndex::Tree bulkTree(true, 20);
+    bulkTree.LoadEntries(bulkEntries);
+    ASSERT_TRUE(bulkTree.DebugElementCount() == count);
+    ASSERT_TRUE(bulkTree.GetCount() == count);
+    ASSERT_TRUE(bulkTree.GetExtents().IsBitwiseEqual(tree.GetExtents()));
+
+    FilterTraverser bulkBoxFilter;
+    bulkBoxFilter.m_box = boxFilter.m_box;
+    bulkTree.Traverse(bulkBoxFilter);
+    ASSERT_TRUE(bulkBoxFilter.m_count == expectedInBox);
+
+    // a tree loaded from a snapshot holds the same entries, and a snapshot is only accepted with a matching key and layout.
+    BeFileName snapshotFile;
+    BeTest::GetHost().GetOutputRoot(snapshotFile);
+    snapshotFile.AppendToPath(L"RangeIndexSnapshot.rangeindex");
+    ASSERT_TRUE(SUCCESS == bulkTree.SaveSnapshot(snapshotFile, "key1"));
+    ASSERT_TRUE(RangeIndex::Tree::ReadSnapshotKey(snapshotFile) == "key1");
+
+    RangeIndex::Tree snapshotTree(true, 20);
+    ASSERT_TRUE(ERROR == snapshotTree.LoadSnapshot(snapshotFile, "key2"));
+    ASSERT_TRUE(snapshotTree.GetCount() == 0);
+    RangeIndex::Tree snapshotTree2d(false, 20);
+    ASSERT_TRUE(ERROR == snapshotTree2d.LoadSnapshot(snapshotFile, "key1"));
+    ASSERT_TRUE(SUCCESS == snapshotTree.LoadSnapshot(snapshotFile, "key1"));
+    ASSERT_TRUE(snapshotTree.DebugElementCount() == count);
+    ASSERT_TRUE(snapshotTree.GetCount() == count);
+    ASSERT_TRUE(snapshotTree.GetExtents().IsBitwiseEqual(bulkTree.GetExtents()));
+    ASSERT_TRUE(ERROR == snapshotTree.LoadSnapshot(snapshotFile, "key1")); // not empty
+
+    FilterTraverser snapshotBoxFilter;
+    snapshotBoxFilter.m_box = boxFilter.m_box;
+    snapshotTree.Traverse(snapshotBoxFilter);
+    ASSERT_TRUE(snapshotBoxFilter.m_count == expectedInBox);
+    BeFileName::BeDeleteFile(snapshotFile.c_str());
+
+    for (auto& entry : entries)
+        {
+        ASSERT_TRUE(SUCCESS == bulkTree.RemoveElement(entry.m_id));
+        ASSERT_TRUE(SUCCESS == snapshotTree.RemoveElement(entry.m_id));
+        }
+    ASSERT_TRUE(bulkTree.GetCount() == 0);
+    ASSERT_TRUE(snapshotTree.GetCount() == 0);
+
+    // a traversal sees the tree as it was when the traversal started, even if the tree is modified while it is in progress.
+    struct RemoveFirstTraverser : RangeIndex::Traverser
+        {
+        RangeIndex::TreeR m_tree;
+        RangeIndex::Entry m_removed;
+        size_t m_count = 0;
+        RemoveFirstTraverser(RangeIndex::TreeR tree) : m_tree(tree) {}
+        Accept _CheckRangeTreeNode(RangeIndex::FBoxCR, bool) const override {return Accept::Yes;}
+        Stop _VisitRangeTreeEntry(RangeIndex::EntryCR entry) override
+            {
+            if (0 == m_count++)
+                {
+                m_removed = entry;
+                m_tree.RemoveElement(entry.m_id);
+                }
+            return Stop::No;
+            }
+        };
+
+    RemoveFirstTraverser traverser(tree);
+    tree.Traverse(traverser);
+    ASSERT_TRUE(traverser.m_count == count);
+    ASSERT_TRUE(tree.GetCount() == count-1);
+    ASSERT_TRUE(tree.FindElement(traverser.m_removed.m_id) == nullptr);
+    tree.AddEntry(traverser.m_removed);
+    ASSERT_TRUE(tree.DebugElementCount() == count);
+
     for (auto& entry : entries)
         ASSERT_TRUE(SUCCESS == tree.RemoveElement(entry.m_id));
 
@@ -437,7 +541,7 @@ TEST_F(TransactionManagerTests, UndoRedo)
     el2 = templateEl->Insert();
     stat = txns.ReverseSingleTxn(); // reversing a txn with pending uncommitted changes should abandon them.
     ASSERT_TRUE(DgnDbStatus::Success == stat);
-    ASSERT_TRUE(nullptr == m_db->Elements().FindLoadedElement(el2->GetElementId()));
+    ASSERT_TRUE(m_db->Elements().FindLoadedElement(el2->GetElementId()).IsNull());
     ASSERT_TRUE(!m_db->Elements().GetElement(el2->GetElementId()).IsValid());
 
     testModelUndoRedo(*m_db);
@@ -570,8 +674,8 @@ TEST_F(TransactionManagerTests, ElementInsertReverse)
     auto stat = txns.ReverseTxns(1);
     EXPECT_EQ(DgnDbStatus::Success, stat);
 
-    EXPECT_EQ(nullptr, m_db->Elements().FindLoadedElement(e1id));
-    EXPECT_EQ(nullptr, m_db->Elements().FindLoadedElement(e2id));
+    EXPECT_TRUE(m_db->Elements().FindLoadedElement(e1id).IsNull());
+    EXPECT_TRUE(m_db->Elements().FindLoadedElement(e2id).IsNull());
 
     //Reinstate transcation.The elements should be back in the model.
     stat = txns.ReinstateTxn();
@@ -580,11 +684,11 @@ TEST_F(TransactionManagerTests, ElementInsertReverse)
 
     DgnElementCPtr e1 = m_db->Elements().GetElement(e1id);
     EXPECT_TRUE(e1 != nullptr);
-    EXPECT_NE(nullptr, m_db->Elements().FindLoadedElement(e1id));
+    EXPECT_TRUE(m_db->Elements().FindLoadedElement(e1id).IsValid());
 
     DgnElementCPtr e2 = m_db->Elements().GetElement(e2id);
     EXPECT_TRUE(e2 != nullptr);
-    EXPECT_NE(nullptr, m_db->Elements().FindLoadedElement(e2id));
+    EXPECT_TRUE(m_db->Elements().FindLoadedElement(e2id).IsValid());
 
     //Both the elements and the model shouldn't be in the database.
     txns.ReverseAll();
@@ -610,8 +714,8 @@ TEST_F (TransactionManagerTests, ElementDeleteReverse)
 
     DgnElementId e1id = keyE1->GetElementId();
     EXPECT_TRUE(e1id.IsValid());
-    DgnElementCP pE1 = m_db->Elements().FindLoadedElement(e1id);
-    EXPECT_NE (nullptr, pE1);
+    DgnElementCPtr pE1 = m_db->Elements().FindLoadedElement(e1id);
+    EXPECT_TRUE(pE1.IsValid());
     EXPECT_TRUE(txns.IsUndoPossible());
 
     //Deletes the Element.
@@ -624,7 +728,7 @@ TEST_F (TransactionManagerTests, ElementDeleteReverse)
     auto stat = txns.ReverseTxns(1);
     EXPECT_EQ(DgnDbStatus::Success, stat);
     EXPECT_TRUE(m_db->Elements().GetElement(e1id) != nullptr);
-    EXPECT_NE(nullptr, m_db->Elements().FindLoadedElement(e1id));
+    EXPECT_TRUE(m_db->Elements().FindLoadedElement(e1id).IsValid());
 
     //Reinstate transcation. The elements shouldn't be in the model.
     stat = txns.ReinstateTxn();
@@ -0,0 +1,94 @@
+/*---------------------------------------------------------------------------------------------
+* Copyright (c) Bentley Systems, Incorporated. All rights reserved.
+* See LICENSE.md in the repository root for full copyright notice.
+*--------------------------------------------------------------------------------------------*/
+#include "PerformanceTestFixture.h"
+#include <DgnPlatform/RangeIndex.h>
+#include <random>
+
+USING_NAMESPACE_BENTLEY_DGN
+
+BEGIN_UNNAMED_NAMESPACE
+
+//=======================================================================================
+//! Counts the entries that overlap a query box, either by testing each entry as it is
+//! visited or by letting the leaves filter their entries in batches.
+// @bsiclass
+//=======================================================================================
+struct OverlapCounter : RangeIndex::Traverser
+{
+    RangeIndex::FBox m_query;
+    bool m_batched;
+    size_t m_count = 0;
+
+    OverlapCounter(RangeIndex::FBoxCR query, bool batched) : m_query(query), m_batched(batched) {}
+    Accept _CheckRangeTreeNode(RangeIndex::FBoxCR range, bool) const override {return range.IntersectsWith(m_query) ? Accept::Yes : Accept::No;}
+    RangeIndex::FBoxCP _GetEntryFilterBox() const override {return m_batched ? &m_query : nullptr;}
+    Stop _VisitRangeTreeEntry(RangeIndex::EntryCR entry) override
+        {
+        if (m_batched || entry.m_range.IntersectsWith(m_query))
+            ++m_count;
+
+        return Stop::No;
+        }
+};
+
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+RangeIndex::FBox makeBox(std::mt19937& rng, double worldSize, double maxSize)
+    {
+    std::uniform_real_distribution<double> origin(0.0, worldSize);
+    std::uniform_real_distribution<double> size(0.0, maxSize);
+    double x = origin(rng), y = origin(rng), z = origin(rng);
+    return RangeIndex::FBox(DRange3d::From(x, y, z, x + size(rng), y + size(rng), z + size(rng)), false);
+    }
+
+END_UNNAMED_NAMESPACE
+
+//---------------------------------------------------------------------------------------
+// Compare range queries that test every leaf entry one at a time with queries that filter leaf entries in batches.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+TEST(RangeIndexPerformance, BatchedEntryFilter)
+    {
+    const size_t entryCount = 1000000;
+    const size_t queryCount = 1000;
+    const double worldSize = 10000.0;
+
+    std::mt19937 rng(1234);
+    RangeIndex::Tree tree(true, 20);
+        {
+        RangeIndex::Tree::WriteLock lock(tree);
+        for (size_t i = 0; i < entryCount; ++i)
+            tree.AddEntry(RangeIndex::Entry(makeBox(rng, worldSize, 10.0), DgnElementId((uint64_t) i + 1)));
+        }
+
+    bvector<RangeIndex::FBox> queries;
+    for (size_t i = 0; i < queryCount; ++i)
+        queries.push_back(makeBox(rng, worldSize, 500.0));
+
+    size_t scalarHits = 0;
+    StopWatch scalarTimer(true);
+    for (auto const& query : queries)
+        {
+        OverlapCounter counter(query, false);
+        tree.Traverse(counter);
+        scalarHits += counter.m_count;
+        }
+    scalarTimer.Stop();
+
+    size_t batchedHits = 0;
+    StopWatch batchedTimer(true);
+    for (auto const& query : queries)
+        {
+        OverlapCounter counter(query, true);
+        tree.Traverse(counter);
+        batchedHits += counter.m_count;
+        }
+    batchedTimer.Stop();
+
+    EXPECT_EQ(scalarHits, batchedHits);
+    LOGTODB(TEST_DETAILS, scalarTimer.GetElapsedSeconds(), (int) queryCount, "RangeIndex query, entries tested one at a time");
+    LOGTODB(TEST_DETAILS, batchedTimer.GetElapsedSeconds(), (int) queryCount, "RangeIndex query, entries filtered in batches");
+    }
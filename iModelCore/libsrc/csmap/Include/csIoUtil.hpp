@@ -39,7 +39,7 @@ extern "C"
 	#include "cs_map.h"
 	#include "cs_ioUtil.h"
 
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	extern char cs_Csname[];
 	extern char cs_Dtname[];
@@ -55,7 +55,7 @@ extern "C"
 	extern char cs_Unique;
 	extern char cs_DirsepC;
 	extern short cs_Protect;
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	/**********************************************************************
 	Hook function to support the use of temporary coordinate systems.
@@ -652,6 +652,20 @@
 #	endif
 #endif
 
+/*
+	The error globals (cs_Error, csErrnam, csErrmsg, csErrlng and csErrlat)
+	are written by the conversion functions whenever they report a problem.
+	Each thread gets its own copy so that threads converting coordinates at
+	the same time do not overwrite each other's error state.
+*/
+#ifndef csTHREAD_LOCAL
+#	if defined (_MSC_VER)
+#		define csTHREAD_LOCAL __declspec(thread)
+#	else
+#		define csTHREAD_LOCAL __thread
+#	endif
+#endif
+
 /*
 	We now include the necessary include files.  We do this
 	once, here, to insulate individual code modules from the
@@ -274,7 +274,7 @@ struct csGeoidHeightEntry_* CSnewGeoidHeightEntry (struct csDatumCatalogEntry_*
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	char *cp;
 	struct csGeoidHeightEntry_* __This;
@@ -487,7 +487,7 @@ double CStestGeoidHeightEntry (struct csGeoidHeightEntry_* __This,Const double*
 */
 int CScalcGeoidHeightEntry (struct csGeoidHeightEntry_* __This,double* geoidHgt,Const double *ll84)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int status;
 
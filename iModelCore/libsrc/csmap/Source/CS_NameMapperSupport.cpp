@@ -50,7 +50,7 @@
 
 extern "C" char cs_Dir [];
 extern "C" char* cs_DirP;
-extern "C" char csErrnam [];
+extern "C" csTHREAD_LOCAL char csErrnam [];
 extern "C" const unsigned long KcsNmMapNoNumber = 0UL;
 extern "C" const unsigned long KcsNmInvNumber = 0xFFFFFFFFUL;
 extern "C" char cs_NameMapperName [];
@@ -231,7 +231,7 @@ struct csVertconUSEntry_* CSnewVertconUSEntry (struct csDatumCatalogEntry_* catP
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	char *cp;
 	struct csVertconUSEntry_* thisPtr;
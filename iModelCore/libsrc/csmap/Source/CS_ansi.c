@@ -448,7 +448,7 @@ int EXP_LVL9 CS_remove (Const char *path)
 #endif
 int EXP_LVL9 CS_rename (Const char *old,Const char *new_name)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 
@@ -230,7 +230,7 @@ int CSats77D  (struct cs_Ats77_ *ats77)
 
 struct cs_Ats77_ *CSnewAts77 (Const char *filePath,ulong32_t flags,double density)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
 
@@ -429,7 +429,7 @@ void EXP_LVL9 CSazmedS (struct cs_Csprm_ *csprm)
 
 int EXP_LVL9 CSazmedF (Const struct cs_Azmed_ *azmed,double xy [2],Const double ll [2])
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	extern double cs_Degree;			/* 1.0 / RADIAN  */
 	extern double cs_Pi;				/* 3.14159... */
@@ -853,7 +853,7 @@ int EXP_LVL9 CSazmedF (Const struct cs_Azmed_ *azmed,double xy [2],Const double
 
 int EXP_LVL9 CSazmedI (Const struct cs_Azmed_ *azmed,double ll [2],Const double xy [2])
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	extern double cs_Radian;			/*  57.29577..... */
 	extern double cs_Zero;				/* 0.0 */
@@ -46,7 +46,7 @@
 	enough to warrant a separate set of implementation code.
 */
 
-extern char csErrnam [MAXPATH];
+extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 short CSswapShort (short source,int swapEm);
 long32_t  CSswapLong  (long32_t source,int swapEm);
@@ -89,7 +89,7 @@ struct csBynGridFile_* CSnewBynGridFile (Const char *path,long32_t bufferSize,ul
 
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	size_t readCount;
 	long32_t lngTmp;
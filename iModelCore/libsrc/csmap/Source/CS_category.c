@@ -175,7 +175,7 @@ int ExtendCsNameBlock(struct cs_Ctdef_* pCategoryIn, size_t byCount);
 
 /* live */ int GetCategoryPtrIdx(unsigned index, struct cs_Ctdef_** ppCategory)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	unsigned currentIndex = 0;
 	struct cs_Ctdef_* pHead = NULL;
@@ -209,7 +209,7 @@ int ExtendCsNameBlock(struct cs_Ctdef_* pCategoryIn, size_t byCount);
 *******************************************************************************/
 int LinkInCategory(struct cs_Ctdef_* pNewCategory, struct cs_Ctdef_* pToBeReplaced, int releaseCategory)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern struct cs_Ctdef_* cs_CtDefHead;
 
 	cs_Error = 0;
@@ -254,7 +254,7 @@ int LinkInCategory(struct cs_Ctdef_* pNewCategory, struct cs_Ctdef_* pToBeReplac
 *******************************************************************************/
 int UnlinkCategory(struct cs_Ctdef_* pToBeRemoved, int releaseCategory)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern struct cs_Ctdef_* cs_CtDefHead;
 	cs_Error = 0;
 
@@ -292,7 +292,7 @@ int UnlinkCategory(struct cs_Ctdef_* pToBeRemoved, int releaseCategory)
 *******************************************************************************/
 int AppendCategory(struct cs_Ctdef_* pToAppend)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern struct cs_Ctdef_* cs_CtDefHead;
 	struct cs_Ctdef_* pTailCategory;
 
@@ -406,8 +406,8 @@ int AddCsName(struct cs_Ctdef_* ctDefPtr, Const char* csName)
 **************************************************************************/
 int CanModifyCsName(Const char* catName, unsigned idx, struct cs_Ctdef_** ctDefPtr)
 {
-	extern int cs_Error;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	cs_Error = 0;
 
@@ -665,8 +665,8 @@ void EXP_LVL3 CS_ctfnm (const char* new_name)
  *****************************************************************************/
 struct cs_Ctdef_* EXP_LVL3 CSgetCtDef(const char* catName)
 {
-	extern int cs_Error;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int searchResult = 0;
 	struct cs_Ctdef_* pFoundCategory = NULL;
@@ -704,7 +704,7 @@ struct cs_Ctdef_* EXP_LVL3 CSgetCtDef(const char* catName)
 ********************************************/
 int EXP_LVL3 CSgetCtDefAll(struct cs_Ctdef_ **pDefArray[])
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	int catCount = 0;
 	int catCountIndex = 0;
@@ -820,7 +820,7 @@ struct cs_Ctdef_* EXP_LVL3 CScpyCategory(Const struct cs_Ctdef_ * pSrcCategory)
 
 struct	cs_Ctdef_*	EXP_LVL3 CScpyCategoryEx(struct cs_Ctdef_* pDstCategory, Const struct cs_Ctdef_ * pSrcCategory, int setProtectFlag)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	size_t allocBlockCount = 0;
 	ulong32_t index = 0;
@@ -954,8 +954,8 @@ int EXP_LVL3 CSrmvItmName (Const char* catName, unsigned idx)
 
 int EXP_LVL3 CSrmvItmNameEx (struct cs_Ctdef_ *pCategoryIn, Const char* name)
 {
-	extern int cs_Error;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int csNameIndex = -1;
 
@@ -1018,8 +1018,8 @@ int EXP_LVL3 CSrmvItmNameEx (struct cs_Ctdef_ *pCategoryIn, Const char* name)
 
 int EXP_LVL3 CSrmvItmNames (Const char* catName)
 {
-	extern int cs_Error;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int categoryUpdate;
 	struct cs_Ctdef_ *ctDefPtr = NULL; //our live pointer
@@ -1046,7 +1046,7 @@ int EXP_LVL3 CSrmvItmNames (Const char* catName)
 
 int EXP_LVL3 CSrmvItmNamesEx (struct cs_Ctdef_ *pCategoryIn)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	cs_Error = 0;
 
@@ -1078,8 +1078,8 @@ int EXP_LVL3 CSrmvItmNamesEx (struct cs_Ctdef_ *pCategoryIn)
  *****************************************************************************/
 int EXP_LVL3 CSaddItmName(Const char* catName, Const char* newName)
 {
-	extern int cs_Error;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	struct cs_Ctdef_* ctDefPtr = NULL;
 
@@ -1114,8 +1114,8 @@ int EXP_LVL3 CSaddItmName(Const char* catName, Const char* newName)
  *****************************************************************************/
 int EXP_LVL3 CSaddItmNameEx(struct cs_Ctdef_ *pCategoryIn, Const char* newName)
 {
-	extern int cs_Error;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	cs_Error = 0;
 
@@ -1158,7 +1158,7 @@ csFILE* EXP_LVL3 CS_ctopn (Const char *mode)
 	extern char cs_Dir [];
 	extern char *cs_DirP;
 	extern char cs_Ctname [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	size_t rd_cnt;
 
@@ -1211,8 +1211,8 @@ csFILE* EXP_LVL3 CS_ctopn (Const char *mode)
 **********************************************************************/
 int EXP_LVL3 CSdelCategory(Const char* catName)
 {
-	extern int cs_Error;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern short cs_Protect;
 
 	int unlinkStatus = 0;
@@ -1278,8 +1278,8 @@ int EXP_LVL3 CSdelCategory(Const char* catName)
 **********************************************************************/
 int EXP_LVL3 CSupdCategory(Const struct cs_Ctdef_* categoryIn)
 {
-	extern int cs_Error;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern short cs_Protect;
 
 	char testCsName[cs_KEYNM_DEF] = { '\0' };
@@ -1594,8 +1594,8 @@ int EXP_LVL3 CSwrtCategory (csFILE* stream,Const struct cs_Ctdef_*ctDefPtr)
 
 int EXP_LVL3 CSrplCatNameEx (Const char* oldCtName, Const char* newCtName)
 {
-	extern char csErrnam [];
-	extern int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
 	struct cs_Ctdef_* liveCatPtr = NULL;
 
 	cs_Error = 0;
@@ -1631,7 +1631,7 @@ error:
 
 int EXP_LVL3 CSrplCatName (Const char* newCtName, unsigned idx)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	struct cs_Ctdef_* liveCatPtr = NULL;
 
@@ -1652,7 +1652,7 @@ int EXP_LVL3 CSrplCatName (Const char* newCtName, unsigned idx)
 
 int EXP_LVL3 CSaddCategory (Const char* catName)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	struct cs_Ctdef_* newDefPtr = NULL;
 
 	cs_Error = 0;
@@ -1691,7 +1691,7 @@ struct cs_Ctdef_* EXP_LVL3 CSnewCategory (Const char* ctName)
 
 struct cs_Ctdef_* EXP_LVL3 CSnewCategoryEx (Const char* ctName, int preAllocate)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	struct cs_Ctdef_* newDefPtr;
 
 	cs_Error = 0;
@@ -1725,7 +1725,7 @@ error:
 
 struct cs_Ctdef_* EXP_LVL3 CSrdCategory (csFILE* stream)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	struct cs_Ctdef_* ctDefPtr = NULL;
 	int readStatus;
 
@@ -1759,7 +1759,7 @@ error:
 
 int EXP_LVL3 CSrdCategoryEx (csFILE* stream, struct cs_Ctdef_ *ctDefPtr)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	size_t rdCnt;
 	unsigned idx;
 	unsigned allocSize;
@@ -1835,8 +1835,8 @@ error:
 
 struct cs_Ctdef_* EXP_LVL3 CSrdCatFile ()
 {
-	extern char csErrnam [];
-	extern int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
 	extern char cs_Dir [];
 	extern char cs_UserDir [];
 	
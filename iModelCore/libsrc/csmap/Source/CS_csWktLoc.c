@@ -55,7 +55,7 @@ static struct cs_Eldef_ wktElDef;
 
 int CS_wktCsDefFunc (struct cs_Csdef_* csDefPtr,Const char* wktString)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 	enum ErcWktFlavor flavor;
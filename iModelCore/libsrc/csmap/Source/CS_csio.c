@@ -164,7 +164,7 @@ int EXP_LVL5 CS_csupd (struct cs_Csdef_ *csdef,int crypt)
 	extern char *cs_CsKeyNames;
 	extern struct cs_Prjtab_ cs_Prjtab [];	/* Projection Table */
 	struct cs_Prjtab_ *pp;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Two_pi;				/* 6.28..... */
 	extern double cs_One;					/* 1.0 */
 	extern double cs_Zero;					/* 0.0 */
@@ -47,7 +47,7 @@ extern int (*cs_CsHook)(struct cs_Csdef_ *csdef,unsigned short prj_code,ulong32_
 
 struct cs_Csprm_ * EXP_LVL3 CS_csloc (Const char *cs_nam)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern struct cs_Prjtab_ cs_Prjtab [];
 
 	int status;
@@ -119,7 +119,7 @@ error:
 
 struct cs_Csprm_ * EXP_LVL3 CScsloc1 (struct cs_Csdef_ *cs_ptr)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern struct cs_Prjtab_ cs_Prjtab [];
 
 	struct cs_Csprm_ *csprm;
@@ -256,7 +256,7 @@ error:
 struct cs_Csprm_ * EXP_LVL3 CScsloc (	struct cs_Csdef_ *cs_ptr,
 										struct cs_Datum_ *dt_ptr)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern struct cs_Prjtab_ cs_Prjtab [];
 
 	extern double cs_One;					/* 1.0 */
@@ -432,7 +432,7 @@ extern int (*cs_DtHook)(struct cs_Dtdef_ *dtdef);
 struct cs_Datum_ * EXP_LVL5 CS_dtloc (Const char *dat_nam)
 
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int status;
 
@@ -188,7 +188,7 @@ struct cs_Dtcprm_ * EXP_LVL3 CSdtcsu (	Const struct cs_Datum_ *src_dt,
 										int blk_erf)
 #endif
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	short direction;
 
@@ -906,7 +906,7 @@ error:
 
 int CSdtcsuPhaseOne (struct csDtmBridge_* bridgePtr,struct cs_Dtcprm_ *dtcPtr)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	short idx;
 	short idxCount;
@@ -1134,7 +1134,7 @@ int CSdtcsuPhaseTwo (struct csDtmBridge_* bridgePtr,struct cs_Dtcprm_ *dtcPtr)
 */
 int CSdtcsuPhaseThree (struct csDtmBridge_* bridgePtr,struct cs_Dtcprm_ *dtcPtr)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 	extern struct cs_PivotDatumTbl_ cs_PivotDatumTbl [];
 
 	unsigned short chkFlags;
@@ -1633,9 +1633,9 @@ int EXP_LVL3 CS_dtcvt3D (struct cs_Dtcprm_ *dtcPrm,Const double ll_in [3],double
 }
 int EXP_LVL3 CSdtcvt (struct cs_Dtcprm_ *dtcPrm,short flag3D,Const double ll_in [3],double ll_out [3])
 {
-	extern char csErrnam [MAXPATH];
-	extern int csErrlng;
-	extern int csErrlat;
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL int csErrlng;
+	extern csTHREAD_LOCAL int csErrlat;
 	extern double cs_Zero;
 
 	short idx;
@@ -1892,7 +1892,7 @@ error:
 
 int	EXP_LVL1 CS_isDtXfrmReentrant (Const struct cs_Dtcprm_ *dtc_ptr)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	short idx;
 	int isReentrant;
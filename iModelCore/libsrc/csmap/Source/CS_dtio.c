@@ -244,7 +244,7 @@ struct cs_Dtdef_ * EXP_LVL3 CS_dtdef (Const char *dat_nam)
 
 struct cs_Dtdef_ * EXP_LVL5 CS_dtdef2 (Const char *dat_nam, char* pszDirPath)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	extern double cs_DelMax;		/* 5,000.0 */
 	extern double cs_RotMax;		/* 15.0    */
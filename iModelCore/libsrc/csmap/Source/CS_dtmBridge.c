@@ -61,7 +61,7 @@ error:
 }
 Const char* CSdtmBridgeGetSourceDtm (struct csDtmBridge_* thisPtr)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	Const char* cpSrc;
 	Const struct csDtmBridgeXfrm_* bridgeXfrmPtr;
@@ -94,7 +94,7 @@ error:
 }
 Const char* CSdtmBridgeGetTargetDtm (struct csDtmBridge_* thisPtr)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	Const char* cpTrg;
 	Const struct csDtmBridgeXfrm_* bridgeXfrmPtr;
@@ -214,7 +214,7 @@ int CSdtmBridgeIsFull (Const struct csDtmBridge_* thisPtr)
 int CSdtmBridgeAddSrcPath (struct csDtmBridge_* thisPtr,Const struct cs_GeodeticPath_* pathPtr,
 														short direction)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int gxIndex;
 	int bridgeStatus;
@@ -301,7 +301,7 @@ int CSdtmBridgeAddSrcTransformation (struct csDtmBridge_* thisPtr,
 									 Const struct cs_GxIndex_* xfrmPtr,
 									 short direction)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int bridgeStatus;
 
@@ -341,7 +341,7 @@ error:
 int CSdtmBridgeAddTrgPath (struct csDtmBridge_* thisPtr,Const struct cs_GeodeticPath_* pathPtr,
 														short direction)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int gxIndex;
 	int bridgeStatus;
@@ -428,7 +428,7 @@ int CSdtmBridgeAddTrgTransformation (struct csDtmBridge_* thisPtr,
 									 Const struct cs_GxIndex_* xfrmPtr,
 									 short direction)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int bridgeStatus;
 
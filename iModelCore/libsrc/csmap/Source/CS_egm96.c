@@ -71,7 +71,7 @@ struct cs_Egm96_ *CSnewEgm96 (const char *filePath,long32_t bufferSize,ulong32_t
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
 	extern double cs_Zero;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 
@@ -211,7 +211,7 @@ double CStestEgm96 (struct cs_Egm96_ *__This,const double wgs84 [2])
 int CScalcEgm96 (struct cs_Egm96_ *__This,double *geoidHgt,const double wgs84 [2])
 {
 	extern double cs_Mhuge;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 	extern double cs_K360;
 
@@ -502,7 +502,7 @@ error:
 int CSmkBinaryEgm96 (struct cs_Egm96_ *__This)
 {
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	extern double cs_Zero;			/* 0.0 */
 
@@ -661,7 +661,7 @@ error:
 /*lint -save -esym(644,deltaLat,deltaLng) */
 int CSopnBinaryEgm96 (struct cs_Egm96_ *__This,long32_t bufrSize)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	extern double cs_Zero;			/* 0.0 */
 
@@ -137,7 +137,7 @@ int EXP_LVL5 CS_eldel (struct cs_Eldef_ *eldef)
 **********************************************************************/
 int EXP_LVL5 CS_elupd (struct cs_Eldef_ *eldef,int crypt)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	extern char *cs_ElKeyNames;
 
@@ -315,7 +315,7 @@ int EXP_LVL3 CS_eldefAll (struct cs_Eldef_ **pDefArray[])
 
 struct cs_Eldef_ * EXP_LVL5 CS_eldef2 (Const char *el_nam, char* pszDirPath)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	extern double cs_One;			/* 1.0 */
 	extern double cs_Two;			/* 2.0 */
@@ -38,7 +38,7 @@
 void EXP_LVL3 CS_erpt (int err_num)
 
 {
-	extern char csErrmsg [cs_ERRMSG_SIZE];
+	extern csTHREAD_LOCAL char csErrmsg [cs_ERRMSG_SIZE];
 
 //    return;
 
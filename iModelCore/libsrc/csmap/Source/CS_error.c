@@ -34,7 +34,7 @@
 
 void EXP_LVL1 CS_errmsg (char *user_bufr,int bfr_size)
 {
-	extern char csErrmsg [256];
+	extern csTHREAD_LOCAL char csErrmsg [256];
 	
 	strncpy (user_bufr,csErrmsg,(unsigned)bfr_size);
 	user_bufr [bfr_size - 1] = '\0';
@@ -861,10 +861,10 @@ void EXP_LVL9 CSreltoa (char *rslt,int size,long32_t value);
 unsigned short EXP_LVL7 CSerpt (char *mesg,int size,int err_num)
 
 {
-	extern char csErrnam [];
-	extern int csErrlng;
-	extern int csErrlat;
-	extern int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
+	extern csTHREAD_LOCAL int csErrlng;
+	extern csTHREAD_LOCAL int csErrlat;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern int cs_Errno;
 #if _RUN_TIME < _rt_UNIXPCC
 	extern ulong32_t cs_Doserr;
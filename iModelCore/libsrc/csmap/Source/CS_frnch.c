@@ -301,7 +301,7 @@ int CSinitFrnch (struct cs_Frnch_* thisPtr,Const char *filePath,long32_t bufferS
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 
 	int status;
@@ -282,7 +282,7 @@ int EXP_LVL5 CS_rwDictDir (char *rsltPath,size_t rsltSize,Const char* srcPath)
 #else
 	extern char cs_DirsepC;
 	extern char cs_UserDir [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	/* Here for Linux/UNIX.  Directorires/folders can be write protected
 	   such that new files cannot be created in the directory/folder.
@@ -398,7 +398,7 @@ int EXP_LVL5 CS_nampp64 (char *name)
 
 int EXP_LVL7 CSnampp (char *name,size_t nameSize)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char cs_Nmchset [];
 	extern char cs_Unique;
 
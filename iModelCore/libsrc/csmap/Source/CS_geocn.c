@@ -542,7 +542,7 @@ struct cs_GeoconFile_* CSnewGeoconFile (Const char* filePath,long32_t bufferSize
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int swapped;
 	long32_t lngTmp;
@@ -761,7 +761,7 @@ int CSpathsGeoconFile (char *pathBufferLng,char *pathBufferLat,char *pathBufferH
 															   Const char *pathBuffer)
 {
 	extern int cs_Errno;
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	char cc1;
 	char ccL;
@@ -931,7 +931,7 @@ error:
 int CSheaderGeoconFile (struct cs_GeoconFileHdr_ *thisPtr,csFILE *fstr)
 {
 	extern double cs_Zero;
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int status;
 	int swapped;
@@ -1657,7 +1657,7 @@ int CSextractGeoconGridFile (struct csGeocnGridCell_ *cellPtr,struct cs_GeoconFi
 */
 int CSreadGeoconGridFile (struct cs_GeoconFile_* thisPtr,long32_t recNbr)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int status;
 	size_t readCount;
@@ -1937,7 +1937,7 @@ int CSedgeGeocnGridCell (struct csGeocnGridCell_ *cellPtr,struct cs_GeoconFile_*
 														  long32_t recNbr,
 														  enum csGeocnEdgeEffects edge)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int status;
 
@@ -2117,7 +2117,7 @@ double CScalcGeocnGridCell (struct csGeocnGridCell_* thisPtr,Const double *sourc
 {
 	extern double cs_Half;
 	extern double cs_Huge;
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	double rtnValue;
 
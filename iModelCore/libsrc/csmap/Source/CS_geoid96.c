@@ -40,7 +40,7 @@
 	of it is code duplicated in CS_geoid99.c
 */
 
-extern char csErrnam [MAXPATH];
+extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 /*****************************************************************************
 	'Private' support function
@@ -69,7 +69,7 @@ struct csGeoid96GridFile_* CSnewGeoid96GridFile (Const char *path,long32_t buffe
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	size_t readCount;
 	long lngTmp;
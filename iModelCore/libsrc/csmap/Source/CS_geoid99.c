@@ -37,7 +37,7 @@
 	enough to warrant a separate set of implementation code.
 */
 
-extern char csErrnam [MAXPATH];
+extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 /*****************************************************************************
 	'Private' support function
@@ -68,7 +68,7 @@ struct csGeoid99GridFile_* CSnewGeoid99GridFile (Const char *path,long32_t buffe
 	extern double cs_K360;
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	size_t readCount;
 	long lngTmp;
@@ -175,7 +175,7 @@ struct cs_MIdatum_ cs_MIdatum [] =
 Const char* EXP_LVL3 CS_mifcs (Const struct cs_Csdef_ *cs_def)
 {
 	extern struct cs_Prjtab_ cs_Prjtab [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
    	static char cs_claus [256];
 
@@ -215,10 +215,10 @@ struct cs_GeodeticPath_ * EXP_LVL3 CS_gpdefEx (int* direction,
 											   Const char *srcDatum,
 											   Const char *trgDatum)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char cs_UserDir[];
 
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	char currentDir[MAXPATH] = { '\0' };
 	char targetPaths[2][MAXPATH] = { { '\0'}, {'\0'} };
@@ -464,10 +464,10 @@ error:
 /*lint -esym(550,globalFoundForward)  Variable set, but not used. */
 int EXP_LVL3 CS_gpdefFrom(struct cs_GeodeticPath_ *array[], int numArray, Const char *srcDatum)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char cs_UserDir[];
 
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	char currentDir[MAXPATH] = { '\0' };
 	char targetPaths[2][MAXPATH] = { { '\0'}, {'\0'} };
@@ -658,7 +658,7 @@ error:
 
 int EXP_LVL1 CS_gpchk (Const struct cs_GeodeticPath_ *gpPath,unsigned short gpChkFlg,int err_list [],int list_sz)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	short gpIdx;
 
@@ -168,7 +168,7 @@ int EXP_LVL9 CSgridiS (struct cs_GxXform_* gxXfrm)
 {
 	extern char *cs_DirP;
 	extern char cs_Dir [];
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 	extern struct cs_GridFormatTab_ cs_GridFormatTab [];
 
 	char cc1;
@@ -341,7 +341,7 @@ French technique is indeed 3 dimensional.  So our design here supports both
  */
 int EXP_LVL9 CSgridiF3 (struct csGridi_ *gridi,double trgLl [3],Const double srcLl [3])
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int status;
 	int fbStatus;
@@ -435,7 +435,7 @@ int EXP_LVL9 CSgridiF3 (struct csGridi_ *gridi,double trgLl [3],Const double src
 }
 int EXP_LVL9 CSgridiF2 (struct csGridi_ *gridi,double* trgLl,Const double* srcLl)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int status;
 	int fbStatus;
@@ -515,7 +515,7 @@ int EXP_LVL9 CSgridiF2 (struct csGridi_ *gridi,double* trgLl,Const double* srcLl
 }
 int EXP_LVL9 CSgridiI3 (struct csGridi_ *gridi,double* trgLl,Const double* srcLl)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int status;
 	int fbStatus;
@@ -600,7 +600,7 @@ int EXP_LVL9 CSgridiI3 (struct csGridi_ *gridi,double* trgLl,Const double* srcLl
 }
 int EXP_LVL9 CSgridiI2 (struct csGridi_ *gridi,double* trgLl,Const double* srcLl)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int status;
 	int fbStatus;
@@ -43,7 +43,7 @@ int EXP_LVL3 CS_csgrp (Const char *grp_key,struct cs_Csgrplst_ **grp_list)
 {
 	extern struct cs_Prjtab_ cs_Prjtab [];
 	extern struct cs_Grptbl_ cs_CsGrptbl [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 	int count;
@@ -33,7 +33,7 @@ extern int (*CS_usrCsDefPtr)(struct cs_Csdef_ *ptr,Const char *keyName);
 
 int EXP_LVL2 CS_getcs (Const char *cs_name,struct cs_Csdef_ *bufr)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	int status;
 
@@ -56,7 +56,7 @@ int EXP_LVL2 CS_getcs (Const char *cs_name,struct cs_Csdef_ *bufr)
 int EXP_LVL2 CS_getdt (	Const char *dt_name,
 			struct cs_Dtdef_ *bufr)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	int status;
 
@@ -79,7 +79,7 @@ int EXP_LVL2 CS_getdt (	Const char *dt_name,
 int EXP_LVL2 CS_getel (	Const char *el_name,
 			struct cs_Eldef_ *bufr)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	int status;
 
@@ -101,7 +101,7 @@ int EXP_LVL2 CS_getel (	Const char *el_name,
 
 int EXP_LVL1 CS_getElValues (Const char *el_name,double *radius,double *e_Sq)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	int status;
 
@@ -123,7 +123,7 @@ int EXP_LVL1 CS_getElValues (Const char *el_name,double *radius,double *e_Sq)
 }
 int EXP_LVL1 CS_isgeo (Const char *cs_nam)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	int rtn_val;
 
 	struct cs_Csprm_ *cs_ptr;
@@ -181,7 +181,7 @@ int EXP_LVL1 CS_putel (	Const struct cs_Eldef_ *el_def,int crypt)
 
 int EXP_LVL1 CS_csEnum (int index,char *key_name,int size)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	cs_Register char *cp;
 
@@ -269,7 +269,7 @@ int EXP_LVL1 CS_csIsValid (Const char *key_name)
 
 int EXP_LVL1 CS_dtEnum (int index,char *key_name,int size)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	cs_Register char *cp;
 
@@ -296,7 +296,7 @@ int EXP_LVL1 CS_dtEnum (int index,char *key_name,int size)
 
 int EXP_LVL1 CS_dtIsValid (Const char *key_name)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	char kyTemp [cs_KEYNM_DEF + 2];
 	cs_Register char *cp;
@@ -317,7 +317,7 @@ int EXP_LVL1 CS_dtIsValid (Const char *key_name)
 
 int EXP_LVL1 CS_elEnum (int index,char *key_name,int size)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	cs_Register char *cp;
 
@@ -344,7 +344,7 @@ int EXP_LVL1 CS_elEnum (int index,char *key_name,int size)
 
 int EXP_LVL1 CS_elIsValid (Const char *key_name)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	char kyTemp [cs_KEYNM_DEF + 2];
 	cs_Register char *cp;
@@ -408,7 +408,7 @@ int EXP_LVL2 CS_csEnumByGroup (int index,Const char *grp_name,struct cs_Csgrplst
 
 int EXP_LVL1 CS_csGrpEnum (int index,char *grp_name,int name_sz,char *grp_dscr,int dscr_sz)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern struct cs_Grptbl_ cs_CsGrptbl [];
 
 	int ii;
@@ -732,7 +732,7 @@ char * EXP_LVL9 CSelKeyNames (void)
 
 int EXP_LVL1 CS_prjEnum (int index,ulong32_t *prj_flags,char *prj_keynm,int keynm_sz,char *prj_descr,int descr_sz)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern struct cs_Prjtab_ cs_Prjtab [];
 
 	int ii;
@@ -771,9 +771,9 @@ int EXP_LVL1 CS_prjEnum (int index,ulong32_t *prj_flags,char *prj_keynm,int keyn
 
 int EXP_LVL1 CS_unEnum (int index,int type,char *un_name,int un_size)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern struct cs_Unittab_ cs_Unittab [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	static char modl_name [] = "CS_unEnum";
 
@@ -820,9 +820,9 @@ int EXP_LVL1 CS_unEnum (int index,int type,char *un_name,int un_size)
 
 int EXP_LVL1 CS_unEnumPlural (int index,int type,char *un_name,int un_size)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern struct cs_Unittab_ cs_Unittab [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	static char modl_name [] = "CS_unEnumPlural";
 
@@ -869,7 +869,7 @@ int EXP_LVL1 CS_unEnumPlural (int index,int type,char *un_name,int un_size)
 
 int EXP_LVL1 CS_unEnumSystem (int index,int type)
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern struct cs_Unittab_ cs_Unittab [];
 
 	int ii;
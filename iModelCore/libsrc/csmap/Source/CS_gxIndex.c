@@ -313,7 +313,7 @@ int CS_selectAccurateGxIndex(unsigned indexGxA, unsigned indexGxB)
 
 int CS_locateGxByDatum2 (int* direction,Const char* srcDtmName,Const char* trgDtmName)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int result;
 	int chosenResult;
@@ -306,9 +306,9 @@ int EXP_LVL3 CS_gxdefAll (struct cs_GeodeticTransform_ **pDefArray[])
 struct cs_GeodeticTransform_ * EXP_LVL3 CS_gxdefEx (Const char *srcDatum,
 													Const char *trgDatum)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char cs_UserDir[];
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	char currentDir[MAXPATH] = { '\0' };
 	char targetPaths[2][MAXPATH] = { {'\0'}, {'\0'} };
@@ -556,9 +556,9 @@ error:
 /*lint -esym(550,direction)   not used in this module, retained to assist in debugging */
 int EXP_LVL3 CS_gxdefFrom (struct cs_GeodeticTransform_ *array[], int numArray, Const char *srcDatum)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char cs_UserDir[];
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	char currentDir[MAXPATH] = { '\0' };
 	char targetPaths[2][MAXPATH] = { {'\0'}, {'\0'} };
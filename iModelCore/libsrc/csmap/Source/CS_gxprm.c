@@ -54,7 +54,7 @@ struct cs_GxXform_ EXP_LVL5 *CS_gxloc (Const char* gxDefName, short userDirectio
 
 struct cs_GxXform_ EXP_LVL5 *CS_gxloc1 (Const struct cs_GeodeticTransform_ *xfrmDefPtr,short userDirection)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern struct cs_XfrmTab_ cs_XfrmTab [];
 
 	int status;
@@ -207,7 +207,7 @@ struct cs_GxXform_ EXP_LVL5 *CS_gxloc1ElDefProvided(Const struct cs_GeodeticTran
 
 struct cs_GxXform_ EXP_LVL5 *CS_gxloc1DtmProvided(Const struct cs_GeodeticTransform_ *xfrmDefPtr, short userDirection, Const struct cs_Datum_ *srcDtPtr, Const struct cs_Datum_ *trgDtPtr, Const struct cs_GeodeticTransform_ *fallbackXfrmDefPtr)
 {
-    extern char csErrnam[];
+    extern csTHREAD_LOCAL char csErrnam[];
     extern struct cs_XfrmTab_ cs_XfrmTab[];
 
     int status;
@@ -315,7 +315,7 @@ error:
 
 struct cs_GxXform_ EXP_LVL5 *CS_gxloc1DefOnly (Const struct cs_GeodeticTransform_ *xfrmDefPtr,short userDirection)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern struct cs_XfrmTab_ cs_XfrmTab [];
 
 	int status;
@@ -434,7 +434,7 @@ struct cs_GxXform_*	EXP_LVL5 CS_gxlocDtm (Const struct cs_Datum_ *src_dt,Const s
 	extern double cs_Five;
 	extern double cs_Eight;
 
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern struct cs_XfrmTab_ cs_XfrmTab [];
 
 	int status;
@@ -647,7 +647,7 @@ int EXP_LVL1 CS_gxInvrs2D (struct cs_GxXform_ *xform,double trgLl [3],Const doub
 int EXP_LVL1 CS_gxchk (Const struct cs_GeodeticTransform_ *gxXform,unsigned short gxChkFlg,int err_list [],int list_sz)
 {
 	extern struct cs_XfrmTab_ cs_XfrmTab[];
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int st;
 	int ii;
@@ -750,7 +750,7 @@ int EXP_LVL1 CS_gxchk (Const struct cs_GeodeticTransform_ *gxXform,unsigned shor
 int EXP_LVL1 CS_gxfastchk (Const struct cs_GeodeticTransform_ *gxXform,unsigned short gxChkFlg,int err_list [],int list_sz)
 {
 	extern struct cs_XfrmTab_ cs_XfrmTab[];
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int st;
 	int ii;
@@ -852,7 +852,7 @@ void EXP_LVL1 CS_gxDisable (struct cs_GxXform_ *xfrmPtr)
 }
 int	EXP_LVL1 CS_isGxfrmReentrant (Const struct cs_GxXform_ *gxXform)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 	extern struct cs_XfrmTab_ cs_XfrmTab[];
 	extern struct cs_GridFormatTab_ cs_GridFormatTab [];
 
@@ -961,7 +961,7 @@ int	EXP_LVL1 CS_isGxfrmReentrant (Const struct cs_GxXform_ *gxXform)
 }
 int EXP_LVL1 CS_isGxDefReentrant (Const struct cs_GeodeticTransform_ *gxDef)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 	extern struct cs_XfrmTab_ cs_XfrmTab[];
 	extern struct cs_GridFormatTab_ cs_GridFormatTab [];
 
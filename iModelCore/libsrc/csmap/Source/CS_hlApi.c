@@ -71,7 +71,7 @@ void EXP_LVL1 CS_fast (int mode)
 int EXP_LVL1 CS_cnvrt (Const char *src_cs,Const char *dst_cs,double coord [3])
 
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern csFILE* csDiagnostic;
 
 	static char modl_name [] = "CS_cnvrt";
@@ -145,7 +145,7 @@ error:
 **********************************************************************/
 int EXP_LVL1 CS_cnvrt3D (Const char *src_cs,Const char *dst_cs,double coord [3])
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern csFILE* csDiagnostic;
 
 	static char modl_name [] = "CS_cnvrt3D";
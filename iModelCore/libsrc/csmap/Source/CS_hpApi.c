@@ -414,7 +414,7 @@ int EXP_LVL3 CS_cschk (	Const struct cs_Csdef_ *cs_def,unsigned short chk_flg,
 	extern unsigned short cs_ErrSup;	/* Error report suppression
 										   bit map */
 	extern struct cs_Prjtab_ cs_Prjtab [];	/* Projection Table */
-	extern char csErrnam [];		/* Dimensioned at MAXPATH */
+	extern csTHREAD_LOCAL char csErrnam [];		/* Dimensioned at MAXPATH */
 	extern short cs_QuadMin;		/* Minimum acceptable value
 									   for quad. */
 	extern short cs_QuadMax;		/* Maximum acceptable value
@@ -835,7 +835,7 @@ int EXP_LVL3 CS_xychk (Const struct cs_Csprm_ *csprm,int cnt,Const double pnts [
    cs_Csprm_ structure is reentrant. */
 int	EXP_LVL1 CS_isCsPrmReentrant (Const struct cs_Csprm_ *prjConversion)
 {
-	extern char csErrnam [];				/* Dimensioned at MAXPATH */
+	extern csTHREAD_LOCAL char csErrnam [];				/* Dimensioned at MAXPATH */
 
 	int isReentrant = FALSE;
 
@@ -852,7 +852,7 @@ int	EXP_LVL1 CS_isCsPrmReentrant (Const struct cs_Csprm_ *prjConversion)
 }
 int	EXP_LVL1 CS_isCsReentrant (Const char *csys)
 {
-	extern char csErrnam [];				/* Dimensioned at MAXPATH */
+	extern csTHREAD_LOCAL char csErrnam [];				/* Dimensioned at MAXPATH */
 	extern struct cs_Prjtab_ cs_Prjtab [];	/* Projection Table */
 
 	int isReentrant;
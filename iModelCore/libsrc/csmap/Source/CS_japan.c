@@ -367,7 +367,7 @@ struct cs_Japan_* CSnewJgd2kGridFile (Const char *path,long32_t bufferSize,ulong
 {
 	extern double cs_Sec2Deg;		/* 1.0 / 3600.0 */
 	extern char cs_DirsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 	size_t rdCnt;
@@ -533,7 +533,7 @@ void CSreleaseJgd2kGridFile (struct cs_Japan_ *thisPtr)
 /* Given a lat/long, we extract the grid cell which covers the point. */
 int CSextractJgd2kGridFile (struct cs_Japan_ *thisPtr,Const double* sourceLL)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Sec2Deg;
 
 	int flag;
@@ -792,7 +792,7 @@ int CScalcJgd2kGridFile (struct cs_Japan_* thisPtr,double targetLL [2],Const dou
 int CSmakeBinaryJgd2kFile (struct cs_Japan_* thisPtr)
 {
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 
 	int st;
@@ -1068,7 +1068,7 @@ error:
 */
 ulong32_t EXP_LVL9 CSjpnLlToMeshCode (const double ll [2])
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	ulong32_t mesh;
 	ulong32_t iLat, iLng;
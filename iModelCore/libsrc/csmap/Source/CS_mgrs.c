@@ -384,8 +384,8 @@ void CSdeleteMgrs (struct cs_Mgrs_ *__This)
 
 int CScalcUtmUps (struct cs_Mgrs_ *__This,double utmUps [2],double latLng [2])
 {
-	extern int csErrlng;
-	extern int csErrlat;
+	extern csTHREAD_LOCAL int csErrlng;
+	extern csTHREAD_LOCAL int csErrlat;
 	extern double cs_Degree;				/* converts degrees to radians by
 											   multiplication */
 	int status;
@@ -523,8 +523,8 @@ int CScalcMgrsFromLl (struct cs_Mgrs_ *__This,char *result,int size,double latLn
 
 int CScalcMgrsFromLlUtm (struct cs_Mgrs_ *__This,char *result,int size,double latLng [2],double utmUps [2],int prec)
 {
-	extern int csErrlng;
-	extern int csErrlat;
+	extern csTHREAD_LOCAL int csErrlng;
+	extern csTHREAD_LOCAL int csErrlat;
 
 	int ii;
 	int idx;
@@ -672,7 +672,7 @@ int CScalcLlFromMgrs (struct cs_Mgrs_ *__This,double latLng [2],Const char *mgrs
 }
 int CScalcLlFromMgrsEx (struct cs_Mgrs_ *__This,double latLng [2],Const char *mgrsString,short grdSqrPos)
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	char cc;
 	int count;
@@ -588,7 +588,7 @@ struct cs_NadconFile_* CSnewNadconFile (Const char* filePath,long32_t bufferSize
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int hpgn;
 	size_t readCount;
@@ -882,7 +882,7 @@ double CStestNadconFile (struct cs_NadconFile_* thisPtr,Const double *sourceLL)
 int CSextractNadconFile (struct cs_NadconFile_* thisPtr,Const double* sourceLL)
 {
 	extern double cs_LlNoise;			/* 1.0E-12 */
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int eleNbr;
 	int recNbr;
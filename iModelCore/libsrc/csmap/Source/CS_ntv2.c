@@ -387,7 +387,7 @@ int CSinitNTv2 (struct cs_NTv2_* thisPtr,Const char *filePath,long32_t bufferSiz
 	extern double cs_Sec2Deg;
 	extern double cs_K360;
 	extern char cs_DirsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	short idx;
 	short parIdx;
@@ -880,7 +880,7 @@ Const char* CSpathNTv2 (Const struct cs_NTv2_* thisPtr)
    conversion of that location. */
 struct csNTv2SubGrid_* CSlocateSubNTv2 (struct cs_NTv2_* thisPtr,Const double source [2])
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	short idx;
 	short parIdx;
@@ -1032,7 +1032,7 @@ int CScalcNTv2 (struct cs_NTv2_* thisPtr,double deltaLL [2],Const double source
 {
 	extern double cs_Zero;				/* 0.0 */
 	extern double cs_LlNoise;			/* 1.0E-12 */
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	short onLimit;
 	unsigned short eleNbr, rowNbr;
@@ -1397,7 +1397,7 @@ struct cs_ZoneMap_ cs_ZoneMap [] =
 
 int EXP_LVL1 CS_spZoneNbrMap (char *zoneNbr,int is83)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	char cc;
 	short zone;
@@ -1500,7 +1500,7 @@ int EXP_LVL1 CS_spZoneNbrMap (char *zoneNbr,int is83)
 
 int EXP_LVL3 CS_dynutm (struct cs_Csprm_ *csprm,int zone)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	extern double cs_Degree;		/* 0.17 */
 
@@ -49,7 +49,7 @@ struct cs_Osgm91_ *CSnewOsgm91 (const char *filePath,long32_t bufferSize,ulong32
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	extern double cs_Half;
 	extern double cs_One;
@@ -195,7 +195,7 @@ double CStestOsgm91 (struct cs_Osgm91_ *__This,const double etrs89 [2])
 int CScalcOsgm91 (struct cs_Osgm91_ *__This,double *geoidHgt,const double etrs89 [2])
 {
 	extern double cs_Mhuge;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 
 	long32_t readCount;
@@ -398,7 +398,7 @@ error:
 int CSmkBinaryOsgm91 (struct cs_Osgm91_ *__This)
 {
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 #if !defined(GEOCOORD_ENHANCEMENT)
@@ -82,7 +82,7 @@ double CSost02T (struct cs_Ostn02_ *ost02, double *ll_src, short direction)
 
 int CSost02F2 (struct cs_Ostn02_ *ost02, double *ll_trg, Const double *ll_src)
 {
-	extern char csErrnam[];
+	extern csTHREAD_LOCAL char csErrnam[];
 
 	int st;
 	double xy_src[2];
@@ -117,7 +117,7 @@ int CSost02F2 (struct cs_Ostn02_ *ost02, double *ll_trg, Const double *ll_src)
 
 int CSost02F3 (struct cs_Ostn02_ *ost02, double *ll_trg, Const double *ll_src)
 {
-	extern char csErrnam[];
+	extern csTHREAD_LOCAL char csErrnam[];
 
 	int st;
 	double xy_src[2];
@@ -154,7 +154,7 @@ int CSost02F3 (struct cs_Ostn02_ *ost02, double *ll_trg, Const double *ll_src)
 
 int CSost02I2 (struct cs_Ostn02_ *ost02,double *ll_trg,Const double *ll_src)
 {
-	extern char csErrnam[];
+	extern csTHREAD_LOCAL char csErrnam[];
 
 	int st;
 	double xy_src[2];
@@ -189,7 +189,7 @@ int CSost02I2 (struct cs_Ostn02_ *ost02,double *ll_trg,Const double *ll_src)
 
 int CSost02I3 (struct cs_Ostn02_ *ost02, double *ll_trg, Const double *ll_src)
 {
-	extern char csErrnam[];
+	extern csTHREAD_LOCAL char csErrnam[];
 
 	int st;
 	double xy_src[2];
@@ -149,7 +149,7 @@ double CSost15T (struct cs_Ostn15_ *ostn15,double *ll_src,short direction)
 }
 int CSost15F2 (struct cs_Ostn15_ *ostn15,double *ll_36,Const double *ll_89)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 	double xy89 [2];
@@ -183,7 +183,7 @@ int CSost15F2 (struct cs_Ostn15_ *ostn15,double *ll_36,Const double *ll_89)
 }
 int CSost15F3 (struct cs_Ostn15_ *ostn15,double *ll_36,Const double *ll_89)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 	double xy89 [2];
@@ -219,7 +219,7 @@ int CSost15F3 (struct cs_Ostn15_ *ostn15,double *ll_36,Const double *ll_89)
 }
 int CSost15I2 (struct cs_Ostn15_ *ostn15,double *ll_89,Const double* ll_36)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 	double xy89 [2];
@@ -253,7 +253,7 @@ int CSost15I2 (struct cs_Ostn15_ *ostn15,double *ll_89,Const double* ll_36)
 }
 int CSost15I3 (struct cs_Ostn15_ *ostn15,double *ll_89,Const double *ll_36)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 	double xy89 [2];
@@ -113,7 +113,7 @@ struct cs_Ostn02_ *CSnewOstn02 (const char *filePath)
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 #ifdef GEOCOORD_ENHANCEMENT
 	cs_Time_ bTime;
@@ -261,7 +261,7 @@ void CSreleaseOstn02 (struct cs_Ostn02_ *__This)
 int CSprivateOstn02 (struct cs_Ostn02_ *__This,double result [2],const double etrs89 [2])
 {
 	extern double cs_Mhuge;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 
 	long32_t readCount;
@@ -477,7 +477,7 @@ int CSforwardOstn02 (struct cs_Ostn02_ *__This,double osgb36 [2],const double et
 }
 int CSinverseOstn02 (struct cs_Ostn02_ *__This,double etrs89 [2],const double osgb36 [2])
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 
 	int st;
@@ -554,7 +554,7 @@ int CSinverseOstn02 (struct cs_Ostn02_ *__This,double etrs89 [2],const double os
 int CSmkBinaryOstn02 (struct cs_Ostn02_ *__This)
 {
 	extern char cs_DirsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 	int idx;
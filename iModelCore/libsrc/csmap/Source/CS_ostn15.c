@@ -104,7 +104,7 @@ struct cs_Ostn15_ *CSnewOstn15 (const char *filePath)
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 #ifdef GEOCOORD_ENHANCEMENT
 	cs_Time_ bTime;
@@ -279,7 +279,7 @@ void CSreleaseOstn15 (struct cs_Ostn15_ *__This)
 int CSprivateOstn15 (struct cs_Ostn15_ *__This,double result [2],const double etrs89 [2])
 {
 	extern Const double cs_Mhuge;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 
 	long32_t readCount;
@@ -504,7 +504,7 @@ int CSforwardOstn15 (struct cs_Ostn15_ *__This,double osgb36 [2],const double et
 }
 int CSinverseOstn15 (struct cs_Ostn15_ *__This,double etrs89 [2],const double osgb36 [2])
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 
 	int st;
@@ -585,7 +585,7 @@ int CSinverseOstn15 (struct cs_Ostn15_ *__This,double etrs89 [2],const double os
 int CSmkBinaryOstn15 (struct cs_Ostn15_ *__This)
 {
 	extern char cs_DirsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 	int idx;
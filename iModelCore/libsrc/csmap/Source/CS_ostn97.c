@@ -75,7 +75,7 @@ struct cs_Ostn97_ *CSnewOstn97 (const char *filePath /* path to the txt file */)
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 
@@ -177,7 +177,7 @@ void CSreleaseOstn97 (struct cs_Ostn97_ *__This)
 int CSprivateOstn97 (struct cs_Ostn97_ *__This,double result [2],const double etrs89 [2])
 {
 	extern double cs_Mhuge;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 
 	long32_t readCount;
@@ -391,7 +391,7 @@ int CSforwardOstn97 (struct cs_Ostn97_ *__This,double osgb36 [2],const double et
 }
 int CSinverseOstn97 (struct cs_Ostn97_ *__This,double etrs89 [2],const double osgb36 [2])
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern double cs_Zero;
 
 	int st;
@@ -462,7 +462,7 @@ int CSinverseOstn97 (struct cs_Ostn97_ *__This,double etrs89 [2],const double os
 int CSmkBinaryOstn97 (struct cs_Ostn97_ *__This)
 {
 	extern char cs_DirsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int st;
 
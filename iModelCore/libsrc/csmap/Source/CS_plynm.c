@@ -72,7 +72,7 @@ int EXP_LVL9 CSplynmQ (struct cs_GeodeticTransform_ *gxDef,unsigned short xfrmCo
 /*******************************************************************************/
 int EXP_LVL9 CSplynmS (struct cs_GxXform_* gxXfrm)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int idx;
 	unsigned long bitMapBit;
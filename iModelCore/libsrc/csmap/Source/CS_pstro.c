@@ -393,7 +393,7 @@ void EXP_LVL9 CSpstroS (struct cs_Csprm_ *csprm)
 int EXP_LVL9 CSpstroF (Const struct cs_Pstro_ *pstro,double xy [2],Const double ll [2])
 
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	extern double cs_Degree;			/* 1.0 / RADIAN  */
 	extern double cs_Half;				/* 0.5 */
@@ -113,7 +113,7 @@ int EXP_LVL7 CS_swpal (void (*prog)(Const char *name))
 	extern char cs_Dtname [];
 	extern char cs_Elname [];
 
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 
 	int st;
 
@@ -488,7 +488,7 @@ atl_error:
 char * EXP_LVL7 CS_swpfl (Const char org_name [])
 {
 	extern char cs_Dir [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char *cs_DirP;
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
@@ -945,7 +945,7 @@ int EXP_LVL3 CS_csrup (Const char *distrb,Const char *bkupnm)
 	extern char cs_Dir [];
 	extern char *cs_DirP;
 	extern char cs_Csname [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char cs_DirsepC;
 
 	int st;
@@ -1191,7 +1191,7 @@ error:
 }
 int CScsrupReadOld (csFILE *oldStrm,struct csCsrup_ *csrup,int old_lvl)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int old_st;
 
@@ -2077,7 +2077,7 @@ int EXP_LVL3 CS_dtrup (Const char *distrb,Const char *bkupnm)
 	extern char cs_Dir [];
 	extern char *cs_DirP;
 	extern char cs_Dtname [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char cs_DirsepC;
 
 	int st;
@@ -2326,7 +2326,7 @@ error:
 
 int CSdtrupReadOld (csFILE *oldStrm,struct csDtrup_ *dtrup,int old_lvl)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int old_st;
 
@@ -2879,7 +2879,7 @@ int EXP_LVL3 CS_elrup (Const char *distrb,Const char *bkupnm)
 	extern char cs_Dir [];
 	extern char *cs_DirP;
 	extern char cs_Elname [];
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern char cs_DirsepC;
 
 	int st;
@@ -3124,7 +3124,7 @@ error:
 
 int CSelrupReadOld (csFILE *oldStrm,struct csElrup_ *elrup,int old_lvl)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	int old_st;
 
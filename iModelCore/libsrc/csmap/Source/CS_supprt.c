@@ -1546,7 +1546,7 @@ int EXP_LVL3 CS_envsub (char* stringBufr,size_t bufrSize /*in chars*/)
 	extern char cs_EnvchrC;
 	extern char cs_EnvStartC;
 	extern char cs_EnvEndC;
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	enum envSubState {	envSubBegin = 0,
 						envSubCopy,
@@ -81,8 +81,8 @@ extern double (*CS_usrUnitPtr) (short type,Const char *unitName);
 double EXP_LVL1 CS_unitlu (short type,Const char *name)
 {
 	extern double cs_Zero;
-	extern int cs_Error;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL int cs_Error;
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern struct cs_Unittab_ cs_Unittab [];
 
 	cs_Register struct cs_Unittab_ Huge *tp;
@@ -161,7 +161,7 @@ error:
 }
 int EXP_LVL3 CS_unitAdd (struct cs_Unittab_ *unitPtr)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern struct cs_Unittab_ cs_Unittab [];
 
 	int status = 0;
@@ -219,7 +219,7 @@ int EXP_LVL3 CS_unitAdd (struct cs_Unittab_ *unitPtr)
 }
 int EXP_LVL3 CS_unitDel (short type,Const char *name)
 {
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 	extern struct cs_Unittab_ cs_Unittab [];
 
 	int status = 0;
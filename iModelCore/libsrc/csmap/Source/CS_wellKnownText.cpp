@@ -64,7 +64,7 @@ extern "C" const unsigned long KcsNmMapNoNumber;
 extern "C" const unsigned long KcsNmInvNumber;
 
 extern "C" int cs_Errno;
-extern "C" char csErrnam [MAXPATH];
+extern "C" csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 extern "C" struct cs_Prjprm_ csPrjprm [];
 extern "C" struct cs_Prjtab_ cs_Prjtab [];
@@ -3061,7 +3061,7 @@ error:
 //
 // This implies that zero is returned if no subsitutions are made.
 //
-extern "C" int cs_Error;
+extern "C" csTHREAD_LOCAL int cs_Error;
 int CS_wktDictRpl (struct cs_Csdef_ *csDef,struct cs_Dtdef_ *dtDef,struct cs_Eldef_ *elDef)
 {
 
@@ -46,7 +46,7 @@ extern "C" double cs_Zero;
 extern "C" double cs_One;
 extern "C" double cs_K90;
 extern "C" double cs_Degree;
-extern "C" char csErrnam [];
+extern "C" csTHREAD_LOCAL char csErrnam [];
 extern "C" struct cs_Prjtab_ cs_Prjtab [];
 extern "C" struct cs_Prjprm_ csPrjprm [];
 
@@ -206,10 +206,10 @@ int cs_Sortbs = 128 * 1024;
 #else
 int cs_Sortbs = 24 * 1024;
 #endif
-int cs_Error = 0;
+csTHREAD_LOCAL int cs_Error = 0;
 int cs_Errno = 0;
-int csErrlng = 0;
-int csErrlat = 0;
+csTHREAD_LOCAL int csErrlng = 0;
+csTHREAD_LOCAL int csErrlat = 0;
 unsigned short cs_ErrSup = 0;
 #if _RUN_TIME <= _rt_UNIXPCC
 ulong32_t cs_Doserr = 0;
@@ -249,8 +249,8 @@ double csGeoCtrEsq = 0.0;
 /* Note: several functions assume that csErrnam is dimensioned
    at MAXPATH (i.e. a minimum value). */
 
-char csErrnam [MAXPATH] = "<?>";
-char csErrmsg [cs_ERRMSG_SIZE] = "<?>";
+csTHREAD_LOCAL char csErrnam [MAXPATH] = "<?>";
+csTHREAD_LOCAL char csErrmsg [cs_ERRMSG_SIZE] = "<?>";
 
 /* The following carries a pointer to the category list. */
 struct cs_Ctdef_* cs_CtDefHead = NULL;
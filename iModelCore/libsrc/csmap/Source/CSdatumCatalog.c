@@ -219,7 +219,7 @@ Const struct cs_GdcCatalogTable_* EXP_LVL3 CS_gdcTable (enum cs_GdcCatalogs iden
 struct csDatumCatalog_* CSnewDatumCatalog (Const char* pathName)
 {
 	extern char cs_DirsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	short relative;
 	ulong32_t flags;
@@ -583,7 +583,7 @@ void CSdeleteDatumCatalog (struct csDatumCatalog_ *__This)
 int CSwriteDatumCatalog (struct csDatumCatalog_ *__This,Const char *path)
 {
 	extern char cs_DirsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	char *cp;
 	FILE *catFstr;
@@ -925,7 +925,7 @@ struct csDatumCatalogEntry_* CSnewDatumCatalogEntry (Const char* path,short rela
 {
 	extern char cs_DirsepC;
 	extern char cs_ExtsepC;
-	extern char csErrnam [];
+	extern csTHREAD_LOCAL char csErrnam [];
 
 	const char *cp;
 	struct csDatumCatalogEntry_* __This;
@@ -40,8 +40,8 @@
 
 #include "cs_Legacy.h"
 
-extern "C" int cs_Error;
-extern "C" char csErrnam [];
+extern "C" csTHREAD_LOCAL int cs_Error;
+extern "C" csTHREAD_LOCAL char csErrnam [];
 extern "C" const double cs_Zero;
 
 int EXP_LVL1 CS_dt2WktEx (char *bufr,size_t bufrSize,const char *dtKeyName,int flavor,unsigned short flags)
@@ -40,8 +40,8 @@
 
 extern "C" const double cs_Zero;
 extern "C" const double cs_One;
-extern "C" int cs_Error;
-extern "C" char csErrnam [];
+extern "C" csTHREAD_LOCAL int cs_Error;
+extern "C" csTHREAD_LOCAL char csErrnam [];
 
 int EXP_LVL1 CS_el2WktEx (char *bufr,size_t bufrSize,const char *elKeyName,int flavor,unsigned short flags)
 {
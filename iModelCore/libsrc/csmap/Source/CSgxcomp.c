@@ -985,7 +985,7 @@ int CSgxdefwr (	csFILE *outStrm,
 				int (*err_func)(char *mesg)
 			  )
 {
-	extern char csErrnam [MAXPATH];
+	extern csTHREAD_LOCAL char csErrnam [MAXPATH];
 
 	int st;
 	int ii;
@@ -48,13 +48,13 @@ BSTR _stdcall GetCsErrorAsString (void);
 extern char cs_Dir [MAXPATH];
 extern char* cs_DirP;
 extern csFILE* csDiagnostic;
-extern char csErrmsg [];
+extern csTHREAD_LOCAL char csErrmsg [];
 
 extern char cs_DirsepC;
 extern char cs_ExtsepC;
 extern char cs_OptchrC;
 
-extern int cs_Error;
+extern csTHREAD_LOCAL int cs_Error;
 
 /* The following are global variables with repsect to the DLL.  These are
    initialized in the DllMain function upon inital loading of the library.
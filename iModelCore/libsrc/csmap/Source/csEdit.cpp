@@ -32,7 +32,7 @@
 #include "cs_mfc.h"
 #include "cs_hlp.h"
 
-extern "C" char csErrnam [];
+extern "C" csTHREAD_LOCAL char csErrnam [];
 extern "C" struct cs_Prjtab_ cs_Prjtab [];
 
 /**********************************************************************
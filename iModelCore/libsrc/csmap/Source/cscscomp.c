@@ -927,7 +927,7 @@ int CScsdefwr (	csFILE *outStrm,
 			  )
 {
 	extern double cs_Zero;
-	extern char csErrnam [];	/* Expected to be dimensioned at MAXPATH */
+	extern csTHREAD_LOCAL char csErrnam [];	/* Expected to be dimensioned at MAXPATH */
 	extern struct cs_Prjtab_ cs_Prjtab [];
 
 	int st;
@@ -50,7 +50,7 @@ extern "C"
 	extern union cs_Bswap_ cs_BswapU;
 	extern short cs_Protect;
 	extern char cs_Unique;
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern int cs_Errno;
 	extern char cs_OptchrC;
 	extern char cs_DirsepC;
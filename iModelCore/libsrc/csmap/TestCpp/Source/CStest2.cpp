@@ -44,10 +44,10 @@ static struct tst_lst_ dt_tst [] =
 
 extern "C"
 {
-extern int cs_Error;
+extern csTHREAD_LOCAL int cs_Error;
 extern int cs_Errno;
-extern int csErrlng;
-extern int csErrlat;
+extern csTHREAD_LOCAL int csErrlng;
+extern csTHREAD_LOCAL int csErrlat;
 extern unsigned short cs_ErrSup;
 
 #if _RUN_TIME <= _rt_UNIXPCC
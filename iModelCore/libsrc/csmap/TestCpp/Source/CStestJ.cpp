@@ -32,10 +32,10 @@
 
 extern "C"
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern int cs_Errno;
-	extern int csErrlng;
-	extern int csErrlat;
+	extern csTHREAD_LOCAL int csErrlng;
+	extern csTHREAD_LOCAL int csErrlat;
 	extern unsigned short cs_ErrSup;
 
 	#if _RUN_TIME <= _rt_UNIXPCC
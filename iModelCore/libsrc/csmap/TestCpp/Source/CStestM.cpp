@@ -20,10 +20,10 @@
 
 extern "C"
 {
-	extern "C" int cs_Error;
+	extern "C" csTHREAD_LOCAL int cs_Error;
 	extern "C" int cs_Errno;
-	extern "C" int csErrlng;
-	extern "C" int csErrlat;
+	extern "C" csTHREAD_LOCAL int csErrlng;
+	extern "C" csTHREAD_LOCAL int csErrlat;
 	extern "C" unsigned short cs_ErrSup;
 
 	#if _RUN_TIME <= _rt_UNIXPCC
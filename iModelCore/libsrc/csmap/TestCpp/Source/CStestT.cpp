@@ -36,10 +36,10 @@
 
 extern "C"
 {
-	extern int cs_Error;
+	extern csTHREAD_LOCAL int cs_Error;
 	extern int cs_Errno;
-	extern int csErrlng;
-	extern int csErrlat;
+	extern csTHREAD_LOCAL int csErrlng;
+	extern csTHREAD_LOCAL int csErrlat;
 	extern unsigned short cs_ErrSup;
 
 	#if _RUN_TIME <= _rt_UNIXPCC
@@ -63,7 +63,7 @@ extern "C"
 
 extern "C" char cs_Dir [];
 extern "C" char *cs_DirP;
-extern "C" char csErrmsg [256];
+extern "C" csTHREAD_LOCAL char csErrmsg [256];
 extern "C" double cs_Zero;
 extern "C" double cs_LlNoise;
 extern "C" double cs_Sec2Deg;		/* Converts arc seconds to degrees by multiplication */
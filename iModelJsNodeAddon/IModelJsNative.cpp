@@ -71,10 +71,26 @@ struct FileProps {
     Utf8String m_fileExt;
     Utf8String m_localFileName;
     bool m_compress = true;
+    bool m_zstd = false;
     DateTime m_date;
     FileProps(Utf8StringCR name, Utf8StringCR fileExt,Utf8StringCR localFileName): m_name(name), m_fileExt(fileExt), m_localFileName(localFileName) {}
 };
 
+//---------------------------------------------------------------------------------------
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static ChangesetFileFormat getChangesetFileFormat(Napi::Env env, Utf8StringCR format) {
+    if (format.empty() || format == "singleStream")
+        return ChangesetFileFormat::SingleStream;
+    if (format == "blocks")
+        return ChangesetFileFormat::Blocks;
+    if (format == "zstdBlocks")
+        return ChangesetFileFormat::ZstdBlocks;
+
+    BeNapi::ThrowJsException(env, "changeset file format must be \"singleStream\", \"blocks\" or \"zstdBlocks\"");
+    return ChangesetFileFormat::SingleStream;
+}
+
 struct SQLiteOps {
     virtual Db* _GetMyDb() = 0;
 
@@ -102,6 +118,10 @@ struct SQLiteOps {
             BeNapi::ThrowJsException(info.Env(), "invalid date");
 
         props.m_compress = opts[JsInterop::json_compress()].asBool(true);
+        Utf8String codec = opts[JsInterop::json_codec()].asString("lzma");
+        if (codec != "lzma" && codec != "zstd")
+            BeNapi::ThrowJsException(info.Env(), "codec must be \"lzma\" or \"zstd\"");
+        props.m_zstd = codec == "zstd";
         return props;
     }
 
@@ -114,7 +134,8 @@ struct SQLiteOps {
         Db& db = GetOpenedDb(info);
         auto props = getEmbedFileArg(info);
         DbResult stat;
-        db.EmbeddedFiles().Import(&stat, props.m_compress, props.m_name.c_str(), props.m_localFileName.c_str(), &props.m_date, props.m_fileExt.c_str());
+        auto compression = !props.m_compress ? DbEmbeddedFileTable::Compression::None : props.m_zstd ? DbEmbeddedFileTable::Compression::Zstd : DbEmbeddedFileTable::Compression::Lzma;
+        db.EmbeddedFiles().Import(&stat, compression, props.m_name.c_str(), props.m_localFileName.c_str(), &props.m_date, props.m_fileExt.c_str());
         if (stat != BE_SQLITE_OK) {
             Utf8String err = "error embedding [" + props.m_localFileName + "] in";
             JsInterop::throwSqlResult(err.c_str(), db.GetDbFileName(), stat);
@@ -1250,9 +1271,13 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps
 
     Napi::Value StartCreateChangeset(NapiInfoCR info) {
         RequireDbIsWritable(info);
+        ChangesetFileFormat format = ChangesetFileFormat::SingleStream;
+        if (info.Length() > 0 && info[0].IsObject())
+            format = getChangesetFileFormat(Env(), BeJsConst(info[0])[JsInterop::json_fileFormat()].asString());
+
         TxnManagerR txns = m_dgndb->Txns();
         txns.StopCreateChangeset(false); // if there's one in progress, just abandon it.
-        ChangesetPropsPtr changeset = txns.StartCreateChangeset();
+        ChangesetPropsPtr changeset = txns.StartCreateChangeset(nullptr, format);
         if (!changeset.IsValid())
             BeNapi::ThrowJsException(Env(), "Error creating changeset");
 
@@ -2140,6 +2165,32 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps
         auto memoryUsed = GetDgnDb().Txns().GetMemoryUsed();
         return Napi::Number::New(Env(), memoryUsed);
         }
+    Napi::Value GetElementCacheStats(NapiInfoCR info)
+        {
+        RequireDbIsOpen(info);
+        auto stats = GetDgnDb().Elements().GetCacheStats();
+        BeJsNapiObject out(Env());
+        out["hits"] = (double) stats.m_hits;
+        out["misses"] = (double) stats.m_misses;
+        out["evictions"] = (double) stats.m_evictions;
+        out["memoryUsed"] = (double) stats.m_memoryUsed;
+        out["memoryLimit"] = (double) stats.m_memoryLimit;
+        out["elementCount"] = stats.m_elementCount;
+        return out;
+        }
+    void ResetElementCacheStats(NapiInfoCR info)
+        {
+        RequireDbIsOpen(info);
+        GetDgnDb().Elements().ResetCacheStats();
+        }
+    void SetElementCacheMemoryLimit(NapiInfoCR info)
+        {
+        RequireDbIsOpen(info);
+        REQUIRE_ARGUMENT_NUMBER(0, maxBytes);
+        if (maxBytes.DoubleValue() < 0)
+            BeNapi::ThrowJsException(Env(), "invalid element cache memory limit", (int)DgnDbStatus::BadArg);
+        GetDgnDb().Elements().SetCacheMemoryLimit((uint64_t) maxBytes.DoubleValue());
+        }
 
     Napi::Value StartProfiler(NapiInfoCR info)
         {
@@ -2241,6 +2292,31 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps
             BeNapi::ThrowJsException(Env(), "error applying changeset", (int)stat);
     }
 
+    Napi::Value ApplyChangesets(NapiInfoCR info) {
+        RequireDbIsWritable(info);
+        REQUIRE_ARGUMENT_ANY_OBJ(0, changesets);
+
+        auto& db = GetDgnDb();
+        bool containsSchemaChanges;
+        bvector<ChangesetPropsPtr> revisions = JsInterop::GetChangesetPropsVec(containsSchemaChanges, db.GetDbGuid().ToString(), changesets);
+        bvector<ChangesetPropsCP> revisionPtrs;
+        for (auto const& revision : revisions)
+            revisionPtrs.push_back(revision.get());
+
+        TxnManager::MergeTimings timings;
+        ChangesetStatus stat = db.Txns().MergeChangesets(revisionPtrs, &timings);
+        if (ChangesetStatus::Success != stat)
+            BeNapi::ThrowJsException(Env(), "error applying changeset", (int)stat);
+
+        BeJsNapiObject out(Env());
+        out["changesets"] = timings.m_changesets;
+        out["prepare"] = timings.m_prepare;
+        out["wait"] = timings.m_wait;
+        out["schema"] = timings.m_schema;
+        out["apply"] = timings.m_apply;
+        return out;
+    }
+
     void ConcurrentQueryExecute(NapiInfoCR info) {
         RequireDbIsOpen(info);;
         REQUIRE_ARGUMENT_ANY_OBJ(0, requestObj);
@@ -2282,6 +2358,7 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps
             InstanceMethod("addChildPropagatesChangesToParentRelationship", &NativeDgnDb::AddChildPropagatesChangesToParentRelationship),
             InstanceMethod("addNewFont", &NativeDgnDb::AddNewFont),
             InstanceMethod("applyChangeset", &NativeDgnDb::ApplyChangeset),
+            InstanceMethod("applyChangesets", &NativeDgnDb::ApplyChangesets),
             InstanceMethod("attachChangeCache", &NativeDgnDb::AttachChangeCache),
             InstanceMethod("beginMultiTxnOperation", &NativeDgnDb::BeginMultiTxnOperation),
             InstanceMethod("beginPurgeOperation", &NativeDgnDb::BeginPurgeOperation),
@@ -2334,6 +2411,7 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps
             InstanceMethod("getCurrentTxnId", &NativeDgnDb::GetCurrentTxnId),
             InstanceMethod("getECClassMetaData", &NativeDgnDb::GetECClassMetaData),
             InstanceMethod("getElement", &NativeDgnDb::GetElement),
+            InstanceMethod("getElementCacheStats", &NativeDgnDb::GetElementCacheStats),
             InstanceMethod("getFilePath", &NativeDgnDb::GetFilePath),
             InstanceMethod("getGeoCoordinatesFromIModelCoordinates", &NativeDgnDb::GetGeoCoordsFromIModelCoords),
             InstanceMethod("getGeometryContainment", &NativeDgnDb::GetGeometryContainment),
@@ -2400,6 +2478,7 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps
             InstanceMethod("removeEmbeddedFile", &NativeDgnDb::RemoveEmbeddedFile),
             InstanceMethod("replaceEmbeddedFile", &NativeDgnDb::ReplaceEmbeddedFile),
             InstanceMethod("resetBriefcaseId", &NativeDgnDb::ResetBriefcaseId),
+            InstanceMethod("resetElementCacheStats", &NativeDgnDb::ResetElementCacheStats),
             InstanceMethod("restartDefaultTxn", &NativeDgnDb::RestartDefaultTxn),
             InstanceMethod("restartTxnSession", &NativeDgnDb::RestartTxnSession),
             InstanceMethod("resumeProfiler", &NativeDgnDb::ResumeProfiler),
@@ -2410,6 +2489,7 @@ struct NativeDgnDb : BeObjectWrap<NativeDgnDb>, SQLiteOps
             InstanceMethod("saveFileProperty", &NativeDgnDb::SaveFileProperty),
             InstanceMethod("saveLocalValue", &NativeDgnDb::SaveLocalValue),
             InstanceMethod("schemaToXmlString", &NativeDgnDb::SchemaToXmlString),
+            InstanceMethod("setElementCacheMemoryLimit", &NativeDgnDb::SetElementCacheMemoryLimit),
             InstanceMethod("setGeometricModelTrackingEnabled", &NativeDgnDb::SetGeometricModelTrackingEnabled),
             InstanceMethod("setIModelDb", &NativeDgnDb::SetIModelDb),
             InstanceMethod("setIModelId", &NativeDgnDb::SetIModelId),
@@ -2523,11 +2603,13 @@ struct NativeRevisionUtility : BeObjectWrap<NativeRevisionUtility>
         REQUIRE_ARGUMENT_STRING(0, sourceChangeSetFile);
         REQUIRE_ARGUMENT_STRING(1, targetChangeSetFile);
         OPTIONAL_ARGUMENT_STRING(2, lzmaProperties);
+        OPTIONAL_ARGUMENT_STRING(3, fileFormat);
         LzmaEncoder::LzmaParams params;
         if (!lzmaProperties.empty())
             params.FromJson(BeJsDocument(lzmaProperties));
 
-        BentleyStatus status = RevisionUtility::RecompressRevision(sourceChangeSetFile.c_str(), targetChangeSetFile.c_str(), params);
+        ChangesetFileFormat format = getChangesetFileFormat(info.Env(), fileFormat);
+        BentleyStatus status = RevisionUtility::RecompressRevision(sourceChangeSetFile.c_str(), targetChangeSetFile.c_str(), params, format);
         return Napi::Number::New(info.Env(), (int)status);
         }
     static Napi::Value DisassembleRevision(NapiInfoCR info)
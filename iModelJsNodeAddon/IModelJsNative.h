@@ -383,6 +383,7 @@ struct JsInterop {
     BE_JSON_NAME(checksumBlockNames)
     BE_JSON_NAME(client)
     BE_JSON_NAME(cloudContainer)
+    BE_JSON_NAME(codec)
     BE_JSON_NAME(codeScope)
     BE_JSON_NAME(codeSpecId)
     BE_JSON_NAME(columnName)
@@ -402,6 +403,7 @@ struct JsInterop {
     BE_JSON_NAME(expires)
     BE_JSON_NAME(face)
     BE_JSON_NAME(fileExt)
+    BE_JSON_NAME(fileFormat)
     BE_JSON_NAME(fileName)
     BE_JSON_NAME(fonts)
     BE_JSON_NAME(forceUseId)
@@ -495,6 +495,56 @@ Napi::Object JsInterop::ConcurrentQueryResetConfig(Napi::Env env, ECDbCR ecdb, N
     }
     return ConcurrentQueryResetConfig(env, ecdb);
 }
+//---------------------------------------------------------------------------------------
+// Hand the column buffers of a columnar ECSql response to JS as external ArrayBuffers.
+// Every buffer holds a reference to the response so the native memory lives until JS
+// releases the last buffer and no copy is made. Runtimes that do not allow external
+// buffers (e.g. Electron with the V8 memory cage enabled) get a copy instead.
+// @bsimethod
+//---------------------------------------------------------------------------------------
+static Napi::Object ColumnarResultToJs(Napi::Env env, QueryResponse::Ptr const& response) {
+    auto& result = response->GetAsConst<ECSqlResponse>().GetColumnarResult();
+    bool allowExternal = true;
+    auto makeBuffer = [&](void const* data, size_t byteLength) {
+        if (byteLength == 0)
+            return Napi::ArrayBuffer::New(env, 0);
+
+        if (allowExternal) {
+            // Call N-API directly: on failure the Napi wrapper throws without releasing the hint, which would leak the reference.
+            auto keepAlive = new QueryResponse::Ptr(response);
+            napi_value value;
+            auto status = napi_create_external_arraybuffer(env, const_cast<void*>(data), byteLength,
+                [](napi_env, void*, void* hint) { delete static_cast<QueryResponse::Ptr*>(hint); }, keepAlive, &value);
+            if (napi_ok == status)
+                return Napi::ArrayBuffer(env, value);
+
+            delete keepAlive;
+            if (env.IsExceptionPending())
+                env.GetAndClearPendingException();
+            allowExternal = false; // don't try again for the remaining columns
+        }
+
+        auto buffer = Napi::ArrayBuffer::New(env, byteLength);
+        memcpy(buffer.Data(), data, byteLength);
+        return buffer;
+    };
+    auto jsData = Napi::Object::New(env);
+    jsData[QueryColumnarResult::JRowCount] = Napi::Number::New(env, result.GetRowCount());
+    auto jsColumns = Napi::Array::New(env, result.GetColumns().size());
+    uint32_t index = 0;
+    for (auto& column : result.GetColumns()) {
+        auto jsColumn = Napi::Object::New(env);
+        jsColumn[QueryColumnarResult::JType] = Napi::Number::New(env, (int)column.GetType());
+        jsColumn[QueryColumnarResult::JValues] = makeBuffer(column.GetValues().data(), column.GetValues().size());
+        jsColumn[QueryColumnarResult::JValidity] = makeBuffer(column.GetValidity().data(), column.GetValidity().size());
+        if (column.IsVariableLength())
+            jsColumn[QueryColumnarResult::JOffsets] = makeBuffer(column.GetOffsets().data(), column.GetOffsets().size() * sizeof(uint32_t));
+        jsColumns[index++] = jsColumn;
+    }
+    jsData[QueryColumnarResult::JColumns] = jsColumns;
+    return jsData;
+}
+
 //---------------------------------------------------------------------------------------
 // @bsimethod
 //---------------------------------------------------------------------------------------
@@ -512,7 +562,9 @@ void JsInterop::ConcurrentQueryExecute(ECDbCR ecdb, Napi::Object requestObj, Nap
             else if (value->GetKind() == QueryResponse::Kind::ECSql) {
                 auto& resp = value->GetAsConst<ECSqlResponse>();
                 resp.ToJs(beJsResp, false);
-                if (!resp.asJsonString().empty()) {
+                if (resp.IsColumnar()) {
+                    jsResp[ECSqlResponse::JData] = ColumnarResultToJs(Env(), value);
+                } else if (!resp.asJsonString().empty()) {
                     auto parse = Env().Global().Get("JSON").As<Napi::Object>().Get("parse").As<Napi::Function>();
                     auto rows = Napi::String::New(Env(), resp.asJsonString());
                     jsResp[ECSqlResponse::JData] = parse({ rows });
@@ -545,7 +597,9 @@ void JsInterop::ConcurrentQueryExecute(ECDbCR ecdb, Napi::Object requestObj, Nap
                 } else if (value->GetKind() ==  QueryResponse::Kind::ECSql) {
                     auto& resp = value->GetAsConst<ECSqlResponse>();
                     resp.ToJs(beJsResp, false);
-                    if (!resp.asJsonString().empty()) {
+                    if (resp.IsColumnar()) {
+                        jsResp[ECSqlResponse::JData] = ColumnarResultToJs(env, value);
+                    } else if (!resp.asJsonString().empty()) {
                         auto parse = env.Global().Get("JSON").As<Napi::Object>().Get("parse").As<Napi::Function>();
                         auto rows = Napi::String::New(env, resp.asJsonString());
                         jsResp[ECSqlResponse::JData] = parse({rows});
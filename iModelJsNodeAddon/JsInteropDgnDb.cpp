@@ -1232,6 +1232,18 @@ BentleyStatus JsInterop::GetGeoCoordsFromIModelCoords(BeJsValue results, DgnDbR
 
     // If targetGCS is nullptr and target valid at this point we only want cartesian to latitude/longitude conversion switched below
 
+    // Reproject all points at once so the datum conversion is set up once and large arrays are converted in parallel
+    if (nullptr != gcs && gcs->IsValid() && nullptr != targetGCS)
+        {
+        bvector<DPoint3d> cartesianPoints(iModelPoints.size());
+        for (size_t i = 0; i < iModelPoints.size(); ++i)
+            gcs->CartesianFromUors(cartesianPoints[i], iModelPoints[i]);
+
+        gcs->CartesianFromCartesian(geoPoints.data(), statusList.data(), cartesianPoints.data(), cartesianPoints.size(), *targetGCS);
+        populateGeoCoordResult(results[json_geoCoords()], geoPoints, statusList);
+        return BentleyStatus::BSISUCCESS;
+        }
+
     auto outputStatus = statusList.begin();
     for (auto input = iModelPoints.begin(), output = geoPoints.begin(); input != iModelPoints.end(); input++, output++, outputStatus++)
         {
@@ -1292,6 +1304,18 @@ BentleyStatus JsInterop::GetIModelCoordsFromGeoCoords(BeJsValue results, DgnDbR
 
     // If sourceGCS is nullptr and source valid at this point we only want cartesian to latitude/longitude conversion switched below
 
+    // Reproject all points at once so the datum conversion is set up once and large arrays are converted in parallel
+    if (nullptr != gcs && gcs->IsValid() && nullptr != sourceGCS)
+        {
+        bvector<DPoint3d> cartesianPoints(geoPoints.size());
+        sourceGCS->CartesianFromCartesian(cartesianPoints.data(), statusList.data(), geoPoints.data(), geoPoints.size(), *gcs);
+        for (size_t i = 0; i < cartesianPoints.size(); ++i)
+            gcs->UorsFromCartesian(iModelPoints[i], cartesianPoints[i]);
+
+        populateGeoCoordResult(results[json_iModelCoords()], iModelPoints, statusList);
+        return BentleyStatus::BSISUCCESS;
+        }
+
     auto outputStatus = statusList.begin();
     for (auto input = geoPoints.begin(), output = iModelPoints.begin(); input != geoPoints.end(); ++input, ++output, ++outputStatus)
         {
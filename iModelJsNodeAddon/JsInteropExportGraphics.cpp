@@ -807,11 +807,13 @@ struct ExportGraphicsJob
     ExportGraphicsContext           m_context;
     DgnElementId                    m_elementId;
     bvector<PartInstanceRecord>     m_instances;
+    bvector<Byte>                   m_geomBlob; // Compressed GeometryStream, decompressed by Execute on a worker thread
     bool                            m_caughtException;
+    bool                            m_readError;
 
 ExportGraphicsJob(DgnDbR db, IFacetOptionsR fo, DgnElementId elId, bool saveInstances, double decimationTolerance, bool generateLines, double minLineStyleComponentSize)
     : m_geom(db), m_db(db), m_processor(db, fo, decimationTolerance, generateLines, minLineStyleComponentSize), m_elementId(elId),
-    m_context(m_processor, saveInstances ? &m_instances : nullptr), m_caughtException(false)
+    m_context(m_processor, saveInstances ? &m_instances : nullptr), m_caughtException(false), m_readError(false)
     {
     }
 
@@ -822,6 +824,16 @@ void Execute()
         // Needed to handle errors and clear thread exclusion.
         RefCountedPtr<IRefCounted> errorHandler = T_HOST.GetBRepGeometryAdmin()._CreateWorkerThreadErrorHandler();
 
+        // Each worker thread has its own snappy buffer, so geometry streams decompress in parallel instead of
+        // contending for the one owned by DgnElements.
+        void const* blob = m_geomBlob.empty() ? nullptr : m_geomBlob.data();
+        if (DgnDbStatus::Success != m_geom.m_geomStream.ReadGeometryStream(BeSQLite::SnappyFromMemory::GetForThread(), m_db, blob, (int)m_geomBlob.size()))
+            {
+            m_readError = true;
+            return;
+            }
+        bvector<Byte>().swap(m_geomBlob);
+
         m_context.SetDgnDb(m_db);
         m_geom.Draw(m_context, 0);
         }
@@ -973,11 +985,84 @@ static Placement3d getPlacement(BeSQLite::CachedStatement& stmt)
     }
 
 /*---------------------------------------------------------------------------------**//**
+* Deliver the meshes, lines and part instances of a completed job to the JavaScript callbacks.
+* @bsimethod
++---------------+---------------+---------------+---------------+---------------+------*/
+static void deliverJobResults(ExportGraphicsJob& job, Napi::Function& onGraphicsCb, Napi::Function& onLineGraphicsCb, Napi::Array* napiPartArray)
+    {
+    Napi::Env env = JsInterop::Env();
+    if (job.m_caughtException)
+        {
+        Utf8CP errorMsg = "Element 0x%llx caused uncaught exception, this may indicate problems with the source data.";
+        LOG.errorv(errorMsg, job.m_elementId.GetValueUnchecked());
+        return; // State is invalid - ignore this element.
+        }
+
+    if (job.m_readError)
+        return;
+
+    if (job.m_processor.m_gotBadPolyface)
+        {
+        Utf8CP errorMsg = "Element 0x%llx generated invalid geometry, this may indicate problems with the source data.";
+        LOG.errorv(errorMsg, job.m_elementId.GetValueUnchecked());
+        // Bad polyface is handled gracefully, OK to continue in case other valid geometry was generated
+        }
+
+    Napi::String elementIdString = createIdString(env, job.m_elementId);
+    for (auto& entry : job.m_processor.m_cachedEntries)
+        {
+         // Can happen if all triangles are degenerate
+        if (entry.mesh.indices.empty())
+            continue;
+        Napi::Object cbArgument = Napi::Object::New(env);
+        cbArgument.Set("elementId", elementIdString);
+        cbArgument.Set("mesh", convertMesh(env, entry.mesh, entry.isTwoSided));
+        cbArgument.Set("color", Napi::Number::New(env, entry.color.GetValue()));
+        cbArgument.Set("subCategory", createIdString(env, entry.subCategoryId));
+        cbArgument.Set("geometryClass", Napi::Number::New(env, static_cast<uint8_t>(entry.geometryClass)));
+        if (entry.materialId.IsValid())
+            cbArgument.Set("materialId", createIdString(env, entry.materialId));
+        if (entry.textureId.IsValid())
+            cbArgument.Set("textureId", createIdString(env, entry.textureId));
+        onGraphicsCb.Call({ cbArgument });
+        }
+
+    for (auto& entry : job.m_processor.m_cachedLineStrings)
+        {
+        if (entry.indices.empty())
+            continue;
+        Napi::Object cbArgument = Napi::Object::New(env);
+        cbArgument.Set("elementId", elementIdString);
+        cbArgument.Set("subCategory", createIdString(env, entry.subCategoryId));
+        cbArgument.Set("geometryClass", Napi::Number::New(env, static_cast<uint8_t>(entry.geometryClass)));
+        cbArgument.Set("color", Napi::Number::New(env, entry.color.GetValue()));
+        cbArgument.Set("lines", convertLines(env, entry.indices, entry.points));
+        onLineGraphicsCb.Call({ cbArgument });
+        }
+
+    if (nullptr != napiPartArray && !job.m_instances.empty())
+        convertPartInstances(env, *napiPartArray, job.m_elementId, job.m_instances);
+    }
+
+/*---------------------------------------------------------------------------------**//**
+* The calling thread reads each element's row and hands its compressed geometry to a job on the
+* CPU pool, which decompresses and facets it. At most a fixed number of jobs are in flight: once
+* that many are pending, the oldest job is waited on and its results are delivered to onGraphics
+* before the next element is read. Memory therefore stays bounded by the number of jobs in flight
+* rather than by the number of elements exported, and results arrive in elementIdArray order.
 * @bsimethod
 +---------------+---------------+---------------+---------------+---------------+------*/
 DgnDbStatus JsInterop::ExportGraphics(DgnDbR db, Napi::Object const& exportProps)
     {
+    struct PendingJob
+        {
+        std::unique_ptr<ExportGraphicsJob> m_job;
+        folly::Future<folly::Unit> m_done;
+        PendingJob(ExportGraphicsJob* job, folly::Future<folly::Unit>&& done) : m_job(job), m_done(std::move(done)) {}
+        };
+
     BeFolly::ThreadPool& threadPool = BeFolly::ThreadPool::GetCpuPool();
+    const size_t maxJobsInFlight = std::max((size_t)8, 4 * threadPool.size());
     BeSQLite::CachedStatementPtr stmt = getSelectStatement(db);
     IFacetOptionsPtr facetOptions = createFacetOptions(exportProps);
     Napi::Array elementIdArray = exportProps.Get("elementIdArray").As<Napi::Array>();
@@ -992,106 +1077,48 @@ DgnDbStatus JsInterop::ExportGraphics(DgnDbR db, Napi::Object const& exportProps
     if (napiDecimationTolerance.IsNumber())
         decimationTolerance = napiDecimationTolerance.DoubleValue();
 
-    bvector<std::unique_ptr<ExportGraphicsJob>> jobs;
-    bvector<folly::Future<folly::Unit>> jobHandles;
-    jobs.reserve(elementIdArray.Length());
-    jobHandles.reserve(elementIdArray.Length());
-
     Napi::Array napiPartArray = exportProps.Get("partInstanceArray").As<Napi::Array>();
     bool saveInstances = napiPartArray.IsArray();
 
+    // TS API specifies that modifying the binding of these functions in the callbacks will be ignored
+    Napi::Function onGraphicsCb = exportProps.Get("onGraphics").As<Napi::Function>();
     Napi::Function onLineGraphicsCb = exportProps.Get("onLineGraphics").As<Napi::Function>();
     bool generateLines = onLineGraphicsCb.IsFunction();
 
-    for (uint32_t i = 0; i < elementIdArray.Length(); ++i)
+    std::deque<PendingJob> jobsInFlight;
+    const uint32_t elementCount = elementIdArray.Length();
+    uint32_t nextElement = 0;
+    while (nextElement < elementCount || !jobsInFlight.empty())
         {
         Napi::HandleScope handleScope(Env());
-        Napi::String napiElementId = elementIdArray.Get(i).As<Napi::String>();
-        std::string elementIdStr = napiElementId.Utf8Value();
-        DgnElementId elementId(BeInt64Id::FromString(elementIdStr.c_str()).GetValue());
-        if (!elementId.IsValid())
-            continue;
-
-        // Mimic GeometrySelector3d in Tile.cpp
-        stmt->Reset();
-        stmt->BindInt64(1, elementId.GetValueUnchecked());
-        if (BeSQLite::BE_SQLITE_ROW != stmt->Step())
-            continue;
-
-        GeometryStream geomStream;
-        auto status = db.Elements().LoadGeometryStream(geomStream, stmt->GetValueBlob(1), stmt->GetColumnBytes(1));
-        if (status != DgnDbStatus::Success)
-            continue;
-
-        auto job = new ExportGraphicsJob(db, *facetOptions.get(), elementId, saveInstances, decimationTolerance, generateLines, minLineStyleComponentSize);
-        job->m_geom.m_categoryId = stmt->GetValueId<DgnCategoryId>(0);
-        job->m_geom.m_placement = getPlacement(*stmt);
-        job->m_geom.m_geomStream = std::move(geomStream);
-
-        jobs.emplace_back(job);
-        jobHandles.push_back(folly::via(&threadPool, [=]() { job->Execute(); }));
-        }
-
-    // TS API specifies that modifying the binding of this function in the callback will be ignored
-    Napi::Function onGraphicsCb = exportProps.Get("onGraphics").As<Napi::Function>();
-
-    for (uint32_t i = 0; i < (uint32_t)jobHandles.size(); ++i)
-        {
-        Napi::HandleScope handleScope(Env());
-        jobHandles[i].wait(); // Should use folly chaining? Good enough for now, jobs are FIFO
-        ExportGraphicsJob* job = jobs[i].get();
-
-        if (job->m_caughtException)
-            {
-            Utf8CP errorMsg = "Element 0x%llx caused uncaught exception, this may indicate problems with the source data.";
-            LOG.errorv(errorMsg, job->m_elementId.GetValueUnchecked());
-            jobs[i].reset();
-            continue; // State is invalid - clean up and ignore this element.
-            }
-
-        if (job->m_processor.m_gotBadPolyface)
+        if (nextElement < elementCount && jobsInFlight.size() < maxJobsInFlight)
             {
-            Utf8CP errorMsg = "Element 0x%llx generated invalid geometry, this may indicate problems with the source data.";
-            LOG.errorv(errorMsg, job->m_elementId.GetValueUnchecked());
-            // Bad polyface is handled gracefully, OK to continue in case other valid geometry was generated
-            }
-
-        Napi::String elementIdString = createIdString(Env(), job->m_elementId);
-        for (auto& entry : job->m_processor.m_cachedEntries)
-            {
-             // Can happen if all triangles are degenerate
-            if (entry.mesh.indices.empty())
+            Napi::String napiElementId = elementIdArray.Get(nextElement++).As<Napi::String>();
+            std::string elementIdStr = napiElementId.Utf8Value();
+            DgnElementId elementId(BeInt64Id::FromString(elementIdStr.c_str()).GetValue());
+            if (!elementId.IsValid())
                 continue;
-            Napi::Object cbArgument = Napi::Object::New(Env());
-            cbArgument.Set("elementId", elementIdString);
-            cbArgument.Set("mesh", convertMesh(Env(), entry.mesh, entry.isTwoSided));
-            cbArgument.Set("color", Napi::Number::New(Env(), entry.color.GetValue()));
-            cbArgument.Set("subCategory", createIdString(Env(), entry.subCategoryId));
-            cbArgument.Set("geometryClass", Napi::Number::New(Env(), static_cast<uint8_t>(entry.geometryClass)));
-            if (entry.materialId.IsValid())
-                cbArgument.Set("materialId", createIdString(Env(), entry.materialId));
-            if (entry.textureId.IsValid())
-                cbArgument.Set("textureId", createIdString(Env(), entry.textureId));
-            onGraphicsCb.Call({ cbArgument });
-            }
 
-        for (auto& entry : job->m_processor.m_cachedLineStrings)
-            {
-            if (entry.indices.empty())
+            // Mimic GeometrySelector3d in Tile.cpp
+            stmt->Reset();
+            stmt->BindInt64(1, elementId.GetValueUnchecked());
+            if (BeSQLite::BE_SQLITE_ROW != stmt->Step())
                 continue;
-            Napi::Object cbArgument = Napi::Object::New(Env());
-            cbArgument.Set("elementId", elementIdString);
-            cbArgument.Set("subCategory", createIdString(Env(), entry.subCategoryId));
-            cbArgument.Set("geometryClass", Napi::Number::New(Env(), static_cast<uint8_t>(entry.geometryClass)));
-            cbArgument.Set("color", Napi::Number::New(Env(), entry.color.GetValue()));
-            cbArgument.Set("lines", convertLines(Env(), entry.indices, entry.points));
-            onLineGraphicsCb.Call({ cbArgument });
-            }
 
-        if (saveInstances && !job->m_instances.empty())
-            convertPartInstances(Env(), napiPartArray, job->m_elementId, job->m_instances);
+            auto job = new ExportGraphicsJob(db, *facetOptions.get(), elementId, saveInstances, decimationTolerance, generateLines, minLineStyleComponentSize);
+            job->m_geom.m_categoryId = stmt->GetValueId<DgnCategoryId>(0);
+            job->m_geom.m_placement = getPlacement(*stmt);
+            Byte const* blob = static_cast<Byte const*>(stmt->GetValueBlob(1));
+            job->m_geomBlob.assign(blob, blob + stmt->GetColumnBytes(1));
+
+            jobsInFlight.emplace_back(job, folly::via(&threadPool, [=]() { job->Execute(); }));
+            continue;
+            }
 
-        jobs[i].reset(); // Cleaning these up now while they're still in cache is much faster
+        PendingJob& oldest = jobsInFlight.front();
+        oldest.m_done.wait();
+        deliverJobResults(*oldest.m_job, onGraphicsCb, onLineGraphicsCb, saveInstances ? &napiPartArray : nullptr);
+        jobsInFlight.pop_front(); // Cleaning these up now while they're still in cache is much faster
         }
 
     return DgnDbStatus::Success;
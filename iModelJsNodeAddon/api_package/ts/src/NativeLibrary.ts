@@ -220,6 +220,7 @@ export declare namespace IModelJsNative {
  * @internal
  */
   export interface QueryConfig {
+    cursorIdleTimeout?: number;
     globalQuota?: QueryQuota;
     ignoreDelay?: boolean;
     ignorePriority?: boolean;
@@ -302,6 +303,9 @@ export declare namespace IModelJsNative {
     Latest = V3_2,
   }
 
+  /** The container and codec of a changeset file. "singleStream" is readable by all versions; "blocks" and "zstdBlocks" are not readable by versions that predate them. */
+  type ChangesetFileFormat = "singleStream" | "blocks" | "zstdBlocks";
+
   interface ChangesetFileProps {
     index: number;
     id: string;
@@ -324,6 +328,8 @@ export declare namespace IModelJsNative {
     date: number;
     fileExt?: string;
     compress?: boolean;
+    /** The codec used when `compress` is not false. Files compressed with "zstd" extract several times faster, but can't be read by versions that predate it. Default is "lzma". */
+    codec?: "lzma" | "zstd";
   }
 
   interface EmbedFileQuery {
@@ -444,6 +450,36 @@ export declare namespace IModelJsNative {
     status: IModelStatus;
   }
 
+  /** Counters that describe the use of the element cache of a [[DgnDb]]. */
+  interface ElementCacheStats {
+    /** The number of lookups that found the element in the cache. */
+    hits: number;
+    /** The number of lookups that did not find the element in the cache. */
+    misses: number;
+    /** The number of elements dropped from the cache to stay within its limits. */
+    evictions: number;
+    /** The approximate number of bytes held by the cached elements. */
+    memoryUsed: number;
+    /** The maximum number of bytes held by the cached elements. */
+    memoryLimit: number;
+    /** The number of elements in the cache. */
+    elementCount: number;
+  }
+
+  /** The number of changesets applied by [[DgnDb.applyChangesets]] and the time spent in each phase, in seconds. */
+  interface ApplyChangesetsTimings {
+    /** The number of changesets applied. */
+    changesets: number;
+    /** Reading, decompressing and verifying the changesets, on a background thread while the previous changeset is applied. */
+    prepare: number;
+    /** Waiting for the next changeset to be prepared. */
+    wait: number;
+    /** Applying DDL changes. */
+    schema: number;
+    /** Applying data changes, including propagating indirect changes, notifying monitors and saving. */
+    apply: number;
+  }
+
   /** The native object for a Briefcase. */
   class DgnDb implements IConcurrentQueryManager, SQLiteOps {
     constructor();
@@ -453,6 +489,7 @@ export declare namespace IModelJsNative {
     public addChildPropagatesChangesToParentRelationship(schemaName: string, relClassName: string): BentleyStatus;
     public addNewFont(arg: { type: FontType, name: string }): number;
     public applyChangeset(changeSet: ChangesetFileProps): void;
+    public applyChangesets(changeSets: ChangesetFileProps[]): ApplyChangesetsTimings;
     public attachChangeCache(changeCachePath: string): DbResult;
     public beginMultiTxnOperation(): DbResult;
     public beginPurgeOperation(): IModelStatus;
@@ -505,6 +542,7 @@ export declare namespace IModelJsNative {
     public getCurrentTxnId(): TxnIdString;
     public getECClassMetaData(schema: string, className: string): ErrorStatusOrResult<IModelStatus, string>;
     public getElement(opts: ElementLoadProps): ElementProps;
+    public getElementCacheStats(): ElementCacheStats;
     public getFilePath(): string; // full path of the DgnDb file
     public getGeoCoordinatesFromIModelCoordinates(points: GeoCoordinatesRequestProps): GeoCoordinatesResponseProps;
     public getGeometryContainment(props: object): Promise<GeometryContainmentResponseProps>;
@@ -573,6 +611,7 @@ export declare namespace IModelJsNative {
     public removeEmbeddedFile(name: string): void;
     public replaceEmbeddedFile(arg: EmbedFileArg): void;
     public resetBriefcaseId(idValue: number): void;
+    public resetElementCacheStats(): void;
     public restartDefaultTxn(): void;
     public restartTxnSession(): void;
     public resumeProfiler(): DbResult;
@@ -583,12 +622,15 @@ export declare namespace IModelJsNative {
     public saveFileProperty(props: FilePropertyProps, strValue: string | undefined, blobVal: Uint8Array | undefined): void;
     public saveLocalValue(name: string, value: string | undefined): void;
     public schemaToXmlString(schemaName: string, version?: ECVersion): string | undefined;
+    public setElementCacheMemoryLimit(maxBytes: number): void;
     public setGeometricModelTrackingEnabled(enabled: boolean): ErrorStatusOrResult<IModelStatus, boolean>;
     public setIModelDb(iModelDb?: any/* IModelDb */): void;
     public setIModelId(guid: GuidString): DbResult;
     public setITwinId(guid: GuidString): DbResult;
     public simplifyElementGeometry(simplifyArgs: any): DbResult;
-    public startCreateChangeset(): ChangesetFileProps;
+    /** Create a changeset file from the local Txns. By default the file is written in the "singleStream" format, which all versions can read.
+     * The "blocks" and "zstdBlocks" formats are faster to write and apply, but can't be read by versions that predate them. */
+    public startCreateChangeset(args?: { fileFormat?: ChangesetFileFormat }): ChangesetFileProps;
     public startProfiler(scopeName?: string, scenarioName?: string, overrideFile?: boolean, computeExecutionPlan?: boolean): DbResult;
     public stopProfiler(): { rc: DbResult, elapsedTime?: number, scopeId?: number, fileName?: string };
     public updateElement(elemProps: ElementProps): void;
@@ -629,7 +671,7 @@ export declare namespace IModelJsNative {
     public static dumpChangesetToDb(sourceFile: string, dbFile: string, includeCols: boolean): BentleyStatus;
     public static getUncompressSize(sourceFile: string): string;
     public static normalizeLzmaParams(lzmaPropsJson?: string): string;
-    public static recompressRevision(sourceFile: string, targetFile: string, lzmaPropsJson?: string): BentleyStatus;
+    public static recompressRevision(sourceFile: string, targetFile: string, lzmaPropsJson?: string, fileFormat?: ChangesetFileFormat): BentleyStatus;
   }
 
   class ECDb implements IDisposable, IConcurrentQueryManager {
@@ -1138,6 +1180,8 @@ export declare namespace IModelJsNative {
     mode: "disk";
     directory: string;
     memoryCacheSize?: number;
+    /** Key caches of read-only iModels by iModel id and changeset id, and share them between processes using the same directory. */
+    shareByChangeset?: boolean;
   }
 
   interface ECPresentationHybridHierarchyCacheConfig {
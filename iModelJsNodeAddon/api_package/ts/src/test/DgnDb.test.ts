@@ -79,6 +79,31 @@ describe("basic tests", () => {
       assert.isDefined(elementsWithGraphics[id], `No graphics generated for ${id}`);
   });
 
+  it("testExportGraphicsDeliversResultsInOrder", () => {
+    const geometricElementIds: Id64Array = [];
+    const statement = new iModelJsNative.ECSqlStatement();
+    statement.prepare(dgndb, "SELECT ECInstanceId FROM bis.GeometricElement3d");
+    while (DbResult.BE_SQLITE_ROW === statement.step())
+      geometricElementIds.push(statement.getValue(0).getId());
+    statement.dispose();
+    assert(geometricElementIds.length > 0, "No 3D elements in test file");
+
+    // Request more elements than the exporter keeps in flight at once, along with ids that have no geometry.
+    const elementIdArray: Id64Array = [];
+    while (elementIdArray.length < 200)
+      elementIdArray.push(...geometricElementIds, "0", "0x33333");
+
+    // An element may produce several meshes, so record each run of callbacks for the same element once.
+    const withoutRepeats = (ids: Id64Array) => ids.filter((id, index) => index === 0 || id !== ids[index - 1]);
+    const deliveredIds: Id64Array = [];
+    const onGraphics = (info: any) => deliveredIds.push(info.elementId);
+    const res = dgndb.exportGraphics({ elementIdArray, onGraphics });
+
+    assert.equal(res, 0, `IModelDb.exportGraphics returned ${res}`);
+    const expectedIds = elementIdArray.filter((id) => geometricElementIds.includes(id));
+    assert.deepEqual(withoutRepeats(deliveredIds), withoutRepeats(expectedIds));
+  });
+
   it("testSchemaImport", () => {
     const writeDbFileName = copyFile("testSchemaImport.bim", dbFileName);
     // Without ProfileOptions.Upgrade, we get: Error | ECDb | Failed to import schema 'BisCore.01.00.15'. Current ECDb profile version (4.0.0.1) only support schemas with EC version < 3.2. ECDb profile version upgrade is required to import schemas with EC Version >= 3.2.
@@ -107,6 +107,9 @@ static void ApplyDiskCacheParams(ECPresentationManager::Params::CachingParams& c
 
     if (diskCacheConfig.hasMember("memoryCacheSize") && diskCacheConfig["memoryCacheSize"].isNumeric())
         cachingParams.SetDiskCacheMemoryCacheSize(diskCacheConfig["memoryCacheSize"].asUInt64());
+
+    if (diskCacheConfig.hasMember("shareByChangeset") && diskCacheConfig["shareByChangeset"].isBool())
+        cachingParams.SetShareCacheByChangeset(diskCacheConfig["shareByChangeset"].asBool());
     }
 
 /*---------------------------------------------------------------------------------**//**